@@ -0,0 +1,231 @@
+# ----------------------------------------------------------------------------
+# Copyright (c) Microsoft. All rights reserved.
+# Licensed under the MIT license. See LICENSE.md file in the project root
+# for full license information.
+# ----------------------------------------------------------------------------
+#
+# Converts a CNTKTextFormat (CTF) input file into one or more CNTK binary
+# format (CBF) shard files, as read by CNTKBinaryReader.
+#
+# Each shard is a complete, self-describing CBF file: it carries the stream
+# descriptors and a chunk index in its footer, so shards can be distributed
+# across workers independently (see the 'files', 'workerRank' and
+# 'numberOfWorkers' options of CNTKBinaryReader).
+#
+# Example:
+#   python ctf2bin.py --input train.ctf --output train.bin \
+#       --stream features:dense:100 --stream labels:sparse:10000 \
+#       --chunk-size 512 --shard-size 100000
+#
+# Stream specification: NAME[=ALIAS]:dense|sparse:DIMENSION, where ALIAS is
+# the stream name used in the CTF file when it differs from NAME.
+
+from __future__ import print_function
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x636e746b5f62696e
+VERSION = 1
+
+ENCODING_DENSE = 0
+ENCODING_SPARSE = 1
+
+DATA_TYPE_FLOAT = 0
+DATA_TYPE_DOUBLE = 1
+
+
+class Stream(object):
+    def __init__(self, spec):
+        parts = spec.split(':')
+        if len(parts) != 3 or parts[1] not in ('dense', 'sparse'):
+            raise ValueError("Invalid stream specification '%s', "
+                             "expected NAME[=ALIAS]:dense|sparse:DIMENSION" % spec)
+        name = parts[0].split('=')
+        self.name = name[0]
+        self.alias = name[1] if len(name) > 1 else name[0]
+        self.is_sparse = (parts[1] == 'sparse')
+        self.dimension = int(parts[2])
+
+
+class Sequence(object):
+    def __init__(self, num_streams):
+        # One list of samples per stream; a dense sample is a list of values,
+        # a sparse sample is a list of (index, value) pairs.
+        self.samples = [[] for _ in range(num_streams)]
+
+    def num_samples(self):
+        return max(len(s) for s in self.samples)
+
+
+class ShardWriter(object):
+    def __init__(self, path, streams, value_format):
+        self.path = path
+        self.streams = streams
+        self.value_format = value_format
+        self.chunks = []  # (offset, num_sequences, num_samples)
+        self.num_sequences = 0
+        self.output = open(path, 'wb')
+        self.output.write(struct.pack('<QI', MAGIC, VERSION))
+
+    def write_chunk(self, sequences):
+        offset = self.output.tell()
+        num_samples = sum(s.num_samples() for s in sequences)
+
+        # Chunk prefix: the number of samples of every sequence.
+        self.output.write(struct.pack('<%dI' % len(sequences),
+                                      *[s.num_samples() for s in sequences]))
+
+        # Then the data of all sequences, stream by stream.
+        for index, stream in enumerate(self.streams):
+            for sequence in sequences:
+                self._write_sequence(stream, sequence.samples[index])
+
+        self.chunks.append((offset, len(sequences), num_samples))
+        self.num_sequences += len(sequences)
+
+    def _write_sequence(self, stream, samples):
+        if not stream.is_sparse:
+            self.output.write(struct.pack('<I', len(samples)))
+            for sample in samples:
+                if len(sample) != stream.dimension:
+                    raise ValueError("Dense sample of stream '%s' has %d values, expected %d"
+                                     % (stream.name, len(sample), stream.dimension))
+                self.output.write(struct.pack('<%d%s' % (len(sample), self.value_format), *sample))
+        else:
+            values = []
+            indices = []
+            nnz_counts = []
+            for sample in samples:
+                nnz_counts.append(len(sample))
+                for index, value in sample:
+                    if index >= stream.dimension:
+                        raise ValueError("Sparse index %d of stream '%s' is out of bounds (dimension %d)"
+                                         % (index, stream.name, stream.dimension))
+                    indices.append(index)
+                    values.append(value)
+            self.output.write(struct.pack('<II', len(samples), len(values)))
+            self.output.write(struct.pack('<%d%s' % (len(values), self.value_format), *values))
+            self.output.write(struct.pack('<%di' % len(indices), *indices))
+            self.output.write(struct.pack('<%di' % len(nnz_counts), *nnz_counts))
+
+    def close(self, data_type):
+        # The footer index: stream descriptors plus the chunk table, with the
+        # offset of the header stored in the last 8 bytes of the file.
+        header_offset = self.output.tell()
+        self.output.write(struct.pack('<QII', MAGIC, len(self.chunks), len(self.streams)))
+        for stream in self.streams:
+            name = stream.name.encode('utf-8')
+            self.output.write(struct.pack('<B', ENCODING_SPARSE if stream.is_sparse else ENCODING_DENSE))
+            self.output.write(struct.pack('<I', len(name)))
+            self.output.write(name)
+            self.output.write(struct.pack('<BI', data_type, stream.dimension))
+        for offset, num_sequences, num_samples in self.chunks:
+            self.output.write(struct.pack('<qII', offset, num_sequences, num_samples))
+        self.output.write(struct.pack('<q', header_offset))
+        self.output.close()
+
+
+def parse_sequences(input_file, streams):
+    alias_to_index = {s.alias: i for i, s in enumerate(streams)}
+    sequence = None
+    sequence_id = None
+    for line_number, line in enumerate(input_file, 1):
+        line = line.rstrip('\r\n')
+        if not line:
+            continue
+        prefix, _, rest = line.partition('|')
+        prefix = prefix.strip()
+        if not rest:
+            raise ValueError("Line %d: no input streams found" % line_number)
+        # Sequences without an explicit id are single-line sequences.
+        if sequence is not None and (not prefix or prefix != sequence_id):
+            yield sequence
+            sequence = None
+        if sequence is None:
+            sequence = Sequence(len(streams))
+            sequence_id = prefix
+        for chunk in rest.split('|'):
+            fields = chunk.split()
+            if not fields:
+                continue
+            alias = fields[0]
+            if alias.startswith('#'):  # a comment stream
+                continue
+            if alias not in alias_to_index:
+                raise ValueError("Line %d: unknown stream '%s'" % (line_number, alias))
+            index = alias_to_index[alias]
+            if streams[index].is_sparse:
+                sample = []
+                for field in fields[1:]:
+                    position, _, value = field.partition(':')
+                    sample.append((int(position), float(value)))
+                sample.sort()
+            else:
+                sample = [float(f) for f in fields[1:]]
+            sequence.samples[index].append(sample)
+    if sequence is not None:
+        yield sequence
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Converts a CNTKTextFormat file into sharded CNTK binary format files.')
+    parser.add_argument('--input', required=True, help='input CTF file')
+    parser.add_argument('--output', required=True,
+                        help='output file; shards are named <output>.<shard number> '
+                             'when more than one shard is produced')
+    parser.add_argument('--stream', action='append', required=True, dest='streams',
+                        help='stream specification NAME[=ALIAS]:dense|sparse:DIMENSION '
+                             '(can be given multiple times)')
+    parser.add_argument('--chunk-size', type=int, default=512,
+                        help='number of sequences per chunk (default: 512)')
+    parser.add_argument('--shard-size', type=int, default=0,
+                        help='number of sequences per shard; 0 produces a single file (default: 0)')
+    parser.add_argument('--precision', choices=['float', 'double'], default='float',
+                        help='element type of the output (default: float)')
+    args = parser.parse_args()
+
+    streams = [Stream(spec) for spec in args.streams]
+    value_format = 'f' if args.precision == 'float' else 'd'
+    data_type = DATA_TYPE_FLOAT if args.precision == 'float' else DATA_TYPE_DOUBLE
+
+    def shard_path(number):
+        if args.shard_size == 0:
+            return args.output
+        return '%s.%d' % (args.output, number)
+
+    shard_number = 0
+    writer = ShardWriter(shard_path(shard_number), streams, value_format)
+    pending = []
+    with open(args.input, 'r') as input_file:
+        for sequence in parse_sequences(input_file, streams):
+            pending.append(sequence)
+            if len(pending) == args.chunk_size:
+                writer.write_chunk(pending)
+                pending = []
+            if args.shard_size and writer.num_sequences + len(pending) >= args.shard_size:
+                if pending:
+                    writer.write_chunk(pending)
+                    pending = []
+                writer.close(data_type)
+                print('Wrote %s (%d sequences, %d chunks)'
+                      % (writer.path, writer.num_sequences, len(writer.chunks)))
+                shard_number += 1
+                writer = ShardWriter(shard_path(shard_number), streams, value_format)
+    if pending:
+        writer.write_chunk(pending)
+    if writer.num_sequences == 0 and shard_number > 0:
+        # The input size was a multiple of the shard size; drop the empty trailing shard.
+        writer.output.close()
+        os.remove(writer.path)
+    else:
+        writer.close(data_type)
+        print('Wrote %s (%d sequences, %d chunks)'
+              % (writer.path, writer.num_sequences, len(writer.chunks)))
+
+
+if __name__ == '__main__':
+    sys.exit(main())
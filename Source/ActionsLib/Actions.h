@@ -59,6 +59,8 @@ void DoCreateLabelMap(const ConfigParameters& config);
 template <typename ElemType>
 void DoParameterSVD(const ConfigParameters& config);
 template <typename ElemType>
+void DoQuantizeModel(const ConfigParameters& config);
+template <typename ElemType>
 void DoWriteWordAndClassInfo(const ConfigParameters& config);
 template <typename ElemType>
 void DoTopologyPlot(const ConfigParameters& config);
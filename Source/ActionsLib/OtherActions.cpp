@@ -16,6 +16,8 @@
 #include "Config.h"
 #include "ScriptableObjects.h"
 #include "BrainScriptEvaluator.h"
+#include "LinearAlgebraNodes.h"
+#include "InputAndParamNodes.h"
 
 #include <string>
 #include <chrono>
@@ -23,6 +25,7 @@
 #include <vector>
 #include <iostream>
 #include <queue>
+#include <regex>
 #include <set>
 #include <memory>
 #include <map>
@@ -203,6 +206,81 @@ void DoParameterSVD(const ConfigParameters& config)
 template void DoParameterSVD<float>(const ConfigParameters& config);
 template void DoParameterSVD<double>(const ConfigParameters& config);
 
+// ===========================================================================
+// DoQuantizeModel() - implements CNTK "quantize" command
+// ===========================================================================
+
+// Rewrites eligible Times nodes of a trained model into QuantizedTimes nodes, so that
+// EvalDll serves the model through the int16 BlockMultiplier GEMM without hand-editing.
+// Eligible are dense products whose weight side (input 0) is a learnable parameter; the
+// quantizers self-calibrate (per-matrix absolute max, cached for the constant weight side),
+// so no separate calibration pass over data is needed -- what must be chosen per model is
+// the bit shift that guards the int32 accumulator against overflow, which is exposed here
+// as bitShiftA/bitShiftB (see the QuantizedTimes node for the precision trade-off).
+//
+// config parameters:
+//     modelPath       - model to convert
+//     outputModelPath - where to write the converted model (default: modelPath + ".quantized")
+//     bitShiftA       - quantizer bit shift for the weight side (default 1)
+//     bitShiftB       - quantizer bit shift for the activation side (default 1)
+//     nodeNameRegex   - only convert Times nodes whose name matches (default: all)
+//     minElements     - skip products whose weight has fewer elements (default 4096;
+//                       tiny products gain nothing from the int16 path)
+template <typename ElemType>
+void DoQuantizeModel(const ConfigParameters& config)
+{
+    DEVICEID_TYPE deviceId = CPUDEVICE; // QuantizedTimes runs on the CPU only
+    wstring modelPath = config(L"modelPath");
+    wstring outputModelPath = config(L"outputModelPath", L"");
+    if (outputModelPath.empty())
+        outputModelPath = modelPath + L".quantized";
+    size_t bitShiftA = config(L"bitShiftA", "1");
+    size_t bitShiftB = config(L"bitShiftB", "1");
+    wstring nodeNameRegex = config(L"nodeNameRegex", L"");
+    size_t minElements = config(L"minElements", "4096");
+
+    ComputationNetwork net(deviceId);
+    net.Load<ElemType>(modelPath);
+
+    size_t numConverted = 0;
+    for (const auto& nodeBase : net.GetNodesWithType(OperationNameOf(TimesNode)))
+    {
+        const wstring& nodeName = nodeBase->NodeName();
+        if (!nodeNameRegex.empty() && !regex_match(nodeName, wregex(nodeNameRegex)))
+            continue;
+
+        // the weight side must be a learnable parameter, so the quantized copy can be cached
+        // across evaluations; a product of two dynamic inputs would re-quantize both per call
+        auto weight = dynamic_pointer_cast<LearnableParameter<ElemType>>(nodeBase->Input(0));
+        if (!weight)
+        {
+            fprintf(stderr, "DoQuantizeModel: skipping %ls: input 0 is not a learnable parameter\n", nodeName.c_str());
+            continue;
+        }
+        if (nodeBase->Input(0)->GetSampleLayout().GetNumElements() < minElements)
+        {
+            fprintf(stderr, "DoQuantizeModel: skipping %ls: weight has fewer than %d elements\n", nodeName.c_str(), (int) minElements);
+            continue;
+        }
+
+        auto quantizedNode = make_shared<QuantizedTimesNode<ElemType>>(deviceId, nodeName, bitShiftA, bitShiftB);
+        nodeBase->CopyTo(quantizedNode, nodeName, CopyNodeFlags::copyNodeValue); // takes over outputRank etc.
+        net.ReplaceNode(nodeName, quantizedNode);
+        numConverted++;
+    }
+
+    fprintf(stderr, "DoQuantizeModel: converted %d Times nodes to QuantizedTimes (bitShiftA=%d, bitShiftB=%d)\n",
+            (int) numConverted, (int) bitShiftA, (int) bitShiftB);
+    if (numConverted == 0)
+        fprintf(stderr, "DoQuantizeModel: WARNING: nothing to convert; writing the model unmodified.\n");
+
+    net.SaveEdited(outputModelPath); // (re-)compiles, which validates the rewritten graph, then saves
+    fprintf(stderr, "DoQuantizeModel: wrote %ls\n", outputModelPath.c_str());
+}
+
+template void DoQuantizeModel<float>(const ConfigParameters& config);
+template void DoQuantizeModel<double>(const ConfigParameters& config);
+
 // ===========================================================================
 // DoWriteWordAndClassInfo() - implements CNTK "writeWordAndClass" command
 // ===========================================================================
@@ -15,6 +15,7 @@
 #include "ConvolutionalNodes.h"
 #include "RecurrentNodes.h"
 #include "PreComputeNodes.h"
+#include "RNNCommon.h"
 
 #pragma warning(disable : 4189) // (we have lots of unused variables to show how variables can be set up)
 
@@ -169,6 +170,69 @@ ComputationNetworkPtr SimpleNetworkBuilder<ElemType>::BuildFFDNNFromDescription(
     return m_net;
 }
 
+// Checks whether the recurrent topology described by the config is the standard uniform stack
+// that cuDNN's fused RNN implementation computes: every hidden layer is recurrent, all hidden
+// layers have the same dimension, the hidden state starts at zero, and there are no per-layer
+// insertions (dropout, direct connects, lookup tables, moving-average context, gate overrides).
+// Anything else keeps the explicit PastValue unrolling, with a notice on stderr saying why.
+template <class ElemType>
+bool SimpleNetworkBuilder<ElemType>::CanBuildFusedRnnStack(const wchar_t* recurrentOp, size_t numHiddenLayers) const
+{
+    const char* reason = nullptr;
+    if (m_deviceId < 0)
+        reason = "the fused RNN stack can only be trained on a GPU";
+    else if (recurrentOp == nullptr)
+        reason = "the layer nonlinearity has no cuDNN equivalent (only RectifiedLinear and Tanh map to fused cells)";
+    else if (numHiddenLayers == 0)
+        reason = "the network has no hidden layer";
+    else if (m_recurrentLayers.size() != numHiddenLayers)
+        reason = "not every hidden layer is recurrent";
+    else if (m_defaultHiddenActivity != 0)
+        reason = "cuDNN initializes the hidden state to zero, but defaultHiddenActivity is non-zero";
+    else if (m_addDropoutNodes)
+        reason = "per-layer dropout nodes cannot be inserted into the fused stack";
+    else if (m_directConnect.size() > 0)
+        reason = "directConnect taps intermediate layer outputs";
+    else if (m_lookupTableOrder > 0)
+        reason = "lookupTable embedding layers are not folded into the fused stack";
+    else if (m_maOrder > 0)
+        reason = "maOrder is not supported by the fused stack";
+    else if (m_sparse_input)
+        reason = "cuDNN packs input sequences densely, which requires dense features";
+    else if (m_constForgetGateValue || m_constInputGateValue || m_constOutputGateValue)
+        reason = "constant gate overrides produce a nonstandard cell";
+    for (size_t i = 0; reason == nullptr && i < numHiddenLayers; i++)
+    {
+        if (m_recurrentLayers[i] != (int) i + 1)
+            reason = "the recurrent layers do not form a contiguous stack starting at the first hidden layer";
+        else if (m_layerSizes[i + 1] != m_layerSizes[1])
+            reason = "hidden layer sizes differ, but the fused stack requires a uniform hidden dimension";
+    }
+    if (reason != nullptr)
+        fprintf(stderr, "SimpleNetworkBuilder: useCuDnnRNN requested, but %s; falling back to the explicit PastValue network.\n", reason);
+    return reason == nullptr;
+}
+
+// Emits the entire recurrent stack as a single OptimizedRNNStackNode backed by cuDNN's fused
+// multi-layer RNN, replacing numLayers explicit PastValue loops. All per-layer weights live in
+// one learnable parameter whose layout is dictated by cuDNN; models saved with this node can
+// still be evaluated on the CPU through the native RNN implementation in CPUMatrix.
+template <class ElemType>
+shared_ptr<ComputationNode<ElemType>> SimpleNetworkBuilder<ElemType>::BuildFusedRnnStack(unsigned long& randomSeed, size_t inputDim, size_t hiddenSize, size_t numLayers, ComputationNodePtr input, const std::wstring& recurrentOp)
+{
+    ComputationNetworkBuilder<ElemType> builder(*m_net);
+
+    RnnAttributes rnnAttributes(/*bidirectional=*/false, numLayers, hiddenSize, recurrentOp, /*axis=*/-1);
+    auto paramDims = rnnAttributes.GetNumParameters(inputDim);
+    ComputationNodePtr w = builder.CreateLearnableParameter(L"RnnParameters", paramDims.first, paramDims.second);
+    m_net->RandomInitLearnableParameters(w, m_uniformInit, randomSeed++, m_initValueScale);
+
+    fprintf(stderr, "SimpleNetworkBuilder: emitting %d '%ls' layer(s) of dimension %d as one fused cuDNN RNN stack\n",
+            (int) numLayers, recurrentOp.c_str(), (int) hiddenSize);
+
+    return builder.OptimizedRNNStack(w, input, /*bidirectional=*/false, numLayers, hiddenSize, recurrentOp, L"RnnStack");
+}
+
 // Note: while ComputationNode and CompuationNetwork are (supposed to be) independent of ElemType, it is OK to keep this class dependent.
 template <class ElemType>
 ComputationNetworkPtr SimpleNetworkBuilder<ElemType>::BuildRNNFromDescription()
@@ -184,7 +248,20 @@ ComputationNetworkPtr SimpleNetworkBuilder<ElemType>::BuildRNNFromDescription()
 
         ComputationNodePtr input, w, b, u, pastValue, output, label, prior;
 
-        input = builder.CreateSparseInputNode(L"features", m_layerSizes[0]);
+        // When requested, emit the whole recurrence as one cuDNN-fused RNN node instead of
+        // explicit PastValue loops. cuDNN only implements ReLU and tanh cells, so networks
+        // with sigmoid layers (the default) keep the unrolled path.
+        const wchar_t* fusedOp = nullptr;
+        if (m_nonLinearFunctions[0] == OperationNameOf(RectifiedLinearNode))
+            fusedOp = L"rnnReLU";
+        else if (m_nonLinearFunctions[0] == OperationNameOf(TanhNode))
+            fusedOp = L"rnnTanh";
+        bool useFusedRnn = m_useCuDnnRNN && CanBuildFusedRnnStack(fusedOp, numHiddenLayers);
+
+        if (useFusedRnn) // cuDNN packs input sequences densely, so the features must be dense as well
+            input = builder.CreateInputNode(L"features", m_layerSizes[0]);
+        else
+            input = builder.CreateSparseInputNode(L"features", m_layerSizes[0]);
         m_net->AddToNodeGroup(L"feature", input);
 
         if (m_applyMeanVarNorm)
@@ -197,7 +274,12 @@ ComputationNetworkPtr SimpleNetworkBuilder<ElemType>::BuildRNNFromDescription()
         }
 
         int recur_idx = 0;
-        if (numHiddenLayers > 0)
+        if (useFusedRnn)
+        {
+            output = BuildFusedRnnStack(randomSeed, m_layerSizes[0], m_layerSizes[1], numHiddenLayers, input, fusedOp);
+            input = output;
+        }
+        else if (numHiddenLayers > 0)
         {
             // TODO: to figure out sparse matrix size
             u = builder.CreateLearnableParameter(L"U0", m_layerSizes[1], m_layerSizes[0]);
@@ -1257,7 +1339,13 @@ ComputationNetworkPtr SimpleNetworkBuilder<ElemType>::BuildLSTMNetworkFromDescri
 
         int recur_idx = 0;
         int offset = m_lookupTableOrder > 0 ? 1 : 0;
-        if (numHiddenLayers > 0)
+        // standard uniform LSTM stacks can be emitted as one cuDNN-fused RNN node (useCuDnnRNN=true)
+        if (numHiddenLayers > 0 && m_useCuDnnRNN && CanBuildFusedRnnStack(L"lstm", numHiddenLayers))
+        {
+            output = BuildFusedRnnStack(randomSeed, m_layerSizes[0], m_layerSizes[1], numHiddenLayers, input, L"lstm");
+            input = output;
+        }
+        else if (numHiddenLayers > 0)
         {
 
             // output = (ComputationNodePtr)BuildLSTMNodeComponent(randomSeed, 0, m_layerSizes[offset] * (offset ? m_lookupTableOrder : 1), m_layerSizes[offset + 1], input);
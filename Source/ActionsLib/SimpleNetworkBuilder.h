@@ -140,6 +140,7 @@ public:
         intargvector recurrentLayers = rLayerSizes;
         m_recurrentLayers = recurrentLayers;
         m_defaultHiddenActivity = config("defaultHiddenActivity", "0.1"); // TODO: spelling, should be -Activation
+        m_useCuDnnRNN = config("useCuDnnRNN", "false"); // emit standard recurrent stacks as one cuDNN-fused RNN node instead of explicit PastValue loops
         ConfigArray str_rnnType = config("rnnType", L"SIMPLENET"); // TODO: camelCase
 
         m_maOrder = config("maOrder", "0");
@@ -260,6 +261,10 @@ protected:
     ComputationNodePtr BuildLSTMNodeComponent(ULONG& randomSeed, size_t iLayer, size_t inputDim, size_t outputDim, ComputationNodePtr input);
     ComputationNodePtr BuildDirectConnect(unsigned long& randomSeed, size_t iLayer, size_t inputDim, size_t outputDim, ComputationNodePtr input, ComputationNodePtr toNode);
 
+    // cuDNN-fused emission of a standard recurrent stack (useCuDnnRNN=true)
+    bool CanBuildFusedRnnStack(const wchar_t* recurrentOp, size_t numHiddenLayers) const;
+    ComputationNodePtr BuildFusedRnnStack(unsigned long& randomSeed, size_t inputDim, size_t hiddenSize, size_t numLayers, ComputationNodePtr input, const std::wstring& recurrentOp);
+
     // layer is 0 based
     ComputationNodePtr ApplyNonlinearFunction(ComputationNodePtr input, const size_t layer, const std::wstring nodeName = L"");
     ComputationNodePtr AddTrainAndEvalCriterionNodes(ComputationNodePtr input, ComputationNodePtr label, ComputationNodePtr matrix = nullptr, const std::wstring trainNodeName = L"", const std::wstring evalNodeName = L"", ComputationNodePtr clspostprob = nullptr, ComputationNodePtr trans = nullptr);
@@ -337,6 +342,7 @@ protected:
     // recurrent network
     intargvector m_recurrentLayers;
     float m_defaultHiddenActivity;
+    bool m_useCuDnnRNN;
     StandardNetworkKind m_standardNetworkKind;
     int m_maOrder; // MA model order
 
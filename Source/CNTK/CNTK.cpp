@@ -57,6 +57,7 @@
 #include <queue>
 #include <set>
 #include <memory>
+#include <future>
 
 #ifndef let
 #define let const auto
@@ -81,6 +82,9 @@ void SetupProfiling(ProfilerContext& profilerContext, const ConfigParamType& con
                              config(L"profilerBufferSize", static_cast<uint64_t>(32 * 1024 * 1024)),
                              std::to_wstring(nodeRank),
                              config(L"profilerSyncGpu", true));
+
+        // per-node forward/backward timing into the custom event stream (see Globals.h)
+        Globals::SetTimeNodes(config(L"profilerTimeNodes", false));
     }
 }
 
@@ -239,6 +243,28 @@ void DoCommands(const ConfigParameters& config, const shared_ptr<MPIWrapper>& mp
 
     size_t fullEpochsOffset = 0;
 
+    // Background execution of read-only actions ('runInBackground=true' in the command block):
+    // the action runs on a worker thread while subsequent commands proceed, so that e.g. an
+    // epoch's write or eval can overlap the next training command on a spare device. A later
+    // command that names the same modelPath waits for the background action first, and all
+    // background actions are joined before DoCommands() returns. Background commands must be
+    // self-contained: they should load their model from modelPath (not from an NDL/BS network
+    // description, whose global macro state is cleared between commands) and pick their own
+    // deviceId. Not available under MPI, where all ranks must execute commands in lockstep.
+    std::vector<std::pair<std::wstring, std::future<void>>> backgroundActions; // (modelPath, completion)
+    auto waitForBackgroundActions = [&backgroundActions](const std::wstring& modelPath) // L"" = wait for all
+    {
+        for (auto& ba : backgroundActions)
+        {
+            if (ba.second.valid() && (modelPath.empty() || ba.first == modelPath))
+                ba.second.get(); // rethrows if the background action failed
+        }
+        backgroundActions.erase(std::remove_if(backgroundActions.begin(), backgroundActions.end(),
+                                               [](const std::pair<std::wstring, std::future<void>>& ba) { return !ba.second.valid(); }),
+                                backgroundActions.end());
+    };
+    const std::set<std::string> backgroundableActions = { "eval", "test", "cv", "write", "plot", "dumpNodes", "dumpNode", "dumpnode" };
+
     // execute the commands
     for (int i = 0; i < command.size(); i++)
     {
@@ -270,7 +296,38 @@ void DoCommands(const ConfigParameters& config, const shared_ptr<MPIWrapper>& mp
 
             if ((mpi == nullptr) || (commandstoRunOnAllRanks.find(thisAction) != commandstoRunOnAllRanks.end()) || mpi->IsMainNode())
             {
-                if (thisAction == "train" || thisAction == "trainRNN")
+                // an outstanding background action on this command's model must finish first
+                wstring actionModelPath = commandParams(L"modelPath", L"");
+                if (!actionModelPath.empty() && !backgroundActions.empty())
+                    waitForBackgroundActions(actionModelPath);
+
+                bool runInBackground = commandParams(L"runInBackground", false);
+                if (runInBackground && (mpi != nullptr || backgroundableActions.find(thisAction) == backgroundableActions.end()))
+                {
+                    LOGPRINTF(stderr, "WARNING: runInBackground is only supported for read-only actions without MPI; running '%s' in the foreground.\n", thisAction.c_str());
+                    runInBackground = false;
+                }
+
+                if (runInBackground)
+                {
+                    LOGPRINTF(stderr, "Running '%s' action in the background.\n", thisAction.c_str());
+                    ConfigParameters backgroundParams = commandParams; // worker thread owns its copy
+                    std::string backgroundAction = thisAction;
+                    backgroundActions.emplace_back(actionModelPath, std::async(std::launch::async, [backgroundParams, backgroundAction]()
+                    {
+                        if (backgroundAction == "eval" || backgroundAction == "test")
+                            DoEval<ElemType>(backgroundParams);
+                        else if (backgroundAction == "cv")
+                            DoCrossValidate<ElemType>(backgroundParams);
+                        else if (backgroundAction == "write")
+                            DoWriteOutput<ElemType>(backgroundParams);
+                        else if (backgroundAction == "plot")
+                            DoTopologyPlot<ElemType>(backgroundParams);
+                        else // dumpNodes and spelling variants
+                            DoDumpNodes<ElemType>(backgroundParams);
+                    }));
+                }
+                else if (thisAction == "train" || thisAction == "trainRNN")
                 {
                     if (progressTracing)
                     {
@@ -339,6 +396,10 @@ void DoCommands(const ConfigParameters& config, const shared_ptr<MPIWrapper>& mp
                 {
                     DoParameterSVD<ElemType>(commandParams);
                 }
+                else if (thisAction == "quantize")
+                {
+                    DoQuantizeModel<ElemType>(commandParams);
+                }
                 else
                 {
                     RuntimeError("unknown action: %s  in command set: %s", thisAction.c_str(), command[i].c_str());
@@ -359,6 +420,9 @@ void DoCommands(const ConfigParameters& config, const shared_ptr<MPIWrapper>& mp
                 mpi->WaitAll();
         }
     }
+
+    // all remaining background actions must finish (and surface their errors) before we return
+    waitForBackgroundActions(L"");
 }
 
 std::string TimeDateStamp()
@@ -470,6 +534,10 @@ int wmainWithBS(int argc, wchar_t* argv[]) // called from wmain which is a wrapp
         Globals::ForceDeterministicAlgorithms();
     if (config(L"forceConstantRandomSeed", false))
         Globals::ForceConstantRandomSeed();
+    if (!config(L"fastMathTensorOps", true))
+        Globals::SetFastMathTensorOps(false);
+    if (config(L"mmapWeights", false))
+        Globals::SetMemoryMapWeights(true);
 
 #ifndef CPUONLY
     auto valpp = config.Find(L"deviceId");
@@ -510,6 +578,14 @@ int wmainWithBS(int argc, wchar_t* argv[]) // called from wmain which is a wrapp
 
     Globals::SetShareNodeValueMatrices(config(L"shareNodeValueMatrices", true));
     Globals::SetGradientAccumulationOptimization(config(L"optimizeGradientAccumulation", true));
+    Globals::SetParallelForwardEval(config(L"parallelForwardEval", false));
+    Globals::SetFuseElementwiseOps(config(L"fuseElementwiseOps", false));
+    Globals::SetFuseConvolutionOps(config(L"fuseConvolutionOps", false));
+    Globals::SetFoldConstants(config(L"foldConstants", false));
+    Globals::SetAbsorbTransposes(config(L"absorbTransposes", false));
+    Globals::SetCacheCompiledNetwork(config(L"cacheCompiledNetwork", false));
+    Globals::SetSyncBatchNormalization(config(L"syncBatchNormalization", false));
+    Globals::SetEagerValueRelease(config(L"eagerValueRelease", false));
 
     TracingGPUMemoryAllocator::SetTraceLevel(config(L"traceGPUMemoryAllocations", 0));
 
@@ -632,6 +708,10 @@ int wmainOldCNTKConfig(int argc, wchar_t* argv[])
         Globals::ForceDeterministicAlgorithms();
     if (config(L"forceConstantRandomSeed", false))
         Globals::ForceConstantRandomSeed();
+    if (!config(L"fastMathTensorOps", true))
+        Globals::SetFastMathTensorOps(false);
+    if (config(L"mmapWeights", false))
+        Globals::SetMemoryMapWeights(true);
 
     // get the command param set they want
     wstring logpath = config(L"stderr", L"");
@@ -655,6 +735,14 @@ int wmainOldCNTKConfig(int argc, wchar_t* argv[])
 
     Globals::SetShareNodeValueMatrices(config(L"shareNodeValueMatrices", true));
     Globals::SetGradientAccumulationOptimization(config(L"optimizeGradientAccumulation", true));
+    Globals::SetParallelForwardEval(config(L"parallelForwardEval", false));
+    Globals::SetFuseElementwiseOps(config(L"fuseElementwiseOps", false));
+    Globals::SetFuseConvolutionOps(config(L"fuseConvolutionOps", false));
+    Globals::SetFoldConstants(config(L"foldConstants", false));
+    Globals::SetAbsorbTransposes(config(L"absorbTransposes", false));
+    Globals::SetCacheCompiledNetwork(config(L"cacheCompiledNetwork", false));
+    Globals::SetSyncBatchNormalization(config(L"syncBatchNormalization", false));
+    Globals::SetEagerValueRelease(config(L"eagerValueRelease", false));
 
     TracingGPUMemoryAllocator::SetTraceLevel(config(L"traceGPUMemoryAllocations", 0));
 
@@ -20,6 +20,9 @@
 #include <iosfwd>
 #include <algorithm>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
 #include <future>
 #include <cstddef>
 
@@ -802,6 +805,11 @@ namespace CNTK
         ///
         CNTK_API std::wstring AsString() const;
 
+        // NDArrayView objects are small and created at a high rate by view aliasing and slicing;
+        // their storage is recycled through an internal object pool.
+        CNTK_API static void* operator new(size_t size);
+        CNTK_API static void operator delete(void* block, size_t size);
+
     private:
         // Disallow copy and move construction and assignment
         NDArrayView(const NDArrayView&) = delete; NDArrayView& operator=(const NDArrayView&) = delete; NDArrayView& operator=(NDArrayView&&) = delete; NDArrayView(NDArrayView&& other) = delete;
@@ -1878,7 +1886,7 @@ private:
     inline Variable PlaceholderVariable(const NDShape& shape, ::CNTK::DataType dataType, const std::wstring& name, const std::vector<Axis>& dynamicAxes)
     {
         auto varKind = VariableKind::Placeholder;
-        return Variable(shape, varKind, dataType, nullptr, false, dynamicAxes, name, Internal::GenerateUid(varKind));
+        return Variable(shape, varKind, dataType, nullptr, false, dynamicAxes, name, /*uid (deferred) =*/ std::wstring());
     }
 
     ///
@@ -1913,7 +1921,7 @@ private:
     ///
     inline Variable InputVariable(const NDShape& shape, bool isSparse, ::CNTK::DataType dataType, bool needsGradient, const std::wstring& name /*= L""*/, const std::vector<Axis>& dynamicAxes /*= Axis::DefaultInputVariableDynamicAxes()*/)
     {
-        return Variable(shape, isSparse, dataType, needsGradient, name, dynamicAxes, Internal::GenerateUid(VariableKind::Input));
+        return Variable(shape, isSparse, dataType, needsGradient, name, dynamicAxes, /*uid (deferred) =*/ std::wstring());
     }
 
     ///
@@ -1985,7 +1993,7 @@ private:
     ///
     inline Variable OutputVariable(const NDShape& shape, ::CNTK::DataType dataType, const std::vector<Axis>& dynamicAxes, bool needsGradient, const std::wstring& name /*= L""*/)
     {
-        return Variable(shape, VariableKind::Output, dataType, nullptr, needsGradient, dynamicAxes, /*isSparse =*/ false, name, Internal::GenerateUid(VariableKind::Output));
+        return Variable(shape, VariableKind::Output, dataType, nullptr, needsGradient, dynamicAxes, /*isSparse =*/ false, name, /*uid (deferred) =*/ std::wstring());
     }
 
     static const int SentinelValueForInferParamInitRank = std::numeric_limits<int>::max();
@@ -2019,7 +2027,7 @@ private:
         /// Construct a parameter whose initial contents are a copy of the specified 'value'
         ///
         explicit Parameter(const NDArrayViewPtr& value, const std::wstring& name = L"")
-            : Parameter(value, name, Internal::GenerateUid(VariableKind::Parameter))
+            : Parameter(value, name, /*uid (deferred) =*/ std::wstring())
         {}
 
         // TODO: Constructor to move a specified NDArrayView value
@@ -2106,7 +2114,7 @@ private:
         /// Construct a Constant whose initial contents are a copy of the specified value
         ///
         Constant(const NDArrayViewPtr& value, const std::wstring& name = L"")
-            : Constant(value, name, Internal::GenerateUid(VariableKind::Constant))
+            : Constant(value, name, /*uid (deferred) =*/ std::wstring())
         {}
 
         // TODO: Constructor to move a specified NDArrayView value
@@ -2541,6 +2549,36 @@ namespace CNTK
             return CreateSequence(sampleShape, sequenceLength, colStarts, rowIndices, nonZeroValues, numNonZeroValues, true, device, readOnly);
         }
 
+        ///
+        /// Creates a new Value object containing a batch of variable length sequences, each represented
+        /// by CSC sparse input format (http://docs.nvidia.com/cuda/cusparse/#compressed-sparse-column-format-csc).
+        /// The packed sparse batch is assembled directly from the specified per-sequence CSC buffers,
+        /// concatenating the sequence columns in parallel, without creating per-sequence NDArrayView
+        /// copies or any dense intermediate storage.
+        /// Parameters:
+        ///     ElementType: data type of the created Value object. Currently, float and double are supported.
+        ///     sampleShape: the tensor shape. For sparse input, the tensor shape leading dimensionality must be the same as the total size of the tensor shape.
+        ///     sequenceLengths: the length, in samples, of each sequence in the batch.
+        ///     colStarts, rowIndices, nonZeroValues: the CSC buffers of each sequence.
+        ///     numNonZeroValues: the number of non-zero values of each sequence.
+        ///     sequenceStartFlags: A collection of boolean values. Each element represents whether the corresponding sequence is a new sequence (in case of true) or a continuation of a previous sequence (in case of false).
+        ///     device : on which device the Value object should be created.
+        ///     readOnly : the Value is read - only if this flag is true.
+        ///
+        template <typename ElementType>
+        CNTK_API static ValuePtr CreateBatchOfSequences(const NDShape& sampleShape, const std::vector<size_t>& sequenceLengths, const std::vector<const SparseIndexType*>& colStarts, const std::vector<const SparseIndexType*>& rowIndices, const std::vector<const ElementType*>& nonZeroValues, const std::vector<size_t>& numNonZeroValues, const std::vector<bool>& sequenceStartFlags, const DeviceDescriptor& device, bool readOnly = false);
+
+        ///
+        /// Creates a new Value object containing a batch of variable length sequences in CSC sparse input format.
+        /// This method does not have parameter sequenceStartFlags, and thus all sequences are new sequences.
+        /// All other parameters are same as the method above.
+        ///
+        template <typename ElementType>
+        static ValuePtr CreateBatchOfSequences(const NDShape& sampleShape, const std::vector<size_t>& sequenceLengths, const std::vector<const SparseIndexType*>& colStarts, const std::vector<const SparseIndexType*>& rowIndices, const std::vector<const ElementType*>& nonZeroValues, const std::vector<size_t>& numNonZeroValues, const DeviceDescriptor& device, bool readOnly = false)
+        {
+            return CreateBatchOfSequences(sampleShape, sequenceLengths, colStarts, rowIndices, nonZeroValues, numNonZeroValues, {}, device, readOnly);
+        }
+
         ///
         /// Destruct 'this' Value object.
         ///
@@ -3056,7 +3094,7 @@ namespace CNTK
         ///
         /// Returns the internally generated unique name of the Function
         ///
-        const std::wstring& Uid() const { return m_uid; }
+        CNTK_API const std::wstring& Uid() const;
 
         ///
         /// Returns the primitive Function at the root of the graph of Functions underlying this Function.
@@ -3398,7 +3436,12 @@ namespace CNTK
 
         FunctionPtr m_rootFunction; // nullptr for primitive Function instances
         std::wstring m_name;
-        std::wstring m_uid;
+        // The uid string is materialized lazily: constructing the Function with an empty uid only
+        // reserves m_uidNumber from the process-wide counter and the string is built from it and
+        // OpName() on the first Uid() access.
+        mutable std::wstring m_uid;
+        mutable std::atomic<bool> m_hasDeferredUid;
+        size_t m_uidNumber;
         Dictionary m_attributes;
     };
 
@@ -4458,6 +4501,34 @@ namespace CNTK
                                     bool adamax = false,
                                     AdditionalLearningOptions additionalOptions = AdditionalLearningOptions());
 
+    ///
+    /// Create an instance of the CNTK built-in LARS (layer-wise adaptive rate scaling) learner.
+    /// Momentum SGD whose learning rate is scaled per layer by the trust ratio
+    /// trustRatioCoefficient * ||w|| / (||gradient|| + epsilon), which preserves accuracy
+    /// at large minibatch sizes where plain momentum SGD degrades.
+    ///
+    CNTK_API LearnerPtr LarsLearner(const std::vector<Parameter>& parameters,
+                                    const LearningRateSchedule& learningRateSchedule,
+                                    const MomentumSchedule& momentumSchedule,
+                                    bool unitGain = DefaultUnitGainValue(),
+                                    double trustRatioCoefficient = 0.001,
+                                    double epsilon = 1e-8,
+                                    AdditionalLearningOptions additionalOptions = AdditionalLearningOptions());
+
+    ///
+    /// Create an instance of the CNTK built-in LAMB learner: Adam-style moment estimates
+    /// with a per-layer trust ratio applied to the preconditioned update, for large-batch
+    /// training of models that are usually trained with Adam.
+    ///
+    CNTK_API LearnerPtr LambLearner(const std::vector<Parameter>& parameters,
+                                    const LearningRateSchedule& learningRateSchedule,
+                                    const MomentumSchedule& momentumSchedule,
+                                    bool unitGain = DefaultUnitGainValue(),
+                                    const MomentumSchedule& varianceMomentumSchedule = DefaultVarianceMomentum,
+                                    double trustRatioCoefficient = 1.0,
+                                    double epsilon = 1e-6,
+                                    AdditionalLearningOptions additionalOptions = AdditionalLearningOptions());
+
     ///
     /// Create an instance of the CNTK built-in AdaGrad learner.
     ///
@@ -4638,6 +4709,32 @@ namespace CNTK
         ///
         CNTK_API double TestMinibatch(const std::unordered_map<Variable, ValuePtr>& arguments, std::unordered_map<Variable, ValuePtr>& outputsToFetch, const DeviceDescriptor& computeDevice = DeviceDescriptor::UseDefaultDevice());
 
+        ///
+        /// Thread-safe variant of TestMinibatch: may be invoked concurrently from multiple threads.
+        /// Parameter storage is shared across all concurrent evaluations; each concurrent call runs
+        /// on its own clone of the evaluation graph drawn from an internal pool, so only activation
+        /// workspaces are duplicated per thread. Do not mix concurrent calls to this method with
+        /// the plain TestMinibatch overloads on the same Evaluator instance.
+        ///
+        CNTK_API double TestMinibatchThreadSafe(const std::unordered_map<Variable, ValuePtr>& arguments, const DeviceDescriptor& computeDevice = DeviceDescriptor::UseDefaultDevice());
+
+        ///
+        /// Tests the model on a single sequence and returns its average evaluation criterion value
+        /// per sample. Concurrent calls are coalesced into a single batched forward pass: the first
+        /// caller waits up to the configured latency budget for further requests to arrive (or for
+        /// the batch to fill up), evaluates the batch once, and scatters the per-sequence criterion
+        /// values back to the individual callers. Each argument Value must contain exactly one dense
+        /// sequence. Thread-safe; requires the evaluation function to have dynamic axes.
+        ///
+        CNTK_API double TestSequenceBatched(const std::unordered_map<Variable, ValuePtr>& arguments, const DeviceDescriptor& computeDevice = DeviceDescriptor::UseDefaultDevice());
+
+        ///
+        /// Configures the cross-request batching used by TestSequenceBatched: the maximum number of
+        /// requests coalesced into one forward pass and the time the first request in a batch waits
+        /// for others to arrive before evaluating a partial batch.
+        ///
+        CNTK_API void SetBatchingPolicy(size_t maxBatchSize, size_t latencyBudgetInMilliseconds);
+
         ///
         /// Evaluation Function that is used as for the criterion for evaluating the trained model's quality.
         ///
@@ -4671,8 +4768,41 @@ namespace CNTK
 
         std::pair<ValuePtr, size_t> TestLocalMinibatch(const std::unordered_map<Variable, ValuePtr>& arguments, std::unordered_map<Variable, ValuePtr>& outputsToFetch, const DeviceDescriptor& computeDevice);
 
+        // Variant of TestMinibatchThreadSafe that also surfaces the aggregate criterion value and the
+        // sample count. Returns false on an empty minibatch (end of data) without evaluating anything.
+        // Used by TrainingSession to run overlapped cross validation on a background thread.
+        bool TestMinibatchThreadSafe(const std::unordered_map<Variable, ValuePtr>& arguments, std::pair<double, size_t>& errorAndCount, const DeviceDescriptor& computeDevice);
+
         void UpdateTestProgress(size_t numSamples, const ValuePtr& evalCriterion, const DeviceDescriptor& computeDevice);
 
+        // A clone of the combined eval function that shares parameter storage with the original
+        // but owns its computation network (and thus its activation workspaces), plus the
+        // variable mappings needed to translate between the original and the cloned graph.
+        struct SharedParameterClone
+        {
+            FunctionPtr combinedEvalFunction;
+            Variable evaluationFunction;
+            Variable aggregatedEvaluationFunction;
+            Variable testSampleCountVar;
+            std::unordered_map<Variable, Variable> argumentMap;
+        };
+        typedef std::shared_ptr<SharedParameterClone> SharedParameterClonePtr;
+
+        SharedParameterClonePtr AcquireSharedParameterClone();
+        void ReleaseSharedParameterClone(const SharedParameterClonePtr& clone);
+
+        // A single-sequence evaluation request waiting to be coalesced into a batched forward pass.
+        struct PendingEvalRequest
+        {
+            std::unordered_map<Variable, ValuePtr> arguments;
+            double result = 0;
+            bool completed = false;
+            std::exception_ptr error;
+        };
+        typedef std::shared_ptr<PendingEvalRequest> PendingEvalRequestPtr;
+
+        void EvaluateRequestBatch(const std::vector<PendingEvalRequestPtr>& batch, const DeviceDescriptor& computeDevice);
+
     protected:
         Evaluator(const FunctionPtr& evaluationFunction, const std::vector<ProgressWriterPtr>& progressWriters = {}, bool initializeCombined = true);
 
@@ -4702,6 +4832,16 @@ namespace CNTK
         const AccumulatorPtr m_aggregatedTestEvalCriterionValue;
         Variable             m_testSampleCountVar;
         FunctionPtr          m_combinedEvalFunction;
+
+        std::mutex m_clonePoolMutex;
+        std::vector<SharedParameterClonePtr> m_clonePool;
+        std::mutex m_testProgressMutex;
+
+        std::mutex m_batchingMutex;
+        std::condition_variable m_batchingCV;
+        std::vector<PendingEvalRequestPtr> m_pendingEvalRequests;
+        size_t m_maxBatchSize = 16;
+        size_t m_batchingLatencyBudgetInMs = 5;
     };
 
     ///
@@ -4792,6 +4932,23 @@ namespace CNTK
         ///
         CNTK_API void SummarizeTrainingProgress();
 
+        ///
+        /// Sets the number of forward/backward passes over which gradients are accumulated before
+        /// the parameter learners are invoked (and, for a distributed Trainer, before gradients
+        /// are exchanged with other workers). With the default of 1, every TrainMinibatch() call
+        /// updates the parameters. With N > 1, each TrainMinibatch() call processes one
+        /// micro-batch; every Nth call performs a single update using the gradients summed over
+        /// the N micro-batches and their combined sample count, and the intermediate calls return
+        /// the result of the most recent update. An empty minibatch (end of data) flushes a
+        /// partial accumulation cycle.
+        ///
+        CNTK_API void SetGradientAccumulationSteps(size_t numSteps);
+
+        ///
+        /// Returns the number of micro-batches over which gradients are accumulated per parameter update.
+        ///
+        size_t GradientAccumulationSteps() const { return m_gradientAccumulationSteps; }
+
     private:
         template <typename T1, typename ...CtorArgTypes>
         friend std::shared_ptr<T1> MakeSharedObject(CtorArgTypes&& ...ctorArgs);
@@ -4818,6 +4975,15 @@ namespace CNTK
         void UpdateTrainingProgress(size_t numSamples, const ValuePtr& loss, const ValuePtr& evalCriterion, const DeviceDescriptor& computeDevice);
         void AddProgressWriters(const std::vector<ProgressWriterPtr>& progressWriters);
 
+        // Micro-batch gradient accumulation, cf. SetGradientAccumulationSteps()
+        bool AccumulateGradients(std::unordered_map<Parameter, NDArrayViewPtr>& gradients, size_t& numSamples, bool& sweepEnd);
+        void AccumulateInto(NDArrayViewPtr& accumulated, const NDArrayViewPtr& value, bool firstMicrobatch);
+        void ResetGradientAccumulationCycle();
+
+        // Transfers both fused criterion scalars from the device in a single copy and caches them
+        // for PreviousMinibatchLossAverage/PreviousMinibatchEvaluationAverage.
+        void FetchFusedCriterionScalars() const;
+
         FunctionPtr m_model;
         FunctionPtr m_combinedTrainingFunction;
         FunctionPtr m_lossFunction;
@@ -4833,10 +4999,30 @@ namespace CNTK
         ValuePtr m_prevMinibatchAggregateTrainingLossValue;
         ValuePtr m_prevMinibatchAggregateEvalCriterionValue;
 
+        // On-device concatenation of the aggregated loss and evaluation criterion scalars, so that
+        // both can be fetched with a single device-to-host transfer after the forward pass.
+        FunctionPtr m_fusedCriterionFunction;
+        ValuePtr m_prevMinibatchFusedCriterionValue;
+        mutable double m_prevMinibatchLossScalar = 0;
+        mutable double m_prevMinibatchEvalCriterionScalar = 0;
+        mutable bool m_prevMinibatchScalarsValid = false;
+
         AccumulatorPtr m_aggregatedTrainingLossValue;
         AccumulatorPtr m_aggregatedTrainingEvalCriterionValue;
 
         size_t m_prevDistributedTotalNumSamples;
+
+        // micro-batch gradient accumulation, cf. SetGradientAccumulationSteps(): gradients are
+        // summed into trainer-owned buffers across N micro-batches, and the learners (and any
+        // distributed gradient exchange) run once per N
+        size_t m_gradientAccumulationSteps = 1;
+        size_t m_numAccumulatedMicrobatches = 0;
+        size_t m_accumulatedNumSamples = 0;
+        bool m_accumulatedSweepEnd = false;
+        bool m_lastUpdateResult = true;
+        std::unordered_map<Parameter, NDArrayViewPtr> m_accumulatedGradients;
+        NDArrayViewPtr m_accumulatedTrainingLoss;
+        NDArrayViewPtr m_accumulatedEvalCriterion;
     };
 
     ///
@@ -5061,6 +5247,25 @@ namespace CNTK
         ///
         bool isMultithreaded { false };
 
+        ///
+        /// Number of threads used for multithreaded deserialization (decoding) of sequences.
+        /// A non-zero value implies multithreaded deserialization; zero keeps the default
+        /// thread count (all available cores).
+        ///
+        size_t deserializationThreadCount { 0 };
+
+        ///
+        /// Number of minibatches the reader prepares ahead of the consumer; zero keeps the
+        /// default depth of one.
+        ///
+        size_t prefetchDepth { 0 };
+
+        ///
+        /// Byte budget for look-ahead chunk prefetching per worker; zero keeps a single chunk
+        /// of look-ahead.
+        ///
+        size_t prefetchBudgetInBytes { 0 };
+
         ///
         /// Deserializers to be used in the composite reader.
         ///
@@ -5305,16 +5510,25 @@ namespace CNTK
         /// crossValidationSource: a minibatch source that will be used for cross validation.
         /// crossValidationSchedule : a minibatch size schedule for cross validation.
         /// crossValidationFrequencyInSamples: frequency in samples when to perform cross validation.
+        /// runOverlapped: if true, cross validation runs on a background thread against a snapshot
+        /// of the model parameters while training continues; results are delivered to the
+        /// OnCrossValidationEnd callback on the training thread as they become available. Not
+        /// supported in distributed training, where cross validation stays inline.
+        /// overlappedDevice: the device on which overlapped cross validation is evaluated.
         ///
         CNTK_API CrossValidationConfig(const MinibatchSourcePtr& crossValidationSource,
             const MinibatchSizeSchedule& crossValidationSchedule = MinibatchSizeSchedule(64),
-            size_t crossValidationFrequencyInSamples = std::numeric_limits<size_t>::max());
+            size_t crossValidationFrequencyInSamples = std::numeric_limits<size_t>::max(),
+            bool runOverlapped = false,
+            const DeviceDescriptor& overlappedDevice = DeviceDescriptor::UseDefaultDevice());
 
     private:
         friend class TrainingSession;
         const MinibatchSourcePtr m_source;
         const MinibatchSizeSchedule m_mbSize;
         const size_t m_frequency;
+        const bool m_overlapped;
+        const DeviceDescriptor m_device;
     };
 
     ///
@@ -5408,7 +5622,11 @@ namespace CNTK
         ///
         CNTK_API void RestoreFromCheckpoint(const std::wstring& checkpointFileName);
 
-        CNTK_API virtual ~TrainingSession() {}
+        CNTK_API virtual ~TrainingSession()
+        {
+            if (m_cvThread.joinable())
+                m_cvThread.join();
+        }
 
     public:
         ///
@@ -5478,6 +5696,12 @@ namespace CNTK
         void ReportProgress(size_t currentIndex);
         void Test(const DeviceDescriptor& computeDevice);
 
+        // Overlapped cross validation.
+        bool ScheduleOverlappedCrossValidation(size_t currentIndex);
+        void RunOverlappedCrossValidation(size_t currentIndex, const DeviceDescriptor& computeDevice);
+        bool DeliverOverlappedCrossValidationResults();
+        void FinishOverlappedCrossValidation();
+
         size_t m_parallelAfterSamples;
         size_t m_workerRank;
         size_t m_numberOfWorkers;
@@ -5496,6 +5720,21 @@ namespace CNTK
         CheckpointConfig m_checkpoint;
         CrossValidationConfig m_cv;
         TestConfig m_test;
+
+        // Overlapped cross validation state. The background thread only evaluates and records its
+        // result here; the OnCrossValidationEnd callback is always invoked on the training thread.
+        struct CrossValidationResult
+        {
+            size_t index;
+            double averageError;
+            size_t numberOfSamples;
+            size_t numberOfMinibatches;
+        };
+        std::thread m_cvThread;
+        std::mutex m_cvResultMutex;
+        std::vector<CrossValidationResult> m_pendingCVResults;
+        std::exception_ptr m_cvError;
+        std::atomic<bool> m_cvInFlight;
     };
 
     ///
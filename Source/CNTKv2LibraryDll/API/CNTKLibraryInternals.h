@@ -36,6 +36,10 @@
 #include <unordered_map>
 #include <stdlib.h>
 #include <string.h>
+#include <ctime>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #pragma warning(disable: 4702 4127)
 
@@ -238,6 +242,7 @@ namespace CNTK
         CNTK_API FunctionPtr Slice(const Variable& operand, const std::vector<Axis>& axis, const std::vector<int>& beginIndex, const std::vector<int>& endIndex, const std::wstring& name = L"");
         CNTK_API FunctionPtr ReduceElements(const Variable& operand, const std::wstring& reductionOpName, const Axis& axis, const std::wstring& name = L"");
         CNTK_API FunctionPtr ReduceElements(const Variable& operand, const std::wstring& reductionOpName, const Axis& axis, bool keepReducedDimensions, const std::wstring& name = L"");
+        CNTK_API FunctionPtr ReduceElements(const Variable& operand, const std::wstring& reductionOpName, const std::vector<Axis>& axes, bool keepReducedDimensions, const std::wstring& name = L"");
         CNTK_API FunctionPtr CosineDistanceWithNegativeSamples(const Variable& leftOperand, const Variable& rightOperand, const Variable& shiftWindow, const Variable& numberOfNegativeSamples, const std::wstring& name = L"");
         CNTK_API FunctionPtr Convolution(const Variable& convolutionMap, const Variable& operand, const NDShape& strides, const std::vector<bool>& sharing, const std::vector<bool>& autoPadding,
                                          bool transpose, const NDShape& outputShape, size_t maxTempMemSizeInSamples, const std::wstring& name = L"");
@@ -245,6 +250,12 @@ namespace CNTK
         // This is meant for debugging purposes only and is very likely to be deprecated in the future.
         CNTK_API void SaveAsLegacyModel(const FunctionPtr& rootFunction, const std::wstring& modelFile);
 
+        // Saves the model in the chunked streaming format: parameter payloads are written
+        // directly from their buffers in fixed-size chunks (optionally compressed) instead of
+        // first building the complete serialized image in memory. Models written this way are
+        // loaded transparently by Function::Load.
+        CNTK_API void SaveAsStreamingModel(const FunctionPtr& rootFunction, const std::wstring& modelFile, bool compressPayloads = true);
+
         CNTK_API size_t NewUniqueId();
 
         CNTK_API size_t GenerateRandomSeed(bool perWorkerLocalValue = false);
@@ -263,6 +274,12 @@ namespace CNTK
         CNTK_API void SetAutomaticUnpackingOfPackedValues(bool disable);
         CNTK_API bool IsAutomaticUnpackingOfPackedValuesDisabled();
 
+        // Enables evaluating elementwise ops over Constant operands at Function construction time,
+        // replacing the op with a Constant holding the result. Off by default since folded
+        // Constants no longer observe subsequent SetValue() updates of their source Constants.
+        CNTK_API void SetConstantFoldingInFunctionConstruction(bool enable);
+        CNTK_API bool IsConstantFoldingInFunctionConstructionEnabled();
+
         CNTK_API void SetComputationNetworkTraceLevel(int traceLevel);
         int GetComputationNetworkTraceLevel();
 
@@ -346,6 +363,8 @@ namespace CNTK
             /// Record a value of some metric at a particular step.
             /// For example, to record average value of a loss function for the n-th minibatch, one could call this:
             ///     WriteValue("mb_avg_loss", lossValue, minibatchIdx);
+            /// The record is queued and serialized to disk by a background writer thread, so this
+            /// call returns without performing any file I/O.
             ///
             CNTK_API void WriteValue(const std::wstring& name, float value, uint64_t step);
 
@@ -361,11 +380,25 @@ namespace CNTK
             CNTK_API bool Close();
 
         private:
+            // A metric record queued by WriteValue and serialized by the background writer thread.
+            struct PendingEvent
+            {
+                std::wstring name;
+                float value;
+                uint64_t step;
+                time_t wallTime;
+            };
+
             void Init();
             void WriteModel();
             void WriteRecord(const std::string& data);
             void WriteVersion(time_t time);
 
+            void EnsureWriterThread();
+            void StopWriterThread();
+            void WriterThreadProc();
+            bool FlushFile();
+
             // Disable copy-construction and assignment.
             TensorBoardFileWriter(const TensorBoardFileWriter& other) = delete;
             TensorBoardFileWriter& operator=(const TensorBoardFileWriter& other) = delete;
@@ -374,6 +407,14 @@ namespace CNTK
             const std::wstring m_dir;
             FILE* m_file;
             std::wstring m_fileName;
+
+            std::mutex m_queueMutex;
+            std::condition_variable m_queueCV;
+            std::vector<PendingEvent> m_pendingEvents;
+            std::thread m_writerThread;
+            bool m_shutdownWriter = false;
+            bool m_flushRequested = false;
+            bool m_flushSucceeded = true;
         };
 
         ///
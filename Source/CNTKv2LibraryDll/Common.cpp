@@ -148,6 +148,17 @@ namespace CNTK
             return s_disableAutomaticUnpackingOfPackedValues.load();
         }
 
+        std::atomic<bool> s_constantFoldingInFunctionConstruction(false);
+        void SetConstantFoldingInFunctionConstruction(bool enable)
+        {
+            s_constantFoldingInFunctionConstruction.store(enable);
+        }
+
+        bool IsConstantFoldingInFunctionConstructionEnabled()
+        {
+            return s_constantFoldingInFunctionConstruction.load();
+        }
+
         void EnableForwardValuesSharing()
         {
             Microsoft::MSR::CNTK::Globals::SetShareNodeValueMatrices(/* enable = */ true);
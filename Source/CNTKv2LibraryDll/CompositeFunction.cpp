@@ -940,9 +940,17 @@ namespace CNTK
                     if (functionConfig.Contains(PrimitiveFunction::AttributeNameReductionKeepDimensions))
                         keepDimensions = functionConfig[PrimitiveFunction::AttributeNameReductionKeepDimensions].Value<bool>();
 
-                    auto reductionAxis = functionConfig[PrimitiveFunction::AttributeNameAxis].Value<Axis>();
                     auto reductionOpName = functionConfig[PrimitiveFunction::AttributeNameReductionOpName].Value<std::wstring>();
-                    computationNodePtr = New<ReduceElementsNode<ElementType>>(network->GetDeviceId(), internalNodeName, reductionOpName, AsCNTKInternalAxisIdx(reductionAxis), keepDimensions);
+                    if (functionConfig.Contains(PrimitiveFunction::AttributeNameAxisVec))
+                    {
+                        auto reductionAxes = AsVector<Axis>(functionConfig[PrimitiveFunction::AttributeNameAxisVec].Value<std::vector<DictionaryValue>>());
+                        computationNodePtr = New<ReduceElementsNode<ElementType>>(network->GetDeviceId(), internalNodeName, reductionOpName, AsCNTKInternalAxisIdx(reductionAxes), keepDimensions);
+                    }
+                    else
+                    {
+                        auto reductionAxis = functionConfig[PrimitiveFunction::AttributeNameAxis].Value<Axis>();
+                        computationNodePtr = New<ReduceElementsNode<ElementType>>(network->GetDeviceId(), internalNodeName, reductionOpName, AsCNTKInternalAxisIdx(reductionAxis), keepDimensions);
+                    }
                     break;
                 }
                 case PrimitiveOpType::BatchNormalization:
@@ -1842,6 +1850,151 @@ namespace CNTK
         return backpropStatePtr;
     }
 
+    PreparedForwardEvaluationPtr CompositeFunction::PrepareForForwardEvaluation(const std::vector<Variable>& arguments,
+                                                                                const std::vector<Variable>& outputs,
+                                                                                const DeviceDescriptor& computeDevice)
+    {
+        if (outputs.empty())
+            InvalidArgument("At least one output has to be specified when preparing a forward evaluation handle for the Function '%S'.", this->AsString().c_str());
+
+        auto dataType = DataType::Unknown;
+        for (auto& argument : arguments)
+        {
+            // Free static axes require per-call shape inference and possible network revalidation,
+            // which is exactly the bookkeeping the prepared handle elides; only Forward supports them
+            if (argument.Shape().HasFreeDimension())
+                InvalidArgument("Function '%S' PrepareForForwardEvaluation: Argument '%S' has a free static axis; such arguments are only supported by Forward.",
+                                this->AsString().c_str(), argument.AsString().c_str());
+
+            if (dataType == DataType::Unknown)
+                dataType = argument.GetDataType();
+            else if (dataType != argument.GetDataType())
+                LogicError("Function '%S' PrepareForForwardEvaluation: The DataType of all arguments must be same.", this->AsString().c_str());
+        }
+
+        if (dataType == DataType::Unknown)
+            dataType = outputs.front().GetDataType();
+
+        // The bound arguments must cover the dependencies of every bound output
+        std::unordered_set<Variable> boundArguments(arguments.begin(), arguments.end());
+        std::unordered_set<Variable> requestedOutputVariables(outputs.begin(), outputs.end());
+        std::vector<Variable> missingRequiredArguments;
+        for (auto& outputVariable : outputs)
+        {
+            for (auto& requiredArgument : GetArgumentDependencies(outputVariable))
+            {
+                if (boundArguments.find(requiredArgument) == boundArguments.end())
+                    missingRequiredArguments.push_back(requiredArgument);
+            }
+        }
+
+        if (!missingRequiredArguments.empty())
+            InvalidArgument("%d required arguments '%S', that the requested output(s) '%S' depend on, are missing from the arguments bound to the forward evaluation handle.",
+                            (int)missingRequiredArguments.size(), NamedListString(missingRequiredArguments).c_str(), NamedListString(requestedOutputVariables).c_str());
+
+        // Compile (or revalidate) the network upfront so Run never has to
+        if (dataType == DataType::Float)
+            GetComputationNetwork<float>(computeDevice, {}, requestedOutputVariables, {}, true);
+        else if (dataType == DataType::Double)
+            GetComputationNetwork<double>(computeDevice, {}, requestedOutputVariables, {}, true);
+        else
+            InvalidArgument("Unsupported DataType %s", DataTypeName(dataType));
+
+        auto handle = MakeSharedObject<PreparedForwardEvaluation>(std::static_pointer_cast<CompositeFunction>(this->shared_from_this()), arguments, outputs, dataType);
+        handle->Bind();
+        return handle;
+    }
+
+    PreparedForwardEvaluation::PreparedForwardEvaluation(const CompositeFunctionPtr& composite, const std::vector<Variable>& arguments, const std::vector<Variable>& outputs, DataType dataType)
+        : m_composite(composite), m_arguments(arguments), m_outputs(outputs), m_dataType(dataType)
+    {}
+
+    void PreparedForwardEvaluation::Bind()
+    {
+        m_network = m_composite->m_computationNetwork;
+
+        m_argumentNodes.clear();
+        for (auto& argument : m_arguments)
+            m_argumentNodes.push_back(m_composite->m_variableToNodeMap.at(argument));
+
+        m_outputNodes.clear();
+        for (auto& output : m_outputs)
+            m_outputNodes.push_back(m_composite->m_variableToNodeMap.at(output));
+
+        auto dropoutNodes = m_network->GetNodesWithType(OperationNameOf(DropoutNode));
+        m_dropoutNodes.assign(dropoutNodes.begin(), dropoutNodes.end());
+    }
+
+    void PreparedForwardEvaluation::Run(const std::vector<ValuePtr>& argumentValues, std::vector<ValuePtr>& outputValues)
+    {
+        if (argumentValues.size() != m_arguments.size())
+            InvalidArgument("Function '%S' prepared evaluation: %d argument values provided but the handle was prepared with %d arguments.",
+                            m_composite->AsString().c_str(), (int)argumentValues.size(), (int)m_arguments.size());
+
+        outputValues.resize(m_outputs.size());
+
+        // An interleaved Forward call may have recompiled the network; re-resolve the node bindings in that case
+        if (m_network != m_composite->m_computationNetwork)
+            Bind();
+
+        std::unordered_map<MBLayoutPtr, Variable> layoutsPopulated;
+        for (size_t i = 0; i < m_arguments.size(); ++i)
+        {
+            switch (m_dataType)
+            {
+            case DataType::Float:
+                CompositeFunction::PopulateComputationNodeValue<float>({ m_arguments[i], argumentValues[i] }, m_argumentNodes[i], layoutsPopulated);
+                break;
+            case DataType::Double:
+                CompositeFunction::PopulateComputationNodeValue<double>({ m_arguments[i], argumentValues[i] }, m_argumentNodes[i], layoutsPopulated);
+                break;
+            default:
+                LogicError("Function '%S' prepared evaluation: Unsupported DataType %s.", m_composite->AsString().c_str(), DataTypeName(m_dataType));
+                break;
+            }
+        }
+
+        m_network->BumpEvalTimeStamp(m_argumentNodes);
+
+        for (auto& dropoutNode : m_dropoutNodes)
+            dropoutNode->SetEvalTimeStampOutdatedWrtAll();
+
+        // Parameters may still change between calls (e.g. a trainer updating shared parameters);
+        // keep the timestamp scan from Forward so such updates are picked up
+        for (auto& paramTimeStampRecord : m_composite->m_lastRecordedParameterValueTimeStamps)
+        {
+            auto parameter = paramTimeStampRecord.first;
+            auto prevTimeStamp = paramTimeStampRecord.second;
+            auto newTimeStamp = parameter.CurrentValueTimeStamp();
+            if (newTimeStamp > prevTimeStamp)
+            {
+                paramTimeStampRecord.second = newTimeStamp;
+                m_composite->m_variableToNodeMap.at(parameter)->BumpEvalTimeStamp();
+            }
+        }
+
+        // Usually empty for a pure inference function; mirrors Forward for composites also used in training
+        for (auto& backpropRoot : m_composite->m_currentBackpropRoots)
+            m_composite->m_variableToNodeMap.at(backpropRoot)->SetEvalTimeStampOutdatedWrtAll();
+
+        m_composite->ClearExistingOutputOrGradientStorageReferences();
+
+        ScopedNetworkOperationMode modeGuard(m_network, NetworkOperationMode::inferring);
+
+        m_network->ForwardProp(m_outputNodes);
+        m_network->PostForwardAndBackProp(m_outputNodes);
+
+        for (size_t i = 0; i < m_outputs.size(); ++i)
+        {
+            bool noValueStorageProvided = (outputValues[i] == nullptr);
+            CompositeFunction::GetNodeOutputOrGradient(m_outputs[i], outputValues[i], m_outputNodes[i], /*getGradient =*/ false);
+
+            auto packedVarValue = std::dynamic_pointer_cast<PackedValue>(outputValues[i]);
+            if (noValueStorageProvided && packedVarValue && packedVarValue->IsPacked())
+                m_composite->m_existingNetworkStorageReferences.push_back(packedVarValue);
+        }
+    }
+
     /*virtual*/ void CompositeFunction::Backward(const BackPropStatePtr& state,
                                                  const std::unordered_map<Variable, ValuePtr>& rootGradientValues,
                                                  std::unordered_map<Variable, ValuePtr>& backPropagatedGradientValuesForInputs)
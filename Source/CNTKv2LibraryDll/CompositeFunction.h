@@ -34,6 +34,9 @@ namespace CNTK
     class CompositeFunction;
     typedef std::shared_ptr<CompositeFunction> CompositeFunctionPtr;
 
+    class PreparedForwardEvaluation;
+    typedef std::shared_ptr<PreparedForwardEvaluation> PreparedForwardEvaluationPtr;
+
     ///
     /// Represents a symbolic computation with zero or more input arguments and one or more outputs.
     /// Opposed to primitive functions, a composite function is composed of other Function instances whose inputs and outputs are wired together.
@@ -47,6 +50,7 @@ namespace CNTK
         friend class Trainer;
         friend class CompositeMinibatchSource;
         friend class PackedValue;
+        friend class PreparedForwardEvaluation;
 
         template <typename T, typename ...CtorArgTypes>
         friend inline std::shared_ptr<T> MakeSharedObject(CtorArgTypes&& ...ctorArgs);
@@ -90,6 +94,14 @@ namespace CNTK
                                  const std::unordered_set<Variable>& outputsToRetainBackwardStateFor,
                                  const std::unordered_set<Variable>& inputsToExcludeGradientsFor);
 
+        // Binds a fixed set of arguments and outputs once and returns a lightweight handle whose Run
+        // method skips the per-call argument validation, dependency resolution and Variable-to-node
+        // map lookups that Forward performs. Evaluation only (no backprop state is retained); intended
+        // for low-latency repeated inference with an unchanging call signature.
+        PreparedForwardEvaluationPtr PrepareForForwardEvaluation(const std::vector<Variable>& arguments,
+                                                                 const std::vector<Variable>& outputs,
+                                                                 const DeviceDescriptor& computeDevice);
+
         virtual BackPropStatePtr Forward(const std::vector<ValuePtr>& /*inputValues*/,
                                          std::unordered_map<Variable, ValuePtr>& /*outputs*/,
                                          const DeviceDescriptor& /*computeDevice*/,
@@ -382,4 +394,42 @@ namespace CNTK
         // 3 -- store internal function state directly in the attributes dictionary.
         static const size_t s_serializationVersion = 3;
     };
+
+    ///
+    /// A pre-bound evaluation handle for a CompositeFunction, created via CompositeFunction::PrepareForForwardEvaluation.
+    /// The argument and output descriptors are validated and resolved to their ComputationNodes once, at creation;
+    /// Run then only populates the input nodes, runs the forward pass and wraps the outputs, so repeated inference
+    /// calls with the same signature pay none of the per-call bookkeeping of Forward.
+    ///
+    class PreparedForwardEvaluation final
+    {
+        friend class CompositeFunction;
+
+        template <typename T, typename ...CtorArgTypes>
+        friend inline std::shared_ptr<T> MakeSharedObject(CtorArgTypes&& ...ctorArgs);
+
+    public:
+        // Evaluates the bound outputs for the given argument values. 'argumentValues' must parallel the
+        // argument list the handle was prepared with; 'outputValues' parallels the output list and null
+        // entries are populated with Value objects aliasing the network's output storage.
+        void Run(const std::vector<ValuePtr>& argumentValues, std::vector<ValuePtr>& outputValues);
+
+    private:
+        PreparedForwardEvaluation(const CompositeFunctionPtr& composite, const std::vector<Variable>& arguments, const std::vector<Variable>& outputs, DataType dataType);
+
+        // Resolves the computation nodes for the bound variables. Rerun if the composite's network is
+        // recompiled underneath us (e.g. by an interleaved Forward call).
+        void Bind();
+
+        CompositeFunctionPtr m_composite;
+        std::vector<Variable> m_arguments;
+        std::vector<Variable> m_outputs;
+        DataType m_dataType;
+
+        // Node bindings; only valid for m_network.
+        Microsoft::MSR::CNTK::ComputationNetworkPtr m_network;
+        std::vector<Microsoft::MSR::CNTK::ComputationNodeBasePtr> m_argumentNodes;
+        std::vector<Microsoft::MSR::CNTK::ComputationNodeBasePtr> m_outputNodes;
+        std::vector<Microsoft::MSR::CNTK::ComputationNodeBasePtr> m_dropoutNodes;
+    };
 }
@@ -131,6 +131,14 @@ namespace CNTK
                 PrepaireZeroGradients(gradientValues, info);
             ConvertToOrdered(gradientValues, m_gradientBuffer);
 
+            // When the communicator supports per-buffer completion callbacks and the learner can
+            // consume gradients one parameter at a time, overlap the aggregation with the weight
+            // updates instead of waiting for the slowest collective first.
+            auto mpiCommunicator = std::dynamic_pointer_cast<MPICommunicatorImpl>(m_communicator);
+            auto learnerBase = std::dynamic_pointer_cast<LearnerBase>(m_learner);
+            if (mpiCommunicator != nullptr && learnerBase != nullptr)
+                return UpdateAsGradientsArrive(mpiCommunicator, learnerBase, info);
+
             std::vector<NDArrayViewPtr> valuesToAggregate;
             for (const auto& i : m_gradientBuffer)
                 valuesToAggregate.push_back(i.second);
@@ -154,4 +162,47 @@ namespace CNTK
 
         return m_learner->Update(gradientValues, info.numberOfSamples, info.atEndOfSweep);
     }
+
+    bool DataParallelDistributedLearner::UpdateAsGradientsArrive(
+        const std::shared_ptr<MPICommunicatorImpl>& communicator,
+        const std::shared_ptr<LearnerBase>& learner,
+        MinibatchInfo& info)
+    {
+        // Aggregate the control values (loss, eval criterion, sample count) up front with a
+        // blocking call, so that the aggregated sample count is available to every parameter
+        // update that follows.
+        std::vector<NDArrayViewPtr> controlValues;
+        controlValues.push_back(info.evalCriterionValue);
+        controlValues.push_back(info.trainingLossValue);
+
+        auto sampleCountValue = MakeSharedObject<NDArrayView>(static_cast<double>(info.numberOfSamples), NDShape{}, DeviceDescriptor::CPUDevice());
+        controlValues.push_back(sampleCountValue);
+
+        m_communicator->AggregateInPlace(controlValues, m_communicator->Workers());
+        info.numberOfSamples = static_cast<size_t>(*sampleCountValue->WritableDataBuffer<double>());
+
+        std::vector<NDArrayViewPtr> gradients;
+        gradients.reserve(m_gradientBuffer.size());
+        for (const auto& i : m_gradientBuffer)
+            gradients.push_back(i.second);
+
+        auto profWeights = Microsoft::MSR::CNTK::ScopeProfile(Microsoft::MSR::CNTK::profilerEvtMainWeights);
+
+        bool updating = !info.IsEmpty() && learner->BeginStreamingUpdate(info.numberOfSamples);
+        communicator->AggregateInPlace(
+            gradients,
+            [this, updating, &learner, &info](size_t valueIndex)
+            {
+                if (updating)
+                    learner->UpdateParameter(m_gradientBuffer[valueIndex].first, m_gradientBuffer[valueIndex].second, info.numberOfSamples);
+            },
+            m_communicator->Workers());
+
+        if (updating)
+            learner->EndStreamingUpdate(info.numberOfSamples, info.atEndOfSweep);
+
+        m_sampleCount += info.numberOfSamples;
+        m_gradientBuffer.clear();
+        return updating;
+    }
 }
@@ -10,6 +10,9 @@
 
 namespace CNTK
 {
+    class MPICommunicatorImpl;
+    class LearnerBase;
+
     ///
     /// Distributed Trainer.
     ///
@@ -20,5 +23,14 @@ namespace CNTK
 
         // Optional override that gets called per minibatch after finishing gradient computation but before updating model parameters
         bool Update(std::unordered_map<Parameter, NDArrayViewPtr>& gradientValues, MinibatchInfo& trainingSampleCount) override;
+
+    private:
+        // Aggregates the gradients in m_gradientBuffer with non-blocking collectives and updates
+        // each parameter as its aggregation lands, instead of waiting for the slowest collective
+        // before touching any weights.
+        bool UpdateAsGradientsArrive(
+            const std::shared_ptr<MPICommunicatorImpl>& communicator,
+            const std::shared_ptr<LearnerBase>& learner,
+            MinibatchInfo& info);
     };
 }
\ No newline at end of file
@@ -284,6 +284,123 @@ namespace CNTK
         AggregateImpl(values, values, sendToWorkers);
     }
 
+    void MPICommunicatorImpl::AggregateInPlace(
+        const std::vector<NDArrayViewPtr>& values,
+        const std::function<void(size_t valueIndex)>& onValueAggregated,
+        const std::unordered_set<DistributedWorkerDescriptor>& sendToWorkers)
+    {
+        CheckWorkers(sendToWorkers);
+
+        auto numValues = values.size();
+        if (numValues == 0)
+            return;
+
+        if (m_mpi->NumNodesInUse() == 1) // No need to aggregate anything.
+        {
+            for (size_t i = 0; i < numValues; ++i)
+                onValueAggregated(i);
+            return;
+        }
+
+        std::vector<NDArrayViewPtr> valuesToAggregate(values);
+        Initialize(valuesToAggregate);
+
+        auto device = GetNonCPUDevice(valuesToAggregate);
+        if (device.Type() != DeviceKind::CPU)
+        {
+            // Since we will be copying the gradients asynchronously, let us
+            // ensure that the gradient matrices have been computed before starting to aggregate
+            // them asynchronously on another thread. This essentially means that when we are using
+            // a GPU device, we will synchronize on the main GPU compute stream before starting
+            // the gradient aggregation asynchronously on a separate stream
+            std::unique_ptr<MatrixComputeStreamEvent> mainStreamSyncEvent(MatrixComputeStreamEvent::Create(device.Id()));
+            mainStreamSyncEvent->SynchronizeDataTransferFetchStreamWithEvent<float>();
+        }
+
+        // BUGBUG: assuming the all values on the same device
+        if (m_nccl == nullptr)
+        {
+            m_nccl.reset(new NcclComm(AsCNTKImplDeviceId(valuesToAggregate[0]->Device()), m_mpi));
+        }
+
+        // For all values residing on GPU initiate async transfer to CPU buffers if needed
+        CopyDataFromGPUToCPU(valuesToAggregate);
+
+        std::vector<MPI_Request> allReduceRequests;
+        std::vector<size_t> requestValueIndices;     // value index of each entry in allReduceRequests
+        std::vector<size_t> streamBoundValueIndices; // values reduced without an MPI request (NCCL or GPUDirect RDMA)
+        for (size_t i = 0; i < numValues; ++i)
+        {
+            auto inputValue = valuesToAggregate[i];
+
+            if (ShouldCopyDataToCPU(inputValue))
+            {
+                m_gpuDataTransferers[i]->WaitForCopyGPUToCPUAsync();
+            }
+
+            auto numElements = inputValue->Shape().TotalSize();
+            auto dataType = inputValue->GetDataType();
+
+            void* data = (ShouldCopyDataToCPU(inputValue)) ? m_intermediateCPUBuffers[i].data.get() : GetDataBuffer(inputValue);
+
+            auto numRequestsBefore = allReduceRequests.size();
+            bool dataOnCPU = (inputValue->Device() == DeviceDescriptor::CPUDevice());
+            if (dataType == DataType::Float)
+            {
+                AllReduceGradients(static_cast<float*>(data), static_cast<float*>(data), numElements, allReduceRequests, dataOnCPU);
+            }
+            else if (dataType == DataType::Double)
+            {
+                AllReduceGradients(static_cast<double*>(data), static_cast<double*>(data), numElements, allReduceRequests, dataOnCPU);
+            }
+            else
+                LogicError("MPICommunicator: Unknown DataType.");
+
+            if (allReduceRequests.size() == numRequestsBefore)
+                streamBoundValueIndices.push_back(i);
+            else
+                requestValueIndices.push_back(i);
+        }
+
+        // Values reduced over NCCL or GPUDirect RDMA complete together once the stream syncs;
+        // they never go through the intermediate CPU buffers.
+        if (m_nccl->IsSupported())
+        {
+            m_nccl->Sync();
+        }
+        for (auto valueIndex : streamBoundValueIndices)
+            onValueAggregated(valueIndex);
+
+        // Drain the non-blocking all-reduces in completion order, copying each gpu-bound result
+        // back to the device before reporting it done.
+        size_t numAllReduceRequestsCompleted = 0;
+        while (numAllReduceRequestsCompleted < allReduceRequests.size())
+        {
+            int idx = MPI_UNDEFINED;
+            m_mpi->WaitAny(allReduceRequests.data(), (int)allReduceRequests.size(), &idx);
+            if (idx == MPI_UNDEFINED)
+            {
+                break;
+            }
+
+            numAllReduceRequestsCompleted++;
+
+            auto valueIndex = requestValueIndices[idx];
+            auto value = valuesToAggregate[valueIndex];
+
+            if (ShouldCopyDataToCPU(value))
+            {
+                auto size = GetBufferSize(value);
+                auto& transferer = m_gpuDataTransferers[valueIndex];
+                auto& buffer = m_intermediateCPUBuffers[valueIndex];
+                transferer->CopyCPUToGPUAsync(buffer.data.get(), size, GetDataBuffer(value));
+                transferer->WaitForCopyCPUToGPUAsync();
+            }
+
+            onValueAggregated(valueIndex);
+        }
+    }
+
     void  MPICommunicatorImpl::AggregateImpl(
         const std::vector<NDArrayViewPtr>& inputValues,
         const std::vector<NDArrayViewPtr>& outputValues,
@@ -327,10 +444,11 @@ namespace CNTK
         }
 
         // Do the packing to reduce the number of MPI requests.
-        // Do not re-allocating the continous buffer if existing buffer size equals to required one.
-        m_aggregationBufferFloat = SetContinuousBuffer<float>(packedFloatGradientsIndex, packedFloatGradientsSizeInBytes, inputValues, outputValues,
+        // The fusion buffers are persistent: they are kept across aggregations and only grow,
+        // so steady-state minibatches do no allocator work here.
+        SetContinuousBuffer(m_aggregationBufferFloat, packedFloatGradientsIndex, packedFloatGradientsSizeInBytes, inputValues, outputValues,
             valuesToAggregate, valuesAfterAggregate);
-        m_aggregationBufferDouble = SetContinuousBuffer<double>(packedDoubleGradientsIndex, packedDoubleGradientsSizeInBytes, inputValues, outputValues,
+        SetContinuousBuffer(m_aggregationBufferDouble, packedDoubleGradientsIndex, packedDoubleGradientsSizeInBytes, inputValues, outputValues,
             valuesToAggregate, valuesAfterAggregate);
 
         PackToContinuousBuffer(m_aggregationBufferFloat.get(), packedFloatGradientsIndex, inputValues, outputValues, valuesToAggregate, valuesAfterAggregate);
@@ -474,14 +592,19 @@ namespace CNTK
     }
 
     template <typename ElemType>
-    std::unique_ptr<Matrix<ElemType>> MPICommunicatorImpl::SetContinuousBuffer(std::vector<size_t>& packedGradientsIndex, size_t packedGradientsSizeInBytes,
+    void MPICommunicatorImpl::SetContinuousBuffer(std::unique_ptr<Matrix<ElemType>>& aggregationBuffer,
+        std::vector<size_t>& packedGradientsIndex, size_t packedGradientsSizeInBytes,
         const std::vector<NDArrayViewPtr>& inputValues, const std::vector<NDArrayViewPtr>& outputValues,
         std::vector<NDArrayViewPtr>& valuesToAggregate, std::vector<NDArrayViewPtr>& valuesAfterAggregate)
     {
         if (packedGradientsIndex.size() > 1)
         {
-            return std::unique_ptr<Matrix<ElemType>>{new (std::nothrow) Matrix<ElemType>(1, packedGradientsSizeInBytes / sizeof(ElemType),
-                AsCNTKImplDeviceId(inputValues[packedGradientsIndex[0]]->Device()))};
+            size_t numElements = packedGradientsSizeInBytes / sizeof(ElemType);
+            auto deviceId = AsCNTKImplDeviceId(inputValues[packedGradientsIndex[0]]->Device());
+            // Reuse the existing fusion buffer if it lives on the right device and is big enough;
+            // only the first aggregation (or a grown set of packed gradients) allocates.
+            if (aggregationBuffer == nullptr || aggregationBuffer->GetDeviceId() != deviceId || aggregationBuffer->GetNumElements() < numElements)
+                aggregationBuffer.reset(new (std::nothrow) Matrix<ElemType>(1, numElements, deviceId));
         }
         else if (packedGradientsIndex.size() == 1)
         {
@@ -489,7 +612,6 @@ namespace CNTK
             valuesAfterAggregate.push_back(outputValues[packedGradientsIndex.front()]);
             packedGradientsIndex.clear();
         }
-        return std::unique_ptr<Matrix<ElemType>>{ nullptr };
     }
 
     template <typename ElemType>
@@ -519,7 +641,9 @@ namespace CNTK
             aggregationBuffer->ColumnSlice(offset, gradient->GetNumElements()).AssignValuesOf(gradient->Reshaped(1, gradient->GetNumElements()));
             offset += gradient->GetNumElements();
         }
-        ::CNTK::NDShape shape{ aggregationBuffer->GetNumElements() };
+        // the persistent buffer may be larger than this aggregation's payload, so the view
+        // (and thereby the allreduce) covers only the packed elements
+        ::CNTK::NDShape shape{ offset };
         auto data = ::CNTK::MakeSharedObject<::CNTK::NDArrayView>(inputValues[packedGradientsIndex[0]]->GetDataType(), shape, aggregationBuffer->Data(),
             offset * sizeof(ElemType), inputValues[packedGradientsIndex[0]]->Device());
         valuesToAggregate.push_back(data);
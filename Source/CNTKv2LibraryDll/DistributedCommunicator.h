@@ -53,6 +53,16 @@ namespace CNTK
             const std::vector<NDArrayViewPtr>& values,
             const std::unordered_set<DistributedWorkerDescriptor>& sendToWorkers) override;
 
+        // Non-blocking variant of AggregateInPlace: initiates one all-reduce per value and invokes
+        // onValueAggregated(i) as the aggregation of values[i] lands (for GPU-bound values after the
+        // result is back on the device), returning once every value has completed. Small gradients
+        // are intentionally not packed into a single collective here - callers use this entry point
+        // precisely for per-buffer completion granularity.
+        void AggregateInPlace(
+            const std::vector<NDArrayViewPtr>& values,
+            const std::function<void(size_t valueIndex)>& onValueAggregated,
+            const std::unordered_set<DistributedWorkerDescriptor>& sendToWorkers);
+
         virtual void Aggregate(
             const std::vector<NDArrayViewPtr>& inValues,
             std::vector<NDArrayViewPtr>& outValues,
@@ -125,7 +135,8 @@ namespace CNTK
         void CopyDataFromGPUToCPU(std::vector<NDArrayViewPtr>& inputValues);
 
         template <typename ElemType>
-        std::unique_ptr<Microsoft::MSR::CNTK::Matrix<ElemType>> SetContinuousBuffer(std::vector<size_t>& packedGradientsIndex, size_t packedGradientsSizeInBytes,
+        void SetContinuousBuffer(std::unique_ptr<Microsoft::MSR::CNTK::Matrix<ElemType>>& aggregationBuffer,
+            std::vector<size_t>& packedGradientsIndex, size_t packedGradientsSizeInBytes,
             const std::vector<NDArrayViewPtr>& inputValues, const std::vector<NDArrayViewPtr>& outputValues,
             std::vector<NDArrayViewPtr>& valuesToAggregate, std::vector<NDArrayViewPtr>& valuesAfterAggregate);
 
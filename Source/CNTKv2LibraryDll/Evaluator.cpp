@@ -8,6 +8,8 @@
 #include "Utils.h"
 #include "PerformanceProfiler.h"
 
+#include <chrono>
+
 namespace CNTK
 {
     EvaluatorPtr CreateEvaluator(const FunctionPtr& evaluationFunction, const std::vector<ProgressWriterPtr>& progressWriters)
@@ -174,6 +176,297 @@ namespace CNTK
         return make_pair(aggregateEvalCriterionValue, sampleCount);
     }
 
+    Evaluator::SharedParameterClonePtr Evaluator::AcquireSharedParameterClone()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_clonePoolMutex);
+            if (!m_clonePool.empty())
+            {
+                auto clone = m_clonePool.back();
+                m_clonePool.pop_back();
+                return clone;
+            }
+        }
+
+        // Parameters and constants are shared with the original graph; everything else -
+        // including the computation network the clone compiles on first use - is per clone.
+        auto clone = std::make_shared<SharedParameterClone>();
+        clone->combinedEvalFunction = m_combinedEvalFunction->Clone(ParameterCloningMethod::Share);
+
+        // Cloning preserves the graph structure, so arguments and outputs line up by position.
+        auto originalArguments = m_combinedEvalFunction->Arguments();
+        auto clonedArguments = clone->combinedEvalFunction->Arguments();
+        if (originalArguments.size() != clonedArguments.size())
+            LogicError("Evaluator: the cloned evaluation graph has %d arguments, the original has %d.",
+                       (int)clonedArguments.size(), (int)originalArguments.size());
+
+        for (size_t i = 0; i < originalArguments.size(); ++i)
+            clone->argumentMap.insert({ originalArguments[i], clonedArguments[i] });
+
+        auto originalOutputs = m_combinedEvalFunction->Outputs();
+        auto clonedOutputs = clone->combinedEvalFunction->Outputs();
+        if (originalOutputs.size() != clonedOutputs.size())
+            LogicError("Evaluator: the cloned evaluation graph has %d outputs, the original has %d.",
+                       (int)clonedOutputs.size(), (int)originalOutputs.size());
+
+        bool foundEvaluationOutput = false;
+        bool foundAggregatedOutput = false;
+        bool foundSampleCountVar = false;
+        Variable evaluationOutput = m_evaluationFunction;
+        Variable aggregatedEvaluationOutput = m_aggregatedEvaluationFunction;
+        for (size_t i = 0; i < originalOutputs.size(); ++i)
+        {
+            if (originalOutputs[i] == evaluationOutput)
+            {
+                clone->evaluationFunction = clonedOutputs[i];
+                foundEvaluationOutput = true;
+            }
+            if (originalOutputs[i] == aggregatedEvaluationOutput)
+            {
+                clone->aggregatedEvaluationFunction = clonedOutputs[i];
+                foundAggregatedOutput = true;
+            }
+            if (originalOutputs[i] == m_testSampleCountVar)
+            {
+                clone->testSampleCountVar = clonedOutputs[i];
+                foundSampleCountVar = true;
+            }
+        }
+
+        if (!foundEvaluationOutput || !foundAggregatedOutput || !foundSampleCountVar)
+            LogicError("Evaluator: could not locate the criterion or the sample count variable in the cloned evaluation graph.");
+
+        return clone;
+    }
+
+    void Evaluator::ReleaseSharedParameterClone(const SharedParameterClonePtr& clone)
+    {
+        std::lock_guard<std::mutex> guard(m_clonePoolMutex);
+        m_clonePool.push_back(clone);
+    }
+
+    double Evaluator::TestMinibatchThreadSafe(const std::unordered_map<Variable, ValuePtr>& arguments, const DeviceDescriptor& computeDevice /*= DeviceDescriptor::UseDefaultDevice()*/)
+    {
+        if (arguments.empty())
+            InvalidArgument("Evaluator::TestMinibatchThreadSafe: Cannot test on an empty minibatch.");
+
+        std::pair<double, size_t> errorAndCount;
+        TestMinibatchThreadSafe(arguments, errorAndCount, computeDevice);
+        return errorAndCount.first / errorAndCount.second;
+    }
+
+    bool Evaluator::TestMinibatchThreadSafe(const std::unordered_map<Variable, ValuePtr>& arguments, std::pair<double, size_t>& errorAndCount, const DeviceDescriptor& computeDevice)
+    {
+        if (!m_aggregatedEvaluationFunction)
+            InvalidArgument("Evaluator::TestMinibatchThreadSafe: Cannot test when no evaluation function was specified during construction.");
+
+        errorAndCount = { 0.0, 0 };
+        if (arguments.empty()) // End of data.
+            return false;
+
+        auto clone = AcquireSharedParameterClone();
+
+        std::unordered_map<Variable, ValuePtr> clonedArguments(arguments.size());
+        for (const auto& kv : arguments)
+        {
+            auto mapping = clone->argumentMap.find(kv.first);
+            if (mapping == clone->argumentMap.end())
+                InvalidArgument("Evaluator::TestMinibatchThreadSafe: Variable '%S' is not an argument of the evaluation function.", kv.first.AsString().c_str());
+            clonedArguments[mapping->second] = kv.second;
+        }
+
+        std::unordered_map<Variable, ValuePtr> outputs = { { clone->aggregatedEvaluationFunction, nullptr }, { clone->testSampleCountVar, nullptr } };
+        clone->combinedEvalFunction->Forward(clonedArguments, outputs, computeDevice);
+
+        const ValuePtr& aggregateEvalCriterionValue = outputs[clone->aggregatedEvaluationFunction];
+        auto sampleCount = GetSampleCount(clone->testSampleCountVar, outputs[clone->testSampleCountVar]);
+
+        // The output values may reference the clone's network storage, so consume them before
+        // returning the clone to the pool where another thread can overwrite that storage.
+        auto aggregateCriterion = aggregateEvalCriterionValue->AsScalar<double>();
+        {
+            std::lock_guard<std::mutex> guard(m_testProgressMutex);
+            UpdateTestProgress(sampleCount, aggregateEvalCriterionValue, computeDevice);
+        }
+
+        ReleaseSharedParameterClone(clone);
+
+        errorAndCount = { aggregateCriterion, sampleCount };
+        return true;
+    }
+
+    void Evaluator::SetBatchingPolicy(size_t maxBatchSize, size_t latencyBudgetInMilliseconds)
+    {
+        if (maxBatchSize == 0)
+            InvalidArgument("Evaluator::SetBatchingPolicy: maxBatchSize must be at least 1.");
+
+        std::lock_guard<std::mutex> guard(m_batchingMutex);
+        m_maxBatchSize = maxBatchSize;
+        m_batchingLatencyBudgetInMs = latencyBudgetInMilliseconds;
+    }
+
+    double Evaluator::TestSequenceBatched(const std::unordered_map<Variable, ValuePtr>& arguments, const DeviceDescriptor& computeDevice /*= DeviceDescriptor::UseDefaultDevice()*/)
+    {
+        if (!m_aggregatedEvaluationFunction)
+            InvalidArgument("Evaluator::TestSequenceBatched: Cannot test when no evaluation function was specified during construction.");
+
+        if (arguments.empty())
+            InvalidArgument("Evaluator::TestSequenceBatched: Cannot test on an empty set of arguments.");
+
+        // Without dynamic axes there is no batch axis to coalesce requests along.
+        if (m_evaluationFunction == m_aggregatedEvaluationFunction)
+            InvalidArgument("Evaluator::TestSequenceBatched: The evaluation function must have dynamic axes.");
+
+        auto functionArguments = m_combinedEvalFunction->Arguments();
+        for (const auto& kv : arguments)
+        {
+            if (std::find(functionArguments.begin(), functionArguments.end(), kv.first) == functionArguments.end())
+                InvalidArgument("Evaluator::TestSequenceBatched: Variable '%S' is not an argument of the evaluation function.", kv.first.AsString().c_str());
+
+            const auto& value = kv.second;
+            if (value->Data()->GetStorageFormat() != StorageFormat::Dense)
+                InvalidArgument("Evaluator::TestSequenceBatched: Only dense argument values are supported.");
+
+            auto valueRank = value->Shape().Rank();
+            if ((valueRank != kv.first.Shape().Rank() + 2) || (value->Shape()[valueRank - 1] != 1))
+                InvalidArgument("Evaluator::TestSequenceBatched: The Value for variable '%S' must contain exactly one sequence.", kv.first.AsString().c_str());
+        }
+
+        auto request = std::make_shared<PendingEvalRequest>();
+        request->arguments = arguments;
+
+        std::unique_lock<std::mutex> lock(m_batchingMutex);
+        bool isLeader = m_pendingEvalRequests.empty();
+        m_pendingEvalRequests.push_back(request);
+
+        if (!isLeader)
+        {
+            // Wake the leader in case this request completes its batch, then wait for the result.
+            m_batchingCV.notify_all();
+            m_batchingCV.wait(lock, [&request]() { return request->completed; });
+        }
+        else
+        {
+            // The first request in an empty queue becomes the batch leader: it waits up to the
+            // latency budget for further requests to arrive (or for the batch to fill up) and
+            // then evaluates the whole batch in a single forward pass.
+            auto maxBatchSize = m_maxBatchSize;
+            m_batchingCV.wait_for(lock, std::chrono::milliseconds(m_batchingLatencyBudgetInMs),
+                                  [this, maxBatchSize]() { return m_pendingEvalRequests.size() >= maxBatchSize; });
+
+            std::vector<PendingEvalRequestPtr> batch;
+            batch.swap(m_pendingEvalRequests);
+            lock.unlock();
+
+            try
+            {
+                EvaluateRequestBatch(batch, computeDevice);
+            }
+            catch (...)
+            {
+                auto error = std::current_exception();
+                for (auto& batchedRequest : batch)
+                    batchedRequest->error = error;
+            }
+
+            lock.lock();
+            for (auto& batchedRequest : batch)
+                batchedRequest->completed = true;
+            m_batchingCV.notify_all();
+        }
+
+        if (request->error)
+            std::rethrow_exception(request->error);
+
+        return request->result;
+    }
+
+    template <typename ElementType>
+    static void ComputePerSequenceCriterionAverages(const ValuePtr& criterionValue, const Variable& criterionVar, std::vector<double>& averages)
+    {
+        std::vector<std::vector<ElementType>> sequences;
+        criterionValue->CopyVariableValueTo(criterionVar, sequences);
+
+        auto sampleSize = criterionVar.Shape().TotalSize();
+        averages.resize(sequences.size());
+        for (size_t i = 0; i < sequences.size(); ++i)
+        {
+            double sum = 0;
+            for (auto v : sequences[i])
+                sum += v;
+
+            auto numSamples = (sampleSize != 0) ? (sequences[i].size() / sampleSize) : 0;
+            averages[i] = (numSamples != 0) ? (sum / numSamples) : 0;
+        }
+    }
+
+    void Evaluator::EvaluateRequestBatch(const std::vector<PendingEvalRequestPtr>& batch, const DeviceDescriptor& computeDevice)
+    {
+        auto clone = AcquireSharedParameterClone();
+
+        // Coalesce the per-request single-sequence Values into one batched Value per argument.
+        // Requests may carry sequences of different lengths; Value::Create pads and masks them.
+        const auto& referenceArguments = batch.front()->arguments;
+        std::unordered_map<Variable, ValuePtr> batchedArguments(referenceArguments.size());
+        for (const auto& kv : referenceArguments)
+        {
+            const auto& var = kv.first;
+            auto mapping = clone->argumentMap.find(var);
+            if (mapping == clone->argumentMap.end())
+                InvalidArgument("Evaluator::TestSequenceBatched: Variable '%S' is not an argument of the evaluation function.", var.AsString().c_str());
+
+            std::vector<NDArrayViewPtr> sequences;
+            sequences.reserve(batch.size());
+            for (const auto& batchedRequest : batch)
+            {
+                auto argument = batchedRequest->arguments.find(var);
+                if (argument == batchedRequest->arguments.end())
+                    InvalidArgument("Evaluator::TestSequenceBatched: All coalesced requests must supply the same set of arguments.");
+
+                // Strip the trailing batch axis of the single-sequence Value.
+                auto data = argument->second->Data();
+                sequences.push_back(data->AsShape(data->Shape().SubShape(0, data->Shape().Rank() - 1)));
+            }
+
+            batchedArguments[mapping->second] = Value::Create(var.Shape(), sequences, computeDevice, /*readOnly =*/ true);
+        }
+
+        std::unordered_map<Variable, ValuePtr> outputs = { { clone->evaluationFunction, nullptr }, { clone->aggregatedEvaluationFunction, nullptr }, { clone->testSampleCountVar, nullptr } };
+        clone->combinedEvalFunction->Forward(batchedArguments, outputs, computeDevice);
+
+        // Scatter the per-sequence criterion values back to the individual requests. The output
+        // values may reference the clone's network storage, so consume them before returning the
+        // clone to the pool where another thread can overwrite that storage.
+        const ValuePtr& criterionValue = outputs[clone->evaluationFunction];
+        std::vector<double> averages;
+        switch (criterionValue->GetDataType())
+        {
+        case DataType::Float:
+            ComputePerSequenceCriterionAverages<float>(criterionValue, clone->evaluationFunction, averages);
+            break;
+        case DataType::Double:
+            ComputePerSequenceCriterionAverages<double>(criterionValue, clone->evaluationFunction, averages);
+            break;
+        default:
+            LogicError("Evaluator::TestSequenceBatched: Unsupported criterion DataType %s.", DataTypeName(criterionValue->GetDataType()));
+        }
+
+        if (averages.size() != batch.size())
+            LogicError("Evaluator::TestSequenceBatched: The batched criterion value holds %d sequences, expected %d.",
+                       (int)averages.size(), (int)batch.size());
+
+        for (size_t i = 0; i < batch.size(); ++i)
+            batch[i]->result = averages[i];
+
+        auto sampleCount = GetSampleCount(clone->testSampleCountVar, outputs[clone->testSampleCountVar]);
+        {
+            std::lock_guard<std::mutex> guard(m_testProgressMutex);
+            UpdateTestProgress(sampleCount, outputs[clone->aggregatedEvaluationFunction], computeDevice);
+        }
+
+        ReleaseSharedParameterClone(clone);
+    }
+
     void Evaluator::UpdateTestProgress(size_t numSamples, const ValuePtr& evalCriterion, const DeviceDescriptor& computeDevice)
     {
         if (numSamples == 0)
@@ -10,6 +10,7 @@
 #include "BlockFunction.h"
 #include "Utils.h"
 #include "UserFunctionFactory.h"
+#include "Serialization.h"
 
 using namespace Microsoft::MSR::CNTK;
 
@@ -41,7 +42,8 @@ namespace CNTK
                 if (m_rootFunction == nullptr && outputVar.IsOutput() && outputVar.Owner().get() == this)
                 {
                     // in case of a primitive function, set uid of output vars to owner function uid + "_Output_" + output index.
-                    outputVar.m_dataFields->m_uid = m_uid + L"_" + VariableKindName(outputVar.Kind()) + L"_" + std::to_wstring(m_outputs.size());
+                    outputVar.m_dataFields->m_uid = Uid() + L"_" + VariableKindName(outputVar.Kind()) + L"_" + std::to_wstring(m_outputs.size());
+                    outputVar.m_dataFields->m_hasDeferredUid = false;
                 }
 
                 m_outputs.push_back(outputVar);
@@ -103,8 +105,27 @@ namespace CNTK
         : Function(inputs, Dictionary(), name)
     {}
 
+    // Serializes materialization of deferred uids; uniqueness comes from the reserved number, the
+    // lock only prevents concurrent first reads from racing on the string assignment.
+    static std::mutex s_functionUidMaterializationMutex;
+
+    const std::wstring& Function::Uid() const
+    {
+        if (m_hasDeferredUid)
+        {
+            std::lock_guard<std::mutex> guard(s_functionUidMaterializationMutex);
+            if (m_hasDeferredUid)
+            {
+                m_uid = OpName() + std::to_wstring(m_uidNumber);
+                m_hasDeferredUid = false;
+            }
+        }
+
+        return m_uid;
+    }
+
     Function::Function(const std::vector<Variable>& inputs, Dictionary&& functionConfig, const FunctionPtr& rootFunction, const std::wstring& name, const std::wstring& uid)
-        : m_rootFunction(rootFunction), m_name(name), m_uid(uid), m_attributes(std::move(functionConfig))
+        : m_rootFunction(rootFunction), m_name(name), m_uid(uid), m_hasDeferredUid(uid.empty()), m_uidNumber(uid.empty() ? Internal::NewUniqueId() : 0), m_attributes(std::move(functionConfig))
     {
         for (auto inputVar : inputs)
         {
@@ -438,6 +459,17 @@ namespace CNTK
         stream->flush();
     }
 
+    namespace Internal
+    {
+        void SaveAsStreamingModel(const FunctionPtr& rootFunction, const std::wstring& modelFile, bool compressPayloads)
+        {
+            Dictionary model = rootFunction->Serialize();
+            auto stream = GetFstream(modelFile, false);
+            SerializeStreaming(model, *stream, compressPayloads);
+            stream->flush();
+        }
+    }
+
     /*static*/ FunctionPtr Function::Load(const std::wstring& filepath, const DeviceDescriptor& computeDevice, const Internal::UDFDeserializerPtr& deserializer)
     {
         auto stream = GetFstream(filepath, true);
@@ -939,9 +971,205 @@ namespace CNTK
         return wss.str();
     }
 
+    // Construction-time constant folding: whitelisted elementwise ops whose operands are all
+    // Constants are evaluated right here, once, instead of surviving into the runtime graph where
+    // they would be recomputed every minibatch. Opt-in via
+    // Internal::SetConstantFoldingInFunctionConstruction since a folded Constant no longer
+    // observes subsequent SetValue() updates of its source Constants.
+    static bool IsFoldablePrimitiveOp(PrimitiveOpType op, size_t numOperands)
+    {
+        if (numOperands == 1)
+        {
+            switch (op)
+            {
+            case PrimitiveOpType::Negate:
+            case PrimitiveOpType::Sigmoid:
+            case PrimitiveOpType::Tanh:
+            case PrimitiveOpType::ReLU:
+            case PrimitiveOpType::Exp:
+            case PrimitiveOpType::Log:
+            case PrimitiveOpType::Sqrt:
+            case PrimitiveOpType::Floor:
+            case PrimitiveOpType::Abs:
+            case PrimitiveOpType::Reciprocal:
+            case PrimitiveOpType::Sin:
+            case PrimitiveOpType::Cos:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        if (numOperands == 2)
+        {
+            switch (op)
+            {
+            case PrimitiveOpType::Plus:
+            case PrimitiveOpType::Minus:
+            case PrimitiveOpType::ElementTimes:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        return false;
+    }
+
+    // Returns the value of the operand if it is a Constant, looking through aliasing ops
+    // (NoOp/Pass) so that chains of already folded subexpressions keep folding.
+    static NDArrayViewPtr TryGetConstantOperandValue(const Variable& operand)
+    {
+        if (operand.IsConstant())
+            return Constant(operand).Value();
+
+        if (operand.IsOutput() && operand.Owner())
+        {
+            auto owner = dynamic_cast<PrimitiveFunction*>(operand.Owner().get());
+            if (owner && ((owner->OpType() == PrimitiveOpType::NoOp) || (owner->OpType() == PrimitiveOpType::Pass)))
+                return TryGetConstantOperandValue(owner->Inputs()[0]);
+        }
+
+        return nullptr;
+    }
+
+    template <typename ElementType>
+    static bool FoldUnaryConstantOp(PrimitiveOpType op, const ElementType* input, ElementType* result, size_t count)
+    {
+        ElementType (*unaryOp)(ElementType) = nullptr;
+        switch (op)
+        {
+        case PrimitiveOpType::Negate:     unaryOp = [](ElementType v) { return -v; }; break;
+        case PrimitiveOpType::Sigmoid:    unaryOp = [](ElementType v) { return (ElementType)1 / ((ElementType)1 + std::exp(-v)); }; break;
+        case PrimitiveOpType::Tanh:       unaryOp = [](ElementType v) { return std::tanh(v); }; break;
+        case PrimitiveOpType::ReLU:       unaryOp = [](ElementType v) { return (v > 0) ? v : (ElementType)0; }; break;
+        case PrimitiveOpType::Exp:        unaryOp = [](ElementType v) { return std::exp(v); }; break;
+        case PrimitiveOpType::Log:        unaryOp = [](ElementType v) { return std::log(v); }; break;
+        case PrimitiveOpType::Sqrt:       unaryOp = [](ElementType v) { return std::sqrt(v); }; break;
+        case PrimitiveOpType::Floor:      unaryOp = [](ElementType v) { return std::floor(v); }; break;
+        case PrimitiveOpType::Abs:        unaryOp = [](ElementType v) { return std::abs(v); }; break;
+        case PrimitiveOpType::Reciprocal: unaryOp = [](ElementType v) { return (ElementType)1 / v; }; break;
+        case PrimitiveOpType::Sin:        unaryOp = [](ElementType v) { return std::sin(v); }; break;
+        case PrimitiveOpType::Cos:        unaryOp = [](ElementType v) { return std::cos(v); }; break;
+        default:
+            return false;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            result[i] = unaryOp(input[i]);
+
+        return true;
+    }
+
+    template <typename ElementType>
+    static bool FoldBinaryConstantOp(PrimitiveOpType op, const ElementType* left, size_t leftCount, const ElementType* right, size_t rightCount, ElementType* result, size_t count)
+    {
+        ElementType (*binaryOp)(ElementType, ElementType) = nullptr;
+        switch (op)
+        {
+        case PrimitiveOpType::Plus:         binaryOp = [](ElementType a, ElementType b) { return a + b; }; break;
+        case PrimitiveOpType::Minus:        binaryOp = [](ElementType a, ElementType b) { return a - b; }; break;
+        case PrimitiveOpType::ElementTimes: binaryOp = [](ElementType a, ElementType b) { return a * b; }; break;
+        default:
+            return false;
+        }
+
+        // Only scalar broadcast; general broadcasting falls back to the runtime graph
+        size_t leftStride = (leftCount == 1) ? 0 : 1;
+        size_t rightStride = (rightCount == 1) ? 0 : 1;
+        for (size_t i = 0; i < count; ++i)
+            result[i] = binaryOp(left[i * leftStride], right[i * rightStride]);
+
+        return true;
+    }
+
+    template <typename ElementType>
+    static NDArrayViewPtr EvaluateConstantFold(PrimitiveOpType op, const std::vector<NDArrayViewPtr>& operandValues)
+    {
+        std::vector<NDArrayViewPtr> cpuValues;
+        std::vector<const ElementType*> buffers;
+        for (const auto& value : operandValues)
+        {
+            cpuValues.push_back((value->Device() == DeviceDescriptor::CPUDevice()) ? value : value->DeepClone(DeviceDescriptor::CPUDevice(), /*readOnly =*/ true));
+            buffers.push_back(cpuValues.back()->DataBuffer<ElementType>());
+        }
+
+        NDShape resultShape = operandValues[0]->Shape();
+        if ((operandValues.size() == 2) && (resultShape.TotalSize() == 1))
+            resultShape = operandValues[1]->Shape();
+
+        std::vector<ElementType> resultData(resultShape.TotalSize());
+        bool folded;
+        if (operandValues.size() == 1)
+            folded = FoldUnaryConstantOp(op, buffers[0], resultData.data(), resultData.size());
+        else
+            folded = FoldBinaryConstantOp(op, buffers[0], cpuValues[0]->Shape().TotalSize(), buffers[1], cpuValues[1]->Shape().TotalSize(), resultData.data(), resultData.size());
+
+        if (!folded)
+            return nullptr;
+
+        NDArrayView result(AsDataType<ElementType>(), resultShape, resultData.data(), resultData.size() * sizeof(ElementType), DeviceDescriptor::CPUDevice());
+        return result.DeepClone(operandValues[0]->Device(), /*readOnly =*/ true);
+    }
+
+    static FunctionPtr TryFoldConstantPrimitiveOp(PrimitiveOpType op, const std::vector<Variable>& operands, const std::wstring& name)
+    {
+        if (!Internal::IsConstantFoldingInFunctionConstructionEnabled() || !IsFoldablePrimitiveOp(op, operands.size()))
+            return nullptr;
+
+        std::vector<NDArrayViewPtr> operandValues;
+        for (const auto& operand : operands)
+        {
+            auto value = TryGetConstantOperandValue(operand);
+            if (!value ||
+                (value->GetStorageFormat() != StorageFormat::Dense) ||
+                value->Shape().HasUnboundDimension() ||
+                ((value->GetDataType() != DataType::Float) && (value->GetDataType() != DataType::Double)))
+                return nullptr;
+
+            // Mixed precision operands go through the runtime graph's coercion rules
+            if (!operandValues.empty() && (value->GetDataType() != operandValues.front()->GetDataType()))
+                return nullptr;
+
+            operandValues.push_back(value);
+        }
+
+        // Only identical shapes or a scalar operand; general broadcasting falls back to the runtime graph
+        if ((operandValues.size() == 2) &&
+            (operandValues[0]->Shape() != operandValues[1]->Shape()) &&
+            (operandValues[0]->Shape().TotalSize() != 1) && (operandValues[1]->Shape().TotalSize() != 1))
+            return nullptr;
+
+        NDArrayViewPtr foldedValue;
+        switch (operandValues.front()->GetDataType())
+        {
+        case DataType::Float:
+            foldedValue = EvaluateConstantFold<float>(op, operandValues);
+            break;
+        case DataType::Double:
+            foldedValue = EvaluateConstantFold<double>(op, operandValues);
+            break;
+        default:
+            return nullptr;
+        }
+
+        if (!foldedValue)
+            return nullptr;
+
+        // The alias keeps the requested name on the graph node holding the folded result
+        return Alias(Constant(foldedValue), name);
+    }
+
     FunctionPtr UnaryOp(PrimitiveOpType op, const Variable& operand, Dictionary&& opConfig, const std::wstring& name)
     {
         std::vector<Variable> operands = { operand };
+        if (opConfig.Size() == 0)
+        {
+            auto folded = TryFoldConstantPrimitiveOp(op, operands, name);
+            if (folded)
+                return folded;
+        }
+
         return AsComposite(MakeSharedObject<PrimitiveFunction>(op, operands, std::move(opConfig), name), name);
     }
 
@@ -1134,6 +1362,13 @@ namespace CNTK
     FunctionPtr BinaryOp(PrimitiveOpType op, const Variable& leftOperand, const Variable& rightOperand, Dictionary&& opConfig, const std::wstring& name)
     {
         std::vector<Variable> operands = { leftOperand, rightOperand };
+        if (opConfig.Size() == 0)
+        {
+            auto folded = TryFoldConstantPrimitiveOp(op, operands, name);
+            if (folded)
+                return folded;
+        }
+
         return AsComposite(MakeSharedObject<PrimitiveFunction>(op, operands, std::move(opConfig), name), name);
     }
 
@@ -1895,6 +2130,27 @@ namespace CNTK
                        operand.AsString().c_str());
         }
 
+        FunctionPtr ReduceElements(const Variable& operand, const std::wstring& reductionOpName, const std::vector<Axis>& axes, bool keepReducedDimensions, const std::wstring& name)
+        {
+            if (axes.empty())
+                LogicError("ReduceElements: operand %S; At least one reduction axis must be provided.", operand.AsString().c_str());
+
+            // a single axis takes the regular path, so that sentinel axis values keep working
+            if (axes.size() == 1)
+                return ReduceElements(operand, reductionOpName, axes[0], keepReducedDimensions, name);
+
+            // multiple axes reduce in one pass; this is only supported for static axes
+            for (auto& axis : axes)
+                if (!axis.IsStaticAxis())
+                    LogicError("ReduceElements: operand %S; Only static axes can be combined in a multi-axis reduction.", operand.AsString().c_str());
+
+            auto additionalProperties = Dictionary();
+            additionalProperties[PrimitiveFunction::AttributeNameAxisVec] = AsDictionaryValueVector(axes);
+            additionalProperties[PrimitiveFunction::AttributeNameReductionOpName] = reductionOpName;
+            additionalProperties[PrimitiveFunction::AttributeNameReductionKeepDimensions] = keepReducedDimensions;
+            return UnaryOp(PrimitiveOpType::ReduceElements, operand, std::move(additionalProperties), name);
+        }
+
         FunctionPtr ReduceElements(const Variable& operand, const std::wstring& reductionOpName, const Axis& axis, const std::wstring& name)
         {
             bool keepReducedDimensions = true;
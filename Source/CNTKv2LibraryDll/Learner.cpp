@@ -266,6 +266,18 @@ namespace CNTK
         if (trainingSampleCount == 0)
             InvalidArgument("Learner::Update() cannot perform an update with an empty minibatch.");
 
+        // give the learner a chance to update all parameters in a few fused (multi-tensor) launches
+        if (TryBatchUpdate(gradientValues, trainingSampleCount))
+        {
+            m_sampleCount += trainingSampleCount;
+            m_minibatchCount++;
+            if (sweepEnd)
+            {
+                m_sweepCount++;
+            }
+            return true;
+        }
+
         for (const auto& parameter : Parameters())
         {
             const auto& smoothedGradientValue = m_smoothedGradientValues.at(parameter);
@@ -312,8 +324,52 @@ namespace CNTK
         return true;
     }
 
+    bool LearnerBase::BeginStreamingUpdate(size_t trainingSampleCount)
+    {
+        ReportTrainingParameterValue(m_learningRateSchedule, L"Learning rate");
+
+        if (LearningRate(trainingSampleCount) == 0.0)
+        {
+            return false;
+        }
+
+        // make sure trainingSampleCount is a valid value
+        if (trainingSampleCount == 0)
+            InvalidArgument("Learner::Update() cannot perform an update with an empty minibatch.");
+
+        return true;
+    }
+
+    void LearnerBase::UpdateParameter(const Parameter& parameter, const NDArrayViewPtr& gradientValue, size_t trainingSampleCount)
+    {
+        const auto& smoothedGradientValue = m_smoothedGradientValues.at(parameter);
+
+#ifdef _DEBUG
+        if (HasNan(smoothedGradientValue, "TrainOneEpoch/UpdateWeights/Learner::Update(): "))
+            LogicError("%ls has NaNs in smoothedGradient.", parameter.Uid().c_str());
+#endif
+
+        DISPATCH_TO_TYPED_UPDATE_FUNCTION;
+
+#ifdef _DEBUG
+        const auto& parameterValue = parameter.Value();
+        if (HasNan(parameterValue, "TrainOneEpoch/UpdateWeights/Learner::Update(): "))
+            LogicError("%ls has NaNs in parameter values after parameter update.", parameter.Uid().c_str());
+#endif
+    }
+
+    void LearnerBase::EndStreamingUpdate(size_t trainingSampleCount, bool sweepEnd)
+    {
+        m_sampleCount += trainingSampleCount;
+        m_minibatchCount++;
+        if (sweepEnd)
+        {
+            m_sweepCount++;
+        }
+    }
+
     template <typename ElementType>
-    void LearnerBase::Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue, 
+    void LearnerBase::Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue,
                              const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const
     {
         const auto& parameterValue = parameter.Value();
@@ -706,6 +762,380 @@ namespace CNTK
                                            momentum, varMomentum, (ElementType)m_epsilon, UseUnitGainMomentum(), m_adamax);
     }
 
+    /*virtual*/ bool LearnerAdam::TryBatchUpdate(unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount) /*override*/
+    {
+        const auto& parameters = Parameters();
+        if (parameters.empty())
+            return false;
+
+        // the batched path folds all parameters into a single typed call; fall back on mixed precision
+        auto dataType = parameters.front().GetDataType();
+        for (const auto& parameter : parameters)
+        {
+            if (parameter.GetDataType() != dataType)
+                return false;
+        }
+
+        switch (dataType)
+        {
+        case DataType::Float:
+            BatchUpdate<float>(gradientValues, trainingSampleCount);
+            break;
+        case DataType::Double:
+            BatchUpdate<double>(gradientValues, trainingSampleCount);
+            break;
+        default:
+            NOT_IMPLEMENTED;
+        }
+        return true;
+    }
+
+    template <typename ElementType>
+    void LearnerAdam::BatchUpdate(unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount)
+    {
+        const auto& parameters = Parameters();
+
+        // keep the matrix shared_ptrs alive across the batched call
+        vector<shared_ptr<Matrix<ElementType>>> matrices;
+        matrices.reserve(3 * parameters.size());
+        vector<Matrix<ElementType>*> smoothedGradients, gradients, functionValues;
+        vector<double*> smoothedCounts;
+
+        for (const auto& parameter : parameters)
+        {
+            const auto& smoothedGradientValue = m_smoothedGradientValues.at(parameter);
+            const auto& gradientValue = gradientValues.at(parameter);
+            PreProcess<ElementType>(parameter.Value(), gradientValue, trainingSampleCount);
+
+            matrices.push_back(GetWritableMatrix<ElementType>(smoothedGradientValue));
+            smoothedGradients.push_back(matrices.back().get());
+            matrices.push_back(GetWritableMatrix<ElementType>(gradientValue));
+            gradients.push_back(matrices.back().get());
+            matrices.push_back(GetWritableMatrix<ElementType>(parameter.Value()));
+            functionValues.push_back(matrices.back().get());
+            smoothedCounts.push_back(&m_smoothedCounts.at(parameter));
+        }
+
+        const auto learningRate = LearningRate(trainingSampleCount);
+        const auto momentum = MomentumValueForMB(trainingSampleCount);
+        const auto varMomentum = VarianceMomentumValueForMB(trainingSampleCount);
+
+        Matrix<ElementType>::BatchAdamUpdate(smoothedGradients, gradients, functionValues, smoothedCounts,
+                                             learningRate, momentum, varMomentum, m_epsilon, UseUnitGainMomentum(), m_adamax);
+
+        for (const auto& parameter : parameters)
+        {
+            PostProcess<ElementType>(parameter, gradientValues.at(parameter), trainingSampleCount);
+            auto paramRef = parameter;
+            paramRef.RecordValueUpdate();
+        }
+    }
+
+    LearnerLars::LearnerLars(const vector<Parameter>& parameters,
+                             const LearningRateSchedule& learningRateSchedule,
+                             const MomentumSchedule& momentumSchedule,
+                             bool unitGain,
+                             double trustRatioCoefficient,
+                             double epsilon,
+                             AdditionalLearningOptions additionalOptions)
+                             : LearnerMomentumSGD(parameters, learningRateSchedule, momentumSchedule,
+                                                  unitGain, additionalOptions, /*allocateSmoothGradients*/ true),
+                             m_trustRatioCoefficient(trustRatioCoefficient), m_epsilon(epsilon)
+    {
+        if (m_trustRatioCoefficient <= 0.0)
+        {
+            InvalidArgument("The trust ratio coefficient should be positive. You are trying to set it to %g.", m_trustRatioCoefficient);
+        }
+        if (m_epsilon < 0.0)
+        {
+            InvalidArgument("Epsilon should be non-negative. You are trying to set it to %g.", m_epsilon);
+        }
+    }
+
+    double LearnerLars::TrustRatio(double squaredParameterNorm, double squaredGradientNorm) const
+    {
+        // freshly initialized (all-zero) parameters and dead gradients get no scaling
+        if (squaredParameterNorm == 0.0 || squaredGradientNorm == 0.0)
+            return 1.0;
+
+        return m_trustRatioCoefficient * sqrt(squaredParameterNorm) / (sqrt(squaredGradientNorm) + m_epsilon);
+    }
+
+    /*virtual*/ void LearnerLars::Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue,
+                                         const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const /*override*/
+    {
+        DISPATCH_TO_TYPED_UPDATE_FUNCTION;
+    }
+
+    template <typename ElementType>
+    void LearnerLars::Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue,
+                             const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const
+    {
+        GET_WRITABLE_MATRICES;
+
+        const auto learningRate = LearningRate(trainingSampleCount);
+        const auto momentum = MomentumValueForMB(trainingSampleCount);
+
+        // per-parameter fallback path: one synchronizing reduction per norm
+        const double parameterNorm = parameterMatrix->FrobeniusNorm();
+        const double gradientNorm = gradientMatrix->FrobeniusNorm();
+        const auto scaledLearningRate = learningRate * TrustRatio(parameterNorm * parameterNorm, gradientNorm * gradientNorm);
+
+        parameterMatrix->MomentumSGDUpdate(*gradientMatrix, *smoothedGradientMatrix,
+                                           (ElementType) scaledLearningRate, (ElementType) momentum, UseUnitGainMomentum());
+    }
+
+    /*virtual*/ bool LearnerLars::TryBatchUpdate(unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount) /*override*/
+    {
+        const auto& parameters = Parameters();
+        if (parameters.empty())
+            return false;
+
+        // the batched path folds all norm computations into a few typed calls; fall back on mixed precision
+        auto dataType = parameters.front().GetDataType();
+        for (const auto& parameter : parameters)
+        {
+            if (parameter.GetDataType() != dataType)
+                return false;
+        }
+
+        switch (dataType)
+        {
+        case DataType::Float:
+            BatchUpdate<float>(gradientValues, trainingSampleCount);
+            break;
+        case DataType::Double:
+            BatchUpdate<double>(gradientValues, trainingSampleCount);
+            break;
+        default:
+            NOT_IMPLEMENTED;
+        }
+        return true;
+    }
+
+    template <typename ElementType>
+    void LearnerLars::BatchUpdate(unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount)
+    {
+        const auto& parameters = Parameters();
+
+        // keep the matrix shared_ptrs alive across the batched calls
+        vector<shared_ptr<Matrix<ElementType>>> matrices;
+        matrices.reserve(3 * parameters.size());
+        vector<Matrix<ElementType>*> smoothedGradients, gradients, functionValues;
+        vector<const Matrix<ElementType>*> normInputs;
+        normInputs.reserve(2 * parameters.size());
+
+        for (const auto& parameter : parameters)
+        {
+            const auto& gradientValue = gradientValues.at(parameter);
+            PreProcess<ElementType>(parameter.Value(), gradientValue, trainingSampleCount);
+
+            matrices.push_back(GetWritableMatrix<ElementType>(m_smoothedGradientValues.at(parameter)));
+            smoothedGradients.push_back(matrices.back().get());
+            matrices.push_back(GetWritableMatrix<ElementType>(gradientValue));
+            gradients.push_back(matrices.back().get());
+            matrices.push_back(GetWritableMatrix<ElementType>(parameter.Value()));
+            functionValues.push_back(matrices.back().get());
+            normInputs.push_back(functionValues.back());
+            normInputs.push_back(gradients.back());
+        }
+
+        // all parameter and gradient norms of the minibatch with a single device synchronization
+        vector<ElementType> squaredNorms;
+        Matrix<ElementType>::BatchSquaredFrobeniusNorms(normInputs, squaredNorms);
+
+        const auto learningRate = LearningRate(trainingSampleCount);
+        const auto momentum = MomentumValueForMB(trainingSampleCount);
+        for (size_t i = 0; i < parameters.size(); i++)
+        {
+            const auto scaledLearningRate = learningRate * TrustRatio(squaredNorms[2 * i], squaredNorms[2 * i + 1]);
+            functionValues[i]->MomentumSGDUpdate(*gradients[i], *smoothedGradients[i],
+                                                 (ElementType) scaledLearningRate, (ElementType) momentum, UseUnitGainMomentum());
+        }
+
+        for (const auto& parameter : parameters)
+        {
+            PostProcess<ElementType>(parameter, gradientValues.at(parameter), trainingSampleCount);
+            auto paramRef = parameter;
+            paramRef.RecordValueUpdate();
+        }
+    }
+
+    LearnerLamb::LearnerLamb(const vector<Parameter>& parameters,
+                             const LearningRateSchedule& learningRateSchedule,
+                             const MomentumSchedule& momentumSchedule,
+                             bool unitGain,
+                             const MomentumSchedule& varianceMomentumSchedule,
+                             double trustRatioCoefficient,
+                             double epsilon,
+                             AdditionalLearningOptions additionalOptions)
+                             : LearnerMomentumSGD(parameters, learningRateSchedule, momentumSchedule,
+                                                  unitGain, additionalOptions, /*allocateSmoothGradients*/ false),
+                             m_varianceMomentumSchedule(varianceMomentumSchedule),
+                             m_trustRatioCoefficient(trustRatioCoefficient), m_epsilon(epsilon)
+    {
+        if (m_trustRatioCoefficient <= 0.0)
+        {
+            InvalidArgument("The trust ratio coefficient should be positive. You are trying to set it to %g.", m_trustRatioCoefficient);
+        }
+        if (m_epsilon < 0.0)
+        {
+            InvalidArgument("Epsilon should be non-negative. You are trying to set it to %g.", m_epsilon);
+        }
+
+        for (const auto& parameter : parameters)
+        {
+            const auto shape = GetMatrixShape(parameter);
+            NDArrayViewPtr view = AllocateNDArrayView(parameter, { shape[0], 2 * shape[1] });
+            m_smoothedGradientValues.emplace(parameter, view);
+            m_updateScratch.emplace(parameter, AllocateNDArrayView(parameter, shape));
+            m_smoothedCounts.emplace(parameter, 0.0);
+        }
+    }
+
+    double LearnerLamb::TrustRatio(double squaredParameterNorm, double squaredUpdateNorm) const
+    {
+        // freshly initialized (all-zero) parameters and dead updates get no scaling
+        if (squaredParameterNorm == 0.0 || squaredUpdateNorm == 0.0)
+            return 1.0;
+
+        return m_trustRatioCoefficient * sqrt(squaredParameterNorm) / (sqrt(squaredUpdateNorm) + m_epsilon);
+    }
+
+    template <typename ElementType>
+    void LearnerLamb::ComputeUpdate(const Parameter& parameter, const NDArrayViewPtr& gradientValue,
+                                    const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const
+    {
+        const auto& smoothedGradientMatrix = GetWritableMatrix<ElementType>(smoothedGradientValue);
+        const auto& gradientMatrix = GetWritableMatrix<ElementType>(gradientValue);
+        const auto& updateMatrix = GetWritableMatrix<ElementType>(m_updateScratch.at(parameter));
+
+        const auto meanMomentum = MomentumValueForMB(trainingSampleCount);
+        const auto varMomentum = VarianceMomentumValueForMB(trainingSampleCount);
+        const auto unitGainFactor = UseUnitGainMomentum() ? (1.0 - meanMomentum) : 1.0;
+
+        double& smoothedCount = m_smoothedCounts.at(parameter);
+        smoothedCount++;
+
+        const size_t numCols = gradientMatrix->GetNumCols();
+        auto mean = smoothedGradientMatrix->ColumnSlice(0, numCols);
+        auto variance = smoothedGradientMatrix->ColumnSlice(numCols, numCols);
+
+        // m <- b1 * m + unitGainFactor * g;  v <- b2 * v + (1 - b2) * g .* g
+        Matrix<ElementType>::Scale((ElementType) meanMomentum, mean);
+        Matrix<ElementType>::ScaleAndAdd((ElementType) unitGainFactor, *gradientMatrix, mean);
+        updateMatrix->AssignElementProductOf(*gradientMatrix, *gradientMatrix);
+        Matrix<ElementType>::Scale((ElementType) varMomentum, variance);
+        Matrix<ElementType>::ScaleAndAdd((ElementType)(1.0 - varMomentum), *updateMatrix, variance);
+
+        // update <- (m / (1 - b1^t)) / (sqrt(v / (1 - b2^t)) + epsilon), bias-corrected as in AdamUpdate()
+        updateMatrix->SetValue(variance);
+        *updateMatrix *= (ElementType)(1.0 / (1.0 - pow(varMomentum, smoothedCount)));
+        updateMatrix->InplaceSqrt();
+        *updateMatrix += (ElementType) m_epsilon;
+        updateMatrix->ElementInverse();
+        updateMatrix->ElementMultiplyWith(mean);
+        *updateMatrix *= (ElementType)(1.0 / (1.0 - pow(meanMomentum, smoothedCount)));
+    }
+
+    /*virtual*/ void LearnerLamb::Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue,
+                                         const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const /*override*/
+    {
+        DISPATCH_TO_TYPED_UPDATE_FUNCTION;
+    }
+
+    template <typename ElementType>
+    void LearnerLamb::Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue,
+                             const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const
+    {
+        ComputeUpdate<ElementType>(parameter, gradientValue, smoothedGradientValue, trainingSampleCount);
+
+        const auto& parameterMatrix = GetWritableMatrix<ElementType>(parameter.Value());
+        const auto& updateMatrix = GetWritableMatrix<ElementType>(m_updateScratch.at(parameter));
+
+        // per-parameter fallback path: one synchronizing reduction per norm
+        const double parameterNorm = parameterMatrix->FrobeniusNorm();
+        const double updateNorm = updateMatrix->FrobeniusNorm();
+        const auto learningRate = LearningRate(trainingSampleCount);
+        const auto scaledLearningRate = learningRate * TrustRatio(parameterNorm * parameterNorm, updateNorm * updateNorm);
+
+        Matrix<ElementType>::ScaleAndAdd((ElementType) -scaledLearningRate, *updateMatrix, *parameterMatrix);
+    }
+
+    /*virtual*/ bool LearnerLamb::TryBatchUpdate(unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount) /*override*/
+    {
+        const auto& parameters = Parameters();
+        if (parameters.empty())
+            return false;
+
+        // the batched path folds all norm computations into a few typed calls; fall back on mixed precision
+        auto dataType = parameters.front().GetDataType();
+        for (const auto& parameter : parameters)
+        {
+            if (parameter.GetDataType() != dataType)
+                return false;
+        }
+
+        switch (dataType)
+        {
+        case DataType::Float:
+            BatchUpdate<float>(gradientValues, trainingSampleCount);
+            break;
+        case DataType::Double:
+            BatchUpdate<double>(gradientValues, trainingSampleCount);
+            break;
+        default:
+            NOT_IMPLEMENTED;
+        }
+        return true;
+    }
+
+    template <typename ElementType>
+    void LearnerLamb::BatchUpdate(unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount)
+    {
+        const auto& parameters = Parameters();
+
+        // phase 1: moment estimates and preconditioned updates per tensor (launches only, no syncs)
+        vector<shared_ptr<Matrix<ElementType>>> matrices;
+        matrices.reserve(2 * parameters.size());
+        vector<Matrix<ElementType>*> updates, functionValues;
+        vector<const Matrix<ElementType>*> normInputs;
+        normInputs.reserve(2 * parameters.size());
+
+        for (const auto& parameter : parameters)
+        {
+            const auto& gradientValue = gradientValues.at(parameter);
+            PreProcess<ElementType>(parameter.Value(), gradientValue, trainingSampleCount);
+            ComputeUpdate<ElementType>(parameter, gradientValue, m_smoothedGradientValues.at(parameter), trainingSampleCount);
+
+            matrices.push_back(GetWritableMatrix<ElementType>(parameter.Value()));
+            functionValues.push_back(matrices.back().get());
+            matrices.push_back(GetWritableMatrix<ElementType>(m_updateScratch.at(parameter)));
+            updates.push_back(matrices.back().get());
+            normInputs.push_back(functionValues.back());
+            normInputs.push_back(updates.back());
+        }
+
+        // phase 2: all parameter and update norms with a single device synchronization
+        vector<ElementType> squaredNorms;
+        Matrix<ElementType>::BatchSquaredFrobeniusNorms(normInputs, squaredNorms);
+
+        // phase 3: apply the trust-ratio-scaled updates
+        const auto learningRate = LearningRate(trainingSampleCount);
+        for (size_t i = 0; i < parameters.size(); i++)
+        {
+            const auto scaledLearningRate = learningRate * TrustRatio(squaredNorms[2 * i], squaredNorms[2 * i + 1]);
+            Matrix<ElementType>::ScaleAndAdd((ElementType) -scaledLearningRate, *updates[i], *functionValues[i]);
+        }
+
+        for (const auto& parameter : parameters)
+        {
+            PostProcess<ElementType>(parameter, gradientValues.at(parameter), trainingSampleCount);
+            auto paramRef = parameter;
+            paramRef.RecordValueUpdate();
+        }
+    }
+
     LearnerRMSProp::LearnerRMSProp(const vector<Parameter>& parameters,
                                    const LearningRateSchedule& learningRateSchedule,
                                    double gamma, double inc, double dec, double max, double min,
@@ -805,6 +1235,29 @@ namespace CNTK
         return MakeSharedObject<LearnerAdam>(parameters, learningRateSchedule, momentumSchedule, unitGain, varianceMomentumSchedule, epsilon, adamax, additionalOptions);
     }
 
+    LearnerPtr LarsLearner(const vector<Parameter>& parameters,
+                           const LearningRateSchedule& learningRateSchedule,
+                           const MomentumSchedule& momentumSchedule,
+                           bool unitGain, /*=true*/
+                           double trustRatioCoefficient, /*= 0.001*/
+                           double epsilon, /*= 1e-8*/
+                           AdditionalLearningOptions additionalOptions /*= AdditionalLearningOptions()*/)
+    {
+        return MakeSharedObject<LearnerLars>(parameters, learningRateSchedule, momentumSchedule, unitGain, trustRatioCoefficient, epsilon, additionalOptions);
+    }
+
+    LearnerPtr LambLearner(const vector<Parameter>& parameters,
+                           const LearningRateSchedule& learningRateSchedule,
+                           const MomentumSchedule& momentumSchedule,
+                           bool unitGain, /*=true*/
+                           const MomentumSchedule& varianceMomentumSchedule, /*= MomentumAsTimeConstantSchedulePerSample(2 * 3600 * 100)*/
+                           double trustRatioCoefficient, /*= 1.0*/
+                           double epsilon, /*= 1e-6*/
+                           AdditionalLearningOptions additionalOptions /*= AdditionalLearningOptions()*/)
+    {
+        return MakeSharedObject<LearnerLamb>(parameters, learningRateSchedule, momentumSchedule, unitGain, varianceMomentumSchedule, trustRatioCoefficient, epsilon, additionalOptions);
+    }
+
     LearnerPtr AdaGradLearner(const vector<Parameter>& parameters,
                               const LearningRateSchedule& learningRateSchedule,
                               bool needAveMultiplier /*= true*/,
@@ -27,6 +27,16 @@ namespace CNTK
 
         virtual void ResetSmoothedGradients() override final;
 
+        // Streaming variant of Update() for callers that obtain gradients one parameter at a
+        // time, e.g. as each distributed aggregation lands. BeginStreamingUpdate returns false
+        // when the learning rate is zero and no updates should be applied; UpdateParameter
+        // applies the update for a single parameter; EndStreamingUpdate commits the minibatch
+        // bookkeeping once all parameters have been fed. Learners overriding TryBatchUpdate
+        // do not get multi-tensor fusion on this path.
+        bool BeginStreamingUpdate(size_t trainingSampleCount);
+        void UpdateParameter(const Parameter& parameter, const NDArrayViewPtr& gradientValue, size_t trainingSampleCount);
+        void EndStreamingUpdate(size_t trainingSampleCount, bool sweepEnd);
+
     protected:
         // allocateSmoothGradients flag specifies whether NDArrayViews for smoothed gradients can be allocated 
         // in the base class constructor (in which case they are allocated with the shapes identical to the shapes of
@@ -39,6 +49,17 @@ namespace CNTK
 
         virtual void Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue, const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const = 0;
 
+        // Learners that can fold the whole parameter set into a few fused kernel launches
+        // (multi-tensor batching) override this and perform the complete minibatch update,
+        // including per-parameter pre-/postprocessing; returning false falls back to the
+        // per-parameter Update() loop above.
+        virtual bool TryBatchUpdate(std::unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount)
+        {
+            UNUSED(gradientValues);
+            UNUSED(trainingSampleCount);
+            return false;
+        }
+
         std::string LearnerType() const;
 
         // Returns current (per-sample) learning rate.
@@ -283,6 +304,12 @@ namespace CNTK
         template <typename ElementType>
         void Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue, const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const;
 
+        // multi-tensor batched update: all parameters in a few fused kernel launches
+        virtual bool TryBatchUpdate(std::unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount) override;
+
+        template <typename ElementType>
+        void BatchUpdate(std::unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount);
+
     private:
 
         // returns current per-minibatch variance momentum value.
@@ -297,6 +324,93 @@ namespace CNTK
         bool m_adamax;
     };
 
+    // LARS (layer-wise adaptive rate scaling): momentum SGD whose learning rate is scaled per
+    // layer by trustRatioCoefficient * ||w|| / (||grad|| + epsilon), keeping each update
+    // proportional to the magnitude of the parameter it updates. This holds accuracy at batch
+    // sizes where plain momentum SGD degrades. On the batched path, all parameter and gradient
+    // norms of a minibatch are computed with multi-tensor batching, so an update costs one
+    // device synchronization instead of two per layer.
+    class LearnerLars : public LearnerMomentumSGD
+    {
+    public:
+        LearnerLars(const std::vector<Parameter>& parameters,
+                    const LearningRateSchedule& learningRateSchedule,
+                    const MomentumSchedule& momentumSchedule,
+                    bool unitGain,
+                    double trustRatioCoefficient,
+                    double epsilon,
+                    AdditionalLearningOptions additionalOptions);
+
+    protected:
+        virtual void Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue, const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const override;
+
+        template <typename ElementType>
+        void Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue, const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const;
+
+        // multi-tensor batched update: all per-layer norms in a few fused reductions
+        virtual bool TryBatchUpdate(std::unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount) override;
+
+        template <typename ElementType>
+        void BatchUpdate(std::unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount);
+
+        // per-layer learning rate multiplier from the squared parameter and gradient norms
+        double TrustRatio(double squaredParameterNorm, double squaredGradientNorm) const;
+
+    private:
+        double m_trustRatioCoefficient;
+        double m_epsilon;
+    };
+
+    // LAMB: Adam-style moment estimates combined with a LARS-style per-layer trust ratio that
+    // is applied to the preconditioned update rather than the raw gradient. The smoothed
+    // gradient layout matches LearnerAdam (mean and variance side by side); a per-parameter
+    // scratch tensor holds the preconditioned update so that all parameter and update norms
+    // can be computed with multi-tensor batching before any update is applied.
+    class LearnerLamb : public LearnerMomentumSGD
+    {
+    public:
+        LearnerLamb(const std::vector<Parameter>& parameters,
+                    const LearningRateSchedule& learningRateSchedule,
+                    const MomentumSchedule& momentumSchedule,
+                    bool unitGain,
+                    const MomentumSchedule& varianceMomentumSchedule,
+                    double trustRatioCoefficient,
+                    double epsilon,
+                    AdditionalLearningOptions additionalOptions);
+
+    protected:
+        virtual void Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue, const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const override;
+
+        template <typename ElementType>
+        void Update(const Parameter& parameter, const NDArrayViewPtr& gradientValue, const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const;
+
+        // multi-tensor batched update: all per-layer norms in a few fused reductions
+        virtual bool TryBatchUpdate(std::unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount) override;
+
+        template <typename ElementType>
+        void BatchUpdate(std::unordered_map<Parameter, NDArrayViewPtr>& gradientValues, size_t trainingSampleCount);
+
+        // updates the moment estimates and writes the bias-corrected preconditioned update
+        // m_hat / (sqrt(v_hat) + epsilon) into the parameter's scratch tensor
+        template <typename ElementType>
+        void ComputeUpdate(const Parameter& parameter, const NDArrayViewPtr& gradientValue, const NDArrayViewPtr& smoothedGradientValue, size_t trainingSampleCount) const;
+
+        double TrustRatio(double squaredParameterNorm, double squaredUpdateNorm) const;
+
+    private:
+        // returns current per-minibatch variance momentum value.
+        double VarianceMomentumValueForMB(size_t minibatchSize) const
+        {
+            return MomentumValueForMB(m_varianceMomentumSchedule, minibatchSize);
+        }
+
+        mutable std::unordered_map<Parameter, double> m_smoothedCounts;
+        std::unordered_map<Parameter, NDArrayViewPtr> m_updateScratch;
+        MomentumSchedule m_varianceMomentumSchedule;
+        double m_trustRatioCoefficient;
+        double m_epsilon;
+    };
+
     class LearnerRMSProp : public LearnerBase
     {
     public:
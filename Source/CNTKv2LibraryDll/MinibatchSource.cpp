@@ -458,9 +458,19 @@ namespace CNTK
             }
 
             augmentedConfiguration[L"frameMode"] = configuration.isFrameModeEnabled;
-            augmentedConfiguration[L"multiThreadedDeserialization"] = configuration.isMultithreaded;
+            augmentedConfiguration[L"multiThreadedDeserialization"] =
+                configuration.isMultithreaded || (configuration.deserializationThreadCount != 0);
             augmentedConfiguration[L"traceLevel"] = static_cast<size_t>(configuration.traceLevel);
 
+            if (configuration.deserializationThreadCount != 0)
+                augmentedConfiguration[L"deserializationThreadCount"] = configuration.deserializationThreadCount;
+
+            if (configuration.prefetchDepth != 0)
+                augmentedConfiguration[L"prefetchDepth"] = configuration.prefetchDepth;
+
+            if (configuration.prefetchBudgetInBytes != 0)
+                augmentedConfiguration[L"prefetchBudgetInBytes"] = configuration.prefetchBudgetInBytes;
+
             // The CNTK reader implementation requires for each deserializer both the module and deserializer type be specified
             // This is redundant and the V2 API users will just specify type from which the module is automatically inferred
             // TODO: This should be done in the same manner for CNTK exe as well.
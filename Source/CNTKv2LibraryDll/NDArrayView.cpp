@@ -29,8 +29,8 @@ namespace CNTK
                             (int)bufferSizeInBytes, viewShape.AsString().c_str());
 
         auto matrixDims = GetMatrixDimensions(viewShape);
-        std::shared_ptr<Matrix<ElementType>> matrix = std::make_shared<Matrix<ElementType>>(matrixDims.first, matrixDims.second, (ElementType*)dataBuffer, AsCNTKImplDeviceId(device), matrixFlagDontOwnBuffer);
-        return new TensorView<ElementType>(matrix, AsTensorViewShape(viewShape));
+        std::shared_ptr<Matrix<ElementType>> matrix = std::allocate_shared<Matrix<ElementType>>(PooledViewAllocator<Matrix<ElementType>>(), matrixDims.first, matrixDims.second, (ElementType*)dataBuffer, AsCNTKImplDeviceId(device), matrixFlagDontOwnBuffer);
+        return ViewObjectPool::NewTensorView<ElementType>(matrix, AsTensorViewShape(viewShape));
     }
 
     static void* AllocateTensorView(CNTK::DataType dataType,
@@ -64,7 +64,7 @@ namespace CNTK
                                                                                             IsSparseStorageFormat(storageType) ? MatrixType::SPARSE : MatrixType::DENSE,
                                                                                             AsCNTKImplMatrixFormat(storageType),
                                                                                             numNonZeroValues);
-        return new TensorView<ElementType>(matrix, AsTensorViewShape(viewShape));
+        return ViewObjectPool::NewTensorView<ElementType>(matrix, AsTensorViewShape(viewShape));
     }
 
     static void* AllocateTensorView(CNTK::DataType dataType,
@@ -107,20 +107,32 @@ namespace CNTK
     NDArrayView::NDArrayView(CNTK::DataType dataType, const DeviceDescriptor& device, CNTK::StorageFormat storageType, const NDShape& viewShape, bool readOnly, void* tensorView)
         : m_dataType(dataType), m_device(device), m_storageFormat(storageType), m_viewShape(viewShape), m_isReadOnly(readOnly)
     {
+        // The TensorView comes from the view object pool and is returned there on destruction;
+        // the control block of the shared_ptr is drawn from the same pool
         m_tensorView = std::shared_ptr<void>(tensorView, [this](void*) {
             switch (m_dataType)
             {
             case DataType::Float:
-                delete GetTensorView<float>();
+                ViewObjectPool::DeleteTensorView(GetTensorView<float>());
                 break;
             case DataType::Double:
-                delete GetTensorView<double>();
+                ViewObjectPool::DeleteTensorView(GetTensorView<double>());
                 break;
             default:
                 LogicError("Unsupported DataType %s", DataTypeName(m_dataType));
                 break;
             }
-        });
+        }, PooledViewAllocator<void>());
+    }
+
+    /*static*/ void* NDArrayView::operator new(size_t size)
+    {
+        return ViewObjectPool::Allocate(size);
+    }
+
+    /*static*/ void NDArrayView::operator delete(void* block, size_t size)
+    {
+        ViewObjectPool::Free(block, size);
     }
 
     NDArrayView::NDArrayView(CNTK::DataType dataType, CNTK::StorageFormat storageType, const NDShape& viewShape, const DeviceDescriptor& device)
@@ -288,17 +300,18 @@ namespace CNTK
         switch (m_dataType)
         {
         case DataType::Float:
-            tensorView = new TensorView<float>(*(GetTensorView<float>()));
+            tensorView = ViewObjectPool::NewTensorView<float>(*(GetTensorView<float>()));
             break;
         case DataType::Double:
-            tensorView = new TensorView<double>(*(GetTensorView<double>()));
+            tensorView = ViewObjectPool::NewTensorView<double>(*(GetTensorView<double>()));
             break;
         default:
             LogicError("NDArrayView::Alias: Unsupported DataType %s", DataTypeName(m_dataType));
             break;
         }
 
-        return MakeSharedObject<NDArrayView>(GetDataType(), Device(), GetStorageFormat(), Shape(), IsReadOnly() || readOnly, tensorView);
+        // Draw the control block from the view object pool as well, so aliasing allocates nothing on the heap in steady state
+        return NDArrayViewPtr(new NDArrayView(GetDataType(), Device(), GetStorageFormat(), Shape(), IsReadOnly() || readOnly, tensorView), [](NDArrayView* ptr) { delete ptr; }, PooledViewAllocator<NDArrayView>());
     }
 
     NDArrayViewPtr NDArrayView::SliceView(const std::vector<size_t>& startOffset, const std::vector<size_t>& extent, bool readOnly) const
@@ -345,11 +358,11 @@ namespace CNTK
             std::pair<size_t, size_t> currentMatrixDims = { currentMatrix->GetNumRows(), currentMatrix->GetNumCols() };
             std::shared_ptr<Matrix<float>> slicedMatrixView;
             if (sliceViewMatrixDims.first != currentMatrixDims.first)
-                slicedMatrixView = make_shared<Matrix<float>>(currentMatrix->Reshaped(1, currentMatrix->GetNumElements()).ColumnSlice(flatBufferOffset, sliceViewShape.TotalSize()));
+                slicedMatrixView = std::allocate_shared<Matrix<float>>(PooledViewAllocator<Matrix<float>>(), currentMatrix->Reshaped(1, currentMatrix->GetNumElements()).ColumnSlice(flatBufferOffset, sliceViewShape.TotalSize()));
             else
-                slicedMatrixView = make_shared<Matrix<float>>(currentMatrix->ColumnSlice(sliceMatrixColumnOffset, sliceViewMatrixDims.second));
+                slicedMatrixView = std::allocate_shared<Matrix<float>>(PooledViewAllocator<Matrix<float>>(), currentMatrix->ColumnSlice(sliceMatrixColumnOffset, sliceViewMatrixDims.second));
 
-            tensorView = new TensorView<float>(slicedMatrixView, AsTensorViewShape(sliceViewShape));
+            tensorView = ViewObjectPool::NewTensorView<float>(slicedMatrixView, AsTensorViewShape(sliceViewShape));
             break;
         }
         case DataType::Double:
@@ -358,11 +371,11 @@ namespace CNTK
             std::pair<size_t, size_t> currentMatrixDims = { currentMatrix->GetNumRows(), currentMatrix->GetNumCols() };
             std::shared_ptr<Matrix<double>> slicedMatrixView;
             if (sliceViewMatrixDims.first != currentMatrixDims.first)
-                slicedMatrixView = make_shared<Matrix<double>>(currentMatrix->Reshaped(1, currentMatrix->GetNumElements()).ColumnSlice(flatBufferOffset, sliceViewShape.TotalSize()));
+                slicedMatrixView = std::allocate_shared<Matrix<double>>(PooledViewAllocator<Matrix<double>>(), currentMatrix->Reshaped(1, currentMatrix->GetNumElements()).ColumnSlice(flatBufferOffset, sliceViewShape.TotalSize()));
             else
-                slicedMatrixView = make_shared<Matrix<double>>(currentMatrix->ColumnSlice(sliceMatrixColumnOffset, sliceViewMatrixDims.second));
+                slicedMatrixView = std::allocate_shared<Matrix<double>>(PooledViewAllocator<Matrix<double>>(), currentMatrix->ColumnSlice(sliceMatrixColumnOffset, sliceViewMatrixDims.second));
 
-            tensorView = new TensorView<double>(slicedMatrixView, AsTensorViewShape(sliceViewShape));
+            tensorView = ViewObjectPool::NewTensorView<double>(slicedMatrixView, AsTensorViewShape(sliceViewShape));
             break;
         }
         default:
@@ -370,7 +383,7 @@ namespace CNTK
             break;
         }
 
-        return MakeSharedObject<NDArrayView>(GetDataType(), Device(), GetStorageFormat(), sliceViewShape, IsReadOnly() || readOnly, tensorView);
+        return NDArrayViewPtr(new NDArrayView(GetDataType(), Device(), GetStorageFormat(), sliceViewShape, IsReadOnly() || readOnly, tensorView), [](NDArrayView* ptr) { delete ptr; }, PooledViewAllocator<NDArrayView>());
     }
 
     NDArrayViewPtr NDArrayView::AsShape(const NDShape& newShape) const
@@ -387,17 +400,17 @@ namespace CNTK
         switch (m_dataType)
         {
         case DataType::Float:
-            tensorView = new TensorView<float>(*(GetTensorView<float>()), newTensorShape);
+            tensorView = ViewObjectPool::NewTensorView<float>(*(GetTensorView<float>()), newTensorShape);
             break;
         case DataType::Double:
-            tensorView = new TensorView<double>(*(GetTensorView<double>()), newTensorShape);
+            tensorView = ViewObjectPool::NewTensorView<double>(*(GetTensorView<double>()), newTensorShape);
             break;
         default:
             LogicError("NDArrayView::AsShape: Unsupported DataType %s", DataTypeName(m_dataType));
             break;
         }
 
-        return MakeSharedObject<NDArrayView>(GetDataType(), Device(), GetStorageFormat(), newShape, IsReadOnly(), tensorView);
+        return NDArrayViewPtr(new NDArrayView(GetDataType(), Device(), GetStorageFormat(), newShape, IsReadOnly(), tensorView), [](NDArrayView* ptr) { delete ptr; }, PooledViewAllocator<NDArrayView>());
     }
 
     // TODO: This could actually be strided?
@@ -460,7 +473,7 @@ namespace CNTK
     {
         auto matrixDims = GetMatrixDimensions(shape);
         auto randomNormalMatrix = std::make_shared<Matrix<ElementType>>(Matrix<ElementType>::RandomGaussian(matrixDims.first, matrixDims.second, AsCNTKImplDeviceId(device), (ElementType)mean, (ElementType)stdDev, seed));
-        auto tensorView = new TensorView<ElementType>(randomNormalMatrix, AsTensorViewShape(shape));
+        auto tensorView = ViewObjectPool::NewTensorView<ElementType>(randomNormalMatrix, AsTensorViewShape(shape));
 
         return MakeSharedObject<NDArrayView>(AsDataType<ElementType>(), device, StorageFormat::Dense, shape, false, tensorView);
     }
@@ -470,7 +483,7 @@ namespace CNTK
     {
         auto matrixDims = GetMatrixDimensions(shape);
         auto randomUniformMatrix = std::make_shared<Matrix<ElementType>>(Matrix<ElementType>::RandomUniform(matrixDims.first, matrixDims.second, AsCNTKImplDeviceId(device), (ElementType)rangeBegin, (ElementType)rangeEnd, seed));
-        auto tensorView = new TensorView<ElementType>(randomUniformMatrix, AsTensorViewShape(shape));
+        auto tensorView = ViewObjectPool::NewTensorView<ElementType>(randomUniformMatrix, AsTensorViewShape(shape));
 
         return MakeSharedObject<NDArrayView>(AsDataType<ElementType>(), device, StorageFormat::Dense, shape, false, tensorView);
     }
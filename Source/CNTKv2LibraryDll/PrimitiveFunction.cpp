@@ -164,7 +164,7 @@ namespace CNTK
         // We currently require that the inputs' dynamic axes, if any, match
         std::vector<Axis> outputDynamicAxes;
         if ((op == PrimitiveOpType::SumAll) ||
-            (op == PrimitiveOpType::ReduceElements && functionConfig[PrimitiveFunction::AttributeNameAxis].Value<Axis>() == Axis::AllAxes()) ||
+            (op == PrimitiveOpType::ReduceElements && functionConfig.Contains(PrimitiveFunction::AttributeNameAxis) && functionConfig[PrimitiveFunction::AttributeNameAxis].Value<Axis>() == Axis::AllAxes()) ||
             (op == PrimitiveOpType::SquaredError) ||
             (op == PrimitiveOpType::CrossEntropyWithSoftmax) ||
             (op == PrimitiveOpType::EditDistanceError) ||
@@ -176,7 +176,7 @@ namespace CNTK
         {
             outputDynamicAxes = std::vector<Axis>({});
         }
-        else if ((op == PrimitiveOpType::ReduceElements) && functionConfig[PrimitiveFunction::AttributeNameAxis].Value<Axis>().IsDynamicAxis() && (inputs[0].DynamicAxes() != Axis::UnknownDynamicAxes()))
+        else if ((op == PrimitiveOpType::ReduceElements) && functionConfig.Contains(PrimitiveFunction::AttributeNameAxis) && functionConfig[PrimitiveFunction::AttributeNameAxis].Value<Axis>().IsDynamicAxis() && (inputs[0].DynamicAxes() != Axis::UnknownDynamicAxes()))
         {
             reduceAxis(functionConfig[PrimitiveFunction::AttributeNameAxis].Value<Axis>(), inputs[0], outputDynamicAxes);
         }
@@ -260,6 +260,124 @@ namespace CNTK
         return outputDynamicAxes;
     }
 
+    // Process-wide memoization of shape inference results. Programmatically built graphs repeat
+    // the same few (op, input signature) combinations tens of thousands of times, and for
+    // elementwise ops the inferred output is fully determined by the op and the input signatures.
+    // Only ops whose inference neither consults attributes nor updates operand shapes/types are
+    // memoized, and only when every input signature is fully known, so the inference side effects
+    // (propagating data types and inferred dimensions into Parameters/Constants) can never be
+    // skipped by a cache hit.
+    struct CachedOutputSignature
+    {
+        NDShape shape;
+        DataType dataType;
+        std::vector<Axis> dynamicAxes;
+        bool needsGradient;
+    };
+
+    static std::mutex s_shapeInferenceCacheMutex;
+    static std::unordered_map<std::wstring, CachedOutputSignature> s_shapeInferenceCache;
+
+    static bool IsShapeInferenceCacheable(PrimitiveOpType op)
+    {
+        switch (op)
+        {
+        case PrimitiveOpType::Plus:
+        case PrimitiveOpType::LogPlus:
+        case PrimitiveOpType::Pow:
+        case PrimitiveOpType::Minus:
+        case PrimitiveOpType::ElementTimes:
+        case PrimitiveOpType::Equal:
+        case PrimitiveOpType::NotEqual:
+        case PrimitiveOpType::Less:
+        case PrimitiveOpType::LessEqual:
+        case PrimitiveOpType::Greater:
+        case PrimitiveOpType::GreaterEqual:
+        case PrimitiveOpType::Negate:
+        case PrimitiveOpType::Sigmoid:
+        case PrimitiveOpType::Tanh:
+        case PrimitiveOpType::ReLU:
+        case PrimitiveOpType::Exp:
+        case PrimitiveOpType::Log:
+        case PrimitiveOpType::Sqrt:
+        case PrimitiveOpType::Floor:
+        case PrimitiveOpType::Abs:
+        case PrimitiveOpType::Reciprocal:
+        case PrimitiveOpType::Softmax:
+        case PrimitiveOpType::Hardmax:
+        case PrimitiveOpType::LogSoftmax:
+        case PrimitiveOpType::Sin:
+        case PrimitiveOpType::Cos:
+        case PrimitiveOpType::Pass:
+        case PrimitiveOpType::StopGradient:
+        case PrimitiveOpType::ELU:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Returns an empty string when any input signature is not fully known, i.e. when running the
+    // actual inference could update an operand and the result must not be memoized.
+    static std::wstring ShapeInferenceCacheKey(PrimitiveOpType op, const std::vector<Variable>& inputs)
+    {
+        std::wstringstream key;
+        key << (int)op;
+        for (const auto& input : inputs)
+        {
+            if (input.Shape().IsUnknown() || input.Shape().HasUnboundDimension() ||
+                (input.GetDataType() == DataType::Unknown) ||
+                (input.DynamicAxes() == Axis::UnknownDynamicAxes()))
+                return L"";
+
+            key << L"|" << (int)input.GetDataType() << L"," << (input.NeedsGradient() ? 1 : 0) << L"," << (input.IsSparse() ? 1 : 0);
+            for (auto dim : input.Shape().Dimensions())
+                key << L"," << dim;
+            for (const auto& axis : input.DynamicAxes())
+                key << L";" << axis.Name() << L"," << (axis.IsOrdered() ? 1 : 0);
+        }
+
+        return key.str();
+    }
+
+    bool PrimitiveFunction::TryInferOutputsFromCache(std::vector<Variable>& outputs)
+    {
+        if (!IsShapeInferenceCacheable(m_op))
+            return false;
+
+        auto key = ShapeInferenceCacheKey(m_op, m_inputs);
+        if (key.empty())
+            return false;
+
+        CachedOutputSignature cached;
+        {
+            std::lock_guard<std::mutex> guard(s_shapeInferenceCacheMutex);
+            auto it = s_shapeInferenceCache.find(key);
+            if (it == s_shapeInferenceCache.end())
+                return false;
+
+            cached = it->second;
+        }
+
+        outputs.push_back(OutputVariable(cached.shape, cached.dataType, cached.dynamicAxes, cached.needsGradient, Name().empty() ? L"" : Name()));
+        return true;
+    }
+
+    void PrimitiveFunction::CacheInferredOutput(const Variable& output)
+    {
+        if (!IsShapeInferenceCacheable(m_op))
+            return;
+
+        // Build the key from the post-inference input signatures; if any of them is still not
+        // fully known the result is not memoizable
+        auto key = ShapeInferenceCacheKey(m_op, m_inputs);
+        if (key.empty() || output.Shape().IsUnknown())
+            return;
+
+        std::lock_guard<std::mutex> guard(s_shapeInferenceCacheMutex);
+        s_shapeInferenceCache[key] = { output.Shape(), output.GetDataType(), output.DynamicAxes(), output.NeedsGradient() };
+    }
+
     void PrimitiveFunction::InferOutputs(std::vector<Variable>& outputs)
     {
         if (m_op == PrimitiveOpType::Combine)
@@ -268,6 +386,9 @@ namespace CNTK
             outputs.push_back(OutputVariable(m_inputs[0].Shape(), m_inputs[0].GetDataType(), m_inputs[0].DynamicAxes(), m_inputs[0].NeedsGradient(), Name()));
         else
         {
+            if (TryInferOutputsFromCache(outputs))
+                return;
+
             DataType outputDataType = GetOutputDataType(m_op, m_inputs, true);
             std::vector<Axis> outputDynamicAxes = GetOutputDynamicAxes(m_op, m_inputs, this, m_attributes);
             bool needsGradient = std::any_of(m_inputs.begin(), m_inputs.end(), [](const Variable& input) { return input.NeedsGradient(); });
@@ -791,6 +912,17 @@ namespace CNTK
                             if (m_attributes.Contains(PrimitiveFunction::AttributeNameReductionKeepDimensions))
                                 keepDimensions = m_attributes[PrimitiveFunction::AttributeNameReductionKeepDimensions].Value<bool>();
 
+                            // a set of static axes reduces in one pass, cf. the multi-axis ReduceElementsNode
+                            if (m_attributes.Contains(PrimitiveFunction::AttributeNameAxisVec))
+                            {
+                                auto axes = AsVector<Axis>(m_attributes[PrimitiveFunction::AttributeNameAxisVec].Value<std::vector<DictionaryValue>>());
+                                std::vector<int> reductionAxes;
+                                for (auto& axis : axes)
+                                    reductionAxes.push_back(NormalizeAxis(axis, m_inputs[0]).StaticAxisIndex());
+                                outputShape = ReductionOpOutputShape(m_op, m_inputs[0].Shape(), reductionAxes, /*preserveReductionAxes =*/ keepDimensions);
+                                break;
+                            }
+
                             auto reductionAxis = NormalizeAxis(m_attributes[PrimitiveFunction::AttributeNameAxis].Value<Axis>(), m_inputs[0]);
                             if (reductionAxis == Axis::AllStaticAxes() || reductionAxis == Axis::AllAxes())
                                 outputShape = keepDimensions ? NDShape(m_inputs[0].Shape().Rank(), 1) : NDShape({});
@@ -951,6 +1083,7 @@ namespace CNTK
 
             auto primaryOutput = OutputVariable(outputShape, outputDataType, outputDynamicAxes, needsGradient, Name().empty() ? L"" : Name());
             outputs.push_back(primaryOutput);
+            CacheInferredOutput(primaryOutput);
             if (m_op == PrimitiveOpType::UnpackSequence)
             {
                 auto suppressMaskOutput = m_attributes[PrimitiveFunction::AttributeNameSequenceUnpackSuppressMaskOutput].Value<bool>();
@@ -1115,7 +1248,8 @@ namespace CNTK
             auto runCount = Constant::Scalar(0.0f, device);
             // HACK: uid has to be changed (by adding some unique prefix to the auto-generated "Constant"+ID_counter) 
             // to avoid conflicts with uids recorded in the function graph, which we are deserializing.
-            runCount.m_dataFields->m_uid = L"BatchNormSampleCount" + runCount.m_dataFields->m_uid;
+            runCount.m_dataFields->m_uid = L"BatchNormSampleCount" + runCount.m_dataFields->Uid();
+            runCount.m_dataFields->m_hasDeferredUid = false;
             inputs.push_back(runCount);
         }
         
@@ -1293,6 +1427,7 @@ namespace CNTK
         // Restore the original uid, which other functions in the graph depend on
         // (their inputs refer to the uids of this UDF outputs, which are generated base on the uid of this UDF).
         udf->m_uid = uid;
+        udf->m_hasDeferredUid = false;
         
         return udf;
     }
@@ -268,7 +268,7 @@ namespace CNTK
 
     public:
         PrimitiveFunction(PrimitiveOpType op, const std::vector<Variable>& inputs, Dictionary&& functionConfig, const std::wstring& functionName = L"")
-            : PrimitiveFunction(op, inputs, std::move(functionConfig), functionName, GenerateUid(op))
+            : PrimitiveFunction(op, inputs, std::move(functionConfig), functionName, /*uid (deferred, built from the op name on first access) =*/ std::wstring())
         {}
 
         // Primitive functions are currently implemented using the core CNTK engine ComputationNode types
@@ -735,6 +735,11 @@ namespace CNTK
 
         void InferOutputs(std::vector<Variable>& outputs) override;
 
+        // Process-wide memoization of shape inference results for side-effect free elementwise
+        // ops whose input signatures are fully known; see the cache in PrimitiveFunction.cpp.
+        bool TryInferOutputsFromCache(std::vector<Variable>& outputs);
+        void CacheInferredOutput(const Variable& output);
+
         FunctionPtr Clone(const std::vector<Variable>& clonedInputs) override
         {
             return MakeSharedObject<PrimitiveFunction>(OpType(), clonedInputs, Dictionary(Attributes()), Name());
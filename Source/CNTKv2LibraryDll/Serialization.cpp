@@ -6,11 +6,14 @@
 #include "stdafx.h"
 #include "CNTKLibrary.h"
 #include "Utils.h"
+#include "Serialization.h"
 #include <istream>
 #include <ostream>
 #include <string>
 #include <vector>
 #include <limits>
+#include <thread>
+#include <algorithm>
 
 #ifdef _MSC_VER
 #include <io.h>
@@ -38,7 +41,21 @@ namespace CNTK
         friend class Dictionary;
         friend class DictionaryValue;
 
+        friend void SerializeStreaming(const Dictionary&, std::ostream&, bool);
+        friend void DeserializeStreaming(std::istream&, Dictionary&);
+
     private:
+        static void WriteStreaming(std::ostream& stream, const Dictionary& src, bool compressPayloads);
+        static void ReadStreaming(std::istream& stream, Dictionary& dst);
+
+        static void WriteStreaming(std::ostream& stream, const DictionaryValue& src, bool compressPayloads);
+        static void ReadStreaming(std::istream& stream, DictionaryValue& dst);
+
+        static void WriteStreaming(std::ostream& stream, const NDShape& src);
+        static NDShape* ReadShapeStreaming(std::istream& stream);
+
+        static void WriteStreaming(std::ostream& stream, const NDArrayView& src, bool compressPayloads);
+        static NDArrayView* ReadArrayViewStreaming(std::istream& stream);
         static proto::DictionaryValue* CreateProto(const DictionaryValue& src, Arena* arena = nullptr);
         static proto::Dictionary* CreateProto(const Dictionary& src, Arena* arena = nullptr);
         static proto::Vector* CreateProto(const std::vector<DictionaryValue>& src, Arena* arena = nullptr);
@@ -130,8 +147,71 @@ namespace CNTK
             memcpy(buffer, src.data(), size * sizeof(T));
         }
 
+        // A payload copy into an already allocated NDArrayView, deferred during a dictionary
+        // tree walk so that all tensor payloads can be copied in parallel once the walk completes.
+        struct DeferredArrayViewCopy
+        {
+            const proto::NDArrayView* source;
+            NDArrayView* destination;
+        };
+
+        // Installs a collector for deferred payload copies for the lifetime of the scope and
+        // drains it across a pool of worker threads on destruction. Nested scopes are no-ops;
+        // the outermost scope owns the collected copies.
+        struct ParallelArrayViewCopyScope
+        {
+            ParallelArrayViewCopyScope();
+            ~ParallelArrayViewCopyScope();
+            std::vector<DeferredArrayViewCopy> pending;
+        };
+
+        static thread_local std::vector<DeferredArrayViewCopy>* s_pendingArrayViewCopies;
     };
 
+    thread_local std::vector<Serializer::DeferredArrayViewCopy>* Serializer::s_pendingArrayViewCopies = nullptr;
+
+    Serializer::ParallelArrayViewCopyScope::ParallelArrayViewCopyScope()
+    {
+        if (s_pendingArrayViewCopies == nullptr)
+            s_pendingArrayViewCopies = &pending;
+    }
+
+    Serializer::ParallelArrayViewCopyScope::~ParallelArrayViewCopyScope()
+    {
+        if (s_pendingArrayViewCopies != &pending)
+            return;
+
+        s_pendingArrayViewCopies = nullptr;
+        if (pending.empty())
+            return;
+
+        auto worker = [this](size_t firstIndex, size_t stride)
+        {
+            for (size_t i = firstIndex; i < pending.size(); i += stride)
+            {
+                const auto& deferred = pending[i];
+                if (deferred.destination->GetDataType() == DataType::Float)
+                    CopyData<float>(deferred.source->float_values().value(), deferred.destination);
+                else
+                    CopyData<double>(deferred.source->double_values().value(), deferred.destination);
+            }
+        };
+
+        auto numThreads = std::min<size_t>(pending.size(), std::max<size_t>(1, std::thread::hardware_concurrency()));
+        if (numThreads == 1)
+        {
+            worker(0, 1);
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; ++i)
+            threads.emplace_back(worker, i, numThreads);
+        for (auto& thread : threads)
+            thread.join();
+    }
+
     /*static*/ proto::NDShape* Serializer::CreateProto(const NDShape& src, Arena* arena)
     {
         proto::NDShape* dst = (arena != nullptr) ? 
@@ -209,6 +289,14 @@ namespace CNTK
         auto storageFormat = FromProtoType(src.storage_format());
         NDArrayView* dst = new NDArrayView(dataType, storageFormat, *shape, DeviceDescriptor::CPUDevice());
 
+        // When a parallel-copy scope is active, only allocate the view here and defer the payload
+        // copy, so the enclosing dictionary tree walk is not serialized on large tensor reads.
+        if (s_pendingArrayViewCopies != nullptr)
+        {
+            s_pendingArrayViewCopies->push_back({ &src, dst });
+            return dst;
+        }
+
         if (dataType == DataType::Float)
         {
             CopyData<float>(src.float_values().value(), dst);
@@ -370,6 +458,496 @@ namespace CNTK
         }
     }
 
+    namespace
+    {
+        // Streaming format framing: magic marker, format version, flags, then the recursively
+        // encoded dictionary with NDArrayView payloads split into chunks of c_payloadChunkSize
+        // bytes. Each chunk is framed as [raw size][stored size][bytes]; a stored size smaller
+        // than the raw size marks a compressed chunk.
+        const char c_streamingMagic[8] = { 'C', 'N', 'T', 'K', 'S', 'T', 'R', 'M' };
+        const uint32_t c_streamingFormatVersion = 1;
+        const uint32_t c_streamingFlagCompressed = 1;
+        const size_t c_payloadChunkSize = 1 << 20;
+
+        void WriteRaw(std::ostream& stream, const void* data, size_t size)
+        {
+            stream.write(reinterpret_cast<const char*>(data), size);
+            if (stream.fail())
+                RuntimeError("Failed to write to the output stream.");
+        }
+
+        void ReadRaw(std::istream& stream, void* data, size_t size)
+        {
+            stream.read(reinterpret_cast<char*>(data), size);
+            if (stream.fail() || stream.gcount() != size)
+                RuntimeError("Failed to read from the input stream.");
+        }
+
+        template <typename T>
+        void WritePod(std::ostream& stream, const T& value)
+        {
+            WriteRaw(stream, &value, sizeof(value));
+        }
+
+        template <typename T>
+        T ReadPod(std::istream& stream)
+        {
+            T value;
+            ReadRaw(stream, &value, sizeof(value));
+            return value;
+        }
+
+        void WriteString(std::ostream& stream, const std::string& value)
+        {
+            WritePod<uint32_t>(stream, (uint32_t)value.size());
+            WriteRaw(stream, value.data(), value.size());
+        }
+
+        std::string ReadString(std::istream& stream)
+        {
+            auto size = ReadPod<uint32_t>(stream);
+            std::string value(size, '\0');
+            if (size > 0)
+                ReadRaw(stream, &value[0], size);
+            return value;
+        }
+
+        // Greedy LZ77 compressor with an LZ4-style token encoding: each sequence is a token byte
+        // (high nibble - literal count, low nibble - match length minus the 4-byte minimum, with
+        // 15 indicating 255-continuation bytes), the literals, a 2-byte match offset and any match
+        // length continuation bytes. The final sequence carries literals only. Returns the
+        // compressed size, or 0 when the input does not shrink into outputCapacity.
+        size_t CompressChunk(const unsigned char* input, size_t inputSize, unsigned char* output, size_t outputCapacity)
+        {
+            const size_t minMatchLength = 4;
+            const size_t maxMatchOffset = 65535;
+
+            std::vector<uint32_t> hashTable(1 << 16, uint32_t(-1));
+            auto hashAt = [input](size_t position)
+            {
+                uint32_t value;
+                memcpy(&value, input + position, sizeof(value));
+                return (value * 2654435761u) >> 16;
+            };
+
+            size_t outPos = 0;
+            auto writeByte = [&outPos, output, outputCapacity](unsigned char value)
+            {
+                if (outPos >= outputCapacity)
+                    return false;
+                output[outPos++] = value;
+                return true;
+            };
+            auto writeLength = [&writeByte](size_t remainder)
+            {
+                while (remainder >= 255)
+                {
+                    if (!writeByte(255))
+                        return false;
+                    remainder -= 255;
+                }
+                return writeByte((unsigned char)remainder);
+            };
+            auto writeLiterals = [&](size_t anchor, size_t literalLength)
+            {
+                if (outPos + literalLength > outputCapacity)
+                    return false;
+                memcpy(output + outPos, input + anchor, literalLength);
+                outPos += literalLength;
+                return true;
+            };
+
+            size_t position = 0;
+            size_t anchor = 0;
+            while (position + minMatchLength <= inputSize)
+            {
+                auto hash = hashAt(position);
+                auto candidate = hashTable[hash];
+                hashTable[hash] = (uint32_t)position;
+
+                if (candidate == uint32_t(-1) ||
+                    position - candidate > maxMatchOffset ||
+                    memcmp(input + candidate, input + position, minMatchLength) != 0)
+                {
+                    position++;
+                    continue;
+                }
+
+                size_t matchLength = minMatchLength;
+                while (position + matchLength < inputSize && input[candidate + matchLength] == input[position + matchLength])
+                    matchLength++;
+
+                size_t literalLength = position - anchor;
+                unsigned char token = (unsigned char)
+                    ((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchLength - minMatchLength, 15));
+                if (!writeByte(token))
+                    return 0;
+                if (literalLength >= 15 && !writeLength(literalLength - 15))
+                    return 0;
+                if (!writeLiterals(anchor, literalLength))
+                    return 0;
+
+                size_t offset = position - candidate;
+                if (!writeByte((unsigned char)(offset & 0xFF)) || !writeByte((unsigned char)(offset >> 8)))
+                    return 0;
+                if (matchLength - minMatchLength >= 15 && !writeLength(matchLength - minMatchLength - 15))
+                    return 0;
+
+                position += matchLength;
+                anchor = position;
+            }
+
+            // The remaining input goes out as a final, literals-only sequence.
+            size_t literalLength = inputSize - anchor;
+            if (literalLength > 0)
+            {
+                if (!writeByte((unsigned char)(std::min<size_t>(literalLength, 15) << 4)))
+                    return 0;
+                if (literalLength >= 15 && !writeLength(literalLength - 15))
+                    return 0;
+                if (!writeLiterals(anchor, literalLength))
+                    return 0;
+            }
+
+            return outPos;
+        }
+
+        // Returns the decompressed size, or SIZE_MAX when the input is malformed.
+        size_t DecompressChunk(const unsigned char* input, size_t inputSize, unsigned char* output, size_t outputCapacity)
+        {
+            const size_t minMatchLength = 4;
+
+            size_t inPos = 0;
+            size_t outPos = 0;
+            auto readLength = [input, inputSize, &inPos](size_t& length)
+            {
+                unsigned char extra;
+                do
+                {
+                    if (inPos >= inputSize)
+                        return false;
+                    extra = input[inPos++];
+                    length += extra;
+                } while (extra == 255);
+                return true;
+            };
+
+            while (inPos < inputSize)
+            {
+                unsigned char token = input[inPos++];
+
+                size_t literalLength = token >> 4;
+                if (literalLength == 15 && !readLength(literalLength))
+                    return SIZE_MAX;
+                if (inPos + literalLength > inputSize || outPos + literalLength > outputCapacity)
+                    return SIZE_MAX;
+                memcpy(output + outPos, input + inPos, literalLength);
+                inPos += literalLength;
+                outPos += literalLength;
+
+                if (inPos == inputSize)
+                    break; // the final sequence carries no match
+
+                if (inPos + 2 > inputSize)
+                    return SIZE_MAX;
+                size_t offset = input[inPos] | (size_t(input[inPos + 1]) << 8);
+                inPos += 2;
+
+                size_t matchLength = (token & 0xF) + minMatchLength;
+                if ((token & 0xF) == 15 && !readLength(matchLength))
+                    return SIZE_MAX;
+                if (offset == 0 || offset > outPos || outPos + matchLength > outputCapacity)
+                    return SIZE_MAX;
+
+                // The match may overlap its own output, so copy byte by byte.
+                for (size_t i = 0; i < matchLength; ++i, ++outPos)
+                    output[outPos] = output[outPos - offset];
+            }
+
+            return outPos;
+        }
+
+        void WritePayload(std::ostream& stream, const char* data, size_t totalBytes, bool compress)
+        {
+            WritePod<uint64_t>(stream, totalBytes);
+
+            std::vector<unsigned char> scratch;
+            size_t offset = 0;
+            while (offset < totalBytes)
+            {
+                uint32_t rawSize = (uint32_t)std::min(c_payloadChunkSize, totalBytes - offset);
+                const char* chunk = data + offset;
+                uint32_t storedSize = rawSize;
+
+                if (compress && rawSize >= 64)
+                {
+                    scratch.resize(rawSize - 1);
+                    auto compressedSize = CompressChunk(reinterpret_cast<const unsigned char*>(chunk), rawSize, scratch.data(), scratch.size());
+                    if (compressedSize != 0)
+                    {
+                        storedSize = (uint32_t)compressedSize;
+                        chunk = reinterpret_cast<const char*>(scratch.data());
+                    }
+                }
+
+                WritePod<uint32_t>(stream, rawSize);
+                WritePod<uint32_t>(stream, storedSize);
+                WriteRaw(stream, chunk, storedSize);
+                offset += rawSize;
+            }
+        }
+
+        void ReadPayload(std::istream& stream, char* data, size_t expectedBytes)
+        {
+            auto totalBytes = ReadPod<uint64_t>(stream);
+            if (totalBytes != expectedBytes)
+                RuntimeError("Unexpected payload size (%zu vs. %zu) in the input stream.", (size_t)totalBytes, expectedBytes);
+
+            std::vector<unsigned char> scratch;
+            size_t offset = 0;
+            while (offset < totalBytes)
+            {
+                auto rawSize = ReadPod<uint32_t>(stream);
+                auto storedSize = ReadPod<uint32_t>(stream);
+                if (rawSize == 0 || storedSize > rawSize || offset + rawSize > totalBytes)
+                    RuntimeError("Malformed payload chunk in the input stream.");
+
+                if (storedSize == rawSize)
+                {
+                    ReadRaw(stream, data + offset, rawSize);
+                }
+                else
+                {
+                    scratch.resize(storedSize);
+                    ReadRaw(stream, scratch.data(), storedSize);
+                    if (DecompressChunk(scratch.data(), storedSize, reinterpret_cast<unsigned char*>(data + offset), rawSize) != rawSize)
+                        RuntimeError("Failed to decompress a payload chunk from the input stream.");
+                }
+                offset += rawSize;
+            }
+        }
+    }
+
+    /*static*/ void Serializer::WriteStreaming(std::ostream& stream, const NDShape& src)
+    {
+        WritePod<uint32_t>(stream, (uint32_t)src.Rank());
+        for (size_t i = 0; i < src.Rank(); ++i)
+            WritePod<uint64_t>(stream, src[i]);
+    }
+
+    /*static*/ NDShape* Serializer::ReadShapeStreaming(std::istream& stream)
+    {
+        auto rank = ReadPod<uint32_t>(stream);
+        NDShape* dst = new NDShape(rank);
+        for (size_t i = 0; i < rank; ++i)
+            dst->operator[](i) = (size_t)ReadPod<uint64_t>(stream);
+        return dst;
+    }
+
+    /*static*/ void Serializer::WriteStreaming(std::ostream& stream, const NDArrayView& src, bool compressPayloads)
+    {
+        WritePod<uint32_t>(stream, (uint32_t)src.GetDataType());
+        WritePod<uint32_t>(stream, (uint32_t)src.GetStorageFormat());
+        WriteStreaming(stream, src.Shape());
+
+        auto totalBytes = src.Shape().TotalSize() * DataTypeSize(src.GetDataType());
+        const char* buffer;
+        if (src.GetDataType() == DataType::Float)
+            buffer = reinterpret_cast<const char*>(src.DataBuffer<float>());
+        else if (src.GetDataType() == DataType::Double)
+            buffer = reinterpret_cast<const char*>(src.DataBuffer<double>());
+        else
+            LogicError("Unsupported NDArrayView DataType for streaming serialization.");
+
+        WritePayload(stream, buffer, totalBytes, compressPayloads);
+    }
+
+    /*static*/ NDArrayView* Serializer::ReadArrayViewStreaming(std::istream& stream)
+    {
+        auto dataType = FromProtoType(proto::NDArrayView_DataType(ReadPod<uint32_t>(stream)));
+        auto storageFormat = FromProtoType(proto::NDArrayView_StorageFormat(ReadPod<uint32_t>(stream)));
+        std::unique_ptr<NDShape> shape(ReadShapeStreaming(stream));
+
+        NDArrayView* dst = new NDArrayView(dataType, storageFormat, *shape, DeviceDescriptor::CPUDevice());
+
+        auto totalBytes = shape->TotalSize() * DataTypeSize(dataType);
+        char* buffer;
+        if (dataType == DataType::Float)
+            buffer = reinterpret_cast<char*>(dst->WritableDataBuffer<float>());
+        else
+            buffer = reinterpret_cast<char*>(dst->WritableDataBuffer<double>());
+
+        ReadPayload(stream, buffer, totalBytes);
+        return dst;
+    }
+
+    /*static*/ void Serializer::WriteStreaming(std::ostream& stream, const DictionaryValue& src, bool compressPayloads)
+    {
+        auto valueType = src.ValueType();
+        WritePod<uint32_t>(stream, (uint32_t)ToProtoType(valueType));
+        switch (valueType)
+        {
+        case DictionaryValue::Type::None:
+            break;
+        case DictionaryValue::Type::Bool:
+            WritePod<uint8_t>(stream, src.Value<bool>() ? 1 : 0);
+            break;
+        case DictionaryValue::Type::Int:
+            WritePod<int32_t>(stream, src.Value<int>());
+            break;
+        case DictionaryValue::Type::SizeT:
+            WritePod<uint64_t>(stream, src.Value<size_t>());
+            break;
+        case DictionaryValue::Type::Float:
+            WritePod<float>(stream, src.Value<float>());
+            break;
+        case DictionaryValue::Type::Double:
+            WritePod<double>(stream, src.Value<double>());
+            break;
+        case DictionaryValue::Type::String:
+            WriteString(stream, ToString(src.Value<std::wstring>()));
+            break;
+        case DictionaryValue::Type::NDShape:
+            WriteStreaming(stream, src.Value<NDShape>());
+            break;
+        case DictionaryValue::Type::Axis:
+        {
+            const auto& axis = src.Value<Axis>();
+            WritePod<int32_t>(stream, (int32_t)axis.StaticAxisIndex(false));
+            WriteString(stream, ToString(axis.Name()));
+            WritePod<uint8_t>(stream, axis.IsOrdered() ? 1 : 0);
+            break;
+        }
+        case DictionaryValue::Type::Vector:
+        {
+            const auto& vector = src.Value<std::vector<DictionaryValue>>();
+            WritePod<uint32_t>(stream, (uint32_t)vector.size());
+            for (const auto& value : vector)
+                WriteStreaming(stream, value, compressPayloads);
+            break;
+        }
+        case DictionaryValue::Type::Dictionary:
+            WriteStreaming(stream, src.Value<Dictionary>(), compressPayloads);
+            break;
+        case DictionaryValue::Type::NDArrayView:
+            WriteStreaming(stream, src.Value<NDArrayView>(), compressPayloads);
+            break;
+        default:
+            NOT_IMPLEMENTED
+        }
+    }
+
+    /*static*/ void Serializer::ReadStreaming(std::istream& stream, DictionaryValue& dst)
+    {
+        auto valueType = proto::DictionaryValue_Type(ReadPod<uint32_t>(stream));
+        if (!proto::DictionaryValue::Type_IsValid(valueType))
+            RuntimeError("Invalid DictionaryValue type in the input stream.");
+
+        dst.m_valueType = FromProtoType(valueType);
+        switch (valueType)
+        {
+        case proto::DictionaryValue::None:
+            break;
+        case proto::DictionaryValue::Bool:
+            dst.m_data.m_boolean = (ReadPod<uint8_t>(stream) != 0);
+            break;
+        case proto::DictionaryValue::Int:
+            dst.m_data.m_int = ReadPod<int32_t>(stream);
+            break;
+        case proto::DictionaryValue::SizeT:
+            dst.m_data.m_sizeT = (size_t)ReadPod<uint64_t>(stream);
+            break;
+        case proto::DictionaryValue::Float:
+            dst.m_data.m_float = ReadPod<float>(stream);
+            break;
+        case proto::DictionaryValue::Double:
+            dst.m_data.m_double = ReadPod<double>(stream);
+            break;
+        case proto::DictionaryValue::String:
+            dst.m_data.m_ptr = new std::wstring(ToWString(ReadString(stream)));
+            break;
+        case proto::DictionaryValue::NDShape:
+            dst.m_data.m_ptr = ReadShapeStreaming(stream);
+            break;
+        case proto::DictionaryValue::Axis:
+        {
+            auto staticAxisIdx = (int)ReadPod<int32_t>(stream);
+            auto name = ReadString(stream);
+            auto isOrdered = (ReadPod<uint8_t>(stream) != 0);
+            if (!Axis(staticAxisIdx).IsDynamicAxis())
+                dst.m_data.m_ptr = new Axis(staticAxisIdx);
+            else
+                dst.m_data.m_ptr = new Axis(ToWString(name), isOrdered);
+            break;
+        }
+        case proto::DictionaryValue::Vector:
+        {
+            auto size = ReadPod<uint32_t>(stream);
+            auto vector = new std::vector<DictionaryValue>(size);
+            for (size_t i = 0; i < size; ++i)
+                ReadStreaming(stream, vector->at(i));
+            dst.m_data.m_ptr = vector;
+            break;
+        }
+        case proto::DictionaryValue::Dictionary:
+        {
+            auto dictionary = new Dictionary();
+            ReadStreaming(stream, *dictionary);
+            dst.m_data.m_ptr = dictionary;
+            break;
+        }
+        case proto::DictionaryValue::NDArrayView:
+            dst.m_data.m_ptr = ReadArrayViewStreaming(stream);
+            break;
+        }
+    }
+
+    /*static*/ void Serializer::WriteStreaming(std::ostream& stream, const Dictionary& src, bool compressPayloads)
+    {
+        WritePod<uint64_t>(stream, src.s_version);
+        WritePod<uint32_t>(stream, (uint32_t)src.Size());
+        for (const auto& kv : src)
+        {
+            WriteString(stream, ToString(kv.first));
+            WriteStreaming(stream, kv.second, compressPayloads);
+        }
+    }
+
+    /*static*/ void Serializer::ReadStreaming(std::istream& stream, Dictionary& dst)
+    {
+        ReadPod<uint64_t>(stream); // dictionary version, unused for now
+        auto size = ReadPod<uint32_t>(stream);
+        dst.m_dictionaryData->reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto key = ReadString(stream);
+            ReadStreaming(stream, dst[ToWString(key)]);
+        }
+    }
+
+    void SerializeStreaming(const Dictionary& dictionary, std::ostream& stream, bool compressPayloads)
+    {
+        WriteRaw(stream, c_streamingMagic, sizeof(c_streamingMagic));
+        WritePod<uint32_t>(stream, c_streamingFormatVersion);
+        WritePod<uint32_t>(stream, compressPayloads ? c_streamingFlagCompressed : 0);
+        Serializer::WriteStreaming(stream, dictionary, compressPayloads);
+    }
+
+    void DeserializeStreaming(std::istream& stream, Dictionary& dictionary)
+    {
+        char magic[sizeof(c_streamingMagic)];
+        ReadRaw(stream, magic, sizeof(magic));
+        if (memcmp(magic, c_streamingMagic, sizeof(magic)) != 0)
+            RuntimeError("The input stream does not start with the streaming serialization marker.");
+
+        auto formatVersion = ReadPod<uint32_t>(stream);
+        if (formatVersion > c_streamingFormatVersion)
+            RuntimeError("Unsupported streaming serialization format version (%u).", (unsigned int)formatVersion);
+
+        ReadPod<uint32_t>(stream); // flags; compression is detected per payload chunk
+        Serializer::ReadStreaming(stream, dictionary);
+    }
+
     static void SetUTF8Locale()
     {   
 #ifndef _MSC_VER
@@ -443,9 +1021,17 @@ namespace CNTK
     std::istream& operator>>(std::istream& stream, Dictionary& dictionary)
     {
         UsingUTF8 locale;
+        // A leading 'C' can only be the streaming serialization marker: a protobuf-serialized
+        // Dictionary always starts with the tag of its version field (0x08).
+        if (stream.peek() == c_streamingMagic[0])
+        {
+            DeserializeStreaming(stream, dictionary);
+            return stream;
+        }
         proto::Dictionary proto;
         stream >> proto;
         dictionary.m_dictionaryData->reserve(proto.data_size());
+        Serializer::ParallelArrayViewCopyScope parallelCopyScope;
         for (const auto& kv : proto.data())
         {
             Serializer::Copy(kv.second, dictionary[ToWString(kv.first)]);
@@ -494,6 +1080,7 @@ namespace CNTK
 
         Dictionary dictionary;
         dictionary.m_dictionaryData->reserve(proto->data_size());
+        Serializer::ParallelArrayViewCopyScope parallelCopyScope;
         for (const auto& kv : proto->data())
         {
             Serializer::Copy(kv.second, dictionary[ToWString(kv.first)]);
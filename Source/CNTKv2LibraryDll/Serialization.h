@@ -11,6 +11,14 @@
 
 namespace CNTK
 {
+    // Streaming (chunked) dictionary serialization. Unlike operator<<, which builds the complete
+    // protobuf image in memory before writing, this walks the dictionary and writes NDArrayView
+    // payloads directly from their buffers in fixed-size chunks, optionally compressing each
+    // payload chunk with an LZ4-style byte codec. Streams written this way start with a magic
+    // marker and are recognized transparently by operator>>.
+    void SerializeStreaming(const Dictionary& dictionary, std::ostream& stream, bool compressPayloads = false);
+    void DeserializeStreaming(std::istream& stream, Dictionary& dictionary);
+
     const std::wstring versionKey = L"version";
     const std::wstring typeKey = L"type";
     const std::wstring uidKey = L"uid";
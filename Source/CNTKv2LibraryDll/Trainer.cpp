@@ -101,6 +101,22 @@ namespace CNTK
             combinedFunctionArgs.insert(combinedFunctionArgs.end(), evalArgs.begin(), evalArgs.end());
 
             m_aggregatedTrainingEvalCriterionValue = std::make_shared<Accumulator>();
+
+            // When both aggregated criteria reduce to scalars of the same type, splice them into a
+            // single on-device output so that the loss and the metric can be fetched with one
+            // device-to-host transfer instead of two separate syncs.
+            if (m_aggregatedLossFunction->Output().DynamicAxes().empty() &&
+                m_aggregatedEvaluationFunction->Output().DynamicAxes().empty() &&
+                (m_aggregatedLossFunction->Output().Shape().TotalSize() == 1) &&
+                (m_aggregatedEvaluationFunction->Output().Shape().TotalSize() == 1) &&
+                (m_aggregatedLossFunction->Output().GetDataType() == m_aggregatedEvaluationFunction->Output().GetDataType()))
+            {
+                m_fusedCriterionFunction = Splice({ m_aggregatedLossFunction, m_aggregatedEvaluationFunction }, Axis(0), L"fusedCriterion");
+                if (m_fusedCriterionFunction->Output().Shape().TotalSize() == 2)
+                    combinedFunctionArgs.push_back(m_fusedCriterionFunction);
+                else
+                    m_fusedCriterionFunction = nullptr;
+            }
         }
 
         // create a default eval value in case there's no criterion
@@ -194,6 +210,19 @@ namespace CNTK
         if (emptyMinibatch) // Nothing to train with.
         {
             m_prevMinibatchNumSamples = 0;
+
+            // flush a partial accumulation cycle, so that the tail of the data still updates the model
+            if (m_numAccumulatedMicrobatches > 0)
+            {
+                std::unordered_map<Parameter, NDArrayViewPtr> gradients;
+                for (const auto& parameter : m_learnerParameters)
+                    gradients[parameter] = m_accumulatedGradients.at(parameter);
+                auto numSamples = m_accumulatedNumSamples;
+                auto accumulatedSweepEnd = m_accumulatedSweepEnd;
+                ResetGradientAccumulationCycle();
+                m_lastUpdateResult = m_parameterLearners->Update(gradients, numSamples, accumulatedSweepEnd || sweepEnd);
+                return m_lastUpdateResult;
+            }
             return false;
         }
 
@@ -205,7 +234,13 @@ namespace CNTK
         std::unordered_map<Parameter, NDArrayViewPtr> gradients;
         for (const auto& parameter : m_learnerParameters)
             gradients[parameter] = parameterGradients[parameter]->Data();
-        return m_parameterLearners->Update(gradients, m_prevMinibatchNumSamples, sweepEnd);
+
+        auto numSamples = m_prevMinibatchNumSamples;
+        if (m_gradientAccumulationSteps > 1 && !AccumulateGradients(gradients, numSamples, sweepEnd))
+            return m_lastUpdateResult; // mid-cycle micro-batch: gradients parked, no learner update yet
+
+        m_lastUpdateResult = m_parameterLearners->Update(gradients, numSamples, sweepEnd);
+        return m_lastUpdateResult;
     }
 
     bool Trainer::TrainDistributedMinibatch(const std::unordered_map<Variable, ValuePtr>& arguments, std::unordered_map<Variable, ValuePtr>& outputsToFetch, bool sweepEnd, const DeviceDescriptor& computeDevice /*= DeviceDescriptor::UseDefaultDevice()*/)
@@ -219,9 +254,24 @@ namespace CNTK
         if (emptyMinibatch)
         {
             m_prevMinibatchNumSamples = 0;
-            // Gradients are not existing.
-            for (const auto& parameter : m_learnerParameters)
-                gradients[parameter] = nullptr;
+            if (m_numAccumulatedMicrobatches > 0)
+            {
+                // flush the partial accumulation cycle; its summed gradients stand in for this
+                // worker's contribution to the final exchange
+                for (const auto& parameter : m_learnerParameters)
+                    gradients[parameter] = m_accumulatedGradients.at(parameter);
+                trainingLoss = m_accumulatedTrainingLoss;
+                evalCriterion = m_accumulatedEvalCriterion;
+                m_prevMinibatchNumSamples = m_accumulatedNumSamples;
+                sweepEnd = sweepEnd || m_accumulatedSweepEnd;
+                ResetGradientAccumulationCycle();
+            }
+            else
+            {
+                // Gradients are not existing.
+                for (const auto& parameter : m_learnerParameters)
+                    gradients[parameter] = nullptr;
+            }
         }
         else
         {
@@ -232,6 +282,22 @@ namespace CNTK
                 gradients[parameter] = parameterGradients[parameter]->Data();
             trainingLoss = m_prevMinibatchAggregateTrainingLossValue->Data();
             evalCriterion = m_prevMinibatchAggregateEvalCriterionValue->Data();
+
+            if (m_gradientAccumulationSteps > 1)
+            {
+                // the criterion values handed to the learners must cover the whole cycle, just
+                // like the gradients, so sum them alongside
+                bool firstMicrobatch = (m_numAccumulatedMicrobatches == 0);
+                AccumulateInto(m_accumulatedTrainingLoss, trainingLoss, firstMicrobatch);
+                AccumulateInto(m_accumulatedEvalCriterion, evalCriterion, firstMicrobatch);
+
+                auto numSamples = m_prevMinibatchNumSamples;
+                if (!AccumulateGradients(gradients, numSamples, sweepEnd))
+                    return m_lastUpdateResult; // mid-cycle micro-batch: no gradient exchange or learner update yet
+                trainingLoss = m_accumulatedTrainingLoss;
+                evalCriterion = m_accumulatedEvalCriterion;
+                m_prevMinibatchNumSamples = numSamples;
+            }
         }
 
         auto currentWorkerNumSamples = m_prevMinibatchNumSamples;
@@ -239,8 +305,14 @@ namespace CNTK
 
         MinibatchInfo info{ arguments.empty(), sweepEnd, m_prevMinibatchNumSamples, trainingLoss, evalCriterion };
         bool updated = m_parameterLearners->Update(gradients, info);
+        m_lastUpdateResult = updated;
         m_prevMinibatchNumSamples = info.numberOfSamples;
 
+        // The loss and criterion were aggregated across workers in place; the fused value only
+        // holds this worker's share, so fall back to fetching the aggregated values separately.
+        m_prevMinibatchFusedCriterionValue = nullptr;
+        m_prevMinibatchScalarsValid = false;
+
         // Update internal state.
         if (emptyMinibatch)
         {
@@ -263,6 +335,71 @@ namespace CNTK
         return updated;
     }
 
+    void Trainer::SetGradientAccumulationSteps(size_t numSteps)
+    {
+        if (numSteps == 0)
+            InvalidArgument("Trainer::SetGradientAccumulationSteps: the number of accumulation steps must be at least 1.");
+
+        m_gradientAccumulationSteps = numSteps;
+        ResetGradientAccumulationCycle();
+    }
+
+    // Add this micro-batch's gradients into the trainer-owned accumulation buffers. Returns false
+    // while the accumulation cycle is still open; once the cycle is complete, 'gradients',
+    // 'numSamples' and 'sweepEnd' have been replaced by the summed gradients, the cycle's combined
+    // sample count and whether any micro-batch of the cycle ended a sweep, and true is returned.
+    bool Trainer::AccumulateGradients(std::unordered_map<Parameter, NDArrayViewPtr>& gradients, size_t& numSamples, bool& sweepEnd)
+    {
+        bool firstMicrobatch = (m_numAccumulatedMicrobatches == 0);
+        for (auto& parameterGradient : gradients)
+        {
+            auto& accumulated = m_accumulatedGradients[parameterGradient.first];
+            AccumulateInto(accumulated, parameterGradient.second, firstMicrobatch);
+            parameterGradient.second = accumulated;
+        }
+
+        m_accumulatedNumSamples += numSamples;
+        m_accumulatedSweepEnd = m_accumulatedSweepEnd || sweepEnd;
+        m_numAccumulatedMicrobatches++;
+        if (m_numAccumulatedMicrobatches < m_gradientAccumulationSteps)
+            return false;
+
+        numSamples = m_accumulatedNumSamples;
+        sweepEnd = m_accumulatedSweepEnd;
+        ResetGradientAccumulationCycle();
+        return true;
+    }
+
+    // Add 'value' into 'accumulated'; the first micro-batch of a cycle copies instead, reusing
+    // the buffer from the previous cycle when its geometry still matches.
+    void Trainer::AccumulateInto(NDArrayViewPtr& accumulated, const NDArrayViewPtr& value, bool firstMicrobatch)
+    {
+        if (value == nullptr)
+            return;
+
+        if (firstMicrobatch)
+        {
+            if (accumulated == nullptr || accumulated->GetDataType() != value->GetDataType() ||
+                accumulated->Shape() != value->Shape() || accumulated->Device() != value->Device())
+                accumulated = value->DeepClone();
+            else
+                accumulated->CopyFrom(*value);
+        }
+        else if (value->GetDataType() == DataType::Float)
+            *accumulated->GetWritableMatrix<float>() += *value->GetMatrix<float>();
+        else if (value->GetDataType() == DataType::Double)
+            *accumulated->GetWritableMatrix<double>() += *value->GetMatrix<double>();
+        else
+            LogicError("Trainer::AccumulateInto: Unsupported DataType %s.", DataTypeName(value->GetDataType()));
+    }
+
+    void Trainer::ResetGradientAccumulationCycle()
+    {
+        m_numAccumulatedMicrobatches = 0;
+        m_accumulatedNumSamples = 0;
+        m_accumulatedSweepEnd = false;
+    }
+
     void Trainer::UpdateTrainingProgress(size_t numSamples, const ValuePtr& loss, const ValuePtr& evalCriterion,
                                          const DeviceDescriptor& computeDevice)
     {
@@ -314,6 +451,8 @@ namespace CNTK
         std::unordered_map<Variable, ValuePtr> outputs = { { m_aggregatedLossFunction, nullptr }, { m_trainingSampleCountVar, nullptr } };
         if (m_aggregatedEvaluationFunction)
             outputs.insert({ m_aggregatedEvaluationFunction, nullptr });
+        if (m_fusedCriterionFunction)
+            outputs.insert({ m_fusedCriterionFunction, nullptr });
 
         outputs.insert(outputsToFetch.begin(), outputsToFetch.end());
 
@@ -322,6 +461,9 @@ namespace CNTK
         if (m_aggregatedEvaluationFunction)
             m_prevMinibatchAggregateEvalCriterionValue = outputs[m_aggregatedEvaluationFunction];
 
+        m_prevMinibatchFusedCriterionValue = m_fusedCriterionFunction ? outputs[m_fusedCriterionFunction] : nullptr;
+        m_prevMinibatchScalarsValid = false;
+
         for (auto outputToFetch : outputsToFetch)
         {
             if (outputToFetch.second == nullptr)
@@ -473,13 +615,48 @@ namespace CNTK
         return localState[externalWorkerStateKey].Value<Dictionary>();
     }
 
+    void Trainer::FetchFusedCriterionScalars() const
+    {
+        if (m_prevMinibatchScalarsValid)
+            return;
+
+        if (m_prevMinibatchFusedCriterionValue)
+        {
+            // A single device-to-host copy covering both scalars.
+            auto fusedData = m_prevMinibatchFusedCriterionValue->Data();
+            auto cpuView = MakeSharedObject<NDArrayView>(fusedData->GetDataType(), fusedData->Shape(), DeviceDescriptor::CPUDevice());
+            cpuView->CopyFrom(*fusedData);
+            if (cpuView->GetDataType() == DataType::Float)
+            {
+                auto buffer = cpuView->DataBuffer<float>();
+                m_prevMinibatchLossScalar = buffer[0];
+                m_prevMinibatchEvalCriterionScalar = buffer[1];
+            }
+            else
+            {
+                auto buffer = cpuView->DataBuffer<double>();
+                m_prevMinibatchLossScalar = buffer[0];
+                m_prevMinibatchEvalCriterionScalar = buffer[1];
+            }
+        }
+        else
+        {
+            m_prevMinibatchLossScalar = m_prevMinibatchAggregateTrainingLossValue->AsScalar<double>();
+            m_prevMinibatchEvalCriterionScalar = (m_evaluationFunction && m_prevMinibatchAggregateEvalCriterionValue) ?
+                m_prevMinibatchAggregateEvalCriterionValue->AsScalar<double>() : 0;
+        }
+
+        m_prevMinibatchScalarsValid = true;
+    }
+
     double Trainer::PreviousMinibatchLossAverage() const
     {
         // TODO: better return 0; it is then still valid to compute lossAverage * numSamples
         if (m_prevMinibatchNumSamples == 0)
             RuntimeError("There was no preceeding call to TrainMinibatch or the minibatch was empty.");
 
-        return m_prevMinibatchAggregateTrainingLossValue->AsScalar<double>() / m_prevMinibatchNumSamples;
+        FetchFusedCriterionScalars();
+        return m_prevMinibatchLossScalar / m_prevMinibatchNumSamples;
     }
 
     double Trainer::PreviousMinibatchEvaluationAverage() const
@@ -490,7 +667,8 @@ namespace CNTK
         if (m_prevMinibatchNumSamples == 0)
             RuntimeError("There was no preceeding call to TrainMinibatch or the minibatch was empty.");
 
-        return m_prevMinibatchAggregateEvalCriterionValue->AsScalar<double>() / m_prevMinibatchNumSamples;
+        FetchFusedCriterionScalars();
+        return m_prevMinibatchEvalCriterionScalar / m_prevMinibatchNumSamples;
     }
 
     const std::vector<LearnerPtr>& Trainer::ParameterLearners() const
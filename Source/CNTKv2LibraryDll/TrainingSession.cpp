@@ -47,10 +47,14 @@ namespace CNTK
     CrossValidationConfig::CrossValidationConfig(
         const MinibatchSourcePtr& crossValidationSource,
         const MinibatchSizeSchedule& crossValidationSchedule,
-        size_t crossValidationFrequencyInSamples):
+        size_t crossValidationFrequencyInSamples,
+        bool runOverlapped,
+        const DeviceDescriptor& overlappedDevice):
         m_source(crossValidationSource),
         m_mbSize(crossValidationSchedule),
-        m_frequency(crossValidationFrequencyInSamples)
+        m_frequency(crossValidationFrequencyInSamples),
+        m_overlapped(runOverlapped),
+        m_device(overlappedDevice)
     {
     }
 
@@ -103,7 +107,8 @@ namespace CNTK
         m_parallelAfterSamples(0),
         m_workerRank(0),
         m_numberOfWorkers(1),
-        m_test(test)
+        m_test(test),
+        m_cvInFlight(false)
     {
         if (!m_trainer)
             InvalidArgument("Trainer must not be null.");
@@ -203,6 +208,11 @@ namespace CNTK
                     action.sampleCountWhenLastCalled = totalNumberOfSamples;
                 }
             }
+
+            // Hand results of completed overlapped cross validation runs to the callback
+            // on this (the training) thread.
+            if (m_cv.m_overlapped)
+                earlyExit |= !DeliverOverlappedCrossValidationResults();
         }
 
         if (restoredNumberOfSamples != Trainer()->TotalNumberOfSamplesSeen())
@@ -216,6 +226,9 @@ namespace CNTK
             }
         }
 
+        // Wait for any in-flight overlapped cross validation run and deliver its results.
+        FinishOverlappedCrossValidation();
+
         // In case of incremental - save final checkpoint.
         // This is required only when we keep all existing checkpoints, otherwise 
         // The checkpoint was already saved with the proper name.
@@ -231,6 +244,13 @@ namespace CNTK
     // TODO: Possibly expose a limiting counter on the number of samples for validation.
     bool TrainingSession::CrossValidate(size_t currentIndex, const DeviceDescriptor& computeDevice)
     {
+        // Overlapped mode runs cross validation on a background thread against a snapshot of the
+        // parameters, so training does not pause for the validation pass. Distributed training
+        // keeps the inline path - the cross-worker error aggregation must run in lockstep on all
+        // workers and cannot be moved off the training thread.
+        if (m_cv.m_source && m_cv.m_overlapped && m_numberOfWorkers == 1)
+            return ScheduleOverlappedCrossValidation(currentIndex);
+
         if (m_cv.m_source) // Running cross validation
         {
             std::unordered_map<Variable, ValuePtr> minibatch;
@@ -266,6 +286,101 @@ namespace CNTK
         }
     }
 
+    bool TrainingSession::ScheduleOverlappedCrossValidation(size_t currentIndex)
+    {
+        // If the previous run has not finished yet, skip this boundary rather than queueing up
+        // validation passes behind one another.
+        if (!m_cvInFlight)
+        {
+            if (m_cvThread.joinable())
+                m_cvThread.join();
+
+            auto device = m_cv.m_device;
+            m_cvInFlight = true;
+            m_cvThread = std::thread([this, currentIndex, device]() { RunOverlappedCrossValidation(currentIndex, device); });
+        }
+
+        return true;
+    }
+
+    void TrainingSession::RunOverlappedCrossValidation(size_t currentIndex, const DeviceDescriptor& computeDevice)
+    {
+        try
+        {
+            std::unordered_map<Variable, ValuePtr> minibatch;
+            double accumulatedError = 0;
+            size_t totalNumberOfSamples = 0;
+            size_t numberOfMinibatches = 0;
+
+            // TestMinibatchThreadSafe evaluates on a pooled clone of the graph whose parameter
+            // values are copied from the live model on acquisition, so the training thread can
+            // keep updating the parameters while this pass runs.
+            std::pair<double, size_t> errorAndCount;
+            auto checkpoint = m_cv.m_source->GetCheckpointState();
+            bool shouldCV = true;
+            while (shouldCV)
+            {
+                GetCrossValidationMinibatch(minibatch, m_cv.m_mbSize[totalNumberOfSamples], computeDevice);
+                shouldCV = m_trainer->TestMinibatchThreadSafe(minibatch, errorAndCount, computeDevice);
+                if (shouldCV)
+                {
+                    accumulatedError += errorAndCount.first;
+                    totalNumberOfSamples += errorAndCount.second;
+                    numberOfMinibatches++;
+                }
+            }
+
+            m_cv.m_source->RestoreFromCheckpoint(checkpoint);
+
+            std::lock_guard<std::mutex> guard(m_cvResultMutex);
+            m_pendingCVResults.push_back({ currentIndex,
+                totalNumberOfSamples != 0 ? accumulatedError / totalNumberOfSamples : 0,
+                totalNumberOfSamples, numberOfMinibatches });
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> guard(m_cvResultMutex);
+            m_cvError = std::current_exception();
+        }
+
+        m_cvInFlight = false;
+    }
+
+    bool TrainingSession::DeliverOverlappedCrossValidationResults()
+    {
+        std::vector<CrossValidationResult> results;
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> guard(m_cvResultMutex);
+            results.swap(m_pendingCVResults);
+            std::swap(error, m_cvError);
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+
+        bool shouldContinue = true;
+        for (const auto& result : results)
+        {
+            {
+                // The next overlapped run may already be updating the test progress accumulators.
+                std::lock_guard<std::mutex> guard(m_trainer->m_testProgressMutex);
+                Trainer()->SummarizeTestProgress();
+            }
+            shouldContinue &= OnCrossValidationEnd(result.index, result.averageError, result.numberOfSamples, result.numberOfMinibatches);
+        }
+
+        return shouldContinue;
+    }
+
+    void TrainingSession::FinishOverlappedCrossValidation()
+    {
+        if (m_cvThread.joinable())
+            m_cvThread.join();
+
+        DeliverOverlappedCrossValidationResults();
+    }
+
     void TrainingSession::Test(const DeviceDescriptor& computeDevice)
     {
         if (!m_test.m_source)
@@ -24,6 +24,78 @@ using namespace Microsoft::MSR::CNTK;
 
 namespace CNTK
 {
+    namespace
+    {
+        // Blocks above this size are served by the regular heap; views and their helper
+        // objects are all well below it.
+        const size_t c_maxPooledBlockSize = 1024;
+
+        // Pooled block sizes are rounded up to a multiple of this, which also defines the
+        // granularity of the size classes.
+        const size_t c_blockSizeGranularity = 16;
+
+        // Bound on the number of retained free blocks per size class and thread; overflow
+        // is returned to the heap.
+        const size_t c_maxFreeBlocksPerSizeClass = 4096;
+
+        // Per-thread free lists, one per size class. Blocks freed on a thread other than the
+        // allocating one simply migrate to the freeing thread's lists.
+        struct PooledViewFreeLists
+        {
+            std::vector<std::vector<void*>> lists;
+
+            PooledViewFreeLists() : lists(c_maxPooledBlockSize / c_blockSizeGranularity) {}
+
+            ~PooledViewFreeLists()
+            {
+                for (auto& freeList : lists)
+                    for (auto block : freeList)
+                        ::operator delete(block);
+            }
+        };
+
+        std::vector<void*>& PooledViewFreeList(size_t sizeClass)
+        {
+            thread_local PooledViewFreeLists s_freeLists;
+            return s_freeLists.lists[sizeClass];
+        }
+    }
+
+    /*static*/ void* ViewObjectPool::Allocate(size_t size)
+    {
+        if ((size == 0) || (size > c_maxPooledBlockSize))
+            return ::operator new(size);
+
+        auto sizeClass = (size - 1) / c_blockSizeGranularity;
+        auto& freeList = PooledViewFreeList(sizeClass);
+        if (!freeList.empty())
+        {
+            auto block = freeList.back();
+            freeList.pop_back();
+            return block;
+        }
+
+        return ::operator new((sizeClass + 1) * c_blockSizeGranularity);
+    }
+
+    /*static*/ void ViewObjectPool::Free(void* block, size_t size)
+    {
+        if (block == nullptr)
+            return;
+
+        if ((size == 0) || (size > c_maxPooledBlockSize))
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        auto& freeList = PooledViewFreeList((size - 1) / c_blockSizeGranularity);
+        if (freeList.size() < c_maxFreeBlocksPerSizeClass)
+            freeList.push_back(block);
+        else
+            ::operator delete(block);
+    }
+
     template<typename T>
     T* CreateDataPtr(const T& value)
     {
@@ -846,7 +918,7 @@ namespace CNTK
         // Reshuffle to data to unpack and uninterleave the CNTK form packed data
         auto unpackedTensorView = ComputationNode<ElementType>::Unpack(AsTensorShape(sampleShape), matrix, layout, /*batchMajor=*/ false, /*gapPadValue=*/ nullptr);
         auto dataShape = PackedValue::GetUnpackedShape(sampleShape, sampleDynamicAxes, layout);
-        auto data = MakeSharedObject<NDArrayView>(AsDataType<ElementType>(), AsDeviceDescriptor(matrix.GetDeviceId()), AsStorageFormat(matrix.GetFormat()), dataShape, readOnly, new TensorView<ElementType>(unpackedTensorView, AsTensorViewShape(dataShape)));
+        auto data = MakeSharedObject<NDArrayView>(AsDataType<ElementType>(), AsDeviceDescriptor(matrix.GetDeviceId()), AsStorageFormat(matrix.GetFormat()), dataShape, readOnly, ViewObjectPool::NewTensorView<ElementType>(unpackedTensorView, AsTensorViewShape(dataShape)));
         return MakeSharedObject<Value>(data, mask);
     }
 
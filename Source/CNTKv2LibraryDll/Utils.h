@@ -681,6 +681,69 @@ namespace CNTK
         bool m_isDistributed;
     };
 
+    // Recycles the small fixed-size blocks churned by NDArrayView aliasing, slicing and value
+    // unpacking: the TensorView copies, the sliced Matrix wrappers, the NDArrayView objects
+    // themselves and their shared_ptr control blocks. Freed blocks are kept in thread-local
+    // free lists keyed by size class, so once the lists reach their high-water mark,
+    // steady-state view creation performs no heap allocations and avoids allocator contention.
+    // Blocks larger than the pooling threshold fall through to the regular heap.
+    class ViewObjectPool
+    {
+    public:
+        CNTK_API static void* Allocate(size_t size);
+        CNTK_API static void Free(void* block, size_t size);
+
+        // Allocates a TensorView from the pool. All TensorViews handed to the NDArrayView
+        // tensorView constructor must be created through this method, since NDArrayView
+        // returns them to the pool on destruction.
+        template <typename ElementType, typename ...CtorArgTypes>
+        static Microsoft::MSR::CNTK::TensorView<ElementType>* NewTensorView(CtorArgTypes&& ...ctorArgs)
+        {
+            void* block = Allocate(sizeof(Microsoft::MSR::CNTK::TensorView<ElementType>));
+            try
+            {
+                return new (block) Microsoft::MSR::CNTK::TensorView<ElementType>(std::forward<CtorArgTypes>(ctorArgs)...);
+            }
+            catch (...)
+            {
+                Free(block, sizeof(Microsoft::MSR::CNTK::TensorView<ElementType>));
+                throw;
+            }
+        }
+
+        template <typename ElementType>
+        static void DeleteTensorView(const Microsoft::MSR::CNTK::TensorView<ElementType>* tensorView)
+        {
+            if (tensorView == nullptr)
+                return;
+
+            auto writableTensorView = const_cast<Microsoft::MSR::CNTK::TensorView<ElementType>*>(tensorView);
+            writableTensorView->~TensorView();
+            Free(writableTensorView, sizeof(Microsoft::MSR::CNTK::TensorView<ElementType>));
+        }
+    };
+
+    // Minimal STL-style allocator over ViewObjectPool, for use with std::allocate_shared and
+    // as the control block allocator of shared_ptr, so the reference counting blocks of views
+    // are recycled along with the views themselves.
+    template <typename T>
+    struct PooledViewAllocator
+    {
+        typedef T value_type;
+
+        PooledViewAllocator() = default;
+        template <typename U>
+        PooledViewAllocator(const PooledViewAllocator<U>&) {}
+
+        T* allocate(size_t n) { return (T*)ViewObjectPool::Allocate(n * sizeof(T)); }
+        void deallocate(T* p, size_t n) { ViewObjectPool::Free(p, n * sizeof(T)); }
+
+        template <typename U>
+        bool operator==(const PooledViewAllocator<U>&) const { return true; }
+        template <typename U>
+        bool operator!=(const PooledViewAllocator<U>&) const { return false; }
+    };
+
     class Utils
     {
     public:
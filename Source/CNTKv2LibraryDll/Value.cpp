@@ -135,6 +135,46 @@ namespace CNTK
         std::copy(currentSequencePaddedColStarts.begin(), currentSequencePaddedColStarts.end(), std::back_inserter(colStarts));
     }
 
+    // Packs dense CPU sequences into a single batch buffer. The destination is allocated once
+    // up front, the per-sequence copies into their precomputed offsets run in parallel, and a
+    // batch whose sequences already lie contiguously in memory at full length (e.g. views over
+    // one flat buffer) is aliased without any copy when the caller allows sharing the storage.
+    template <typename ElementType>
+    static NDArrayViewPtr PackDenseSequences(const std::vector<NDArrayViewPtr>& sequences,
+                                             const NDShape& valueDataShape,
+                                             size_t maxSequenceSizeInElements,
+                                             bool allowAliasing,
+                                             bool readOnly)
+    {
+        auto numSequences = sequences.size();
+
+        // Pre-scan: resolve the source buffers and sizes once on the calling thread
+        std::vector<const ElementType*> sourceBuffers(numSequences);
+        std::vector<size_t> sourceSizes(numSequences);
+        bool isContiguousFullLength = true;
+        for (size_t i = 0; i < numSequences; ++i)
+        {
+            sourceBuffers[i] = sequences[i]->DataBuffer<ElementType>();
+            sourceSizes[i] = sequences[i]->Shape().TotalSize();
+            isContiguousFullLength = isContiguousFullLength && (sourceSizes[i] == maxSequenceSizeInElements) &&
+                                     (sourceBuffers[i] == (sourceBuffers[0] + (i * maxSequenceSizeInElements)));
+        }
+
+        // Already-contiguous equal-length batch: wrap the existing storage instead of copying.
+        // As with the non-copying single-sequence path, the input storage must outlive the
+        // created Value object.
+        if (isContiguousFullLength && allowAliasing)
+            return MakeSharedObject<NDArrayView>(valueDataShape, const_cast<ElementType*>(sourceBuffers[0]), numSequences * maxSequenceSizeInElements, DeviceDescriptor::CPUDevice(), readOnly);
+
+        auto valueData = MakeSharedObject<NDArrayView>(AsDataType<ElementType>(), valueDataShape, DeviceDescriptor::CPUDevice());
+        ElementType* dataBuffer = valueData->template WritableDataBuffer<ElementType>();
+#pragma omp parallel for
+        for (int i = 0; i < (int)numSequences; ++i)
+            std::copy(sourceBuffers[i], sourceBuffers[i] + sourceSizes[i], dataBuffer + (maxSequenceSizeInElements * i));
+
+        return valueData;
+    }
+
     /*static*/ ValuePtr Value::Create(const NDShape& sampleShape, const std::vector<NDArrayViewPtr>& sequences, const std::vector<bool>& sequenceStartFlags, const DeviceDescriptor& device, bool readOnly, bool createNewCopy)
     {
         auto numSequences = sequences.size();
@@ -243,32 +283,15 @@ namespace CNTK
             }
             else
             {
-                valueData = MakeSharedObject<NDArrayView>(dataType, valueDataShape, DeviceDescriptor::CPUDevice());
                 auto maxSequenceSizeInElements = fullyDefinedSampleShape.TotalSize() * maxSequenceLength;
                 switch (dataType)
                 {
                 case DataType::Float:
-                {
-                    float* dataBuffer = valueData->WritableDataBuffer<float>();
-                    for (size_t i = 0; i < numSequences; ++i)
-                    {
-                        const float* currentSequenceBuffer = sequences[i]->DataBuffer<float>();
-                        auto currentSequenceSizeInElements = sequences[i]->Shape().TotalSize();
-                        std::copy(currentSequenceBuffer, currentSequenceBuffer + currentSequenceSizeInElements, dataBuffer + (maxSequenceSizeInElements * i));
-                    }
+                    valueData = PackDenseSequences<float>(sequences, valueDataShape, maxSequenceSizeInElements, /*allowAliasing =*/ !createNewCopy, readOnly);
                     break;
-                }
                 case DataType::Double:
-                {
-                    double* dataBuffer = valueData->WritableDataBuffer<double>();
-                    for (size_t i = 0; i < numSequences; ++i)
-                    {
-                        const double* currentSequenceBuffer = sequences[i]->DataBuffer<double>();
-                        auto currentSequenceSizeInElements = sequences[i]->Shape().TotalSize();
-                        std::copy(currentSequenceBuffer, currentSequenceBuffer + currentSequenceSizeInElements, dataBuffer + (maxSequenceSizeInElements * i));
-                    }
+                    valueData = PackDenseSequences<double>(sequences, valueDataShape, maxSequenceSizeInElements, /*allowAliasing =*/ !createNewCopy, readOnly);
                     break;
-                }
                 default:
                     NOT_IMPLEMENTED;
                 }
@@ -375,6 +398,67 @@ namespace CNTK
         return Create(sampleShape, {sequenceData}, {sequenceStartFlag}, device, readOnly, false);
     }
 
+    template <typename ElementType>
+    /*static*/ ValuePtr Value::CreateBatchOfSequences(const NDShape& sampleShape, const std::vector<size_t>& sequenceLengths, const std::vector<const SparseIndexType*>& colStarts, const std::vector<const SparseIndexType*>& rowIndices, const std::vector<const ElementType*>& nonZeroValues, const std::vector<size_t>& numNonZeroValues, const std::vector<bool>& sequenceStartFlags, const DeviceDescriptor& device, bool readOnly/* = false*/)
+    {
+        auto numSequences = sequenceLengths.size();
+        if (numSequences == 0)
+            InvalidArgument("Value::CreateBatchOfSequences: The number of sequences must be > 0");
+
+        if ((colStarts.size() != numSequences) || (rowIndices.size() != numSequences) || (nonZeroValues.size() != numSequences) || (numNonZeroValues.size() != numSequences))
+            InvalidArgument("Value::CreateBatchOfSequences: The number of per-sequence CSC buffers must match the number (%zu) of sequences.", numSequences);
+
+        if ((sampleShape.Rank() < 1) || (sampleShape[0] != sampleShape.TotalSize()))
+            InvalidArgument("Value::CreateBatchOfSequences: The sample shape's leading axis dimensionality must equal the total size of the sample shape '%S'.", sampleShape.AsString().c_str());
+
+        // Scan once to compute per-sequence destinations inside the packed batch
+        size_t maxSequenceLength = 0;
+        size_t totalNumNonZeroValues = 0;
+        std::vector<size_t> nonZeroValueOffsets(numSequences);
+        for (size_t i = 0; i < numSequences; ++i)
+        {
+            if (sequenceLengths[i] == 0)
+                InvalidArgument("Value::CreateBatchOfSequences: The length of sequence #%zu must be > 0.", i);
+
+            auto sequenceNumNonZeroValues = (size_t)(colStarts[i][sequenceLengths[i]] - colStarts[i][0]);
+            if (sequenceNumNonZeroValues != numNonZeroValues[i])
+                InvalidArgument("Value::CreateBatchOfSequences: The specified number (%zu) of non-zero values of sequence #%zu does not match its colStarts buffer (%zu).",
+                                numNonZeroValues[i], i, sequenceNumNonZeroValues);
+
+            nonZeroValueOffsets[i] = totalNumNonZeroValues;
+            totalNumNonZeroValues += sequenceNumNonZeroValues;
+            maxSequenceLength = std::max(maxSequenceLength, sequenceLengths[i]);
+        }
+
+        // Assemble the packed CSC batch directly from the user buffers. The sequences' destination
+        // regions are disjoint, so the column concatenation runs one sequence per thread.
+        std::vector<SparseIndexType> batchColStarts((maxSequenceLength * numSequences) + 1);
+        std::vector<SparseIndexType> batchRowIndices(totalNumNonZeroValues);
+        std::vector<ElementType> batchNonZeroValues(totalNumNonZeroValues);
+#pragma omp parallel for
+        for (int i = 0; i < (int)numSequences; ++i)
+        {
+            auto offset = nonZeroValueOffsets[i];
+            std::copy(rowIndices[i], rowIndices[i] + numNonZeroValues[i], batchRowIndices.begin() + offset);
+            std::copy(nonZeroValues[i], nonZeroValues[i] + numNonZeroValues[i], batchNonZeroValues.begin() + offset);
+
+            auto currentSequencePaddedColStarts = batchColStarts.data() + (i * maxSequenceLength);
+            for (size_t j = 0; j < sequenceLengths[i]; ++j)
+                currentSequencePaddedColStarts[j] = (SparseIndexType)(offset + (colStarts[i][j] - colStarts[i][0]));
+
+            // The padded trailing columns of shorter sequences are empty
+            for (size_t j = sequenceLengths[i]; j < maxSequenceLength; ++j)
+                currentSequencePaddedColStarts[j] = (SparseIndexType)(offset + numNonZeroValues[i]);
+        }
+        batchColStarts.back() = (SparseIndexType)totalNumNonZeroValues;
+
+        NDMaskPtr deviceValueMask = CreateMask(sequenceLengths, sequenceStartFlags, DeviceDescriptor::CPUDevice());
+        NDShape valueDataShape = sampleShape.AppendShape({ maxSequenceLength, numSequences });
+        // TODO: In case of sparse we can directly create on target device
+        auto deviceValueData = MakeSharedObject<NDArrayView>(valueDataShape, batchColStarts.data(), batchRowIndices.data(), batchNonZeroValues.data(), totalNumNonZeroValues, device, readOnly);
+        return MakeSharedObject<Value>(deviceValueData, deviceValueMask);
+    }
+
     /*virtual*/ Value::~Value()
     {
     }
@@ -706,6 +790,8 @@ namespace CNTK
     template /*static*/ CNTK_API ValuePtr Value::CreateSequence<double>(size_t dimension, const std::vector<size_t>& sequenceData, bool sequenceStartFlag, const DeviceDescriptor& device, bool readOnly/* = false*/);
     template /*static*/ CNTK_API ValuePtr Value::CreateSequence<float>(const NDShape& sampleShape, size_t sequenceLength, const SparseIndexType* colStarts, const SparseIndexType* rowIndices, const float* nonZeroValues, size_t numNonZeroValues, bool sequenceStartFlag, const DeviceDescriptor& device, bool readOnly/* = false*/);
     template /*static*/ CNTK_API ValuePtr Value::CreateSequence<double>(const NDShape& sampleShape, size_t sequenceLength, const SparseIndexType* colStarts, const SparseIndexType* rowIndices, const double* nonZeroValues, size_t numNonZeroValues, bool sequenceStartFlag, const DeviceDescriptor& device, bool readOnly/* = false*/);
+    template /*static*/ CNTK_API ValuePtr Value::CreateBatchOfSequences<float>(const NDShape& sampleShape, const std::vector<size_t>& sequenceLengths, const std::vector<const SparseIndexType*>& colStarts, const std::vector<const SparseIndexType*>& rowIndices, const std::vector<const float*>& nonZeroValues, const std::vector<size_t>& numNonZeroValues, const std::vector<bool>& sequenceStartFlags, const DeviceDescriptor& device, bool readOnly/* = false*/);
+    template /*static*/ CNTK_API ValuePtr Value::CreateBatchOfSequences<double>(const NDShape& sampleShape, const std::vector<size_t>& sequenceLengths, const std::vector<const SparseIndexType*>& colStarts, const std::vector<const SparseIndexType*>& rowIndices, const std::vector<const double*>& nonZeroValues, const std::vector<size_t>& numNonZeroValues, const std::vector<bool>& sequenceStartFlags, const DeviceDescriptor& device, bool readOnly/* = false*/);
     template CNTK_API void Value::CopyVariableValueToVector<float>(const Variable& outputVariable, std::vector<std::vector<float>>& sequences);
     template CNTK_API void Value::CopyVariableValueToVector<double>(const Variable& outputVariable, std::vector<std::vector<double>>& sequences);
     template CNTK_API void Value::CopyVariableValueToVector<float>(const Variable& outputVariable, std::vector<std::vector<size_t>>& sequences);
@@ -44,7 +44,7 @@ namespace CNTK
 
     const std::wstring& Variable::Uid() const
     {
-        return m_dataFields->m_uid; 
+        return m_dataFields->Uid();
     }
     
     DataType Variable::GetDataType() const
@@ -194,6 +194,25 @@ namespace CNTK
     static const std::wstring KernelWidthAttributeName = L"kernelWidth";
     static const std::wstring KernelHeightAttributeName = L"kernelHeight";
 
+    // Serializes materialization of deferred uids; uniqueness comes from the reserved number, the
+    // lock only prevents concurrent first reads from racing on the string assignment.
+    static std::mutex s_uidMaterializationMutex;
+
+    const std::wstring& VariableFields::Uid() const
+    {
+        if (m_hasDeferredUid)
+        {
+            std::lock_guard<std::mutex> guard(s_uidMaterializationMutex);
+            if (m_hasDeferredUid)
+            {
+                m_uid = VariableKindName(m_varKind) + std::to_wstring(m_uidNumber);
+                m_hasDeferredUid = false;
+            }
+        }
+
+        return m_uid;
+    }
+
     std::wstring VariableFields::AsString() const
     {
         std::wstringstream wss;
@@ -201,7 +220,7 @@ namespace CNTK
         if (m_name != L"")
             wss << m_name;
         else
-            wss << m_uid;
+            wss << Uid();
         bool reverse = Internal::IsReversingTensorShapesInErrorMessagesEnabled();
         if (reverse)
             wss << "', " << DynamicAxesAsString(m_dynamicAxes, reverse) << ", " << m_shape.AsString() << ")";
@@ -237,7 +256,7 @@ namespace CNTK
             m_dynamicAxes,
             m_isSparse,
             m_name,
-            Internal::GenerateUid(m_varKind));
+            /*uid =*/ std::wstring());
 
         if (m_valueInitializer)
             clone->SetValueInitialization(*m_valueInitializer, *m_valueInitializationDevice);
@@ -510,7 +529,7 @@ namespace CNTK
     }
 
     Parameter::Parameter(const NDShape& shape, DataType dataType, const ParameterInitializer& initializer, const DeviceDescriptor& device, const std::wstring& name)
-        : Variable(shape, VariableKind::Parameter, dataType, nullptr, true, {}, name, Internal::GenerateUid(VariableKind::Parameter))
+        : Variable(shape, VariableKind::Parameter, dataType, nullptr, true, {}, name, /*uid =*/ std::wstring())
     {
 
         m_dataFields->SetValueInitialization(initializer, device);
@@ -527,7 +546,7 @@ namespace CNTK
     }
 
     Constant::Constant(const NDShape& shape, DataType dataType, const ParameterInitializer& initializer, const DeviceDescriptor& device, const std::wstring& name)
-        : Variable(shape, VariableKind::Constant, dataType, nullptr, false, {}, name, Internal::GenerateUid(VariableKind::Constant))
+        : Variable(shape, VariableKind::Constant, dataType, nullptr, false, {}, name, /*uid =*/ std::wstring())
     {
         m_dataFields->SetValueInitialization(initializer, device);
     }
@@ -27,12 +27,17 @@ namespace CNTK
         std::wstring m_name;
         std::vector<Axis> m_dynamicAxes;
         bool m_isSparse;
-        std::wstring m_uid;
+        // The uid string is materialized lazily: constructing the Variable with an empty uid only
+        // reserves m_uidNumber from the process-wide counter and the string is built from it on
+        // the first Uid() access. m_hasDeferredUid must be cleared when assigning m_uid directly.
+        mutable std::wstring m_uid;
+        mutable std::atomic<bool> m_hasDeferredUid;
+        size_t m_uidNumber;
         std::atomic<size_t> m_valueTimeStamp;
         Variable m_blockFunctionVariableMapping;
 
         VariableFields(const NDShape& shape, VariableKind varType, ::CNTK::DataType type, const std::weak_ptr<Function>& ownerFunction, const NDArrayViewPtr& value, bool needsGradient, const std::vector<Axis>& dynamicAxes, bool isSparse, const std::wstring& name, const std::wstring& uid)
-            : m_shape(shape), m_varKind(varType), m_dataType(type), m_ownerFunction(ownerFunction), m_value(value), m_needsGradient(needsGradient), m_dynamicAxes(dynamicAxes), m_isSparse(isSparse), m_name(name), m_uid(uid), m_valueTimeStamp(0)
+            : m_shape(shape), m_varKind(varType), m_dataType(type), m_ownerFunction(ownerFunction), m_value(value), m_needsGradient(needsGradient), m_dynamicAxes(dynamicAxes), m_isSparse(isSparse), m_name(name), m_uid(uid), m_hasDeferredUid(uid.empty()), m_uidNumber(uid.empty() ? Internal::NewUniqueId() : 0), m_valueTimeStamp(0)
         {
             if (value && (type != value->GetDataType()))
                 InvalidArgument("The DataType of the Parameter/Constant Variable '%S' does not match the DataType of the associated Value", AsString().c_str());
@@ -66,6 +71,9 @@ namespace CNTK
         std::shared_ptr<VariableFields> Clone() const;
         FunctionPtr Owner() const;
 
+        // Returns the uid, building the string from the reserved number on first access
+        const std::wstring& Uid() const;
+
         CNTK_API void SetValueInitialization(const ParameterInitializer& initializationConfig, const DeviceDescriptor& device);
 
     private:
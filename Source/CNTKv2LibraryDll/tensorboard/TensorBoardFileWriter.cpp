@@ -7,6 +7,7 @@
 #include "CNTKLibraryInternals.h"
 
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <ctime>
@@ -112,16 +113,104 @@ namespace CNTK
 
         void TensorBoardFileWriter::WriteValue(const std::wstring& name, float value, uint64_t step)
         {
-            tensorflow::Event event;
-            event.set_step(step);
-            event.set_wall_time(static_cast<double>(std::time(0)));
+            // Only enqueue the record here; the background writer thread does the
+            // serialization and file I/O, so the training thread never blocks on disk.
+            std::lock_guard<std::mutex> guard(m_queueMutex);
+            EnsureWriterThread();
+            m_pendingEvents.push_back({ name, value, step, std::time(0) });
+            m_queueCV.notify_one();
+        }
 
-            tensorflow::Summary* summary = event.mutable_summary();
-            tensorflow::Summary::Value* summaryValue = summary->add_value();
-            summaryValue->set_tag(ToString(name));
-            summaryValue->set_simple_value(value);
+        void TensorBoardFileWriter::EnsureWriterThread()
+        {
+            // Called with m_queueMutex held.
+            if (!m_writerThread.joinable())
+                m_writerThread = std::thread(&TensorBoardFileWriter::WriterThreadProc, this);
+        }
 
-            WriteRecord(Serialize(event));
+        void TensorBoardFileWriter::StopWriterThread()
+        {
+            {
+                std::lock_guard<std::mutex> guard(m_queueMutex);
+                if (!m_writerThread.joinable())
+                    return;
+
+                m_shutdownWriter = true;
+                m_queueCV.notify_all();
+            }
+
+            // The writer drains any still queued records before exiting.
+            m_writerThread.join();
+            m_shutdownWriter = false;
+        }
+
+        void TensorBoardFileWriter::WriterThreadProc()
+        {
+            // Batch the physical flushes: sync the file once enough bytes have accumulated or
+            // enough time has passed, rather than after every record.
+            const size_t flushThresholdBytes = 64 * 1024;
+            const std::chrono::seconds flushInterval(5);
+
+            size_t bytesSinceFlush = 0;
+            auto lastFlushTime = std::chrono::steady_clock::now();
+
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            while (true)
+            {
+                m_queueCV.wait_for(lock, flushInterval,
+                                   [this]() { return m_shutdownWriter || m_flushRequested || !m_pendingEvents.empty(); });
+
+                std::vector<PendingEvent> batch;
+                batch.swap(m_pendingEvents);
+                bool shutdown = m_shutdownWriter;
+                bool flushRequested = m_flushRequested;
+                lock.unlock();
+
+                for (const auto& pending : batch)
+                {
+                    tensorflow::Event event;
+                    event.set_step(pending.step);
+                    event.set_wall_time(static_cast<double>(pending.wallTime));
+
+                    tensorflow::Summary* summary = event.mutable_summary();
+                    tensorflow::Summary::Value* summaryValue = summary->add_value();
+                    summaryValue->set_tag(ToString(pending.name));
+                    summaryValue->set_simple_value(pending.value);
+
+                    try
+                    {
+                        std::string record = Serialize(event);
+                        WriteRecord(record);
+                        bytesSinceFlush += record.size();
+                    }
+                    catch (const std::exception&)
+                    {
+                        // WriteRecord has already logged the failure and closed the file;
+                        // subsequent records will attempt to re-open a new one.
+                    }
+                }
+
+                bool flushSucceeded = true;
+                auto now = std::chrono::steady_clock::now();
+                if (flushRequested || (bytesSinceFlush >= flushThresholdBytes) ||
+                    ((bytesSinceFlush > 0) && ((now - lastFlushTime) >= flushInterval)))
+                {
+                    flushSucceeded = FlushFile();
+                    bytesSinceFlush = 0;
+                    lastFlushTime = now;
+                }
+
+                lock.lock();
+                if (flushRequested)
+                {
+                    m_flushSucceeded = flushSucceeded;
+                    m_flushRequested = false;
+                    m_queueCV.notify_all();
+                }
+
+                if (shutdown && m_pendingEvents.empty())
+                    break;
+            }
         }
 
         void TensorBoardFileWriter::WriteModel()
@@ -189,6 +278,20 @@ namespace CNTK
         }
 
         bool TensorBoardFileWriter::Flush()
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            if (!m_writerThread.joinable())
+                return FlushFile();
+
+            // Hand the flush over to the writer thread, so that it happens after all
+            // currently queued records, and wait for its outcome.
+            m_flushRequested = true;
+            m_queueCV.notify_all();
+            m_queueCV.wait(lock, [this]() { return !m_flushRequested && m_pendingEvents.empty(); });
+            return m_flushSucceeded;
+        }
+
+        bool TensorBoardFileWriter::FlushFile()
         {
             if (m_file == NULL)
             {
@@ -206,12 +309,15 @@ namespace CNTK
 
         bool TensorBoardFileWriter::Close()
         {
+            // Drain and stop the background writer before touching the file from this thread.
+            StopWriterThread();
+
             if (m_file == NULL)
             {
                 return false;
             }
 
-            bool success = Flush();
+            bool success = FlushFile();
             if (fclose(m_file))
             {
                 fprintf(stderr,
@@ -41,6 +41,7 @@ int bestGPUDummy = 42; // put something into this CPP, as to avoid a linker warn
 #define PATH_DELIMITER '\\'
 #elif defined(__UNIX__)
 #define PATH_DELIMITER '/'
+#include <unistd.h> // for getpid()
 #endif // __WINDOWS__
 #include <stdio.h>
 #include <string.h>
@@ -92,6 +93,8 @@ private:
     int m_allowedDevices; // bitfield of allowed devices
     bool m_disallowCPUDevice;
     void GetCudaProperties();
+    bool TryLoadCachedCudaProperties();
+    void SaveCudaPropertiesToCache();
     void GetNvmlData();
     void QueryNvmlData();
 
@@ -327,11 +330,110 @@ inline int _ConvertSMVer2Cores(int major, int minor)
     return nGpuArchCoresPerSM[7].Cores;
 }
 
+// ---------------------------------------------------------------------------
+// cached device enumeration
+// The static device properties (name, compute capability, core counts) cannot
+// change while the machine is up, so gang-scheduled multi-process launches
+// only pay the per-device CUDA property probes once; every other process just
+// reads the cache back. Dynamic data (utilization, free memory) still always
+// comes fresh from NVML. The cache is keyed on driver/runtime version and
+// device count, and written atomically via a temp file + rename.
+// ---------------------------------------------------------------------------
+
+struct DeviceEnumerationCacheHeader
+{
+    int driverVersion;
+    int runtimeVersion;
+    int deviceCount;
+    int propSize; // sizeof(cudaDeviceProp) of the writer, guards against toolkit mismatches
+};
+
+static std::string GetDeviceEnumerationCachePath()
+{
+#ifdef __WINDOWS__
+    char tempPath[MAX_PATH];
+    DWORD len = GetTempPathA(MAX_PATH, tempPath);
+    if (len == 0 || len >= MAX_PATH)
+        return "";
+    return std::string(tempPath) + "cntk_gpu_enumeration_cache";
+#else
+    return "/tmp/cntk_gpu_enumeration_cache";
+#endif
+}
+
+bool BestGpu::TryLoadCachedCudaProperties()
+{
+    const std::string path = GetDeviceEnumerationCachePath();
+    if (path.empty())
+        return false;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f == NULL)
+        return false;
+    int driverVersion = 0, runtimeVersion = 0;
+    DeviceEnumerationCacheHeader header = {0};
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              cudaDriverGetVersion(&driverVersion) == cudaSuccess &&
+              cudaRuntimeGetVersion(&runtimeVersion) == cudaSuccess &&
+              header.driverVersion == driverVersion &&
+              header.runtimeVersion == runtimeVersion &&
+              header.deviceCount == m_deviceCount &&
+              header.propSize == (int) sizeof(cudaDeviceProp);
+    int dev = 0;
+    for (ProcessorData* pd : m_procData)
+    {
+        ok = ok && fread(&pd->deviceProp, sizeof(pd->deviceProp), 1, f) == 1 &&
+             fread(&pd->cores, sizeof(pd->cores), 1, f) == 1;
+        pd->deviceId = dev;
+        dev++;
+    }
+    fclose(f);
+    return ok;
+}
+
+void BestGpu::SaveCudaPropertiesToCache()
+{
+    const std::string path = GetDeviceEnumerationCachePath();
+    if (path.empty())
+        return;
+    int driverVersion = 0, runtimeVersion = 0;
+    if (cudaDriverGetVersion(&driverVersion) != cudaSuccess || cudaRuntimeGetVersion(&runtimeVersion) != cudaSuccess)
+        return;
+    // write to a process-unique temp file first, then rename into place atomically
+    const std::string tempPath = path + "." + std::to_string(
+#ifdef __WINDOWS__
+        (unsigned long) GetCurrentProcessId()
+#else
+        (unsigned long) getpid()
+#endif
+        );
+    FILE* f = fopen(tempPath.c_str(), "wb");
+    if (f == NULL) // not being able to cache is never an error
+        return;
+    DeviceEnumerationCacheHeader header = {driverVersion, runtimeVersion, m_deviceCount, (int) sizeof(cudaDeviceProp)};
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    for (ProcessorData* pd : m_procData)
+        ok = ok && fwrite(&pd->deviceProp, sizeof(pd->deviceProp), 1, f) == 1 &&
+             fwrite(&pd->cores, sizeof(pd->cores), 1, f) == 1;
+    ok = (fclose(f) == 0) && ok;
+#ifdef __WINDOWS__
+    if (!ok || !MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+#else
+    if (!ok || rename(tempPath.c_str(), path.c_str()) != 0)
+#endif
+        remove(tempPath.c_str());
+}
+
 void BestGpu::GetCudaProperties()
 {
     if (m_cudaData)
         return;
 
+    if (TryLoadCachedCudaProperties()) // another process already enumerated this machine
+    {
+        m_cudaData = m_procData.size() > 0;
+        return;
+    }
+
     int dev = 0;
 
     for (ProcessorData* pd : m_procData)
@@ -342,6 +444,8 @@ void BestGpu::GetCudaProperties()
         dev++;
     }
     m_cudaData = m_procData.size() > 0;
+    if (m_cudaData)
+        SaveCudaPropertiesToCache();
 }
 
 void BestGpu::Init()
@@ -572,9 +676,11 @@ std::vector<int> BestGpu::GetDevices(int number, BestGpuFlags p_bestFlags)
     }
 
     // global lock for this process
+    // Always wait for this lock: gang-scheduled multi-process launches select their
+    // devices one after another, so two workers can never claim the same "free" GPU.
     CrossProcessMutex deviceAllocationLock("CNTK_device_allocation_lock");
 
-    if (!deviceAllocationLock.Acquire((bestFlags & bestGpuExclusiveLock) != 0)) // failure  --this should not really happen
+    if (!deviceAllocationLock.Acquire(/*wait=*/true)) // failure  --this should not really happen
         RuntimeError("DeviceFromConfig: Unexpected failure acquiring device allocation lock.");
 
     {
@@ -13,6 +13,9 @@
 #include "Config.h"
 #include "ScriptableObjects.h"
 
+#include <map>
+#include <mutex>
+
 namespace Microsoft { namespace MSR { namespace CNTK {
 
 // ParseCommandLine - parse the command line parameters
@@ -195,13 +198,41 @@ std::string ConfigParser::ReadConfigFile(const std::string& filePath)
     return ReadConfigFile(msra::strfun::utf16(filePath));
 }
 
+// include cache: the same config files (esp. large shared macro libraries) get read and
+// comment-stripped over and over--once per include site, per command, and per NDL/MEL/BrainScript
+// pass. Cache the stripped text per file path, validated by file size and modification time,
+// so each file is only read and stripped once per process.
+struct CachedConfigFile
+{
+    int64_t size;                 // file size at read time
+    time_t time;                  // modification time at read time
+    std::string strippedContents; // comment-stripped file contents
+};
+static std::mutex s_cachedConfigFilesMutex; // guards s_cachedConfigFiles
+static std::map<std::wstring, CachedConfigFile> s_cachedConfigFiles;
+
+// get the (size, modification time) stamp used to validate cache entries; false if the file cannot be stat'ed
+static bool GetConfigFileStamp(const std::wstring& filePath, int64_t& size, time_t& time)
+{
+#ifdef _WIN32
+    struct _stat64 buf;
+    if (_wstat64(filePath.c_str(), &buf) != 0)
+        return false;
+#else
+    struct stat buf;
+    if (stat(msra::strfun::utf8(filePath).c_str(), &buf) != 0)
+        return false;
+#endif
+    size = buf.st_size;
+    time = buf.st_mtime;
+    return true;
+}
+
 // ReadConfigFile - read a configuration file, and return all lines, stripped of comments, concatenated by newlines, as one long string (no other processing, expansion etc.)
 // filePath - the path to the config file to read
 // returns: a string with the concatentated file contents
 std::string ConfigParser::ReadConfigFile(const std::wstring& filePath)
 {
-    File file(filePath, fileOptionsRead);
-
     // initialize configName with file name
     std::string configName = msra::strfun::utf8(filePath);
     auto location = configName.find_last_of("/\\");
@@ -209,6 +240,20 @@ std::string ConfigParser::ReadConfigFile(const std::wstring& filePath)
         configName = configName.substr(location + 1);
     m_configName = move(configName);
 
+    // serve from the cache if the file is unchanged since we last read it
+    int64_t size = 0;
+    time_t time = 0;
+    const bool haveStamp = GetConfigFileStamp(filePath, size, time);
+    if (haveStamp)
+    {
+        std::lock_guard<std::mutex> lock(s_cachedConfigFilesMutex);
+        const auto cached = s_cachedConfigFiles.find(filePath);
+        if (cached != s_cachedConfigFiles.end() && cached->second.size == size && cached->second.time == time)
+            return cached->second.strippedContents;
+    }
+
+    File file(filePath, fileOptionsRead);
+
     // read the entire file into a string
     // CONSIDER: should the File API support this, instead of us having to call it line by line?
     size_t fileLength = file.CanSeek() ? file.Size() : 0;
@@ -225,6 +270,12 @@ std::string ConfigParser::ReadConfigFile(const std::wstring& filePath)
             configFile.append("\n");
         }
     }
+
+    if (haveStamp) // (files we cannot stat are not cached)
+    {
+        std::lock_guard<std::mutex> lock(s_cachedConfigFilesMutex);
+        s_cachedConfigFiles[filePath] = CachedConfigFile{size, time, configFile};
+    }
     return configFile;
 }
 
@@ -15,6 +15,7 @@
 #include "DataReader.h"
 #include "Config.h"
 #include "ScriptableObjects.h"
+#include <future>
 #include <string>
 
 using namespace std;
@@ -73,7 +74,9 @@ void DataReader::Destroy()
     // newer code that explicitly place multiple streams for inputs
     foreach_index (i, m_ioNames) // inputNames should map to node names
     {
-        m_dataReaders[m_ioNames[i]]->Destroy();
+        auto reader = m_dataReaders.find(m_ioNames[i]);
+        if (reader != m_dataReaders.end()) // readers that were never used were never created (lazy creation)
+            reader->second->Destroy();
     }
 }
 
@@ -83,11 +86,12 @@ void DataReader::Destroy()
 template <class ConfigRecordType>
 DataReader::DataReader(const ConfigRecordType& config)
 {
-    typedef void (*GetReaderProc)(IDataReader** preader);
-
     assert(m_dataReaders.empty());
 
     string precision = config(L"precision", "float");
+    m_precision = precision;
+    size_t nbrUttPerMinibatch = config(L"nbruttsineachrecurrentiter", (size_t) 1);
+    m_nbrUttPerMinibatch = nbrUttPerMinibatch;
 
     bool hasMultipleReaders = config.Exists(L"readers");
     // In case when deserializers are specified, use the new logic to compose them.
@@ -99,63 +103,118 @@ DataReader::DataReader(const ConfigRecordType& config)
         for (const auto& ioName : ioNames) // inputNames should map to node names
         {
             const ConfigRecordType& thisIO = config(ioName);
-            wstring readerType = thisIO(L"readerType", L"Cntk.Deserializers.TextFormat");
-
             // get the name for the reader we want to use, default to CNTKTextFormatReader
-            GetReaderProc getReaderProc = (GetReaderProc) Plugin::Load(readerType, GetReaderName(precision));
+            wstring readerType = thisIO(L"readerType", L"Cntk.Deserializers.TextFormat");
+            m_readerTypes[ioName] = readerType;
             m_ioNames.push_back(ioName);
-            assert(getReaderProc != nullptr);
-            getReaderProc(&m_dataReaders[ioName]); // instantiates the reader with the default constructor (no config processed at this point)
         }
     }
     else if (hasDeserializers)
     {
-        wstring readerType = config(L"readerType", L"Cntk.Composite");
-
         // Creating Composite Data Reader that allow to combine deserializers.
         // This should be changed to link statically when SGD uses the new interfaces.
+        wstring readerType = config(L"readerType", L"Cntk.Composite");
         wstring ioName = L"ioName";
-        GetReaderProc getReaderProc = (GetReaderProc)Plugin::Load(readerType, GetReaderName(precision));
+        m_readerTypes[ioName] = readerType;
         m_ioNames.push_back(ioName);
-        assert(getReaderProc != nullptr);
-        getReaderProc(&m_dataReaders[ioName]);
     }
     else
     {
+        // backward support to use only one type of data reader
         wstring readerType = config(L"readerType", L"Cntk.Deserializers.TextFormat");
         wstring ioName = L"ioName";
-        // backward support to use only one type of data reader
-        // get the name for the reader we want to use, default to CNTKTextFormatReader
-        GetReaderProc getReaderProc = (GetReaderProc)Plugin::Load(readerType, GetReaderName(precision));
+        m_readerTypes[ioName] = readerType;
         m_ioNames.push_back(ioName);
-        assert(getReaderProc != nullptr);
-        getReaderProc(&m_dataReaders[ioName]);
     }
 
-    // now pass that to concurrent reader so we can read ahead
-    // m_DataReader = new ConcurrentReader<ElemType>(m_DataReader);
-    // NOW we can init
-    // TODO: merge with the code above, but we first need to get the nbrUttPerMinibatch initialized inside each reader
+    // either hold the per-reader configurations for deferred creation, or create right away
+    DeferOrCreateReaders(config, hasMultipleReaders);
+}
+
+template DataReader::DataReader(const ConfigParameters&);
+template DataReader::DataReader(const ScriptableObjects::IConfigRecord&);
+
+// ConfigParameters can be copied, so reader creation (and with it the loading of the reader
+// DLLs) is deferred until first use; see EnsureReadersCreated().
+void DataReader::DeferOrCreateReaders(const ConfigParameters& config, bool hasMultipleReaders)
+{
+    for (const auto& ioName : m_ioNames)
+    {
+        if (hasMultipleReaders)
+            m_deferredConfigs.insert(make_pair(ioName, ConfigParameters(config(ioName))));
+        else
+            m_deferredConfigs.insert(make_pair(ioName, config)); // legacy: the reader section is the whole config
+    }
+}
+
+// BrainScript config records cannot be copied out of the constructor, so these readers are
+// created and initialized eagerly, as before.
+void DataReader::DeferOrCreateReaders(const ScriptableObjects::IConfigRecord& config, bool hasMultipleReaders)
+{
+    typedef void (*GetReaderProc)(IDataReader** preader);
     for (const auto& ioName : m_ioNames)
     {
-        const ConfigRecordType& thisIO = hasMultipleReaders ? config(ioName) : config /*legacy*/;
+        GetReaderProc getReaderProc = (GetReaderProc) Plugin::Load(m_readerTypes[ioName], GetReaderName(m_precision));
+        assert(getReaderProc != nullptr);
+        getReaderProc(&m_dataReaders[ioName]); // instantiates the reader with the default constructor (no config processed at this point)
+
+        const ScriptableObjects::IConfigRecord& thisIO = hasMultipleReaders ? config(ioName) : config /*legacy*/;
         m_dataReaders[ioName]->Init(thisIO);
 
         // pass on some global option    --TODO: Why is this not done inside each reader??
-        size_t nbrUttPerMinibatch = config(L"nbruttsineachrecurrentiter", (size_t) 1);
-        m_dataReaders[ioName]->SetNumParallelSequences(nbrUttPerMinibatch);
+        m_dataReaders[ioName]->SetNumParallelSequences(m_nbrUttPerMinibatch);
     }
 }
 
-template DataReader::DataReader(const ConfigParameters&);
-template DataReader::DataReader(const ScriptableObjects::IConfigRecord&);
+// Creates and initializes the readers whose creation was deferred by the constructor. This is
+// where the reader DLLs actually get loaded (resolved entry points are cached process-wide in
+// Plugin). When several readers are configured, their initialization runs in parallel, since
+// each reader only touches its own descriptor files.
+void DataReader::EnsureReadersCreated() const
+{
+    if (m_deferredConfigs.empty())
+        return;
+
+    typedef void (*GetReaderProc)(IDataReader** preader);
+    std::vector<std::pair<IDataReader*, const ConfigParameters*>> toInit;
+    for (const auto& ioName : m_ioNames)
+    {
+        GetReaderProc getReaderProc = (GetReaderProc) Plugin::Load(m_readerTypes[ioName], GetReaderName(m_precision));
+        assert(getReaderProc != nullptr);
+        getReaderProc(&m_dataReaders[ioName]); // instantiates the reader with the default constructor (no config processed at this point)
+        toInit.push_back(make_pair(m_dataReaders[ioName], &m_deferredConfigs.find(ioName)->second));
+    }
+
+    auto initReader = [this](IDataReader* reader, const ConfigParameters* config)
+    {
+        reader->Init(*config);
+        // pass on some global option    --TODO: Why is this not done inside each reader??
+        reader->SetNumParallelSequences(m_nbrUttPerMinibatch);
+    };
+    if (toInit.size() > 1)
+    {
+        std::vector<std::future<void>> inits;
+        for (const auto& entry : toInit)
+            inits.push_back(std::async(std::launch::async, initReader, entry.first, entry.second));
+        for (auto& init : inits)
+            init.get(); // rethrows any initialization failure
+    }
+    else
+        initReader(toInit.front().first, toInit.front().second);
+
+    m_deferredConfigs.clear();
+}
 
 // destructor - cleanup temp files, etc.
 DataReader::~DataReader()
 {
-    // free up resources
+    // free up resources; readers that were never used were never created (lazy creation)
     for (size_t i = 0; i < m_ioNames.size(); i++)
-        m_dataReaders[m_ioNames[i]]->Destroy();
+    {
+        auto reader = m_dataReaders.find(m_ioNames[i]);
+        if (reader != m_dataReaders.end())
+            reader->second->Destroy();
+    }
 }
 
 // StartMinibatchLoop - Startup a minibatch loop
@@ -164,6 +223,7 @@ DataReader::~DataReader()
 //  requestedEpochSamples - [in] number of samples to randomize, defaults to requestDataSize which uses the number of samples there are in the dataset
 void DataReader::StartMinibatchLoop(size_t mbSize, size_t epoch, size_t requestedEpochSamples)
 {
+    EnsureReadersCreated();
     for (size_t i = 0; i < m_ioNames.size(); i++)
         m_dataReaders[m_ioNames[i]]->StartMinibatchLoop(mbSize, epoch, requestedEpochSamples);
 }
@@ -171,6 +231,7 @@ void DataReader::StartMinibatchLoop(size_t mbSize, size_t epoch, size_t requeste
 // Same as above but with additional information about required streams.
 void DataReader::StartMinibatchLoop(size_t mbSize, size_t epoch, const std::unordered_set<InputStreamDescription>& streamDescriptions, size_t requestedEpochSamples)
 {
+    EnsureReadersCreated();
     for (size_t i = 0; i < m_ioNames.size(); i++)
         m_dataReaders[m_ioNames[i]]->StartMinibatchLoop(mbSize, epoch, streamDescriptions, requestedEpochSamples);
 }
@@ -178,6 +239,7 @@ void DataReader::StartMinibatchLoop(size_t mbSize, size_t epoch, const std::unor
 //SupportsDistributedMBRead - Tells if the reader supports distributed minibatch reading for parallel training
 bool DataReader::SupportsDistributedMBRead() const
 {
+    EnsureReadersCreated();
     bool supportsDistributedMBRead = true;
     for (size_t i = 0; i < m_ioNames.size(); i++)
     {
@@ -193,6 +255,7 @@ bool DataReader::SupportsDistributedMBRead() const
 //IsLegacyReader - Returns true if one of the readers is a legacy reader, false otherwise.
 bool DataReader::IsLegacyReader() const
 {
+    EnsureReadersCreated();
     for (size_t i = 0; i < m_ioNames.size(); i++)
     {
         auto currReaderIter = m_dataReaders.find(m_ioNames[i]);
@@ -215,6 +278,7 @@ bool DataReader::IsLegacyReader() const
 // requestedEpochSamples - [in] number of samples to randomize, defaults to requestDataSize which uses the number of samples there are in the dataset
 void DataReader::StartDistributedMinibatchLoop(size_t mbSize, size_t epoch, size_t subsetNum, size_t numSubsets, size_t requestedEpochSamples /* = requestDataSize*/)
 {
+    EnsureReadersCreated();
     for (size_t i = 0; i < m_ioNames.size(); i++)
     {
         m_dataReaders[m_ioNames[i]]->StartDistributedMinibatchLoop(mbSize, epoch, subsetNum, numSubsets, requestedEpochSamples);
@@ -224,6 +288,7 @@ void DataReader::StartDistributedMinibatchLoop(size_t mbSize, size_t epoch, size
 // Same as above but with additional information about required streams.
 void DataReader::StartDistributedMinibatchLoop(size_t mbSize, size_t epoch, size_t subsetNum, size_t numSubsets, const std::unordered_set<InputStreamDescription>& streamDescriptions, size_t requestedEpochSamples /* = requestDataSize*/)
 {
+    EnsureReadersCreated();
     for (size_t i = 0; i < m_ioNames.size(); i++)
     {
         m_dataReaders[m_ioNames[i]]->StartDistributedMinibatchLoop(mbSize, epoch, subsetNum, numSubsets, streamDescriptions, requestedEpochSamples);
@@ -232,6 +297,7 @@ void DataReader::StartDistributedMinibatchLoop(size_t mbSize, size_t epoch, size
 
 size_t DataReader::GetCurrentSamplePosition()
 {
+    EnsureReadersCreated();
     // BUGBUG: composition of old readers is not supported.
     // Returning just for the last reader.
     return m_dataReaders[m_ioNames.back()]->GetCurrentSamplePosition();
@@ -243,6 +309,7 @@ size_t DataReader::GetCurrentSamplePosition()
 // returns - true if there are more minibatches, false if no more minibatchs remain
 bool DataReader::GetMinibatch(StreamMinibatchInputs& matrices)
 {
+    EnsureReadersCreated();
     /**
     each reader reads data with number of columns as  nbr_utterances_per_minibatch * mbSize
     notice that readers may differ in their actual mbsize, though it is supposedly to be nbr_utterances_per_minibatch * mbSize.
@@ -276,6 +343,7 @@ bool DataReader::GetMinibatch(StreamMinibatchInputs& matrices)
 // returns - true if there are more minibatches, false if no more minibatchs remain
 bool DataReader::GetMinibatch4SE(std::vector<shared_ptr<const msra::dbn::latticepair>>& latticeinput, vector<size_t>& uids, vector<size_t>& boundaries, vector<size_t>& extrauttmap)
 {
+    EnsureReadersCreated();
     bool bRet = true;
     for (size_t i = 0; i < m_ioNames.size(); i++)
         bRet &= m_dataReaders[m_ioNames[i]]->GetMinibatch4SE(latticeinput, uids, boundaries, extrauttmap);
@@ -287,6 +355,7 @@ bool DataReader::GetMinibatch4SE(std::vector<shared_ptr<const msra::dbn::lattice
 // returns - true if succeed
 bool DataReader::GetHmmData(msra::asr::simplesenonehmm* hmm)
 {
+    EnsureReadersCreated();
     bool bRet = true;
     for (size_t i = 0; i < m_ioNames.size(); i++)
         bRet &= m_dataReaders[m_ioNames[i]]->GetHmmData(hmm);
@@ -295,6 +364,7 @@ bool DataReader::GetHmmData(msra::asr::simplesenonehmm* hmm)
 
 size_t DataReader::GetNumParallelSequencesForFixingBPTTMode()
 {
+    EnsureReadersCreated();
     size_t nNbr = 0;
     for (size_t i = 0; i < m_ioNames.size(); i++)
     {
@@ -309,12 +379,14 @@ size_t DataReader::GetNumParallelSequencesForFixingBPTTMode()
 
 void DataReader::InitProposals(StreamMinibatchInputs* matrices)
 {
+    EnsureReadersCreated();
     for (size_t i = 0; i < m_ioNames.size(); i++)
         m_dataReaders[m_ioNames[i]]->InitProposals(matrices);
 }
 
 bool DataReader::GetProposalObs(StreamMinibatchInputs* matrices, const size_t tidx, vector<size_t>& history)
 {
+    EnsureReadersCreated();
     bool bRet = true;
     for (size_t i = 0; i < m_ioNames.size(); i++)
         bRet &= m_dataReaders[m_ioNames[i]]->GetProposalObs(matrices, tidx, history);
@@ -323,6 +395,7 @@ bool DataReader::GetProposalObs(StreamMinibatchInputs* matrices, const size_t ti
 
 void DataReader::CopyMBLayoutTo(MBLayoutPtr pMBLayout)
 {
+    EnsureReadersCreated();
     // BUGBUG: This copies all data reader's layout info on top of each other, keeping only the last one; likely not what was intended.
     for (size_t i = 0; i < m_ioNames.size(); i++)
         m_dataReaders[m_ioNames[i]]->CopyMBLayoutTo(pMBLayout);
@@ -330,6 +403,7 @@ void DataReader::CopyMBLayoutTo(MBLayoutPtr pMBLayout)
 
 void DataReader::SetRandomSeed(int seed)
 {
+    EnsureReadersCreated();
     for (size_t i = 0; i < m_ioNames.size(); i++)
         m_dataReaders[m_ioNames[i]]->SetRandomSeed(seed);
 }
@@ -339,6 +413,7 @@ bool DataReader::GetMinibatchCopy(
     StreamMinibatchInputs& matrices,
     MBLayoutPtr pMBLayout)
 {
+    EnsureReadersCreated();
     bool ans = false;
     for (size_t i = 0; i < m_ioNames.size(); i++)
         ans = (m_dataReaders[m_ioNames[i]]->GetMinibatchCopy(uttInfo, matrices, pMBLayout) || ans);
@@ -350,6 +425,7 @@ bool DataReader::SetNetOutput(
     const MatrixBase& outputs,
     const MBLayoutPtr pMBLayout)
 {
+    EnsureReadersCreated();
     bool ans = false;
     for (size_t i = 0; i < m_ioNames.size(); i++)
         ans = (m_dataReaders[m_ioNames[i]]->SetNetOutput(uttInfo, outputs, pMBLayout) || ans);
@@ -368,6 +444,7 @@ const std::map<typename DataReader::LabelIdType, typename DataReader::LabelType>
 // note: for tasks with labels, the mapping table must be the same between a training run and a testing run
 void DataReader::SetLabelMapping(const std::wstring& sectionName, const std::map<LabelIdType, LabelType>& labelMapping)
 {
+    EnsureReadersCreated();
     for (size_t i = 0; i < m_ioNames.size(); i++)
         m_dataReaders[m_ioNames[i]]->SetLabelMapping(sectionName, labelMapping);
 }
@@ -382,6 +459,7 @@ void DataReader::SetLabelMapping(const std::wstring& sectionName, const std::map
 // returns: true if data remains to be read, false if the end of data was reached
 bool DataReader::GetData(const std::wstring& sectionName, size_t numRecords, void* data, size_t& dataBufferSize, size_t recordStart)
 {
+    EnsureReadersCreated();
     bool bRet = true;
     for (size_t i = 0; i < m_ioNames.size(); i++)
         bRet &= m_dataReaders[m_ioNames[i]]->GetData(sectionName, numRecords, data, dataBufferSize, recordStart);
@@ -390,6 +468,7 @@ bool DataReader::GetData(const std::wstring& sectionName, size_t numRecords, voi
 
 bool DataReader::DataEnd()
 {
+    EnsureReadersCreated();
     bool bRet = true;
     for (size_t i = 0; i < m_ioNames.size(); i++)
         bRet &= m_dataReaders[m_ioNames[i]]->DataEnd();
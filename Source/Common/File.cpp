@@ -15,6 +15,8 @@
 #include <string>
 #include <stdint.h>
 #include <locale>
+#include <map>
+#include <mutex>
 #include <unordered_map>
 #ifdef _WIN32
 #define NOMINMAX
@@ -26,6 +28,7 @@
 #ifdef __unix__
 #include <unistd.h>
 #include <linux/limits.h> // for PATH_MAX
+#include <sys/mman.h>     // for TryMapCopyOnWrite()
 #endif
 
 #define PCLOSE_ERROR -1
@@ -147,6 +150,9 @@ void File::Init(const wchar_t* filename, int fileOptions)
                     m_file = fopenOrDie(filename, options.c_str());
                     m_seekable = true;
                 });
+    // route writes through a background thread; Flush() and the destructor drain the queue
+    if ((fileOptions & fileOptionsWriteBehind) && writing && m_seekable)
+        fenableWriteBehind(m_file);
 }
 
 // determine the directory for a given pathname
@@ -271,6 +277,20 @@ File::~File(void)
     }
     else if (m_file != stdin && m_file != stdout && m_file != stderr)
     {
+        if (m_options & fileOptionsWriteBehind)
+        {
+            try
+            {
+                fdisableWriteBehind(m_file); // drain queued writes; rethrows a pending write error
+            }
+            catch (const std::exception& e)
+            {
+                fclose(m_file);
+                if (!std::uncaught_exception())
+                    RuntimeError("File: %s at %S", e.what(), m_filename.c_str());
+                return;
+            }
+        }
         rc = fclose(m_file);
         if ((rc != FCLOSE_SUCCESS) && !std::uncaught_exception())
         {
@@ -845,6 +865,56 @@ void File::SetPosition(uint64_t pos)
     fsetpos(m_file, pos);
 }
 
+// Memory-map 'size' bytes at the current read position copy-on-write and advance past them.
+// Returns nullptr (leaving the position unchanged) when the stream cannot be mapped: text mode,
+// a pipe or other non-seekable input, a region extending past the end of the file, or a mapping
+// failure. On success the returned pages are backed by the file and shared read-only across
+// processes that map the same region; a write faults in a private copy of just that page, so
+// callers may treat the buffer as ordinary mutable memory. The mapping stays in place for the
+// lifetime of the process (it outlives this File object), which matches its intended use for
+// model weights that live until process exit.
+void* File::TryMapCopyOnWrite(size_t size)
+{
+    if (size == 0 || IsTextBased() || !CanSeek() || m_pcloseNeeded)
+        return nullptr;
+    uint64_t pos = GetPosition();
+    if (pos + size > Size())
+        return nullptr;
+#ifdef _WIN32
+    HANDLE hFile = (HANDLE) _get_osfhandle(_fileno(m_file));
+    if (hFile == INVALID_HANDLE_VALUE)
+        return nullptr;
+    HANDLE hMapping = CreateFileMapping(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (hMapping == NULL)
+        return nullptr;
+    // view offsets must be aligned to the allocation granularity; map from the aligned
+    // offset below 'pos' and hand out a pointer into the view
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    uint64_t mapBegin = pos - (pos % sysInfo.dwAllocationGranularity);
+    size_t mapSize = (size_t)(pos - mapBegin) + size;
+    void* view = MapViewOfFile(hMapping, FILE_MAP_COPY, (DWORD)(mapBegin >> 32), (DWORD)(mapBegin & 0xffffffff), mapSize);
+    CloseHandle(hMapping); // the view keeps the mapping alive
+    if (view == nullptr)
+        return nullptr;
+    SetPosition(pos + size);
+    return (char*) view + (pos - mapBegin);
+#elif defined(__unix__)
+    // mmap offsets must be page-aligned; map from the aligned offset below 'pos' and hand out
+    // a pointer into the mapping
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    uint64_t mapBegin = pos - (pos % pageSize);
+    size_t mapSize = (size_t)(pos - mapBegin) + size;
+    void* p = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(m_file), (off_t) mapBegin);
+    if (p == MAP_FAILED)
+        return nullptr;
+    SetPosition(pos + size);
+    return (char*) p + (pos - mapBegin);
+#else
+    return nullptr;
+#endif
+}
+
 // helper to load a matrix from a stream (file or string literal)
 // The input string is expected to contain one line per matrix row (natural printing order for humans).
 // Inputs:
@@ -975,26 +1045,46 @@ extern std::unordered_map<std::wstring, std::wstring> g_deprecatedReaderWriterNa
 
 FARPROC Plugin::LoadInternal(const std::wstring& plugin, const std::string& proc, bool isCNTKPlugin)
 {
-    m_dllName = plugin;
+    std::wstring dllName = plugin;
 
     if (isCNTKPlugin)
     {
         // map legacy names to new naming scheme
-        auto entry = g_deprecatedReaderWriterNameMap.find(m_dllName);
+        auto entry = g_deprecatedReaderWriterNameMap.find(dllName);
         if (entry != g_deprecatedReaderWriterNameMap.end())
-            m_dllName = entry->second;
+            dllName = entry->second;
 
-        m_dllName += L"-" + msra::strfun::utf16(std::string(CNTK_COMPONENT_VERSION));
+        dllName += L"-" + msra::strfun::utf16(std::string(CNTK_COMPONENT_VERSION));
     }
 
-    m_dllName += L".dll";
-    m_hModule = LoadLibrary(m_dllName.c_str());
-    if (m_hModule == NULL)
-        RuntimeError("Plugin not found: '%ls'", m_dllName.c_str());
+    dllName += L".dll";
+
+    // process-wide cache of loaded modules and resolved entry points; modules are never unloaded (cf. Basics.h)
+    static std::mutex s_pluginCacheMutex;
+    static std::map<std::wstring, HMODULE> s_loadedModules;        // [dll name] -> module handle
+    static std::map<std::wstring, FARPROC> s_resolvedEntryPoints;  // [dll name + '@' + proc] -> entry point
+
+    std::lock_guard<std::mutex> lock(s_pluginCacheMutex);
+    auto cached = s_resolvedEntryPoints.find(dllName + L"@" + msra::strfun::utf16(proc));
+    if (cached != s_resolvedEntryPoints.end())
+        return cached->second;
+
+    HMODULE hModule;
+    auto module = s_loadedModules.find(dllName);
+    if (module != s_loadedModules.end())
+        hModule = module->second;
+    else
+    {
+        hModule = LoadLibrary(dllName.c_str());
+        if (hModule == NULL)
+            RuntimeError("Plugin not found: '%ls'", dllName.c_str());
+        s_loadedModules[dllName] = hModule;
+    }
     // create a variable of each type just to call the proper templated version
-    FARPROC entryPoint = GetProcAddress(m_hModule, proc.c_str());
+    FARPROC entryPoint = GetProcAddress(hModule, proc.c_str());
     if (entryPoint == nullptr)
-        RuntimeError("Symbol '%s' not found in plugin '%ls'", proc.c_str(), m_dllName.c_str());
+        RuntimeError("Symbol '%s' not found in plugin '%ls'", proc.c_str(), dllName.c_str());
+    s_resolvedEntryPoints[dllName + L"@" + msra::strfun::utf16(proc)] = entryPoint;
     return entryPoint;
 }
 
@@ -1019,12 +1109,32 @@ void* Plugin::LoadInternal(const std::string& plugin, const std::string& proc, b
     }
 
     soName += ".so";
-    void* handle = dlopen(soName.c_str(), RTLD_LAZY);
-    if (handle == NULL)
-        RuntimeError("Plugin not found: '%s' (error: %s)", soName.c_str(), dlerror());
+
+    // process-wide cache of loaded modules and resolved entry points; modules are never unloaded (cf. Basics.h)
+    static std::mutex s_pluginCacheMutex;
+    static std::map<std::string, void*> s_loadedModules;        // [so name] -> module handle
+    static std::map<std::string, void*> s_resolvedEntryPoints;  // [so name + '@' + proc] -> entry point
+
+    std::lock_guard<std::mutex> lock(s_pluginCacheMutex);
+    auto cached = s_resolvedEntryPoints.find(soName + "@" + proc);
+    if (cached != s_resolvedEntryPoints.end())
+        return cached->second;
+
+    void* handle;
+    auto module = s_loadedModules.find(soName);
+    if (module != s_loadedModules.end())
+        handle = module->second;
+    else
+    {
+        handle = dlopen(soName.c_str(), RTLD_LAZY);
+        if (handle == NULL)
+            RuntimeError("Plugin not found: '%s' (error: %s)", soName.c_str(), dlerror());
+        s_loadedModules[soName] = handle;
+    }
     void* entryPoint = dlsym(handle, proc.c_str());
     if (entryPoint == nullptr)
         RuntimeError("Symbol '%s' not found in plugin '%s'", proc.c_str(), soName.c_str());
+    s_resolvedEntryPoints[soName + "@" + proc] = entryPoint;
     return entryPoint;
 }
 #endif
@@ -16,6 +16,17 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 
     std::atomic<bool> Globals::m_enableShareNodeValueMatrices(true);
     std::atomic<bool> Globals::m_optimizeGradientAccumulation(true);
+    std::atomic<bool> Globals::m_fastMathTensorOps(true);
+    std::atomic<bool> Globals::m_memoryMapWeights(false);
+    std::atomic<bool> Globals::m_parallelForwardEval(false);
+    std::atomic<bool> Globals::m_fuseElementwiseOps(false);
+    std::atomic<bool> Globals::m_fuseConvolutionOps(false);
+    std::atomic<bool> Globals::m_timeNodes(false);
+    std::atomic<bool> Globals::m_foldConstants(false);
+    std::atomic<bool> Globals::m_absorbTransposes(false);
+    std::atomic<bool> Globals::m_cacheCompiledNetwork(false);
+    std::atomic<bool> Globals::m_syncBatchNormalization(false);
+    std::atomic<bool> Globals::m_eagerValueRelease(false);
 
     // Note: this is a map that transfers the old reader and writer names to
     //       the new naming scheme
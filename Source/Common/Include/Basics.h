@@ -665,60 +665,36 @@ static wstring TypeId()
 // dynamic loading of modules  --TODO: not Basics, should move to its own header
 // ----------------------------------------------------------------------------
 
+// Resolved modules and entry points are cached process-wide (in LoadInternal), since the same
+// reader/writer module gets resolved anew for every DataReader/DataWriter construction, and
+// loading a DLL can be expensive on network-mounted installations. Modules are never unloaded:
+// cached entry points must stay valid, and unloading loses exception messages (exception
+// vftables are unloaded when the DLL is unloaded).
 #ifdef _WIN32
 class Plugin
 {
-    HMODULE m_hModule;      // module handle for the writer DLL
-    std::wstring m_dllName; // name of the writer DLL
 public:
-    Plugin()
-        : m_hModule(NULL)
-    {
-    }
     template <class STRING> // accepts char (UTF-8) and wide string
-    FARPROC Load(const STRING& plugin, const std::string& proc, bool isCNTKPlugin = true)
+    static FARPROC Load(const STRING& plugin, const std::string& proc, bool isCNTKPlugin = true)
     {
         return LoadInternal(msra::strfun::utf16(plugin), proc, isCNTKPlugin);
     }
-    ~Plugin()
-    {
-    }
-    // we do not unload because this causes the exception messages to be lost (exception vftables are unloaded when DLL is unloaded)
-    // ~Plugin() { if (m_hModule) FreeLibrary(m_hModule); }
 
 private:
-    FARPROC LoadInternal(const std::wstring& plugin, const std::string& proc, bool isCNTKPlugin);
+    static FARPROC LoadInternal(const std::wstring& plugin, const std::string& proc, bool isCNTKPlugin);
 };
 #else
 class Plugin
 {
-private:
-    void* handle;
-
 public:
-    Plugin()
-        : handle(NULL)
-    {
-    }
     template <class STRING> // accepts char (UTF-8) and wide string
-    void *Load(const STRING& plugin, const std::string& proc, bool isCNTKPlugin = true)
+    static void *Load(const STRING& plugin, const std::string& proc, bool isCNTKPlugin = true)
     {
         return LoadInternal(msra::strfun::utf8(plugin), proc, isCNTKPlugin);
     }
-    ~Plugin()
-    {
-        if (handle != NULL)
-        {
-            int rc = dlclose(handle);
-            if ((rc != DLCLOSE_SUCCESS) && !std::uncaught_exception())
-            {
-                RuntimeError("Plugin: Failed to decrements the reference count.");
-            }
-        }
-    }
 
 private:
-    void *LoadInternal(const std::string& plugin, const std::string& proc, bool isCNTKPlugin);
+    static void *LoadInternal(const std::string& plugin, const std::string& proc, bool isCNTKPlugin);
 };
 #endif
 
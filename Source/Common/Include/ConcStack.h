@@ -5,8 +5,10 @@
 
 #pragma once
 
-#include <stack>
+#include "Basics.h" // for RuntimeError()
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 
 namespace Microsoft { namespace MSR { namespace CNTK {
@@ -14,43 +16,60 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 // -----------------------------------------------------------------------
 // conc_stack -- very simple version of thread-safe stack. Add other functions as needed.
 // Kept in a separate header because it pulls in some large headers that are not super-commonly needed otherwise.
+//
+// This is a lock-free Treiber stack: push() and pop_or_create() only do a
+// single CAS each on the hot path, so recycling pooled objects across many
+// reader/compute threads does not serialize on a mutex. Nodes live in
+// lazily allocated fixed-size segments and are reused through an internal
+// free list; the list heads pack a 32-bit node index with a 32-bit
+// modification tag into one 64-bit word, which makes the CAS immune to the
+// ABA problem of reused nodes. The only lock left guards allocating a new
+// segment, taken once per c_segmentSize nodes ever created.
 // -----------------------------------------------------------------------
 
 template <typename T>
 class conc_stack
 {
 public:
-    typedef typename std::stack<T>::value_type value_type;
+    typedef T value_type;
 
     conc_stack()
+        : m_head(c_packedEnd), m_free(c_packedEnd), m_numNodes(0)
     {
+        for (size_t i = 0; i < c_numSegments; i++)
+            m_segments[i].store(nullptr);
     }
 
-    value_type pop_or_create(std::function<value_type()> factory)
+    ~conc_stack()
     {
-        {
-            std::lock_guard<std::mutex> g(m_locker);
-            if (m_stack.size() != 0)
-            {
-                auto res = std::move(m_stack.top());
-                m_stack.pop();
-                return res;
-            }
-        }
+        for (size_t i = 0; i < c_numSegments; i++)
+            delete[] m_segments[i].load();
+    }
 
-        return factory();
+    value_type pop_or_create(std::function<value_type()> factory)
+    {
+        unsigned int index = PopNode(m_head);
+        if (index == c_end) // stack empty
+            return factory();
+        Node& node = GetNode(index);
+        value_type res = std::move(node.value);
+        PushNode(m_free, index); // retire the emptied node for reuse
+        return res;
     }
 
     void push(const value_type& item)
     {
-        std::lock_guard<std::mutex> g(m_locker);
-        m_stack.push(item);
+        value_type copy(item);
+        push(std::move(copy));
     }
 
     void push(value_type&& item)
     {
-        std::lock_guard<std::mutex> g(m_locker);
-        m_stack.push(std::forward<value_type>(item));
+        unsigned int index = PopNode(m_free); // reuse a retired node if possible
+        if (index == c_end)
+            index = AllocateNode();
+        GetNode(index).value = std::move(item);
+        PushNode(m_head, index);
     }
 
 public:
@@ -60,7 +79,79 @@ public:
     conc_stack& operator=(conc_stack&&) = delete;
 
 private:
-    std::stack<value_type> m_stack;
-    std::mutex m_locker;
+    struct Node
+    {
+        value_type value;
+        std::atomic<unsigned int> next; // index of the next node, or c_end
+        Node() : value(), next(c_end) { }
+    };
+
+    static const size_t c_segmentSize = 1024;                      // nodes per segment
+    static const size_t c_numSegments = 256;                       // up to 256k pooled objects per stack--plenty for buffer recycling
+    static const unsigned int c_end = 0xffffffff;                  // end-of-list marker (as index)
+    static const unsigned long long c_packedEnd = c_end;           // ditto, packed with tag 0
+
+    // the packed representation: (tag << 32) | index
+    // Every successful CAS bumps the tag, so a stale head value can never be
+    // confused with the current one even if the node index matches (ABA).
+    static unsigned long long Pack(unsigned int index, unsigned long long prevPacked)
+    {
+        return ((prevPacked >> 32) + 1) << 32 | index;
+    }
+
+    // nodes are addressed by index, stored in lazily created segments whose
+    // addresses never change, so lookups need no lock
+    Node& GetNode(unsigned int index)
+    {
+        return m_segments[index / c_segmentSize].load(std::memory_order_acquire)[index % c_segmentSize];
+    }
+
+    unsigned int AllocateNode()
+    {
+        std::lock_guard<std::mutex> g(m_growLocker);
+        size_t index = m_numNodes;
+        if (index / c_segmentSize >= c_numSegments)
+            RuntimeError("conc_stack: exceeded the maximum number of pooled objects");
+        if (index % c_segmentSize == 0) // first node of a new segment
+            m_segments[index / c_segmentSize].store(new Node[c_segmentSize], std::memory_order_release);
+        m_numNodes++;
+        return (unsigned int) index;
+    }
+
+    // pop the top node index off a packed list head, or c_end if the list is empty
+    unsigned int PopNode(std::atomic<unsigned long long>& head)
+    {
+        unsigned long long packed = head.load();
+        for (;;)
+        {
+            unsigned int index = (unsigned int) packed;
+            if (index == c_end)
+                return c_end;
+            // A concurrently recycled node may yield a garbage 'next' here; the
+            // CAS below then fails on the tag and we retry with a fresh head.
+            unsigned int next = GetNode(index).next.load();
+            if (head.compare_exchange_weak(packed, Pack(next, packed)))
+                return index;
+        }
+    }
+
+    // push a node index onto a packed list head
+    void PushNode(std::atomic<unsigned long long>& head, unsigned int index)
+    {
+        Node& node = GetNode(index);
+        unsigned long long packed = head.load();
+        for (;;)
+        {
+            node.next.store((unsigned int) packed);
+            if (head.compare_exchange_weak(packed, Pack(index, packed)))
+                return;
+        }
+    }
+
+    std::atomic<Node*> m_segments[c_numSegments]; // lazily created node segments; addresses are stable
+    std::atomic<unsigned long long> m_head;       // packed (tag, index) of the top of the stack
+    std::atomic<unsigned long long> m_free;       // packed (tag, index) of the retired-node list
+    size_t m_numNodes;                            // total nodes created so far (guarded by m_growLocker)
+    std::mutex m_growLocker;                      // guards segment allocation only
 };
 } } }
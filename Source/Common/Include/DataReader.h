@@ -375,7 +375,21 @@ public:
 class DataReader : public IDataReader, protected Plugin, public ScriptableObjects::Object
 {
     vector<wstring> m_ioNames;                          // TODO: why are these needed, why not loop over m_dataReaders?
-    map<wstring, IDataReader*> m_dataReaders; // readers
+    mutable map<wstring, IDataReader*> m_dataReaders; // readers (created lazily where possible, see below)
+
+    // Deferred reader creation: for ConfigParameters-based configurations, the per-reader
+    // configuration is copied at construction time and the reader DLLs are only loaded and
+    // initialized on first use, so actions that configure a reader but never read from it
+    // do not pay for loading the reader modules (slow on network-mounted installations).
+    // BrainScript config records cannot be copied, so those readers are created eagerly.
+    mutable map<wstring, wstring> m_readerTypes;            // [ioName] -> plugin module name
+    mutable map<wstring, ConfigParameters> m_deferredConfigs; // [ioName] -> config held until first use
+    string m_precision;
+    size_t m_nbrUttPerMinibatch;
+
+    void DeferOrCreateReaders(const ConfigParameters& config, bool hasMultipleReaders);                  // defers (lazy)
+    void DeferOrCreateReaders(const ScriptableObjects::IConfigRecord& config, bool hasMultipleReaders);  // creates eagerly
+    void EnsureReadersCreated() const; // creates and initializes any readers whose creation was deferred
 
     // Init - Reader Initialize for multiple data sets
     // config - [in] configuration parameters for the datareader
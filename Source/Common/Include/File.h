@@ -33,7 +33,8 @@ enum FileOptions
     fileOptionsType = fileOptionsBinary | fileOptionsText,      // file types
     fileOptionsRead = 8,                                        // open in read mode
     fileOptionsWrite = 16,                                      // open in write mode
-    fileOptionsSequential = 32,                                 // optimize for sequential reads (allocates big buffer)
+    fileOptionsSequential = 32,                                 // optimize for sequential reads (allocates big buffer, hints OS readahead)
+    fileOptionsWriteBehind = 64,                                // queue writes to a background thread; Flush() waits until they have landed
     fileOptionsReadWrite = fileOptionsRead | fileOptionsWrite,  // read/write mode
 };
 
@@ -117,6 +118,10 @@ public:
 
     bool IsTextBased();
 
+    // map 'size' bytes at the current position copy-on-write (and skip past them), or return
+    // nullptr if this stream cannot be mapped; see the definition for the lifetime contract
+    void* TryMapCopyOnWrite(size_t size);
+
     bool IsUnicodeBOM(bool skip = false);
     bool IsEOF();
     bool IsWhiteSpace(bool skip = false);
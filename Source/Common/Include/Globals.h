@@ -28,11 +28,113 @@ namespace Microsoft { namespace MSR { namespace CNTK {
         static void SetShareNodeValueMatrices(bool enable) { m_enableShareNodeValueMatrices = enable; }
         static bool ShouldEnableShareNodeValueMatrices() { return m_enableShareNodeValueMatrices; }
 
+        // Controls whether CPU elementwise ops may use vectorized polynomial approximations of
+        // transcendentals (exp/log/tanh/sigmoid) instead of exact libm calls, and whether large
+        // reductions may be summed in parallel chunks (a fixed, thread-count-independent order,
+        // but not the serial one). On by default; disable ('fastMathTensorOps=false') to
+        // reproduce bit-exact libm results and the legacy serial reduction order.
+        static void SetFastMathTensorOps(bool enable) { m_fastMathTensorOps = enable; }
+        static bool ShouldUseFastMathTensorOps() { return m_fastMathTensorOps; }
+
+        // Controls whether dense CPU matrices loaded from a binary model file point their buffer
+        // directly at a copy-on-write mapping of the file instead of copying the payload through
+        // a read buffer ('mmapWeights=true'). Loading becomes O(header) and concurrent processes
+        // share the read-only weight pages; training still works, since a write faults in a
+        // private copy of the touched page. Off by default because mapped matrices must not be
+        // resized beyond their on-disk allocation.
+        static void SetMemoryMapWeights(bool enable) { m_memoryMapWeights = enable; }
+        static bool ShouldMemoryMapWeights() { return m_memoryMapWeights; }
+
+        // Controls whether the forward pass may evaluate independent top-level nodes of the same
+        // dependency level concurrently ('parallelForwardEval=true'). Only takes effect for
+        // CPU-only networks and requires shareNodeValueMatrices=false, since value-buffer sharing
+        // assumes the strictly sequential evaluation order. Off by default.
+        static void SetParallelForwardEval(bool enable) { m_parallelForwardEval = enable; }
+        static bool ShouldParallelizeForwardEval() { return m_parallelForwardEval; }
+
+        // Controls whether CompileNetwork() may rewrite Plus -> {Sigmoid,Tanh} chains into single
+        // fused nodes backed by the fused tensor opcodes ('fuseElementwiseOps=true'). Off by
+        // default, since models saved after fusion contain the fused node types and thus cannot
+        // be read back by builds that predate them.
+        static void SetFuseElementwiseOps(bool enable) { m_fuseElementwiseOps = enable; }
+        static bool ShouldFuseElementwiseOps() { return m_fuseElementwiseOps; }
+
+        // Controls whether CompileNetwork() may rewrite Convolution -> Plus(bias) ->
+        // RectifiedLinear chains into single fused ConvolutionBiasActivation nodes
+        // ('fuseConvolutionOps=true'), which on cuDNN run the whole triple as one kernel. Off
+        // by default, since models saved after fusion contain the fused node type and thus
+        // cannot be read back by builds that predate it.
+        static void SetFuseConvolutionOps(bool enable) { m_fuseConvolutionOps = enable; }
+        static bool ShouldFuseConvolutionOps() { return m_fuseConvolutionOps; }
+
+        // Controls whether ForwardProp()/Backprop() record per-node execution times into the
+        // performance profiler's custom event stream ('profilerTimeNodes=true'). GPU nodes are
+        // timed with CUDA events on the compute stream, so the measurement injects no per-node
+        // host/device syncs; CPU nodes use the host clock. The events appear in the profiler
+        // detail log and in the chrome://tracing JSON written when the profiler shuts down.
+        // Off by default; only takes effect when the profiler itself is enabled.
+        static void SetTimeNodes(bool enable) { m_timeNodes = enable; }
+        static bool ShouldTimeNodes() { return m_timeNodes; }
+
+        // Controls whether CompileNetwork() may evaluate constant-only subgraphs (frozen-parameter
+        // branches, scalar scale chains) once and replace each with a plain constant parameter,
+        // pruning the nodes that thereby become unreachable ('foldConstants=true'). Off by
+        // default, since a model saved after folding contains the folded constants instead of
+        // the original subexpressions, so the pruned nodes can no longer be referenced by name.
+        static void SetFoldConstants(bool enable) { m_foldConstants = enable; }
+        static bool ShouldFoldConstants() { return m_foldConstants; }
+
+        // Controls whether CompileNetwork() may absorb explicit matrix-transpose copies feeding
+        // the left operand of a matrix product into the product itself ('absorbTransposes=true'),
+        // turning Times(X', B) into TransposeTimes(X, B) and vice versa; the underlying GEMM
+        // takes the transposition of its operands as a mere flag. Off by default, since a model
+        // saved after the rewrite contains the flipped node types under the old names.
+        static void SetAbsorbTransposes(bool enable) { m_absorbTransposes = enable; }
+        static bool ShouldAbsorbTransposes() { return m_absorbTransposes; }
+
+        // Controls whether Load() keeps a '<modelPath>.compiled' warm-start cache next to the
+        // model ('cacheCompiledNetwork=true'). The cache stores the traversal orders computed by
+        // CompileNetwork() together with a content hash of the model file; a subsequent load of
+        // an unchanged model restores the orders instead of re-deriving them, cutting the
+        // graph-analysis part of cold-start. A stale or unreadable cache is ignored and
+        // rewritten. Off by default, since it writes files next to the model.
+        static void SetCacheCompiledNetwork(bool enable) { m_cacheCompiledNetwork = enable; }
+        static bool ShouldCacheCompiledNetwork() { return m_cacheCompiledNetwork; }
+
+        // Controls whether BatchNormalization nodes aggregate their minibatch statistics across
+        // all data-parallel workers before normalizing ('syncBatchNormalization=true'), so that
+        // small per-worker batches still normalize with full-minibatch statistics. Only takes
+        // effect when running under MPI with more than one worker; costs one small allreduce per
+        // BatchNormalization node in forward prop and one in backprop. Off by default.
+        static void SetSyncBatchNormalization(bool enable) { m_syncBatchNormalization = enable; }
+        static bool ShouldSyncBatchNormalization() { return m_syncBatchNormalization; }
+
+        // Controls whether, while the network is inferring, each node's value matrix releases its
+        // backing memory as soon as its last consumer's ForwardProp() has completed
+        // ('eagerValueRelease=true'), instead of staying allocated until the next minibatch
+        // overwrites it. Cuts the evaluation-time memory footprint, at the cost of re-growing the
+        // released buffers every minibatch; computation shared between several evaluation roots
+        // is redone per root, since a released value cannot be reused. Has no effect on training
+        // passes, whose values are about to be read by backprop. Off by default.
+        static void SetEagerValueRelease(bool enable) { m_eagerValueRelease = enable; }
+        static bool ShouldEagerlyReleaseValues() { return m_eagerValueRelease; }
+
     private:
         static std::atomic<bool> m_forceDeterministicAlgorithms;
         // The global flag to enable matrices values in forward and backward prop
         static std::atomic<bool> m_enableShareNodeValueMatrices;
         static std::atomic<bool> m_forceConstantRandomSeed;
         static std::atomic<bool> m_optimizeGradientAccumulation;
+        static std::atomic<bool> m_fastMathTensorOps;
+        static std::atomic<bool> m_memoryMapWeights;
+        static std::atomic<bool> m_parallelForwardEval;
+        static std::atomic<bool> m_fuseElementwiseOps;
+        static std::atomic<bool> m_fuseConvolutionOps;
+        static std::atomic<bool> m_timeNodes;
+        static std::atomic<bool> m_foldConstants;
+        static std::atomic<bool> m_absorbTransposes;
+        static std::atomic<bool> m_cacheCompiledNetwork;
+        static std::atomic<bool> m_syncBatchNormalization;
+        static std::atomic<bool> m_eagerValueRelease;
     };
 }}}
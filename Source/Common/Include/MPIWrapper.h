@@ -96,9 +96,30 @@ public:
     virtual size_t MainNodeRank() const = 0;
     virtual bool IsMultiHost() const = 0;
 
+    // host topology, derived from the processor names of all ranks; enables hierarchical
+    // (intra-host/cross-host) communication schemes
+    virtual size_t NumRanksOnHost() const = 0;      // number of ranks running on our host
+    virtual size_t CurrentRankOnHost() const = 0;   // our index among the ranks on our host
+    virtual size_t CurrentHostRootRank() const = 0; // global rank of the first rank on our host
+    virtual bool HostsAreUniform() const = 0;       // do all hosts run the same number of ranks?
+
     // Use GPUDirect RDMA support
     virtual bool UseGpuGdr() = 0;
 
+    // -----------------------------------------------------------------------
+    // elastic membership
+    // Only functional when the MPI library provides the ULFM fault-tolerance
+    // extensions (MPIX_Comm_shrink); otherwise a rank failure stays fatal.
+    // -----------------------------------------------------------------------
+
+    virtual bool SupportsFaultTolerance() const { return false; }
+    // Rebuild the communicator without the failed ranks and renumber this rank.
+    // Returns true if the surviving ranks can continue training; subsequent
+    // CurrentNodeRank()/NumNodesInUse() reflect the shrunken membership, so a
+    // reader restarted via StartDistributedMinibatchLoop() re-shards the data
+    // across the survivors.
+    virtual bool TryShrinkAfterFailure() { return false; }
+
     // -----------------------------------------------------------------------
     // data-exchange functions (wrappers around MPI functions)
     // -----------------------------------------------------------------------
@@ -138,6 +159,11 @@ public:
     virtual void AllReduce(double* sendData, double* receiveData, size_t numElements, MPI_Op op = MPI_SUM) const = 0;
     virtual void AllReduce(float* sendData, float* receiveData, size_t numElements, MPI_Op op = MPI_SUM) const = 0;
 
+    // in-place allreduce restricted to the ranks that share our on-host index, i.e. one
+    // rank per host (used to exchange a reduced shard across hosts)
+    virtual void AllReduceAcrossHosts(double* sendData, size_t numElements, MPI_Op op = MPI_SUM) const = 0;
+    virtual void AllReduceAcrossHosts(float* sendData, size_t numElements, MPI_Op op = MPI_SUM) const = 0;
+
     virtual void AllReduceAsync(size_t* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const = 0;
     virtual void AllReduceAsync(int* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const = 0;
     virtual void AllReduceAsync(double* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const = 0;
@@ -175,6 +201,16 @@ public:
     virtual void Gatherv(const float *sendData, size_t numSendElements, float *receiveData, int recvCounts[], int offsets[], size_t rootRank) const = 0;
     virtual void Gatherv(const double *sendData, size_t numSendElements, double *receiveData, int recvCounts[], int offsets[], size_t rootRank) const = 0;
 
+    // Exchanges a sparse (indices, values) pair with all ranks. The per-rank nonzero counts are
+    // gathered first, then the index and value arrays of all ranks are coalesced into a single
+    // variable-length byte collective, so a sparse message pays the collective launch latency
+    // once instead of once per array. On return, receivedIndices/receivedValues hold the
+    // contributions of all ranks concatenated in rank order and recvCounts[r] is the number of
+    // (index, value) pairs contributed by rank r. The packing buffers are kept inside the
+    // wrapper and reused across calls.
+    virtual void AllGatherSparse(const size_t *indices, const float *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<float>& receivedValues) const = 0;
+    virtual void AllGatherSparse(const size_t *indices, const double *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<double>& receivedValues) const = 0;
+
     // wait for all ranks to reach here
     virtual int WaitAll() = 0;
     virtual void WaitAny(MPI_Request* requests, int numRequests, int* index) = 0;
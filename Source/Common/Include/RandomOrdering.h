@@ -50,6 +50,77 @@ inline void RandomShuffleMT(TVector& v, std::mt19937_64& rng)
     }
 }
 
+// A seeded pseudo-random permutation of [0..size) that is computed per access instead of
+// being stored, for domains too large to materialize an index map. Implemented as a
+// 4-round Feistel network over the smallest power-of-four domain covering the size, with
+// cycle-walking for values that fall outside [0..size). The round keys are drawn from a
+// Mersenne Twister seeded explicitly, so the permutation is reproducible across platforms.
+class RandomPermutation
+{
+public:
+    RandomPermutation() : m_size(0), m_halfBits(0)
+    {
+    }
+
+    RandomPermutation(size_t size, size_t seed)
+    {
+        Reset(size, seed);
+    }
+
+    // Re-keys the permutation for the given domain size and seed.
+    void Reset(size_t size, size_t seed)
+    {
+        m_size = size;
+        m_halfBits = 1;
+        while ((((size_t)1) << (2 * m_halfBits)) < size)
+            m_halfBits++;
+
+        std::mt19937_64 rng((uint64_t)seed);
+        for (size_t i = 0; i < c_numberOfRounds; ++i)
+            m_keys[i] = rng();
+    }
+
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    // Maps a position to its permuted position; a bijection on [0..size).
+    size_t operator()(size_t position) const
+    {
+        assert(position < m_size);
+        const size_t mask = (((size_t)1) << m_halfBits) - 1;
+        do
+        {
+            size_t left = position >> m_halfBits;
+            size_t right = position & mask;
+            for (size_t i = 0; i < c_numberOfRounds; ++i)
+            {
+                // The round function only needs to mix well, not be invertible;
+                // the Feistel structure makes the permutation a bijection regardless.
+                size_t mixed = (right ^ m_keys[i]) * 0x9e3779b97f4a7c15ull;
+                mixed ^= mixed >> 32;
+                size_t newRight = left ^ (mixed & mask);
+                left = right;
+                right = newRight;
+            }
+            position = (left << m_halfBits) | right;
+        }
+        // Cycle-walk: out-of-range values are permuted again until they land inside the
+        // domain; this terminates because the network is a bijection on the power-of-four
+        // domain, and the result is a bijection on [0..size).
+        while (position >= m_size);
+        return position;
+    }
+
+private:
+    static const size_t c_numberOfRounds = 4;
+
+    size_t m_size;
+    size_t m_halfBits;
+    size_t m_keys[c_numberOfRounds];
+};
+
 class RandomOrdering // note: NOT thread-safe at all
 {
     // constants for randomization
@@ -138,8 +138,10 @@ struct MBLayout
         m_distanceToNearestEnd = other->m_distanceToNearestEnd;
 
         m_timeStepHasGap = other->m_timeStepHasGap;
+        m_gapFrameBitset = other->m_gapFrameBitset;
 
         m_columnsValidityMask.SetValue(other->m_columnsValidityMask);
+        m_gapColumnRuns = other->m_gapColumnRuns;
         m_writable = other->m_writable;
 
         if (!keepName)
@@ -164,8 +166,10 @@ struct MBLayout
         m_distanceToNearestEnd = std::move(other->m_distanceToNearestEnd);
 
         m_timeStepHasGap = std::move(other->m_timeStepHasGap);
+        m_gapFrameBitset = std::move(other->m_gapFrameBitset);
 
         m_columnsValidityMask = std::move(other->m_columnsValidityMask);
+        m_gapColumnRuns = std::move(other->m_gapColumnRuns);
         m_writable = other->m_writable;
 
         m_axisName = std::move(other->m_axisName);
@@ -186,7 +190,9 @@ public:
         m_distanceToNearestStart.assign(m_numTimeSteps, PTRDIFF_MAX);
         m_distanceToNearestEnd.assign(m_numTimeSteps, PTRDIFF_MAX);
         m_timeStepHasGap.assign(m_numTimeSteps, false);
+        m_gapFrameBitset.assign(m_numParallelSequences * m_numTimeSteps, false);
         m_columnsValidityMask.Resize(0, 0); // invalidate
+        m_gapColumnRuns.clear();            // ditto
         // reset state
         m_numFramesDeclared = 0;
         m_numGapFrames = 0;
@@ -313,6 +319,8 @@ public:
 
     const Matrix<char>& GetColumnsValidityMask(DEVICEID_TYPE deviceId) const;
 
+    const std::vector<std::pair<size_t, size_t>>& GetGapColumnRuns() const;
+
     // compare whether two layouts are the same
     bool operator==(const MBLayout& other) const
     {
@@ -393,6 +401,7 @@ public:
             for (size_t t = b; t < e; t++)
             {
                 m_timeStepHasGap[t] = true;
+                m_gapFrameBitset[t * m_numParallelSequences + s] = true;
                 m_distanceToStart(s, t) = -1; // start flags also encode gaps
             }
         }
@@ -598,12 +607,23 @@ private:
 
     vector<bool> m_timeStepHasGap; // [t] true if at least one gap in time step t
 
+    // Compact per-frame gap flags, in canonical column order (column = t * numParallelSequences + s).
+    // Built incrementally while sequences are added, so gap tests and the cached masks below do not
+    // have to probe the m_distanceToStart matrix element by element.
+    vector<bool> m_gapFrameBitset; // [t * numParallelSequences + s] true if that frame is a gap
+
     // Cached mask indicating the validity of each column in the MBLayout
     // TODO: We actually just need a boolean matrix for this.
     // A value of 1 indicates that the column has valid content
     // and 0 indicates invalid (aka MinibatchPackingFlags::NoInput)
     mutable Matrix<char> m_columnsValidityMask;
 
+    // Cached list of contiguous gap-column runs, as (startColumn, numColumns) pairs in the
+    // canonical column order (column = t * numParallelSequences + s). This is the compact
+    // counterpart of m_columnsValidityMask: masking can zero just these runs instead of
+    // sweeping the full matrix. Lazily created, invalidated together with the mask.
+    mutable std::vector<std::pair<size_t, size_t>> m_gapColumnRuns;
+
     // A boolean flag indicating whether the MBLayout can be further modified
     // When it's value is false, no set operations are allowed on the MBLayout.
     // Meant to guard in lazy creation of m_columnsValidityMask.
@@ -834,8 +854,8 @@ inline bool MBLayout::IsGap(const FrameRange &fr) const
     if (s == SIZE_MAX) // aggregate requested
         return m_timeStepHasGap[t];
 
-    // determine flags from matrices
-    return m_distanceToStart(s, t) < 0; // value is -1 for gaps, non-negative otherwise
+    // determine flag from the compact bitset (m_distanceToStart encodes the same as value -1)
+    return m_gapFrameBitset[t * m_numParallelSequences + s];
 }
 
 // test whether frame is exceeding the bounds of the MB
@@ -917,19 +937,12 @@ inline const Matrix<char>& MBLayout::GetColumnsValidityMask(DEVICEID_TYPE device
 
         std::vector<char> columnsValidityMask(nT * nS, 1); // form the mask in a CPU-side STL vector first
         size_t gapsFound = 0;
-        for (size_t t = 0; t < nT; t++)
+        for (size_t col = 0; col < nT * nS; col++) // expand the compact per-frame bitset
         {
-            FrameRange fr(nullptr, t);
-            if (IsGap(fr))
+            if (m_gapFrameBitset[col])
             {
-                for (size_t s = 0; s < nS; s++)
-                {
-                    if (IsGap(fr.Sequence(s)))
-                    {
-                        columnsValidityMask[(t * nS) + s] = 0;
-                        gapsFound++;
-                    }
-                }
+                columnsValidityMask[col] = 0;
+                gapsFound++;
             }
         }
         assert(gapsFound == m_numGapFrames); // sanity check
@@ -941,6 +954,38 @@ inline const Matrix<char>& MBLayout::GetColumnsValidityMask(DEVICEID_TYPE device
     return m_columnsValidityMask;
 }
 
+// return the cached list of contiguous gap-column runs, which is lazily created here upon first call
+// This is the compact form of GetColumnsValidityMask(): callers that mask whole minibatches can
+// zero out just these column ranges instead of sweeping the full matrix against the mask.
+// Must only be called if there are gaps.
+inline const std::vector<std::pair<size_t, size_t>>& MBLayout::GetGapColumnRuns() const
+{
+    CheckIsValid();
+    // lazily compute the run list (never empty when there are gaps)
+    if (m_gapColumnRuns.empty())
+    {
+        assert(HasGaps()); // must only be called if there are gaps
+        Lock();
+
+        size_t nT = GetNumTimeSteps();
+        size_t nS = GetNumParallelSequences();
+
+        size_t gapsFound = 0;
+        for (size_t col = 0; col < nT * nS; col++) // coalesce the compact per-frame bitset into runs
+        {
+            if (!m_gapFrameBitset[col])
+                continue;
+            if (!m_gapColumnRuns.empty() && m_gapColumnRuns.back().first + m_gapColumnRuns.back().second == col)
+                m_gapColumnRuns.back().second++; // extends the previous run
+            else
+                m_gapColumnRuns.push_back(std::make_pair(col, (size_t) 1));
+            gapsFound++;
+        }
+        assert(gapsFound == m_numGapFrames); // sanity check
+    }
+    return m_gapColumnRuns;
+}
+
 // class for defining an iteration over a sequence, forward and backward
 // One day, we may also have nested structures. For those, FrameRangeIterations will be able to be instantiated from FrameRange objects to loop over their nested dimension.
 class FrameRangeIteration
@@ -1192,6 +1237,20 @@ static inline void MaskMissingColumnsTo(Matrix<ElemType>& matrixToMask, const MB
 {
     if (pMBLayout && pMBLayout->HasGaps(fr))
     {
+        // Fast path for masking a whole minibatch (the common case): write 'val' into just the
+        // gap-column runs from the layout's cached run list, instead of forming a full validity
+        // mask and sweeping the entire matrix against it. The cost becomes proportional to the
+        // amount of padding rather than to the minibatch size.
+        if (fr.IsAllFrames() && fr.seqIndex == SIZE_MAX)
+        {
+            if ((matrixToMask.GetNumCols() % pMBLayout->GetNumCols()) != 0)
+                LogicError("MaskMissingColumnsTo: The number of columns of the matrix to be masked is not a multiple of the number of columns of the layout.");
+            size_t numColsPerMaskColumn = matrixToMask.GetNumCols() / pMBLayout->GetNumCols();
+            for (const auto& run : pMBLayout->GetGapColumnRuns())
+                matrixToMask.ColumnSlice(run.first * numColsPerMaskColumn, run.second * numColsPerMaskColumn).SetValue(val);
+            return;
+        }
+
         const auto& maskMatrix = pMBLayout->GetColumnsValidityMask(matrixToMask.GetDeviceId());
 
         maskMatrix.TransferToDeviceIfNotThere(matrixToMask.GetDeviceId(), /*ismoved=*/ false, /*emptyTransfer=*/ false, /*updatePreferredDevice=*/ false);
@@ -2,6 +2,14 @@
 
 #include <string>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h> // for __rdtsc()
+#define CNTK_HAS_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h> // for __rdtsc()
+#define CNTK_HAS_RDTSC
+#endif
+
 namespace Microsoft { namespace MSR { namespace CNTK {
 
 class Timer
@@ -57,4 +65,70 @@ public:
     static long long GetTicksPerSecond();
 };
 
+// -----------------------------------------------------------------------
+// CycleClock -- cycle-granular timestamps off the processor's timestamp
+// counter. A read costs a few ns (vs. 20-30 ns for Clock), cheap enough to
+// instrument per-node or per-chunk events in production builds. Tick
+// duration is calibrated against Clock on first use of SecondsPerTick().
+// -----------------------------------------------------------------------
+
+class CycleClock
+{
+public:
+    static long long GetTimeStamp()
+    {
+#ifdef CNTK_HAS_RDTSC
+        return (long long) __rdtsc();
+#else
+        return Clock::GetTimeStamp(); // no TSC on this architecture: fall back to the regular clock
+#endif
+    }
+    static double SecondsPerTick(); // calibrated once, lazily
+};
+
+// -----------------------------------------------------------------------
+// CycleCounters -- named aggregation of CycleClock intervals. Counters are
+// registered once (cheap, locked) and then accumulated into per-thread
+// buffers without any synchronization, so leaving the instrumentation
+// compiled in costs well under 1%. Report() sums the live thread buffers
+// plus the totals of exited threads and logs seconds and hit counts per
+// name through the progress-tracing log format.
+// -----------------------------------------------------------------------
+
+class CycleCounters
+{
+public:
+    static const size_t c_maxCounters = 64;
+
+    static size_t Register(const std::string& name); // get the id for a counter name (creates it if needed)
+    static void Add(size_t id, long long ticks);     // accumulate into this thread's buffer
+    static void Report();                            // log all counters; totals are a snapshot while threads run
+};
+
+// -----------------------------------------------------------------------
+// ScopedCycleTimer -- adds the lifetime of the scope to a named counter.
+// Typical use:
+//     static const size_t id = CycleCounters::Register("forward:Times");
+//     ScopedCycleTimer timer(id);
+// -----------------------------------------------------------------------
+
+class ScopedCycleTimer
+{
+    size_t m_id;
+    long long m_start;
+
+public:
+    ScopedCycleTimer(size_t id)
+        : m_id(id), m_start(CycleClock::GetTimeStamp())
+    {
+    }
+    ~ScopedCycleTimer()
+    {
+        CycleCounters::Add(m_id, CycleClock::GetTimeStamp() - m_start);
+    }
+
+    ScopedCycleTimer(const ScopedCycleTimer&) = delete;
+    ScopedCycleTimer& operator=(const ScopedCycleTimer&) = delete;
+};
+
 }}}
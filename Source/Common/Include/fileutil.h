@@ -135,6 +135,25 @@ void fprintfOrDie(FILE* f, const char* format, ...);
 
 void fflushOrDie(FILE* f);
 
+// ----------------------------------------------------------------------------
+// write-behind: route fwriteOrDie() data for a stream through a background
+// writer thread, so callers (checkpointing, output writers) do not block on
+// storage latency. fflushOrDie(), fseekOrDie(), fget/setpos() and freadOrDie()
+// drain the queue first, so position-dependent code stays correct; a write
+// error is rethrown from the next drain point.
+// ----------------------------------------------------------------------------
+
+void fenableWriteBehind(FILE* f);  // start queueing fwriteOrDie() calls for 'f' to a background thread
+void fdrainWriteBehind(FILE* f);   // wait until all queued data has been handed to the OS (no-op if not enabled)
+void fdisableWriteBehind(FILE* f); // drain and stop the background thread; call before closing 'f'
+
+// ----------------------------------------------------------------------------
+// fadviseSequentialRead(): advise the OS that 'f' will be read front to back,
+// enlarging the kernel readahead window. Best effort; errors are ignored.
+// ----------------------------------------------------------------------------
+
+void fadviseSequentialRead(FILE* f);
+
 // ----------------------------------------------------------------------------
 // filesize(): determine size of the file in bytes
 // ----------------------------------------------------------------------------
@@ -240,6 +259,56 @@ void fgetline(FILE* f, std::wstring& s, std::vector<char>& buf);
 void fgetline(FILE* f, std::vector<char>& buf);
 void fgetline(FILE* f, std::vector<wchar_t>& buf);
 
+// ----------------------------------------------------------------------------
+// MemoryMappedTextFile: zero-copy line iteration over a memory-mapped file.
+// GetLine() returns borrowed (pointer, length) spans into the mapped pages,
+// with the newline scan done by memchr() (SIMD-accelerated in the C library),
+// so no line is ever copied into a caller buffer. Offered alongside fgetline()
+// so the legacy text readers can adopt it incrementally; spans stay valid
+// until the object is destructed.
+// ----------------------------------------------------------------------------
+
+class MemoryMappedTextFile
+{
+public:
+    // a borrowed view of one line inside the mapped file (trailing newline removed, NOT 0-terminated)
+    struct LineSpan
+    {
+        const char* data;
+        size_t size;
+        std::string ToString() const
+        {
+            return std::string(data, size);
+        }
+    };
+
+    explicit MemoryMappedTextFile(const std::wstring& pathname);
+    MemoryMappedTextFile(const MemoryMappedTextFile&) = delete;
+    MemoryMappedTextFile& operator=(const MemoryMappedTextFile&) = delete;
+    ~MemoryMappedTextFile();
+
+    bool GetLine(LineSpan& line); // get the next line; returns false once the end of the file is reached
+    void Reset()                  // restart iteration at the beginning of the file
+    {
+        m_pos = 0;
+    }
+    size_t Size() const // size of the mapped file in bytes
+    {
+        return m_size;
+    }
+
+private:
+    const char* m_data; // the mapped file contents
+    size_t m_size;
+    size_t m_pos; // read cursor of GetLine()
+#ifdef _WIN32
+    HANDLE m_fileHandle;
+    HANDLE m_mappingHandle;
+#else
+    int m_fd;
+#endif
+};
+
 const char* fgetstring(FILE* f, char* buf, int size);
 template <size_t n>
 const char* fgetstring(FILE* f, char(&buf)[n])
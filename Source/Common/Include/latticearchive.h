@@ -21,6 +21,11 @@
 #include <string>
 #include <unordered_map>
 #include <algorithm> // for find()
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include "simplesenonehmm.h"
 #include "Matrix.h"
 
@@ -1093,6 +1098,7 @@ public:
         // to work with CNTK's GPU memory
         void setdevice(size_t DeviceId);
         size_t getdevice();
+        static size_t getdevicecount(); // number of devices usable for lattice processing
         void release(bool cpumode);
         void setloglls(const Microsoft::MSR::CNTK::Matrix<float>& loglls);
         void setloglls(const Microsoft::MSR::CNTK::Matrix<double>& loglls);
@@ -1213,9 +1219,110 @@ class archive
     mutable size_t currentarchiveindex;               // which archive is open
     mutable auto_file_ptr f;                          // cached archive file handle of currentarchiveindex
     std::unordered_map<std::wstring, latticeref> toc; // [key] -> (file, offset)  --table of content (.toc file)
+
+    // background prefetching: a small pool of decoder threads reads and decompresses
+    // upcoming lattices (keys known from the randomizer's lookahead) while the current
+    // minibatch trains, so getlattice() mostly hits the in-memory cache
+    mutable std::mutex prefetchmutex;                   // guards the four members below
+    mutable std::condition_variable prefetchpending;    // signalled when keys are queued or shutdown is requested
+    mutable std::condition_variable prefetchconsumed;   // signalled when a cached lattice is picked up
+    mutable std::deque<std::wstring> prefetchqueue;     // keys waiting for a decoder thread
+    mutable std::unordered_map<std::wstring, std::shared_ptr<lattice>> prefetchedlattices; // [key] -> decoded lattice
+    mutable std::vector<std::thread> prefetchthreads;   // the pool (started lazily on first prefetchlattices())
+    mutable bool prefetchshutdown = false;
+    static const size_t prefetchcachelimit = 4096;      // decoder threads stall once this many lattices sit unconsumed
+
+    // decoder-thread main loop; each thread keeps its own file handles so the
+    // cached handle of the synchronous path is not shared across threads
+    void prefetchthreadproc() const
+    {
+        std::vector<auto_file_ptr> files(archivepaths.size()); // our own per-archive handles, opened on first use
+        std::unique_lock<std::mutex> lock(prefetchmutex);
+        for (;;)
+        {
+            prefetchpending.wait(lock, [this] { return !prefetchqueue.empty() || prefetchshutdown; });
+            if (prefetchshutdown)
+                return;
+            prefetchconsumed.wait(lock, [this] { return prefetchedlattices.size() < prefetchcachelimit || prefetchshutdown; });
+            if (prefetchshutdown)
+                return;
+            const std::wstring key = prefetchqueue.front();
+            prefetchqueue.pop_front();
+            if (prefetchedlattices.find(key) != prefetchedlattices.end()) // duplicate request
+                continue;
+            auto iter = toc.find(key);
+            if (iter == toc.end()) // unknown key: leave it to getlattice() to complain
+                continue;
+            const size_t archiveindex = iter->second.archiveindex;
+            const auto offset = iter->second.offset;
+            lock.unlock();
+            auto L = std::make_shared<lattice>();
+            bool ok = false;
+            try
+            {
+                // the idmap was already loaded by prefetchlattices() on the calling thread; read-only from here
+                auto& idmap = getcachedidmap(archiveindex, modelsymmap);
+                const size_t spunit = idmap.back();
+                if (files[archiveindex] == nullptr)
+                    files[archiveindex] = fopenOrDie(archivepaths[archiveindex], L"rbS");
+                fsetpos(files[archiveindex], offset);
+                L->fread(files[archiveindex], idmap, spunit);
+                L->setverbosity(verbosity);
+                L->key = key;
+                ok = true;
+            }
+            catch (const std::exception& e) // drop the entry; the synchronous path will retry and surface the error
+            {
+                fprintf(stderr, "prefetchthreadproc: error prefetching lattice '%S': %s\n", key.c_str(), e.what());
+                files[archiveindex] = NULL; // reopen on next use, in case the handle is the problem
+            }
+            lock.lock();
+            if (ok)
+                prefetchedlattices[key] = std::move(L);
+        }
+    }
 public:
+    // queue upcoming lattice keys for background decoding
+    // Call this with the randomizer's lookahead when a minibatch is handed out; the
+    // decoded lattices are picked up (and removed from the cache) by getlattice().
+    // Unknown keys are ignored here and will fail in getlattice() as before.
+    void prefetchlattices(const std::vector<std::wstring>& keys, size_t numthreads = 2) const
+    {
+        if (empty())
+            return;
+        // make sure all needed .symlist files are loaded before the pool touches them (lazy load is not thread-safe)
+        for (const auto& key : keys)
+        {
+            auto iter = toc.find(key);
+            if (iter != toc.end())
+                getcachedidmap(iter->second.archiveindex, modelsymmap);
+        }
+        std::lock_guard<std::mutex> lock(prefetchmutex);
+        if (prefetchthreads.empty()) // lazy start of the pool
+            for (size_t i = 0; i < numthreads; i++)
+                prefetchthreads.emplace_back(&archive::prefetchthreadproc, this);
+        for (const auto& key : keys)
+            if (prefetchedlattices.find(key) == prefetchedlattices.end())
+                prefetchqueue.push_back(key);
+        prefetchpending.notify_all();
+    }
+
     // construct = open the archive
     // archive() : currentarchiveindex (SIZE_MAX) {}
+    ~archive()
+    {
+        if (!prefetchthreads.empty()) // shut down the prefetch pool
+        {
+            {
+                std::lock_guard<std::mutex> lock(prefetchmutex);
+                prefetchshutdown = true;
+            }
+            prefetchpending.notify_all();
+            prefetchconsumed.notify_all();
+            for (auto& t : prefetchthreads)
+                t.join();
+        }
+    }
     void setverbosity(int veb) const
     {
         verbosity = veb;
@@ -1324,6 +1431,21 @@ public:
         auto iter = toc.find(key);
         if (iter == toc.end())
             LogicError("getlattice: requested lattice for non-existent key; haslattice() should have been used to check availability");
+        // fast path: the background pool may have decoded this lattice already
+        {
+            std::lock_guard<std::mutex> lock(prefetchmutex);
+            auto cached = prefetchedlattices.find(key);
+            if (cached != prefetchedlattices.end())
+            {
+                L = std::move(*cached->second);
+                prefetchedlattices.erase(cached);
+                prefetchconsumed.notify_all();
+                if (expectedframes != SIZE_MAX && L.getnumframes() != expectedframes)
+                    LogicError("getlattice: number of frames mismatch between numerator lattice and features");
+                L.setverbosity(verbosity);
+                return;
+            }
+        }
         // get the archive that the lattice lives in and its byte offset
         const size_t archiveindex = iter->second.archiveindex;
         const auto offset = iter->second.offset;
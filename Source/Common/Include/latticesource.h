@@ -62,6 +62,14 @@ public:
 #endif
     }
 
+    // queue upcoming lattice keys for background decoding
+    // Call this with the keys of a chunk (or any other lookahead) before the getlattices()
+    // calls; the archive's decoder pool then turns those into in-memory cache hits.
+    void prefetchlattices(const std::vector<std::wstring>& keys) const
+    {
+        denlattices.prefetchlattices(keys); // (numerator lattices are not read in getlattices())
+    }
+
     void getlattices(const std::wstring& key, std::shared_ptr<const latticepair>& L, size_t expectedframes) const
     {
         std::shared_ptr<latticepair> LP(new latticepair);
@@ -40,7 +40,7 @@ template <typename FUNCTION>
 void parallel_for_on_each_numa_node(bool multistep, const FUNCTION &body)
 {
     // get our configuration
-    const size_t cores = ppl_cores;
+    const size_t cores = msra::parallel::get_cores();
     assert(cores > 0);
     const size_t nodes = getnumnodes();
     const size_t corespernode = (cores - 1) / nodes + 1;
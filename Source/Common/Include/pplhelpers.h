@@ -2,14 +2,21 @@
 // Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
 //
-// pplhelpers.h -- some helpers for PPL library
+// pplhelpers.h -- parallel-for helpers over a process-wide work-stealing thread pool
 //
 
 #pragma once
 
-#ifndef __unix__
-#include <ppl.h>
-#endif
+#include <assert.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace msra { namespace parallel {
 
 // ===========================================================================
@@ -19,48 +26,232 @@ namespace msra { namespace parallel {
 // determine number of CPU cores on this machine
 static inline size_t determine_num_cores()
 {
-    SYSTEM_INFO sysInfo;
-    GetSystemInfo(&sysInfo);
-    return sysInfo.dwNumberOfProcessors;
+    const unsigned int n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
 }
 
-extern size_t ppl_cores; // number of cores to run on as requested by user
+// number of cores to run on as requested by user
+// Note: this is an inline (not static) function so that all translation units
+// share a single process-wide setting.
+inline size_t& num_cores_ref()
+{
+    static size_t cores = determine_num_cores();
+    return cores;
+}
 
+// set the core count before the first parallel operation; it also sizes the thread pool
 static inline void set_cores(size_t cores)
 {
-    ppl_cores = cores;
+    num_cores_ref() = cores;
 }
 
 static inline size_t get_cores() // if returns 1 then no parallelization will be done
 {
-    return ppl_cores;
+    return num_cores_ref();
 }
 
-#if 0
-// execute body() a bunch of times for hopefully each core
-// This is not precise. Cores will be hit multiple times, and some cores may not be touched.
-template <typename FUNCTION> void for_all_numa_nodes_approximately (const FUNCTION & body)
+// ===========================================================================
+// taskpool -- process-wide work-stealing thread pool
+//
+// All parallel loops in the process submit to this single pool instead of
+// each spinning up their own parallelism, so overlapping parallel regions
+// (reader decode, matrix kernels, NUMA loops) share one set of threads
+// rather than oversubscribing the cores. Each worker owns a task deque;
+// contiguous chunks of an iteration space are distributed in blocks so a
+// worker mostly runs neighboring chunks (cache- and NUMA-friendly), and
+// only steals from the back of other workers' deques when its own runs dry.
+// The submitting thread participates in executing tasks, so the pool itself
+// holds get_cores() - 1 threads; its size is fixed at first use.
+// ===========================================================================
+
+class taskpool
 {
-    if (ppl_cores > 1)  // parallel computation (regular)
-        parallel_for ((size_t) 0, ppl_cores * 2, (size_t) 1, [&](size_t) { body(); });
-    else            // for comparison: single-threaded (this also documents what the above means)
-        body();
-}
-#endif
+public:
+    // the process-wide instance; created on first use with get_cores() - 1 threads
+    static taskpool& instance()
+    {
+        static taskpool pool(get_cores() > 0 ? get_cores() - 1 : 0);
+        return pool;
+    }
+
+    // submit a single fire-and-forget task
+    // Components that track their own completion (e.g. reader worker pools) use this.
+    void submit(std::function<void()> task)
+    {
+        const size_t q = m_nextqueue++ % m_queues.size();
+        push(q, std::move(task));
+    }
+
+    // execute task(i) for i in [0, numtasks) on the pool and return when all are done
+    // The calling thread executes tasks as well, so this also works with zero pool threads.
+    void run(size_t numtasks, const std::function<void(size_t)>& task)
+    {
+        if (numtasks == 0)
+            return;
+        if (m_threads.empty() || numtasks == 1) // no pool threads: just run inline
+        {
+            for (size_t i = 0; i < numtasks; i++)
+                task(i);
+            return;
+        }
+        auto state = std::make_shared<runstate>(numtasks);
+        const size_t numqueues = m_queues.size();
+        for (size_t i = 0; i < numtasks; i++)
+        {
+            // block distribution: chunk i goes to queue i * numqueues / numtasks, so each
+            // worker gets a contiguous range of the iteration space unless it steals
+            push(i * numqueues / numtasks, [state, &task, i]()
+            {
+                task(i);
+                state->completeone();
+            });
+        }
+        // participate until all tasks of this run have completed, then return
+        std::function<void()> t;
+        while (state->remaining.load() > 0)
+        {
+            if (trypop(0, t))
+            {
+                t();
+                t = nullptr;
+            }
+            else // all tasks claimed but some still in flight on pool threads
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->alldone.wait(lock, [&]() { return state->remaining.load() == 0; });
+            }
+        }
+    }
+
+    ~taskpool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wakemutex);
+            m_shutdown = true;
+        }
+        m_wake.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    taskpool(const taskpool&) = delete;
+    taskpool& operator=(const taskpool&) = delete;
+
+private:
+    taskpool(size_t numthreads)
+        : m_shutdown(false), m_numpending(0), m_nextqueue(0)
+    {
+        const size_t numqueues = numthreads > 0 ? numthreads : 1; // at least one queue for submit()
+        for (size_t i = 0; i < numqueues; i++)
+            m_queues.push_back(std::unique_ptr<workerqueue>(new workerqueue()));
+        for (size_t i = 0; i < numthreads; i++)
+            m_threads.emplace_back([this, i]() { workerproc(i); });
+    }
+
+    // completion tracking for one run(); shared between the submitter and the tasks
+    struct runstate
+    {
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable alldone;
+        runstate(size_t numtasks) : remaining(numtasks) { }
+        void completeone()
+        {
+            if (remaining.fetch_sub(1) == 1) // we completed the last one
+            {
+                { std::lock_guard<std::mutex> lock(mutex); } // synchronize with a waiter about to sleep
+                alldone.notify_all();
+            }
+        }
+    };
+
+    struct workerqueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void push(size_t q, std::function<void()>&& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queues[q]->mutex);
+            m_queues[q]->tasks.push_back(std::move(task));
+        }
+        m_numpending++;
+        {
+            std::lock_guard<std::mutex> lock(m_wakemutex); // pairs with the wait in workerproc()
+        }
+        m_wake.notify_one();
+    }
+
+    // pop a task, preferring the front of our own queue, else stealing from the back of others
+    bool trypop(size_t preferred, std::function<void()>& task)
+    {
+        const size_t numqueues = m_queues.size();
+        for (size_t q1 = preferred; q1 < preferred + numqueues; q1++)
+        {
+            workerqueue& queue = *m_queues[q1 % numqueues];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            if (q1 == preferred) // our own queue: take the oldest (front)
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            else // stealing: take from the back to stay out of the owner's way
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            m_numpending--;
+            return true;
+        }
+        return false;
+    }
+
+    void workerproc(size_t id)
+    {
+        std::function<void()> task;
+        for (;;)
+        {
+            if (trypop(id, task))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_wakemutex);
+            if (m_shutdown)
+                return;
+            m_wake.wait(lock, [this]() { return m_shutdown || m_numpending.load() > 0; });
+            if (m_shutdown)
+                return;
+        }
+    }
+
+    std::vector<std::unique_ptr<workerqueue>> m_queues; // one deque per pool thread
+    std::vector<std::thread> m_threads;
+    std::mutex m_wakemutex;
+    std::condition_variable m_wake; // signalled when tasks are pushed or at shutdown
+    bool m_shutdown;                // under m_wakemutex
+    std::atomic<size_t> m_numpending;
+    std::atomic<size_t> m_nextqueue; // round-robin target for submit()
+};
 
-// wrapper around Concurrency::parallel_for() to allow disabling parallelization altogether
+// wrapper to allow disabling parallelization altogether
+// Runs f(j0) for j0 = begin, begin + step, ... < end on the shared pool.
 template <typename FUNCTION>
 void parallel_for(size_t begin, size_t end, size_t step, const FUNCTION& f)
 {
-    const size_t cores = ppl_cores;
-    if (cores > 1) // parallel computation (regular)
+    const size_t cores = get_cores();
+    const size_t numtasks = begin < end ? (end - begin + step - 1) / step : 0;
+    if (cores > 1 && numtasks > 1) // parallel computation (regular)
     {
-        //fprintf (stderr, "foreach_index_block: computing %d blocks of %d frames on %d cores\n", nblocks, nfwd, determine_num_cores());
-        Concurrency::parallel_for(begin, end, step, f);
+        taskpool::instance().run(numtasks, [&](size_t i) { f(begin + i * step); });
     }
     else // for comparison: single-threaded (this also documents what the above means)
     {
-        //fprintf (stderr, "foreach_index_block: computing %d blocks of %d frames on a single thread\n", nblocks, nfwd);
         for (size_t j0 = begin; j0 < end; j0 += step)
             f(j0);
     }
@@ -69,11 +260,10 @@ void parallel_for(size_t begin, size_t end, size_t step, const FUNCTION& f)
 // execute a function 'body (j0, j1)' for j = [0..n) in chunks of ~targetstep in 'cores' cores
 // Very similar to parallel_for() except that body function also takes end index,
 // and the 'targetsteps' gets rounded a little to better map to 'cores.'
-// ... TODO: Currently, 'cores' does not limit the number of threads in parallel_for() (not so critical, fix later or never)
 template <typename FUNCTION>
 void foreach_index_block(size_t n, size_t targetstep, size_t targetalignment, const FUNCTION& body)
 {
-    const size_t cores = ppl_cores;
+    const size_t cores = get_cores();
     const size_t maxnfwd = 2 * targetstep;
     size_t nblocks = (n + targetstep / 2) / targetstep;
     if (nblocks == 0)
@@ -87,7 +277,6 @@ void foreach_index_block(size_t n, size_t targetstep, size_t targetalignment, co
     assert(nfwd * nblocks >= n);
     if (nfwd > maxnfwd)
         nfwd = maxnfwd; // limit to allocated memory just in case
-    // ... TODO: does the above actually do anything/significant? nfwd != targetstep?
 
     // enforce alignment
     nfwd = (1 + (nfwd - 1) / targetalignment) * targetalignment;
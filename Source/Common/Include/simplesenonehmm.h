@@ -45,6 +45,10 @@ public:                                // (TODO: better encapsulation)
                 return (size_t) senoneids[i];
             LogicError("getsenoneid: out of bounds access");
         }
+        const unsigned short* getsenoneids() const // flat [0..numstates-1] row, for hoisting out of per-frame loops
+        {
+            return senoneids;
+        }
         size_t getnumstates() const
         {
             return (size_t) numstates;
@@ -68,8 +72,13 @@ public:                                // (TODO: better encapsulation)
     struct transP
     {
     private:
-        size_t numstates;
+        // The matrix comes first and the struct is padded to a multiple of 16 bytes, so
+        // each 4-float row sits on a 16-byte boundary within transPs[] and a lookup
+        // touches the minimum number of cache lines (the per-edge-per-frame loops of the
+        // lattice kernels are bounded by memory latency, not arithmetic).
         float loga[MAXSTATES + 1][MAXSTATES + 1];
+        size_t numstates;
+        char padding[16 - sizeof(size_t) % 16];
         void check(int from, size_t to) const
         {
             if (from < -1 || from >= (int) numstates || to > numstates)
@@ -108,6 +117,7 @@ public:                                // (TODO: better encapsulation)
         {
         }
     };
+    static_assert(sizeof(transP) % 16 == 0, "transP must be padded to a multiple of 16 bytes for aligned row access");
     std::vector<transP> transPs;                       // the transition matrices  --TODO: finish this
     std::unordered_map<std::string, size_t> transPmap; // [transPname] -> index into transPs[]
 public:
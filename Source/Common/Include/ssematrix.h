@@ -27,8 +27,145 @@
 #undef min // some garbage from some Windows header that conflicts with std::min()
 #endif
 
+// optional 8-wide AVX2/FMA kernels, selected at runtime
+// The buffers of ssematrixbase are padded and aligned for 4-wide SSE (16 bytes),
+// not 32, so the kernels below process pairs of 4-float groups and finish an odd
+// trailing group 4-wide. On GCC/Clang the kernels carry a target attribute so
+// this header stays compilable without -mavx2; MSVC accepts the intrinsics as is.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SSEMATRIX_HAS_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h> // for __cpuid()
+#define SSEMATRIX_AVX2_TARGET
+#else
+#define SSEMATRIX_AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+#endif
+
 namespace msra { namespace math {
 
+#ifdef SSEMATRIX_HAS_AVX2
+inline bool detectavx2()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0; // OS saves YMM state
+    __cpuidex(info, 7, 0);
+    const bool avx2 = (info[1] & (1 << 5)) != 0;
+    if (!avx2 || !fma || !osxsave)
+        return false;
+    return (_xgetbv(0) & 6) == 6; // XMM and YMM state enabled by the OS
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+#endif
+
+// test once whether the 8-wide kernels can be used on this machine
+inline bool useavx2()
+{
+#ifdef SSEMATRIX_HAS_AVX2
+    static const bool cached = detectavx2();
+    return cached;
+#else
+    return false;
+#endif
+}
+
+#ifdef SSEMATRIX_HAS_AVX2
+// sum of a[k] * b[k] over nlong 4-float groups, 8-wide with FMA
+SSEMATRIX_AVX2_TARGET inline float dotprod_avx2_sum(const float *a, const float *b, size_t nlong)
+{
+    const size_t npairs = nlong / 2;
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t m = 0; m < npairs; m++)
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(a + 8 * m), _mm256_loadu_ps(b + 8 * m), acc);
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    if (nlong % 2) // odd trailing 4-float group
+        sum4 = _mm_add_ps(sum4, _mm_mul_ps(_mm_load_ps(a + 8 * npairs), _mm_load_ps(b + 8 * npairs)));
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 1));
+    return _mm_cvtss_f32(sum4);
+}
+
+// 8-wide version of the dotprod4() inner loop: one row against 4 columns,
+// sharing the (cache-unfriendly) row loads across all 4 accumulators
+SSEMATRIX_AVX2_TARGET inline void dotprod4_avx2_sums(const float *row, const float *cols4, size_t cols4stride, size_t nlong, float (&sums)[4])
+{
+    const float *pcol0 = cols4 + 0 * cols4stride;
+    const float *pcol1 = cols4 + 1 * cols4stride;
+    const float *pcol2 = cols4 + 2 * cols4stride;
+    const float *pcol3 = cols4 + 3 * cols4stride;
+    const size_t npairs = nlong / 2;
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    for (size_t m = 0; m < npairs; m++)
+    {
+        const __m256 r = _mm256_loadu_ps(row + 8 * m);
+        acc0 = _mm256_fmadd_ps(r, _mm256_loadu_ps(pcol0 + 8 * m), acc0);
+        acc1 = _mm256_fmadd_ps(r, _mm256_loadu_ps(pcol1 + 8 * m), acc1);
+        acc2 = _mm256_fmadd_ps(r, _mm256_loadu_ps(pcol2 + 8 * m), acc2);
+        acc3 = _mm256_fmadd_ps(r, _mm256_loadu_ps(pcol3 + 8 * m), acc3);
+    }
+    __m128 sum0 = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    __m128 sum1 = _mm_add_ps(_mm256_castps256_ps128(acc1), _mm256_extractf128_ps(acc1, 1));
+    __m128 sum2 = _mm_add_ps(_mm256_castps256_ps128(acc2), _mm256_extractf128_ps(acc2, 1));
+    __m128 sum3 = _mm_add_ps(_mm256_castps256_ps128(acc3), _mm256_extractf128_ps(acc3, 1));
+    if (nlong % 2) // odd trailing 4-float group
+    {
+        const __m128 r = _mm_load_ps(row + 8 * npairs);
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(r, _mm_load_ps(pcol0 + 8 * npairs)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(r, _mm_load_ps(pcol1 + 8 * npairs)));
+        sum2 = _mm_add_ps(sum2, _mm_mul_ps(r, _mm_load_ps(pcol2 + 8 * npairs)));
+        sum3 = _mm_add_ps(sum3, _mm_mul_ps(r, _mm_load_ps(pcol3 + 8 * npairs)));
+    }
+    // transpose-free horizontal sums
+    sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+    sum1 = _mm_add_ps(sum1, _mm_movehl_ps(sum1, sum1));
+    sum2 = _mm_add_ps(sum2, _mm_movehl_ps(sum2, sum2));
+    sum3 = _mm_add_ps(sum3, _mm_movehl_ps(sum3, sum3));
+    sums[0] = _mm_cvtss_f32(_mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1)));
+    sums[1] = _mm_cvtss_f32(_mm_add_ss(sum1, _mm_shuffle_ps(sum1, sum1, 1)));
+    sums[2] = _mm_cvtss_f32(_mm_add_ss(sum2, _mm_shuffle_ps(sum2, sum2, 1)));
+    sums[3] = _mm_cvtss_f32(_mm_add_ss(sum3, _mm_shuffle_ps(sum3, sum3, 1)));
+}
+
+// us[k] = us[k] * thisweight + other[k] * weight over n4 4-float groups, 8-wide with FMA
+SSEMATRIX_AVX2_TARGET inline void addweighted_avx2(float *us, const float *other, size_t n4, float thisweight, float weight)
+{
+    const size_t npairs = n4 / 2;
+    const __m256 w8 = _mm256_set1_ps(weight);
+    if (thisweight == 1.0f)
+        for (size_t m = 0; m < npairs; m++)
+            _mm256_storeu_ps(us + 8 * m, _mm256_fmadd_ps(_mm256_loadu_ps(other + 8 * m), w8, _mm256_loadu_ps(us + 8 * m)));
+    else if (thisweight == 0.0f)
+        for (size_t m = 0; m < npairs; m++)
+            _mm256_storeu_ps(us + 8 * m, _mm256_mul_ps(_mm256_loadu_ps(other + 8 * m), w8));
+    else
+    {
+        const __m256 tw8 = _mm256_set1_ps(thisweight);
+        for (size_t m = 0; m < npairs; m++)
+            _mm256_storeu_ps(us + 8 * m, _mm256_fmadd_ps(_mm256_loadu_ps(us + 8 * m), tw8, _mm256_mul_ps(_mm256_loadu_ps(other + 8 * m), w8)));
+    }
+    if (n4 % 2) // odd trailing 4-float group
+    {
+        const __m128 w4 = _mm_set1_ps(weight);
+        const __m128 tw4 = _mm_set1_ps(thisweight);
+        const __m128 o = _mm_mul_ps(_mm_load_ps(other + 8 * npairs), w4);
+        const __m128 u = _mm_load_ps(us + 8 * npairs);
+        _mm_store_ps(us + 8 * npairs, thisweight == 0.0f ? o : _mm_add_ps(_mm_mul_ps(u, tw4), o));
+    }
+}
+#endif // SSEMATRIX_HAS_AVX2
+
 // ===========================================================================
 // ssematrixbase -- matrix with SSE-based parallel arithmetic but no memory management
 // This can be passed around for computation, but not instantiated directly.
@@ -387,6 +524,17 @@ public:
         assert((15 & reinterpret_cast<uintptr_t>(&b[0])) == 0); // enforce SSE alignment
 
         size_t nlong = (a.size() + 3) / 4; // number of SSE elements
+#ifdef SSEMATRIX_HAS_AVX2
+        if (useavx2())
+        {
+            const float sum = dotprod_avx2_sum(&a[0], &b[0], nlong);
+            if (addtoresult)
+                result = result * thisscale + weight * sum;
+            else
+                result = sum;
+            return;
+        }
+#endif
         const msra::math::float4 *pa = (const msra::math::float4 *) &a[0];
         const msra::math::float4 *pb = (const msra::math::float4 *) &b[0];
 
@@ -428,6 +576,21 @@ public:
         // perform multiple columns in parallel
         const size_t nlong = (row.size() + 3) / 4; // number of SSE elements
 
+#ifdef SSEMATRIX_HAS_AVX2
+        if (useavx2())
+        {
+            float sums[4];
+            dotprod4_avx2_sums(&row[0], &cols4[0], cols4stride, nlong, sums);
+            for (size_t k = 0; k < 4; k++)
+            {
+                if (addtoresult)
+                    usij[k * usijstride] = usij[k * usijstride] * thisscale + weight * sums[k];
+                else
+                    usij[k * usijstride] = sums[k];
+            }
+            return;
+        }
+#endif
         // row
         const msra::math::float4 *prow = (const msra::math::float4 *) &row[0];
 
@@ -788,6 +951,13 @@ public:
         assert(us4.size() == other4.size());
 
         // perform the operation on one long vector
+#ifdef SSEMATRIX_HAS_AVX2
+        if (useavx2() && us4.size() > 0)
+        {
+            addweighted_avx2((float *) &us4[0], (const float *) &other4[0], us4.size(), thisweight, weight);
+            return;
+        }
+#endif
         msra::math::float4 weight4(weight);
         if (thisweight == 1.0f)
         {
@@ -7,6 +7,9 @@
 
 #if HAS_MPI
 #pragma comment(lib, "msmpi.lib")
+#if defined(OPEN_MPI)
+#include <mpi-ext.h> // for MPIX_Query_cuda_support(), the CUDA-aware runtime probe
+#endif
 #else
 #define MPI_SUCCESS             0
 #define MPI_ERR_INTERN          1
@@ -33,6 +36,23 @@ class MPIWrapperMpi : public MPIWrapper
     // MPI communicator that reflects the current subset selection
     MPI_Comm m_currentComm;
 
+    // host topology derived in RequestNodes() from the processor names of all ranks
+    size_t m_numRanksOnHost;
+    size_t m_rankOnHost;
+    size_t m_hostRootRank;
+    bool m_hostsUniform;
+
+    // MPI communicator connecting the ranks that share our on-host index, one per host
+    MPI_Comm m_crossHostComm;
+
+    // packing buffers for AllGatherSparse, grown on demand and reused across calls so the
+    // exchange does not re-register memory with the MPI library every iteration
+    mutable std::vector<char> m_sparseSendBuffer;
+    mutable std::vector<char> m_sparseRecvBuffer;
+
+    template <typename ElemType>
+    void AllGatherSparseImpl(const size_t *indices, const ElemType *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<ElemType>& receivedValues) const;
+
     // MPI_Init() is loading the msmpi.dll. Failing to load the dll will terminate the
     // application.
     int MPI_Init_DL();
@@ -71,9 +91,19 @@ public:
     size_t MainNodeRank() const;
     bool IsMultiHost() const;
 
+    // host topology
+    size_t NumRanksOnHost() const;
+    size_t CurrentRankOnHost() const;
+    size_t CurrentHostRootRank() const;
+    bool HostsAreUniform() const;
+
     // Use GPUDirect RDMA support
     virtual bool UseGpuGdr() override;
 
+    // elastic membership (requires the ULFM MPI extensions)
+    virtual bool SupportsFaultTolerance() const override;
+    virtual bool TryShrinkAfterFailure() override;
+
     // -----------------------------------------------------------------------
     // data-exchange functions (wrappers around MPI functions)
     // -----------------------------------------------------------------------
@@ -106,6 +136,9 @@ public:
     virtual void AllReduce(double* sendData, double* receiveData, size_t numElements, MPI_Op op = MPI_SUM) const;
     virtual void AllReduce(float* sendData, float* receiveData, size_t numElements, MPI_Op op = MPI_SUM) const;
 
+    virtual void AllReduceAcrossHosts(double* sendData, size_t numElements, MPI_Op op = MPI_SUM) const;
+    virtual void AllReduceAcrossHosts(float* sendData, size_t numElements, MPI_Op op = MPI_SUM) const;
+
     virtual void AllReduceAsync(size_t* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const;
     virtual void AllReduceAsync(int* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const;
     virtual void AllReduceAsync(double* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const;
@@ -143,6 +176,9 @@ public:
     virtual void Gatherv(const float *sendData, size_t numSendElements, float *receiveData, int recvCounts[], int offsets[], size_t rootRank) const;
     virtual void Gatherv(const double *sendData, size_t numSendElements, double *receiveData, int recvCounts[], int offsets[], size_t rootRank) const;
 
+    virtual void AllGatherSparse(const size_t *indices, const float *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<float>& receivedValues) const;
+    virtual void AllGatherSparse(const size_t *indices, const double *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<double>& receivedValues) const;
+
     // wait for all ranks to reach here
     virtual int WaitAll();
     virtual void WaitAny(MPI_Request* requests, int numRequests, int* index);
@@ -168,6 +204,11 @@ public:
     bool UsingAllNodes() const;
     size_t MainNodeRank() const;
     bool IsMultiHost() const;
+    // host topology
+    size_t NumRanksOnHost() const;
+    size_t CurrentRankOnHost() const;
+    size_t CurrentHostRootRank() const;
+    bool HostsAreUniform() const;
     // Use GPUDirect RDMA
     virtual bool UseGpuGdr() override;
 
@@ -203,6 +244,9 @@ public:
     virtual void AllReduce(double* sendData, double* receiveData, size_t numElements, MPI_Op op = MPI_SUM) const;
     virtual void AllReduce(float* sendData, float* receiveData, size_t numElements, MPI_Op op = MPI_SUM) const;
 
+    virtual void AllReduceAcrossHosts(double* sendData, size_t numElements, MPI_Op op = MPI_SUM) const;
+    virtual void AllReduceAcrossHosts(float* sendData, size_t numElements, MPI_Op op = MPI_SUM) const;
+
     virtual void AllReduceAsync(size_t* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const;
     virtual void AllReduceAsync(int* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const;
     virtual void AllReduceAsync(double* sendData, size_t numElements, MPI_Request* request, MPI_Op op = MPI_SUM) const;
@@ -240,6 +284,9 @@ public:
     virtual void Gatherv(const float *sendData, size_t numSendElements, float *receiveData, int recvCounts[], int offsets[], size_t rootRank) const;
     virtual void Gatherv(const double *sendData, size_t numSendElements, double *receiveData, int recvCounts[], int offsets[], size_t rootRank) const;
 
+    virtual void AllGatherSparse(const size_t *indices, const float *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<float>& receivedValues) const;
+    virtual void AllGatherSparse(const size_t *indices, const double *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<double>& receivedValues) const;
+
     // wait for all ranks to reach here
     virtual int WaitAll();
     virtual void WaitAny(MPI_Request* requests, int numRequests, int* index);
@@ -394,7 +441,7 @@ int MPIWrapper::GetTotalNumberOfMPINodes()
 int MPIWrapperMpi::s_myRank = -1;
 
 MPIWrapperMpi::MPIWrapperMpi()
-    : m_currentComm(MPI_COMM_WORLD)
+    : m_currentComm(MPI_COMM_WORLD), m_numRanksOnHost(1), m_rankOnHost(0), m_hostRootRank(0), m_hostsUniform(true), m_crossHostComm(MPI_COMM_NULL)
 {
     static bool initialized = false;
     if (initialized)
@@ -414,6 +461,13 @@ MPIWrapperMpi::MPIWrapperMpi()
     m_numNodesInUse = m_numMPINodes;
     m_multiHost = true;
 
+#ifdef MPIX_ERR_PROC_FAILED
+    // With the ULFM fault-tolerance extensions available, let failures surface as error codes
+    // (turned into exceptions by MpiFail) instead of aborting the whole job, so that the caller
+    // gets a chance to shrink the communicator and continue, cf. TryShrinkAfterFailure().
+    MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_RETURN);
+#endif
+
     // Verify that the environment variable used by GetTotalNumberOfMPINodes()  
     // matches what the MPI API says. There're actually two possible cases:
     // 1) when we're running with mpiexec both values have to match;
@@ -444,6 +498,12 @@ MPIWrapperMpi::MPIWrapperMpi()
         fflush(stderr);
     }
 
+    if (GetMathLibTraceLevel() > 0 && UseGpuGdr())
+    {
+        fprintf(stderr, "mpihelper: MPI is CUDA-aware; gradients will be exchanged directly from device memory\n");
+        fflush(stderr);
+    }
+
     // do an initial handshake
     Ping("mpihelper");
 
@@ -608,17 +668,122 @@ void MPIWrapperMpi::RequestNodes(const char *msg, size_t requestednodes /*defaul
         }
     }
 
+    // Derive the full host topology from the gathered names: how many ranks share our
+    // host, our index among them, the global rank of the first of them, and whether all
+    // hosts run the same number of ranks. Hierarchical aggregation schemes reduce within
+    // each host first and then exchange one shard per host over the inter-host fabric.
+    const size_t myRank = (size_t)CurrentNodeRank();
+    const char* myGatheredName = allNames + myRank * nameMax;
+    m_numRanksOnHost = 0;
+    m_rankOnHost = 0;
+    m_hostRootRank = myRank;
+    for (size_t i = 0; i < m_numNodesInUse; i++)
+    {
+        if (strcmp(myGatheredName, allNames + i * nameMax) != 0)
+            continue;
+        if (i < myRank)
+            m_rankOnHost++;
+        if (i < m_hostRootRank)
+            m_hostRootRank = i;
+        m_numRanksOnHost++;
+    }
+
+    m_hostsUniform = true;
+    for (size_t i = 0; i < m_numNodesInUse && m_hostsUniform; i++)
+    {
+        size_t numRanksOnThatHost = 0;
+        for (size_t j = 0; j < m_numNodesInUse; j++)
+        {
+            if (strcmp(allNames + i * nameMax, allNames + j * nameMax) == 0)
+                numRanksOnThatHost++;
+        }
+        m_hostsUniform = (numRanksOnThatHost == m_numRanksOnHost);
+    }
+
+    // Connect the ranks that share the same on-host index, one per host. When the hosts
+    // are uniform, an allreduce over this communicator aggregates a per-host shard across
+    // all hosts; the split is still performed otherwise so every rank holds a valid
+    // communicator, callers just must not use it for hierarchical aggregation then.
+    if (m_crossHostComm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_crossHostComm) || MpiFail("requestnodes: MPI_Comm_free");
+    MPI_Comm_split(m_currentComm, (int)m_rankOnHost, (int)myRank, &m_crossHostComm) || MpiFail("requestnodes: MPI_Comm_split");
+
     fprintf(stderr, "requestnodes [%s]: using %d out of %d MPI nodes on %s (%d requested); we (%d) are %s\n",
         msg, (int)m_numNodesInUse, (int)m_numMPINodes, m_multiHost ? "multiple hosts" : "a single host",
         (int)requestednodes, (int)CurrentNodeRank(), IsIdle() ? "out (idle)" : "in (participating)");
     fflush(stderr);
 }
 
+bool MPIWrapperMpi::SupportsFaultTolerance() const
+{
+#ifdef MPIX_ERR_PROC_FAILED
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Rebuild the communicator without the failed ranks.
+// All surviving ranks must call this after a communication error; afterwards CurrentNodeRank()
+// and NumNodesInUse() reflect the shrunken membership. The host topology is re-derived by the
+// next RequestNodes(); until then hierarchical (cross-host) aggregation must not be used, so we
+// conservatively mark the hosts as non-uniform.
+bool MPIWrapperMpi::TryShrinkAfterFailure()
+{
+#ifdef MPIX_ERR_PROC_FAILED
+    MPIX_Comm_failure_ack(m_currentComm);
+    MPI_Comm shrunken;
+    if (MPIX_Comm_shrink(m_currentComm, &shrunken) != MPI_SUCCESS)
+        return false;
+    if (m_currentComm != MPI_COMM_WORLD && m_currentComm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_currentComm);
+    m_currentComm = shrunken;
+    MPI_Comm_set_errhandler(m_currentComm, MPI_ERRORS_RETURN);
+
+    int newRank = 0, newSize = 0;
+    MPI_Comm_rank(m_currentComm, &newRank);
+    MPI_Comm_size(m_currentComm, &newSize);
+    fprintf(stderr, "TryShrinkAfterFailure: continuing with %d of %d ranks; we are now rank %d (was %d)\n",
+            newSize, (int)m_numNodesInUse, newRank, m_myRank);
+    fflush(stderr);
+
+    m_myRank = newRank;
+    s_myRank = m_myRank;
+    m_numMPINodes = newSize;
+    m_numNodesInUse = (size_t)newSize;
+    m_multiHost = true;
+    m_hostsUniform = false;
+    return true;
+#else
+    return false; // without ULFM there is nothing to shrink; the failure remains fatal
+#endif
+}
+
 bool MPIWrapperMpi::IsMultiHost() const
 {
     return m_multiHost;
 }
 
+size_t MPIWrapperMpi::NumRanksOnHost() const
+{
+    return m_numRanksOnHost;
+}
+
+size_t MPIWrapperMpi::CurrentRankOnHost() const
+{
+    return m_rankOnHost;
+}
+
+size_t MPIWrapperMpi::CurrentHostRootRank() const
+{
+    return m_hostRootRank;
+}
+
+bool MPIWrapperMpi::HostsAreUniform() const
+{
+    return m_hostsUniform;
+}
+
 MPI_Comm MPIWrapperMpi::Communicator() const
 {
     return m_currentComm;
@@ -691,6 +856,12 @@ bool MPIWrapperMpi::UseGpuGdr()
     // Only support GPUDirect RDMA on Unix and built with GDR
 #if defined(USE_CUDA_GDR) && defined(__unix__)
     return true;
+#elif defined(MPIX_CUDA_AWARE_SUPPORT) && defined(__unix__) && !defined(CPUONLY)
+    // Not explicitly built for GDR, but the MPI runtime may still be CUDA-aware (e.g. a
+    // CUDA-enabled OpenMPI): probe it once. If so, device pointers can be handed to MPI
+    // directly and the aggregators skip their pinned-host staging copies.
+    static const bool runtimeIsCudaAware = (MPIX_Query_cuda_support() == 1);
+    return runtimeIsCudaAware;
 #else
     return false;
 #endif
@@ -809,6 +980,16 @@ void MPIWrapperMpi::AllReduce(float* sendData, float* receiveData, size_t numEle
     MPI_Allreduce(sendData, receiveData, (int)numElements, GetDataType(sendData), op, Communicator()) || MpiFail("Allreduce: MPI_Allreduce");
 }
 
+void MPIWrapperMpi::AllReduceAcrossHosts(double* sendData, size_t numElements, MPI_Op op) const
+{
+    MPI_Allreduce(MPI_IN_PLACE, sendData, (int)numElements, GetDataType(sendData), op, m_crossHostComm) || MpiFail("AllReduceAcrossHosts: MPI_Allreduce");
+}
+
+void MPIWrapperMpi::AllReduceAcrossHosts(float* sendData, size_t numElements, MPI_Op op) const
+{
+    MPI_Allreduce(MPI_IN_PLACE, sendData, (int)numElements, GetDataType(sendData), op, m_crossHostComm) || MpiFail("AllReduceAcrossHosts: MPI_Allreduce");
+}
+
 void MPIWrapperMpi::Bcast(size_t* sendData, size_t numElements, size_t srcRank)
 {
     MPI_Bcast(sendData, (int)numElements, GetDataType(sendData), (int)srcRank, Communicator()) || MpiFail("Bcast: MPI_Bcast");
@@ -958,6 +1139,66 @@ void MPIWrapperMpi::Gatherv(const double *sendData, size_t numSendElements, doub
     MPI_Gatherv(sendData, (int)numSendElements, GetDataType(receiveData), receiveData, recvCounts, offsets, GetDataType(receiveData), (int)rootRank, Communicator()) || MpiFail("AllReduceAsync: MPI_Gatherv");
 }
 
+template <typename ElemType>
+void MPIWrapperMpi::AllGatherSparseImpl(const size_t *indices, const ElemType *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<ElemType>& receivedValues) const
+{
+    const size_t numRanks = NumNodesInUse();
+
+    // exchange the per-rank nonzero counts
+    std::vector<int> counts(numRanks, 0);
+    int myCount = (int)numNonZero;
+    MPI_Allgather(&myCount, 1, MPI_INT, counts.data(), 1, MPI_INT, Communicator()) || MpiFail("AllGatherSparse: MPI_Allgather");
+
+    const size_t pairSize = sizeof(size_t) + sizeof(ElemType);
+    std::vector<int> byteCounts(numRanks), byteOffsets(numRanks);
+    recvCounts.resize(numRanks);
+    size_t totalPairs = 0;
+    for (size_t r = 0; r < numRanks; r++)
+    {
+        recvCounts[r] = (size_t)counts[r];
+        byteCounts[r] = counts[r] * (int)pairSize;
+        byteOffsets[r] = (int)(totalPairs * pairSize);
+        totalPairs += (size_t)counts[r];
+    }
+
+    // coalesce our indices and values into one message (indices first, then values), so both
+    // arrays travel in a single variable-length collective; the buffers are grown geometrically
+    // and kept, so steady-state iterations reuse the same registered memory
+    if (m_sparseSendBuffer.size() < numNonZero * pairSize)
+        m_sparseSendBuffer.resize(std::max(numNonZero * pairSize, m_sparseSendBuffer.size() * 2));
+    if (m_sparseRecvBuffer.size() < totalPairs * pairSize)
+        m_sparseRecvBuffer.resize(std::max(totalPairs * pairSize, m_sparseRecvBuffer.size() * 2));
+
+    memcpy(m_sparseSendBuffer.data(), indices, numNonZero * sizeof(size_t));
+    memcpy(m_sparseSendBuffer.data() + numNonZero * sizeof(size_t), values, numNonZero * sizeof(ElemType));
+
+    MPI_Allgatherv(m_sparseSendBuffer.data(), (int)(numNonZero * pairSize), MPI_CHAR,
+                   m_sparseRecvBuffer.data(), byteCounts.data(), byteOffsets.data(), MPI_CHAR,
+                   Communicator()) || MpiFail("AllGatherSparse: MPI_Allgatherv");
+
+    // unpack the concatenated per-rank blocks
+    receivedIndices.resize(totalPairs);
+    receivedValues.resize(totalPairs);
+    size_t written = 0;
+    for (size_t r = 0; r < numRanks; r++)
+    {
+        const char *block = m_sparseRecvBuffer.data() + byteOffsets[r];
+        memcpy(receivedIndices.data() + written, block, recvCounts[r] * sizeof(size_t));
+        memcpy(receivedValues.data() + written, block + recvCounts[r] * sizeof(size_t), recvCounts[r] * sizeof(ElemType));
+        written += recvCounts[r];
+    }
+}
+
+void MPIWrapperMpi::AllGatherSparse(const size_t *indices, const float *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<float>& receivedValues) const
+{
+    AllGatherSparseImpl(indices, values, numNonZero, recvCounts, receivedIndices, receivedValues);
+}
+
+void MPIWrapperMpi::AllGatherSparse(const size_t *indices, const double *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<double>& receivedValues) const
+{
+    AllGatherSparseImpl(indices, values, numNonZero, recvCounts, receivedIndices, receivedValues);
+}
+
 // wait for an async request to finish
 void MPIWrapperMpi::Wait(MPI_Request* request)
 {
@@ -1002,6 +1243,26 @@ bool MPIWrapperEmpty::IsMultiHost() const
     return false;
 }
 
+size_t MPIWrapperEmpty::NumRanksOnHost() const
+{
+    return 1;
+}
+
+size_t MPIWrapperEmpty::CurrentRankOnHost() const
+{
+    return 0;
+}
+
+size_t MPIWrapperEmpty::CurrentHostRootRank() const
+{
+    return 0;
+}
+
+bool MPIWrapperEmpty::HostsAreUniform() const
+{
+    return true;
+}
+
 bool MPIWrapperEmpty::UseGpuGdr()
 {
     return false;
@@ -1159,6 +1420,14 @@ void MPIWrapperEmpty::AllReduce(float* sendData, float* receiveData, size_t numE
 {
 }
 
+void MPIWrapperEmpty::AllReduceAcrossHosts(double* sendData, size_t numElements, MPI_Op op) const
+{
+}
+
+void MPIWrapperEmpty::AllReduceAcrossHosts(float* sendData, size_t numElements, MPI_Op op) const
+{
+}
+
 void MPIWrapperEmpty::AllReduceAsync(size_t* sendData, size_t numElements, MPI_Request* request, MPI_Op op) const
 {
 }
@@ -1277,6 +1546,21 @@ void MPIWrapperEmpty::Gatherv(const double *sendData, size_t numSendElements, do
 {
 }
 
+// With a single rank the gathered result is just our own contribution.
+void MPIWrapperEmpty::AllGatherSparse(const size_t *indices, const float *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<float>& receivedValues) const
+{
+    recvCounts.assign(1, numNonZero);
+    receivedIndices.assign(indices, indices + numNonZero);
+    receivedValues.assign(values, values + numNonZero);
+}
+
+void MPIWrapperEmpty::AllGatherSparse(const size_t *indices, const double *values, size_t numNonZero, std::vector<size_t>& recvCounts, std::vector<size_t>& receivedIndices, std::vector<double>& receivedValues) const
+{
+    recvCounts.assign(1, numNonZero);
+    receivedIndices.assign(indices, indices + numNonZero);
+    receivedValues.assign(values, values + numNonZero);
+}
+
 
 void MPIWrapperEmpty::Wait(MPI_Request* request)
 {
@@ -1,5 +1,9 @@
 #include "TimerUtility.h"
+#include "ProgressTracing.h"
 #include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
 using namespace std::chrono;
 
 namespace Microsoft { namespace MSR { namespace CNTK {
@@ -61,4 +65,115 @@ long long Clock::GetTicksPerSecond()
     return TickPeriod::den / TickPeriod::num;
 }
 
+// ===================================================================
+// CycleClock
+// ===================================================================
+
+// measure the TSC against the wall clock over a short busy interval
+static double CalibrateSecondsPerTick()
+{
+#ifdef CNTK_HAS_RDTSC
+    const auto wallBegin = high_resolution_clock::now();
+    const long long tscBegin = CycleClock::GetTimeStamp();
+    // 20 ms is plenty for 4-digit accuracy and only paid once, at the first report
+    std::this_thread::sleep_for(milliseconds(20));
+    const long long tscEnd = CycleClock::GetTimeStamp();
+    const auto wallEnd = high_resolution_clock::now();
+    const double seconds = duration_cast<nanoseconds>(wallEnd - wallBegin).count() / 1e9;
+    if (tscEnd > tscBegin && seconds > 0)
+        return seconds / (double) (tscEnd - tscBegin);
+    // a TSC that does not advance (ancient hardware, odd virtualization): pretend it is the wall clock
+    return 1.0 / (double) Clock::GetTicksPerSecond();
+#else
+    return 1.0 / (double) Clock::GetTicksPerSecond(); // GetTimeStamp() falls back to Clock as well
+#endif
+}
+
+double CycleClock::SecondsPerTick()
+{
+    static double secondsPerTick = CalibrateSecondsPerTick(); // calibrated once, thread-safely
+    return secondsPerTick;
+}
+
+// ===================================================================
+// CycleCounters
+// ===================================================================
+
+// per-thread accumulation buffer; registered globally so Report() can sum them,
+// flushed into the retired totals when the thread exits
+struct CycleCounterBuffer
+{
+    long long ticks[CycleCounters::c_maxCounters];
+    long long count[CycleCounters::c_maxCounters];
+
+    CycleCounterBuffer();
+    ~CycleCounterBuffer();
+};
+
+static std::mutex s_cycleCountersMutex;                 // guards everything below
+static std::vector<std::string> s_cycleCounterNames;
+static std::vector<CycleCounterBuffer*> s_cycleCounterBuffers; // buffers of live threads
+static long long s_retiredTicks[CycleCounters::c_maxCounters] = {0}; // totals of exited threads
+static long long s_retiredCount[CycleCounters::c_maxCounters] = {0};
+
+CycleCounterBuffer::CycleCounterBuffer()
+{
+    memset(ticks, 0, sizeof(ticks));
+    memset(count, 0, sizeof(count));
+    std::lock_guard<std::mutex> lock(s_cycleCountersMutex);
+    s_cycleCounterBuffers.push_back(this);
+}
+
+CycleCounterBuffer::~CycleCounterBuffer()
+{
+    std::lock_guard<std::mutex> lock(s_cycleCountersMutex);
+    for (size_t id = 0; id < CycleCounters::c_maxCounters; id++)
+    {
+        s_retiredTicks[id] += ticks[id];
+        s_retiredCount[id] += count[id];
+    }
+    auto iter = std::find(s_cycleCounterBuffers.begin(), s_cycleCounterBuffers.end(), this);
+    if (iter != s_cycleCounterBuffers.end())
+        s_cycleCounterBuffers.erase(iter);
+}
+
+/*static*/ size_t CycleCounters::Register(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(s_cycleCountersMutex);
+    for (size_t id = 0; id < s_cycleCounterNames.size(); id++)
+        if (s_cycleCounterNames[id] == name)
+            return id;
+    if (s_cycleCounterNames.size() >= c_maxCounters)
+        RuntimeError("CycleCounters: exceeded the maximum of %d named counters", (int) c_maxCounters);
+    s_cycleCounterNames.push_back(name);
+    return s_cycleCounterNames.size() - 1;
+}
+
+/*static*/ void CycleCounters::Add(size_t id, long long ticks)
+{
+    static thread_local CycleCounterBuffer buffer; // created on this thread's first Add()
+    buffer.ticks[id] += ticks;
+    buffer.count[id]++;
+}
+
+/*static*/ void CycleCounters::Report()
+{
+    const double secondsPerTick = CycleClock::SecondsPerTick(); // (calibrate outside the lock)
+    std::lock_guard<std::mutex> lock(s_cycleCountersMutex);
+    for (size_t id = 0; id < s_cycleCounterNames.size(); id++)
+    {
+        long long totalTicks = s_retiredTicks[id];
+        long long totalCount = s_retiredCount[id];
+        for (const auto* buffer : s_cycleCounterBuffers) // live threads: racy snapshot, good enough for reporting
+        {
+            totalTicks += buffer->ticks[id];
+            totalCount += buffer->count[id];
+        }
+        if (totalCount == 0)
+            continue;
+        LOGPRINTF(stderr, "CycleCounters: %s: %.6fs over %lld hits\n",
+                  s_cycleCounterNames[id].c_str(), totalTicks * secondsPerTick, totalCount);
+    }
+}
+
 }}}
@@ -27,12 +27,20 @@
 #include <glob.h>
 #include <dirent.h>
 #include <sys/sendfile.h>
+#include <sys/mman.h> // for MemoryMappedTextFile
+#include <fcntl.h>    // for posix_fadvise()
 #endif
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdint.h>
 #include <assert.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #ifdef _WIN32
 #define NOMINMAX
 #include "Windows.h" // for FILETIME
@@ -262,6 +270,8 @@ FILE* fopenOrDie(const string& pathname, const char* mode)
     {
         // If optimized for sequential access, then use large buffer. OK if it fails
         setvbuf(f, NULL, _IOFBF, LARGE_BUF_SIZE);
+        if (strchr(mode, 'r') != nullptr && strchr(mode, '+') == nullptr) // streaming read: also hint the OS readahead
+            fadviseSequentialRead(f);
     }
     return f;
 }
@@ -277,6 +287,8 @@ FILE* fopenOrDie(const wstring& pathname, const wchar_t* mode)
     {
         // If optimized for sequential access, then use large buffer. OK if it fails
         setvbuf(f, NULL, _IOFBF, LARGE_BUF_SIZE);
+        if (strchr(mode, 'r') != nullptr && strchr(mode, '+') == nullptr) // streaming read: also hint the OS readahead
+            fadviseSequentialRead(f);
     }
     return f;
 }
@@ -309,6 +321,8 @@ void fsetmode(FILE* f, char type)
 
 void freadOrDie(void* ptr, size_t size, size_t count, FILE* f)
 {
+    fdrainWriteBehind(f); // in case the caller reads back what it just queued
+
     size_t limit = max(READ_SIZE_LIMIT / size, (size_t)1);  // Normalize by size, as fread() expects units, not bytes
 
     // \\XXX\C$ reads are limited, with some randomness (e.g. 48 MB), on Windows 7 32 bit, so we break this into chunks of some MB. Meh.
@@ -346,7 +360,7 @@ void freadOrDie(void* ptr, size_t size, size_t count, const HANDLE f)
 // with Invalid Argument error), so we break it into chunks (yak!!)
 // ----------------------------------------------------------------------------
 
-void fwriteOrDie(const void* ptr, size_t size, size_t count, FILE* f)
+static void fwriteSyncOrDie(const void* ptr, size_t size, size_t count, FILE* f)
 {
     const char* p1 = (const char*) ptr;
     size_t totalBytes = size * count;
@@ -370,6 +384,173 @@ void fwriteOrDie(const void* ptr, size_t size, size_t count, FILE* f)
     }
 }
 
+// ----------------------------------------------------------------------------
+// write-behind: fenableWriteBehind() registers a stream with a background
+// writer thread. Subsequent fwriteOrDie() calls only copy the data into a
+// chunk buffer; the actual fwrite() happens on the worker, so storage latency
+// stays out of the caller's loop (e.g. checkpointing while training goes on).
+// The drain points (fflushOrDie(), fseekOrDie(), fget/setpos(), freadOrDie(),
+// fdisableWriteBehind()) wait for the queue and rethrow any write error.
+// ----------------------------------------------------------------------------
+
+struct WriteBehindStream
+{
+    FILE* f = nullptr;
+    std::thread worker;
+    std::mutex mutex;                        // guards everything below
+    std::condition_variable workPending;     // signalled when a chunk is queued or shutdown is requested
+    std::condition_variable workDrained;     // signalled when the worker runs out of chunks
+    std::deque<std::vector<char>> queue;     // chunks waiting to be written, in order
+    std::vector<std::vector<char>> recycled; // emptied chunks for reuse, so steady state does not allocate
+    std::vector<char> current;               // chunk currently being filled by the producer
+    bool busy = false;                       // worker is writing a chunk right now
+    bool shutdown = false;
+    std::string error; // first write error, rethrown at the next drain point
+};
+
+static const size_t writeBehindChunkSize = 1024 * 1024;
+
+static std::mutex s_writeBehindMutex; // guards s_writeBehindStreams
+static std::unordered_map<FILE*, std::unique_ptr<WriteBehindStream>> s_writeBehindStreams;
+static std::atomic<long> s_writeBehindCount(0); // fast path: skip the map lookup entirely while no stream is registered
+
+static WriteBehindStream* TryGetWriteBehind(FILE* f)
+{
+    if (s_writeBehindCount.load(std::memory_order_acquire) == 0)
+        return nullptr;
+    std::lock_guard<std::mutex> lock(s_writeBehindMutex);
+    auto iter = s_writeBehindStreams.find(f);
+    return iter == s_writeBehindStreams.end() ? nullptr : iter->second.get();
+}
+
+static void WriteBehindWorker(WriteBehindStream* stream)
+{
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    for (;;)
+    {
+        stream->workPending.wait(lock, [=] { return !stream->queue.empty() || stream->shutdown; });
+        if (stream->queue.empty()) // shutdown and nothing left to write
+            return;
+        std::vector<char> chunk = std::move(stream->queue.front());
+        stream->queue.pop_front();
+        stream->busy = true;
+        bool failed = !stream->error.empty();
+        lock.unlock();
+        if (!failed) // after a failure, just drop the data so the drain point can report the error
+        {
+            try
+            {
+                fwriteSyncOrDie(chunk.data(), 1, chunk.size(), stream->f);
+            }
+            catch (const std::exception& e)
+            {
+                lock.lock();
+                stream->error = e.what();
+                lock.unlock();
+            }
+        }
+        chunk.clear();
+        lock.lock();
+        stream->recycled.push_back(std::move(chunk));
+        stream->busy = false;
+        if (stream->queue.empty())
+            stream->workDrained.notify_all();
+    }
+}
+
+// hand the chunk being filled over to the worker; caller must hold stream->mutex
+static void FlushCurrentWriteBehindChunk(WriteBehindStream* stream)
+{
+    if (stream->current.empty())
+        return;
+    stream->queue.push_back(std::move(stream->current));
+    if (!stream->recycled.empty())
+    {
+        stream->current = std::move(stream->recycled.back());
+        stream->recycled.pop_back();
+    }
+    else
+    {
+        stream->current = std::vector<char>();
+        stream->current.reserve(writeBehindChunkSize);
+    }
+    stream->workPending.notify_one();
+}
+
+void fenableWriteBehind(FILE* f)
+{
+    std::lock_guard<std::mutex> lock(s_writeBehindMutex);
+    if (s_writeBehindStreams.find(f) != s_writeBehindStreams.end()) // already enabled
+        return;
+    std::unique_ptr<WriteBehindStream> stream(new WriteBehindStream());
+    stream->f = f;
+    stream->current.reserve(writeBehindChunkSize);
+    stream->worker = std::thread(WriteBehindWorker, stream.get());
+    s_writeBehindStreams[f] = std::move(stream);
+    s_writeBehindCount.fetch_add(1, std::memory_order_release);
+}
+
+void fdrainWriteBehind(FILE* f)
+{
+    WriteBehindStream* stream = TryGetWriteBehind(f);
+    if (stream == nullptr)
+        return;
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    FlushCurrentWriteBehindChunk(stream);
+    stream->workDrained.wait(lock, [=] { return stream->queue.empty() && !stream->busy; });
+    if (!stream->error.empty()) // keep the failed state, so later drains throw as well
+    {
+        std::string error = stream->error;
+        lock.unlock();
+        RuntimeError("write-behind failed: %s", error.c_str());
+    }
+}
+
+void fdisableWriteBehind(FILE* f)
+{
+    std::unique_ptr<WriteBehindStream> stream;
+    {
+        std::lock_guard<std::mutex> lock(s_writeBehindMutex);
+        auto iter = s_writeBehindStreams.find(f);
+        if (iter == s_writeBehindStreams.end()) // not enabled
+            return;
+        stream = std::move(iter->second);
+        s_writeBehindStreams.erase(iter);
+        s_writeBehindCount.fetch_sub(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        FlushCurrentWriteBehindChunk(stream.get());
+        stream->shutdown = true;
+        stream->workPending.notify_one();
+    }
+    stream->worker.join();
+    if (!stream->error.empty())
+        RuntimeError("write-behind failed: %s", stream->error.c_str());
+}
+
+void fwriteOrDie(const void* ptr, size_t size, size_t count, FILE* f)
+{
+    WriteBehindStream* stream = TryGetWriteBehind(f);
+    if (stream != nullptr) // write-behind: only copy into the current chunk
+    {
+        const char* p1 = (const char*) ptr;
+        size_t totalBytes = size * count;
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        while (totalBytes > 0)
+        {
+            size_t wantCopy = std::min(totalBytes, writeBehindChunkSize - stream->current.size());
+            stream->current.insert(stream->current.end(), p1, p1 + wantCopy);
+            p1 += wantCopy;
+            totalBytes -= wantCopy;
+            if (stream->current.size() >= writeBehindChunkSize)
+                FlushCurrentWriteBehindChunk(stream);
+        }
+        return;
+    }
+    fwriteSyncOrDie(ptr, size, count, f);
+}
+
 #ifdef _WIN32
 void fwriteOrDie(const void* ptr, size_t size, size_t count, const HANDLE f)
 {
@@ -399,6 +580,7 @@ void fwriteOrDie(const void* ptr, size_t size, size_t count, const HANDLE f)
 
 long fseekOrDie(FILE* f, long offset, int mode)
 {
+    fdrainWriteBehind(f); // queued data must land before we move the file position
     long curPos = ftell(f);
     if (curPos == -1L)
     {
@@ -420,6 +602,7 @@ long fseekOrDie(FILE* f, long offset, int mode)
 #pragma warning(disable : 4793) // 'vararg' : causes native code generation
 void fprintfOrDie(FILE* f, const char* fmt, ...)
 {
+    fdrainWriteBehind(f); // text output bypasses the write-behind queue; keep the byte order intact
     va_list arg_ptr;
     va_start(arg_ptr, fmt);
     int rc = vfprintf(f, fmt, arg_ptr);
@@ -463,6 +646,7 @@ void fsyncOrDie(FILE* f)
 
 void fflushOrDie(FILE* f)
 {
+    fdrainWriteBehind(f); // complete queued write-behind data before flushing stdio
     int rc = fflush(f);
     if (rc != 0)
     {
@@ -470,6 +654,25 @@ void fflushOrDie(FILE* f)
     }
 }
 
+// ----------------------------------------------------------------------------
+// fadviseSequentialRead(): advise the OS that 'f' will be read front to back,
+// enlarging the kernel readahead window. Best effort; errors are ignored.
+// ----------------------------------------------------------------------------
+
+void fadviseSequentialRead(FILE* f)
+{
+#ifdef __linux__
+    int fd = fileno(f);
+    if (fd != -1)
+    {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL); // enlarge the readahead window
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);   // and start pulling in the first pages now
+    }
+#else
+    UNUSED(f); // on Windows, the 'S' fopen() mode flag already passes the sequential-scan hint
+#endif
+}
+
 // ----------------------------------------------------------------------------
 // filesize(): determine size of the file in bytes (with open file)
 // ----------------------------------------------------------------------------
@@ -541,6 +744,7 @@ int64_t filesize64(const wchar_t* pathname)
 
 uint64_t fgetpos(FILE* f)
 {
+    fdrainWriteBehind(f); // the position is only meaningful once queued data has landed
 #ifdef _MSC_VER // standard does not allow to cast between fpos_t and integer numbers, and indeed it does not work on Linux (but on Windows and GCC)
     fpos_t post;
     int rc = ::fgetpos(f, &post);
@@ -558,6 +762,7 @@ uint64_t fgetpos(FILE* f)
 
 void fsetpos(FILE* f, uint64_t reqpos)
 {
+    fdrainWriteBehind(f); // queued data must land before we move the file position
 #ifdef _MSC_VER // standard does not allow to cast between fpos_t and integer numbers, and indeed it does not work on Linux (but on Windows and GCC)
 #if (_MSC_VER <= 1800) // Note: this does not trigger if loaded in vs2013 mode in vs2015!
     // Visual Studio's ::fsetpos() flushes the read buffer. This conflicts with a situation where
@@ -934,6 +1139,114 @@ void fgetline(FILE* f, std::vector<wchar_t>& buf)
     buf.resize(wcsnlen(&buf[0], BUF_SIZE) + 1); // SECURITY NOTE: string use has been reviewed
 }
 
+// ----------------------------------------------------------------------------
+// MemoryMappedTextFile: zero-copy line iteration over a memory-mapped file
+// ----------------------------------------------------------------------------
+
+MemoryMappedTextFile::MemoryMappedTextFile(const std::wstring& pathname)
+    : m_data(nullptr), m_size(0), m_pos(0)
+{
+#ifdef _WIN32
+    m_fileHandle = CreateFileW(pathname.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+        RuntimeError("MemoryMappedTextFile: error opening file '%ls': %d", pathname.c_str(), (int) ::GetLastError());
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_fileHandle, &size))
+    {
+        CloseHandle(m_fileHandle);
+        RuntimeError("MemoryMappedTextFile: error determining size of '%ls': %d", pathname.c_str(), (int) ::GetLastError());
+    }
+    m_size = (size_t) size.QuadPart;
+    m_mappingHandle = NULL;
+    if (m_size > 0) // CreateFileMapping() fails for empty files; leave those unmapped
+    {
+        m_mappingHandle = CreateFileMapping(m_fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m_mappingHandle == NULL)
+        {
+            CloseHandle(m_fileHandle);
+            RuntimeError("MemoryMappedTextFile: error mapping '%ls': %d", pathname.c_str(), (int) ::GetLastError());
+        }
+        m_data = (const char*) MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (m_data == nullptr)
+        {
+            CloseHandle(m_mappingHandle);
+            CloseHandle(m_fileHandle);
+            RuntimeError("MemoryMappedTextFile: error mapping view of '%ls': %d", pathname.c_str(), (int) ::GetLastError());
+        }
+    }
+#else
+    const auto pathname8 = msra::strfun::utf8(pathname);
+    m_fd = open(pathname8.c_str(), O_RDONLY);
+    if (m_fd == -1)
+        RuntimeError("MemoryMappedTextFile: error opening file '%s': %s", pathname8.c_str(), strerror(errno));
+    struct stat fileStatus; // 64-bit st_size via _FILE_OFFSET_BITS above
+    if (fstat(m_fd, &fileStatus) == -1)
+    {
+        close(m_fd);
+        RuntimeError("MemoryMappedTextFile: error determining size of '%s': %s", pathname8.c_str(), strerror(errno));
+    }
+    m_size = (size_t) fileStatus.st_size;
+    if (m_size > 0) // mmap() fails for empty files; leave those unmapped
+    {
+        void* p = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (p == MAP_FAILED)
+        {
+            close(m_fd);
+            RuntimeError("MemoryMappedTextFile: error mapping '%s': %s", pathname8.c_str(), strerror(errno));
+        }
+        m_data = (const char*) p;
+        madvise(p, m_size, MADV_SEQUENTIAL); // we scan front to back; enlarge the readahead window
+    }
+#endif
+}
+
+MemoryMappedTextFile::~MemoryMappedTextFile()
+{
+#ifdef _WIN32
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+    if (m_mappingHandle != NULL)
+        CloseHandle(m_mappingHandle);
+    CloseHandle(m_fileHandle);
+#else
+    if (m_data != nullptr)
+        munmap((void*) m_data, m_size);
+    close(m_fd);
+#endif
+}
+
+// get the next line as a span into the mapped pages; false once the end is reached
+// Handles LF, CR+LF, and lone-CR line endings like fgetline(), including a last line without newline.
+bool MemoryMappedTextFile::GetLine(LineSpan& line)
+{
+    if (m_pos >= m_size)
+        return false;
+    const char* begin = m_data + m_pos;
+    const size_t remaining = m_size - m_pos;
+    // memchr() is the vectorized scan; CR-only files fall back to a plain loop below
+    const char* lf = (const char*) memchr(begin, '\n', remaining);
+    const char* end = lf != nullptr ? lf : begin + remaining;
+    if (lf == nullptr) // no LF: check for an old-Mac CR terminator inside this tail
+    {
+        const char* cr = (const char*) memchr(begin, '\r', remaining);
+        if (cr != nullptr)
+            end = cr;
+    }
+    else if (end > begin && end[-1] == '\r') // Windows style: strip the CR before the LF
+        end--;
+    line.data = begin;
+    line.size = (size_t) (end - begin);
+    // advance past the terminator (none if the file ends without one)
+    size_t next = (size_t) (end - m_data);
+    if (next < m_size && m_data[next] == '\r')
+        next++;
+    if (next < m_size && m_data[next] == '\n')
+        next++;
+    m_pos = next;
+    return true;
+}
+
 // read a 0-terminated string
 const char* fgetstring(FILE* f, __out_z_cap(size) char* buf, int size)
 {
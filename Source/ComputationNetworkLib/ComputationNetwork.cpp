@@ -47,6 +47,32 @@ vector<MemRequestInfo<double>>& MatrixPool::GetMemRequestInfoVec<double>()
     return m_memRequestInfoDoubleVec;
 }
 
+template <>
+vector<shared_ptr<Matrix<float>>>& MatrixPool::GetPooledMatrixVec<float>()
+{
+    return m_pooledMatricesFloat;
+}
+
+template <>
+vector<shared_ptr<Matrix<double>>>& MatrixPool::GetPooledMatrixVec<double>()
+{
+    return m_pooledMatricesDouble;
+}
+
+template <>
+vector<pair<shared_ptr<Matrix<float>>*, shared_ptr<Matrix<float>>*>>& MatrixPool::GetAliasInfoVec<float>()
+{
+    return m_aliasInfoFloatVec;
+}
+
+template <>
+vector<pair<shared_ptr<Matrix<double>>*, shared_ptr<Matrix<double>>*>>& MatrixPool::GetAliasInfoVec<double>()
+{
+    return m_aliasInfoDoubleVec;
+}
+
+const char* MatrixPool::c_memoryAttributionGroup = "Matrix Pool Requests By Node";
+
 // -----------------------------------------------------------------------
 // construction
 // -----------------------------------------------------------------------
@@ -214,6 +240,134 @@ size_t ComputationNetwork::GetModelVersion(File& fstream)
     return modelVersion;
 }
 
+// -----------------------------------------------------------------------
+// persistent compilation cache
+// A '<modelPath>.compiled' file stores the traversal orders that CompileNetwork() derives,
+// together with a content hash of the model file. Loading an unchanged model then restores
+// the orders by node-name lookup instead of re-running the depth-first analyses, which is
+// the point of Globals::ShouldCacheCompiledNetwork(): fast warm starts for serving processes.
+// The cache is advisory: any mismatch (stale hash, unknown node name, unreadable file) makes
+// the load fall back to full analysis and rewrite the cache.
+// -----------------------------------------------------------------------
+
+static const size_t COMPILATION_CACHE_VERSION = 1;
+
+// FNV-1a over the model file's bytes; cheap relative to deserializing the same bytes,
+// and the file is typically still in the OS file cache when this runs right after Read().
+uint64_t ComputationNetwork::ComputeModelContentHash(const wstring& fileName)
+{
+    auto_file_ptr f(fopenOrDie(fileName, L"rb"));
+    uint64_t hash = 14695981039346656037ull;
+    char buffer[65536];
+    size_t numRead;
+    while ((numRead = fread(buffer, 1, sizeof(buffer), f)) != 0)
+        for (size_t i = 0; i < numRead; i++)
+            hash = (hash ^ (unsigned char) buffer[i]) * 1099511628211ull;
+    if (ferror(f))
+        RuntimeError("ComputeModelContentHash: error reading file '%ls'", fileName.c_str());
+    return hash;
+}
+
+bool ComputationNetwork::TryLoadCompilationArtifacts(const wstring& cacheFileName, const wstring& modelFileName)
+{
+    m_precompiledEvalOrders.clear();
+    if (!fexists(cacheFileName.c_str()))
+        return false;
+    try
+    {
+        File fstream(cacheFileName, FileOptions::fileOptionsBinary | FileOptions::fileOptionsRead);
+        fstream.GetMarker(FileMarker::fileMarkerBeginSection, L"BCNCompiled");
+        size_t version, modelHash;
+        fstream >> version;
+        if (version != COMPILATION_CACHE_VERSION)
+            RuntimeError("TryLoadCompilationArtifacts: unexpected cache version %d", (int) version);
+        fstream >> modelHash;
+        if ((uint64_t) modelHash != ComputeModelContentHash(modelFileName))
+        {
+            fprintf(stderr, "TryLoadCompilationArtifacts: model file '%ls' has changed; ignoring stale compilation cache.\n", modelFileName.c_str());
+            return false;
+        }
+        size_t numOrders;
+        fstream >> numOrders;
+        for (size_t i = 0; i < numOrders; i++)
+        {
+            wstring rootName;
+            size_t numNodes;
+            fstream >> rootName >> numNodes;
+            auto& order = m_precompiledEvalOrders[rootName];
+            order.resize(numNodes);
+            for (size_t n = 0; n < numNodes; n++)
+                fstream >> order[n];
+        }
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"ECNCompiled");
+    }
+    catch (const exception& e)
+    {
+        fprintf(stderr, "WARNING: failed to read compilation cache '%ls' (%s); falling back to full analysis.\n", cacheFileName.c_str(), e.what());
+        m_precompiledEvalOrders.clear();
+        return false;
+    }
+    return true;
+}
+
+void ComputationNetwork::SaveCompilationArtifacts(const wstring& cacheFileName, const wstring& modelFileName) const
+{
+    VerifyIsCompiled("SaveCompilationArtifacts");
+    try
+    {
+        // write to a temporary file and rename, same as Save(), so a dying process cannot leave a torn cache
+        wstring tmpFileName = cacheFileName + L".tmp";
+        {
+            File fstream(tmpFileName, FileOptions::fileOptionsBinary | FileOptions::fileOptionsWrite);
+            fstream.Setvbuf();
+            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BCNCompiled");
+            fstream << COMPILATION_CACHE_VERSION;
+            fstream << (size_t) ComputeModelContentHash(modelFileName);
+            fstream << m_evalOrders.size();
+            for (const auto& iter : m_evalOrders)
+            {
+                fstream << (iter.first ? iter.first->NodeName() : wstring(L"")); // L"" = global order
+                fstream << iter.second.size();
+                for (const auto& node : iter.second)
+                    fstream << node->NodeName();
+            }
+            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ECNCompiled");
+            fstream.Flush();
+        }
+        renameOrDie(tmpFileName, cacheFileName);
+    }
+    catch (const exception& e) // e.g. model directory not writable: not fatal, just no warm start next time
+    {
+        fprintf(stderr, "WARNING: failed to write compilation cache '%ls' (%s).\n", cacheFileName.c_str(), e.what());
+    }
+}
+
+// resolve a cached traversal order (by node names) against the current node set
+// Returns false if no cache entry exists for this root. An unresolvable node name means the
+// node set differs from when the cache was written (e.g. constant folding rewrote the graph
+// after the orders were formed), in which case the whole cache is dropped.
+bool ComputationNetwork::TryGetPrecompiledEvalOrder(const ComputationNodeBasePtr& rootNode, list<ComputationNodeBasePtr>& evalOrder)
+{
+    if (m_precompiledEvalOrders.empty())
+        return false;
+    auto iter = m_precompiledEvalOrders.find(rootNode ? rootNode->NodeName() : L"");
+    if (iter == m_precompiledEvalOrders.end())
+        return false;
+    for (const auto& nodeName : iter->second)
+    {
+        auto nodeIter = m_nameToNodeMap.find(nodeName);
+        if (nodeIter == m_nameToNodeMap.end())
+        {
+            fprintf(stderr, "WARNING: compilation cache refers to unknown node '%ls'; re-deriving traversal orders.\n", nodeName.c_str());
+            m_precompiledEvalOrders.clear();
+            evalOrder.clear();
+            return false;
+        }
+        evalOrder.push_back(nodeIter->second);
+    }
+    return true;
+}
+
 // load the section of nodes that contain persistable parameters
 // This is also used for reloading a model without recreating it, e.g. during training.
 // TODO: Why not just reload it? Because SGD::Train() holds pointers to the parameters directly? That should be fixed.
@@ -625,7 +779,8 @@ void ComputationNetwork::SetSeqParam(ComputationNetworkPtr net,
                                      const double& lmf /*= 14.0f*/,
                                      const double& wp /*= 0.0f*/,
                                      const double& bMMIfactor /*= 0.0f*/,
-                                     const bool& sMBR /*= false*/
+                                     const bool& sMBR /*= false*/,
+                                     const size_t& numLatticeDevices /*= 1*/
                                      )
 {
     fprintf(stderr, "Setting Hsmoothing weight to %.8g and frame-dropping threshhold to %.8g\n", hsmoothingWeight, frameDropThresh);
@@ -644,7 +799,7 @@ void ComputationNetwork::SetSeqParam(ComputationNetworkPtr net,
             node->SetSmoothWeight(hsmoothingWeight);
             node->SetFrameDropThresh(frameDropThresh);
             node->SetReferenceAlign(doreferencealign);
-            node->SetGammarCalculationParam(amf, lmf, wp, bMMIfactor, sMBR);
+            node->SetGammarCalculationParam(amf, lmf, wp, bMMIfactor, sMBR, numLatticeDevices);
         }
     }
 }
@@ -1528,7 +1683,7 @@ template /*static*/ void ComputationNetwork::SetDropoutRate<float>(ComputationNe
 template /*static*/ void ComputationNetwork::SetIRngUserSeed<float>(ComputationNetworkPtr net, const ComputationNodeBasePtr& criterionNode, size_t randSeedBase);
 template /*static*/ void ComputationNetwork::SetBatchNormalizationTimeConstants<float>(ComputationNetworkPtr net, const ComputationNodeBasePtr& criterionNode, const double normalizationTimeConstant, double& prevNormalizationTimeConstant, double blendTimeConstant, double& prevBlendTimeConstant);
 template void ComputationNetwork::SetSeqParam<float>(ComputationNetworkPtr net, const ComputationNodeBasePtr criterionNode, const double& hsmoothingWeight, const double& frameDropThresh, const bool& doreferencealign,
-                                                     const double& amf, const double& lmf, const double& wp, const double& bMMIfactor, const bool& sMBR);
+                                                     const double& amf, const double& lmf, const double& wp, const double& bMMIfactor, const bool& sMBR, const size_t& numLatticeDevices);
 template void ComputationNetwork::SaveToDbnFile<float>(ComputationNetworkPtr net, const std::wstring& fileName) const;
 
 template void ComputationNetwork::InitLearnableParametersWithBilinearFill<double>(const ComputationNodeBasePtr& node, size_t kernelWidth, size_t kernelHeight);
@@ -1539,7 +1694,7 @@ template /*static*/ void ComputationNetwork::SetDropoutRate<double>(ComputationN
 template /*static*/ void ComputationNetwork::SetIRngUserSeed<double>(ComputationNetworkPtr net, const ComputationNodeBasePtr& criterionNode, size_t randSeedBase);
 template /*static*/ void ComputationNetwork::SetBatchNormalizationTimeConstants<double>(ComputationNetworkPtr net, const ComputationNodeBasePtr& criterionNode, const double normalizationTimeConstant, double& prevNormalizationTimeConstant, double blendTimeConstant, double& prevBlendTimeConstant);
 template void ComputationNetwork::SetSeqParam<double>(ComputationNetworkPtr net, const ComputationNodeBasePtr criterionNode, const double& hsmoothingWeight, const double& frameDropThresh, const bool& doreferencealign,
-                                                      const double& amf, const double& lmf, const double& wp, const double& bMMIfactor, const bool& sMBR);
+                                                      const double& amf, const double& lmf, const double& wp, const double& bMMIfactor, const bool& sMBR, const size_t& numLatticeDevices);
 template void ComputationNetwork::SaveToDbnFile<double>(ComputationNetworkPtr net, const std::wstring& fileName) const;
 
 // register ComputationNetwork with the ScriptableObject system
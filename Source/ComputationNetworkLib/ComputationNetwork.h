@@ -105,7 +105,14 @@ public:
     {
         Read<ElemType>(fileName);
         // perform all further post-processing, caching, etc.
+        // Optionally warm-start from a '<fileName>.compiled' cache left by a previous load of the
+        // same (byte-identical) model, so CompileNetwork() can skip re-deriving traversal orders.
+        if (Globals::ShouldCacheCompiledNetwork())
+            TryLoadCompilationArtifacts(fileName + L".compiled", fileName);
         CompileNetwork();
+        if (Globals::ShouldCacheCompiledNetwork() && m_precompiledEvalOrders.empty()) // no usable cache: write one for the next load
+            SaveCompilationArtifacts(fileName + L".compiled", fileName);
+        m_precompiledEvalOrders.clear();
     }
 
     // static helper to instantiate a network from a file
@@ -123,9 +130,15 @@ public:
 private:
 
     void SaveToFileImpl(const std::wstring& fileName, const FileOptions fileFormat) const;
-    
+
     static size_t GetModelVersion(File& fstream);
 
+    // persistent compilation cache, cf. Globals::ShouldCacheCompiledNetwork()
+    bool TryLoadCompilationArtifacts(const std::wstring& cacheFileName, const std::wstring& modelFileName);
+    void SaveCompilationArtifacts(const std::wstring& cacheFileName, const std::wstring& modelFileName) const;
+    bool TryGetPrecompiledEvalOrder(const ComputationNodeBasePtr& rootNode, std::list<ComputationNodeBasePtr>& evalOrder);
+    static uint64_t ComputeModelContentHash(const std::wstring& fileName);
+
 public:
 
     // -----------------------------------------------------------------------
@@ -141,6 +154,13 @@ public:
     // main entry point for backprop
     void Backprop(const ComputationNodeBasePtr rootNode);
 
+    // Installs a callback that Backprop() fires for each node right after the node's own
+    // gradient has received its last contribution. All consumers of a node lie later in the
+    // evaluation order, so the backward sweep reaches the node itself only once its gradient
+    // is final. SGD uses this to start exchanging finished parameter gradients across workers
+    // while the remainder of the backward pass is still running. Pass nullptr to uninstall.
+    void SetNodeGradientCompleteCallback(std::function<void(const ComputationNodeBasePtr&)> callback) { m_nodeGradientCompleteCallback = std::move(callback); }
+
     template <class NODESET> // version that takes multiple nodes
     void TravserseInSortedGlobalEvalOrder(const NODESET& nodes, const std::function<void(const ComputationNodeBasePtr&)>& action)
     {
@@ -258,6 +278,18 @@ private:
 public:
     void AllocateAllMatrices(const std::vector<ComputationNodeBasePtr>& evalRootNodes, const std::vector<ComputationNodeBasePtr>& outValueRootNodes, ComputationNodeBasePtr trainRootNode);
 
+    // observability and control over the shared-matrix pool, cf. MatrixPool.h
+    MatrixPoolStats GetMatrixPoolStats() const { return m_matrixPool.GetStats(); }
+    void TrimMatrixPoolMemory() { m_matrixPool.TrimPooledMemory(); }
+
+    // gradient checkpointing (activation recomputation): the named nodes cut the network into
+    // segments whose interior values are dropped after the forward pass and recomputed during
+    // backprop, cf. PlanGradientCheckpointing()
+    void SetGradientCheckpointNodes(const std::vector<std::wstring>& nodeNames)
+    {
+        m_gradientCheckpointNodeNames = std::set<std::wstring>(nodeNames.begin(), nodeNames.end());
+    }
+
     // From the set of nodes extract all nodes which are used as accumulator nodes.
     std::set<ComputationNodeBasePtr> ExtractNodesWhichAccumulateResult(std::set<ComputationNodeBasePtr> nodes);
 
@@ -265,6 +297,9 @@ private:
     void PrintMemorySharingStructure(const std::vector<ComputationNodeBasePtr>& nodes);
     void ReleaseMatricesAfterEvalForChildren(ComputationNodeBasePtr n, std::unordered_map<ComputationNodeBasePtr, std::unordered_set<ComputationNodeBasePtr>>& parentsMap);
     void AllocateGradientMatricesForInputs(ComputationNodeBasePtr parentNode);
+    void PlanGradientCheckpointing(const ComputationNodeBasePtr& trainRootNode,
+                                   std::unordered_map<ComputationNodeBasePtr, bool>& outputValueNeededDuringBackProp,
+                                   const std::unordered_map<ComputationNodeBasePtr, std::unordered_set<ComputationNodeBasePtr>>& parentsMap);
 
 public:
     // -----------------------------------------------------------------------
@@ -284,6 +319,7 @@ private:
     void DetermineLoopForwardOrderR(std::unordered_set<ComputationNodeBasePtr>& visited, std::unordered_set<ComputationNodeBasePtr>& recStack, std::list<ComputationNodeBasePtr>& nodesStack, ComputationNodeBasePtr cur);
     void GatherLoopNodesR(const ComputationNodeBasePtr& rootNode, std::unordered_set<ComputationNodeBasePtr>& visited, std::map<int, std::list<ComputationNodeBasePtr>>& recurrentResult, std::list<ComputationNodeBasePtr>& noRecurrentResult);
     void ReorderLoops(std::list<ComputationNodeBasePtr>& nodes, const std::map<int, std::list<ComputationNodeBasePtr>>& /*recurrentNodes*/, const std::list<ComputationNodeBasePtr>& /*noRecurrentNodes*/);
+    void VerifyLoopMinimality() const;
 
 public:
     // -----------------------------------------------------------------------
@@ -305,7 +341,11 @@ public:
         }
 
         std::list<ComputationNodeBasePtr> evalOrder;
-        if (!rootNode) // this creates the global one
+        if (TryGetPrecompiledEvalOrder(rootNode, evalOrder))
+        {
+            // restored from the on-disk compilation cache; nothing to derive
+        }
+        else if (!rootNode) // this creates the global one
         {
             evalOrder = ComputationNodeBase::EnumerateNodes(m_allRoots);
         }
@@ -467,6 +507,12 @@ public:
     void ReplaceNode(wstring nodeName, ComputationNodeBasePtr newNode);
     void InsertNode(wstring nodeName, ComputationNodeBasePtr newNode, const std::set<std::wstring>& newNodeTags);
     void ReplaceLeafNode(wstring oldNodeName, ComputationNodeBasePtr newNode);
+    size_t FuseElementwiseChains();
+    size_t FuseConvolutionBiasActivation();
+    size_t FoldConstantSubexpressions();
+    size_t AbsorbTransposesIntoTimes();
+    void AssignNodesToDevice(const std::vector<std::wstring>& nodeNames, DEVICEID_TYPE deviceId);
+    size_t InsertPipelineTransferNodes();
     void ReplaceFinalCriterionNode(wstring oldNodeName, ComputationNodeBasePtr newNode);
     void AddFeatureNode(ComputationNodeBasePtr featureNode);
     //ComputationNodeBasePtr RemoveFeatureNode(ComputationNodeBasePtr featureNode);
@@ -553,7 +599,8 @@ public:
                             const double& lmf = 14.0f,
                             const double& wp = 0.0f,
                             const double& bMMIfactor = 0.0f,
-                            const bool& sMBR = false);
+                            const bool& sMBR = false,
+                            const size_t& numLatticeDevices = 1);
     static void SetMaxTempMemSizeForCNN(ComputationNetworkPtr net, const ComputationNodeBasePtr& criterionNode, const size_t maxTempMemSizeInSamples);
 
     // -----------------------------------------------------------------------
@@ -1148,6 +1195,11 @@ protected:
         {
             SetNodeName(L"Loop_" + m_sourceNode->NodeName());
         }
+
+    private:
+        // BeginForwardProp() memo: layout bindings are stable once the network is compiled, so
+        // the loop-consistency check only needs to re-run when the binding actually changed.
+        const MBLayout* m_layoutConsistencyCheckedFor = nullptr;
     };
 
     // -----------------------------------------------------------------------
@@ -1200,6 +1252,32 @@ protected:
         // There is currently no other constructor for inner nested PAR-traversed sub-networks, but there will be.
         PARTraversalFlowControlNode(const std::vector<shared_ptr<SEQTraversalFlowControlNode>>& recurrentInfo, const std::list<ComputationNodeBasePtr>& allNodes);
         // Base::m_nestedNodes contains all top-level nodes, in evaluation order
+
+        // fired by Backprop() for each node once its own gradient is final; handed down from
+        // ComputationNetwork::Backprop(), cf. SetNodeGradientCompleteCallback()
+        std::function<void(const ComputationNodeBasePtr&)> m_gradientCompleteCallback;
+
+    private:
+        // frozen forward execution plan: each node with its all-frames FrameRange (and thus its
+        // MBLayout binding) resolved once, replayed as a flat loop every minibatch. See ForwardProp().
+        struct ForwardPlanStep
+        {
+            ComputationNodeBasePtr node;
+            FrameRange fr; // all-frames range with the node's layout bound in
+            // nodes whose last consumer is this step; their values are dropped right after the
+            // step's ForwardProp() while the network is inferring (Globals::ShouldEagerlyReleaseValues())
+            std::vector<ComputationNodeBasePtr> releaseAfter;
+        };
+        std::vector<ForwardPlanStep> m_forwardPlan;
+        // step indices grouped by dependency level, for the opt-in concurrent forward path
+        // (Globals::ShouldParallelizeForwardEval()): steps within one group have no dependencies
+        // among each other. Empty unless m_forwardPlanParallel.
+        std::vector<std::vector<size_t>> m_forwardPlanLevels;
+        bool m_forwardPlanParallel = false;
+        void CompileForwardPlan();
+        void CompileValueReleasePlan();
+        bool ForwardPlanIsCurrent() const;
+        void ExecuteForwardStep(const ForwardPlanStep& step) const;
     };
 
 public:
@@ -1263,16 +1341,40 @@ private:
 
     // cached network iterations
     std::map<const ComputationNodeBasePtr, std::list<ComputationNodeBasePtr>> m_evalOrders; // [out node] flat depth-first traversal starting from out node
+    std::map<std::wstring, std::vector<std::wstring>> m_precompiledEvalOrders;              // [root name; L"" = global] traversal as node names, from the on-disk compilation cache; only alive during Load()
     std::map<const ComputationNodeBasePtr, ComputationNodeBasePtr> m_nestedNetworks;        // [out node] network rewritten as recursive traveral, potentially optimized; execution plan
 
+    std::function<void(const ComputationNodeBasePtr&)> m_nodeGradientCompleteCallback; // see SetNodeGradientCompleteCallback()
+
     // cached quick-access list for inputs and parameters
     std::map<const ComputationNodeBasePtr, std::list<ComputationNodeBasePtr>> m_inputValues;         // [out node] -> all input nodes feeding into out node
     std::map<const ComputationNodeBasePtr, std::list<ComputationNodeBasePtr>> m_learnableParameters; // [out node] -> all parameter nodes feeding into out node
 
 private:
+    // Incremental recompilation: InvalidateCompiledNetwork() stashes the post-processed structures
+    // here instead of discarding them. If CompileNetwork() then finds the wiring and root set
+    // unchanged (many model edits only swap values, not topology), it restores the stash and skips
+    // the depth-first and strongly-connected-component analyses, cf. CurrentTopology().
+    struct CompilationCache
+    {
+        bool valid = false;
+        std::vector<std::pair<ComputationNodeBasePtr, std::vector<ComputationNodeBasePtr>>> topology; // (node, inputs) per node, in name order
+        std::vector<ComputationNodeBasePtr> allRoots;
+        std::vector<std::shared_ptr<SEQTraversalFlowControlNode>> allSEQNodes;
+        std::map<const ComputationNodeBasePtr, std::list<ComputationNodeBasePtr>> evalOrders;
+        std::map<const ComputationNodeBasePtr, ComputationNodeBasePtr> nestedNetworks;
+        std::map<const ComputationNodeBasePtr, std::list<ComputationNodeBasePtr>> inputValues;
+        std::map<const ComputationNodeBasePtr, std::list<ComputationNodeBasePtr>> learnableParameters;
+    };
+    std::vector<std::pair<ComputationNodeBasePtr, std::vector<ComputationNodeBasePtr>>> CurrentTopology() const;
+    CompilationCache m_compilationCache;
+
     // pool for matrices that can be shared across nodes
     // TODO: does this apply to anything else besides temporary node-internal intermediate results? What, for example?
     MatrixPool m_matrixPool;
+
+    // nodes designated as activation checkpoints for gradient checkpointing; empty = feature off
+    std::set<std::wstring> m_gradientCheckpointNodeNames;
 };
 typedef ComputationNetwork::ComputationNetworkPtr ComputationNetworkPtr;
 
@@ -165,6 +165,9 @@ void ComputationNetwork::FormRecurrentLoops(const ComputationNodeBasePtr& rootNo
 
     // --- END reorder process   --TODO: eliminate this process
 
+    // verify that no loop body carries computation that could run batched across timesteps outside the loop
+    VerifyLoopMinimality();
+
     // log the loops
     if (TraceLevel() > 0)
     {
@@ -198,6 +201,68 @@ static int GetRecurrenceSteppingDirection(const ComputationNodeBasePtr& node)
         return 0;
 }
 
+// verify that every loop is minimal, i.e. contains only nodes that actually participate in the recurrence
+// Tarjan's algorithm guarantees this: a node only ends up inside a loop if it lies on a cycle, and every
+// cycle passes through a delay node. Hence loop-invariant computation--e.g. the input-to-hidden projection
+// of an RNN--stays outside the loop, where it evaluates over all timesteps of the minibatch at once (one
+// large GEMM) instead of once per timestep. This check documents and defends that property: should a
+// change to the loop analysis ever pull a hoistable node into a loop body, we want a loud diagnostic,
+// since that silently serializes a batchable computation into T per-timestep ones.
+void ComputationNetwork::VerifyLoopMinimality() const
+{
+    for (let& seqNode : m_allSEQNodes)
+    {
+        let& nestedNodes = seqNode->m_nestedNodes;
+        unordered_set<ComputationNodeBasePtr> inLoop(nestedNodes.begin(), nestedNodes.end());
+
+        // build the intra-loop parent map (GetInputs() gives the other direction)
+        map<ComputationNodeBasePtr, vector<ComputationNodeBasePtr>> parents;
+        for (let& node : nestedNodes)
+            for (let& input : node->GetInputs())
+                if (inLoop.find(input) != inLoop.end())
+                    parents[input].push_back(node);
+
+        // a node participates in the recurrence iff it both (transitively) consumes a delay node's
+        // output and (transitively) feeds one; otherwise it is loop-invariant and hoistable
+        unordered_set<ComputationNodeBasePtr> consumesDelay, feedsDelay;
+        vector<ComputationNodeBasePtr> stack;
+        for (let& node : nestedNodes)
+            if (GetRecurrenceSteppingDirection(node) != 0)
+            {
+                consumesDelay.insert(node);
+                stack.push_back(node);
+            }
+        while (!stack.empty()) // walk parent edges from the delay nodes
+        {
+            let node = stack.back();
+            stack.pop_back();
+            for (let& parent : parents[node])
+                if (consumesDelay.insert(parent).second)
+                    stack.push_back(parent);
+        }
+        for (let& node : nestedNodes)
+            if (GetRecurrenceSteppingDirection(node) != 0)
+            {
+                feedsDelay.insert(node);
+                stack.push_back(node);
+            }
+        while (!stack.empty()) // walk input edges from the delay nodes
+        {
+            let node = stack.back();
+            stack.pop_back();
+            for (let& input : node->GetInputs())
+                if (inLoop.find(input) != inLoop.end() && feedsDelay.insert(input).second)
+                    stack.push_back(input);
+        }
+
+        for (let& node : nestedNodes)
+            if (consumesDelay.find(node) == consumesDelay.end() || feedsDelay.find(node) == feedsDelay.end())
+                fprintf(stderr, "WARNING: VerifyLoopMinimality: %ls %ls operation sits inside loop[%d] but does not participate in its recurrence; "
+                                "it will evaluate once per timestep although it could be hoisted out of the loop and batched across all timesteps.\n",
+                        node->NodeName().c_str(), node->OperationName().c_str(), (int) seqNode->m_loopId);
+    }
+}
+
 static int DetermineLoopDirection(const std::vector<ComputationNodeBasePtr>& nestedNodes);
 
 // get the strongly connected components from the graph
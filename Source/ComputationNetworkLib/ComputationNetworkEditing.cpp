@@ -8,7 +8,11 @@
 #include "Basics.h"
 #include "ComputationNode.h"
 #include "ComputationNetwork.h"
+#include "ConvolutionalNodes.h"
 #include "InputAndParamNodes.h"
+#include "LinearAlgebraNodes.h"
+#include "NonlinearityNodes.h"
+#include "SpecialPurposeNodes.h"
 #include "TrainingNodes.h"
 #include <string>
 #include <vector>
@@ -339,6 +343,66 @@ ComputationNodeBasePtr ComputationNetwork::RemoveFeatureNode(ComputationNodeBase
 }
 #endif
 
+// Pin the given nodes onto a device, for partitioning a network across GPUs (pipeline-style
+// model parallelism). Already materialized matrices (parameter values in particular) move
+// along immediately; pooled value and gradient matrices follow at the next memory allocation,
+// since those are requested on each node's own device. Call InsertPipelineTransferNodes()
+// afterwards to make the resulting cut edges explicit.
+void ComputationNetwork::AssignNodesToDevice(const std::vector<std::wstring>& nodeNames, DEVICEID_TYPE deviceId)
+{
+    InvalidateCompiledNetwork();
+
+    for (const auto& nodeName : nodeNames)
+        GetNodeFromName(nodeName)->MoveToDevice(deviceId);
+}
+
+// Splice a TransferNode into every edge that crosses a device boundary, so each cut edge of a
+// partitioned network performs one explicit device-to-device copy per pass. One transfer node
+// is created per (source node, consuming device) pair and shared by all consumers on that
+// device. Returns the number of transfer nodes inserted.
+size_t ComputationNetwork::InsertPipelineTransferNodes()
+{
+    // snapshot the consumers, since splicing mutates m_nameToNodeMap
+    vector<ComputationNodeBasePtr> consumers;
+    for (const auto& iter : m_nameToNodeMap)
+        consumers.push_back(iter.second);
+
+    map<pair<ComputationNodeBasePtr, DEVICEID_TYPE>, ComputationNodeBasePtr> transferOf;
+    size_t numInserted = 0;
+    for (const auto& node : consumers)
+    {
+        if (node->OperationName() == OperationNameOf(TransferNode)) // transfer nodes cross boundaries by design
+            continue;
+
+        for (int i = 0; i < node->GetNumInputs(); i++)
+        {
+            ComputationNodeBasePtr input = node->GetInputs()[i];
+            if (input->GetDeviceId() == node->GetDeviceId() || input->OperationName() == OperationNameOf(TransferNode))
+                continue;
+
+            InvalidateCompiledNetwork();
+
+            auto key = make_pair(input, node->GetDeviceId());
+            auto found = transferOf.find(key);
+            if (found == transferOf.end())
+            {
+                wstring name = msra::strfun::wstrprintf(L"%ls.xferToDevice%d", input->NodeName().c_str(), (int) node->GetDeviceId());
+                ComputationNodeBasePtr transferNode;
+                if (dynamic_pointer_cast<ComputationNode<float>>(input))
+                    transferNode = New<TransferNode<float>>(node->GetDeviceId(), name);
+                else
+                    transferNode = New<TransferNode<double>>(node->GetDeviceId(), name);
+                transferNode->AttachInputs({ input });
+                AddNodeToNet(transferNode);
+                found = transferOf.insert(make_pair(key, transferNode)).first;
+                numInserted++;
+            }
+            node->SetInput(i, found->second);
+        }
+    }
+    return numInserted;
+}
+
 // sets m_learningRateMultiplier in all LearnableParameters feeding into the passed rootNode
 // Called from MEL
 void ComputationNetwork::SetLearnableNodesBelowLearningRateMultiplier(const float learningRateMultiplier, const ComputationNodeBasePtr& rootNode)
@@ -367,4 +431,440 @@ void ComputationNetwork::SetLearnableNodesBelowLearningRateMultiplier(const floa
     }
 }
 
+// rewrite Plus -> {Sigmoid,Tanh} chains into single fused nodes (SigmoidOfPlus/TanhOfPlus)
+// Called from CompileNetwork() when fuseElementwiseOps=true, i.e. before validation, so the
+// fused nodes get validated and allocated like any hand-written node. The fused node computes
+// sigmoid(a+b) resp. tanh(a+b) in a single pass over memory, without materializing the sum.
+// It takes over the activation's name, so references by name stay valid; the Plus node
+// disappears. A chain is only eligible if the Plus feeds nothing but the activation and is
+// not itself a root or tagged node.
+// Returns the number of chains fused.
+size_t ComputationNetwork::FuseElementwiseChains()
+{
+    // count consumers of every node, and collect nodes that must not disappear
+    map<ComputationNodeBasePtr, size_t> numConsumers;
+    for (const auto& iter : m_nameToNodeMap)
+        for (const auto& input : iter.second->GetInputs())
+            numConsumers[input]++;
+    set<ComputationNodeBasePtr> excluded;
+    for (auto groupIter : GetAllNodeGroups())
+        for (const auto& groupNode : *groupIter)
+            excluded.insert(groupNode);
+
+    // snapshot the candidate activations, since fusing mutates m_nameToNodeMap
+    vector<ComputationNodeBasePtr> candidates;
+    for (const auto& iter : m_nameToNodeMap)
+        if (iter.second->OperationName() == OperationNameOf(SigmoidNode) || iter.second->OperationName() == OperationNameOf(TanhNode))
+            candidates.push_back(iter.second);
+
+    size_t numFused = 0;
+    for (const auto& node : candidates)
+    {
+        if (node->GetNumInputs() != 1)
+            continue;
+        ComputationNodeBasePtr plus = node->GetInputs()[0];
+        if (plus->OperationName() != OperationNameOf(PlusNode) || plus->GetNumInputs() != 2 ||
+            numConsumers[plus] != 1 || excluded.find(plus) != excluded.end())
+            continue;
+
+        InvalidateCompiledNetwork();
+
+        // create the fused replacement under the activation's name
+        bool isSigmoid = node->OperationName() == OperationNameOf(SigmoidNode);
+        ComputationNodeBasePtr fusedNode;
+        if (dynamic_pointer_cast<ComputationNode<float>>(node))
+        {
+            if (isSigmoid) fusedNode = New<SigmoidOfPlusNode<float>>(node->GetDeviceId(), node->NodeName());
+            else           fusedNode = New<TanhOfPlusNode<float>>(node->GetDeviceId(), node->NodeName());
+        }
+        else
+        {
+            if (isSigmoid) fusedNode = New<SigmoidOfPlusNode<double>>(node->GetDeviceId(), node->NodeName());
+            else           fusedNode = New<TanhOfPlusNode<double>>(node->GetDeviceId(), node->NodeName());
+        }
+        fusedNode->AttachInputs({ plus->GetInputs()[0], plus->GetInputs()[1] });
+
+        // swap the fused node into the activation's place; the Plus node drops out entirely
+        ChangeNodeInputs(node, fusedNode);
+        node->DetachInputs(); // deref the Plus node, which in turn derefs its inputs (avoids circular-reference leaks, cf. DeleteNode())
+        plus->DetachInputs();
+        RemoveNodeFromNet(node);
+        RemoveNodeFromNet(plus);
+        AddNodeToNet(fusedNode);
+
+        // also update node groups (the activation may be tagged, e.g. as an output)
+        for (auto groupIter : GetAllNodeGroups())
+        {
+            auto& group = *groupIter;
+            for (int i = 0; i < group.size(); i++)
+                if (group[i] == node)
+                    group[i] = fusedNode;
+        }
+        numFused++;
+    }
+    return numFused;
+}
+
+// typed helper for FuseConvolutionBiasActivation(): checks the eligibility of one
+// convolution/bias pair for one element type and builds the fused replacement node under the
+// activation's name, or returns nullptr
+template <class ElemType>
+static ComputationNodeBasePtr MakeFusedConvolutionBiasActivationNode(const ComputationNodeBasePtr& activation, const ComputationNodeBasePtr& conv, const ComputationNodeBasePtr& bias)
+{
+    auto typedConv = dynamic_pointer_cast<ConvolutionNode<ElemType>>(conv);
+    if (!typedConv)
+        return nullptr;
+
+    // only the canonical CNN pattern is fused: a plain non-transposed CHW convolution without
+    // legacy 2D syntax or a user-specified output shape
+    if (typedConv->IsConvolution2D() || typedConv->Transpose() || typedConv->PoolingKind() != PoolKind::None ||
+        typedConv->ImageLayout() != ImageLayoutKind::CHW ||
+        (typedConv->OutputShape().GetRank() > 0 && typedConv->OutputShape() != TensorShape(0)))
+        return nullptr;
+
+    // the bias must be a parameter holding one value per output feature map, shaped so that it
+    // broadcasts onto the map dimension of the convolution output (singleton in all dimensions
+    // but the last); shorter shapes would be padded with *trailing* singletons and misalign
+    size_t mapCount = typedConv->MapCount().GetNumElements();
+    const auto& biasShape = bias->GetSampleLayout();
+    if (bias->OperationName() != OperationNameOf(LearnableParameter) || bias->HasMBLayout() ||
+        mapCount == 0 || biasShape.GetNumElements() != mapCount ||
+        biasShape.GetRank() != typedConv->KernelShape().GetRank() || biasShape.GetDims().back() != mapCount)
+        return nullptr;
+
+    return New<ConvolutionBiasActivationNode<ElemType>>(conv->GetDeviceId(), activation->NodeName(),
+                                                        typedConv->KernelShape(), typedConv->MapCount(), typedConv->Strides(),
+                                                        typedConv->Sharing(), typedConv->AutoPad(), typedConv->LowerPad(), typedConv->UpperPad(),
+                                                        typedConv->ImageLayout(), typedConv->MaxTempMemSizeInSamples());
+}
+
+// rewrite Convolution -> Plus(bias) -> RectifiedLinear chains into single fused
+// ConvolutionBiasActivation nodes. Called from CompileNetwork() when fuseConvolutionOps=true,
+// i.e. before validation, so the fused nodes get validated and allocated like any hand-written
+// node. On cuDNN the whole triple runs as a single fused kernel; on other engines the bias-add
+// and rectifier run as one elementwise pass over the convolution output. Either way the two
+// intermediate materializations of the unfused chain are gone. The fused node takes over the
+// activation's name, so references by name stay valid; the Plus and Convolution nodes
+// disappear, while the bias parameter stays and becomes the third input. A chain is only
+// eligible if the Plus and the Convolution each feed nothing but the next link and neither is
+// a root or tagged node.
+// Returns the number of chains fused.
+size_t ComputationNetwork::FuseConvolutionBiasActivation()
+{
+    // count consumers of every node, and collect nodes that must not disappear
+    map<ComputationNodeBasePtr, size_t> numConsumers;
+    for (const auto& iter : m_nameToNodeMap)
+        for (const auto& input : iter.second->GetInputs())
+            numConsumers[input]++;
+    set<ComputationNodeBasePtr> excluded;
+    for (auto groupIter : GetAllNodeGroups())
+        for (const auto& groupNode : *groupIter)
+            excluded.insert(groupNode);
+
+    // snapshot the candidate activations, since fusing mutates m_nameToNodeMap
+    vector<ComputationNodeBasePtr> candidates;
+    for (const auto& iter : m_nameToNodeMap)
+        if (iter.second->OperationName() == OperationNameOf(RectifiedLinearNode))
+            candidates.push_back(iter.second);
+
+    size_t numFused = 0;
+    for (const auto& node : candidates)
+    {
+        if (node->GetNumInputs() != 1)
+            continue;
+        ComputationNodeBasePtr plus = node->GetInputs()[0];
+        if (plus->OperationName() != OperationNameOf(PlusNode) || plus->GetNumInputs() != 2 ||
+            numConsumers[plus] != 1 || excluded.find(plus) != excluded.end())
+            continue;
+
+        // the convolution may be either operand of the Plus; the other one is the bias
+        ComputationNodeBasePtr conv, bias, fusedNode;
+        for (size_t i = 0; i < 2 && !fusedNode; i++)
+        {
+            conv = plus->GetInputs()[i];
+            bias = plus->GetInputs()[1 - i];
+            if (conv->OperationName() != OperationNameOf(ConvolutionNode) ||
+                numConsumers[conv] != 1 || excluded.find(conv) != excluded.end())
+                continue;
+            fusedNode = MakeFusedConvolutionBiasActivationNode<float>(node, conv, bias);
+            if (!fusedNode)
+                fusedNode = MakeFusedConvolutionBiasActivationNode<double>(node, conv, bias);
+        }
+        if (!fusedNode)
+            continue;
+
+        InvalidateCompiledNetwork();
+
+        // swap the fused node into the activation's place; the Plus and Convolution nodes drop out entirely
+        fusedNode->AttachInputs({ conv->GetInputs()[0], conv->GetInputs()[1], bias });
+        ChangeNodeInputs(node, fusedNode);
+        node->DetachInputs(); // deref the Plus node, which in turn derefs its inputs (avoids circular-reference leaks, cf. DeleteNode())
+        plus->DetachInputs();
+        conv->DetachInputs();
+        RemoveNodeFromNet(node);
+        RemoveNodeFromNet(plus);
+        RemoveNodeFromNet(conv);
+        AddNodeToNet(fusedNode);
+
+        // also update node groups (the activation may be tagged, e.g. as an output)
+        for (auto groupIter : GetAllNodeGroups())
+        {
+            auto& group = *groupIter;
+            for (int i = 0; i < group.size(); i++)
+                if (group[i] == node)
+                    group[i] = fusedNode;
+        }
+        numFused++;
+    }
+    return numFused;
+}
+
+// typed helper for AbsorbTransposesIntoTimes(): checks the eligibility of one transpose/product
+// pair for one element type and builds the replacement product node, or returns nullptr
+template <class ElemType>
+static ComputationNodeBasePtr MakeAbsorbedTimesNode(const ComputationNodeBasePtr& product, const ComputationNodeBasePtr& transpose)
+{
+    auto typedTranspose = dynamic_pointer_cast<TransposeDimensionsNode<ElemType>>(transpose);
+    if (!typedTranspose)
+        return nullptr;
+
+    // only a swap of axes 1 and 2 of a rank<=2 operand without a time axis is a plain matrix
+    // transpose (the permutation form of TransposeDimensions is not rewritten)
+    bool swapsMatrixAxes = (typedTranspose->Axis1() == 1 && typedTranspose->Axis2() == 2) ||
+                           (typedTranspose->Axis1() == 2 && typedTranspose->Axis2() == 1);
+    if (!swapsMatrixAxes || transpose->HasMBLayout() || transpose->GetInputs()[0]->GetSampleLayout().GetRank() > 2)
+        return nullptr;
+
+    if (auto times = dynamic_pointer_cast<TimesNode<ElemType>>(product))
+    {
+        // TransposeTimes only supports outputRank 1 and no input-rank inference
+        if (times->OutputRank() != 1 || times->InferInputRankToMap() != TimesNode<ElemType>::NoInferredInputRank)
+            return nullptr;
+        return New<TransposeTimesNode<ElemType>>(product->GetDeviceId(), product->NodeName());
+    }
+    else if (dynamic_pointer_cast<TransposeTimesNode<ElemType>>(product))
+        return New<TimesNode<ElemType>>(product->GetDeviceId(), product->NodeName());
+
+    return nullptr;
+}
+
+// absorb explicit transpose copies feeding the left operand of a matrix product into the
+// product itself: Times(Transpose(X), B) becomes TransposeTimes(X, B), and TransposeTimes
+// likewise turns back into Times, since the underlying GEMM takes the transposition of its
+// operands as a mere flag; the materialized transpose copy disappears. Called from
+// CompileNetwork() when absorbTransposes=true, after validation, since only a swap of axes
+// 1 and 2 of a rank<=2 operand is a matrix transpose. A transpose is only absorbed if the
+// product is its sole consumer and it is not itself a root or tagged node. The replacement
+// takes over the product's name, so references by name stay valid.
+// Returns the number of transposes absorbed.
+size_t ComputationNetwork::AbsorbTransposesIntoTimes()
+{
+    // count consumers of every node, and collect nodes that must not disappear
+    map<ComputationNodeBasePtr, size_t> numConsumers;
+    for (const auto& iter : m_nameToNodeMap)
+        for (const auto& input : iter.second->GetInputs())
+            numConsumers[input]++;
+    set<ComputationNodeBasePtr> excluded;
+    for (auto groupIter : GetAllNodeGroups())
+        for (const auto& groupNode : *groupIter)
+            excluded.insert(groupNode);
+
+    // snapshot the candidate products, since rewriting mutates m_nameToNodeMap
+    vector<ComputationNodeBasePtr> candidates;
+    for (const auto& iter : m_nameToNodeMap)
+        if (iter.second->OperationName() == OperationNameOf(TimesNode) || iter.second->OperationName() == OperationNameOf(TransposeTimesNode))
+            candidates.push_back(iter.second);
+
+    size_t numAbsorbed = 0;
+    for (const auto& node : candidates)
+    {
+        ComputationNodeBasePtr transpose = node->GetInputs()[0];
+        if (transpose->OperationName() != OperationNameOf(TransposeDimensionsNode) ||
+            numConsumers[transpose] != 1 || excluded.find(transpose) != excluded.end())
+            continue;
+
+        ComputationNodeBasePtr newNode = MakeAbsorbedTimesNode<float>(node, transpose);
+        if (!newNode)
+            newNode = MakeAbsorbedTimesNode<double>(node, transpose);
+        if (!newNode)
+            continue;
+
+        InvalidateCompiledNetwork();
+
+        // swap the flipped product into place; the transpose node drops out entirely
+        newNode->AttachInputs({ transpose->GetInputs()[0], node->GetInputs()[1] });
+        ChangeNodeInputs(node, newNode);
+        node->DetachInputs(); // deref the transpose node, which in turn derefs its input (avoids circular-reference leaks, cf. DeleteNode())
+        transpose->DetachInputs();
+        RemoveNodeFromNet(node);
+        RemoveNodeFromNet(transpose);
+        AddNodeToNet(newNode);
+
+        // also update node groups (the product may be tagged, e.g. as an output)
+        for (auto groupIter : GetAllNodeGroups())
+        {
+            auto& group = *groupIter;
+            for (int i = 0; i < group.size(); i++)
+                if (group[i] == node)
+                    group[i] = newNode;
+        }
+        numAbsorbed++;
+    }
+    return numAbsorbed;
+}
+
+// evaluate constant-only subgraphs once and replace each with a frozen LearnableParameter
+// holding the computed value; nodes that thereby become unreachable are removed from the net.
+// A subgraph is constant if its leaves are all frozen parameters (learningRateMultiplier = 0)
+// and its interior nodes are deterministic, minibatch-independent operations. Called from
+// CompileNetwork() when foldConstants=true, after validation (folding needs final dimensions);
+// the caller compiles again if anything was folded, since the traversal structures are stale.
+// The replacement takes over the folded node's name, so references by name stay valid; nodes
+// strictly inside the folded subgraph disappear. Returns the number of subgraphs folded.
+size_t ComputationNetwork::FoldConstantSubexpressions()
+{
+    // operations safe to evaluate at compile time: deterministic, free of minibatch data, and
+    // not needing pooled temporaries in forward (the matrix pool does not exist at this point)
+    static const set<wstring> foldableOps =
+    {
+        OperationNameOf(PlusNode), OperationNameOf(MinusNode), OperationNameOf(NegateNode),
+        OperationNameOf(ElementTimesNode), OperationNameOf(TimesNode),
+        OperationNameOf(SigmoidNode), OperationNameOf(TanhNode), OperationNameOf(RectifiedLinearNode),
+        OperationNameOf(ExpNode), OperationNameOf(LogNode), OperationNameOf(SqrtNode),
+        OperationNameOf(AbsNode), OperationNameOf(FloorNode), OperationNameOf(ReciprocalNode),
+        OperationNameOf(CosineNode), OperationNameOf(SinNode),
+    };
+
+    // count consumers of every node, and collect nodes that must not disappear
+    map<ComputationNodeBasePtr, size_t> numConsumers;
+    for (const auto& iter : m_nameToNodeMap)
+        for (const auto& input : iter.second->GetInputs())
+            numConsumers[input]++;
+    set<ComputationNodeBasePtr> excluded;
+    for (auto groupIter : GetAllNodeGroups())
+        for (const auto& groupNode : *groupIter)
+            excluded.insert(groupNode);
+
+    // classify every node: constant = frozen parameter, or foldable op over constant inputs only
+    map<ComputationNodeBasePtr, bool> isConstant;
+    function<bool(const ComputationNodeBasePtr&)> classify = [&](const ComputationNodeBasePtr& node) -> bool
+    {
+        auto res = isConstant.find(node);
+        if (res != isConstant.end())
+            return res->second;
+        bool constant;
+        if (node->GetNumInputs() == 0)
+            constant = node->OperationName() == OperationNameOf(LearnableParameter) && node->GetLearningRateMultiplier() == 0;
+        else
+        {
+            constant = foldableOps.find(node->OperationName()) != foldableOps.end() && !node->HasMBLayout();
+            for (size_t i = 0; constant && i < node->GetNumInputs(); i++)
+                constant = classify(node->Input(i));
+        }
+        isConstant[node] = constant;
+        return constant;
+    };
+
+    // a node is folded if it is a constant interior node that no constant consumer will
+    // subsume, i.e. the topmost node of its constant subgraph as seen by the rest of the net.
+    // Tagged nodes keep their identity, and constant subgraphs that feed nothing (untagged
+    // roots) are left alone, since folding them would only rename what gets computed.
+    auto foldable = [&](const ComputationNodeBasePtr& node)
+    {
+        return node->GetNumInputs() > 0 && classify(node) && excluded.find(node) == excluded.end();
+    };
+    vector<ComputationNodeBasePtr> frontier;
+    for (const auto& iter : m_nameToNodeMap)
+        classify(iter.second); // classify everything first, so the consumer test below is complete
+    for (const auto& iter : m_nameToNodeMap)
+    {
+        const auto& node = iter.second;
+        if (!foldable(node) || numConsumers[node] == 0)
+            continue;
+        bool subsumed = false;
+        for (const auto& consumerIter : m_nameToNodeMap)
+            for (const auto& input : consumerIter.second->GetInputs())
+                if (input == node && foldable(consumerIter.second))
+                    subsumed = true;
+        if (!subsumed)
+            frontier.push_back(node);
+    }
+
+    // evaluate the constant subgraphs bottom-up, once per shared node
+    set<ComputationNodeBasePtr> evaluated;
+    function<void(const ComputationNodeBasePtr&)> evaluate = [&](const ComputationNodeBasePtr& node)
+    {
+        if (node->GetNumInputs() == 0 || evaluated.find(node) != evaluated.end())
+            return;
+        for (const auto& input : node->GetInputs())
+            evaluate(input);
+        node->MarkValueNonSharable(); // allocates m_value; these nodes never enter the matrix pool
+        node->BeginForwardProp();     // sizes m_value from the sample layout (constant nodes carry no dynamic axis)
+        node->ForwardProp(FrameRange(nullptr));
+        node->EndForwardProp();
+        evaluated.insert(node);
+    };
+
+    size_t numFolded = 0;
+    for (const auto& node : frontier)
+    {
+        InvalidateCompiledNetwork();
+        evaluate(node);
+
+        // replace the folded node with a frozen parameter holding the computed value
+        ComputationNodeBasePtr constNode;
+        if (auto typedNode = dynamic_pointer_cast<ComputationNode<float>>(node))
+        {
+            auto param = New<LearnableParameter<float>>(node->GetDeviceId(), node->NodeName(), node->GetSampleLayout());
+            param->Value().SetValue(typedNode->Value());
+            constNode = param;
+        }
+        else
+        {
+            auto typedNodeD = dynamic_pointer_cast<ComputationNode<double>>(node);
+            auto param = New<LearnableParameter<double>>(node->GetDeviceId(), node->NodeName(), node->GetSampleLayout());
+            param->Value().SetValue(typedNodeD->Value());
+            constNode = param;
+        }
+        constNode->SetLearningRateMultiplier(0);
+
+        ChangeNodeInputs(node, constNode);
+        node->DetachInputs(); // deref the subgraph (avoids circular-reference leaks, cf. DeleteNode())
+        RemoveNodeFromNet(node);
+        AddNodeToNet(constNode);
+        numFolded++;
+    }
+
+    // dead-node elimination: nodes strictly inside the folded subgraphs are now unreferenced.
+    // Removing one node can orphan its inputs, so iterate to a fixpoint. Only nodes classified
+    // constant are touched; they lose their name bindings, which is the documented cost of
+    // foldConstants.
+    if (numFolded > 0)
+    {
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            vector<ComputationNodeBasePtr> nodes; // snapshot, since removal mutates the name map
+            for (const auto& iter : m_nameToNodeMap)
+                nodes.push_back(iter.second);
+            set<ComputationNodeBasePtr> referenced;
+            for (const auto& node : nodes)
+                for (const auto& input : node->GetInputs())
+                    referenced.insert(input);
+            for (const auto& node : nodes)
+            {
+                auto constRes = isConstant.find(node); // new parameters are not in the map and thus never pruned
+                if (constRes == isConstant.end() || !constRes->second || numConsumers[node] == 0 /*was a root before folding*/ ||
+                    referenced.find(node) != referenced.end() || excluded.find(node) != excluded.end())
+                    continue;
+                node->DetachInputs();
+                RemoveNodeFromNet(node);
+                changed = true;
+            }
+        }
+    }
+    return numFolded;
+}
+
 }}}
@@ -6,17 +6,20 @@
 #define _CRT_SECURE_NO_WARNINGS // "secure" CRT not available on all platforms  --add this at the top of all CPP files that give "function or variable may be unsafe" warnings
 
 #include "Basics.h"
+#include "Globals.h"
 #include "ComputationNode.h"
 #include "ComputationNetwork.h"
 #include "RecurrentNodes.h"
 #include "InputAndParamNodes.h"
 #include "LinearAlgebraNodes.h"
+#include "PerformanceProfiler.h"
 #include <string>
 #include <vector>
 #include <list>
 #include <set>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
 
 using namespace std;
 
@@ -85,7 +88,11 @@ void ComputationNetwork::Backprop(const ComputationNodeBasePtr rootNode) // trai
     ZeroInputGradients(rootNode);
 
     // backpropagate through the network
-    GetNestedNetwork(rootNode)->Backprop(FrameRange(nullptr), true, true);
+    auto nestedNetwork = GetNestedNetwork(rootNode);
+    // hand the gradient-completion callback down to the traversal node for this sweep
+    if (auto parNetwork = dynamic_pointer_cast<PARTraversalFlowControlNode>(nestedNetwork))
+        parNetwork->m_gradientCompleteCallback = m_nodeGradientCompleteCallback;
+    nestedNetwork->Backprop(FrameRange(nullptr), true, true);
 }
 
 void ComputationNetwork::FormNestedNetwork(const ComputationNodeBasePtr& rootNode)
@@ -103,6 +110,45 @@ ComputationNodeBasePtr ComputationNetwork::GetNestedNetwork(const ComputationNod
     return m_nestedNetworks[rootNode];
 }
 
+// -----------------------------------------------------------------------
+// per-node profiling
+// -----------------------------------------------------------------------
+
+// Records one node's ForwardProp()/Backprop() time into the performance profiler's custom event
+// stream ('profilerTimeNodes=true'). GPU nodes are timed with CUDA events on the compute stream,
+// so no per-node host/device sync distorts the pipeline being measured; CPU nodes use the host
+// clock. The events show up in the profiler detail log and in the chrome://tracing JSON that the
+// profiler writes at shutdown, labeled with the node name so a slow step can be pinned to a node.
+class ScopedNodeTimer
+{
+public:
+    ScopedNodeTimer(const ComputationNodeBasePtr& node, const char* phase)
+        : m_active(Globals::ShouldTimeNodes())
+    {
+        if (!m_active)
+            return;
+        m_onGpu = node->GetDeviceId() >= 0;
+        sprintf_s(m_eventDescription, _countof(m_eventDescription), "%s: %ls (%ls)",
+                  phase, node->NodeName().c_str(), node->OperationName().c_str());
+        m_stateId = m_onGpu ? ProfilerCudaTimeBegin() : ProfilerTimeBegin();
+    }
+    ~ScopedNodeTimer()
+    {
+        if (!m_active)
+            return;
+        if (m_onGpu)
+            ProfilerCudaTimeEnd(m_stateId, m_eventDescription);
+        else
+            ProfilerTimeEnd(m_stateId, m_eventDescription);
+    }
+
+private:
+    bool      m_active;
+    bool      m_onGpu;
+    long long m_stateId;
+    char      m_eventDescription[128];
+};
+
 // -----------------------------------------------------------------------
 // PARTraversalFlowControlNode methods -- implements PAR traversal
 //
@@ -144,6 +190,7 @@ ComputationNetwork::PARTraversalFlowControlNode::PARTraversalFlowControlNode(con
 {
     if (node->IsOutOfDateWrtInputs())
     {
+        ScopedNodeTimer timer(node, "Forward");
         node->BeginForwardProp();
         node->ForwardProp(fr.WithLayout(node->GetMBLayout()));
         node->EndForwardProp();
@@ -157,8 +204,220 @@ ComputationNetwork::PARTraversalFlowControlNode::PARTraversalFlowControlNode(con
 }
 
 
+// Compile the frozen forward execution plan: resolve each node's all-frames FrameRange (and
+// thereby its MBLayout binding) once, so per-minibatch replay is a flat loop with no per-node
+// layout rebinding. Layout *contents* are refreshed in place every minibatch; the *binding*
+// (which MBLayout object a node points to) only changes when the network is recompiled, which
+// ForwardPlanIsCurrent() detects with a pointer sweep.
+void ComputationNetwork::PARTraversalFlowControlNode::CompileForwardPlan()
+{
+    m_forwardPlan.clear();
+    m_forwardPlan.reserve(m_nestedNodes.size());
+    for (auto& node : m_nestedNodes)
+        m_forwardPlan.push_back(ForwardPlanStep{ node, FrameRange(node->GetMBLayout()) });
+
+    CompileValueReleasePlan();
+
+    // Opt-in concurrent forward path: partition the plan into dependency levels, so that steps
+    // within one level are mutually independent and may execute concurrently. This is only valid
+    // when value buffers are not shared across nodes (sharing assumes the strictly sequential
+    // evaluation order for buffer-lifetime analysis) and only worthwhile for CPU execution (the
+    // GPU Math library funnels all work through a single compute stream, so host-side concurrency
+    // would buy nothing there and break stream-ordering assumptions).
+    m_forwardPlanLevels.clear();
+    m_forwardPlanParallel = Globals::ShouldParallelizeForwardEval() && !Globals::ShouldEnableShareNodeValueMatrices();
+    if (!m_forwardPlanParallel)
+        return;
+
+    std::unordered_map<const ComputationNodeBase*, size_t> levelOf;
+    size_t floorLevel = 0; // SEQ loop sentinels act as full barriers; nodes below this level are all complete
+    size_t maxLevel = 0;
+    for (size_t i = 0; i < m_forwardPlan.size(); i++)
+    {
+        auto& node = m_forwardPlan[i].node;
+        size_t level;
+        if (dynamic_cast<SEQTraversalFlowControlNode*>(node.get())) // loop sentinel: we don't track its internal dependencies, so serialize around it
+        {
+            level = maxLevel + 1;
+            floorLevel = level + 1;
+        }
+        else
+        {
+            if (node->GetDeviceId() >= 0) // non-CPU node: fall back to the sequential replay
+            {
+                m_forwardPlanLevels.clear();
+                m_forwardPlanParallel = false;
+                return;
+            }
+            level = floorLevel;
+            for (auto& input : node->GetInputs())
+            {
+                auto found = levelOf.find(input.get());
+                if (found != levelOf.end() && found->second + 1 > level)
+                    level = found->second + 1;
+            }
+            levelOf[node.get()] = level;
+        }
+        if (level > maxLevel)
+            maxLevel = level;
+        if (level >= m_forwardPlanLevels.size())
+            m_forwardPlanLevels.resize(level + 1);
+        m_forwardPlanLevels[level].push_back(i);
+    }
+}
+
+// Consumer-count liveness plan for inference-time eager value release
+// (Globals::ShouldEagerlyReleaseValues()): determine each value's last consumer in the frozen
+// forward plan and attach the value to that consumer's step, so that the sequential replay can
+// return its memory to the device right after the step's ForwardProp() while the network is
+// inferring. Values that are non-sharable (roots, parameters, inputs), sparse, produced inside
+// a recurrent loop, or involved in in-place buffer aliasing keep their regular lifetime. The
+// concurrent forward path does not perform eager release, since its per-level execution order
+// does not honor the plan-order liveness computed here.
+void ComputationNetwork::PARTraversalFlowControlNode::CompileValueReleasePlan()
+{
+    if (!Globals::ShouldEagerlyReleaseValues())
+        return;
+
+    // last plan step that reads each node's value; loop members consume at their sentinel's step
+    std::unordered_map<const ComputationNodeBase*, size_t> lastConsumerStep;
+    // values whose buffer an in-place node overwrites; freeing those would free the alias's output
+    std::unordered_set<const ComputationNodeBase*> aliasSources;
+    auto noteConsumer = [&](const ComputationNodeBasePtr& consumer, size_t step)
+    {
+        for (auto& input : consumer->GetInputs())
+            lastConsumerStep[input.get()] = step;
+        if (consumer->ValueAliasesInput())
+            aliasSources.insert(consumer->GetInputs()[consumer->ValueAliasInputIndex()].get());
+    };
+    for (size_t i = 0; i < m_forwardPlan.size(); i++)
+    {
+        auto& node = m_forwardPlan[i].node;
+        if (auto seqNode = dynamic_cast<SEQTraversalFlowControlNode*>(node.get()))
+        {
+            for (auto& loopNode : seqNode->m_nestedNodes)
+                noteConsumer(loopNode, i);
+        }
+        else
+            noteConsumer(node, i);
+    }
+
+    for (auto& step : m_forwardPlan)
+    {
+        auto& node = step.node;
+        if (dynamic_cast<SEQTraversalFlowControlNode*>(node.get())) // loop members are excluded below anyway
+            continue;
+        auto found = lastConsumerStep.find(node.get());
+        if (found == lastConsumerStep.end())
+            continue; // no consumer in this plan: a root, whose value the caller reads
+        if (!node->IsValueSharable() || node->IsValueSparse() || node->IsPartOfLoop() ||
+            node->ValueAliasesInput() || aliasSources.find(node.get()) != aliasSources.end())
+            continue;
+        m_forwardPlan[found->second].releaseAfter.push_back(node);
+    }
+}
+
+// execute one step of the frozen plan; shared between the sequential replay and the
+// concurrent per-level dispatch (all operations below are safe to run concurrently for
+// independent nodes: the eval time stamp counter is atomic, and layouts are only read)
+void ComputationNetwork::PARTraversalFlowControlNode::ExecuteForwardStep(const ForwardPlanStep& step) const
+{
+    auto& node = step.node;
+    if (!node->IsOutOfDateWrtInputs())
+        return;
+    ScopedNodeTimer timer(node, "Forward");
+    node->BeginForwardProp();
+    node->ForwardProp(step.fr);
+    node->EndForwardProp();
+
+    node->BumpEvalTimeStamp();
+
+    // Extreme Tracing, part 1/4
+    if (node->HasEnvironmentPtr() && node->Environment().ShouldDumpNode())
+        DumpNode<float>(node, /*dumpGradient=*/false) || DumpNode<double>(node, false);
+}
+
+bool ComputationNetwork::PARTraversalFlowControlNode::ForwardPlanIsCurrent() const
+{
+    if (m_forwardPlan.size() != m_nestedNodes.size())
+        return false;
+    for (size_t i = 0; i < m_forwardPlan.size(); i++)
+    {
+        if (m_forwardPlan[i].node != m_nestedNodes[i] ||
+            m_forwardPlan[i].fr.m_pMBLayout != m_forwardPlan[i].node->GetMBLayout())
+            return false;
+    }
+    return true;
+}
+
 /*virtual*/ void ComputationNetwork::PARTraversalFlowControlNode::ForwardProp(const FrameRange& fr) /*override*/
 {
+    // The top-level entry point always passes an all-frames FrameRange without a layout; that
+    // case replays the frozen plan. Any other caller takes the generic per-node path.
+    if (fr.IsAllFrames() && !fr.m_pMBLayout)
+    {
+        if (!ForwardPlanIsCurrent())
+            CompileForwardPlan();
+        if (m_forwardPlanParallel)
+        {
+            // dispatch each dependency level as a batch of independent steps; levels join implicitly
+            // at the end of the parallel region. An exception thrown inside the region would
+            // terminate the process, so capture the first one and rethrow after the join.
+            for (auto& levelSteps : m_forwardPlanLevels)
+            {
+                if (levelSteps.size() == 1)
+                {
+                    ExecuteForwardStep(m_forwardPlan[levelSteps.front()]);
+                    continue;
+                }
+                std::exception_ptr pendingException;
+#pragma omp parallel for schedule(dynamic)
+                for (long i = 0; i < (long) levelSteps.size(); i++)
+                {
+                    try
+                    {
+                        ExecuteForwardStep(m_forwardPlan[levelSteps[i]]);
+                    }
+                    catch (...)
+                    {
+#pragma omp critical(PARForwardPlanException)
+                        if (!pendingException)
+                            pendingException = std::current_exception();
+                    }
+                }
+                if (pendingException)
+                    std::rethrow_exception(pendingException);
+            }
+        }
+        else
+        {
+            // eager value release only applies while inferring; a training (or precompute) pass
+            // is about to read these values again during backprop
+            bool eagerRelease = false;
+            if (Globals::ShouldEagerlyReleaseValues())
+            {
+                for (auto& step : m_forwardPlan)
+                {
+                    if (step.node->HasEnvironmentPtr())
+                    {
+                        eagerRelease = step.node->Environment().IsInferring();
+                        break;
+                    }
+                }
+            }
+            for (auto& step : m_forwardPlan)
+            {
+                ExecuteForwardStep(step);
+                if (eagerRelease)
+                {
+                    for (auto& deadNode : step.releaseAfter)
+                        deadNode->ReleaseValueForInference();
+                }
+            }
+        }
+        return;
+    }
+
     for (auto& node : m_nestedNodes)
         ForwardProp(node, fr);
 }
@@ -177,19 +436,67 @@ ComputationNetwork::PARTraversalFlowControlNode::PARTraversalFlowControlNode(con
 /*virtual*/ void ComputationNetwork::PARTraversalFlowControlNode::Backprop(const FrameRange& fr, bool childrenInThisLoop, bool childrenInOuterLoop) /*override*/
 {
     childrenInThisLoop, childrenInOuterLoop; // TODO: think through what these mean when coming from PAR mode
+
+    // gradient checkpointing: values inside a recompute segment were surrendered to the pool after
+    // the forward pass. When the backward sweep enters a segment, re-evaluate those values into
+    // private scratch matrices (in forward order, from the retained checkpoints), and restore the
+    // pooled bindings when it leaves, so the next forward pass works on the planned buffers again.
+    // Segment ids are contiguous along the evaluation order, cf. PlanGradientCheckpointing();
+    // without checkpointing all ids are -1 and none of this kicks in.
+    auto segmentOf = [](const ComputationNodeBasePtr& node)
+    {
+        auto seqNode = dynamic_cast<SEQTraversalFlowControlNode*>(node.get());
+        return seqNode ? seqNode->m_nestedNodes.front()->GradientCheckpointSegment() : node->GradientCheckpointSegment();
+    };
+    std::vector<ComputationNodeBasePtr> recomputedNodes;
+    auto endActiveSegment = [&recomputedNodes]()
+    {
+        for (auto& recomputedNode : recomputedNodes)
+            recomputedNode->EndValueRecompute();
+        recomputedNodes.clear();
+    };
+    int activeSegment = -1;
+
     // process nodes in pre-determined order
     for (auto pnode = m_nestedNodes.rbegin(); pnode != m_nestedNodes.rend(); pnode++) // iterate backwards over evaluation order
     {
         auto& node = *pnode;
 
-        node->BeginBackprop();
-        node->Backprop(fr.WithLayout(node->GetMBLayout()), true /*childrenInThisLoop*/, true /*childrenInOuterLoop*/);
-        node->EndBackprop();
+        int segment = segmentOf(node);
+        if (segment != activeSegment)
+        {
+            endActiveSegment();
+            activeSegment = segment;
+            for (auto& segmentNode : m_nestedNodes) // re-evaluate the dropped values of this segment
+            {
+                if (segmentOf(segmentNode) != segment || !segmentNode->IsValueRecomputeNeeded())
+                    continue;
+                segmentNode->BeginValueRecompute();
+                segmentNode->BeginForwardProp();
+                segmentNode->ForwardProp(fr.WithLayout(segmentNode->GetMBLayout()));
+                segmentNode->EndForwardProp();
+                recomputedNodes.push_back(segmentNode);
+            }
+        }
+
+        {
+            ScopedNodeTimer timer(node, "Backprop");
+            node->BeginBackprop();
+            node->Backprop(fr.WithLayout(node->GetMBLayout()), true /*childrenInThisLoop*/, true /*childrenInOuterLoop*/);
+            node->EndBackprop();
+        }
+
+        // All consumers of 'node' lie later in the evaluation order and have been processed
+        // above, so the node's own gradient has now received its last contribution; report it
+        // (used to overlap distributed gradient aggregation with the rest of the sweep).
+        if (m_gradientCompleteCallback && node->NeedsGradient() && !dynamic_cast<SEQTraversalFlowControlNode*>(node.get()))
+            m_gradientCompleteCallback(node);
 
         // Extreme Tracing, part 2/4
         if (node->HasEnvironmentPtr() && node->Environment().ShouldDumpNode() && node->NeedsGradient())
             DumpNode<float>(node, /*dumpGradient=*/true) || DumpNode<double>(node, true);
     }
+    endActiveSegment();
 }
 /*virtual*/ void ComputationNetwork::PARTraversalFlowControlNode::RequestMatricesBeforeForwardProp(MatrixPool& matrixPool) /*override*/
 {
@@ -238,13 +545,18 @@ static bool DumpNode(ComputationNodeBasePtr nodep, bool dumpGradient)
 /*virtual*/ void ComputationNetwork::SEQTraversalFlowControlNode::BeginForwardProp() /*override*/
 {
     // take the opportunity to check that layout is shared by all nodes in the loop
-    // TODO: we should do this in a constructor.
-    for (auto& node : m_nestedNodes)
+    // Layout bindings are fixed once the network is compiled, so re-run this only when the
+    // binding changed (i.e. effectively once), not every minibatch.
+    if (GetMBLayout().get() != m_layoutConsistencyCheckedFor)
     {
-        if (node->GetMBLayout() != GetMBLayout())
-            LogicError("Evaluate: All nodes inside a recurrent loop must have a layout that is identical; mismatch found for nodes '%ls' (%ls) vs. '%ls' (%ls)",
-                       node            ->NodeName().c_str(), node            ->GetMBLayoutAxisString().c_str(),
-                       m_nestedNodes[0]->NodeName().c_str(), m_nestedNodes[0]->GetMBLayoutAxisString().c_str());
+        for (auto& node : m_nestedNodes)
+        {
+            if (node->GetMBLayout() != GetMBLayout())
+                LogicError("Evaluate: All nodes inside a recurrent loop must have a layout that is identical; mismatch found for nodes '%ls' (%ls) vs. '%ls' (%ls)",
+                           node            ->NodeName().c_str(), node            ->GetMBLayoutAxisString().c_str(),
+                           m_nestedNodes[0]->NodeName().c_str(), m_nestedNodes[0]->GetMBLayoutAxisString().c_str());
+        }
+        m_layoutConsistencyCheckedFor = GetMBLayout().get();
     }
 
     // tell all that loop is about to commence
@@ -445,8 +757,21 @@ void ComputationNetwork::PrintComputationTree(const ComputationNodeBasePtr& root
 
 // called by model editing operations, such as DeleteNode(); and by RebuildNetwork()
 // These invalidates any post-processed structures. If they are accessed, we will fail.
+// Instead of discarding them outright, we stash them away together with a snapshot of the
+// current wiring; CompileNetwork() restores them if the wiring turns out unchanged.
 void ComputationNetwork::InvalidateCompiledNetwork()
 {
+    if (m_isCompiled) // only a compiled network has structures worth stashing; repeated invalidation keeps the stash
+    {
+        m_compilationCache.topology             = CurrentTopology();
+        m_compilationCache.allRoots             = m_allRoots;
+        m_compilationCache.allSEQNodes          = std::move(m_allSEQNodes);
+        m_compilationCache.evalOrders           = std::move(m_evalOrders);
+        m_compilationCache.nestedNetworks       = std::move(m_nestedNetworks);
+        m_compilationCache.inputValues          = std::move(m_inputValues);
+        m_compilationCache.learnableParameters  = std::move(m_learnableParameters);
+        m_compilationCache.valid = true;
+    }
     m_isCompiled = false;
     m_allSEQNodes.clear();
     m_evalOrders.clear();
@@ -455,6 +780,21 @@ void ComputationNetwork::InvalidateCompiledNetwork()
     m_learnableParameters.clear();
 }
 
+// snapshot of the network's wiring, for deciding whether cached compilation results are still valid.
+// One (node, inputs) entry per node, in name-map order so that the comparison is deterministic.
+// A deleted or added node, a rewired input, or a rename all change this snapshot.
+vector<pair<ComputationNodeBasePtr, vector<ComputationNodeBasePtr>>> ComputationNetwork::CurrentTopology() const
+{
+    vector<pair<ComputationNodeBasePtr, vector<ComputationNodeBasePtr>>> topology;
+    topology.reserve(m_nameToNodeMap.size());
+    for (const auto& iter : m_nameToNodeMap)
+    {
+        const auto& node = iter.second;
+        topology.emplace_back(node, node->GetInputs());
+    }
+    return topology;
+}
+
 // verify that network has undergone CompileNetwork()
 void ComputationNetwork::VerifyIsCompiled(const char* where) const
 {
@@ -475,6 +815,25 @@ void ComputationNetwork::CompileNetwork()
     // Or just invalidate it again, which is easier and safer.
     InvalidateCompiledNetwork();
 
+    // STEP: Optionally fuse elementwise node chains into single fused nodes.
+    // Must happen before roots/eval orders are formed, so the fused nodes go through
+    // validation and allocation like any other node.
+    if (Globals::ShouldFuseElementwiseOps())
+    {
+        size_t numFused = FuseElementwiseChains();
+        if (TraceLevel() > 0 && numFused > 0)
+            fprintf(stderr, "\nFused %d elementwise node chains.\n", (int) numFused);
+    }
+
+    // STEP: Optionally fuse Convolution -> Plus(bias) -> RectifiedLinear chains into single
+    // fused nodes, under the same ordering constraint as above.
+    if (Globals::ShouldFuseConvolutionOps())
+    {
+        size_t numFused = FuseConvolutionBiasActivation();
+        if (TraceLevel() > 0 && numFused > 0)
+            fprintf(stderr, "\nFused %d convolution/bias/activation chains.\n", (int) numFused);
+    }
+
     // all steps below have to be repeated for all root nodes (=nodes without parents and PreComputeNodes)
     DetermineSetOfAllRoots();
 
@@ -488,41 +847,95 @@ void ComputationNetwork::CompileNetwork()
     // Note: Steps below are loops over root nodes. We will gradually push those loops through to the functions,
     //       to reduce redundant operation on shared portions of the network.
 
-    // STEP: Create a depth-first tree-traversal order through complete graph.
-    // TODO: Do not cache this before reordering; get list & pass to FormRecurrentLoops() which reorders it, then store it (such that GetEvalOrder(nullptr) is always valid w.r.t. loops).
-    FormEvalOrder(nullptr);
+    // STEP: If the wiring has not changed since the last compilation (e.g. a model edit only swapped
+    // parameter values), restore the cached traversal orders, loop structures, and nested networks
+    // instead of re-deriving them. Validation and time-stamp reset below still run unconditionally,
+    // since node dimensions may have changed even with identical wiring.
+    if (m_compilationCache.valid && m_compilationCache.allRoots == m_allRoots && m_compilationCache.topology == CurrentTopology())
+    {
+        if (TraceLevel() > 0)
+            fprintf(stderr, "\nNetwork wiring unchanged; reusing cached traversal orders and loop structures.\n");
+        m_allSEQNodes          = std::move(m_compilationCache.allSEQNodes);
+        m_evalOrders           = std::move(m_compilationCache.evalOrders);
+        m_nestedNetworks       = std::move(m_compilationCache.nestedNetworks);
+        m_inputValues          = std::move(m_compilationCache.inputValues);
+        m_learnableParameters  = std::move(m_compilationCache.learnableParameters);
+        m_compilationCache = CompilationCache();
+        // note: ResetMBLayouts() is skipped as well; the nodes still carry the bindings from the
+        // previous compilation, which are valid since the wiring (and hence axis sharing) is unchanged
+    }
+    else
+    {
+        m_compilationCache = CompilationCache(); // drop a stale cache, releasing its node references
 
-    // STEP: Form the m_inputValues and m_learnableParameters sets for the entire network.
-    // Needed for ResetMBLayouts() below.
-    // TODO: Move this further down; or decide whether the 'nullptr' version is needed, other than ResetMBLayouts() which could use the global order and filter by itself.
-    CollectInputAndLearnableParameters(nullptr);
+        // STEP: Create a depth-first tree-traversal order through complete graph.
+        // TODO: Do not cache this before reordering; get list & pass to FormRecurrentLoops() which reorders it, then store it (such that GetEvalOrder(nullptr) is always valid w.r.t. loops).
+        FormEvalOrder(nullptr);
 
-    // STEP: Establish time-axis relationships.
-    // This sets all MBLayout pointers of Input nodes according to user spec of time axes.
-    // TODO: Don't use m_inputValues, traverse ourselves, to remove dependency on FormEvalOrder().
-    ResetMBLayouts();
+        // STEP: Form the m_inputValues and m_learnableParameters sets for the entire network.
+        // Needed for ResetMBLayouts() below.
+        // TODO: Move this further down; or decide whether the 'nullptr' version is needed, other than ResetMBLayouts() which could use the global order and filter by itself.
+        CollectInputAndLearnableParameters(nullptr);
 
-    // STEP: Discover nested loops.
-    FormRecurrentLoops(nullptr); // form the global one  --TODO: just use this; should be no need to do this for each root
-    //for (auto& node : m_allRoots)
-    //    FormRecurrentLoops(node); // BUGBUG: These calls are needed because they patch EvalOrders. Will be unnecessary once we move this out.
+        // STEP: Establish time-axis relationships.
+        // This sets all MBLayout pointers of Input nodes according to user spec of time axes.
+        // TODO: Don't use m_inputValues, traverse ourselves, to remove dependency on FormEvalOrder().
+        ResetMBLayouts();
 
-    // STEP: Create loop-corrected depth-first traversals and cached input/parameter sets for every actual root node.
-    for (auto& root : m_allRoots)
-    {
-        FormEvalOrder(root);
-        CollectInputAndLearnableParameters(root);
-    }
+        // STEP: Discover nested loops.
+        FormRecurrentLoops(nullptr); // form the global one  --TODO: just use this; should be no need to do this for each root
+        //for (auto& node : m_allRoots)
+        //    FormRecurrentLoops(node); // BUGBUG: These calls are needed because they patch EvalOrders. Will be unnecessary once we move this out.
 
-    // STEP: Form nested structure of PAR and SEQ traversal nodes.
-    for (auto& node : m_allRoots)
-        FormNestedNetwork(node);
+        // STEP: Create loop-corrected depth-first traversals and cached input/parameter sets for every actual root node.
+        for (auto& root : m_allRoots)
+        {
+            FormEvalOrder(root);
+            CollectInputAndLearnableParameters(root);
+        }
+
+        // STEP: Form nested structure of PAR and SEQ traversal nodes.
+        for (auto& node : m_allRoots)
+            FormNestedNetwork(node);
+    }
 
     // STEP: Infer node dimensions.
     ValidateNetwork();
 
     // STEP: Optimize the network.
-    // :)
+    // Fold constant-only subgraphs (frozen-parameter branches, scalar scale chains) into plain
+    // constant parameters and prune the nodes that become unreachable. This needs the validated
+    // dimensions, hence it runs down here; if anything was folded, the traversal structures
+    // formed above are stale, so simply compile once more (the second pass finds nothing left
+    // to fold and terminates).
+    if (Globals::ShouldFoldConstants())
+    {
+        size_t numFolded = FoldConstantSubexpressions();
+        if (numFolded > 0)
+        {
+            if (TraceLevel() > 0)
+                fprintf(stderr, "\nFolded %d constant subexpressions.\n", (int) numFolded);
+            CompileNetwork();
+            return;
+        }
+    }
+
+    // Absorb explicit matrix-transpose copies feeding the left operand of a matrix product into
+    // the product itself (Times <-> TransposeTimes), since the underlying GEMM takes the
+    // transposition as a mere flag. Needs the validated dimensions (only a rank<=2 swap of axes
+    // 1 and 2 is a matrix transpose), hence it runs down here; as with folding, a successful
+    // rewrite leaves the traversal structures stale, so simply compile once more.
+    if (Globals::ShouldAbsorbTransposes())
+    {
+        size_t numAbsorbed = AbsorbTransposesIntoTimes();
+        if (numAbsorbed > 0)
+        {
+            if (TraceLevel() > 0)
+                fprintf(stderr, "\nAbsorbed %d transposes into matrix products.\n", (int) numAbsorbed);
+            CompileNetwork();
+            return;
+        }
+    }
 
     // STEP: Some final details.
     ResetEvalTimeStamps(); // invalidate all m_value fields. Really belongs into StartEvaluateMinibatchLoop()
@@ -1094,6 +1507,45 @@ void ComputationNetwork::AllocateAllMatrices(const std::vector<ComputationNodeBa
         }
     }
 
+    // Gradient checkpointing: drop designated segment-interior values after the forward pass and
+    // recompute them during Backprop(), cf. PlanGradientCheckpointing()
+    if (performingBackPropagation && !m_gradientCheckpointNodeNames.empty())
+        PlanGradientCheckpointing(trainRootNode, outputValueNeededDuringBackProp, parentsMap);
+
+    // In-place forward pass: let an elementwise node overwrite its input's value buffer with its
+    // output when liveness permits. The input must have no other consumer, its value must not be
+    // needed during backprop (which covers the aliasing node's own BackpropTo()), and both values
+    // must be regular pooled dense matrices of identical geometry. Loops are excluded since their
+    // nodes evaluate frame by frame under separate buffer management.
+    if (Globals::ShouldEnableShareNodeValueMatrices())
+    {
+        for (auto& node : uniqueForwardPropEvalNodes)
+        {
+            int aliasInputIndex = node->ImplementsInPlaceForwardOptimization();
+            if (aliasInputIndex < 0 || aliasInputIndex >= (int) node->GetNumInputs())
+                continue;
+            auto input = node->GetInputs()[aliasInputIndex];
+            if (node->IsPartOfLoop() || input->IsPartOfLoop())
+                continue;
+            // values involved in gradient checkpointing have their own lifetime scheme
+            if (node->IsValueRecomputeNeeded() || input->IsValueRecomputeNeeded())
+                continue;
+            if (!node->IsValueSharable() || node->IsValueSparse() || !input->IsValueSharable() || input->IsValueSparse())
+                continue;
+            if (node->GetDeviceId() != input->GetDeviceId())
+                continue;
+            // geometries must match exactly; under broadcasting, output elements no longer map 1:1 onto input elements
+            if (node->GetSampleLayout().GetNumElements() != input->GetSampleLayout().GetNumElements() || node->GetMBLayout() != input->GetMBLayout())
+                continue;
+            // the input's value must die with this node's ForwardProp()
+            if (parentsMap[input].size() != 1 || std::count(node->GetInputs().begin(), node->GetInputs().end(), input) > 1)
+                continue;
+            if (outputValueNeededDuringBackProp[input])
+                continue;
+            node->MarkValueAliasesInput((size_t) aliasInputIndex);
+        }
+    }
+
     m_matrixPool.ResetStepCounter();
 
     TravserseInSortedGlobalEvalOrder(forwardPropRoots, [&outputValueNeededDuringBackProp, &parentsMap, this](const ComputationNodeBasePtr& node) {
@@ -1168,7 +1620,110 @@ void ComputationNetwork::AllocateAllMatrices(const std::vector<ComputationNodeBa
 
     // print the memory sharing structure
     if (TraceLevel() > 0)
+    {
         PrintMemorySharingStructure(GetAllNodes());
+        auto poolStats = m_matrixPool.GetStats();
+        fprintf(stderr, "\nMatrix pool: %d shareable requests backed by %d buffers, %.1f MB pre-reserved.\n",
+                (int) poolStats.requestCount, (int) poolStats.bufferCount, poolStats.retainedBytes / (1024.0 * 1024.0));
+    }
+}
+
+// Gradient checkpointing (activation recomputation). The nodes named in m_gradientCheckpointNodeNames
+// cut the backprop evaluation order into segments. Values inside a segment are not kept alive from
+// the forward to the backward pass; their buffers go back to the pool right after their last forward
+// use, and PARTraversalFlowControlNode::Backprop() re-evaluates them into temporary scratch matrices
+// when the backward sweep reaches the segment. Only values whose every backprop-time consumer sits
+// in the node's own segment can be dropped; everything else (the checkpoints themselves, loop nodes,
+// sparse or non-sharable values, values consumed across segment boundaries) stays resident as before.
+void ComputationNetwork::PlanGradientCheckpointing(const ComputationNodeBasePtr& trainRootNode,
+                                                   std::unordered_map<ComputationNodeBasePtr, bool>& outputValueNeededDuringBackProp,
+                                                   const std::unordered_map<ComputationNodeBasePtr, std::unordered_set<ComputationNodeBasePtr>>& parentsMap)
+{
+    if (!Globals::ShouldEnableShareNodeValueMatrices())
+    {
+        fprintf(stderr, "WARNING: gradientCheckpointNodes were specified but value-matrix sharing is disabled; gradient checkpointing is inactive.\n");
+        return;
+    }
+
+    // reset stale state on all nodes; nodes outside the training network keep segment -1,
+    // which conservatively forces any value they consume to stay resident
+    for (const auto& node : GetAllNodes())
+    {
+        node->SetGradientCheckpointSegment(-1);
+        node->SetValueRecomputeNeeded(false);
+    }
+
+    // assign segment ids along the evaluation order; a segment ends right behind each checkpoint node
+    const std::list<ComputationNodeBasePtr>& nodes = GetEvalOrder(trainRootNode);
+    int segment = 0;
+    size_t numCheckpoints = 0;
+    for (const auto& node : nodes)
+    {
+        node->SetGradientCheckpointSegment(segment);
+        if (m_gradientCheckpointNodeNames.find(node->NodeName()) != m_gradientCheckpointNodeNames.end())
+        {
+            if (node->IsPartOfLoop())
+                InvalidArgument("gradientCheckpointNodes: %ls is part of a recurrent loop and cannot serve as a checkpoint.", node->NodeName().c_str());
+            numCheckpoints++;
+            segment++;
+        }
+    }
+    if (numCheckpoints == 0)
+    {
+        fprintf(stderr, "WARNING: none of the gradientCheckpointNodes occur in the training network; gradient checkpointing is inactive.\n");
+        return;
+    }
+
+    // In reverse evaluation order (so parents are decided before their inputs), determine for each
+    // value whether it can be dropped. A value's backprop-time consumers are parents that read it
+    // in their BackpropTo(), parents that are themselves recomputed (re-running their ForwardProp()
+    // reads all inputs), and the node's own BackpropTo(). Scratch values only live while their
+    // segment is being backpropagated, so all consumers must lie in the node's own segment.
+    size_t numDropped = 0;
+    for (auto iter = nodes.rbegin(); iter != nodes.rend(); ++iter)
+    {
+        const auto& node = *iter;
+        bool usedDuringBackprop = node->NeedsGradient() && node->OutputUsedInComputingInputNodesGradients();
+        bool usedInOwnSegmentOnly = true;
+        auto parents = parentsMap.find(node);
+        if (parents != parentsMap.end())
+        {
+            for (const auto& parent : parents->second)
+            {
+                bool parentUsesValue = parent->IsValueRecomputeNeeded();
+                if (!parentUsesValue && parent->NeedsGradient())
+                {
+                    const auto& parentInputs = parent->GetInputs();
+                    for (size_t i = 0; i < parentInputs.size(); i++)
+                        if (parentInputs[i] == node && parent->InputUsedInComputingInputNodesGradients(i))
+                            parentUsesValue = true;
+                }
+                if (!parentUsesValue)
+                    continue;
+                usedDuringBackprop = true;
+                if (parent->GradientCheckpointSegment() != node->GradientCheckpointSegment())
+                    usedInOwnSegmentOnly = false;
+            }
+        }
+        if (!usedDuringBackprop)
+            continue; // the value dies after the forward pass anyway; nothing to decide
+
+        bool droppable = node != trainRootNode &&
+                         m_gradientCheckpointNodeNames.find(node->NodeName()) == m_gradientCheckpointNodeNames.end() &&
+                         !node->IsPartOfLoop() && node->IsValueSharable() && !node->IsValueSparse();
+        if (droppable && usedInOwnSegmentOnly)
+        {
+            node->SetValueRecomputeNeeded(true);
+            outputValueNeededDuringBackProp[node] = false;
+            numDropped++;
+        }
+        else // must stay resident, e.g. because it feeds a recomputation or is consumed across a segment boundary
+            outputValueNeededDuringBackProp[node] = true;
+    }
+
+    if (TraceLevel() > 0)
+        fprintf(stderr, "Gradient checkpointing: %d checkpoint nodes found; %d values will be dropped after the forward pass and recomputed during backprop.\n",
+                (int) numCheckpoints, (int) numDropped);
 }
 
 void ComputationNetwork::ReleaseMatricesAfterEvalForChildren(ComputationNodeBasePtr n, std::unordered_map<ComputationNodeBasePtr, std::unordered_set<ComputationNodeBasePtr>>& parentsMap)
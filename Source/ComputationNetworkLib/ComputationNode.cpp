@@ -764,31 +764,44 @@ void ComputationNode<ElemType>::WriteMinibatchWithFormatting(FILE* f,
                                                              bool onlyShowAbsSumForDense,
                                                              std::function<std::string(size_t)> getKeyById) const
 {
-    // get minibatch matrix -> matData, matRows, matStride
+    // copy the minibatch to the host, then hand off to the static formatter below
     const Matrix<ElemType>& outputValues = outputGradient ? Gradient() : Value();
-    let matRows   = outputValues.GetNumRows();
-    let matStride = matRows; // how to get from one column to the next
     unique_ptr<ElemType[]> matDataPtr(outputValues.CopyToArray());
-    ElemType* matData = matDataPtr.get();
-    let sampleLayout = GetSampleLayout(); // this is currently only used for sparse; dense tensors are linearized
+    WriteMinibatchWithFormatting(f, matDataPtr.get(), outputValues.GetNumRows(), outputValues.GetNumCols(),
+                                 GetSampleLayout(), GetMBLayout(), fr,
+                                 onlyUpToRow, onlyUpToT, transpose, isCategoryLabel, isSparse,
+                                 labelMapping, sequenceSeparator, sequencePrologue, sequenceEpilogue, elementSeparator, sampleSeparator,
+                                 valueFormatString, onlyShowAbsSumForDense, getKeyById);
+}
+
+template <class ElemType>
+/*static*/ void ComputationNode<ElemType>::WriteMinibatchWithFormatting(FILE* f, ElemType* matData, size_t matRows, size_t matCols,
+                                                                        const TensorShape& sampleLayout, MBLayoutPtr pMBLayout, const FrameRange& fr,
+                                                                        size_t onlyUpToRow, size_t onlyUpToT, bool transpose, bool isCategoryLabel, bool isSparse,
+                                                                        const vector<string>& labelMapping, const string& sequenceSeparator,
+                                                                        const string& sequencePrologue, const string& sequenceEpilogue,
+                                                                        const string& elementSeparator, const string& sampleSeparator,
+                                                                        string valueFormatString,
+                                                                        bool onlyShowAbsSumForDense,
+                                                                        std::function<std::string(size_t)> getKeyById)
+{
+    let matStride = matRows; // how to get from one column to the next
 
     // process all sequences one by one
-    MBLayoutPtr pMBLayout = GetMBLayout();
     if (!pMBLayout) // no MBLayout: We are printing aggregates (or LearnableParameters?)
     {
         pMBLayout = make_shared<MBLayout>();
-        pMBLayout->Init(1, outputValues.GetNumCols()); // treat this as if we have one single sequence consisting of the columns
-        pMBLayout->AddSequence(0, 0, 0, outputValues.GetNumCols());
+        pMBLayout->Init(1, matCols); // treat this as if we have one single sequence consisting of the columns
+        pMBLayout->AddSequence(0, 0, 0, matCols);
     }
     let& sequences = pMBLayout->GetAllSequences();
     let  width     = pMBLayout->GetNumTimeSteps();
 
-    TensorShape tensorShape = GetSampleLayout();
     stringstream str;
-    let dims = tensorShape.GetDims();
+    let dims = sampleLayout.GetDims();
     for (auto dim : dims)
         str << dim << ' ';
-    let shape = str.str(); // BUGBUG: change to string(tensorShape) to make sure we always use the same format
+    let shape = str.str(); // BUGBUG: change to string(sampleLayout) to make sure we always use the same format
 
     bool sequencePrologueHasShape = sequencePrologue.find("%x") != sequencePrologue.npos;
     bool sampleSeparatorHasShape  = sampleSeparator.find("%x")  != sampleSeparator.npos;
@@ -864,7 +877,7 @@ void ComputationNode<ElemType>::WriteMinibatchWithFormatting(FILE* f,
         {
             if (formatChar == 's') // verify label dimension
             {
-                if (outputValues.GetNumRows() != labelMapping.size() &&
+                if (matRows != labelMapping.size() &&
                     sampleLayout[0] != labelMapping.size()) // if we match the first dim then use that
                 {
                     static size_t warnings = 0;
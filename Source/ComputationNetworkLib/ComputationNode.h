@@ -55,7 +55,8 @@
 #define CNTK_MODEL_VERSION_23 23 // pooling: add include pad func for average pooling
 #define CNTK_MODEL_VERSION_24 24 // ReduceElements: add keepDimensions
 #define CNTK_MODEL_VERSION_25 25 // transpose: allow specifying a permutation
-#define CURRENT_CNTK_MODEL_VERSION CNTK_MODEL_VERSION_25
+#define CNTK_MODEL_VERSION_26 26 // ReduceElements: accept multiple axes
+#define CURRENT_CNTK_MODEL_VERSION CNTK_MODEL_VERSION_26
 
 
 // helper mode for debugging
@@ -166,7 +167,7 @@ struct ComputationNetworkOwnedNodeState
     friend class ComputationNetwork;
 
     ComputationNetworkOwnedNodeState()
-        : m_needsGradient(false), m_needsDynamicValidation(false), m_valueSharable(true), m_parentOverwritesGradient(false)
+        : m_needsGradient(false), m_needsDynamicValidation(false), m_valueSharable(true), m_parentOverwritesGradient(false), m_valueAliasInputIndex(-1)
     {
         PurgeStateForFormingRecurrentLoops();
         m_isPartOfLoop = false;
@@ -184,6 +185,7 @@ struct ComputationNetworkOwnedNodeState
         other.m_traceNodeValueUpToDim         = m_traceNodeValueUpToDim;
         other.m_traceNodeValueUpToT           = m_traceNodeValueUpToT;
         other.m_parentOverwritesGradient = m_parentOverwritesGradient;
+        other.m_valueAliasInputIndex = m_valueAliasInputIndex;
     }
 
     bool IsPartOfLoop() const { return m_isPartOfLoop; }
@@ -191,6 +193,16 @@ struct ComputationNetworkOwnedNodeState
     void MarkParentOverwritesGradient() { m_parentOverwritesGradient = true; }
     bool ParentOverwritesGradient() const { return m_parentOverwritesGradient; }
 
+    void MarkValueAliasesInput(size_t inputIndex) { m_valueAliasInputIndex = (int) inputIndex; }
+    bool ValueAliasesInput() const { return m_valueAliasInputIndex >= 0; }
+    size_t ValueAliasInputIndex() const { return (size_t) m_valueAliasInputIndex; }
+
+    // gradient checkpointing (activation recomputation), cf. ComputationNetwork::PlanGradientCheckpointing()
+    void SetGradientCheckpointSegment(int segment) { m_gradientCheckpointSegment = segment; }
+    int GradientCheckpointSegment() const { return m_gradientCheckpointSegment; }
+    void SetValueRecomputeNeeded(bool f) { m_valueRecomputeNeeded = f; }
+    bool IsValueRecomputeNeeded() const { return m_valueRecomputeNeeded; }
+
     virtual void MarkValueNonSharable() { m_valueSharable = false; }
     virtual void MarkValueSharable() { m_valueSharable = true; }
     bool IsValueSharable() const { return m_valueSharable; }
@@ -207,6 +219,12 @@ struct ComputationNetworkOwnedNodeState
 
     virtual bool ImplementsGradientOverwriteOptimization() const { return false; }
 
+    // A node whose ForwardProp() computes a strictly elementwise (same-position) function may
+    // return the index of the input whose value buffer its output could overwrite in place;
+    // -1 (default) means none. Whether the aliasing actually happens is decided by the liveness
+    // pass in ComputationNetwork::AllocateAllMatrices(), cf. MarkValueAliasesInput().
+    virtual int ImplementsInPlaceForwardOptimization() const { return -1; }
+
 protected:                // TODO: should be fully encapsulated here
     bool m_needsGradient; // true if this node or any children need a gradient to be computed (for own consumption or propagation to somewhere in the child tree)
     bool m_needsDynamicValidation;
@@ -217,6 +235,11 @@ protected:                // TODO: should be fully encapsulated here
 
     bool m_parentOverwritesGradient; // flag indicating whether the parent of this node overwrites the gradient of this node instead of accumulating to it
 
+    int m_valueAliasInputIndex; // >= 0 if this node's value shares its buffer with that input's value (in-place forward)
+
+    int m_gradientCheckpointSegment = -1; // index of the recompute segment this node belongs to; -1 when gradient checkpointing is off
+    bool m_valueRecomputeNeeded = false;  // true if this node's value is dropped after the forward pass and recomputed during backprop
+
 private:
     bool m_isPartOfLoop; // true if this loop is part of a recurrent loop
 
@@ -645,6 +668,12 @@ public:
 
     DEVICEID_TYPE GetDeviceId() const { return m_deviceId; }
 
+    // Repin this node onto another device, for partitioning a network across GPUs
+    // (pipeline-style model parallelism). Matrices that have already been materialized
+    // (parameter values in particular) are moved along by the typed override; pooled value
+    // and gradient matrices follow at the next memory allocation.
+    virtual void MoveToDevice(DEVICEID_TYPE deviceId) { m_deviceId = deviceId; }
+
     // helper to access to element(0,0) without having to type-cast
     virtual double Get00Element() const = 0;
     virtual MatrixBasePtr ValuePtr() const = 0; // for use in readers that pass the agnostic object around
@@ -809,11 +838,22 @@ public:
     virtual bool InputUsedInComputingInputNodesGradients(size_t /*childIndex*/) const { return true; }
 
     void SetOutputNeededDuringBackprop(bool f) { m_outputNeededDuringBackprop = f; }
-    bool IsOutputNeededDuringBackprop() const 
-    { 
-        return !Globals::ShouldEnableShareNodeValueMatrices() || m_outputNeededDuringBackprop; 
+    bool IsOutputNeededDuringBackprop() const
+    {
+        return !Globals::ShouldEnableShareNodeValueMatrices() || m_outputNeededDuringBackprop;
     }
 
+    // Inference-time eager value release (Globals::ShouldEagerlyReleaseValues()): drop this node's
+    // value memory once its last consumer's ForwardProp() has completed, cf.
+    // PARTraversalFlowControlNode::CompileValueReleasePlan(). Implemented by ComputationNode<ElemType>.
+    virtual void ReleaseValueForInference() {}
+
+    // gradient checkpointing: redirect Value() to a private scratch matrix while this node's value
+    // is recomputed during backprop (its pooled buffer was surrendered after the forward pass),
+    // and restore the pooled binding afterwards so the next forward pass works on the planned buffer
+    virtual void BeginValueRecompute() { }
+    virtual void EndValueRecompute() { }
+
     // -----------------------------------------------------------------------
     // helpers for network traversal
     // -----------------------------------------------------------------------
@@ -1794,7 +1834,12 @@ public:
     {
         size_t matrixSize = m_sampleLayout.GetNumElements();
         if (IsValueSharable() && !m_isValueSparse)
-            RequestMatrixFromPool(m_value, matrixPool, matrixSize, HasMBLayout());
+        {
+            if (ValueAliasesInput() && m_value == nullptr) // in-place forward: share the input's buffer
+                matrixPool.RequestAliasedAllocate<ElemType>(m_deviceId, &InputRef(ValueAliasInputIndex()).m_value, &m_value, matrixSize, HasMBLayout(), NodeName());
+            else
+                RequestMatrixFromPool(m_value, matrixPool, matrixSize, HasMBLayout());
+        }
         else
             CreateMatrixIfNull(m_value);
 
@@ -1819,6 +1864,51 @@ public:
             ReleaseMatrixToPool(m_value, matrixPool);
     }
 
+    // inference-time eager release: the last consumer's ForwardProp() has completed, so this
+    // node's value is dead for the remainder of the pass and its memory can go back to the
+    // device. The time stamp is knocked back so that a later traversal (e.g. for another
+    // evaluation root) recomputes the value instead of reusing the freed matrix.
+    virtual void ReleaseValueForInference() override
+    {
+        if (m_value)
+            m_value->Resize(0, 0, 0, /*growOnly=*/false);
+        auto multiOutputNode = dynamic_cast<MultiOutputNode<ElemType>*>(this);
+        if (multiOutputNode)
+        {
+            for (size_t i = 1; i < multiOutputNode->m_numOutputs; ++i)
+            {
+                if (!multiOutputNode->m_outputsIsValueSparse[i] && multiOutputNode->m_outputsValue[i])
+                    multiOutputNode->m_outputsValue[i]->Resize(0, 0, 0, /*growOnly=*/false);
+            }
+        }
+        SetEvalTimeStampOutdatedWrtAll();
+    }
+
+    // device repinning for cross-GPU partitioning: move any already materialized matrices
+    // along, so that parameter values end up on the new device before the next forward pass
+    virtual void MoveToDevice(DEVICEID_TYPE deviceId) override
+    {
+        Base::MoveToDevice(deviceId);
+        if (m_value)
+            m_value->TransferToDeviceIfNotThere(deviceId, /*isBeingMoved=*/true);
+        if (m_gradient)
+            m_gradient->TransferToDeviceIfNotThere(deviceId, /*isBeingMoved=*/true);
+    }
+
+    // gradient checkpointing: park the pooled value binding and substitute a private scratch
+    // matrix for the duration of one segment's recomputation, cf. ComputationNetworkOwnedNodeState
+    virtual void BeginValueRecompute() override
+    {
+        m_recomputeSavedValue = m_value;
+        m_value = make_shared<Matrix<ElemType>>(m_deviceId);
+    }
+
+    virtual void EndValueRecompute() override
+    {
+        m_value = m_recomputeSavedValue; // this drops the scratch matrix, freeing its memory
+        m_recomputeSavedValue = nullptr;
+    }
+
     virtual void AllocateGradientMatricesForInputs(MatrixPool& matrixPool) override
     {
         for (int i = 0; i < m_inputs.size(); i++)
@@ -1905,7 +1995,7 @@ protected:
     {
         if (matrixPtr == nullptr)
         {
-            matrixPool.RequestAllocate<ElemType>(m_deviceId, &matrixPtr, matrixSize, mbScale, isWorkSpace);
+            matrixPool.RequestAllocate<ElemType>(m_deviceId, &matrixPtr, matrixSize, mbScale, isWorkSpace, NodeName());
         }
     }
 
@@ -1930,6 +2020,19 @@ public:
                                       bool outputGradient = false, bool onlyShowAbsSumForDense = false,
                                       std::function<std::string(size_t)> getKeyById = std::function<std::string(size_t)>()) const;
 
+    // static variant that formats an already-transferred host-side copy of the minibatch
+    // The instance method above delegates to this. Callers that copied the data and layout off the node
+    // themselves (e.g. to format on a background thread while the node is reused) can call it directly.
+    // Note: 'matData' may be modified in place (category labels are reduced to their argmax).
+    static void WriteMinibatchWithFormatting(FILE* f, ElemType* matData, size_t matRows, size_t matCols,
+                                             const TensorShape& sampleLayout, MBLayoutPtr pMBLayout, const FrameRange& fr,
+                                             size_t onlyUpToRow, size_t onlyUpToT, bool transpose, bool isCategoryLabel, bool isSparse,
+                                             const std::vector<std::string>& labelMapping, const std::string& sequenceSeparator,
+                                             const std::string& sequencePrologue, const std::string& sequenceEpilogue, const std::string& elementSeparator,
+                                             const std::string& sampleSeparator, std::string valueFormatString,
+                                             bool onlyShowAbsSumForDense = false,
+                                             std::function<std::string(size_t)> getKeyById = std::function<std::string(size_t)>());
+
     // simple helper to log the content of a minibatch
     void DebugLogMinibatch(bool outputGradient = false) const
     {
@@ -2097,6 +2200,7 @@ public:
 protected:
 
     shared_ptr<Matrix<ElemType>> m_value, m_gradient;
+    shared_ptr<Matrix<ElemType>> m_recomputeSavedValue; // pooled value binding, parked during BeginValueRecompute()/EndValueRecompute()
 
     static std::map<size_t, std::map<size_t, shared_ptr<Matrix<ElemType>>>> s_constOnes;
 
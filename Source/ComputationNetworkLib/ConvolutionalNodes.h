@@ -171,6 +171,7 @@ public:
     PoolKind PoolingKind() const { return m_poolKind; }
     bool CeilOutDim() const { return m_ceilOutDim; }
     bool PoolIncludePad() const { return m_poolIncludePad; }
+    ImageLayoutKind ImageLayout() const { return m_imageLayout; }
 
     // bottomlessly expand shape to filterRank, then expand to inputRank using defaults or given 'from' values
     template<class V, typename T>
@@ -578,7 +579,11 @@ public:
     void RequestMatricesBeforeForwardProp(MatrixPool& matrixPool) override
     {
         Base::RequestMatricesBeforeForwardProp(matrixPool);
-        RequestMatrixFromPool(m_tempMatrixForward, matrixPool, 0, false, true);
+        // All convolution workspaces land in the pool's shared workspace arena; pass the engine's
+        // reported requirement so the arena is pre-sized to the max across all convolution nodes
+        // instead of growing piecemeal during the first minibatches (0 = unknown, grow on use).
+        size_t workspaceSize = m_convEng ? m_convEng->MaxWorkspaceSizePerSample() : 0;
+        RequestMatrixFromPool(m_tempMatrixForward, matrixPool, workspaceSize, workspaceSize != 0 /*mbScale*/, true);
     }
 
     // m_tempMatrixForward is only used as workspace for convolution, we can release it immediately afterwards
@@ -591,7 +596,8 @@ public:
     void RequestMatricesBeforeBackprop(MatrixPool& matrixPool) override
     {
         Base::RequestMatricesBeforeBackprop(matrixPool);
-        RequestMatrixFromPool(m_tempMatrixBackward, matrixPool, 0, false, true);
+        size_t workspaceSize = m_convEng ? m_convEng->MaxWorkspaceSizePerSample() : 0;
+        RequestMatrixFromPool(m_tempMatrixBackward, matrixPool, workspaceSize, workspaceSize != 0 /*mbScale*/, true);
     }
 
     void ReleaseMatricesAfterBackprop(MatrixPool& matrixPool) override
@@ -641,6 +647,199 @@ protected:
     bool m_convolution2D;
 };
 
+// -----------------------------------------------------------------------
+// ConvolutionBiasActivationNode (convolutionWeights, inputFeature, bias)
+// Fused convolution -> add-per-map-bias -> rectifier, created from
+// Convolution -> Plus -> RectifiedLinear chains by
+// ComputationNetwork::FuseConvolutionBiasActivation(). When the engine
+// provides a fused entry point (cuDNN), the whole triple runs as a single
+// kernel; otherwise the bias-add and rectifier run as one elementwise pass
+// over the convolution output. Either way the two intermediate
+// materializations of the unfused chain are gone. Only the canonical CNN
+// pattern is fused: non-transposed CHW convolution with a learnable bias
+// of one value per output feature map.
+// -----------------------------------------------------------------------
+
+template <class ElemType>
+class ConvolutionBiasActivationNode : public ConvolutionNodeBase<ElemType>, public NumInputs<3>, public TransformerNode
+{
+    typedef ConvolutionNodeBase<ElemType> Base; UsingConvolutionNodeBaseMembers;
+    static const std::wstring TypeName() { return L"ConvolutionBiasActivation"; }
+public:
+    DeclareConstructorFromConfigWithNumInputs(ConvolutionBiasActivationNode);
+    ConvolutionBiasActivationNode(DEVICEID_TYPE deviceId, const wstring& name)
+        : Base(deviceId, name)
+    {
+    }
+    ConvolutionBiasActivationNode(DEVICEID_TYPE deviceId, const wstring& name, const TensorShape& kernelShape, const TensorShape& mapCount, const TensorShape& strideShape,
+                                  const std::vector<bool>& sharing, const std::vector<bool>& autoPadding, const TensorShape& lowerPad, const TensorShape& upperPad,
+                                  ImageLayoutKind imageLayout, size_t maxTempMemSizeInSamples)
+                                  : Base(deviceId, name, kernelShape, mapCount, strideShape, sharing, autoPadding, lowerPad, upperPad, PoolKind::None, false, false, TensorShape(0), false, imageLayout, maxTempMemSizeInSamples)
+    {
+    }
+
+    virtual bool ImplementsGradientOverwriteOptimization() const override { return m_convEng->ImplementsGradientOverwriteOptimization(); }
+
+    void ForwardProp(const FrameRange& fr) override
+    {
+        Matrix<ElemType> sliceOutputValue = ValueFor(fr);
+        const Matrix<ElemType>& input0 = InputRef(0).ValueAsMatrix();
+        Matrix<ElemType> sliceInput1Value = InputRef(1).ValueFor(fr);
+        if (m_convEng->ImplementsFusedBiasActivation())
+            m_convEng->ForwardBiasActivation(sliceInput1Value, input0, InputRef(2).Value(), sliceOutputValue, *m_tempMatrixForward);
+        else
+        {
+            // engines without a fused entry point still save the intermediate sum: convolve,
+            // then add the bias and apply the rectifier in a single elementwise pass
+            m_convEng->Forward(sliceInput1Value, input0, sliceOutputValue, *m_tempMatrixForward);
+            size_t rank = DetermineElementwiseTensorRank();
+            auto output = ValueTensorFor(rank, fr);
+            auto bias = InputRef(2).ValueTensorFor(rank, fr.AllowBroadcast());
+            output.DoBinaryOpOf(0, output, bias, 1, ElementWiseOperator::opLinearRectifierOfSum, ElementWiseOperator::opSum);
+        }
+    }
+
+    void BackpropTo(const size_t inputIndex, const FrameRange& fr) override
+    {
+        // this potentially computes over time, so we must mask gaps to 0
+        if (Input(inputIndex)->ReducesInTimeWrt(shared_from_this()))
+            MaskMissingGradientColumnsToZero(fr);
+        if (inputIndex < 2 && Input(inputIndex)->ReducesInTimeWrt(Input(1 - inputIndex)))
+            Input(1 - inputIndex)->MaskMissingValueColumnsToZero(fr);
+
+        // All three gradients need the pre-activation gradient, outGrad * Relu'(out), which the
+        // unfused chain would read from the Plus node. It is cheap (one elementwise pass) and is
+        // recomputed per input, since the order of BackpropTo calls is not guaranteed.
+        size_t rank = DetermineElementwiseTensorRank();
+        m_tempActivationGrad->Resize(Value());
+        auto preActGrad = DataTensorFor(m_tempActivationGrad, rank, fr);
+        auto outputGrad = GradientTensorFor(rank, fr);
+        auto outputValue = ValueTensorFor(rank, fr);
+        preActGrad.DoBinaryOpOf(0, outputGrad, outputValue, 1, ElementWiseOperator::opElementwiseProductWithLinearRectifierDerivativeFromOutput, ElementWiseOperator::opSum);
+
+        if (inputIndex == 0) // derivative with respect to the weight matrix
+        {
+            auto& grad = InputRef(0).GradientAsMatrix();
+            auto sliceInput1Value = InputRef(1).ValueFor(fr);
+            auto sliceActGrad = DataFor(*m_tempActivationGrad, fr);
+            m_convEng->BackwardKernel(sliceActGrad, sliceInput1Value, grad, !Input(inputIndex)->ParentOverwritesGradient(), fr.IsAllFrames(), *m_tempMatrixBackward);
+        }
+        else if (inputIndex == 1) // derivative with respect to the input feature
+        {
+            auto& input0 = InputRef(0).ValueAsMatrix();
+            auto sliceInput1Grad = InputRef(1).GradientFor(fr);
+            auto sliceActGrad = DataFor(*m_tempActivationGrad, fr);
+            m_convEng->BackwardData(sliceActGrad, input0, sliceInput1Grad, !Input(inputIndex)->ParentOverwritesGradient(), *m_tempMatrixBackward);
+        }
+        else if (inputIndex == 2) // derivative with respect to the bias: reduce over all but the map dimension
+        {
+            auto biasGrad = InputRef(2).GradientTensorFor(rank, fr.AllowBroadcast());
+            biasGrad.DoCopyOf(Input(inputIndex)->ParentOverwritesGradient() ? 0.0f : 1.0f, preActGrad, 1);
+        }
+    }
+
+    void Validate(bool isFinalValidationPass) override
+    {
+        Base::Validate(isFinalValidationPass);
+        InferMBLayoutFromInputsForStandardCase(isFinalValidationPass);
+
+        auto inputShape = GetInputSampleLayout(1);
+        // infer reduction dimensions if not given
+        InferReductionDims(inputShape, inputShape);
+        auto outputShape = ConvolveGeometry::ComputeOutputShape(inputShape, m_kernelShape, m_mapCount, m_stride,
+                                                                m_sharing, m_autoPad, m_lowerPad, m_upperPad);
+        SetDims(outputShape, HasMBLayout());
+
+        // update LearnableParameter if it has 0 dimensions (to be inferred)
+        if (Input(0)->GetSampleLayout().GetNumElements() == 0)
+        {
+            auto weightShape = m_kernelShape.GetDims();
+            for (auto outDim : m_mapCount.GetDims())
+                weightShape.push_back(outDim);
+            Input(0)->ValidateInferInputDimsFrom(TensorShape(weightShape));
+        }
+
+        if (isFinalValidationPass)
+        {
+            if (m_imageLayout != ImageLayoutKind::CHW)
+                LogicError("%ls %ls operation supports only CHW/cudnn layout.", NodeName().c_str(), OperationName().c_str());
+
+            if (Input(2)->GetSampleLayout().GetNumElements() != m_mapCount.GetNumElements())
+                InvalidArgument("%ls %ls operation requires the bias to have one value per output feature map.", NodeName().c_str(), OperationName().c_str());
+
+            if (m_convEng == nullptr)
+            {
+                auto geometry = std::make_shared<ConvolveGeometry>(inputShape, m_kernelShape, m_mapCount, m_stride,
+                                                                   m_sharing, m_autoPad, m_lowerPad, m_upperPad);
+                m_convEng = ConvolutionEngine<ElemType>::Create(geometry, m_deviceId, m_imageLayout,
+                                                                m_maxTempMemSizeInSamples, m_poolKind,
+                                                                ConvolutionEngineKind::All, NodeName(), Globals::ShouldForceDeterministicAlgorithms());
+            }
+
+            if (Input(0)->GetSampleLayout().GetNumElements() != m_kernelShape.GetNumElements() * m_convEng->Geometry()->KernelCount())
+            {
+                LogicError("Convolution weight matrix %ls should have dimension [(filter shape) x (input channels) x (output channels)]",
+                           Input(0)->NodeName().c_str());
+            }
+        }
+    }
+
+    void RequestMatricesBeforeForwardProp(MatrixPool& matrixPool) override
+    {
+        Base::RequestMatricesBeforeForwardProp(matrixPool);
+        size_t workspaceSize = m_convEng ? m_convEng->MaxWorkspaceSizePerSample() : 0;
+        RequestMatrixFromPool(m_tempMatrixForward, matrixPool, workspaceSize, workspaceSize != 0 /*mbScale*/, true);
+    }
+
+    void ReleaseMatricesAfterForwardProp(MatrixPool& matrixPool) override
+    {
+        Base::ReleaseMatricesAfterForwardProp(matrixPool);
+        ReleaseMatrixToPool(m_tempMatrixForward, matrixPool);
+    }
+
+    void RequestMatricesBeforeBackprop(MatrixPool& matrixPool) override
+    {
+        Base::RequestMatricesBeforeBackprop(matrixPool);
+        size_t workspaceSize = m_convEng ? m_convEng->MaxWorkspaceSizePerSample() : 0;
+        RequestMatrixFromPool(m_tempMatrixBackward, matrixPool, workspaceSize, workspaceSize != 0 /*mbScale*/, true);
+        RequestMatrixFromPool(m_tempActivationGrad, matrixPool, GetSampleLayout().GetNumElements(), HasMBLayout());
+    }
+
+    void ReleaseMatricesAfterBackprop(MatrixPool& matrixPool) override
+    {
+        Base::ReleaseMatricesAfterBackprop(matrixPool);
+        ReleaseMatrixToPool(m_tempMatrixBackward, matrixPool);
+        ReleaseMatrixToPool(m_tempActivationGrad, matrixPool);
+    }
+
+    // the output value is needed for the rectifier derivative in backprop
+    bool OutputUsedInComputingInputNodesGradients() const override { return true; }
+
+private:
+    using TransformerNode::m_transforms;
+    using ConvolutionNodeBase<ElemType>::ComputeFilterTransform;
+
+    virtual void /*TransformerNode::*/ComputeTransforms() override
+    {
+        if (m_transforms[1].m_axisTransforms.empty())
+        {
+            // convolution, need to inverse transform
+            m_transforms[1] = ComputeFilterTransform().Inverse();
+        }
+        // else: transform already computed, no need to do computation again.
+    }
+
+    virtual bool /*TransformerNode::*/SupportsTransformOnInput(size_t inputIndex) override
+    {
+        // We support transforms just on the convolution input.
+        return (inputIndex == 1);
+    }
+
+private:
+    // Pre-activation gradient, outGrad * Relu'(out), shaped like the output.
+    shared_ptr<Matrix<ElemType>> m_tempActivationGrad;
+};
+
 // -----------------------------------------------------------------------
 // ROIPoolingNode (inputFeatures, inputROIs)--pooling for object detection.
 //
@@ -575,112 +575,112 @@ public:
     // insPen - insertion penalty
     // squashInputs - whether to merge sequences of identical samples.
     // tokensToIgnore - list of samples to ignore during edit distance evaluation
-    static ElemType ComputeEditDistanceError(Matrix<ElemType>& firstSeq, const Matrix<ElemType> & secondSeq, MBLayoutPtr pMBLayout, 
+    static ElemType ComputeEditDistanceError(Matrix<ElemType>& firstSeq, const Matrix<ElemType> & secondSeq, MBLayoutPtr pMBLayout,
         float subPen, float delPen, float insPen, bool squashInputs, const vector<size_t>& tokensToIgnore)
     {
-        std::vector<int> firstSeqVec, secondSeqVec;
-
-        // Edit distance between subsequences
-        Matrix<float> grid(CPUDEVICE);
-        
-        // Number of insertions between subsequences
-        Matrix<float> insMatrix(CPUDEVICE);
-        
-        //Number of deletions between subsequences
-        Matrix<float> delMatrix(CPUDEVICE);
-
-        // Number of substitutions between subsequences
-        Matrix<float> subMatrix(CPUDEVICE);
-
-        float del, ins, sub;
-        ElemType wrongSampleNum = 0.0;
-        size_t totalSampleNum = 0, totalframeNum = 0;
-        size_t sequenceStartFrame = 0;
-
+        // Pull the compact 1 x cols label rows off the device in one transfer each. Reading the
+        // matrices element by element below would otherwise sync with the device once per sample
+        // when the inputs live on a GPU.
+        std::unique_ptr<ElemType[]> firstData(firstSeq.CopyToArray());
+        std::unique_ptr<ElemType[]> secondData(secondSeq.CopyToArray());
+
+        // gather the sequences of the minibatch up front, so the DP below can run over them in parallel
+        std::vector<std::pair<size_t, std::vector<size_t>>> sequences; // (numFrames, columnIndices)
         for (const auto& sequence : pMBLayout->GetAllSequences())
         {
             if (sequence.seqId == GAP_SEQUENCE_ID)
                 continue;
 
             auto numFrames = pMBLayout->GetNumSequenceFramesInCurrentMB(sequence);
-
             if (numFrames > 0)
+                sequences.emplace_back(numFrames, pMBLayout->GetColumnIndices(sequence));
+        }
+
+        float wrongSampleNum = 0.0f;
+        size_t totalSampleNum = 0, totalframeNum = 0;
+
+        // Each sequence's DP table is independent of the others. The DP only ever looks at the
+        // previous row, so two rolling rows per quantity replace the former full
+        // (firstSize+1) x (secondSize+1) matrices; the insertion/deletion/substitution counts
+        // are tracked alongside the distance, since with non-unit penalties the operation count
+        // is not derivable from the distance itself.
+#pragma omp parallel for schedule(dynamic) reduction(+ : wrongSampleNum, totalSampleNum, totalframeNum)
+        for (int s = 0; s < (int)sequences.size(); s++)
+        {
+            std::vector<int> firstSeqVec, secondSeqVec;
+            ExtractSampleSequence(firstData.get(), sequences[s].second, squashInputs, tokensToIgnore, firstSeqVec);
+            ExtractSampleSequence(secondData.get(), sequences[s].second, squashInputs, tokensToIgnore, secondSeqVec);
+
+            totalframeNum += sequences[s].first;
+
+            //calculate edit distance
+            size_t firstSize = firstSeqVec.size();
+            totalSampleNum += firstSize;
+            size_t secondSize = secondSeqVec.size();
+
+            // row 0: second sequence prefixes are reached by insertions only
+            std::vector<float> gridPrev(secondSize + 1), gridCur(secondSize + 1);
+            std::vector<float> insPrev(secondSize + 1), insCur(secondSize + 1);
+            std::vector<float> delPrev(secondSize + 1), delCur(secondSize + 1);
+            std::vector<float> subPrev(secondSize + 1), subCur(secondSize + 1);
+            for (size_t j = 0; j < secondSize + 1; j++)
             {
-                totalframeNum += numFrames;
-
-                auto columnIndices = pMBLayout->GetColumnIndices(sequence);
-
-                ExtractSampleSequence(firstSeq, columnIndices, squashInputs, tokensToIgnore, firstSeqVec);
-                ExtractSampleSequence(secondSeq, columnIndices, squashInputs, tokensToIgnore, secondSeqVec);
-
-                //calculate edit distance
-                size_t firstSize = firstSeqVec.size();
-                totalSampleNum += firstSize;
-                size_t secondSize = secondSeqVec.size();
-                grid.Resize(firstSize + 1, secondSize + 1);
-                insMatrix.Resize(firstSize + 1, secondSize + 1);
-                delMatrix.Resize(firstSize + 1, secondSize + 1);
-                subMatrix.Resize(firstSize + 1, secondSize + 1);
-                insMatrix.SetValue(0.0f);
-                delMatrix.SetValue(0.0f);
-                subMatrix.SetValue(0.0f);
-
-                for (size_t i = 0; i < firstSize + 1; i++)
-                {
-                    grid(i, 0) = (float)(i * delPen);
-                    delMatrix(i, 0) = (float)i;
-                }
+                gridPrev[j] = (float)(j * insPen);
+                insPrev[j] = (float)j;
+            }
 
-                for (size_t j = 0; j < secondSize + 1; j++)
-                {
-                    grid(0, j) = (float)(j * insPen);
-                    insMatrix(0, j) = (float)j;
-                }
-                for (size_t i = 1; i < firstSize + 1; i++)
+            for (size_t i = 1; i < firstSize + 1; i++)
+            {
+                // column 0: first sequence prefixes are reached by deletions only
+                gridCur[0] = (float)(i * delPen);
+                delCur[0] = (float)i;
+                insCur[0] = 0.0f;
+                subCur[0] = 0.0f;
+                for (size_t j = 1; j < secondSize + 1; j++)
                 {
-                    for (size_t j = 1; j < secondSize + 1; j++)
+                    if (firstSeqVec[i - 1] == secondSeqVec[j - 1])
+                    {
+                        gridCur[j] = gridPrev[j - 1];
+                        insCur[j] = insPrev[j - 1];
+                        delCur[j] = delPrev[j - 1];
+                        subCur[j] = subPrev[j - 1];
+                    }
+                    else
                     {
-                        if (firstSeqVec[i - 1] == secondSeqVec[j - 1])
+                        float del = gridPrev[j] + delPen; //deletion
+                        float ins = gridCur[j - 1] + insPen;  //insertion
+                        float sub = gridPrev[j - 1] + subPen; //substitution
+                        if (sub <= del && sub <= ins)
                         {
-                            grid(i, j) = grid(i - 1, j - 1);
-                            insMatrix(i, j) = insMatrix(i - 1, j - 1);
-                            delMatrix(i, j) = delMatrix(i - 1, j - 1);
-                            subMatrix(i, j) = subMatrix(i - 1, j - 1);
+                            insCur[j] = insPrev[j - 1];
+                            delCur[j] = delPrev[j - 1];
+                            subCur[j] = subPrev[j - 1] + 1.0f;
+                            gridCur[j] = sub;
+                        }
+                        else if (del < ins)
+                        {
+                            insCur[j] = insPrev[j];
+                            subCur[j] = subPrev[j];
+                            delCur[j] = delPrev[j] + 1.0f;
+                            gridCur[j] = del;
                         }
                         else
                         {
-                            del = grid(i - 1, j) + delPen; //deletion 
-                            ins = grid(i, j - 1) + insPen;  //insertion
-                            sub = grid(i - 1, j - 1) + subPen; //substitution 
-                            if (sub <= del && sub <= ins)
-                            {
-                                insMatrix(i, j) = insMatrix(i - 1, j - 1);
-                                delMatrix(i, j) = delMatrix(i - 1, j - 1);
-                                subMatrix(i, j) = subMatrix(i - 1, j - 1) + 1.0f;
-                                grid(i, j) = sub;
-                            }
-                            else if (del < ins)
-                            {
-                                insMatrix(i, j) = insMatrix(i - 1, j);
-                                subMatrix(i, j) = subMatrix(i - 1, j);
-                                delMatrix(i, j) = delMatrix(i - 1, j) + 1.0f;
-                                grid(i, j) = del;
-                            }
-                            else
-                            {
-                                delMatrix(i, j) = delMatrix(i, j - 1);
-                                subMatrix(i, j) = subMatrix(i, j - 1);
-                                insMatrix(i, j) = insMatrix(i, j - 1) + 1.0f;
-                                grid(i, j) = ins;
-                            }
+                            delCur[j] = delCur[j - 1];
+                            subCur[j] = subCur[j - 1];
+                            insCur[j] = insCur[j - 1] + 1.0f;
+                            gridCur[j] = ins;
                         }
                     }
                 }
-
-                wrongSampleNum += insMatrix(firstSize, secondSize) + delMatrix(firstSize, secondSize) + subMatrix(firstSize, secondSize);
+                gridPrev.swap(gridCur);
+                insPrev.swap(insCur);
+                delPrev.swap(delCur);
+                subPrev.swap(subCur);
             }
 
-            sequenceStartFrame += numFrames;
+            // after the final swap the 'prev' rows hold row firstSize (or row 0 for an empty first sequence)
+            wrongSampleNum += insPrev[secondSize] + delPrev[secondSize] + subPrev[secondSize];
         }
 
         return (ElemType)(wrongSampleNum * totalframeNum / totalSampleNum);
@@ -721,13 +721,13 @@ private:
     float m_insPen;
     std::vector<size_t> m_tokensToIgnore;
 
-    // Clear out_SampleSeqVec and extract a vector of samples from the matrix into out_SampleSeqVec.
-    static void ExtractSampleSequence(const Matrix<ElemType>& firstSeq, vector<size_t>& columnIndices, bool squashInputs, const vector<size_t>& tokensToIgnore, std::vector<int>& out_SampleSeqVec)
+    // Clear out_SampleSeqVec and extract a vector of samples from the (host copy of the) 1 x cols label row into out_SampleSeqVec.
+    static void ExtractSampleSequence(const ElemType* seqData, const vector<size_t>& columnIndices, bool squashInputs, const vector<size_t>& tokensToIgnore, std::vector<int>& out_SampleSeqVec)
     {
         out_SampleSeqVec.clear();
 
         // Get the first element in the sequence
-        size_t lastId = (int)firstSeq(0, columnIndices[0]);
+        size_t lastId = (int)seqData[columnIndices[0]];
         if (std::find(tokensToIgnore.begin(), tokensToIgnore.end(), lastId) == tokensToIgnore.end())
             out_SampleSeqVec.push_back(lastId);
 
@@ -737,7 +737,7 @@ private:
             //squash sequences of identical samples
             for (size_t i = 1; i < columnIndices.size(); i++)
             {
-                size_t refId = (int)firstSeq(0, columnIndices[i]);
+                size_t refId = (int)seqData[columnIndices[i]];
                 if (lastId != refId)
                 {
                     lastId = refId;
@@ -750,7 +750,7 @@ private:
         {
             for (size_t i = 1; i < columnIndices.size(); i++)
             {
-                auto refId = (int)firstSeq(0, columnIndices[i]);
+                auto refId = (int)seqData[columnIndices[i]];
                 if (std::find(tokensToIgnore.begin(), tokensToIgnore.end(), refId) == tokensToIgnore.end())
                     out_SampleSeqVec.push_back(refId);
             }
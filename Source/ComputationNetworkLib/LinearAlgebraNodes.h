@@ -68,6 +68,18 @@ public:
     }
 
     virtual bool ImplementsGradientOverwriteOptimization() const override { return true; }
+
+    virtual int /*ComputationNodeBase::*/ ImplementsInPlaceForwardOptimization() const override
+    {
+        // the sum may overwrite a summand of the same geometry as the output (the other summand may broadcast)
+        for (int i = 0; i < 2; i++)
+        {
+            const auto& input = this->GetInputs()[i];
+            if (input->GetSampleLayout().GetNumElements() == GetSampleLayout().GetNumElements() && input->GetMBLayout() == GetMBLayout())
+                return i;
+        }
+        return -1;
+    }
 };
 
 template class PlusNode<float>;
@@ -229,8 +241,13 @@ public:
             MaskMissingGradientColumnsToZero(fr);
 
         ElemType sign = inputIndex == 0 ? 1.0f : -1.0f;
-        inputGradient.AddCopyOf(gradient, sign);
+        if (Input(inputIndex)->ParentOverwritesGradient())
+            inputGradient.AssignCopyOf(gradient, sign);
+        else
+            inputGradient.AddCopyOf(gradient, sign);
     }
+
+    virtual bool ImplementsGradientOverwriteOptimization() const override { return true; }
 };
 
 template class MinusNode<float>;
@@ -300,6 +317,11 @@ public:
         else
             inputGradient.AddElementwiseProductOf(gradient, otherInputValue);
     }
+
+    // Note: BackpropToImpl() above always had the overwrite branch, but without this
+    // override it was never taken, since the input is only marked as overwritten if
+    // its parent declares support.
+    virtual bool ImplementsGradientOverwriteOptimization() const override { return true; }
 };
 
 template class ElementTimesNode<float>;
@@ -1115,6 +1137,62 @@ public:
 template class QuantizedTimesNode<float>;
 template class QuantizedTimesNode<double>;
 
+// Half-precision matrix product. Constant inputs (i.e. weights) are stored as IEEE 754 binary16,
+// halving their memory footprint, and are widened back to full precision on the fly during the product.
+// Only dense untransposed matrix multiplication will use fp16 storage. If at least one matrix is sparse then it will fall back to un-quantized default evaluation
+// Currently it works for CPU only. On GPU logicError will be thrown.
+// One way to include this node to the network is with the Edit command:
+// ...
+// node => if node.name == 'LSTMoutput1.output' then HalfPrecisionTimes(node.inputs[0], node.inputs[1]) else node,
+// ...
+// Unlike QuantizedTimes there are no quantizer parameters to tune - fp16 covers the dynamic range of typical trained weights.
+template <class ElemType>
+class HalfPrecisionTimesNode : public TimesNodeBase<ElemType, false>
+{
+    typedef TimesNodeBase<ElemType, false> Base;
+    UsingComputationNodeMembersBoilerplate;
+    static const std::wstring TypeName()
+    {
+        return L"HalfPrecisionTimes";
+    }
+
+public:
+    HalfPrecisionTimesNode(DEVICEID_TYPE deviceId, const wstring& name, size_t outputRank = 1, int inferInputRankToMap = Base::NoInferredInputRank)
+        : Base(deviceId, name, outputRank, inferInputRankToMap)
+    {
+        // TODO support multiplication on GPUs as well (native fp16 needs hardware and toolkit support).
+        if (deviceId != CPUDEVICE)
+            LogicError("Half-precision operation is supposed to be used on CPU device only.");
+
+        this->m_pQuantizedMultiplier = shared_ptr<QuantizedMultiplier<ElemType>>(new HalfPrecisionMultiplier<ElemType>());
+    }
+
+    HalfPrecisionTimesNode(const ScriptableObjects::IConfigRecordPtr configp)
+        : HalfPrecisionTimesNode(configp->Get(L"deviceId"), L"<placeholder>", configp->Get(L"outputRank"), configp->Get(L"inferInputRankToMap"))
+    {
+        AttachInputsFromConfig(configp, this->GetExpectedNumInputs());
+    }
+
+    virtual void /*ComputationNode::*/ ForwardProp(const FrameRange& fr) override
+    {
+        if (dynamic_pointer_cast<LearnableParameter<ElemType>>(Input(0)))
+            this->m_pQuantizedMultiplier->SetIsAConstant(true);
+        if (dynamic_pointer_cast<LearnableParameter<ElemType>>(Input(1)))
+            this->m_pQuantizedMultiplier->SetIsBConstant(true);
+
+        Base::ForwardProp(fr);
+    }
+
+    virtual void /*ComputationNode::*/ BackpropTo(const size_t /*inputIndex*/, const FrameRange& /*fr*/) override
+    {
+        // This operation is intended only for inference
+        NOT_IMPLEMENTED;
+    }
+};
+
+template class HalfPrecisionTimesNode<float>;
+template class HalfPrecisionTimesNode<double>;
+
 // -----------------------------------------------------------------------
 // SumElementsNode (input)
 // Sums up all elements in the input across all samples into a single scalar.
@@ -1265,7 +1343,41 @@ private:
         return shape;
     }
 
-    // verify that the argument is a valid permutation 
+    // determine whether this transposition leaves the memory image unchanged
+    // That is the case iff only singleton axes change their position, i.e. the source axes of all
+    // non-singleton output axes appear in increasing order. The transpose then degenerates to a
+    // reshape, and the output may alias the input buffer.
+    // Note that comparing the non-singleton extents by value would not be sufficient: e.g.
+    // reversing [2 x 3 x 2] yields the same extent sequence but a different memory image.
+    bool IsMemoryLayoutPreserving() const
+    {
+        const auto& inputDims = Input(0)->GetSampleLayout().GetDims();
+        std::vector<size_t> perm; // perm[k] = source input axis of output axis k
+        if (m_axis1 > 0 && m_axis2 > 0)
+        {
+            size_t i = m_axis1 - 1;
+            size_t j = m_axis2 - 1;
+            if (i >= inputDims.size() || j >= inputDims.size()) // Validate() pads the rank in this case; don't bother
+                return false;
+            for (size_t k = 0; k < inputDims.size(); k++)
+                perm.push_back(k);
+            std::swap(perm[i], perm[j]);
+        }
+        else
+            perm.assign(m_perm.begin(), m_perm.end());
+        size_t lastSourceAxis = 0;
+        for (size_t k = 0; k < perm.size(); k++)
+        {
+            if (perm[k] >= inputDims.size() || inputDims[perm[k]] == 1) // singleton axes may move freely
+                continue;
+            if (perm[k] < lastSourceAxis)
+                return false;
+            lastSourceAxis = perm[k];
+        }
+        return true;
+    }
+
+    // verify that the argument is a valid permutation
     // We pass by value because the function mutates perm
     static bool IsPermutation(std::vector<size_t> perm)
     {
@@ -1279,6 +1391,8 @@ private:
 public:
     virtual void /*ComputationNode::*/ ForwardProp(const FrameRange& fr) override
     {
+        if (this->ValueAliasesInput()) // in-place forward (layout-preserving transposition): nothing to copy
+            return;
         size_t rank = DetermineElementwiseTensorRank();
         auto output =                                  ValueTensorFor(                         rank, fr);
         auto input  = TensorView<ElemType>(InputRef(0).ValuePtr(), GetTransposedTensorSliceFor(rank, fr));
@@ -1290,12 +1404,24 @@ public:
         size_t rank = DetermineElementwiseTensorRank();
         auto outputGradient =                                  GradientTensorFor(                         rank, fr);
         auto inputGradient  = TensorView<ElemType>(InputRef(0).GradientPtr(), GetTransposedTensorSliceFor(rank, fr));
-        inputGradient.AddCopyOf(outputGradient);
+        // the transposition is a bijective copy, so the first (and only) write may assign
+        if (Input(inputIndex)->ParentOverwritesGradient())
+            inputGradient.AssignCopyOf(outputGradient);
+        else
+            inputGradient.AddCopyOf(outputGradient);
     }
 
+    virtual bool ImplementsGradientOverwriteOptimization() const override { return true; }
+
     virtual bool OutputUsedInComputingInputNodesGradients() const override { return false; }
     virtual bool InputUsedInComputingInputNodesGradients(size_t /*childIndex*/) const override { return false; }
 
+    // only if no non-singleton axis actually moves, i.e. the transpose degenerates to a reshape
+    virtual int /*ComputationNodeBase::*/ ImplementsInPlaceForwardOptimization() const override
+    {
+        return IsMemoryLayoutPreserving() ? 0 : -1;
+    }
+
     virtual void /*ComputationNodeBase::*/ Validate(bool isFinalValidationPass) override
     {
         assert(m_inputs.size() == 1);
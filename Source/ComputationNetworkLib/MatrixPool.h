@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <vector>
 #include <set>
+#include <map>
 #include <utility>
 #include <algorithm>
 #include <stdlib.h>
@@ -16,6 +17,7 @@
 #include "Basics.h"
 #include "Matrix.h"
 #include "ComputationNode.h"
+#include "PerformanceProfiler.h"
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
@@ -27,11 +29,12 @@ struct MemRequestInfo
     size_t matrixSize;                          // memory size 
     bool mbScale;                               // whether the memory shall be scaled by minibatch size 
     bool isWorkSpace;                           // workspace memory or not, by workspace we indicate whether a memory space will be released very shortly after allocation 
-    int allocStep;                              // at what step counter memory allocation is requested 
-    int releaseStep;                            // at what step counter memory release is requested  
-    int memoryId;                               // integer indexing the memory buffer ID 
-    MemRequestInfo(DEVICEID_TYPE deviceId, shared_ptr<Matrix<ElemType>>*pMatrixPtr, size_t matrixSize, bool mbScale, bool isWorkSpace, int allocStep)
-        :deviceId(deviceId), pMatrixPtr(pMatrixPtr), matrixSize(matrixSize), mbScale(mbScale), isWorkSpace(isWorkSpace), allocStep(allocStep), releaseStep(INT_MAX), memoryId(-1)
+    int allocStep;                              // at what step counter memory allocation is requested
+    int releaseStep;                            // at what step counter memory release is requested
+    int memoryId;                               // integer indexing the memory buffer ID
+    wstring nodeName;                           // name of the requesting node, for the profiler's memory attribution
+    MemRequestInfo(DEVICEID_TYPE deviceId, shared_ptr<Matrix<ElemType>>*pMatrixPtr, size_t matrixSize, bool mbScale, bool isWorkSpace, int allocStep, const wstring& nodeName)
+        :deviceId(deviceId), pMatrixPtr(pMatrixPtr), matrixSize(matrixSize), mbScale(mbScale), isWorkSpace(isWorkSpace), allocStep(allocStep), releaseStep(INT_MAX), memoryId(-1), nodeName(nodeName)
     {
     }
     void SetReleaseStep(int step) { releaseStep = step; }
@@ -58,22 +61,78 @@ struct MemAllocInfo
     }
 };
 
+// summary of the pool's last OptimizedMemoryAllocation() run, queryable via
+// ComputationNetwork::GetMatrixPoolStats(); aggregated over both element types
+struct MatrixPoolStats
+{
+    size_t requestCount;  // dense memory requests that participated in sharing
+    size_t bufferCount;   // distinct shared buffers backing those requests
+    size_t retainedBytes; // bytes currently allocated by the shared buffers, incl. grow-only slack
+    MatrixPoolStats()
+        : requestCount(0), bufferCount(0), retainedBytes(0)
+    {
+    }
+};
+
 // MatrixPool -- class to support memory sharing
 // Despite the gather general name of this class, it is specifically designed to support the memory sharing of ComputationNodes.
 // Note: see #define SUPRESS_MEMSHARING below as for how to temporarily disable memory sharing altogether, for debugging
 class MatrixPool
 {
-    vector<MemRequestInfo<float>> m_memRequestInfoFloatVec; 
+    vector<MemRequestInfo<float>> m_memRequestInfoFloatVec;
     vector<MemRequestInfo<double>> m_memRequestInfoDoubleVec;
-    set<DEVICEID_TYPE> m_deviceIDSet; 
-    int m_stepCounter; 
+    set<DEVICEID_TYPE> m_deviceIDSet;
+    int m_stepCounter;
+    // shared buffers handed out by the last OptimizedMemoryAllocation() run, kept for stats and trimming
+    vector<shared_ptr<Matrix<float>>> m_pooledMatricesFloat;
+    vector<shared_ptr<Matrix<double>>> m_pooledMatricesDouble;
+    size_t m_pooledRequestCount = 0;
+    // in-place aliasing requests as (aliasing request's pointer, source request's pointer), cf. RequestAliasedAllocate()
+    vector<pair<shared_ptr<Matrix<float>>*, shared_ptr<Matrix<float>>*>> m_aliasInfoFloatVec;
+    vector<pair<shared_ptr<Matrix<double>>*, shared_ptr<Matrix<double>>*>> m_aliasInfoDoubleVec;
 
     template <class ElemType>
-    vector<MemRequestInfo<ElemType>>& GetMemRequestInfoVec(); 
+    vector<MemRequestInfo<ElemType>>& GetMemRequestInfoVec();
+
+    template <class ElemType>
+    vector<shared_ptr<Matrix<ElemType>>>& GetPooledMatrixVec();
+
+    template <class ElemType>
+    vector<pair<shared_ptr<Matrix<ElemType>>*, shared_ptr<Matrix<ElemType>>*>>& GetAliasInfoVec();
+
+    static size_t RoundUpToPowerOfTwo(size_t n)
+    {
+        size_t p = 1;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
 
 public:
     void ResetStepCounter() { m_stepCounter = 0; };
 
+    MatrixPoolStats GetStats() const
+    {
+        MatrixPoolStats stats;
+        stats.requestCount = m_pooledRequestCount;
+        stats.bufferCount = m_pooledMatricesFloat.size() + m_pooledMatricesDouble.size();
+        for (const auto& matrixPtr : m_pooledMatricesFloat)
+            stats.retainedBytes += matrixPtr->BufferSize();
+        for (const auto& matrixPtr : m_pooledMatricesDouble)
+            stats.retainedBytes += matrixPtr->BufferSize();
+        return stats;
+    }
+
+    // release the shared buffers' backing memory, e.g. between epochs; the next forward/backward
+    // pass re-grows them through the nodes' regular UpdateFunctionMBSize()/Resize() calls
+    void TrimPooledMemory()
+    {
+        for (auto& matrixPtr : m_pooledMatricesFloat)
+            matrixPtr->Resize(0, 0, 0, /*growOnly=*/false);
+        for (auto& matrixPtr : m_pooledMatricesDouble)
+            matrixPtr->Resize(0, 0, 0, /*growOnly=*/false);
+    }
+
     template <class ElemType>
     void RequestRelease(shared_ptr<Matrix<ElemType>> *pMatrixPtr)
     {
@@ -97,10 +156,10 @@ public:
     // mbScale is another flag indicating if the size of the memory will scale w.r.t. the minibatch size. Unfortunately, at the time of memory
     // request and pointer assignment, we don't known the minibatch size. Thus our memory sharing algorithm is sub-optimal. 
     template <class ElemType>
-    void RequestAllocate(DEVICEID_TYPE deviceId, shared_ptr<Matrix<ElemType>>*pMatrixPtr, size_t matrixSize, bool mbScale, bool isWorkSpace)
+    void RequestAllocate(DEVICEID_TYPE deviceId, shared_ptr<Matrix<ElemType>>*pMatrixPtr, size_t matrixSize, bool mbScale, bool isWorkSpace, const wstring& nodeName = L"")
     {
-        vector<MemRequestInfo<ElemType>>& memInfoVec = GetMemRequestInfoVec<ElemType>(); 
-        MemRequestInfo<ElemType> memInfo(deviceId, pMatrixPtr, matrixSize, mbScale, isWorkSpace, m_stepCounter);
+        vector<MemRequestInfo<ElemType>>& memInfoVec = GetMemRequestInfoVec<ElemType>();
+        MemRequestInfo<ElemType> memInfo(deviceId, pMatrixPtr, matrixSize, mbScale, isWorkSpace, m_stepCounter, nodeName);
         memInfoVec.push_back(memInfo); 
         m_deviceIDSet.insert(deviceId); 
         m_stepCounter++; 
@@ -109,12 +168,35 @@ public:
         *pMatrixPtr = make_shared<Matrix<ElemType>>(deviceId);
     }
 
+    // Variant of RequestAllocate() for a request whose matrix may overwrite another request's buffer
+    // in place (in-place forward, cf. ComputationNodeBase::ImplementsInPlaceForwardOptimization()).
+    // The two requests are folded into a single buffer whose lifetime covers both.
+    template <class ElemType>
+    void RequestAliasedAllocate(DEVICEID_TYPE deviceId, shared_ptr<Matrix<ElemType>>* pSourceMatrixPtr, shared_ptr<Matrix<ElemType>>* pMatrixPtr, size_t matrixSize, bool mbScale, const wstring& nodeName = L"")
+    {
+        vector<MemRequestInfo<ElemType>>& memInfoVec = GetMemRequestInfoVec<ElemType>();
+        MemRequestInfo<ElemType> memInfo(deviceId, pMatrixPtr, matrixSize, mbScale, false, m_stepCounter, nodeName);
+        memInfoVec.push_back(memInfo);
+        m_deviceIDSet.insert(deviceId);
+        m_stepCounter++;
+        GetAliasInfoVec<ElemType>().push_back(make_pair(pMatrixPtr, pSourceMatrixPtr));
+
+        // assign some temporary pointer, they will be replaced later
+        *pMatrixPtr = make_shared<Matrix<ElemType>>(deviceId);
+    }
+
     void OptimizedMemoryAllocation()
     {
-        // MatrixPool is not templated, so we call both float and double versions here 
-        OptimizedMemoryAllocationFunc<float>(); 
+        m_pooledMatricesFloat.clear();
+        m_pooledMatricesDouble.clear();
+        m_pooledRequestCount = 0;
+        // report the per-node requests to the profiler's memory attribution; mbScale request
+        // sizes are per sample, so the reported bytes get multiplied by the minibatch size
+        ProfilerMemoryAttributionBegin(c_memoryAttributionGroup);
+        // MatrixPool is not templated, so we call both float and double versions here
+        OptimizedMemoryAllocationFunc<float>();
         OptimizedMemoryAllocationFunc<double>();
-        return; 
+        return;
     }
 
 private: 
@@ -153,7 +235,37 @@ private:
                 iter++; 
         }
 
-        // sort the memory request from largest size to smallest 
+        // fold in-place alias requests into their source requests: the aliased matrix will point at
+        // the source's buffer, so the source's lifetime must cover the alias's, and the alias does
+        // not get a buffer of its own. Chains of aliases resolve to the ultimate source.
+        auto& aliasInfoVec = GetAliasInfoVec<ElemType>();
+        map<shared_ptr<Matrix<ElemType>>*, shared_ptr<Matrix<ElemType>>*> aliasSourceMap;
+        for (auto& aliasInfo : aliasInfoVec)
+            aliasSourceMap[aliasInfo.first] = aliasInfo.second;
+        vector<pair<shared_ptr<Matrix<ElemType>>*, shared_ptr<Matrix<ElemType>>*>> resolvedAliases;
+        for (auto& aliasInfo : aliasInfoVec)
+        {
+            auto pSource = aliasInfo.second;
+            while (aliasSourceMap.find(pSource) != aliasSourceMap.end())
+                pSource = aliasSourceMap[pSource];
+            auto findRequest = [&memInfoVec](shared_ptr<Matrix<ElemType>>* p)
+            {
+                return std::find_if(memInfoVec.begin(), memInfoVec.end(),
+                                    [p](const MemRequestInfo<ElemType>& info) { return info.pMatrixPtr == p; });
+            };
+            auto sourceIter = findRequest(pSource);
+            auto aliasIter = findRequest(aliasInfo.first);
+            if (sourceIter == memInfoVec.end() || aliasIter == memInfoVec.end()) // e.g. turned sparse: keep the alias as a regular request
+                continue;
+            sourceIter->releaseStep = max(sourceIter->releaseStep, aliasIter->releaseStep);
+            sourceIter->matrixSize = max(sourceIter->matrixSize, aliasIter->matrixSize);
+            resolvedAliases.push_back(make_pair(aliasInfo.first, pSource));
+            memInfoVec.erase(aliasIter);
+        }
+
+        m_pooledRequestCount += memInfoVec.size();
+
+        // sort the memory request from largest size to smallest
         std::sort(memInfoVec.begin(), memInfoVec.end(), greater_than_mem_req_size<ElemType>());
 
         std::vector<bool> workspaceFlagVec = {true, false};
@@ -248,21 +360,53 @@ private:
                     }
                 }
 
-                // now assign the actual pointers 
+                // now assign the actual pointers
                 for (int i = 0; i < memoryCounter; i++)
                 {
                     auto matrixPtr = make_shared<Matrix<ElemType>>(devId);
                     if (!matrixPtr) // this can't really happen, because we haven't started allocating memory yet
                         LogicError("MatrixPool: failed to get a valid matrix.");
+                    size_t reserveElements = 0;
+                    bool mbScale = false;
                     for (auto& memInfo : memInfoVec)
                     {
                         if (memInfo.deviceId == devId && memInfo.isWorkSpace == wsFlag && memInfo.memoryId == i)
+                        {
                             *memInfo.pMatrixPtr = matrixPtr;
+                            reserveElements = max(reserveElements, memInfo.matrixSize);
+                            mbScale |= memInfo.mbScale;
+                        }
                     }
+                    // pre-reserve the buffer up front instead of letting the first minibatches grow it
+                    // incrementally: non-mbScale requests are exactly sized; mbScale sizes are per-sample
+                    // estimates that get multiplied by an unknown minibatch size, so round those up to a
+                    // power of two as a floor against the early reallocation ramp
+                    if (mbScale)
+                        reserveElements = RoundUpToPowerOfTwo(reserveElements);
+                    if (reserveElements > 0)
+                    {
+                        matrixPtr->Resize(1, reserveElements);
+                        matrixPtr->Resize(0, 0); // grow-only: dimensions reset, the reserved buffer stays
+                    }
+                    GetPooledMatrixVec<ElemType>().push_back(matrixPtr);
                 }
             }
         }
+
+        // point the aliased matrices at their sources' buffers
+        for (auto& aliasInfo : resolvedAliases)
+            *aliasInfo.first = *aliasInfo.second;
+
+        // attribute each request's bytes to its node, so the memory report can say which
+        // node asked for what rather than only how big the shared buffers ended up
+        for (auto& memInfo : memInfoVec)
+        {
+            string name = memInfo.nodeName.empty() ? "(unnamed)" : msra::strfun::utf8(memInfo.nodeName);
+            ProfilerMemoryAttribution(c_memoryAttributionGroup, name.c_str(), memInfo.matrixSize * sizeof(ElemType));
+        }
     }
+
+    static const char* c_memoryAttributionGroup;
 };
 
 }}}
@@ -100,6 +100,11 @@ public:
     }
 
     virtual bool ImplementsGradientOverwriteOptimization() const override { return (opType != noGradient); }
+
+    // unary elementwise: output geometry equals input geometry, so the op may run in place.
+    // For ops whose gradient needs the input value (binaryWithInputGradient), the liveness pass
+    // rejects the aliasing during training via InputUsedInComputingInputNodesGradients().
+    virtual int /*ComputationNodeBase::*/ ImplementsInPlaceForwardOptimization() const override { return 0; }
 };
 
 #define UnaryElementWiseWithOpCodeNodeBaseMembers UsingComputationNodeMembersBoilerplate;
@@ -161,6 +166,89 @@ DeclareUnaryElementWiseWithOpCodeNode(ExponentialLinearUnit, ExponentialLinearUn
 
 #pragma pop_macro("DeclareUnaryElementWiseWithOpCodeNode")
 
+// -----------------------------------------------------------------------
+// FusedPlusUnaryWithOpCodeNodeBase (addend1, addend2) -- base for fused
+// add -> unary-nonlinearity nodes, created from Plus -> {Sigmoid,Tanh} chains
+// by ComputationNetwork::FuseElementwiseChains(). Forward is a single fused
+// opcode (e.g. opSigmoidOfSum) over both addends, so the chain touches memory
+// once instead of once per op; the gradient is computed from the output value
+// and distributes to both addends, with automatic reduction over broadcasting
+// dimensions just like PlusNode.
+// -----------------------------------------------------------------------
+
+template <class ElemType, ElementWiseOperator opForward, ElementWiseOperator opBackward>
+class FusedPlusUnaryWithOpCodeNodeBase : public ComputationNode<ElemType>, public NumInputs<2>
+{
+    typedef ComputationNode<ElemType> Base;
+    UsingComputationNodeMembers;
+
+public:
+    FusedPlusUnaryWithOpCodeNodeBase(DEVICEID_TYPE deviceId, const wstring& name)
+        : Base(deviceId, name)
+    {
+    }
+
+    virtual void /*ComputationNode::*/ ForwardProp(const FrameRange& fr) override
+    {
+        size_t rank = DetermineElementwiseTensorRank();
+        auto result =             ValueTensorFor(rank, fr);
+        auto input0 = InputRef(0).ValueTensorFor(rank, fr.AllowBroadcast());
+        auto input1 = InputRef(1).ValueTensorFor(rank, fr.AllowBroadcast());
+        result.DoBinaryOpOf(0, input0, input1, 1, opForward, opSum);
+    }
+
+    virtual void /*ComputationNode::*/ BackpropTo(const size_t inputIndex, const FrameRange& fr) override
+    {
+        size_t rank = DetermineElementwiseTensorRank();
+        auto sliceOutputGrad =                    GradientTensorFor(rank, fr);
+        auto sliceValue      =                    ValueTensorFor(rank, fr);
+        auto sliceInputGrad  = InputRef(inputIndex).GradientTensorFor(rank, fr.AllowBroadcast());
+
+        // if reduction then mask the gradient (zero out the gaps), same as PlusNode
+        if (Input(inputIndex)->ReducesInTimeWrt(shared_from_this()))
+            MaskMissingGradientColumnsToZero(fr);
+
+        sliceInputGrad.DoBinaryOpOf(Input(inputIndex)->ParentOverwritesGradient() ? 0.0f : 1.0f, sliceOutputGrad, sliceValue, 1, opBackward, opSum);
+    }
+
+    virtual void /*ComputationNodeBase::*/ Validate(bool isFinalValidationPass) override
+    {
+        ValidateBinaryZip(isFinalValidationPass, true /*allowBroadcast*/);
+    }
+
+    virtual bool OutputUsedInComputingInputNodesGradients() const override { return true; }
+    virtual bool InputUsedInComputingInputNodesGradients(size_t /*childIndex*/) const override { return false; }
+    virtual bool ImplementsGradientOverwriteOptimization() const override { return true; }
+};
+
+#define FusedPlusUnaryWithOpCodeNodeBaseMembers UsingComputationNodeMembersBoilerplate;
+
+#pragma push_macro("DeclareFusedPlusUnaryWithOpCodeNode")
+#define DeclareFusedPlusUnaryWithOpCodeNode(Name, Forward, Backward)                                                                         \
+    template <class ElemType>                                                                                                                \
+    class Name##Node : public FusedPlusUnaryWithOpCodeNodeBase<ElemType, op##Forward, op##Backward>                                          \
+    {                                                                                                                                        \
+        typedef FusedPlusUnaryWithOpCodeNodeBase<ElemType, op##Forward, op##Backward> Base;                                                  \
+        FusedPlusUnaryWithOpCodeNodeBaseMembers;                                                                                             \
+        static const std::wstring TypeName()                                                                                                 \
+        {                                                                                                                                    \
+            return L## #Name;                                                                                                                \
+        }                                                                                                                                    \
+                                                                                                                                             \
+    public:                                                                                                                                  \
+        DeclareConstructorFromConfigWithNumInputs(Name##Node);                                                                               \
+        Name##Node(DEVICEID_TYPE deviceId, const wstring& Name) :                                                                            \
+            Base(deviceId, Name)                                                                                                             \
+        {                                                                                                                                    \
+        }                                                                                                                                    \
+    }
+
+//                                  Name           Forward opcode  Backward opcode
+DeclareFusedPlusUnaryWithOpCodeNode(SigmoidOfPlus, SigmoidOfSum,   ElementwiseProductWithSigmoidDerivativeFromOutput);
+DeclareFusedPlusUnaryWithOpCodeNode(TanhOfPlus,    TanhOfSum,      ElementwiseProductWithTanhDerivativeFromOutput);
+
+#pragma pop_macro("DeclareFusedPlusUnaryWithOpCodeNode")
+
 // -----------------------------------------------------------------------
 // SoftmaxNodeBase (input) -- shared base of Softmax and LogSoftmax
 // -----------------------------------------------------------------------
@@ -36,7 +36,7 @@ template <class ElemType>
     if (flags & CopyNodeFlags::copyNodeValue)
     {
         auto node = dynamic_pointer_cast<ReduceElementsNode<ElemType>>(nodeP);
-        node->m_axis        = m_axis;
+        node->m_axes        = m_axes;
         node->m_operation   = m_operation;
         node->m_reductionOp = m_reductionOp;
         node->m_scale       = m_scale;
@@ -48,12 +48,33 @@ template <class ElemType>
 /*virtual*/ void ReduceElementsNode<ElemType>::Load(File& fstream, size_t modelVersion) /*override*/
 {
     Base::Load(fstream, modelVersion);
-    fstream >> m_axis >> m_operation;
-    if (modelVersion >= CNTK_MODEL_VERSION_24)
-        fstream >> m_keepDimensions;
+    m_axes.clear();
+    if (modelVersion >= CNTK_MODEL_VERSION_26)
+    {
+        int num;
+        fstream >> num;
+        if (num < 1)
+            InvalidArgument("ReduceElements node number of axes (%d) invalid, must be >=1", num);
+        for (int i = 0; i < num; i++)
+        {
+            int axis;
+            fstream >> axis;
+            m_axes.push_back(axis);
+        }
+        fstream >> m_operation >> m_keepDimensions;
+    }
     else
-        m_keepDimensions = DefaultKeepDimensionsSetting(m_axis);
+    {
+        int axis;
+        fstream >> axis >> m_operation;
+        m_axes.push_back(axis);
+        if (modelVersion >= CNTK_MODEL_VERSION_24)
+            fstream >> m_keepDimensions;
+        else
+            m_keepDimensions = DefaultKeepDimensionsSetting(axis);
+    }
 
+    ValidateAxes();
     ValidateOp();
 }
 
@@ -61,7 +82,11 @@ template <class ElemType>
 /*virtual*/ void ReduceElementsNode<ElemType>::Save(File& fstream) const /*override*/
 {
     Base::Save(fstream);
-    fstream << m_axis << m_operation; // note: we serialize the string and not the opcode, since opcodes may change
+    int num = (int)m_axes.size();
+    fstream << num;
+    for (int i = 0; i < num; i++)
+        fstream << m_axes[i];
+    fstream << m_operation; // note: we serialize the string and not the opcode, since opcodes may change
     fstream << m_keepDimensions;
 }
 
@@ -242,6 +267,27 @@ void ReduceElementsNode<ElemType>::ValidateOp()
     m_reductionOp = ReductionOpEnumValue(m_operation);
 }
 
+// verify that the axis set is well-formed: a sentinel value (all axes, all static axes,
+// sequence axis, batch axis) must stand alone, and specific axes must not repeat
+template <class ElemType>
+void ReduceElementsNode<ElemType>::ValidateAxes()
+{
+    if (m_axes.empty())
+        InvalidArgument("%ls %ls operation: at least one reduction axis must be specified.", NodeName().c_str(), OperationName().c_str());
+
+    if (m_axes.size() > 1)
+    {
+        for (int axis : m_axes)
+        {
+            if (axis < 1)
+                InvalidArgument("%ls %ls operation: sentinel axis value (%d) cannot be combined with other axes.", NodeName().c_str(), OperationName().c_str(), axis);
+
+            if (std::count(m_axes.begin(), m_axes.end(), axis) > 1)
+                InvalidArgument("%ls %ls operation: reduction axis (%d) was specified more than once.", NodeName().c_str(), OperationName().c_str(), axis);
+        }
+    }
+}
+
 template <class ElemType>
 /*virtual*/ void ReduceElementsNode<ElemType>::Validate(bool isFinalValidationPass) /*override*/
 {
@@ -290,18 +336,25 @@ template <class ElemType>
             reducedDim = shape.GetNumElements();
             dims = m_keepDimensions ? SmallVector<size_t>(shape.GetRank(), 1) : (Environment().IsV2Library() ? SmallVector<size_t>({}) : SmallVector<size_t>({ 1 })); // entire sample is reduced to a scalar
         }
-        else if (m_axis - 1 >= 0 && m_axis - 1 < dims.size())
+        else if (std::all_of(m_axes.begin(), m_axes.end(), [&](int axis) { return axis - 1 >= 0 && axis - 1 < dims.size(); }))
         {
-            reducedDim = dims[m_axis - 1];
-            // one axis is reduced to a scalar
+            // each listed axis is reduced to a scalar; a multi-axis reduction happens in one
+            // pass, as a single tensor reduction over all listed axes
+            reducedDim = 1;
+            for (int axis : m_axes)
+                reducedDim *= dims[axis - 1];
+
             if (m_keepDimensions)
-                dims[m_axis - 1] = 1;
+            {
+                for (int axis : m_axes)
+                    dims[axis - 1] = 1;
+            }
             else
             {
-                SmallVector<size_t> reducedDims(dims.size() - 1);
+                SmallVector<size_t> reducedDims(dims.size() - m_axes.size());
                 for (size_t i = 0, j = 0; i < dims.size(); ++i)
                 {
-                    if (i == (m_axis - 1))
+                    if (std::find(m_axes.begin(), m_axes.end(), (int)i + 1) != m_axes.end())
                         continue;
 
                     reducedDims[j] = dims[i];
@@ -311,7 +364,8 @@ template <class ElemType>
             }
         }
         else if (isFinalValidationPass)
-            InvalidArgument("The shape of %ls [%s] has no axis %d", NodeDescription().c_str(), string(shape).c_str(), m_axis);
+            InvalidArgument("The shape of %ls [%s] has no axis %d", NodeDescription().c_str(), string(shape).c_str(),
+                            *std::find_if(m_axes.begin(), m_axes.end(), [&](int axis) { return axis - 1 < 0 || axis - 1 >= dims.size(); }));
 
         // for "Mean", we must divide by #elements
         if (isFinalValidationPass && IsMean())
@@ -360,6 +414,29 @@ template <class ElemType>
     let& inMBLayout = InputRef(0).GetMBLayout();
     let& input = InputRef(0).Value();
     let& sequences = inMBLayout->GetAllSequences();
+    // check the cache: layouts repeat across minibatches in fixed-size regimes, and the
+    // condition values often depend on the layout alone (e.g. selecting the last frame of
+    // each sequence). If neither changed since the last minibatch, then Value() (which is
+    // non-sharable) and our MBLayout still hold the correct result, and we can skip the
+    // recomputation below.
+    bool cacheHit = m_cachedLayout && *m_cachedLayout == *inMBLayout;
+    for (size_t i = 0; cacheHit && i < sequences.size(); i++)
+    {
+        let& seq = sequences[i];
+        if (seq.seqId == GAP_SEQUENCE_ID) // gap columns hold no defined values
+            continue;
+        for (size_t t = 0; cacheHit && t < seq.GetNumTimeSteps(); t++)
+        {
+            let j = inMBLayout->GetColumnIndex(seq, t);
+            cacheHit = (input(0, j) == m_cachedInput[j]);
+        }
+    }
+    if (cacheHit)
+    {
+        input.CollapseDataLocation(); // BUGBUG: Move back, since BOTH state is broken at present.
+        return;
+    }
+    m_cachedInput.assign(inMBLayout->GetNumCols(), 0); // (gap columns compare as 0)
     auto& indexSequences = m_indexSequenceBuffer;
     if (indexSequences.size() < sequences.size())
         indexSequences.resize(sequences.size());
@@ -375,7 +452,9 @@ template <class ElemType>
         double desiredCount = 0.0;
         for (size_t t = 0; t < seq.GetNumTimeSteps(); t++)
         {
-            double delta = input(0, inMBLayout->GetColumnIndex(seq, t)); // how many frames the current time step should expand into
+            let j = inMBLayout->GetColumnIndex(seq, t);
+            double delta = input(0, j); // how many frames the current time step should expand into
+            m_cachedInput[j] = (ElemType)delta; // remember for the cache check in the next minibatch
             desiredCount += delta; // this is now how many frames we should have
             // use a margin against round-off errors, so that we get non-binary ratios like 1/3 and 1/5 right
             // This really means generate a frame if too few, unless we are within machine accuracy of the target.
@@ -411,6 +490,10 @@ template <class ElemType>
     // the result will be kept in CPUDEVICE, since most likely we will access it again in PackedIndexNode
     Value().TransferToDeviceIfNotThere(CPUDEVICE, /*isBeingMoved=*/ true, /*emptyTransfer=*/ true, /*updatePreferredDevice=*/ true);
     Value().SetValue(1, outMBLayout->GetNumCols(), CPUDEVICE, buf.data(), MatrixFormat::matrixFormatColMajor);
+    // remember the input layout for the cache check in the next minibatch
+    if (!m_cachedLayout)
+        m_cachedLayout = make_shared<MBLayout>();
+    m_cachedLayout->CopyFrom(inMBLayout);
 }
 
 template <class ElemType>
@@ -452,6 +535,28 @@ template <class ElemType>
     let& indexMBLayout  = InputRef(INDEXDATA).GetMBLayout();
     let&  index  = InputRef(INDEXDATA).Value(); // per-seq index values that are to be mapped
     auto& result =                     Value(); // packed index values as mapped to sourceData's layout
+    // check the cache: in fixed-size regimes both layouts (and with them the index values
+    // produced by Where) repeat across minibatches. If nothing changed, Value() (which is
+    // non-sharable) still holds the mapped indices -- typically already resident on the
+    // device from the previous GatherPacked/ScatterPacked -- so we skip both the remapping
+    // and the re-materialization of the packed index matrix.
+    let& indexSequences = indexMBLayout->GetAllSequences();
+    bool cacheHit = m_cachedSourceLayout && *m_cachedSourceLayout == *sourceMBLayout &&
+                    m_cachedIndexLayout  && *m_cachedIndexLayout  == *indexMBLayout;
+    for (size_t i = 0; cacheHit && i < indexSequences.size(); i++)
+    {
+        let& seq = indexSequences[i];
+        if (seq.seqId == GAP_SEQUENCE_ID) // gap columns hold no defined values
+            continue;
+        for (size_t t = 0; cacheHit && t < seq.GetNumTimeSteps(); t++)
+        {
+            let j = indexMBLayout->GetColumnIndex(seq, t);
+            cacheHit = (index(0, j) == m_cachedIndex[j]);
+        }
+    }
+    if (cacheHit)
+        return;
+    m_cachedIndex.assign(indexMBLayout->GetNumCols(), 0); // (gap columns compare as 0)
     // loop over sourceSequences
     // Input matrix contains time indices for each sequence that refer to frames inside that sequence.
     // We replace every per-sequence index by the resolved column index w.r.t. the same MBLayout.
@@ -466,12 +571,20 @@ template <class ElemType>
         {
             let jIndex  = indexMBLayout->GetColumnIndex(indexSeq, tIndex);    // map time index to actual location in the matrix storage object
             let tSource = (size_t)index(0, jIndex);                           // the new time location (relative to source sequence)
+            m_cachedIndex[jIndex] = (ElemType)tSource; // remember for the cache check in the next minibatch
             let jSource = sourceMBLayout->GetColumnIndex(sourceSeq, tSource); // map new time index as well. This performs a range check.
             result(0, jIndex) = (ElemType)jSource;
         }
     }
     // Note: maybe this is no longer needed, now that we do the same inside UpdateFunctionValueSize() for all nodes.
     result.CollapseDataLocation(); // BUGBUG: Move back, since BOTH state is broken at present.
+    // remember the layouts for the cache check in the next minibatch
+    if (!m_cachedSourceLayout)
+        m_cachedSourceLayout = make_shared<MBLayout>();
+    m_cachedSourceLayout->CopyFrom(sourceMBLayout);
+    if (!m_cachedIndexLayout)
+        m_cachedIndexLayout = make_shared<MBLayout>();
+    m_cachedIndexLayout->CopyFrom(indexMBLayout);
 }
 
 template <class ElemType>
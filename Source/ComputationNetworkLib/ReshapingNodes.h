@@ -152,6 +152,8 @@ public:
 
     virtual void /*ComputationNode::*/ ForwardProp(const FrameRange& fr) override
     {
+        if (this->ValueAliasesInput()) // in-place forward: the reshape is a pure reinterpretation of the shared buffer
+            return;
         auto result     =             ValueFor(fr);
         auto inputValue = InputRef(0).ValueFor(fr);
         result.AssignValuesOf(inputValue.Reshaped(result.GetNumRows(), result.GetNumCols()));
@@ -167,6 +169,9 @@ public:
     virtual bool OutputUsedInComputingInputNodesGradients() const override { return false; }
     virtual bool InputUsedInComputingInputNodesGradients(size_t /*childIndex*/) const override { return false; }
 
+    // a reshape never changes the memory image, only the shape, so the output may alias the input buffer
+    virtual int /*ComputationNodeBase::*/ ImplementsInPlaceForwardOptimization() const override { return 0; }
+
 private:
     TensorShape m_replacementSampleLayout; // user-specified dimensions to replace dimensions [beginAxis, endAxis]
     int m_beginDimParameter;               // 1-based index range as specified
@@ -179,7 +184,9 @@ template class ReshapeNode<double>;
 // -----------------------------------------------------------------------
 // ReduceElements (op, axis=, input)
 // Reduces (e.g. sums up) all elements in each sample (column) of the input.
-// The optional axis can be 0 (meaning all elements) or a specific axis.
+// The optional axis can be 0 (meaning all elements), a specific axis, or a set of
+// specific axes; a multi-axis reduction lowers to a single tensor reduction call,
+// with no intermediate per-axis result.
 // Allowed operations:
 //  - "Sum"
 //  - "LogSum"
@@ -190,7 +197,6 @@ template class ReshapeNode<double>;
 //  - "Any"       --not implemented yet
 // TODO:
 //  - move to a different header, since it's not really Reshaping
-//  - consider to change to pass in a set of axes instead of only one
 // -----------------------------------------------------------------------
 
 template <class ElemType>
@@ -200,6 +206,7 @@ class ReduceElementsNode : public ComputationNode<ElemType>, public NumInputs<1>
     static const std::wstring TypeName() { return L"ReduceElements"; }
 
     void ValidateOp();
+    void ValidateAxes();
 
     static bool DefaultKeepDimensionsSetting(int axis)
     {
@@ -242,13 +249,19 @@ public:
     }
 
 public:
-    ReduceElementsNode(DEVICEID_TYPE deviceId, const wstring& name, const std::wstring& operation, int axis, bool keepDimensions) :
-        Base(deviceId, name), m_operation(operation), m_axis(axis), m_reductionOp((ElementWiseOperator)-1/*invalid*/), m_scale(0/*invalid*/), m_keepDimensions(keepDimensions)
+    ReduceElementsNode(DEVICEID_TYPE deviceId, const wstring& name, const std::wstring& operation, const std::vector<int>& axes, bool keepDimensions) :
+        Base(deviceId, name), m_operation(operation), m_axes(axes), m_reductionOp((ElementWiseOperator)-1/*invalid*/), m_scale(0/*invalid*/), m_keepDimensions(keepDimensions)
     {
+        ValidateAxes();
         if (!m_operation.empty()) // verify validity already here out of courtesy (would otherwise be caught in Validate())
             ValidateOp();
     }
 
+    ReduceElementsNode(DEVICEID_TYPE deviceId, const wstring& name, const std::wstring& operation, int axis, bool keepDimensions) :
+        ReduceElementsNode(deviceId, name, operation, std::vector<int>{ axis }, keepDimensions)
+    {
+    }
+
     ReduceElementsNode(DEVICEID_TYPE deviceId, const wstring& name, const std::wstring& operation = std::wstring(), int axis = CNTKInternalIdxValueForAllStaticAxes) :
         ReduceElementsNode(deviceId, name, operation, axis, DefaultKeepDimensionsSetting(axis))
     {
@@ -297,7 +310,8 @@ public:
     }
 
     std::wstring ReductionOpName() const { return m_operation; }
-    int ReductionAxis() const { return m_axis; }
+    int ReductionAxis() const { return m_axes[0]; }
+    const std::vector<int>& ReductionAxes() const { return m_axes; }
 
     static const int  CNTKInternalIdxValueForAllStaticAxes = 0;
     static const int  CNTKInternalIdxValueForAllAxes = -1;
@@ -306,14 +320,15 @@ public:
 
 private:
     bool IsMean() const { return (m_operation == L"Mean"); }
-    bool ReduceAllStaticAxes() const { return m_axis == CNTKInternalIdxValueForAllStaticAxes; }
-    bool ReduceAllAxes() const { return m_axis == CNTKInternalIdxValueForAllAxes; }
-    bool ReduceSequenceAxis() const { return m_axis == CNTKInternalIdxValueForSequenceAxis; }
-    bool ReduceBatchAxis() const { return m_axis == CNTKInternalIdxValueForBatchAxis; }
+    // the sentinel axis values are only meaningful on their own, cf. ValidateAxes()
+    bool ReduceAllStaticAxes() const { return m_axes[0] == CNTKInternalIdxValueForAllStaticAxes; }
+    bool ReduceAllAxes() const { return m_axes[0] == CNTKInternalIdxValueForAllAxes; }
+    bool ReduceSequenceAxis() const { return m_axes[0] == CNTKInternalIdxValueForSequenceAxis; }
+    bool ReduceBatchAxis() const { return m_axes[0] == CNTKInternalIdxValueForBatchAxis; }
 
 private:
     // operation attributes
-    int m_axis;
+    std::vector<int> m_axes;           // 1-based static axes to reduce over, or a single sentinel value (see CNTKInternalIdxValueFor*)
     std::wstring m_operation;          // the operation as a string, e.g. "Sum", see ValidateOp()
     bool m_keepDimensions;
 
@@ -1047,6 +1062,9 @@ private:
     std::vector<size_t>               m_rowAllocationsBuffer; // [row] for determining new MBLayout packing
     std::vector<std::pair<size_t, size_t>> m_placementBuffer; // [sequenceIndex] assigned location for a sequence
     std::wstring m_dynamicAxisName;
+    // cache for skipping recomputation when the input repeats across minibatches (fixed-size regimes)
+    MBLayoutPtr m_cachedLayout;          // input's layout in the previous minibatch
+    std::vector<ElemType> m_cachedInput; // [column] input values in the previous minibatch (0 in gaps)
 };
 
 // -----------------------------------------------------------------------
@@ -1082,6 +1100,12 @@ public:
     virtual bool OutputUsedInComputingInputNodesGradients() const override { return false; }
     virtual bool InputUsedInComputingInputNodesGradients(size_t /*childIndex*/) const override { return false; }
     virtual void Validate(bool isFinalValidationPass) override;
+
+private:
+    // cache for skipping recomputation when the inputs repeat across minibatches (fixed-size regimes)
+    MBLayoutPtr m_cachedSourceLayout;    // sourceData's layout in the previous minibatch
+    MBLayoutPtr m_cachedIndexLayout;     // indexData's layout in the previous minibatch
+    std::vector<ElemType> m_cachedIndex; // [column] indexData values in the previous minibatch (0 in gaps)
 };
 
 // -----------------------------------------------------------------------
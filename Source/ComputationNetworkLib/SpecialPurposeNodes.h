@@ -65,6 +65,59 @@ private:
     std::vector<std::string> m_labelMapping;
 };
 
+// -----------------------------------------------------------------------
+// TransferNode (input) -- pass a value across a device boundary
+// An identity node pinned to a device: the forward pass copies the input's value over to
+// the node's own device, the backward pass copies the gradient back to the input's device.
+// ComputationNetwork::InsertPipelineTransferNodes() splices these into every edge that
+// crosses a device boundary of a network partitioned with AssignNodesToDevice(), so each
+// cut edge costs one explicit device-to-device copy instead of the matrix library bouncing
+// shared buffers between devices. Device assignments are not persisted with the model; a
+// reloaded network must be partitioned again.
+// -----------------------------------------------------------------------
+
+template <class ElemType>
+class TransferNode : public ComputationNode<ElemType>, public NumInputs<1>
+{
+    typedef ComputationNode<ElemType> Base; UsingComputationNodeMembersBoilerplate;
+    static const std::wstring TypeName() { return L"Transfer"; }
+
+public:
+    DeclareConstructorFromConfigWithNumInputs(TransferNode);
+    TransferNode(DEVICEID_TYPE deviceId, const wstring& name)
+        : Base(deviceId, name)
+    {
+    }
+
+    virtual void /*ComputationNode::*/ ForwardProp(const FrameRange& fr) override
+    {
+        auto result = ValueFor(fr);
+        auto input = Input(0)->ValueFor(fr);
+        if (input.GetDeviceId() != result.GetDeviceId()) // copy via a temp on our device; assigning cross-device directly would move 'result' to the input's device
+            result.AssignValuesOf(Matrix<ElemType>(input, result.GetDeviceId()));
+        else
+            result.AssignValuesOf(input);
+    }
+
+    virtual void /*ComputationNode::*/ BackpropTo(const size_t /*inputIndex*/, const FrameRange& fr) override
+    {
+        auto gradient = GradientFor(fr);
+        auto inputGradient = Input(0)->GradientFor(fr);
+        if (gradient.GetDeviceId() != inputGradient.GetDeviceId())
+            inputGradient += Matrix<ElemType>(gradient, inputGradient.GetDeviceId());
+        else
+            inputGradient += gradient;
+    }
+
+    virtual bool OutputUsedInComputingInputNodesGradients() const override { return false; }
+    virtual bool InputUsedInComputingInputNodesGradients(size_t /*childIndex*/) const override { return false; }
+
+    virtual void /*ComputationNodeBase::*/ Validate(bool isFinalValidationPass) override
+    {
+        ValidateUnaryMap(isFinalValidationPass);
+    }
+};
+
 #ifdef COMING_SOON
 
 // -----------------------------------------------------------------------
@@ -632,7 +685,7 @@ public:
     void SetFrameDropThresh(double frameDropThresh) { m_frameDropThreshold = frameDropThresh; }
     void SetReferenceAlign(const bool doreferencealign) { m_doReferenceAlignment = doreferencealign; }
 
-    void SetGammarCalculationParam(const double& amf, const double& lmf, const double& wp, const double& bMMIfactor, const bool& sMBR)
+    void SetGammarCalculationParam(const double& amf, const double& lmf, const double& wp, const double& bMMIfactor, const bool& sMBR, const size_t& numLatticeDevices = 1)
     {
         msra::lattices::SeqGammarCalParam param;
         param.amf = amf;
@@ -640,6 +693,7 @@ public:
         param.wp = wp;
         param.bMMIfactor = bMMIfactor;
         param.sMBRmode = sMBR;
+        param.numLatticeDevices = numLatticeDevices;
         m_gammaCalculator.SetGammarCalculationParams(param);
     }
 
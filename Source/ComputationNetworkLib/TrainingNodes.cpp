@@ -4,6 +4,9 @@
 //
 
 #include "TrainingNodes.h"
+#include "Globals.h"
+#include "MPIWrapper.h"
+#include "TensorView.h"
 #include <boost/random/uniform_real_distribution.hpp>
 
 namespace Microsoft { namespace MSR { namespace CNTK {
@@ -61,6 +64,12 @@ void RandomSampleNodeBase<ElemType>::Load(File& fstream, size_t modelVersion)
 template<class ElemType>
 void RandomSampleNodeBase<ElemType>::UpdateWeightsPrefixSum()
 {
+    // The prefix sum and the alias table depend only on the sampling weights, which typically
+    // do not change between minibatches; only rebuild them when the input was actually updated.
+    if (!m_samplingWeightsPrefixSum.empty() && m_weightsTimeStamp == Input(0)->GetEvalTimeStamp())
+        return;
+    m_weightsTimeStamp = Input(0)->GetEvalTimeStamp();
+
     const Matrix<ElemType>& samplingWeights = Input(0)->ValueAsMatrix();
     m_samplingWeightsPrefixSum.clear();
     double runningWeightsSum = 0;
@@ -73,6 +82,42 @@ void RandomSampleNodeBase<ElemType>::UpdateWeightsPrefixSum()
         runningWeightsSum += currentWeight;
         m_samplingWeightsPrefixSum.push_back(runningWeightsSum);
     }
+
+    UpdateAliasTable(samplingWeights);
+}
+
+// Builds the alias table (Vose's method) over the sampling distribution, so that each draw in
+// RunSampling() costs O(1) instead of a binary search over the prefix sum.
+template<class ElemType>
+void RandomSampleNodeBase<ElemType>::UpdateAliasTable(const Matrix<ElemType>& samplingWeights)
+{
+    size_t numClasses = m_samplingWeightsPrefixSum.size();
+    double weightsSum = m_samplingWeightsPrefixSum.back();
+    m_aliasProb.assign(numClasses, 1.0);
+    m_aliasTable.resize(numClasses);
+
+    // scale the weights such that the average bucket has probability 1, then repeatedly pair an
+    // underfull bucket with an overfull one, storing the donor class as the underfull bucket's alias
+    std::vector<double> scaledProb(numClasses);
+    std::vector<int> small, large;
+    small.reserve(numClasses);
+    large.reserve(numClasses);
+    for (size_t i = 0; i < numClasses; i++)
+    {
+        m_aliasTable[i] = (int)i;
+        scaledProb[i] = samplingWeights.GetValue((int)i, 0) * numClasses / weightsSum;
+        (scaledProb[i] < 1 ? small : large).push_back((int)i);
+    }
+    while (!small.empty() && !large.empty())
+    {
+        int s = small.back(); small.pop_back();
+        int l = large.back(); large.pop_back();
+        m_aliasProb[s] = scaledProb[s];
+        m_aliasTable[s] = l;
+        scaledProb[l] -= 1 - scaledProb[s]; // the donor loses what went into the underfull bucket
+        (scaledProb[l] < 1 ? small : large).push_back(l);
+    }
+    // buckets left over in either list have probability 1 up to round-off and keep themselves as alias
 }
 
 // Runs the sampling returning a vector with the id's of the samples. The parameter nTries is used to return the number of draws that was needed
@@ -80,7 +125,7 @@ void RandomSampleNodeBase<ElemType>::UpdateWeightsPrefixSum()
 template<class ElemType>
 const std::vector<size_t> RandomSampleNodeBase<ElemType>::RunSampling(size_t& nTries)
 {
-    boost::random::uniform_real_distribution<double> r(0, m_samplingWeightsPrefixSum.back());
+    boost::random::uniform_real_distribution<double> r(0, 1);
     std::unordered_set<int> alreadySampled;
     std::vector<size_t> samples;
     CPURNGHandle* cpuRNGHandle = dynamic_cast<CPURNGHandle*>(&GetRNGHandle(CPUDEVICE));
@@ -91,14 +136,19 @@ const std::vector<size_t> RandomSampleNodeBase<ElemType>::RunSampling(size_t& nT
     else
         nTries = 0; // just initialize and count how many tries we need.
 
+    size_t numClasses = m_aliasProb.size();
     auto offset = GetRngOffset();
     while (samples.size() < m_sizeOfSampledSet)
     {
-        double randomValue = r(cpuRNGHandle->Generator());
+        // alias-method draw: one uniform value selects both the bucket (integer part)
+        // and the coin flip against the bucket's own probability (fractional part)
+        double randomValue = r(cpuRNGHandle->Generator()) * numClasses;
         offset++;
-        // Find the first index where value[idx] >= randomValue.
-        auto lower = std::lower_bound(m_samplingWeightsPrefixSum.begin(), m_samplingWeightsPrefixSum.end(), randomValue);
-        int idx = (int)(lower - m_samplingWeightsPrefixSum.begin());
+        int idx = (int)randomValue;
+        if (idx >= (int)numClasses) // guard against round-off
+            idx = (int)numClasses - 1;
+        if (randomValue - idx >= m_aliasProb[idx])
+            idx = m_aliasTable[idx];
 
         if (m_allowDuplicates)
             samples.push_back(idx);
@@ -278,6 +328,164 @@ void DropoutNode<ElemType>::Load(File& fstream, size_t modelVersion)
     RngUser::Load(fstream, modelVersion);
 }
 
+// -----------------------------------------------------------------------
+// BatchNormalizationNode -- cross-worker synchronized statistics ("sync BN")
+// -----------------------------------------------------------------------
+// In data-parallel training, each worker normally normalizes with the statistics of its own
+// sub-minibatch, which degrades the estimates at small per-worker batch sizes. With
+// 'syncBatchNormalization=true' and more than one MPI worker, the per-channel sums are
+// aggregated across all workers before normalizing, so every worker normalizes with the
+// statistics of the full distributed minibatch. The cost is one small allreduce (2 * channels
+// values, plus the sample count) per BatchNormalization node in the forward pass, and one in
+// backprop for the exact gradient correction terms; the normalization itself runs as broadcast
+// tensor ops on the device, bypassing the batch-norm engine (which fuses the local statistics
+// into its kernels and cannot take externally aggregated ones).
+
+// view a [spatial * channels x cols] data matrix as a [spatial x channels x cols] tensor, so
+// that per-channel reductions and broadcasts apply to both the spatial and per-activation cases
+template <class ElemType>
+static TensorView<ElemType> BatchNormDataView(const Matrix<ElemType>& data, size_t numChannels)
+{
+    const size_t spatialSize = data.GetNumRows() / numChannels;
+    return TensorView<ElemType>(make_shared<Matrix<ElemType>>(data.AsReference()), TensorShape(spatialSize, numChannels, data.GetNumCols()));
+}
+
+// view a [channels x 1] statistics vector as a [1 x channels x 1] tensor (broadcasts over the above)
+template <class ElemType>
+static TensorView<ElemType> BatchNormStatView(const Matrix<ElemType>& stat, size_t numChannels)
+{
+    return TensorView<ElemType>(make_shared<Matrix<ElemType>>(stat.AsReference()), TensorShape(1, numChannels, 1));
+}
+
+template <class ElemType>
+static std::vector<ElemType> CopyToHostVector(const Matrix<ElemType>& m)
+{
+    std::vector<ElemType> result(m.GetNumElements());
+    ElemType* buffer = result.data();
+    size_t bufferSize = result.size();
+    m.CopyToArray(buffer, bufferSize); // (exact size: copies in place, no reallocation)
+    return result;
+}
+
+template <class ElemType>
+bool BatchNormalizationNode<ElemType>::UseSyncStatistics() const
+{
+    if (!Globals::ShouldSyncBatchNormalization())
+        return false;
+    let mpi = MPIWrapper::GetInstance();
+    return mpi != nullptr && mpi->NumNodesInUse() > 1;
+}
+
+template <class ElemType>
+void BatchNormalizationNode<ElemType>::ForwardPropSynced(const Matrix<ElemType>& in, const Matrix<ElemType>& scale, const Matrix<ElemType>& bias,
+                                                         Matrix<ElemType>& runMean, Matrix<ElemType>& runVariance, Matrix<ElemType>& out,
+                                                         double expAvgFactor)
+{
+    let mpi = MPIWrapper::GetInstance();
+    const size_t numChannels = scale.GetNumRows();
+    const size_t spatialSize = in.GetNumRows() / numChannels;
+
+    // per-channel sum and sum of squares over the local sub-minibatch (gap columns were masked to zero)
+    if (!m_syncSums)
+        m_syncSums = make_shared<Matrix<ElemType>>(numChannels, 2, m_deviceId);
+    let inView = BatchNormDataView(in, numChannels);
+    BatchNormStatView(m_syncSums->ColumnSlice(0, 1), numChannels).AssignCopyOf(inView); // reduces over spatial and batch dims
+    BatchNormStatView(m_syncSums->ColumnSlice(1, 1), numChannels).AssignSqrOf(inView);
+
+    // aggregate the sums and the sample count across all workers
+    std::vector<ElemType> sums = CopyToHostVector(*m_syncSums);
+    size_t count = spatialSize * in.GetNumCols(); // note: counts gap columns, like the engines do
+    mpi->AllReduce(sums.data(), sums.size());
+    mpi->AllReduce(&count, 1);
+    m_syncSampleCount = count;
+
+    // finalize the statistics on the host, mirroring the engines' conventions: normalization uses
+    // the biased variance, while the running estimate is updated with the unbiased one
+    std::vector<ElemType> mean(numChannels), invStdDev(numChannels);
+    std::vector<ElemType> runMeanHost = CopyToHostVector(runMean);
+    std::vector<ElemType> runVarHost = CopyToHostVector(runVariance);
+    std::vector<ElemType> scaleHost = CopyToHostVector(scale);
+    std::vector<ElemType> biasHost = CopyToHostVector(bias);
+    std::vector<ElemType> alpha(numChannels), beta(numChannels); // folded so normalization is out = alpha * x + beta
+    for (size_t c = 0; c < numChannels; c++)
+    {
+        mean[c] = sums[c] / count;
+        double m2 = std::max(0.0, (double)sums[numChannels + c] - (double)count * mean[c] * mean[c]);
+        runMeanHost[c] = (ElemType)(expAvgFactor * mean[c] + (1 - expAvgFactor) * runMeanHost[c]);
+        runVarHost[c] = (ElemType)(expAvgFactor * (count <= 1 ? 0 : m2 / (count - 1)) + (1 - expAvgFactor) * runVarHost[c]);
+        invStdDev[c] = (ElemType)(1.0 / sqrt(m2 / count + m_epsilon));
+        alpha[c] = scaleHost[c] * invStdDev[c];
+        beta[c] = biasHost[c] - alpha[c] * mean[c];
+    }
+    runMean.SetValue(numChannels, 1, m_deviceId, runMeanHost.data());
+    runVariance.SetValue(numChannels, 1, m_deviceId, runVarHost.data());
+    m_savedMean->SetValue(numChannels, 1, m_deviceId, mean.data());
+    m_savedInvStdDev->SetValue(numChannels, 1, m_deviceId, invStdDev.data());
+
+    // normalize-scale-shift as two broadcast tensor ops
+    if (!m_syncScaleFactor)
+    {
+        m_syncScaleFactor = make_shared<Matrix<ElemType>>(numChannels, 1, m_deviceId);
+        m_syncBiasFactor = make_shared<Matrix<ElemType>>(numChannels, 1, m_deviceId);
+        m_syncXHatFactor = make_shared<Matrix<ElemType>>(numChannels, 1, m_deviceId);
+    }
+    m_syncScaleFactor->SetValue(numChannels, 1, m_deviceId, alpha.data());
+    m_syncBiasFactor->SetValue(numChannels, 1, m_deviceId, beta.data());
+    auto outView = BatchNormDataView(out, numChannels);
+    outView.AssignElementwiseProductOf(inView, BatchNormStatView(*m_syncScaleFactor, numChannels));
+    outView.AddCopyOf(BatchNormStatView(*m_syncBiasFactor, numChannels));
+}
+
+template <class ElemType>
+void BatchNormalizationNode<ElemType>::BackpropDataSynced(const Matrix<ElemType>& in, const Matrix<ElemType>& srcGrad, Matrix<ElemType>& grad,
+                                                          const Matrix<ElemType>& scale, Matrix<ElemType>& scaleGrad, Matrix<ElemType>& biasGrad)
+{
+    let mpi = MPIWrapper::GetInstance();
+    const size_t numChannels = scale.GetNumRows();
+    const size_t count = m_syncSampleCount; // sample count of the full distributed minibatch, cf. ForwardPropSynced()
+
+    // recompute the normalized input x-hat from the saved statistics
+    m_syncXHat->Resize(in.GetNumRows(), in.GetNumCols());
+    let inView = BatchNormDataView(in, numChannels);
+    auto xHatView = BatchNormDataView(*m_syncXHat, numChannels);
+    xHatView.AssignDifferenceOf(inView, BatchNormStatView(*m_savedMean, numChannels));
+    xHatView.AssignElementwiseProductOf(xHatView, BatchNormStatView(*m_savedInvStdDev, numChannels));
+
+    // local per-channel gradient sums; these also are this worker's scale/bias gradients
+    let srcGradView = BatchNormDataView(srcGrad, numChannels);
+    scaleGrad.Resize(numChannels, 1);
+    biasGrad.Resize(numChannels, 1);
+    BatchNormStatView(scaleGrad, numChannels).AssignElementwiseProductOf(srcGradView, xHatView); // reduces per channel
+    BatchNormStatView(biasGrad, numChannels).AssignCopyOf(srcGradView);
+
+    // The data gradient needs the sums over the full distributed minibatch, so allreduce a copy.
+    // scaleGrad/biasGrad themselves must stay local: the data-parallel gradient aggregation
+    // sums them across workers later, which completes exactly these sums.
+    std::vector<ElemType> scaleGradSum = CopyToHostVector(scaleGrad);
+    std::vector<ElemType> biasGradSum = CopyToHostVector(biasGrad);
+    scaleGradSum.insert(scaleGradSum.end(), biasGradSum.begin(), biasGradSum.end());
+    mpi->AllReduce(scaleGradSum.data(), scaleGradSum.size());
+
+    // dx += scale * invStdDev * (dy - x-hat * dScaleSum / N - dBiasSum / N), with the per-channel
+    // factors folded on the host so the elementwise part is three broadcast tensor ops
+    std::vector<ElemType> scaleHost = CopyToHostVector(scale);
+    std::vector<ElemType> invStdDevHost = CopyToHostVector(*m_savedInvStdDev);
+    std::vector<ElemType> alpha(numChannels), gamma(numChannels), delta(numChannels);
+    for (size_t c = 0; c < numChannels; c++)
+    {
+        alpha[c] = scaleHost[c] * invStdDevHost[c];
+        gamma[c] = -alpha[c] * scaleGradSum[c] / count;
+        delta[c] = -alpha[c] * scaleGradSum[numChannels + c] / count;
+    }
+    m_syncScaleFactor->SetValue(numChannels, 1, m_deviceId, alpha.data());
+    m_syncXHatFactor->SetValue(numChannels, 1, m_deviceId, gamma.data());
+    m_syncBiasFactor->SetValue(numChannels, 1, m_deviceId, delta.data());
+    auto gradView = BatchNormDataView(grad, numChannels);
+    gradView.AddElementwiseProductOf(srcGradView, BatchNormStatView(*m_syncScaleFactor, numChannels));
+    gradView.AddElementwiseProductOf(xHatView, BatchNormStatView(*m_syncXHatFactor, numChannels));
+    gradView.AddCopyOf(BatchNormStatView(*m_syncBiasFactor, numChannels));
+}
+
 #if 0 // outdated version
 template<class ElemType>
 void BatchNormalizationNode<ElemType>::AttachInputs(const std::vector<ComputationNodeBasePtr>& inputs)
@@ -108,6 +108,10 @@ template class SquareErrorNode<double>;
 // -----------------------------------------------------------------------
 // CrossEntropyWithSoftmaxNode (labels, prediction)
 // calculates: -sum(left_i * log(softmax_i(right)))
+// Labels may be given either as one-hot vectors of the same dimension as the
+// prediction, or as a scalar sequence of class indices (index-label mode).
+// The latter avoids constructing a sparse one-hot label matrix in the reader
+// and replaces the sparse product with a gather of the target log-probabilities.
 // -----------------------------------------------------------------------
 
 template <class ElemType>
@@ -119,8 +123,14 @@ class CrossEntropyWithSoftmaxNode : public ComputationNodeNonLooping /*Computati
 public:
     DeclareConstructorFromConfigWithNumInputs(CrossEntropyWithSoftmaxNode);
     CrossEntropyWithSoftmaxNode(DEVICEID_TYPE deviceId, const wstring& name)
-        : Base(deviceId, name)
+        : Base(deviceId, name), m_columnOffsets(deviceId), m_columnOffsetsRowStride(0)
+    {
+    }
+
+    // labels given as class indices (scalar per frame) rather than one-hot vectors?
+    bool IsIndexLabelMode() const
     {
+        return Input(0)->GetSampleLayout().GetNumElements() == 1 && Input(1)->GetSampleLayout().GetNumElements() > 1;
     }
 
     virtual void BackpropToNonLooping(size_t inputIndex) override
@@ -129,6 +139,8 @@ public:
         // left input is scalar
         if (inputIndex == 0) // left derivative
         {
+            if (IsIndexLabelMode()) // class indices carry no gradient
+                return;
 #if DUMPOUTPUT
             m_logSoftmaxOfRight->Print("CrossEntropyWithSoftmax Partial-logSoftmaxOfRight");
             Gradient().Print("CrossEntropyWithSoftmax Partial-gradientValues");
@@ -144,6 +156,19 @@ public:
 
         else if (inputIndex == 1) // right derivative
         {
+            if (IsIndexLabelMode())
+            {
+                auto gradient = InputRef(1).GradientFor(fr);
+                // dense part: gradient += scale * softmax
+                Matrix<ElemType>::Multiply1x1AndWeightedAdd(+1.0f, Gradient() /*1x1*/, *m_softmaxOfRight, 1.0f, gradient);
+                // one-hot part: subtract the scale at each column's target logit, by scattering
+                // a row of scale values into the flattened gradient (gaps have index -1 and are skipped)
+                m_targetValueRow->SetValue((ElemType) 1);
+                Matrix<ElemType>::Multiply1x1AndWeightedAdd(+1.0f, Gradient() /*1x1*/, *m_targetValueRow, 0.0f, *m_targetValueRow);
+                auto gradientFlat = gradient.Reshaped(1, gradient.GetNumElements());
+                gradientFlat.DoScatterColumnsOf(1, *m_targetIndex, *m_targetValueRow, -1);
+                return;
+            }
 #if DUMPOUTPUT
             m_softmaxOfRight->Print("CrossEntropyWithSoftmax Partial-softmaxOfRight");
             InputRef(0).ValueFor(fr).Print("CrossEntropyWithSoftmax Partial-inputFunctionValues");
@@ -182,11 +207,38 @@ public:
         // BUGBUG: No need to compute m_softmaxOfRight in ForwardProp, should be moved to BackpropTo().
         m_softmaxOfRight->SetValue(*m_logSoftmaxOfRight);
         m_softmaxOfRight->InplaceExp();
-        // flatten all gaps to zero, such that gaps will contribute zero to the sum
-        MaskMissingColumnsToZero(*m_logSoftmaxOfRight, InputRef(1).GetMBLayout(), fr);
-        // reduce over all frames
-        Value().AssignInnerProductOfMatrices(InputRef(0).MaskedValueFor(fr), *m_logSoftmaxOfRight);
-        Value() *= -1;
+        if (IsIndexLabelMode())
+        {
+            // labels are class indices: pick each column's target log-probability with a
+            // gather on the flattened log-softmax matrix instead of a sparse product
+            size_t numRows = m_logSoftmaxOfRight->GetNumRows();
+            size_t numCols = m_logSoftmaxOfRight->GetNumCols();
+            // flat element index of the target logit is label + column * numRows;
+            // the column offsets depend on the dimensions alone and are cached across minibatches
+            if (m_columnOffsets.GetNumCols() != numCols || m_columnOffsetsRowStride != numRows)
+            {
+                std::vector<ElemType> offsets(numCols);
+                for (size_t j = 0; j < numCols; j++)
+                    offsets[j] = (ElemType)(j * numRows);
+                m_columnOffsets.SetValue(1, numCols, Value().GetDeviceId(), offsets.data(), MatrixFormat::matrixFormatColMajor);
+                m_columnOffsetsRowStride = numRows;
+            }
+            m_targetIndex->AssignSumOf(InputRef(0).ValueFor(fr), m_columnOffsets);
+            MaskMissingColumnsTo(*m_targetIndex, InputRef(1).GetMBLayout(), fr, (ElemType) -1); // negative index means gap
+            m_targetValueRow->Resize(1, numCols);
+            m_targetValueRow->SetValue(0); // so that gap columns contribute zero to the sum
+            m_targetValueRow->DoGatherColumnsOf(1, *m_targetIndex, m_logSoftmaxOfRight->Reshaped(1, numRows * numCols), 1);
+            Value().AssignSumOfElements(*m_targetValueRow);
+            Value() *= -1;
+        }
+        else
+        {
+            // flatten all gaps to zero, such that gaps will contribute zero to the sum
+            MaskMissingColumnsToZero(*m_logSoftmaxOfRight, InputRef(1).GetMBLayout(), fr);
+            // reduce over all frames
+            Value().AssignInnerProductOfMatrices(InputRef(0).MaskedValueFor(fr), *m_logSoftmaxOfRight);
+            Value() *= -1;
+        }
 #if NANCHECK
         Value().HasNan("CrossEntropyWithSoftmax");
 #endif
@@ -197,7 +249,18 @@ public:
 
     virtual void /*ComputationNodeBase::*/ Validate(bool isFinalValidationPass) override
     {
-        ValidateBinaryReduce(isFinalValidationPass);
+        if (IsIndexLabelMode())
+        {
+            // index-label mode: labels are a scalar sequence, so the sample layouts of the
+            // two inputs do not match, and ValidateBinaryReduce() would reject them
+            ComputationNodeBase::Validate(isFinalValidationPass);
+            m_pMBLayout = nullptr; // this node does not hold mini-batch data
+            if (isFinalValidationPass && (!Input(0)->HasMBLayout() || !Input(1)->HasMBLayout()))
+                LogicError("%ls: Expected MBLayout in both inputs.", NodeDescription().c_str());
+            SetDims(TensorShape::Scalar(Environment().IsV2Library()), false);
+        }
+        else
+            ValidateBinaryReduce(isFinalValidationPass);
     }
 
     virtual void CopyTo(ComputationNodeBasePtr nodeP, const std::wstring& newName, const CopyNodeFlags flags) const override
@@ -217,6 +280,8 @@ public:
         Base::RequestMatricesBeforeForwardProp(matrixPool);
         RequestMatrixFromPool(m_logSoftmaxOfRight, matrixPool);
         RequestMatrixFromPool(m_softmaxOfRight, matrixPool);
+        RequestMatrixFromPool(m_targetIndex, matrixPool);
+        RequestMatrixFromPool(m_targetValueRow, matrixPool);
     }
 
     // release gradient and temp matrices that no longer needed after all the children's gradients are computed.
@@ -225,11 +290,18 @@ public:
         Base::ReleaseMatricesAfterBackprop(matrixPool);
         ReleaseMatrixToPool(m_logSoftmaxOfRight, matrixPool);
         ReleaseMatrixToPool(m_softmaxOfRight, matrixPool);
+        ReleaseMatrixToPool(m_targetIndex, matrixPool);
+        ReleaseMatrixToPool(m_targetValueRow, matrixPool);
     }
 
 protected:
     shared_ptr<Matrix<ElemType>> m_logSoftmaxOfRight;
     shared_ptr<Matrix<ElemType>> m_softmaxOfRight;
+    // index-label mode temporaries
+    shared_ptr<Matrix<ElemType>> m_targetIndex;    // [1 x C] flat element index of each column's target logit (-1 in gaps)
+    shared_ptr<Matrix<ElemType>> m_targetValueRow; // [1 x C] gathered target log-probabilities / scattered gradient scale
+    Matrix<ElemType> m_columnOffsets;              // [1 x C] cached column offsets (j * numRows) for flattening
+    size_t m_columnOffsetsRowStride;               // numRows that m_columnOffsets was built for
 };
 
 template class CrossEntropyWithSoftmaxNode<float>;
@@ -1271,6 +1343,8 @@ protected:
 
     void UpdateWeightsPrefixSum();
 
+    void UpdateAliasTable(const Matrix<ElemType>& samplingWeights);
+
     // Runs the sampling returning a vector with the id's of the samples. The parameter nTries is used to return the number of draws that was needed
     // to get the expected number of samples.
     const std::vector<size_t> RunSampling(size_t& nTries);
@@ -1288,6 +1362,10 @@ protected:
     bool m_allowDuplicates; // The node can create samples allowing for duplicates (sampling with replacement) or not (sampling without replacement).
     size_t m_sizeOfSampledSet; // Requested size of sample in case of run-mode = CREATE_SAMPLES.
     std::vector<double> m_samplingWeightsPrefixSum;
+    // alias table over the sampling distribution (Vose's method), for O(1) draws in RunSampling()
+    std::vector<double> m_aliasProb;   // [class] probability that a draw landing in this bucket keeps the bucket's own class
+    std::vector<int> m_aliasTable;     // [class] class returned when the coin flip fails
+    uint64_t m_weightsTimeStamp = 0;   // evaluation timestamp of Input(0) at the last table rebuild
 };
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------
@@ -2141,7 +2219,7 @@ public:
         Matrix<ElemType> sliceOutputGrad = GradientFor(fr);
 
         if (m_dropoutRate > 0)
-            sliceInput0Grad.AddElementProductOf(sliceOutputGrad, DataFor(*m_maskOfDropout, fr));
+            sliceInput0Grad.AddDropoutOf(sliceOutputGrad, (ElemType)m_dropoutRate, (ElemType)(1.0 / (1.0 - m_dropoutRate)) /*pre-scaled*/, m_dropoutSeed, DropoutStreamOffsetFor(fr));
         else
             sliceInput0Grad += sliceOutputGrad;
     }
@@ -2152,9 +2230,10 @@ public:
     virtual void UpdateFunctionMBSize() override
     {
         Base::UpdateFunctionMBSize();
-        // resize temporaries to their proper size
-        if (m_dropoutRate > 0)
-            m_maskOfDropout->Resize(Input(0)->Value());
+        // the mask is never materialized; remember where this minibatch's mask stream starts
+        // so that backprop (which runs after the offset has advanced) regenerates the same mask
+        m_dropoutSeed = GetRngSeed();
+        m_dropoutStreamOffset = GetRngOffset();
     }
 
     virtual void /*ComputationNode::*/ ForwardProp(const FrameRange& fr) override
@@ -2168,12 +2247,10 @@ public:
         }
         else
         {
-            // determine drop-out mask for this minibatch
-            auto sliceMask = DataFor(*m_maskOfDropout, fr);
-            sliceMask.SetUniformRandomMask((ElemType)m_dropoutRate, (ElemType)(1.0 / (1.0 - m_dropoutRate)) /*pre-scaled*/, GetRNGHandle());
-            // apply dropout mask
-            sliceOutputValue.AssignElementProductOf(sliceMask, sliceInput0Value);
-            UpdateRngOffset(GetRngOffset() + sliceMask.GetNumElements());
+            // generate and apply the drop-out mask in one pass; the mask is a pure function of
+            // (seed, stream offset), so it is regenerated in BackpropTo() rather than stored
+            sliceOutputValue.AssignDropoutOf(sliceInput0Value, (ElemType)m_dropoutRate, (ElemType)(1.0 / (1.0 - m_dropoutRate)) /*pre-scaled*/, m_dropoutSeed, DropoutStreamOffsetFor(fr));
+            UpdateRngOffset(GetRngOffset() + sliceOutputValue.GetNumElements());
         }
     }
 
@@ -2190,11 +2267,6 @@ public:
         m_dropoutRate = val;
     }
 
-    RNGHandle& GetRNGHandle()
-    {
-        return RngUser::GetRNGHandle(ValuePtr()->GetDeviceId());
-    }
-
     virtual void CopyTo(ComputationNodeBasePtr nodeP, const std::wstring& newName, const CopyNodeFlags flags) const override
     {
         Base::CopyTo(nodeP, newName, flags);
@@ -2203,28 +2275,25 @@ public:
             auto node = dynamic_pointer_cast<DropoutNode<ElemType>>(nodeP);
             node->m_dropoutRate = m_dropoutRate;
             node->SetRngState(GetRngSeed(), GetRngOffset());
-            node->m_maskOfDropout = m_maskOfDropout;
         }
     }
-    // request matrices needed to do node function value evaluation
-    virtual void RequestMatricesBeforeForwardProp(MatrixPool& matrixPool)
-    {
-        Base::RequestMatricesBeforeForwardProp(matrixPool);
-        RequestMatrixFromPool(m_maskOfDropout, matrixPool);
-    }
-
-    // release gradient and temp matrices that no longer needed after all the children's gradients are computed.
-    virtual void ReleaseMatricesAfterBackprop(MatrixPool& matrixPool)
-    {
-        Base::ReleaseMatricesAfterBackprop(matrixPool);
-        ReleaseMatrixToPool(m_maskOfDropout, matrixPool);
-    }
 
     double GetDropoutRate() const { return m_dropoutRate; }
 
 private:
+    // stream position of the first mask element covered by a frame range: masks occupy the RNG
+    // stream in the same layout as the value matrix, so sub-minibatch slices are reproducible
+    uint64_t DropoutStreamOffsetFor(const FrameRange& fr)
+    {
+        // dimensions come from the sample layout, not Value(), since the value matrix may
+        // already have been returned to the pool by the time backprop runs
+        auto columnRange = ColumnRangeWithMBLayoutFor(GetSampleMatrixNumCols(), fr, GetMBLayout());
+        return m_dropoutStreamOffset + columnRange.first * GetSampleMatrixNumRows();
+    }
+
     double m_dropoutRate;
-    shared_ptr<Matrix<ElemType>> m_maskOfDropout;
+    uint64_t m_dropoutSeed = 0;         // (seed, stream start) that the current minibatch's
+    uint64_t m_dropoutStreamOffset = 0; // forward pass used, for regeneration in backprop
 };
 
 // -----------------------------------------------------------------------
@@ -2536,6 +2605,14 @@ private: // time-constant conversions
         else                                                           // zero
             return 0;                                                  // no weight for prior stats, only use MB stats
     }
+
+private: // cross-worker synchronized statistics ("sync BN"); implemented in TrainingNodes.cpp (needs MPIWrapper)
+    bool UseSyncStatistics() const;
+    void ForwardPropSynced(const Matrix<ElemType>& in, const Matrix<ElemType>& scale, const Matrix<ElemType>& bias,
+                           Matrix<ElemType>& runMean, Matrix<ElemType>& runVariance, Matrix<ElemType>& out,
+                           double expAvgFactor);
+    void BackpropDataSynced(const Matrix<ElemType>& in, const Matrix<ElemType>& srcGrad, Matrix<ElemType>& grad,
+                            const Matrix<ElemType>& scale, Matrix<ElemType>& scaleGrad, Matrix<ElemType>& biasGrad);
 public:
 
     virtual void /*ComputationNodeNonLooping::*/ ForwardPropNonLooping() override
@@ -2566,6 +2643,14 @@ public:
         // produced and BackpropToNonLooping() may not be called. In
         // non-inference (training) mode, saved statistics must be produced.
         bool inferenceOnly = !Environment().IsTraining();
+
+        // Cross-worker synchronized statistics ('syncBatchNormalization', cf. TrainingNodes.cpp):
+        // normalize with the statistics of the full distributed minibatch rather than this
+        // worker's sub-minibatch. Not needed in inference, where running estimates are used.
+        m_syncStatsActive = !inferenceOnly && UseSyncStatistics();
+        if (m_syncStatsActive)
+            ForwardPropSynced(sliceInputValue, scale, bias, runMean, runVariance, sliceOutputValue, expAvgFactor);
+        else
         m_bnEng->Forward(/*in=*/ sliceInputValue, scale, bias,   // (in)
                          inferenceOnly, expAvgFactor, blendFactor,
                          runMean, runVariance,                   // (in/out) running estimates, updated from the current MB mean/variance
@@ -2619,6 +2704,9 @@ public:
 
             // Compute all derivatives in one step. Save derivatives with respect to scale and bias in temp matrices.
             // TODO: Move this out. Follow the same pattern as the RNN node. But can't without requiring another buffer.
+            if (m_syncStatsActive) // forward pass used cross-worker statistics; backprop must match (cf. TrainingNodes.cpp)
+                BackpropDataSynced(sliceInputValue, sliceOutputGrad, sliceInputGrad, scale, *m_dScale, *m_dBias);
+            else
             m_bnEng->Backward(sliceInputValue, sliceOutputGrad, // (in)  input from below, gradient from above
                               sliceInputGrad,                   // (out) gradient for data input goes here  --TODO: Check if cudnn engine adds the gradient, or just overwrites (BUGBUG). CNTK engine is OK.
                               scale,                            // (in)  out of scale and bias, only scale is needed in gradient propagation
@@ -2762,6 +2850,9 @@ public:
             if (m_blendTimeConst < 0)
                 InvalidArgument("%ls %ls requires blend time constant to be >= 0.", NodeName().c_str(), OperationName().c_str());
 
+            if (UseSyncStatistics() && m_blendTimeConst != 0)
+                InvalidArgument("%ls %ls: syncBatchNormalization does not support a non-zero blendTimeConstant.", NodeName().c_str(), OperationName().c_str());
+
             if (m_bnEng == nullptr)
             {
                 auto shape = GetSampleLayout();
@@ -2784,6 +2875,7 @@ public:
         RequestMatrixFromPool(m_dDataDummy, matrixPool);
         RequestMatrixFromPool(m_dScale, matrixPool);
         RequestMatrixFromPool(m_dBias, matrixPool);
+        RequestMatrixFromPool(m_syncXHat, matrixPool);
     }
 
     void ReleaseMatricesAfterBackprop(MatrixPool& matrixPool) override
@@ -2794,6 +2886,7 @@ public:
         ReleaseMatrixToPool(m_dDataDummy, matrixPool);
         ReleaseMatrixToPool(m_dScale, matrixPool);
         ReleaseMatrixToPool(m_dBias, matrixPool);
+        ReleaseMatrixToPool(m_syncXHat, matrixPool);
     }
 
     void SetNormalizationTimeConstants(double normalizationTimeConstant, double prevNormalizationTimeConstant,
@@ -2914,6 +3007,19 @@ private:
 
     bool m_gradientValid = false;
 
+    // Cross-worker synchronized statistics ('syncBatchNormalization', cf. TrainingNodes.cpp).
+    // Whether the last forward pass used globally aggregated statistics (backprop must match),
+    // and the sample count of the full distributed minibatch it normalized with.
+    bool m_syncStatsActive = false;
+    size_t m_syncSampleCount = 0;
+    // scratch: per-channel sum/sum-of-squares (forward) resp. gradient sums (backprop), and the
+    // folded per-channel factors of the elementwise normalization; lazily created on first use
+    shared_ptr<Matrix<ElemType>> m_syncSums;        // [C x 2]
+    shared_ptr<Matrix<ElemType>> m_syncScaleFactor; // [C x 1]
+    shared_ptr<Matrix<ElemType>> m_syncBiasFactor;  // [C x 1]
+    shared_ptr<Matrix<ElemType>> m_syncXHatFactor;  // [C x 1]
+    shared_ptr<Matrix<ElemType>> m_syncXHat;        // (pooled) normalized input, recomputed in backprop
+
     std::unique_ptr<BatchNormEngine<ElemType>> m_bnEng;
 
     bool m_convertRunningVariancePending;
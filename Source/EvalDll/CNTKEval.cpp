@@ -28,6 +28,7 @@
 #include "InputAndParamNodes.h"
 #include "latticearchive.h"
 #include <limits>
+#include <mutex>
 #include "RecurrentNodes.h"
 
 namespace Microsoft { namespace MSR { namespace CNTK {
@@ -41,9 +42,49 @@ void CNTKEvalBase<ElemType>::Init(const std::string& config)
     CPUMatrix<ElemType>::SetNumThreads(nThreads);
 
     Globals::SetShareNodeValueMatrices(m_config(L"shareNodeValueMatrices", true));
+    Globals::SetParallelForwardEval(m_config(L"parallelForwardEval", false));
+    Globals::SetFuseElementwiseOps(m_config(L"fuseElementwiseOps", false));
+    Globals::SetFuseConvolutionOps(m_config(L"fuseConvolutionOps", false));
+    Globals::SetCacheCompiledNetwork(m_config(L"cacheCompiledNetwork", false));
 }
 
 
+// ShareParameterMatrices - let this network's learnable parameters reference the matrices
+// of a previously loaded instance of the same model file, if one is still alive.
+// Evaluation never writes to parameters, so all instances of one model can read a single
+// copy of the weights; only activations (and inputs/outputs) remain per-instance. This
+// matters for serving scenarios that host many instances of one model for thread parallelism.
+template <typename ElemType>
+static void ShareParameterMatrices(const ComputationNetworkPtr& net, const std::wstring& modelPath)
+{
+    static std::mutex s_cacheMutex;
+    static std::map<std::wstring, std::map<std::wstring, std::weak_ptr<Matrix<ElemType>>>> s_parameterCache; // [modelPath@deviceId][nodeName]
+    // weak_ptrs so that the cache does not keep weights alive after the last instance is destroyed
+
+    std::wstring key = modelPath + L"@" + std::to_wstring(net->GetDeviceId());
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    auto& cachedParameters = s_parameterCache[key];
+    size_t numShared = 0;
+    for (const auto& nodeBase : net->GetNodesWithType(OperationNameOf(LearnableParameter)))
+    {
+        auto node = dynamic_pointer_cast<ComputationNode<ElemType>>(nodeBase);
+        if (!node || !node->ValuePtrRef())
+            continue;
+        auto& valuePtr = node->ValuePtrRef();
+        auto iter = cachedParameters.find(node->NodeName());
+        auto master = (iter != cachedParameters.end()) ? iter->second.lock() : nullptr;
+        if (master && master->GetNumRows() == valuePtr->GetNumRows() && master->GetNumCols() == valuePtr->GetNumCols())
+        {
+            valuePtr = master; // drop our private copy; this instance now reads the shared storage
+            numShared++;
+        }
+        else // first instance, or a stale entry: publish our copy for subsequent instances
+            cachedParameters[node->NodeName()] = valuePtr;
+    }
+    if (numShared > 0)
+        fprintf(stderr, "ShareParameterMatrices: sharing %d parameter matrices of model '%ls' with a previously loaded instance\n", (int) numShared, modelPath.c_str());
+}
+
 // CreateNetwork - create a network based on the network description
 // networkDescription - network description
 template <typename ElemType>
@@ -54,11 +95,16 @@ void CNTKEvalBase<ElemType>::CreateNetwork(const std::string& networkDescription
 
     std::vector<wstring> outputNodeNames;
     this->m_net = GetModelFromConfig<ConfigParameters, ElemType>(config, L"outputNodeNames", outputNodeNames);
-    
+
     if (this->m_net == nullptr)
     {
         LogicError("Unable to construct network from description");
     }
+
+    // share the (read-only) weight matrices across instances of the same model file
+    std::wstring modelPath = config(L"modelPath", L"");
+    if (!modelPath.empty() && config(L"shareParameterMatrices", true))
+        ShareParameterMatrices<ElemType>(this->m_net, modelPath);
 }
 
 
@@ -362,7 +408,15 @@ void CNTKEvalExtended<ElemType>::ForwardPassT(const std::vector<ValueBuffer<Elem
         inputNode->GetMBLayout()->AddSequence(0, 0, resetRNN ? 0 : SentinelValueIndicatingUnspecifedSequenceBeginIdx, numCols);
 
         if (type == MatrixType::DENSE)
-            matrix->SetValue(numRows, numCols, matrix->GetDeviceId(), buffer.m_buffer.data(), matrixFlagNormal);
+        {
+            // CPU evaluation binds the caller's buffer in place (it is column-major, read-only
+            // to the network, and outlives the forward pass); GPU evaluation copies, since the
+            // data has to cross the bus anyway.
+            if (matrix->GetDeviceId() == CPUDEVICE)
+                matrix->SetValue(numRows, numCols, CPUDEVICE, buffer.m_buffer.data(), matrixFlagDontOwnBuffer);
+            else
+                matrix->SetValue(numRows, numCols, matrix->GetDeviceId(), buffer.m_buffer.data(), matrixFlagNormal);
+        }
         else if (type == MatrixType::SPARSE)
         {
             // In the sparse case the m_data layout is identical to CUDA's CSC layout
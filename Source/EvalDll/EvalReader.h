@@ -137,10 +137,18 @@ public:
             // allocate the matrix if we don't have one yet
             auto& matrix = matrices.GetInputMatrix<ElemType>(name);
 
-            // copy over the data
+            // bind or copy over the data
             std::vector<ElemType>* data = iter->second;
             ElemType* dataPtr = data->data() + (m_currentRecord * rows);
-            matrix.SetValue(rows, recordCount, matrix.GetDeviceId(), dataPtr, matrixFlagNormal);
+            // For CPU evaluation we wrap the caller's buffer directly instead of copying it in.
+            // The caller's vectors are column-major with 'rows' elements per record, which is
+            // exactly the matrix layout, they stay alive (and unread by us) for the duration of
+            // the Evaluate() call, and the network only reads its input matrices. GPU evaluation
+            // still needs the copy, since the data must cross the PCIe bus anyway.
+            if (matrix.GetDeviceId() == CPUDEVICE && matrix.GetMatrixType() == MatrixType::DENSE)
+                matrix.SetValue(rows, recordCount, CPUDEVICE, dataPtr, matrixFlagDontOwnBuffer);
+            else
+                matrix.SetValue(rows, recordCount, matrix.GetDeviceId(), dataPtr, matrixFlagNormal);
         }
 
         // increment our record pointer
@@ -0,0 +1,324 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full licence information.
+//
+#pragma once
+#include "BlockMultiplierPlatform.h"
+#include <immintrin.h>
+#include <emmintrin.h>
+#include <assert.h>
+#include <cstdint>
+#define FOR_CNTK
+#ifdef FOR_CNTK
+#include "CommonMatrix.h"
+#endif
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// AVX-512 block handler for BlockMultiplier.
+// Blocks of 32, 64 and 128 are handled with full 512-bit registers (32 int16 lanes each);
+// blocks of 16 fall back to the AVX2 kernels and blocks of 8 to the SSE kernels, widening
+// the partial sums into the 512-bit accumulators so that the caller only ever deals in VectorT.
+// On machines with AVX512_VNNI (Cascade Lake, Ice Lake, ...) the multiply-accumulate is a single
+// VPDPWSSD; elsewhere we issue VPMADDWD + VPADDD, which is still twice the lane width of AVX2.
+// Compile the file with -mavx512f -mavx512bw (SUPPORT_AVX512 in the Makefile); the VPDPWSSD
+// path additionally needs -mavx512vnni (SUPPORT_AVX512_VNNI, which makes the binary require a
+// VNNI-capable processor). The code will throw illegal instruction on processors without
+// AVX-512 support.
+class MATH_API BlockHandlerAVX512
+{
+    private:
+        // Fused multiply-accumulate of one 512-bit row/column pair into a 32-bit accumulator.
+        FORCEINLINE static __m512i MultiplyAdd(__m512i row, __m512i col, __m512i accum)
+        {
+#ifdef __AVX512VNNI__
+            return _mm512_dpwssd_epi32(accum, row, col);
+#else
+            return _mm512_add_epi32(accum, _mm512_madd_epi16(row, col));
+#endif
+        }
+
+        // Widen a 256-bit (AVX2) partial result into a 512-bit accumulator (upper lanes zero).
+        FORCEINLINE static __m512i Widen(__m256i v)
+        {
+            return _mm512_inserti64x4(_mm512_setzero_si512(), v, 0);
+        }
+
+        //TODO: Should these be refactored somewhere else? Any BlockHandler will need access to these functions.
+        static int RowToColOffsetRewrittenB(int col, int kOffset, int blockSize, int origCols);
+        static int RowToColOffsetRewrittenA(int row, int kOffset, int blockSize, int rowsPerBlock, int origCols);
+        static void DumpM512(__m512i dumpMe);
+
+    public:
+        typedef __m512i VectorT;
+        typedef int16_t ScalarAT;
+        typedef int16_t ScalarBT;
+        typedef int32_t ScalarCT;
+        FORCEINLINE static void HandleBlock8x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m128i* resultStorage);
+        FORCEINLINE static void HandleBlock16x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m512i* resultStorage);
+        FORCEINLINE static void HandleBlock32x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m512i* resultStorage);
+        FORCEINLINE static void HandleBlock64x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m512i* resultStorage);
+        FORCEINLINE static void HandleBlock128x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m512i* resultStorage, VectorT* subtractMe);
+
+        FORCEINLINE static void HandleBlock8x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m128i* resultStorage);
+        FORCEINLINE static void HandleBlock16x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m512i* resultStorage);
+        FORCEINLINE static void HandleBlock32x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m512i* resultStorage);
+        FORCEINLINE static void HandleBlock64x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m512i* resultStorage);
+        FORCEINLINE static void HandleBlock128x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+                int blockCnt, __m512i* resultStorage, VectorT* subtractMe);
+
+        static VectorT* PrepareExtraB(const ScalarBT* /*prepareMe*/, int /*k*/, int /*n*/)
+        {
+            return nullptr;
+        }
+        static void FreePreparedB(VectorT* freeMe) { freeMe; assert(nullptr == freeMe); }
+};
+
+// Blocks of 8: reuse the SSE kernel shape - one xmm madd per row.
+FORCEINLINE void BlockHandlerAVX512::HandleBlock8x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int /*blockCnt*/, __m128i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 8, 4, k);
+    short* currA = &newA[aOffset];
+    __m128i r0 = _mm_load_si128((__m128i*)currA);
+    __m128i r1 = _mm_load_si128((__m128i*)currA + 1);
+    __m128i r2 = _mm_load_si128((__m128i*)currA + 2);
+    __m128i r3 = _mm_load_si128((__m128i*)currA + 3);
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 8, n)];
+        __m128i col = _mm_load_si128((__m128i*)currB);
+        resultStorage[RowColToOffset(0, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(0, c, n)], _mm_madd_epi16(r0, col));
+        resultStorage[RowColToOffset(1, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(1, c, n)], _mm_madd_epi16(r1, col));
+        resultStorage[RowColToOffset(2, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(2, c, n)], _mm_madd_epi16(r2, col));
+        resultStorage[RowColToOffset(3, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(3, c, n)], _mm_madd_epi16(r3, col));
+    }
+}
+
+FORCEINLINE void BlockHandlerAVX512::HandleBlock8x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int /*blockCnt*/, __m128i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 8, 1, k);
+    short* currA = &newA[aOffset];
+    __m128i r0 = _mm_load_si128((__m128i*)currA);
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 8, n)];
+        __m128i col = _mm_load_si128((__m128i*)currB);
+        resultStorage[RowColToOffset(0, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(0, c, n)], _mm_madd_epi16(r0, col));
+    }
+}
+
+// Blocks of 16: half a zmm register, so do the madd in AVX2 and widen into the 512-bit accumulator.
+FORCEINLINE void BlockHandlerAVX512::HandleBlock16x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int /*blockCnt*/, __m512i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 16, 4, k);
+    short* currA = &newA[aOffset];
+    __m256i r0 = _mm256_load_si256((__m256i*)currA);
+    __m256i r1 = _mm256_load_si256((__m256i*)currA + 1);
+    __m256i r2 = _mm256_load_si256((__m256i*)currA + 2);
+    __m256i r3 = _mm256_load_si256((__m256i*)currA + 3);
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 16, n)];
+        __m256i col = _mm256_load_si256((__m256i*)currB);
+        resultStorage[RowColToOffset(0, c, n)] = _mm512_add_epi32(resultStorage[RowColToOffset(0, c, n)], Widen(_mm256_madd_epi16(r0, col)));
+        resultStorage[RowColToOffset(1, c, n)] = _mm512_add_epi32(resultStorage[RowColToOffset(1, c, n)], Widen(_mm256_madd_epi16(r1, col)));
+        resultStorage[RowColToOffset(2, c, n)] = _mm512_add_epi32(resultStorage[RowColToOffset(2, c, n)], Widen(_mm256_madd_epi16(r2, col)));
+        resultStorage[RowColToOffset(3, c, n)] = _mm512_add_epi32(resultStorage[RowColToOffset(3, c, n)], Widen(_mm256_madd_epi16(r3, col)));
+    }
+}
+
+FORCEINLINE void BlockHandlerAVX512::HandleBlock16x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int /*blockCnt*/, __m512i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 16, 1, k);
+    short* currA = &newA[aOffset];
+    __m256i r0 = _mm256_load_si256((__m256i*)currA);
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 16, n)];
+        __m256i col = _mm256_load_si256((__m256i*)currB);
+        resultStorage[RowColToOffset(0, c, n)] = _mm512_add_epi32(resultStorage[RowColToOffset(0, c, n)], Widen(_mm256_madd_epi16(r0, col)));
+    }
+}
+
+// Blocks of 32: exactly one zmm register per row.
+FORCEINLINE void BlockHandlerAVX512::HandleBlock32x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int /*blockCnt*/, __m512i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 32, 4, k);
+    short* currA = &newA[aOffset];
+    __m512i r0 = _mm512_load_si512((__m512i*)currA);
+    __m512i r1 = _mm512_load_si512((__m512i*)currA + 1);
+    __m512i r2 = _mm512_load_si512((__m512i*)currA + 2);
+    __m512i r3 = _mm512_load_si512((__m512i*)currA + 3);
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 32, n)];
+        __m512i col = _mm512_load_si512((__m512i*)currB);
+        resultStorage[RowColToOffset(0, c, n)] = MultiplyAdd(r0, col, resultStorage[RowColToOffset(0, c, n)]);
+        resultStorage[RowColToOffset(1, c, n)] = MultiplyAdd(r1, col, resultStorage[RowColToOffset(1, c, n)]);
+        resultStorage[RowColToOffset(2, c, n)] = MultiplyAdd(r2, col, resultStorage[RowColToOffset(2, c, n)]);
+        resultStorage[RowColToOffset(3, c, n)] = MultiplyAdd(r3, col, resultStorage[RowColToOffset(3, c, n)]);
+    }
+}
+
+FORCEINLINE void BlockHandlerAVX512::HandleBlock32x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int /*blockCnt*/, __m512i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 32, 1, k);
+    short* currA = &newA[aOffset];
+    __m512i r0 = _mm512_load_si512((__m512i*)currA);
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 32, n)];
+        __m512i col = _mm512_load_si512((__m512i*)currB);
+        resultStorage[RowColToOffset(0, c, n)] = MultiplyAdd(r0, col, resultStorage[RowColToOffset(0, c, n)]);
+    }
+}
+
+// Blocks of 64: two zmm registers per row.
+FORCEINLINE void BlockHandlerAVX512::HandleBlock64x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int /*blockCnt*/, __m512i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 64, 4, k);
+    short* currA = &newA[aOffset];
+    __m512i r0a = _mm512_load_si512((__m512i*)currA);
+    __m512i r0b = _mm512_load_si512((__m512i*)currA + 1);
+    __m512i r1a = _mm512_load_si512((__m512i*)currA + 2);
+    __m512i r1b = _mm512_load_si512((__m512i*)currA + 3);
+    __m512i r2a = _mm512_load_si512((__m512i*)currA + 4);
+    __m512i r2b = _mm512_load_si512((__m512i*)currA + 5);
+    __m512i r3a = _mm512_load_si512((__m512i*)currA + 6);
+    __m512i r3b = _mm512_load_si512((__m512i*)currA + 7);
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 64, n)];
+        __m512i colA = _mm512_load_si512((__m512i*)currB);
+        __m512i colB = _mm512_load_si512((__m512i*)currB + 1);
+        resultStorage[RowColToOffset(0, c, n)] = MultiplyAdd(r0b, colB, MultiplyAdd(r0a, colA, resultStorage[RowColToOffset(0, c, n)]));
+        resultStorage[RowColToOffset(1, c, n)] = MultiplyAdd(r1b, colB, MultiplyAdd(r1a, colA, resultStorage[RowColToOffset(1, c, n)]));
+        resultStorage[RowColToOffset(2, c, n)] = MultiplyAdd(r2b, colB, MultiplyAdd(r2a, colA, resultStorage[RowColToOffset(2, c, n)]));
+        resultStorage[RowColToOffset(3, c, n)] = MultiplyAdd(r3b, colB, MultiplyAdd(r3a, colA, resultStorage[RowColToOffset(3, c, n)]));
+    }
+}
+
+FORCEINLINE void BlockHandlerAVX512::HandleBlock64x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int /*blockCnt*/, __m512i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 64, 1, k);
+    short* currA = &newA[aOffset];
+    __m512i r0a = _mm512_load_si512((__m512i*)currA);
+    __m512i r0b = _mm512_load_si512((__m512i*)currA + 1);
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 64, n)];
+        __m512i colA = _mm512_load_si512((__m512i*)currB);
+        __m512i colB = _mm512_load_si512((__m512i*)currB + 1);
+        resultStorage[RowColToOffset(0, c, n)] = MultiplyAdd(r0b, colB, MultiplyAdd(r0a, colA, resultStorage[RowColToOffset(0, c, n)]));
+    }
+}
+
+// Blocks of 128: four zmm registers per row; like the AVX2 handler we are fed two blocks at a
+// time (blockCnt) so that the column loop touches more of B per pass over the result row.
+FORCEINLINE void BlockHandlerAVX512::HandleBlock128x4(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int blockCnt, __m512i* resultStorage, VectorT* /*subtractMe*/)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 128, 4, k);
+    int aOffset2 = RowToColOffsetRewrittenA(startRow, currBlock + 1, 128, 4, k);
+    short* currA = &newA[aOffset];
+    short* currA2 = &newA[aOffset2];
+    __m512i row[16];
+    __m512i row2[16];
+    for (int i = 0; i < 16; ++i)
+    {
+        row[i] = _mm512_load_si512((__m512i*)currA + i);
+        if (blockCnt > 1)
+            row2[i] = _mm512_load_si512((__m512i*)currA2 + i);
+    }
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 128, n)];
+        short* currB2 = &B[RowToColOffsetRewrittenB(c, currBlock + 1, 128, n)];
+        __m512i colA = _mm512_load_si512((__m512i*)currB);
+        __m512i colB = _mm512_load_si512((__m512i*)currB + 1);
+        __m512i colC = _mm512_load_si512((__m512i*)currB + 2);
+        __m512i colD = _mm512_load_si512((__m512i*)currB + 3);
+        for (int r = 0; r < 4; ++r)
+        {
+            __m512i accum = resultStorage[RowColToOffset(r, c, n)];
+            accum = MultiplyAdd(row[r * 4], colA, accum);
+            accum = MultiplyAdd(row[r * 4 + 1], colB, accum);
+            accum = MultiplyAdd(row[r * 4 + 2], colC, accum);
+            accum = MultiplyAdd(row[r * 4 + 3], colD, accum);
+            resultStorage[RowColToOffset(r, c, n)] = accum;
+        }
+        if (blockCnt > 1)
+        {
+            __m512i col2A = _mm512_load_si512((__m512i*)currB2);
+            __m512i col2B = _mm512_load_si512((__m512i*)currB2 + 1);
+            __m512i col2C = _mm512_load_si512((__m512i*)currB2 + 2);
+            __m512i col2D = _mm512_load_si512((__m512i*)currB2 + 3);
+            for (int r = 0; r < 4; ++r)
+            {
+                __m512i accum = resultStorage[RowColToOffset(r, c, n)];
+                accum = MultiplyAdd(row2[r * 4], col2A, accum);
+                accum = MultiplyAdd(row2[r * 4 + 1], col2B, accum);
+                accum = MultiplyAdd(row2[r * 4 + 2], col2C, accum);
+                accum = MultiplyAdd(row2[r * 4 + 3], col2D, accum);
+                resultStorage[RowColToOffset(r, c, n)] = accum;
+            }
+        }
+    }
+}
+
+FORCEINLINE void BlockHandlerAVX512::HandleBlock128x1(int currBlock, int startRow, int k, int n, short* newA, short* B,
+        int blockCnt, __m512i* resultStorage, VectorT* /*subtractMe*/)
+{
+    // On the x1 path A was rewritten with one row per block, so the offsets must be
+    // computed with rowsPerBlock=1 (as in BlockHandlerSSE); with rowsPerBlock=4 the two
+    // formulas coincide only while there is a single 128-block.
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 128, 1, k);
+    int aOffset2 = RowToColOffsetRewrittenA(startRow, currBlock + 1, 128, 1, k);
+    short* currA = &newA[aOffset];
+    short* currA2 = &newA[aOffset2];
+    __m512i row[4];
+    __m512i row2[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        row[i] = _mm512_load_si512((__m512i*)currA + i);
+        if (blockCnt > 1)
+            row2[i] = _mm512_load_si512((__m512i*)currA2 + i);
+    }
+    for (int c = 0; c < n; ++c)
+    {
+        short* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 128, n)];
+        short* currB2 = &B[RowToColOffsetRewrittenB(c, currBlock + 1, 128, n)];
+        __m512i accum = resultStorage[RowColToOffset(0, c, n)];
+        accum = MultiplyAdd(row[0], _mm512_load_si512((__m512i*)currB), accum);
+        accum = MultiplyAdd(row[1], _mm512_load_si512((__m512i*)currB + 1), accum);
+        accum = MultiplyAdd(row[2], _mm512_load_si512((__m512i*)currB + 2), accum);
+        accum = MultiplyAdd(row[3], _mm512_load_si512((__m512i*)currB + 3), accum);
+        if (blockCnt > 1)
+        {
+            accum = MultiplyAdd(row2[0], _mm512_load_si512((__m512i*)currB2), accum);
+            accum = MultiplyAdd(row2[1], _mm512_load_si512((__m512i*)currB2 + 1), accum);
+            accum = MultiplyAdd(row2[2], _mm512_load_si512((__m512i*)currB2 + 2), accum);
+            accum = MultiplyAdd(row2[3], _mm512_load_si512((__m512i*)currB2 + 3), accum);
+        }
+        resultStorage[RowColToOffset(0, c, n)] = accum;
+    }
+}
+
+}}}
@@ -0,0 +1,201 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full licence information.
+//
+#pragma once
+#include "BlockMultiplierPlatform.h"
+#include <immintrin.h>
+#include <emmintrin.h>
+#include <assert.h>
+#include <cstdint>
+#define FOR_CNTK
+#ifdef FOR_CNTK
+#include "CommonMatrix.h"
+#endif
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// Int8 AVX2 block handler for BlockMultiplier.
+// A and B are stored as int8, which halves the memory traffic relative to the int16 handlers;
+// the kernels sign-extend 16 int8 values at a time to int16 (VPMOVSXBW) and then use the same
+// VPMADDWD multiply-accumulate as BlockHandlerAVX, so the accumulation is exact in int32.
+// The block rewrite logic in BlockMultiplier is element-type agnostic, so this handler reuses
+// the same PrepareB/RewriteBInBlockOrder machinery via BlockMultiplier<BlockHandlerAVXInt8>.
+class MATH_API BlockHandlerAVXInt8
+{
+    private:
+        // Load 16 int8 values and sign-extend them to a 16-lane int16 vector.
+        FORCEINLINE static __m256i LoadSx16(const int8_t* p)
+        {
+            return _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i*)p));
+        }
+        // Multiply-accumulate a sign-extended row/column pair into a 32-bit accumulator.
+        FORCEINLINE static __m256i MultiplyAdd(__m256i row, __m256i col, __m256i accum)
+        {
+            return _mm256_add_epi32(accum, _mm256_madd_epi16(row, col));
+        }
+
+        static int RowToColOffsetRewrittenB(int col, int kOffset, int blockSize, int origCols);
+        static int RowToColOffsetRewrittenA(int row, int kOffset, int blockSize, int rowsPerBlock, int origCols);
+
+    public:
+        typedef __m256i VectorT;
+        typedef int8_t ScalarAT;
+        typedef int8_t ScalarBT;
+        typedef int32_t ScalarCT;
+        FORCEINLINE static void HandleBlock8x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m128i* resultStorage);
+        FORCEINLINE static void HandleBlock16x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m256i* resultStorage);
+        FORCEINLINE static void HandleBlock32x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m256i* resultStorage);
+        FORCEINLINE static void HandleBlock64x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m256i* resultStorage);
+        FORCEINLINE static void HandleBlock128x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m256i* resultStorage, VectorT* subtractMe);
+
+        FORCEINLINE static void HandleBlock8x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m128i* resultStorage);
+        FORCEINLINE static void HandleBlock16x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m256i* resultStorage);
+        FORCEINLINE static void HandleBlock32x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m256i* resultStorage);
+        FORCEINLINE static void HandleBlock64x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m256i* resultStorage);
+        FORCEINLINE static void HandleBlock128x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockCnt, __m256i* resultStorage, VectorT* subtractMe);
+
+        static VectorT* PrepareExtraB(const ScalarBT* /*prepareMe*/, int /*k*/, int /*n*/)
+        {
+            return nullptr;
+        }
+        static void FreePreparedB(VectorT* freeMe) { freeMe; assert(nullptr == freeMe); }
+
+    private:
+        // Shared body for the wide kernels: numVecs sign-extended 16-lane vectors per row.
+        template <int numVecs, int numRows>
+        FORCEINLINE static void HandleBlockImpl(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+                int blockSize, int rowsPerBlock, __m256i* resultStorage)
+        {
+            int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, blockSize, rowsPerBlock, k);
+            int8_t* currA = &newA[aOffset];
+            __m256i row[numVecs * numRows];
+            for (int i = 0; i < numVecs * numRows; ++i)
+            {
+                row[i] = LoadSx16(currA + 16 * i);
+            }
+            for (int c = 0; c < n; ++c)
+            {
+                int8_t* currB = &B[RowToColOffsetRewrittenB(c, currBlock, blockSize, n)];
+                __m256i col[numVecs];
+                for (int v = 0; v < numVecs; ++v)
+                {
+                    col[v] = LoadSx16(currB + 16 * v);
+                }
+                for (int r = 0; r < numRows; ++r)
+                {
+                    __m256i accum = resultStorage[RowColToOffset(r, c, n)];
+                    for (int v = 0; v < numVecs; ++v)
+                    {
+                        accum = MultiplyAdd(row[r * numVecs + v], col[v], accum);
+                    }
+                    resultStorage[RowColToOffset(r, c, n)] = accum;
+                }
+            }
+        }
+};
+
+// Blocks of 8: sign-extend 8 int8 values into an xmm int16 vector and madd, same shape as the SSE kernel.
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock8x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int /*blockCnt*/, __m128i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 8, 4, k);
+    int8_t* currA = &newA[aOffset];
+    __m128i r0 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)currA));
+    __m128i r1 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(currA + 8)));
+    __m128i r2 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(currA + 16)));
+    __m128i r3 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(currA + 24)));
+    for (int c = 0; c < n; ++c)
+    {
+        int8_t* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 8, n)];
+        __m128i col = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)currB));
+        resultStorage[RowColToOffset(0, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(0, c, n)], _mm_madd_epi16(r0, col));
+        resultStorage[RowColToOffset(1, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(1, c, n)], _mm_madd_epi16(r1, col));
+        resultStorage[RowColToOffset(2, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(2, c, n)], _mm_madd_epi16(r2, col));
+        resultStorage[RowColToOffset(3, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(3, c, n)], _mm_madd_epi16(r3, col));
+    }
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock8x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int /*blockCnt*/, __m128i* resultStorage)
+{
+    int aOffset = RowToColOffsetRewrittenA(startRow, currBlock, 8, 1, k);
+    int8_t* currA = &newA[aOffset];
+    __m128i r0 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)currA));
+    for (int c = 0; c < n; ++c)
+    {
+        int8_t* currB = &B[RowToColOffsetRewrittenB(c, currBlock, 8, n)];
+        __m128i col = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)currB));
+        resultStorage[RowColToOffset(0, c, n)] = _mm_add_epi32(resultStorage[RowColToOffset(0, c, n)], _mm_madd_epi16(r0, col));
+    }
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock16x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int /*blockCnt*/, __m256i* resultStorage)
+{
+    HandleBlockImpl<1, 4>(currBlock, startRow, k, n, newA, B, 16, 4, resultStorage);
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock16x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int /*blockCnt*/, __m256i* resultStorage)
+{
+    HandleBlockImpl<1, 1>(currBlock, startRow, k, n, newA, B, 16, 1, resultStorage);
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock32x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int /*blockCnt*/, __m256i* resultStorage)
+{
+    HandleBlockImpl<2, 4>(currBlock, startRow, k, n, newA, B, 32, 4, resultStorage);
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock32x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int /*blockCnt*/, __m256i* resultStorage)
+{
+    HandleBlockImpl<2, 1>(currBlock, startRow, k, n, newA, B, 32, 1, resultStorage);
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock64x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int /*blockCnt*/, __m256i* resultStorage)
+{
+    HandleBlockImpl<4, 4>(currBlock, startRow, k, n, newA, B, 64, 4, resultStorage);
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock64x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int /*blockCnt*/, __m256i* resultStorage)
+{
+    HandleBlockImpl<4, 1>(currBlock, startRow, k, n, newA, B, 64, 1, resultStorage);
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock128x4(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int blockCnt, __m256i* resultStorage, VectorT* /*subtractMe*/)
+{
+    HandleBlockImpl<8, 4>(currBlock, startRow, k, n, newA, B, 128, 4, resultStorage);
+    if (blockCnt > 1)
+    {
+        HandleBlockImpl<8, 4>(currBlock + 1, startRow, k, n, newA, B, 128, 4, resultStorage);
+    }
+}
+
+FORCEINLINE void BlockHandlerAVXInt8::HandleBlock128x1(int currBlock, int startRow, int k, int n, int8_t* newA, int8_t* B,
+        int blockCnt, __m256i* resultStorage, VectorT* /*subtractMe*/)
+{
+    // On the x1 path A is rewritten one row per block, so rowsPerBlock must be 1 here; the
+    // rowsPerBlock=4 offsets coincide only while there is a single 128-block (k < 256).
+    HandleBlockImpl<8, 1>(currBlock, startRow, k, n, newA, B, 128, 1, resultStorage);
+    if (blockCnt > 1)
+    {
+        HandleBlockImpl<8, 1>(currBlock + 1, startRow, k, n, newA, B, 128, 1, resultStorage);
+    }
+}
+
+}}}
@@ -20,9 +20,12 @@
 #include <vector>
 #include "BlockMultiplierMatrixUtil.h"
 #include "BlockHandlerSSE.h"
-#ifdef SUPPORT_AVX2
+#if defined(SUPPORT_AVX2) || defined(SUPPORT_AVX512)
 #include "BlockHandlerAVX.h"
 #endif
+#ifdef SUPPORT_AVX512
+#include "BlockHandlerAVX512.h"
+#endif
 //#define STDTHREAD
 #define OPENMPTHREAD
 #ifdef STDTHREAD
@@ -182,7 +185,7 @@ template<typename BlockHandlerT> class BlockMultiplier
         static void BlockHandler128x4Thread(HandlerArgs<BlockHandlerT> ha)
         {
             // Accumulate full row results locally b/f writing to C
-            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * ha.rowsPerBlock * ha.n, 16);
+            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * ha.rowsPerBlock * ha.n, 64);
             memset(resultStorage, 0, sizeof(VectorT) * ha.rowsPerBlock * ha.n);
             const int blocksAtOnce = 2;
 
@@ -221,7 +224,7 @@ template<typename BlockHandlerT> class BlockMultiplier
 
         static void BlockHandler64x4Thread(HandlerArgs<BlockHandlerT> ha)
         {
-            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * 4 * ha.n, 16);
+            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * 4 * ha.n, 64);
             memset(resultStorage, 0, sizeof(VectorT) * 4 * ha.n);
             int32_t* transC = ha.transC;
 
@@ -254,7 +257,7 @@ template<typename BlockHandlerT> class BlockMultiplier
 
         static void BlockHandler32x4Thread(HandlerArgs<BlockHandlerT> ha)
         {
-            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * 4 * ha.n, 16);
+            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * 4 * ha.n, 64);
             memset(resultStorage, 0, sizeof(VectorT) * 4 * ha.n);
             int32_t* transC = ha.transC;
 
@@ -287,7 +290,7 @@ template<typename BlockHandlerT> class BlockMultiplier
 
         static void BlockHandler16x4Thread(HandlerArgs<BlockHandlerT> ha)
         {
-            VectorT* resultStorage = (VectorT*) ALIGNED_ALLOC(sizeof(VectorT) * 4 * ha.n, 16);
+            VectorT* resultStorage = (VectorT*) ALIGNED_ALLOC(sizeof(VectorT) * 4 * ha.n, 64);
             memset(resultStorage, 0, sizeof(VectorT) * 4 * ha.n);
             int32_t* transC = ha.transC;
             for (int currBlock = 0; currBlock < ha.blocks; ++currBlock)
@@ -319,7 +322,7 @@ template<typename BlockHandlerT> class BlockMultiplier
 
         static void BlockHandler8x4Thread(HandlerArgs<BlockHandlerT> ha)
         {
-            __m128i* resultStorage = (__m128i*)ALIGNED_ALLOC(sizeof(__m128i) * 4 * ha.n, 16);
+            __m128i* resultStorage = (__m128i*)ALIGNED_ALLOC(sizeof(__m128i) * 4 * ha.n, 64);
             memset(resultStorage, 0, sizeof(__m128i) * 4 * ha.n);
             int32_t* transC = ha.transC;
             //_mm_prefetch((char*)&(transC[RowColToOffset(c, ha.startRow, m)]), _MM_HINT_T1);
@@ -379,7 +382,7 @@ template<typename BlockHandlerT> class BlockMultiplier
 
         static void BlockHandler64x1Thread(HandlerArgs<BlockHandlerT> ha)
         {
-            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * ha.rowsPerBlock * ha.n, 16);
+            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * ha.rowsPerBlock * ha.n, 64);
             memset(resultStorage, 0, sizeof(VectorT) * ha.rowsPerBlock * ha.n);
             int32_t* transC = ha.transC;
 
@@ -403,7 +406,7 @@ template<typename BlockHandlerT> class BlockMultiplier
 
         static void BlockHandler32x1Thread(HandlerArgs<BlockHandlerT> ha)
         {
-            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * ha.rowsPerBlock * ha.n, 16);
+            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * ha.rowsPerBlock * ha.n, 64);
             memset(resultStorage, 0, sizeof(VectorT) * ha.rowsPerBlock * ha.n);
             int32_t* transC = ha.transC;
 
@@ -427,7 +430,7 @@ template<typename BlockHandlerT> class BlockMultiplier
 
         static void BlockHandler16x1Thread(HandlerArgs<BlockHandlerT> ha)
         {
-            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * ha.rowsPerBlock * ha.n, 16);
+            VectorT* resultStorage = (VectorT*)ALIGNED_ALLOC(sizeof(VectorT) * ha.rowsPerBlock * ha.n, 64);
             memset(resultStorage, 0, sizeof(VectorT) * ha.rowsPerBlock  * ha.n);
             int32_t* transC = ha.transC;
 
@@ -512,7 +515,7 @@ template<typename BlockHandlerT> class BlockMultiplier
             return _mm_extract_epi32(res2, 0);
         }
 
-#ifdef SUPPORT_AVX2
+#if defined(SUPPORT_AVX2) || defined(SUPPORT_AVX512)
         //Same as above, for AVX registers
         FORCEINLINE static __m256i my_adds_epi32(__m256i a, __m256i b)
         {
@@ -545,6 +548,30 @@ template<typename BlockHandlerT> class BlockMultiplier
         }
 #endif
 
+#ifdef SUPPORT_AVX512
+        //Same as above, for AVX-512 registers. Blend is replaced with mask moves.
+        FORCEINLINE static __m512i my_adds_epi32(__m512i a, __m512i b)
+        {
+            __m512i int_min = _mm512_set1_epi32(0x80000000);
+            __m512i int_max = _mm512_set1_epi32(0x7FFFFFFF);
+            __m512i res = _mm512_add_epi32(a, b);
+            __m512i sign_and = _mm512_and_si512(a, b);
+            __m512i sign_or = _mm512_or_si512(a, b);
+            __mmask16 min_sat_mask = _mm512_cmplt_epi32_mask(_mm512_andnot_si512(res, sign_and), _mm512_setzero_si512());
+            __mmask16 max_sat_mask = _mm512_cmplt_epi32_mask(_mm512_andnot_si512(sign_or, res), _mm512_setzero_si512());
+            res = _mm512_mask_mov_epi32(res, min_sat_mask, int_min);
+            return _mm512_mask_mov_epi32(res, max_sat_mask, int_max);
+        }
+
+        //Same as above, for AVX-512 registers. Fold the halves together and reuse the 256-bit reduction.
+        FORCEINLINE static int32_t my_hadd(__m512i hAddMe)
+        {
+            __m256i lo = _mm512_extracti64x4_epi64(hAddMe, 0);
+            __m256i hi = _mm512_extracti64x4_epi64(hAddMe, 1);
+            return my_hadd(my_adds_epi32(lo, hi));
+        }
+#endif
+
 
         int m_numThreads;
 
@@ -4,6 +4,7 @@
 //
 #pragma once
 #include "Basics.h" // for RuntimeError()
+#include "Globals.h"
 #include "Matrix.h"
 #include "File.h"
 #include "Helpers.h"
@@ -156,6 +157,8 @@ public:
     void SetUniformRandomValue(const ElemType low, const ElemType high, unsigned long seed = USE_TIME_BASED_SEED);
     void SetGaussianRandomValue(const ElemType mean, const ElemType sigma, unsigned long seed = USE_TIME_BASED_SEED);
     void SetUniformRandomMask(const ElemType maskRate, const ElemType scaleValue, RNGHandle& rngHandle);
+    CPUMatrix<ElemType>& AssignDropoutOf(const CPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset);
+    CPUMatrix<ElemType>& AddDropoutOf(const CPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset);
     void AddGaussianRandomValue(const ElemType mean, const ElemType sigma, unsigned long seed = USE_TIME_BASED_SEED);
 
     CPUMatrix<ElemType> Transpose();
@@ -398,6 +401,10 @@ public:
     void BatchNormalizationBackward(const CPUMatrix<ElemType>& in, CPUMatrix<ElemType>& grad, const CPUMatrix<ElemType>& scale, double blendFactor, const CPUMatrix<ElemType>& saveMean, const CPUMatrix<ElemType>& saveInvStdDev,
                                     CPUMatrix<ElemType>& scaleGrad, CPUMatrix<ElemType>& biasGrad) const;
 
+    void RNNForward(const CPUMatrix<ElemType>& inputX, const CPUMatrix<ElemType>& paramW, size_t xDim, size_t yDim, const vector<size_t>& numSequencesForFrame, const struct RnnAttributes& rnnAttributes, CPUMatrix<ElemType>& reserve, CPUMatrix<ElemType>& workspace);
+    void RNNBackwardData(const CPUMatrix<ElemType>& outputDY, const CPUMatrix<ElemType>& paramW, CPUMatrix<ElemType>& outputDX, const struct RnnAttributes& rnnAttributes, CPUMatrix<ElemType>& reserve, CPUMatrix<ElemType>& workspace);
+    void RNNBackwardWeights(const CPUMatrix<ElemType>& inputX, const CPUMatrix<ElemType>& outputY, CPUMatrix<ElemType>& dw, const struct RnnAttributes& rnnAttributes, CPUMatrix<ElemType>& reserve, CPUMatrix<ElemType>& workspace);
+
 public:
     // This functions do not depend on <ElemType>, i.e. you can call them on any <ElemType>
     static int SetNumThreads(int numThreads);
@@ -488,6 +495,26 @@ public:
         size_t numRows, numCols;
         int format;
         stream >> matrixName >> format >> numRows >> numCols;
+
+        // Fast path for model load: in binary mode the on-disk payload is already the raw
+        // column-major element array, so instead of copying it through a heap buffer the matrix
+        // can point straight at a copy-on-write mapping of the file. Loading skips the payload
+        // read entirely, processes loading the same model share the read-only weight pages, and
+        // a write (e.g. a model update during training) transparently faults in a private copy
+        // of the touched page. Requires an element-aligned payload position; anything else takes
+        // the copying path below.
+        if (Globals::ShouldMemoryMapWeights() && !stream.IsTextBased() && stream.CanSeek() &&
+            numRows * numCols > 0 && (stream.GetPosition() % sizeof(ElemType)) == 0)
+        {
+            void* mapped = stream.TryMapCopyOnWrite(numRows * numCols * sizeof(ElemType));
+            if (mapped != nullptr)
+            {
+                stream.GetMarker(fileMarkerEndSection, std::wstring(L"EMAT"));
+                us.SetValue(numRows, numCols, (ElemType*) mapped, matrixFlagDontOwnBuffer);
+                return stream;
+            }
+        }
+
         ElemType* d_array = new ElemType[numRows * numCols];
         for (size_t i = 0; i < numRows * numCols; ++i)
             stream >> d_array[i];
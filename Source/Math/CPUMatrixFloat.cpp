@@ -19,6 +19,14 @@ namespace Microsoft { namespace MSR { namespace CNTK {
         return (m_traceLevel > 0);
     }
 
+    bool MATH_API TracingGPUMemoryAllocator::m_cachingEnabled = true;
+
+#ifdef CPUONLY
+    void TracingGPUMemoryAllocator::PurgeCache()
+    {
+    }
+#endif
+
     // explicit instantiations, due to CPUMatrix being too big and causing VS2015 cl crash.
     template class MATH_API CPUMatrix<float>;
 }}}
\ No newline at end of file
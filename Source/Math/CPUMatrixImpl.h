@@ -11,7 +11,9 @@
 #include "File.h"
 
 #include "CPUMatrix.h"
+#include "RNNCommon.h"
 #include "TensorOps.h"
+#include "CPUTensorOpsSimd.h"
 #include <assert.h>
 #include <stdexcept>
 #include <omp.h>
@@ -106,10 +108,25 @@ CPUMatrix<ElemType>::CPUMatrix()
 
 // helper to allocate an array of ElemType
 // Use this instead of new[] to get NaN initialization for debugging.
+// Large buffers are zeroed in parallel rather than by 'new ElemType[n]()', so that under the
+// OS's first-touch policy their pages get placed on the NUMA nodes of the worker threads that
+// touch them, instead of all landing on the node of the allocating thread. The msra::numa
+// helpers are Windows-only, whereas this works wherever we have OpenMP.
 template <class ElemType>
 static ElemType* NewArray(size_t n)
 {
-    ElemType* p = new ElemType[n]();
+    ElemType* p;
+    const size_t numaFirstTouchThresholdBytes = 1 << 20; // small buffers are not worth a parallel region
+    if (n * sizeof(ElemType) >= numaFirstTouchThresholdBytes)
+    {
+        p = new ElemType[n]; // no value-initialization; ElemType is a scalar type, so this does not touch the pages
+        long long nLL = (long long) n;
+#pragma omp parallel for
+        for (long long i = 0; i < nLL; i++)
+            p[i] = 0;
+    }
+    else
+        p = new ElemType[n]();
 #if 0 // _DEBUG
         ElemType nan = Matrix<ElemType>::MakeNan(__LINE__);
         for (size_t i = 0; i < n; i++)
@@ -589,21 +606,23 @@ CPUMatrix<ElemType>& CPUMatrix<ElemType>::AssignTransposeOf(const CPUMatrix<Elem
 
     auto& us = *this;
 
+    // Cache-blocked transpose: walking both matrices a tile at a time keeps the strided side of
+    // the copy inside a small working set, instead of striding through the whole source column
+    // per output row. The tile (64x64 elements) fits in L1 for float and double, and the tiles
+    // are independent so the tile loop parallelizes without write conflicts.
+    const long blockSize = 64;
 #pragma omp parallel for
-    for (long j = 0; j < n; j++)
+    for (long jb = 0; jb < n; jb += blockSize)
     {
-        // four-way unrolling
-        for (long i = 0; i < (m & ~3); i += 4)
-        {
-            us(j, i) = a(i, j);
-            us(j, i + 1) = a(i + 1, j);
-            us(j, i + 2) = a(i + 2, j);
-            us(j, i + 3) = a(i + 3, j);
-        }
-        // handle remaining stuffs
-        for (long i = m & ~3; i < m; i++)
+        const long jEnd = std::min(n, jb + blockSize);
+        for (long ib = 0; ib < m; ib += blockSize)
         {
-            us(j, i) = a(i, j);
+            const long iEnd = std::min(m, ib + blockSize);
+            for (long j = jb; j < jEnd; j++)
+            {
+                for (long i = ib; i < iEnd; i++)
+                    us(j, i) = a(i, j);
+            }
         }
     }
 
@@ -642,8 +661,13 @@ CPUMatrix<ElemType>& CPUMatrix<ElemType>::DoGatherColumnsOf(ElemType beta, const
         Resize(a.GetNumRows(), idx.GetNumCols());
 
     auto& us = *this;
-    // race-condition consideration: Since this loops over independent output columns, this has no race condition. Cf. DoScatterColumnsOf().
-#pragma omp parallel for // TODO: Depending in circumstance, it may be more efficient to parallelize over rows.
+
+    // Precheck pass: validate and decode the map up front (an InvalidArgument() thrown from inside
+    // the OMP region below would terminate the process), drop gap columns (negative index), and
+    // coalesce runs of adjacent source columns so they can be moved with one wide copy each.
+    struct ColumnRun { size_t jOut, jIn, numCols; };
+    std::vector<ColumnRun> runs;
+    runs.reserve(idx.GetNumCols());
     foreach_column(jOut, us)
     {
         auto jInF = idx(0, jOut);         // this is the column we need to get
@@ -652,7 +676,24 @@ CPUMatrix<ElemType>& CPUMatrix<ElemType>::DoGatherColumnsOf(ElemType beta, const
         size_t jIn = (size_t)jInF;
         if (jIn >= a.GetNumCols())
             InvalidArgument("DoGatherColumnsOf: Map out of bounds. %ld >= %ld", (long int)jIn, (long int)a.GetNumCols());
-        ScaleAndAddColumn(beta, &us(0,jOut), &a(0,jIn), us.GetNumRows(), alpha);
+        if (!runs.empty() && runs.back().jOut + runs.back().numCols == (size_t)jOut && runs.back().jIn + runs.back().numCols == jIn)
+            runs.back().numCols++;
+        else
+            runs.push_back(ColumnRun{(size_t)jOut, jIn, 1});
+    }
+
+    // race-condition consideration: Since this loops over independent output columns, this has no race condition. Cf. DoScatterColumnsOf().
+    size_t numRows = us.GetNumRows();
+    bool plainCopy = (alpha == 1 && beta == 0); // common case: whole runs can be moved with one memcpy
+#pragma omp parallel for // TODO: Depending in circumstance, it may be more efficient to parallelize over rows.
+    for (long r = 0; r < (long)runs.size(); r++)
+    {
+        const auto& run = runs[r];
+        if (plainCopy) // columns are contiguous in memory, so a run is one contiguous block
+            memcpy(&us(0, run.jOut), &a(0, run.jIn), sizeof(ElemType) * numRows * run.numCols);
+        else
+            for (size_t j = 0; j < run.numCols; j++)
+                ScaleAndAddColumn(beta, &us(0, run.jOut + j), &a(0, run.jIn + j), numRows, alpha);
     }
 
     return *this;
@@ -867,7 +908,10 @@ void CPUMatrix<ElemType>::SetValue(const size_t numRows, const size_t numCols, E
     if (matrixFlags & matrixFlagDontOwnBuffer)
     {
         // free previous array allocation if any before overwriting
-        delete[] Buffer();
+        // (unless that buffer was external as well, i.e. owned by the caller; repeated
+        // rebinding to external buffers must not free the previously bound one)
+        if (!HasExternalBuffer())
+            delete[] Buffer();
 
         m_numRows = numRows;
         m_numCols = numCols;
@@ -1028,15 +1072,23 @@ void CPUMatrix<ElemType>::SetGaussianRandomValue(const ElemType mean, const Elem
     if (IsEmpty())
         LogicError("SetUniformRandomValue: Matrix is empty.");
 
-    auto& us = *this;
-
-    std::mt19937_64 generator(seed == USE_TIME_BASED_SEED ? (unsigned long) time(NULL) : seed);
-    boost::random::normal_distribution<ElemType> r(mean, sigma);
+    uint64_t rngSeed = (seed == USE_TIME_BASED_SEED) ? (unsigned long) time(NULL) : seed;
 
-    // #pragma omp parallel for   // is it thread safe?
-    foreach_coord (i, j, us)
+    // Counter-based generation: each 128-bit Philox block yields four samples, and blocks are
+    // independent, so threads can fill disjoint ranges in parallel with a reproducible result.
+    ElemType* bufPtr = Data();
+    long m = (long) GetNumElements();
+    long numBlocks = (m + 3) / 4;
+#pragma omp parallel for
+    for (long b = 0; b < numBlocks; b++)
     {
-        us(i, j) = r(generator);
+        uint32_t rnd[4];
+        CPUPhiloxRNG::Generate(rngSeed, (uint64_t) b, rnd);
+        ElemType z[4];
+        CPUPhiloxRNG::ToGaussianPair(rnd[0], rnd[1], z[0], z[1]);
+        CPUPhiloxRNG::ToGaussianPair(rnd[2], rnd[3], z[2], z[3]);
+        for (long k = 0, i = 4 * b; k < 4 && i < m; k++, i++)
+            bufPtr[i] = mean + sigma * z[k];
     }
 }
 
@@ -1086,31 +1138,92 @@ void CPUMatrix<ElemType>::SetUniformRandomMask(const ElemType maskRate, const El
     if (cpuRNGHandle == nullptr)
         LogicError("rngHandle must be a CPURNGHandle.");
 
-    auto& us = *this;
-    boost::random::uniform_real_distribution<ElemType> r(0, 1);
-    long m = (long) GetNumRows(), n = (long) GetNumCols();
-    ElemType v;
-    for (long j = 0; j < n; j++)
+    // Counter-based generation keyed by the handle's (seed, offset): blocks are independent, so
+    // threads can fill disjoint ranges in parallel, and advancing the offset afterwards gives the
+    // next call (e.g. the next minibatch's dropout mask) a fresh but reproducible stream.
+    const uint64_t rngSeed = cpuRNGHandle->Seed();
+    const uint64_t rngOffset = cpuRNGHandle->Offset();
+    ElemType* bufPtr = Data();
+    long m = (long) GetNumElements();
+    long numBlocks = (m + 3) / 4;
+#pragma omp parallel for
+    for (long b = 0; b < numBlocks; b++)
     {
-        // four-way unrolling
-        for (long i = 0; i < (m & ~3); i += 4)
+        uint32_t rnd[4];
+        CPUPhiloxRNG::Generate(rngSeed, rngOffset + (uint64_t) b, rnd);
+        for (long k = 0, i = 4 * b; k < 4 && i < m; k++, i++)
         {
-            v = r(cpuRNGHandle->Generator());
-            us(i, j) = v <= maskRate ? 0 : scaleValue;
-            v = r(cpuRNGHandle->Generator());
-            us(i + 1, j) = v <= maskRate ? 0 : scaleValue;
-            v = r(cpuRNGHandle->Generator());
-            us(i + 2, j) = v <= maskRate ? 0 : scaleValue;
-            v = r(cpuRNGHandle->Generator());
-            us(i + 3, j) = v <= maskRate ? 0 : scaleValue;
+            ElemType v = CPUPhiloxRNG::ToUniform<ElemType>(rnd[k]);
+            bufPtr[i] = v <= maskRate ? 0 : scaleValue;
         }
-        // handle remaining stuffs
-        for (long i = m & ~3; i < m; i++)
+    }
+    cpuRNGHandle->AdvanceOffset((uint64_t) numBlocks);
+}
+
+// [this] = dropoutMask(seed, offset) .* a * scaleValue
+// Fused generate-and-apply: the mask value of element i is derived from word (offset + i) % 4 of
+// Philox counter (offset + i) / 4, so any sub-range of the stream regenerates the same mask and
+// no mask matrix needs to be materialized.
+template <class ElemType>
+CPUMatrix<ElemType>& CPUMatrix<ElemType>::AssignDropoutOf(const CPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset)
+{
+    if (a.IsEmpty())
+        LogicError("AssignDropoutOf: Matrix a is empty.");
+
+    RequireSize(a.GetNumRows(), a.GetNumCols());
+
+    const ElemType* aPtr = a.Data();
+    ElemType* usPtr = Data();
+    long m = (long) GetNumElements();
+    const uint64_t firstCounter = offset / 4;
+    long numBlocks = (long) ((offset + m - 1) / 4 - firstCounter + 1);
+#pragma omp parallel for
+    for (long b = 0; b < numBlocks; b++)
+    {
+        uint32_t rnd[4];
+        CPUPhiloxRNG::Generate(seed, firstCounter + (uint64_t) b, rnd);
+        for (long k = 0; k < 4; k++)
+        {
+            int64_t i = (int64_t) (firstCounter + (uint64_t) b) * 4 + k - (int64_t) offset;
+            if (i < 0 || i >= m)
+                continue;
+            ElemType v = CPUPhiloxRNG::ToUniform<ElemType>(rnd[k]);
+            usPtr[i] = v <= maskRate ? 0 : aPtr[i] * scaleValue;
+        }
+    }
+    return *this;
+}
+
+// [this] += dropoutMask(seed, offset) .* a * scaleValue
+template <class ElemType>
+CPUMatrix<ElemType>& CPUMatrix<ElemType>::AddDropoutOf(const CPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset)
+{
+    if (a.IsEmpty())
+        LogicError("AddDropoutOf: Matrix a is empty.");
+    if (a.GetNumRows() != GetNumRows() || a.GetNumCols() != GetNumCols())
+        InvalidArgument("AddDropoutOf: The input matrix dimensions do not match.");
+
+    const ElemType* aPtr = a.Data();
+    ElemType* usPtr = Data();
+    long m = (long) GetNumElements();
+    const uint64_t firstCounter = offset / 4;
+    long numBlocks = (long) ((offset + m - 1) / 4 - firstCounter + 1);
+#pragma omp parallel for
+    for (long b = 0; b < numBlocks; b++)
+    {
+        uint32_t rnd[4];
+        CPUPhiloxRNG::Generate(seed, firstCounter + (uint64_t) b, rnd);
+        for (long k = 0; k < 4; k++)
         {
-            v = r(cpuRNGHandle->Generator());
-            us(i, j) = v <= maskRate ? 0 : scaleValue;
+            int64_t i = (int64_t) (firstCounter + (uint64_t) b) * 4 + k - (int64_t) offset;
+            if (i < 0 || i >= m)
+                continue;
+            ElemType v = CPUPhiloxRNG::ToUniform<ElemType>(rnd[k]);
+            if (v > maskRate)
+                usPtr[i] += aPtr[i] * scaleValue;
         }
     }
+    return *this;
 }
 
 template <class ElemType>
@@ -4711,37 +4824,93 @@ void CPUMatrix<ElemType>::BatchNormalizationForward(const CPUMatrix<ElemType>& s
     if (GetNumRows() % scale.GetNumRows() != 0)
         LogicError("The number of rows of this matrx must be multiple of the number of rows of the scale matrix.");
 
-    if (!inferenceOnly || expAvgFactor != 0 || blendFactor != 1)
-        RuntimeError("Batch normalization training on CPU is not yet implemented.");
+    long numChannels = (long) scale.GetNumRows();
+    long spatialSize = (long) (GetNumRows() / scale.GetNumRows());
+    long numRows = (long) GetNumRows();
+    long numCols = (long) GetNumCols();
+    const ElemType* inPtr = Data();
+    ElemType* outPtr = out.Data();
 
-    saveMean.Resize(0, 0); // only doing inference: these two are not produced
-    saveInvStdDev.Resize(0, 0);
+    // Per-channel normalization parameters, folded so the main loop is a single fused multiply-add:
+    // out = scale * (x - mean) * invStdDev + bias = alpha * x + beta
+    std::vector<ElemType> alphas(numChannels), betas(numChannels);
 
-    bool spatial = GetNumRows() != scale.GetNumRows();
-    if (spatial)
+    if (inferenceOnly)
     {
-        size_t spatialSize = GetNumRows() / scale.GetNumRows();
-#pragma omp parallel for
-        for (long icol = 0; icol < out.GetNumCols(); icol++)
+        assert(expAvgFactor == 0 && blendFactor == 1);
+        saveMean.Resize(0, 0); // only doing inference: these two are not produced
+        saveInvStdDev.Resize(0, 0);
+
+        for (long imap = 0; imap < numChannels; imap++)
         {
-            for (long irow = 0; irow < out.GetNumRows(); irow++)
-            {
-                size_t imap = irow / spatialSize;
-                ElemType stdDev = sqrt(runVariance(imap, 0) + epsilon);
-                out(irow, icol) = scale(imap, 0) * ((*this)(irow, icol) - runMean(imap, 0)) / stdDev + bias(imap, 0);
-            }
+            ElemType alpha = scale(imap, 0) / (ElemType) sqrt(runVariance(imap, 0) + epsilon);
+            alphas[imap] = alpha;
+            betas[imap] = bias(imap, 0) - alpha * runMean(imap, 0);
         }
     }
     else
     {
+        saveMean.Resize(numChannels, 1);
+        saveInvStdDev.Resize(numChannels, 1);
+
+        long batchSize = spatialSize * numCols; // number of samples that contribute to each channel
 #pragma omp parallel for
-        for (long icol = 0; icol < out.GetNumCols(); icol++)
+        for (long imap = 0; imap < numChannels; imap++)
         {
-            for (long irow = 0; irow < out.GetNumRows(); irow++)
+            // Single-pass Welford recurrence for the batch mean/variance; numerically stable
+            // regardless of the magnitude of the values or the size of the batch.
+            ElemType mean = 0;
+            ElemType m2 = 0;
+            long n = 0;
+            for (long icol = 0; icol < numCols; icol++)
             {
-                ElemType stdDev = sqrt(runVariance(irow, 0) + epsilon);
-                out(irow, icol) = scale(irow, 0) * ((*this)(irow, icol) - runMean(irow, 0)) / stdDev + bias(irow, 0);
+                const ElemType* p = inPtr + (size_t) icol * numRows + (size_t) imap * spatialSize;
+                for (long i = 0; i < spatialSize; i++)
+                {
+                    n++;
+                    ElemType d = p[i] - mean;
+                    mean += d / n;
+                    m2 += d * (p[i] - mean);
+                }
             }
+
+            // Update the running statistics and blend them into the values used for normalization.
+            // This mirrors the GPU implementation in CntkBatchNormalization.cuh: the running variance
+            // uses the unbiased estimate while normalization uses the biased one.
+            runMean(imap, 0) = (ElemType) (expAvgFactor * mean + (1 - expAvgFactor) * runMean(imap, 0));
+            ElemType xMean = (ElemType) (blendFactor * runMean(imap, 0) + (1 - blendFactor) * mean);
+            ElemType batchVariance = batchSize == 1 ? 0 : m2 / (batchSize - 1);
+            runVariance(imap, 0) = (ElemType) (expAvgFactor * batchVariance + (1 - expAvgFactor) * runVariance(imap, 0));
+            ElemType invStdDev = (ElemType) (1.0 / sqrt(m2 / batchSize + epsilon));
+            if (blendFactor != 0)
+            {
+                ElemType runInvStdDev = (ElemType) (1.0 / sqrt(runVariance(imap, 0) + epsilon));
+                invStdDev = (ElemType) (blendFactor * runInvStdDev + (1 - blendFactor) * invStdDev);
+            }
+            saveMean(imap, 0) = xMean;
+            saveInvStdDev(imap, 0) = invStdDev;
+
+            ElemType alpha = scale(imap, 0) * invStdDev;
+            alphas[imap] = alpha;
+            betas[imap] = bias(imap, 0) - alpha * xMean;
+        }
+    }
+
+    // Fused normalize-scale-shift. Each channel occupies a contiguous range of rows within a column,
+    // so the inner loop is a plain FMA over contiguous memory and auto-vectorizes.
+#pragma omp parallel for
+    for (long icol = 0; icol < numCols; icol++)
+    {
+        const ElemType* pin = inPtr + (size_t) icol * numRows;
+        ElemType* pout = outPtr + (size_t) icol * numRows;
+        for (long imap = 0; imap < numChannels; imap++)
+        {
+            ElemType alpha = alphas[imap];
+            ElemType beta = betas[imap];
+            const ElemType* pi = pin + imap * spatialSize;
+            ElemType* po = pout + imap * spatialSize;
+            for (long i = 0; i < spatialSize; i++)
+                po[i] = alpha * pi[i] + beta;
         }
     }
 }
@@ -4751,10 +4920,314 @@ void CPUMatrix<ElemType>::BatchNormalizationBackward(const CPUMatrix<ElemType>&
                                                      const CPUMatrix<ElemType>& saveMean, const CPUMatrix<ElemType>& saveInvStdDev,
                                                      CPUMatrix<ElemType>& scaleGrad, CPUMatrix<ElemType>& biasGrad) const
 {
-    UNUSED(in); UNUSED(grad); UNUSED(scale); UNUSED(blendFactor), UNUSED(saveMean); UNUSED(saveInvStdDev); UNUSED(scaleGrad); UNUSED(biasGrad);
-    RuntimeError("Batch normalization training on CPU is not yet implemented.");
+    if (GetNumRows() % scale.GetNumRows() != 0)
+        LogicError("The number of rows of this matrx must be multiple of the number of rows of the scale matrix.");
+
+    long numChannels = (long) scale.GetNumRows();
+    long spatialSize = (long) (GetNumRows() / scale.GetNumRows());
+    long numRows = (long) GetNumRows();
+    long numCols = (long) GetNumCols();
+    const ElemType* dyPtr = Data(); // 'this' is the incoming gradient
+    const ElemType* xPtr = in.Data();
+    ElemType* dxPtr = grad.Data();
+
+    ElemType m = (ElemType) (spatialSize * numCols); // number of samples that contribute to each channel
+    ElemType mbStatsWeight = (ElemType) (1 - blendFactor); // weight of the minibatch statistics in the gradient
+
+    // First pass: per-channel reductions for the scale and bias gradients.
+#pragma omp parallel for
+    for (long imap = 0; imap < numChannels; imap++)
+    {
+        ElemType mean = saveMean(imap, 0);
+        ElemType invStdDev = saveInvStdDev(imap, 0);
+        ElemType ds = 0;
+        ElemType db = 0;
+        for (long icol = 0; icol < numCols; icol++)
+        {
+            size_t base = (size_t) icol * numRows + (size_t) imap * spatialSize;
+            const ElemType* pdy = dyPtr + base;
+            const ElemType* px = xPtr + base;
+            for (long i = 0; i < spatialSize; i++)
+            {
+                ds += pdy[i] * (px[i] - mean) * invStdDev;
+                db += pdy[i];
+            }
+        }
+        scaleGrad(imap, 0) = ds;
+        biasGrad(imap, 0) = db;
+    }
+
+    // Second pass: accumulate the input gradient,
+    // dx += scale * invStdDev * (dy - mbStatsWeight * (xHat * dScale + dBias) / m)
+    // which matches the GPU implementation in CntkBatchNormalization.cuh.
+#pragma omp parallel for
+    for (long icol = 0; icol < numCols; icol++)
+    {
+        for (long imap = 0; imap < numChannels; imap++)
+        {
+            ElemType mean = saveMean(imap, 0);
+            ElemType invStdDev = saveInvStdDev(imap, 0);
+            ElemType scaleInvStdDev = scale(imap, 0) * invStdDev;
+            ElemType dsOverM = mbStatsWeight * scaleGrad(imap, 0) / m;
+            ElemType dbOverM = mbStatsWeight * biasGrad(imap, 0) / m;
+            size_t base = (size_t) icol * numRows + (size_t) imap * spatialSize;
+            const ElemType* pdy = dyPtr + base;
+            const ElemType* px = xPtr + base;
+            ElemType* pdx = dxPtr + base;
+            for (long i = 0; i < spatialSize; i++)
+            {
+                ElemType xHat = (px[i] - mean) * invStdDev;
+                pdx[i] += scaleInvStdDev * (pdy[i] - (xHat * dsOverM + dbOverM));
+            }
+        }
+    }
+}
+
+#pragma region RNN Functions
+
+// Native CPU execution of the RNN stack behind OptimizedRNNStackNode, so that models trained
+// with the cuDNN-backed GPU path can be served on CPU from the same model file.
+//
+// Data layout (identical to what the node feeds the GPU path): 'inputX' has xDim rows; its
+// columns are packed frame-major, i.e. frame 0 of all sequences (sorted longest-first), then
+// frame 1 of all sequences still active, etc. numSequencesForFrame[t] gives the column count
+// of frame t and is non-increasing. All sequences start at frame 0 and differ only in length.
+//
+// Parameter blob layout (the cuDNN packing the GPU path reads): first the gate matrices of all
+// pseudo-layers (layer-major, direction within layer), per pseudo-layer the input matrices
+// W[0..numGates) -- each hiddenSize x layerInputDim, row-major -- followed by the recurrent
+// matrices R[0..numGates), each hiddenSize x hiddenSize, row-major. After all matrices come the
+// bias vectors, 2*numGates per pseudo-layer of length hiddenSize: the input-side biases bW
+// followed by the recurrence-side biases bR (cuDNN keeps both; the effective bias is their sum).
+// Gate order: lstm i,f,c,o; gru r,u,c (where c's recurrent term is gated by r before adding,
+// cuDNN's 'linear before reset' variant).
+//
+// The input projection of each pseudo-layer is batched across all gates, timesteps, and
+// sequences into a single GEMM; only the recurrent matrix-vector products run per timestep,
+// batched across gates and the sequences active in that frame. The elementwise cell updates
+// are parallelized across sequences.
+template <class ElemType>
+void CPUMatrix<ElemType>::RNNForward(const CPUMatrix<ElemType>& inputX, const CPUMatrix<ElemType>& paramW, size_t xDim, size_t yDim,
+                                     const vector<size_t>& numSequencesForFrame, const RnnAttributes& rnnAttributes,
+                                     CPUMatrix<ElemType>& /*reserve*/, CPUMatrix<ElemType>& /*workspace*/)
+{
+    const size_t numLayers = rnnAttributes.m_numLayers;
+    const size_t hiddenSize = rnnAttributes.m_hiddenSize;
+    const size_t numDirections = rnnAttributes.m_bidirectional ? 2 : 1;
+    const wstring& op = rnnAttributes.m_recurrentOp;
+    enum { cellReLU, cellTanh, cellGRU, cellLSTM } cellType =
+        (op == L"lstm") ? cellLSTM : (op == L"gru") ? cellGRU : (op == L"rnnReLU") ? cellReLU : cellTanh;
+    const size_t numGates = (cellType == cellLSTM) ? 4 : (cellType == cellGRU) ? 3 : 1;
+    const long gateRows = (long) (numGates * hiddenSize);
+
+    const size_t T = numSequencesForFrame.size();
+    const size_t totalCols = inputX.GetNumCols();
+
+    if (yDim != numDirections * hiddenSize)
+        LogicError("RNNForward: output dimension %d does not match %d direction(s) x hidden size %d.", (int) yDim, (int) numDirections, (int) hiddenSize);
+    if (inputX.GetNumRows() != xDim)
+        LogicError("RNNForward: input has %d rows but xDim is %d.", (int) inputX.GetNumRows(), (int) xDim);
+
+    // column range of each frame in the packed layout
+    vector<size_t> frameStart(T + 1, 0);
+    for (size_t t = 0; t < T; t++)
+    {
+        if (t > 0 && numSequencesForFrame[t] > numSequencesForFrame[t - 1])
+            InvalidArgument("RNNForward: numSequencesForFrame must be non-increasing (sequences are packed longest-first).");
+        frameStart[t + 1] = frameStart[t] + numSequencesForFrame[t];
+    }
+    if (frameStart[T] != totalCols)
+        LogicError("RNNForward: packed input has %d columns but the frame counts sum to %d.", (int) totalCols, (int) frameStart[T]);
+
+    RequireSize(yDim, totalCols);
+
+    // offsets into the parameter blob, per pseudo-layer
+    const size_t numPseudoLayers = numLayers * numDirections;
+    vector<size_t> matOffset(numPseudoLayers), biasOffset(numPseudoLayers), layerInDim(numPseudoLayers);
+    size_t offset = 0;
+    {
+        size_t inDim = xDim;
+        for (size_t layer = 0; layer < numLayers; layer++)
+        {
+            for (size_t dir = 0; dir < numDirections; dir++)
+            {
+                size_t pl = layer * numDirections + dir;
+                layerInDim[pl] = inDim;
+                matOffset[pl] = offset;
+                offset += numGates * hiddenSize * (inDim + hiddenSize);
+            }
+            inDim = numDirections * hiddenSize;
+        }
+        for (size_t pl = 0; pl < numPseudoLayers; pl++)
+        {
+            biasOffset[pl] = offset;
+            offset += 2 * numGates * hiddenSize;
+        }
+    }
+    if (offset != paramW.GetNumElements())
+        InvalidArgument("RNNForward: parameter matrix has %d elements but the RNN attributes call for %d.", (int) paramW.GetNumElements(), (int) offset);
+
+    ElemType* prm = paramW.Data();
+
+    // work buffers: per-gate pre-activations from the input (wx) and the recurrence (rh),
+    // per-direction hidden state h, and the LSTM cell state c, all in the packed column layout
+    CPUMatrix<ElemType> layerInput;
+    CPUMatrix<ElemType> layerOutput(yDim, totalCols);
+    CPUMatrix<ElemType> wx(numGates * hiddenSize, totalCols);
+    CPUMatrix<ElemType> rh(numGates * hiddenSize, totalCols);
+    CPUMatrix<ElemType> h(hiddenSize, totalCols);
+    CPUMatrix<ElemType> c;
+    if (cellType == cellLSTM)
+        c.RequireSize(hiddenSize, totalCols);
+
+    const CPUMatrix<ElemType>* x = &inputX;
+    for (size_t layer = 0; layer < numLayers; layer++)
+    {
+        CPUMatrix<ElemType>* target = (layer + 1 == numLayers) ? this : &layerOutput;
+        for (size_t dir = 0; dir < numDirections; dir++)
+        {
+            const size_t pl = layer * numDirections + dir;
+            const size_t inDim = layerInDim[pl];
+
+            // wrap the blob segments; a row-major (rows x cols) matrix is a column-major (cols x rows)
+            // one, so the wrapped matrices are applied transposed below
+            CPUMatrix<ElemType> W(inDim, numGates * hiddenSize, prm + matOffset[pl], matrixFlagDontOwnBuffer);
+            CPUMatrix<ElemType> R(hiddenSize, numGates * hiddenSize, prm + matOffset[pl] + numGates * hiddenSize * inDim, matrixFlagDontOwnBuffer);
+            const ElemType* bW = prm + biasOffset[pl];
+            const ElemType* bR = bW + numGates * hiddenSize;
+
+            // input contribution of all gates over all frames and sequences: one large GEMM
+            MultiplyAndWeightedAdd(1, W, true, *x, false, 0, wx);
+#pragma omp parallel for
+            for (long j = 0; j < (long) totalCols; j++)
+            {
+                ElemType* col = wx.Data() + (size_t) j * gateRows;
+                for (long i = 0; i < gateRows; i++)
+                    col[i] += bW[i];
+            }
+
+            // recurrence over frames; dir 0 runs left-to-right, dir 1 right-to-left
+            for (size_t step = 0; step < T; step++)
+            {
+                const size_t t = (dir == 0) ? step : T - 1 - step;
+                const size_t n = numSequencesForFrame[t];
+                // number of sequences that carry state over from the previously processed frame;
+                // the rest (shorter sequences entering in the backward direction, or everything
+                // at the first step) start from a zero initial state
+                size_t nPrev = 0;
+                if (dir == 0 && t > 0)
+                    nPrev = n; // counts are non-increasing, so all n sequences were active at t-1
+                else if (dir == 1 && t + 1 < T)
+                    nPrev = numSequencesForFrame[t + 1];
+
+                // recurrent contribution: bias bR for all active sequences, R^T * h_prev for carried-over ones
+                auto rhT = rh.ColumnSlice(frameStart[t], n);
+#pragma omp parallel for
+                for (long j = 0; j < (long) n; j++)
+                {
+                    ElemType* col = rhT.Data() + (size_t) j * gateRows;
+                    for (long i = 0; i < gateRows; i++)
+                        col[i] = bR[i];
+                }
+                const size_t tPrev = (dir == 0) ? t - 1 : t + 1;
+                if (nPrev > 0)
+                {
+                    auto hPrev = h.ColumnSlice(frameStart[tPrev], nPrev);
+                    auto rhPrev = rh.ColumnSlice(frameStart[t], nPrev);
+                    MultiplyAndWeightedAdd(1, R, true, hPrev, false, 1, rhPrev);
+                }
+
+                // elementwise cell update, parallel across the sequences of this frame
+                const ElemType* wxP = wx.Data() + frameStart[t] * (size_t) gateRows;
+                const ElemType* rhP = rh.Data() + frameStart[t] * (size_t) gateRows;
+                ElemType* hP = h.Data() + frameStart[t] * hiddenSize;
+                const ElemType* hPrevP = (nPrev > 0) ? h.Data() + frameStart[tPrev] * hiddenSize : nullptr;
+                ElemType* cP = (cellType == cellLSTM) ? c.Data() + frameStart[t] * hiddenSize : nullptr;
+                const ElemType* cPrevP = (cellType == cellLSTM && nPrev > 0) ? c.Data() + frameStart[tPrev] * hiddenSize : nullptr;
+#pragma omp parallel for
+                for (long j = 0; j < (long) n; j++)
+                {
+                    const ElemType* wxj = wxP + (size_t) j * gateRows;
+                    const ElemType* rhj = rhP + (size_t) j * gateRows;
+                    ElemType* hj = hP + (size_t) j * hiddenSize;
+                    const bool carried = (size_t) j < nPrev;
+                    switch (cellType)
+                    {
+                    case cellLSTM:
+                    {
+                        const ElemType* cPrevj = carried ? cPrevP + (size_t) j * hiddenSize : nullptr;
+                        ElemType* cj = cP + (size_t) j * hiddenSize;
+                        for (long i = 0; i < (long) hiddenSize; i++)
+                        {
+                            ElemType it = (ElemType) 1 / ((ElemType) 1 + exp_(-(wxj[i] + rhj[i])));
+                            ElemType ft = (ElemType) 1 / ((ElemType) 1 + exp_(-(wxj[hiddenSize + i] + rhj[hiddenSize + i])));
+                            ElemType gt = tanh_(wxj[2 * hiddenSize + i] + rhj[2 * hiddenSize + i]);
+                            ElemType ot = (ElemType) 1 / ((ElemType) 1 + exp_(-(wxj[3 * hiddenSize + i] + rhj[3 * hiddenSize + i])));
+                            ElemType ct = it * gt + (cPrevj ? ft * cPrevj[i] : (ElemType) 0);
+                            cj[i] = ct;
+                            hj[i] = ot * tanh_(ct);
+                        }
+                        break;
+                    }
+                    case cellGRU:
+                    {
+                        const ElemType* hPrevj = carried ? hPrevP + (size_t) j * hiddenSize : nullptr;
+                        for (long i = 0; i < (long) hiddenSize; i++)
+                        {
+                            ElemType rt = (ElemType) 1 / ((ElemType) 1 + exp_(-(wxj[i] + rhj[i])));
+                            ElemType ut = (ElemType) 1 / ((ElemType) 1 + exp_(-(wxj[hiddenSize + i] + rhj[hiddenSize + i])));
+                            ElemType candidate = tanh_(wxj[2 * hiddenSize + i] + rt * rhj[2 * hiddenSize + i]);
+                            hj[i] = ((ElemType) 1 - ut) * candidate + (hPrevj ? ut * hPrevj[i] : (ElemType) 0);
+                        }
+                        break;
+                    }
+                    case cellReLU:
+                        for (long i = 0; i < (long) hiddenSize; i++)
+                        {
+                            ElemType v = wxj[i] + rhj[i];
+                            hj[i] = v > 0 ? v : (ElemType) 0;
+                        }
+                        break;
+                    case cellTanh:
+                        for (long i = 0; i < (long) hiddenSize; i++)
+                            hj[i] = tanh_(wxj[i] + rhj[i]);
+                        break;
+                    }
+                }
+            }
+
+            // deposit this direction's hidden states into rows [dir*hiddenSize, +hiddenSize) of the layer output
+            ElemType* dst = target->Data() + dir * hiddenSize;
+            const ElemType* src = h.Data();
+#pragma omp parallel for
+            for (long j = 0; j < (long) totalCols; j++)
+                memcpy(dst + (size_t) j * yDim, src + (size_t) j * hiddenSize, hiddenSize * sizeof(ElemType));
+        }
+
+        // the next layer consumes this layer's output (both directions)
+        if (layer + 1 < numLayers)
+        {
+            layerInput.SetValue(layerOutput);
+            x = &layerInput;
+        }
+    }
+}
+
+template <class ElemType>
+void CPUMatrix<ElemType>::RNNBackwardData(const CPUMatrix<ElemType>& /*outputDY*/, const CPUMatrix<ElemType>& /*paramW*/, CPUMatrix<ElemType>& /*outputDX*/,
+                                          const RnnAttributes& /*rnnAttributes*/, CPUMatrix<ElemType>& /*reserve*/, CPUMatrix<ElemType>& /*workspace*/)
+{
+    RuntimeError("RNNBackwardData: The CPU implementation of OptimizedRNNStack is inference-only; training requires a GPU.");
 }
 
+template <class ElemType>
+void CPUMatrix<ElemType>::RNNBackwardWeights(const CPUMatrix<ElemType>& /*inputX*/, const CPUMatrix<ElemType>& /*outputY*/, CPUMatrix<ElemType>& /*dw*/,
+                                             const RnnAttributes& /*rnnAttributes*/, CPUMatrix<ElemType>& /*reserve*/, CPUMatrix<ElemType>& /*workspace*/)
+{
+    RuntimeError("RNNBackwardWeights: The CPU implementation of OptimizedRNNStack is inference-only; training requires a GPU.");
+}
+
+#pragma endregion RNN Functions
 
 #pragma region Static BLAS Functions
 
@@ -6000,7 +6473,7 @@ void CPUMatrix<ElemType>::RCRFBackwardCompute(const CPUMatrix<ElemType>& alpha,
 // uttBeginFrame(input): the positon of the first frame of each utterance in the minibatch channel. We need this because each channel may contain more than one utterance.
 // uttPhoneNum (input): the phone number of each utterance. The size of this vector =  the number of all utterances in this minibatch
 // numChannels (input): channel number in this minibatch
-// uttNum (input): number of utterances
+// uttId (input): utterance to process
 // t (input): time stamp to process
 // maxPhoneNum (input): the max number of phones between utterances
 // totalPhoneNum (input): the total number of phones of all utterances
@@ -6020,22 +6493,18 @@ void _assignAlphaScore(
     const std::vector<size_t>& uttBeginFrame,
     const std::vector<size_t>& uttPhoneNum,
     size_t numChannels,
-    const size_t uttNum,
+    const size_t uttId,
     const size_t  t,
     const size_t maxPhoneNum, // Maximum length of utterance in this MB
     const size_t totalPhoneNum, // Total number of phones
     const size_t blankTokenId,
     const int delayConstraint)
 {
-    for (size_t uttId = 0;uttId < uttNum;uttId++) {
-
-        // Number of phones and frames in this utterance
-        size_t frameNum = uttFrameNum[uttId];
-        if (t >= frameNum) continue;
-
+    {
         size_t phoneNum = uttPhoneNum[uttId];
 
-#pragma omp parallel for
+        // serial over labels: the caller parallelizes across utterances, which keeps this
+        // utterance's alpha stripe in one core's cache over the whole time recursion
         for (int phoneSeqId = 1;phoneSeqId < phoneNum - 1;phoneSeqId++) {
             // Index of the label in the sequence
 
@@ -6130,22 +6599,18 @@ void _assignBetaScore(
     const std::vector<size_t>& uttBeginFrame,
     const std::vector<size_t>& uttPhoneNum,
     const size_t numChannels,
-    const size_t uttNum,
+    const size_t uttId,
     const long  t,
     const size_t maxPhoneNum,
     const size_t totalPhoneNum,
     const size_t blankTokenId,
     const int delayConstraint)
 {
-    for (size_t uttId = 0;uttId < uttNum;uttId++) {
-
+    {
         // Number of phones and frames in this utterance
         size_t frameNum = uttFrameNum[uttId];
-        if (t >= frameNum) continue;
-
         size_t phoneNum = uttPhoneNum[uttId];
 
-#pragma omp parallel for
         for (int phoneSeqId = 1;phoneSeqId < phoneNum - 1;phoneSeqId++) {
 
             size_t labelid = uttId*maxPhoneNum + phoneSeqId;
@@ -6302,16 +6767,26 @@ CPUMatrix<ElemType>& CPUMatrix<ElemType>::AssignCTCScore(
         // Max number of phones in utterances in this minibatch
         size_t maxPhoneNum = phoneSeq.GetNumRows();
 
-        for (size_t t = 0; t < maxFrameNum; t++)
+        // The time recursion is inherently sequential, but utterances are independent: give
+        // each worker one utterance's complete forward and backward recursion instead of
+        // forking a thread team per (frame, utterance). This removes one barrier per frame
+        // (with 2000-frame utterances those dominated) and keeps each utterance's alpha/beta
+        // stripe in a single core's cache. The label loop inside stays scalar: its LogAdd
+        // chains are short and branchy, which defeats SIMD batching.
+#pragma omp parallel for
+        for (int uttId = 0; uttId < uttNum; uttId++)
         {
-            _assignAlphaScore(prob.Data(), alpha.Data(), phoneSeq.Data(), phoneBoundary.Data(), uttToChanInd,
-                uttFrameNum, uttBeginFrame, uttPhoneNum, numParallelSequences, uttNum, t, maxPhoneNum, totalPhoneNum, blankTokenId, delayConstraint);
-        }
+            for (size_t t = 0; t < uttFrameNum[uttId]; t++)
+            {
+                _assignAlphaScore(prob.Data(), alpha.Data(), phoneSeq.Data(), phoneBoundary.Data(), uttToChanInd,
+                    uttFrameNum, uttBeginFrame, uttPhoneNum, numParallelSequences, uttId, t, maxPhoneNum, totalPhoneNum, blankTokenId, delayConstraint);
+            }
 
-        for (LONG64 t = maxFrameNum - 1; t >= 0; t--)
-        {
-            _assignBetaScore(prob.Data(), beta.Data(), phoneSeq.Data(), phoneBoundary.Data(), uttToChanInd,
-                uttFrameNum, uttBeginFrame, uttPhoneNum, numParallelSequences, uttNum, t, maxPhoneNum, totalPhoneNum, blankTokenId, delayConstraint);
+            for (LONG64 t = (LONG64) uttFrameNum[uttId] - 1; t >= 0; t--)
+            {
+                _assignBetaScore(prob.Data(), beta.Data(), phoneSeq.Data(), phoneBoundary.Data(), uttToChanInd,
+                    uttFrameNum, uttBeginFrame, uttPhoneNum, numParallelSequences, uttId, t, maxPhoneNum, totalPhoneNum, blankTokenId, delayConstraint);
+            }
         }
 
         std::vector<ElemType> scores(uttNum);
@@ -6838,8 +7313,113 @@ struct TensorOpIteration<ElemType, OPFN, ReductionOp, N, vectorizable, m, -1>
     }
 };
 
+// Parallel version of the outermost regular loop for ops that reduce: with a reduction present,
+// none of the TensorOpIteration loops are parallelized (the OMP specializations above require
+// m == -1), so e.g. a batch-axis reduction runs on one core. Each thread here computes complete
+// output elements, so the per-element reduction order -- and therefore every output bit -- is
+// identical to the serial path, and this can be used unconditionally.
+template <class ElemType, typename OPFN, typename ReductionOp, size_t N, int m, int k>
+struct TensorOpParallelOuterIteration
+{
+    static inline void Loop(ElemType beta, array<ElemType*, N> pointers, ElemType alpha, const OPFN& opfn, const ReductionOp& reductionOp,
+                            const SmallVector<size_t>& regularOpDims, const array<SmallVector<ptrdiff_t>, N>& regularStrides,
+                            const SmallVector<size_t>& reducingOpDims, const array<SmallVector<ptrdiff_t>, N>& reducingStrides)
+    {
+        array<ptrdiff_t, N> strides;
+        for (size_t i = 0; i < N; i++) // N = a small constant, this will be unrolled
+            strides[i] = regularStrides[i][(size_t) k];
+        ptrdiff_t dim = (ptrdiff_t) regularOpDims[(size_t) k];
+#pragma omp parallel for
+        for (ptrdiff_t d = 0; d < dim; d++)
+        {
+            auto threadPointers = pointers;
+            for (size_t i = 0; i < N; i++)
+                threadPointers[i] += d * strides[i];
+            TensorOpIteration<ElemType, OPFN, ReductionOp, N, false /*vectorizable*/, m, k - 1>::Loop(beta, threadPointers, alpha, opfn, reductionOp, regularOpDims, regularStrides, reducingOpDims, reducingStrides);
+        }
+    }
+};
+
+// terminate the recursion for the scalar-output case (never taken at runtime; the dispatch
+// below requires k >= 0, but the template still gets instantiated for k == -1)
+template <class ElemType, typename OPFN, typename ReductionOp, size_t N, int m>
+struct TensorOpParallelOuterIteration<ElemType, OPFN, ReductionOp, N, m, -1>
+{
+    static inline void Loop(ElemType beta, array<ElemType*, N> pointers, ElemType alpha, const OPFN& opfn, const ReductionOp& reductionOp,
+                            const SmallVector<size_t>& regularOpDims, const array<SmallVector<ptrdiff_t>, N>& regularStrides,
+                            const SmallVector<size_t>& reducingOpDims, const array<SmallVector<ptrdiff_t>, N>& reducingStrides)
+    {
+        TensorOpIteration<ElemType, OPFN, ReductionOp, N, false /*vectorizable*/, m, -1>::Loop(beta, pointers, alpha, opfn, reductionOp, regularOpDims, regularStrides, reducingOpDims, reducingStrides);
+    }
+};
+
+// Decide whether to parallelize the outermost output loop of a reducing tensor op: the outer
+// dimension must offer at least two chunks of work, and the total element count must be large
+// enough to amortize the OMP fork/join.
+static inline bool ShouldParallelizeOuterReductionLoop(int k, const SmallVector<size_t>& regularOpDims, const SmallVector<size_t>& reducingOpDims)
+{
+    if (k < 0)
+        return false;
+    size_t reductionSize = 1;
+    for (size_t i = 0; i < reducingOpDims.size(); i++)
+        reductionSize *= reducingOpDims[i];
+    return regularOpDims[(size_t) k] >= 2 && regularOpDims[(size_t) k] * reductionSize >= 16384;
+}
+
+// Chunked parallel reduction of a single reducing dimension into a scalar output (criterion
+// aggregation, full-tensor ReduceElementsNode) -- the one reducing shape the outer-loop
+// parallelization above cannot touch. The reducing dimension is split into fixed-size chunks
+// whose partials are computed in parallel and combined pairwise in index order; since the chunk
+// grid does not depend on the thread count, results are bitwise reproducible across runs and
+// core counts. The order does differ from the strictly serial path, so the caller only comes
+// here when fast-math tensor ops are enabled ('fastMathTensorOps=false' is the deterministic
+// legacy-order mode, see Globals).
+template <class ElemType, typename OPFN, typename ReductionOp, size_t N>
+static void TensorOpChunkedScalarReduction(ElemType beta, array<ElemType*, N> pointers, ElemType alpha, const OPFN& opfn, const ReductionOp& reductionOp,
+                                           const SmallVector<size_t>& reducingOpDims, const array<SmallVector<ptrdiff_t>, N>& reducingStrides)
+{
+    array<ptrdiff_t, N - 1> strides;   // N-1 because last one is the result pointer, which is unused in reduction
+    for (size_t i = 0; i < N - 1; i++) // N = a small constant, this will be unrolled
+        strides[i] = reducingStrides[i][0];
+
+    const size_t dim = reducingOpDims[0];
+    const size_t numChunks = (dim + TensorReductionChunkSize - 1) / TensorReductionChunkSize;
+    std::vector<double> partials(numChunks);
+#pragma omp parallel for
+    for (ptrdiff_t c = 0; c < (ptrdiff_t) numChunks; c++)
+    {
+        auto chunkPointers = pointers;
+        for (size_t i = 0; i < N - 1; i++)
+            chunkPointers[i] += (ptrdiff_t)((size_t) c * TensorReductionChunkSize) * strides[i];
+        size_t count = std::min(TensorReductionChunkSize, dim - (size_t) c * TensorReductionChunkSize);
+
+        double aggregate = opfn(chunkPointers);
+        for (size_t j = 1; j < count; j++)
+        {
+            for (size_t i = 0; i < N - 1; i++)
+                chunkPointers[i] += strides[i];
+            aggregate = reductionOp(aggregate, opfn(chunkPointers));
+        }
+        partials[c] = aggregate;
+    }
+
+    // combine the partials pairwise in index order (tree reduction with a fixed shape); valid for
+    // all reduction lambdas dispatched through TensorOpWithFn since they are associative
+    for (size_t step = 1; step < numChunks; step *= 2)
+        for (size_t i = 0; i + step < numChunks; i += 2 * step)
+            partials[i] = reductionOp(partials[i], partials[i + step]);
+
+    // same epilogue as TensorOpIteration<.../*m*/, -1>
+    ElemType val = (ElemType) partials[0];
+    val *= alpha;
+    auto* pout = pointers.back();
+    if (beta != 0)
+        val += beta * *pout;
+    *pout = val;
+}
+
 // perform loop over regular index k and reducing index m for N operands (counting the output), the difference
-// between TensorOpIteration and TensorArgOpIteration, is that the latter store the index of the result, instead of 
+// between TensorOpIteration and TensorArgOpIteration, is that the latter store the index of the result, instead of
 // the result. The reason that they aren't combined is because of performance.
 template <class ElemType, size_t N, int k>
 struct TensorArgOpIteration
@@ -6893,8 +7473,15 @@ static void TensorOpWithRegularLoop(ElemType beta, const array<ElemType*, N>& po
     switch (dims)
     {
     case 2:
+        if (ShouldParallelizeOuterReductionLoop(k, regularOpDims, reducingOpDims))
+            return TensorOpParallelOuterIteration<ElemType, OPFN, ReductionOp, N, 1, k>::Loop(beta, pointers, alpha, opfn, reductionOp, regularOpDims, regularStrides, reducingOpDims, reducingStrides);
         return TensorOpIteration<ElemType, OPFN, ReductionOp, N, false /*vectorizable*/, 1, k>::Loop(beta, pointers, alpha, opfn, reductionOp, regularOpDims, regularStrides, reducingOpDims, reducingStrides);
     case 1:
+        // scalar output: no regular loop to parallelize over, so chunk the reduction itself
+        if (k == -1 && reducingOpDims[0] >= 2 * TensorReductionChunkSize && Globals::ShouldUseFastMathTensorOps())
+            return TensorOpChunkedScalarReduction(beta, pointers, alpha, opfn, reductionOp, reducingOpDims, reducingStrides);
+        if (ShouldParallelizeOuterReductionLoop(k, regularOpDims, reducingOpDims))
+            return TensorOpParallelOuterIteration<ElemType, OPFN, ReductionOp, N, 0, k>::Loop(beta, pointers, alpha, opfn, reductionOp, regularOpDims, regularStrides, reducingOpDims, reducingStrides);
         return TensorOpIteration<ElemType, OPFN, ReductionOp, N, false /*vectorizable*/, 0, k>::Loop(beta, pointers, alpha, opfn, reductionOp, regularOpDims, regularStrides, reducingOpDims, reducingStrides);
     case 0:
     {
@@ -6993,6 +7580,41 @@ void CPUMatrix<ElemType>::TensorOp(ElemType beta, const CPUMatrix<ElemType>& a,
         reductionOp != ElementWiseOperator::opElementwiseProduct)
         InvalidArgument("TensorOp: Unary reduction operations other than opMax, opMin, opSum, and opLogSum are not implemented.");
 
+    // Fast path: dense unary op over a single flattened dimension with unit strides, no reduction
+    // and trivial alpha/beta. These are the shapes NonlinearityNodes produce, and the explicitly
+    // vectorized kernels beat the auto-vectorizer on the transcendental ops by a wide margin.
+    // Anything TryUnaryTensorOpSimd does not handle falls through to the generic machinery below.
+    if (reducingOpDims.size() == 0 && regularOpDims.size() == 1 &&
+        regularStrides[0].size() == 1 && regularStrides[0][0] == 1 &&
+        regularStrides[1].size() == 1 && regularStrides[1][0] == 1 &&
+        beta == 0 && alpha == 1 &&
+        TryUnaryTensorOpSimd(op, a.Data() + offsets[0], Data() + offsets[1], regularOpDims[0]))
+    {
+        return;
+    }
+
+    // Fast path: summing a contiguous tensor into a scalar (criterion aggregation, full-tensor
+    // ReduceElementsNode). The generic reduction runs serially; this one sums fixed-size chunks
+    // in parallel with SIMD inner loops and double accumulators, combining the partials in a
+    // thread-count-independent order. The probe falls through for small tensors and when
+    // fast-math tensor ops are disabled, keeping the legacy serial order available.
+    if (reductionOp == ElementWiseOperator::opSum && op == ElementWiseOperator::opCopy &&
+        regularOpDims.size() == 0 && reducingOpDims.size() == 1 &&
+        reducingStrides[0].size() == 1 && reducingStrides[0][0] == 1)
+    {
+        double sum;
+        if (TryParallelSumReductionSimd(a.Data() + offsets[0], reducingOpDims[0], sum))
+        {
+            ElemType val = (ElemType) sum;
+            val *= alpha;
+            ElemType* pout = Data() + offsets[1];
+            if (beta != 0)
+                val += beta * *pout;
+            *pout = val;
+            return;
+        }
+    }
+
 // TODO: Change the lambda to take a pointer and a number of elements, so that we can pass it 1 or 4 elements, in order for it to SSE-vectorize.
 #define CaseUnaryTensorOp(oper)                                                        \
     case ElementWiseOperator::op##oper:                                                \
@@ -7214,27 +7836,40 @@ void CPUMatrix<ElemType>::ScatterValues(ElemType* indices, ElemType* value, Elem
     if (!indices || !value || !data)
         LogicError("ScatterValues: input data is null.");
 
+    // Precheck pass: validate and decode the index map up front, so that the parallel region below
+    // neither throws (which would terminate the process) nor redoes the NaN/bounds checks per thread.
+    std::vector<ptrdiff_t> targetCols(num_indices);
+    for (size_t i = 0; i < num_indices; i++)
+    {
+        auto col_r = indices[i * indices_step];
+        if (std::isnan(col_r) || col_r < 0) // negative index means gap
+        {
+            targetCols[i] = -1;
+            continue;
+        }
+        auto col = (size_t)col_r;
+        if (col >= cols)
+            InvalidArgument("ScatterValues: Indices map out of bounds. %ld >= %ld", (long int)col, (long int)cols);
+        targetCols[i] = (ptrdiff_t)col;
+    }
+
+    // Scatter may add several source columns into the same target column. Each thread owns the
+    // target columns with col % nthread == ithread, so no two threads ever write the same column.
 #pragma omp parallel
     {
-        int ithread = omp_get_thread_num();
-        int nthread = omp_get_num_threads();
-        for (auto i = 0; i < num_indices; i++)
+        size_t ithread = (size_t)omp_get_thread_num();
+        size_t nthread = (size_t)omp_get_num_threads();
+        for (size_t i = 0; i < num_indices; i++)
         {
-            auto col_r = indices[i * indices_step];
-            if (std::isnan(col_r) || col_r < 0)
-                continue;
-            auto col = (size_t)col_r;
-            //ignore the elements that is not partitioned into this thread
-            if (col % nthread != ithread)
+            auto col = targetCols[i];
+            // ignore gaps and the columns that are not partitioned into this thread
+            if (col < 0 || (size_t)col % nthread != ithread)
                 continue;
-            
-            if (col >= cols)
-                InvalidArgument("ScatterValues: Indices map out of bounds. %ld >= %ld", (long int)col, (long int)cols);
-
-            auto index = col * rows;
-            auto offset = i * rows;
-            for (auto j = 0; j < rows; j++)
-                data[index + j] = data[index + j] + alpha * value[offset + j];
+
+            ElemType* dst = data + (size_t)col * rows;
+            const ElemType* src = value + i * rows;
+            for (size_t j = 0; j < rows; j++)
+                dst[j] += alpha * src[j];
         }
     }
 }
@@ -12,7 +12,9 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 
 CPURNGHandle::CPURNGHandle(int deviceId, uint64_t seed, uint64_t offset)
     : RNGHandle(deviceId),
-    m_generator(seed)
+    m_generator(seed),
+    m_seed(seed),
+    m_offset(offset)
 {
     m_generator.discard(offset);
 }
@@ -8,11 +8,59 @@
 #pragma once
 
 #include "RNGHandle.h"
+#include <math.h>
 #include <memory>
 #include <random>
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+// Unlike a sequential generator, the output is a pure function of (key, counter), so worker threads
+// can each fill a disjoint counter range in parallel and still produce a stream that is reproducible
+// from (seed, offset) alone.
+class CPUPhiloxRNG
+{
+public:
+    // generate the 128-bit output block for a 64-bit key (seed) and a 64-bit counter
+    static void Generate(uint64_t seed, uint64_t counter, uint32_t (&out)[4])
+    {
+        uint32_t key0 = (uint32_t) seed, key1 = (uint32_t) (seed >> 32);
+        uint32_t c0 = (uint32_t) counter, c1 = (uint32_t) (counter >> 32), c2 = 0, c3 = 0;
+        for (int round = 0; round < 10; round++)
+        {
+            uint64_t p0 = (uint64_t) 0xD2511F53u * c0;
+            uint64_t p1 = (uint64_t) 0xCD9E8D57u * c2;
+            uint32_t n0 = (uint32_t) (p1 >> 32) ^ c1 ^ key0;
+            uint32_t n1 = (uint32_t) p1;
+            uint32_t n2 = (uint32_t) (p0 >> 32) ^ c3 ^ key1;
+            uint32_t n3 = (uint32_t) p0;
+            c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+            key0 += 0x9E3779B9u; // golden-ratio Weyl constants, per the paper
+            key1 += 0xBB67AE85u;
+        }
+        out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+    }
+
+    // map a 32-bit word to [0,1) using its top 24 bits (exactly representable in float)
+    template <class ElemType>
+    static ElemType ToUniform(uint32_t x)
+    {
+        return (ElemType) ((x >> 8) * (1.0 / 16777216.0));
+    }
+
+    // map two 32-bit words to a pair of standard-normal samples via Box-Muller
+    template <class ElemType>
+    static void ToGaussianPair(uint32_t x0, uint32_t x1, ElemType& z0, ElemType& z1)
+    {
+        const double twoPi = 6.283185307179586476;
+        double u1 = ((x0 >> 8) + 1) * (1.0 / 16777216.0); // (0,1], so the log is finite
+        double u2 = (x1 >> 8) * (1.0 / 16777216.0);
+        double radius = sqrt(-2.0 * log(u1));
+        z0 = (ElemType) (radius * cos(twoPi * u2));
+        z1 = (ElemType) (radius * sin(twoPi * u2));
+    }
+};
+
 class CPURNGHandle : public RNGHandle
 {
 public:
@@ -23,8 +71,27 @@ public:
         return m_generator;
     }
 
+    // (seed, offset) key for counter-based parallel generation; callers that consume
+    // counters through CPUPhiloxRNG must advance the offset by the number they used
+    uint64_t Seed() const
+    {
+        return m_seed;
+    }
+
+    uint64_t Offset() const
+    {
+        return m_offset;
+    }
+
+    void AdvanceOffset(uint64_t numCounters)
+    {
+        m_offset += numCounters;
+    }
+
 private:
     std::mt19937_64 m_generator;
+    uint64_t m_seed;
+    uint64_t m_offset;
 };
 
 }}}
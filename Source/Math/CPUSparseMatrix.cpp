@@ -931,45 +931,73 @@ public:
         // Now do the actual multiplication.
         ElemType* valueBuffer = sparse.Buffer() + *sparse.SecondaryIndexLocation(); // Points to the value buffer of the current view (i.e. buffer containing values of non-zero elements).
         int* rowIndexBuffer = sparse.MajorIndexLocation();                          // Points to the index buffer of the current view (i.e. buffer containing indices of non-zero elements).
-        size_t iNonzero = 0;                                                           // Number of nonzero elements handled so far for curent slice view.
         int numPreviosNonzero = sparse.SecondaryIndexLocation()[0];                 // Total number of nonzero values handled in previous slices.
 
-        // Loop over columns of the sparse matrix
-        for (size_t colSparse = 0; colSparse < sparse.GetNumCols(); colSparse++)
+        // Handles a single nonzero element of the sparse matrix against one outer index of the dense matrix.
+        auto updateElement = [&](size_t iNonzero, size_t colSparse, size_t outerIndexDense)
         {
-            size_t numNonzeroInSparseCol = sparse.SecondaryIndexLocation()[colSparse + 1] - numPreviosNonzero;
-            // Loop over the nonzero rows of the current column of the sparse matrix
-            for (; iNonzero < numNonzeroInSparseCol; iNonzero++)
+            size_t rowSparse = rowIndexBuffer[iNonzero]; // RowLocation
+            ElemType sparseVal = valueBuffer[iNonzero];
+
+            // Determine the index of the 'outer' dimension of the sparse matrix and the common inner index.
+            size_t outerIndexSparse;
+            size_t innerIndex;
+            // Below if-statements are evaluated at compile time.
+            if      ( denseTimesSparse && !transposeB) { outerIndexSparse = colSparse; innerIndex = rowSparse; }
+            else if ( denseTimesSparse &&  transposeB) { outerIndexSparse = rowSparse; innerIndex = colSparse; }
+            else if (!denseTimesSparse && !transposeA) { outerIndexSparse = rowSparse; innerIndex = colSparse; }
+            else if (!denseTimesSparse &&  transposeA) { outerIndexSparse = colSparse; innerIndex = rowSparse; }
+
+            // Determine the row index of the dense input matrix.
+            // Below if-statements are evaluated at compile time.
+            ElemType denseVal;
+            if      ( denseTimesSparse && !transposeA) denseVal = dense(outerIndexDense,      innerIndex);
+            else if ( denseTimesSparse &&  transposeA) denseVal = dense(     innerIndex, outerIndexDense);
+            else if (!denseTimesSparse && !transposeB) denseVal = dense(     innerIndex, outerIndexDense);
+            else if (!denseTimesSparse &&  transposeB) denseVal = dense(outerIndexDense,      innerIndex);
+
+            // Update matrix c.
+            if (denseTimesSparse)
+                c(outerIndexDense, outerIndexSparse) += alpha * denseVal * sparseVal;
+            else /*Sparse times dense */
+                c(outerIndexSparse, outerIndexDense) += alpha * denseVal * sparseVal;
+        };
+
+        // When the sparse outer index is the column index, each sparse column updates its own
+        // row/column of c, so the column loop can run in parallel without write conflicts.
+        // In the other two cases several sparse columns can hit the same output row, so we
+        // parallelize over the dense outer dimension instead; each thread then walks all
+        // nonzeros but owns a disjoint slice of the output.
+        // Below if-statement is evaluated at compile time.
+        if ((denseTimesSparse && !transposeB) || (!denseTimesSparse && transposeA))
+        {
+#pragma omp parallel for
+            for (long colSparse = 0; colSparse < (long) sparse.GetNumCols(); colSparse++)
+            {
+                size_t iBegin = sparse.SecondaryIndexLocation()[colSparse] - numPreviosNonzero;
+                size_t iEnd   = sparse.SecondaryIndexLocation()[colSparse + 1] - numPreviosNonzero;
+                // Loop over the nonzero rows of the current column of the sparse matrix
+                for (size_t iNonzero = iBegin; iNonzero < iEnd; iNonzero++)
+                {
+                    // Loop over the outer index of the dense matrix
+                    for (size_t outerIndexDense = 0; outerIndexDense < outerDimensionDense; outerIndexDense++)
+                        updateElement(iNonzero, colSparse, outerIndexDense);
+                }
+            }
+        }
+        else
+        {
+#pragma omp parallel for
+            for (long outerIndexDense = 0; outerIndexDense < (long) outerDimensionDense; outerIndexDense++)
             {
-                size_t rowSparse = rowIndexBuffer[iNonzero]; // RowLocation
-                ElemType sparseVal = valueBuffer[iNonzero];
-
-                // Determine the index of the 'outer' dimension of the sparse matrix and the common inner index.
-                size_t outerIndexSparse;
-                size_t innerIndex;
-                // Below if-statements are evaluated at compile time.
-                if      ( denseTimesSparse && !transposeB) { outerIndexSparse = colSparse; innerIndex = rowSparse; }
-                else if ( denseTimesSparse &&  transposeB) { outerIndexSparse = rowSparse; innerIndex = colSparse; }
-                else if (!denseTimesSparse && !transposeA) { outerIndexSparse = rowSparse; innerIndex = colSparse; }
-                else if (!denseTimesSparse &&  transposeA) { outerIndexSparse = colSparse; innerIndex = rowSparse; }
-
-                // Loop over the outer index of the dense matrix
-                for (size_t outerIndexDense = 0; outerIndexDense < outerDimensionDense; outerIndexDense++)
+                size_t iNonzero = 0;
+                // Loop over columns of the sparse matrix
+                for (size_t colSparse = 0; colSparse < sparse.GetNumCols(); colSparse++)
                 {
-                    // Determine the row index of the dense input matrix.
-                    // Below if-statements are evaluated at compile time.
-                    ElemType denseVal;
-                    if      ( denseTimesSparse && !transposeA) denseVal = dense(outerIndexDense,      innerIndex);
-                    else if ( denseTimesSparse &&  transposeA) denseVal = dense(     innerIndex, outerIndexDense);
-                    else if (!denseTimesSparse && !transposeB) denseVal = dense(     innerIndex, outerIndexDense);
-                    else if (!denseTimesSparse &&  transposeB) denseVal = dense(outerIndexDense,      innerIndex);
-                    
-
-                    // Update matrix c.
-                    if (denseTimesSparse)
-                        c(outerIndexDense, outerIndexSparse) += alpha * denseVal * sparseVal;
-                    else /*Sparse times dense */
-                        c(outerIndexSparse, outerIndexDense) += alpha * denseVal * sparseVal;
+                    size_t numNonzeroInSparseCol = sparse.SecondaryIndexLocation()[colSparse + 1] - numPreviosNonzero;
+                    // Loop over the nonzero rows of the current column of the sparse matrix
+                    for (; iNonzero < numNonzeroInSparseCol; iNonzero++)
+                        updateElement(iNonzero, colSparse, outerIndexDense);
                 }
             }
         }
@@ -1438,6 +1466,83 @@ void CPUSparseMatrix<ElemType>::AdaDelta(CPUMatrix<ElemType>& c, CPUMatrix<ElemT
     }
 }
 
+// Adam update with a block column sparse gradient. Only the columns present in the gradient
+// are touched. The smoothed gradient matrix carries a third state block holding the step at
+// which each column was last updated, so the moment estimates of a column are lazily caught
+// up with the decay they missed while the column went untouched; the parameter updates those
+// decayed moments would have produced are skipped, as usual for lazy Adam variants.
+template <class ElemType>
+void CPUSparseMatrix<ElemType>::Adam(CPUMatrix<ElemType>& c, CPUMatrix<ElemType>& functionValues,
+                                     ElemType learnRatePerSample, ElemType momentum, ElemType adaWeight,
+                                     ElemType adaMul, ElemType epsilon, double smoothedCount,
+                                     bool unitGainMomentum, bool adamax)
+{
+    size_t numColsNeeded = 3 * GetNumCols(); // [squared moment | momentum | per-column last update step]
+
+    if (c.IsEmpty() || (c.GetNumCols() < numColsNeeded))
+    {
+        c.RequireSize(GetNumRows(), numColsNeeded);
+        c.SetValue(0.0);
+    }
+
+    if (c.GetNumRows() != GetNumRows() || c.GetNumCols() != numColsNeeded)
+        LogicError("The matrix gradients does not have expected dimensions.");
+
+    if (GetFormat() != MatrixFormat::matrixFormatSparseBlockCol)
+        LogicError("Unsupported sparse format.");
+
+    const auto unitGainFactor = ElemType(unitGainMomentum ? (1.0 - momentum) : 1.0);
+    size_t n = GetNumElements();
+    ElemType* grad = Data();
+    ElemType* smoothAda = c.Data();
+    ElemType* smoothMom = c.Data() + n;
+    ElemType* lastUpdateStep = c.Data() + 2 * n; // only row 0 of each column in this block is used
+    ElemType* val = functionValues.Data();
+
+#pragma omp parallel for
+    for (int j = 0; j < (int)GetBlockSize(); j++)
+    {
+        size_t i = GetBlockIds()[j] - GetBlockIdShift();
+        size_t len = GetNumRows();
+        size_t start = j * len;
+
+        // Catch the moment estimates up with the decay they missed while the column went untouched
+        double stepsMissed = smoothedCount - 1.0 - (double)lastUpdateStep[i * len];
+        if (stepsMissed > 0)
+        {
+            ElemType adaDecay = (ElemType)pow((double)adaWeight, stepsMissed);
+            ElemType momDecay = (ElemType)pow((double)momentum, stepsMissed);
+            for (size_t p = start; p < start + len; p++)
+            {
+                size_t denseIndex = i * len + (p - start);
+                smoothAda[denseIndex] *= adaDecay;
+                smoothMom[denseIndex] *= momDecay;
+            }
+        }
+        lastUpdateStep[i * len] = (ElemType)smoothedCount;
+
+        for (size_t p = start; p < start + len; p++)
+        {
+            size_t denseIndex = i * len + (p - start);
+            ElemType g = grad[p];
+            ElemType ada;
+            if (!adamax)
+            {
+                ElemType adaSqr = adaWeight * smoothAda[denseIndex] + (1.0f - adaWeight) * g * g;
+                smoothAda[denseIndex] = adaSqr;
+                ada = sqrt(adaSqr);
+            }
+            else
+                ada = smoothAda[denseIndex] = std::max(adaWeight * smoothAda[denseIndex], abs(g));
+
+            ElemType w = adaMul * (ElemType)(1.0 / (ada + epsilon));
+            g = momentum * smoothMom[denseIndex] + unitGainFactor * g;
+            smoothMom[denseIndex] = g;
+            val[denseIndex] -= g * w * learnRatePerSample;
+        }
+    }
+}
+
 template <class ElemType>
 CPUSparseMatrix<ElemType>& CPUSparseMatrix<ElemType>::InplaceTruncateTop(const ElemType threshold)
 {
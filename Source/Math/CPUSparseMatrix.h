@@ -232,6 +232,8 @@ public:
     void NormalGrad(CPUMatrix<ElemType>& c, const ElemType momentum, bool unitGainMomentum = true);
     ElemType Adagrad(CPUMatrix<ElemType>& c, const bool needAveMultiplier);
     void AdaDelta(CPUMatrix<ElemType>& c, CPUMatrix<ElemType>& functionValues, ElemType learningRate, ElemType rho, ElemType epsilon);
+    void Adam(CPUMatrix<ElemType>& c, CPUMatrix<ElemType>& functionValues, ElemType learnRatePerSample, ElemType momentum, ElemType adaWeight,
+              ElemType adaMul, ElemType epsilon, double smoothedCount, bool unitGainMomentum, bool adamax);
 
 public:
     CPUSparseMatrix<ElemType>& InplaceTruncateTop(const ElemType threshold);
@@ -285,6 +287,11 @@ public:
         return BaseMatrix<ElemType>::GetBlockSize();
     }
 
+    size_t GetBlockIdShift() const
+    {
+        return BaseMatrix<ElemType>::GetBlockIdShift();
+    }
+
     size_t* BlockIdsLocation() const
     {
         if ((GetFormat() != matrixFormatSparseBlockCol) && (GetFormat() != matrixFormatSparseBlockRow))
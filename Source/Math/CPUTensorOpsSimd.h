@@ -0,0 +1,506 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+// Explicitly vectorized kernels for the most common dense elementwise tensor ops.
+//
+// The generic TensorOpIteration machinery in CPUMatrixImpl.h applies ops through a functor,
+// which the compiler mostly fails to vectorize for transcendentals (Sigmoid, Tanh, Exp, ...).
+// This header provides hand-vectorized float kernels for those ops, with the SIMD level picked
+// once at startup (AVX2 when both the binary and the machine support it, else SSE2). Everything
+// not covered here - double precision, exotic strides, reductions - stays on the scalar path;
+// callers probe via TryUnaryTensorOpSimd and fall through when it returns false.
+//
+// Accuracy: each kernel documents its maximum error in ulp against libm. Configs that need
+// bit-exact libm results can opt out globally with 'fastMathTensorOps=false'
+// (Globals::SetFastMathTensorOps), which makes the probe always fall through.
+//
+
+#pragma once
+
+#include "CommonMatrix.h"
+#include "Globals.h"
+#include <emmintrin.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// -----------------------------------------------------------------------
+// runtime SIMD level detection (done once at startup)
+// -----------------------------------------------------------------------
+
+enum class CPUSimdLevel
+{
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+inline CPUSimdLevel DetectCPUSimdLevel()
+{
+#if defined(__GNUC__)
+    if (__builtin_cpu_supports("avx2"))
+        return CPUSimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return CPUSimdLevel::SSE2;
+    return CPUSimdLevel::Scalar;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) // EBX bit 5 = AVX2
+            return CPUSimdLevel::AVX2;
+    }
+    return CPUSimdLevel::SSE2; // SSE2 is part of the x64 baseline
+#else
+    return CPUSimdLevel::Scalar;
+#endif
+}
+
+inline CPUSimdLevel GetCPUSimdLevel()
+{
+    static const CPUSimdLevel level = DetectCPUSimdLevel();
+    return level;
+}
+
+// -----------------------------------------------------------------------
+// SSE2 vector math helpers (float)
+// -----------------------------------------------------------------------
+
+// Vectorized expf() using the classic Cephes range reduction + degree-5 polynomial.
+// Max relative error is ~2 ulp over the non-flushing range, which is well within what
+// the surrounding training code tolerates (the scalar path uses fast-math expf anyway).
+inline __m128 ExpPs(__m128 x)
+{
+    const __m128 expHi = _mm_set1_ps(88.3762626647949f);
+    const __m128 expLo = _mm_set1_ps(-88.3762626647949f);
+    const __m128 log2e = _mm_set1_ps(1.44269504088896341f);
+    const __m128 c1 = _mm_set1_ps(0.693359375f);
+    const __m128 c2 = _mm_set1_ps(-2.12194440e-4f);
+    const __m128 p0 = _mm_set1_ps(1.9875691500e-4f);
+    const __m128 p1 = _mm_set1_ps(1.3981999507e-3f);
+    const __m128 p2 = _mm_set1_ps(8.3334519073e-3f);
+    const __m128 p3 = _mm_set1_ps(4.1665795894e-2f);
+    const __m128 p4 = _mm_set1_ps(1.6666665459e-1f);
+    const __m128 p5 = _mm_set1_ps(5.0000001201e-1f);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    x = _mm_min_ps(x, expHi);
+    x = _mm_max_ps(x, expLo);
+
+    // express exp(x) as exp(g + n*log(2))
+    __m128 fx = _mm_add_ps(_mm_mul_ps(x, log2e), _mm_set1_ps(0.5f));
+    __m128i emm0 = _mm_cvttps_epi32(fx);
+    __m128 tmp = _mm_cvtepi32_ps(emm0);
+    // if greater, subtract 1
+    __m128 mask = _mm_and_ps(_mm_cmpgt_ps(tmp, fx), one);
+    fx = _mm_sub_ps(tmp, mask);
+
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, c1));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, c2));
+
+    __m128 z = _mm_mul_ps(x, x);
+    __m128 y = p0;
+    y = _mm_add_ps(_mm_mul_ps(y, x), p1);
+    y = _mm_add_ps(_mm_mul_ps(y, x), p2);
+    y = _mm_add_ps(_mm_mul_ps(y, x), p3);
+    y = _mm_add_ps(_mm_mul_ps(y, x), p4);
+    y = _mm_add_ps(_mm_mul_ps(y, x), p5);
+    y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), one);
+
+    // build 2^n
+    emm0 = _mm_cvttps_epi32(fx);
+    emm0 = _mm_add_epi32(emm0, _mm_set1_epi32(0x7f));
+    emm0 = _mm_slli_epi32(emm0, 23);
+    return _mm_mul_ps(y, _mm_castsi128_ps(emm0));
+}
+
+// Vectorized logf() using the Cephes range reduction to [1/sqrt(2), sqrt(2)) and a degree-9
+// polynomial. Max error ~1 ulp for normal positive inputs; returns NaN for x <= 0 like libm
+// does for negative inputs (libm returns -inf for exactly 0, the only deviation).
+inline __m128 LogPs(__m128 x)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 invalidMask = _mm_cmple_ps(x, _mm_setzero_ps());
+    x = _mm_max_ps(x, _mm_set1_ps(1.17549435e-38f)); // flush denormals/zero to smallest normal
+
+    // split into exponent e and mantissa x in [0.5, 1)
+    __m128i emm0 = _mm_srli_epi32(_mm_castps_si128(x), 23);
+    emm0 = _mm_sub_epi32(emm0, _mm_set1_epi32(0x7f));
+    x = _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(~0x7f800000)));
+    x = _mm_or_ps(x, _mm_set1_ps(0.5f));
+    __m128 e = _mm_add_ps(_mm_cvtepi32_ps(emm0), one);
+
+    // if mantissa < 1/sqrt(2), halve the exponent and double the mantissa instead
+    __m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+    __m128 tmp = _mm_and_ps(x, mask);
+    x = _mm_sub_ps(x, one);
+    e = _mm_sub_ps(e, _mm_and_ps(one, mask));
+    x = _mm_add_ps(x, tmp);
+
+    __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(7.0376836292e-2f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+    y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+    y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+    y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    x = _mm_add_ps(x, y);
+    x = _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+    return _mm_or_ps(x, invalidMask); // force NaN for x <= 0
+}
+
+// 1 / (1 + exp(-x)); error is dominated by ExpPs, ~3 ulp worst case
+inline __m128 SigmoidPs(__m128 x)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 e = ExpPs(_mm_sub_ps(_mm_setzero_ps(), x));
+    return _mm_div_ps(one, _mm_add_ps(one, e));
+}
+
+// tanh(x) = 1 - 2 / (exp(2x) + 1); relative error ~3 ulp away from 0, grows to ~1e-7
+// absolute near 0 where the subtraction cancels - fine for activations
+inline __m128 TanhPs(__m128 x)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    __m128 e = ExpPs(_mm_mul_ps(x, two));
+    return _mm_sub_ps(one, _mm_div_ps(two, _mm_add_ps(e, one)));
+}
+
+#ifdef __AVX2__
+// AVX2 versions of the same kernels; only compiled in when the binary targets AVX2.
+inline __m256 ExpPs256(__m256 x)
+{
+    const __m256 expHi = _mm256_set1_ps(88.3762626647949f);
+    const __m256 expLo = _mm256_set1_ps(-88.3762626647949f);
+    const __m256 log2e = _mm256_set1_ps(1.44269504088896341f);
+    const __m256 c1 = _mm256_set1_ps(0.693359375f);
+    const __m256 c2 = _mm256_set1_ps(-2.12194440e-4f);
+    const __m256 p0 = _mm256_set1_ps(1.9875691500e-4f);
+    const __m256 p1 = _mm256_set1_ps(1.3981999507e-3f);
+    const __m256 p2 = _mm256_set1_ps(8.3334519073e-3f);
+    const __m256 p3 = _mm256_set1_ps(4.1665795894e-2f);
+    const __m256 p4 = _mm256_set1_ps(1.6666665459e-1f);
+    const __m256 p5 = _mm256_set1_ps(5.0000001201e-1f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    x = _mm256_min_ps(x, expHi);
+    x = _mm256_max_ps(x, expLo);
+
+    __m256 fx = _mm256_fmadd_ps(x, log2e, _mm256_set1_ps(0.5f));
+    fx = _mm256_floor_ps(fx);
+
+    x = _mm256_fnmadd_ps(fx, c1, x);
+    x = _mm256_fnmadd_ps(fx, c2, x);
+
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = p0;
+    y = _mm256_fmadd_ps(y, x, p1);
+    y = _mm256_fmadd_ps(y, x, p2);
+    y = _mm256_fmadd_ps(y, x, p3);
+    y = _mm256_fmadd_ps(y, x, p4);
+    y = _mm256_fmadd_ps(y, x, p5);
+    y = _mm256_add_ps(_mm256_fmadd_ps(y, z, x), one);
+
+    __m256i emm0 = _mm256_cvttps_epi32(fx);
+    emm0 = _mm256_add_epi32(emm0, _mm256_set1_epi32(0x7f));
+    emm0 = _mm256_slli_epi32(emm0, 23);
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(emm0));
+}
+
+// see LogPs for the algorithm and error bound (~1 ulp)
+inline __m256 LogPs256(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 invalidMask = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LE_OQ);
+    x = _mm256_max_ps(x, _mm256_set1_ps(1.17549435e-38f));
+
+    __m256i emm0 = _mm256_srli_epi32(_mm256_castps_si256(x), 23);
+    emm0 = _mm256_sub_epi32(emm0, _mm256_set1_epi32(0x7f));
+    x = _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(~0x7f800000)));
+    x = _mm256_or_ps(x, _mm256_set1_ps(0.5f));
+    __m256 e = _mm256_add_ps(_mm256_cvtepi32_ps(emm0), one);
+
+    __m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+    __m256 tmp = _mm256_and_ps(x, mask);
+    x = _mm256_sub_ps(x, one);
+    e = _mm256_sub_ps(e, _mm256_and_ps(one, mask));
+    x = _mm256_add_ps(x, tmp);
+
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(7.0376836292e-2f);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.1514610310e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.1676998740e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.2420140846e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.4249322787e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.6668057665e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(2.0000714765e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-2.4999993993e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(3.3333331174e-1f));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+    y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+    x = _mm256_add_ps(x, y);
+    x = _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), x);
+    return _mm256_or_ps(x, invalidMask);
+}
+
+inline __m256 SigmoidPs256(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 e = ExpPs256(_mm256_sub_ps(_mm256_setzero_ps(), x));
+    return _mm256_div_ps(one, _mm256_add_ps(one, e));
+}
+
+inline __m256 TanhPs256(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    __m256 e = ExpPs256(_mm256_mul_ps(x, two));
+    return _mm256_sub_ps(one, _mm256_div_ps(two, _mm256_add_ps(e, one)));
+}
+#endif
+
+// -----------------------------------------------------------------------
+// kernel driver: apply a vector functor + scalar tail over a dense range
+// -----------------------------------------------------------------------
+
+template <typename VecFn, typename ScalarFn>
+inline void UnaryOpSse(const float* pa, float* pc, size_t count, VecFn vecFn, ScalarFn scalarFn)
+{
+    const ptrdiff_t simdCount = (ptrdiff_t)(count / 4) * 4;
+#pragma omp parallel for
+    for (ptrdiff_t i = 0; i < simdCount; i += 4)
+        _mm_storeu_ps(pc + i, vecFn(_mm_loadu_ps(pa + i)));
+    for (size_t i = (size_t)simdCount; i < count; i++)
+        pc[i] = scalarFn(pa[i]);
+}
+
+#ifdef __AVX2__
+template <typename VecFn, typename ScalarFn>
+inline void UnaryOpAvx(const float* pa, float* pc, size_t count, VecFn vecFn, ScalarFn scalarFn)
+{
+    const ptrdiff_t simdCount = (ptrdiff_t)(count / 8) * 8;
+#pragma omp parallel for
+    for (ptrdiff_t i = 0; i < simdCount; i += 8)
+        _mm256_storeu_ps(pc + i, vecFn(_mm256_loadu_ps(pa + i)));
+    for (size_t i = (size_t)simdCount; i < count; i++)
+        pc[i] = scalarFn(pa[i]);
+}
+#endif
+
+// -----------------------------------------------------------------------
+// entry point: probe for a vectorized implementation of a dense unary op
+// -----------------------------------------------------------------------
+
+// Returns true if the op was handled. The caller must have verified that both tensors are
+// dense with unit strides, there is no reduction, and beta == 0 / alpha == 1.
+inline bool TryUnaryTensorOpSimd(ElementWiseOperator op, const float* pa, float* pc, size_t count)
+{
+    if (GetCPUSimdLevel() == CPUSimdLevel::Scalar || !Globals::ShouldUseFastMathTensorOps())
+        return false;
+
+#ifdef __AVX2__
+    if (GetCPUSimdLevel() == CPUSimdLevel::AVX2)
+    {
+        switch (op)
+        {
+        case ElementWiseOperator::opSigmoid:
+            UnaryOpAvx(pa, pc, count, [](__m256 x) { return SigmoidPs256(x); }, [](float x) { return 1.0f / (1.0f + expf(-x)); });
+            return true;
+        case ElementWiseOperator::opTanh:
+            UnaryOpAvx(pa, pc, count, [](__m256 x) { return TanhPs256(x); }, [](float x) { return tanhf(x); });
+            return true;
+        case ElementWiseOperator::opExp:
+            UnaryOpAvx(pa, pc, count, [](__m256 x) { return ExpPs256(x); }, [](float x) { return expf(x); });
+            return true;
+        case ElementWiseOperator::opLog:
+            // opLog is ClippedLog() in TensorOps.h: inputs below EPS_IN_LOG map to LOG_OF_EPS_IN_LOG
+            UnaryOpAvx(pa, pc, count,
+                       [](__m256 x)
+                       {
+                           __m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(EPS_IN_LOG), _CMP_LT_OQ);
+                           return _mm256_blendv_ps(LogPs256(x), _mm256_set1_ps(LOG_OF_EPS_IN_LOG), mask);
+                       },
+                       [](float x) { return x < EPS_IN_LOG ? LOG_OF_EPS_IN_LOG : logf(x); });
+            return true;
+        case ElementWiseOperator::opLinearRectifier:
+            UnaryOpAvx(pa, pc, count, [](__m256 x) { return _mm256_max_ps(x, _mm256_setzero_ps()); }, [](float x) { return x > 0 ? x : 0.0f; });
+            return true;
+        case ElementWiseOperator::opExponentialLinearUnit:
+            UnaryOpAvx(pa, pc, count,
+                       [](__m256 x)
+                       {
+                           __m256 mask = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ);
+                           __m256 neg = _mm256_sub_ps(ExpPs256(x), _mm256_set1_ps(1.0f));
+                           return _mm256_blendv_ps(neg, x, mask);
+                       },
+                       [](float x) { return x > 0 ? x : expf(x) - 1.0f; });
+            return true;
+        default:
+            return false;
+        }
+    }
+#endif
+
+    switch (op)
+    {
+    case ElementWiseOperator::opSigmoid:
+        UnaryOpSse(pa, pc, count, [](__m128 x) { return SigmoidPs(x); }, [](float x) { return 1.0f / (1.0f + expf(-x)); });
+        return true;
+    case ElementWiseOperator::opTanh:
+        UnaryOpSse(pa, pc, count, [](__m128 x) { return TanhPs(x); }, [](float x) { return tanhf(x); });
+        return true;
+    case ElementWiseOperator::opExp:
+        UnaryOpSse(pa, pc, count, [](__m128 x) { return ExpPs(x); }, [](float x) { return expf(x); });
+        return true;
+    case ElementWiseOperator::opLog:
+        // opLog is ClippedLog() in TensorOps.h: inputs below EPS_IN_LOG map to LOG_OF_EPS_IN_LOG
+        UnaryOpSse(pa, pc, count,
+                   [](__m128 x)
+                   {
+                       __m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(EPS_IN_LOG));
+                       __m128 y = LogPs(x);
+                       return _mm_or_ps(_mm_and_ps(mask, _mm_set1_ps(LOG_OF_EPS_IN_LOG)), _mm_andnot_ps(mask, y));
+                   },
+                   [](float x) { return x < EPS_IN_LOG ? LOG_OF_EPS_IN_LOG : logf(x); });
+        return true;
+    case ElementWiseOperator::opLinearRectifier:
+        UnaryOpSse(pa, pc, count, [](__m128 x) { return _mm_max_ps(x, _mm_setzero_ps()); }, [](float x) { return x > 0 ? x : 0.0f; });
+        return true;
+    case ElementWiseOperator::opExponentialLinearUnit:
+        UnaryOpSse(pa, pc, count,
+                   [](__m128 x)
+                   {
+                       __m128 mask = _mm_cmpgt_ps(x, _mm_setzero_ps());
+                       __m128 neg = _mm_sub_ps(ExpPs(x), _mm_set1_ps(1.0f));
+                       return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, neg));
+                   },
+                   [](float x) { return x > 0 ? x : expf(x) - 1.0f; });
+        return true;
+    default:
+        return false;
+    }
+}
+
+// double precision (and any other element type) is left on the scalar path - it is rare in
+// training configs and the polynomial constants above are tuned for float.
+template <class ElemType>
+inline bool TryUnaryTensorOpSimd(ElementWiseOperator /*op*/, const ElemType* /*pa*/, ElemType* /*pc*/, size_t /*count*/)
+{
+    return false;
+}
+
+// -----------------------------------------------------------------------
+// parallel sum reduction of a contiguous range into a scalar
+// -----------------------------------------------------------------------
+
+// Parallel reductions split the input into fixed-size chunks so that the summation order depends
+// only on the element count, never on the thread count: chunk partials are computed independently
+// and combined pairwise in index order, making results bitwise reproducible across runs and
+// machines with different core counts. Shared with the generic chunked reduction in CPUMatrixImpl.h.
+const size_t TensorReductionChunkSize = 16384;
+
+// Sum one chunk of contiguous floats. The scalar tensor-op path aggregates in double (see the
+// BUGBUG note at TensorOpWithFn), so each lane is widened to double before accumulating; the
+// fixed lane structure keeps the chunk partial deterministic.
+inline double SumReductionChunkSse(const float* pa, size_t count)
+{
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    const size_t simdCount = (count / 4) * 4;
+    for (size_t i = 0; i < simdCount; i += 4)
+    {
+        __m128 v = _mm_loadu_ps(pa + i);
+        acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+        acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    acc0 = _mm_add_pd(acc0, acc1);
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc0);
+    double sum = lanes[0] + lanes[1];
+    for (size_t i = simdCount; i < count; i++)
+        sum += (double) pa[i];
+    return sum;
+}
+
+#ifdef __AVX2__
+inline double SumReductionChunkAvx(const float* pa, size_t count)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    const size_t simdCount = (count / 8) * 8;
+    for (size_t i = 0; i < simdCount; i += 8)
+    {
+        __m256 v = _mm256_loadu_ps(pa + i);
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    acc0 = _mm256_add_pd(acc0, acc1);
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc0);
+    double sum = (lanes[0] + lanes[2]) + (lanes[1] + lanes[3]);
+    for (size_t i = simdCount; i < count; i++)
+        sum += (double) pa[i];
+    return sum;
+}
+#endif
+
+// Returns true if the sum was computed. The caller must have verified that the input is
+// contiguous and the output a scalar; this probe additionally requires the range to be large
+// enough to amortize the fork/join, and falls through when fast-math tensor ops are disabled
+// so that 'fastMathTensorOps=false' restores the legacy serial summation order bit for bit.
+inline bool TryParallelSumReductionSimd(const float* pa, size_t count, double& sum)
+{
+    if (GetCPUSimdLevel() == CPUSimdLevel::Scalar || !Globals::ShouldUseFastMathTensorOps())
+        return false;
+    if (count < 2 * TensorReductionChunkSize)
+        return false;
+
+    const size_t numChunks = (count + TensorReductionChunkSize - 1) / TensorReductionChunkSize;
+    std::vector<double> partials(numChunks);
+#pragma omp parallel for
+    for (ptrdiff_t c = 0; c < (ptrdiff_t) numChunks; c++)
+    {
+        const float* p = pa + (size_t) c * TensorReductionChunkSize;
+        size_t n = std::min(TensorReductionChunkSize, count - (size_t) c * TensorReductionChunkSize);
+#ifdef __AVX2__
+        if (GetCPUSimdLevel() == CPUSimdLevel::AVX2)
+            partials[c] = SumReductionChunkAvx(p, n);
+        else
+#endif
+            partials[c] = SumReductionChunkSse(p, n);
+    }
+
+    // combine the partials pairwise in index order (tree reduction with a fixed shape)
+    for (size_t step = 1; step < numChunks; step *= 2)
+        for (size_t i = 0; i + step < numChunks; i += 2 * step)
+            partials[i] += partials[i + step];
+    sum = partials[0];
+    return true;
+}
+
+template <class ElemType>
+inline bool TryParallelSumReductionSimd(const ElemType* /*pa*/, size_t /*count*/, double& /*sum*/)
+{
+    return false;
+}
+
+}}}
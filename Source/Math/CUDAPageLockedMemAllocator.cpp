@@ -1,8 +1,11 @@
 #include "stdafx.h"
 #include "CUDAPageLockedMemAllocator.h"
 #include "BestGpu.h" // for CPUONLY
+#include "PerformanceProfiler.h"
 #ifndef CPUONLY
 #include <cuda_runtime_api.h>
+#include <map>
+#include <mutex>
 #endif
 
 namespace Microsoft { namespace MSR { namespace CNTK {
@@ -15,6 +18,12 @@ inline static void CheckCudaReturnCode(cudaError_t rc, const char* msg)
         RuntimeError("%s: %s (cuda error %d)", msg, cudaGetErrorString(rc), (int)rc);
 }
 
+// allocation sizes by pointer, so frees can be memory-profiled with the right byte count;
+// page-locked allocations are few (reader prefetch buffers), so a mutex-guarded map is fine
+static std::mutex s_allocationSizeMutex;
+static std::map<void*, size_t> s_allocationSizes;
+static const char* c_memoryProfilerTag = "CUDA Page-Locked Host";
+
 CUDAPageLockedMemAllocator::CUDAPageLockedMemAllocator(int deviceID)
     : m_deviceID(deviceID)
 {
@@ -27,6 +36,11 @@ void* CUDAPageLockedMemAllocator::Malloc(size_t size, int deviceId)
 
     // Note: I ask for cudaHostAllocDefault but cudaHostGetFlags() shows that it is allocated as 'cudaHostAllocMapped'
     CheckCudaReturnCode(cudaHostAlloc(&p, size, cudaHostAllocDefault), "Malloc in CUDAPageLockedMemAllocator failed");
+    {
+        std::lock_guard<std::mutex> lock(s_allocationSizeMutex);
+        s_allocationSizes[p] = size;
+    }
+    ProfilerMemoryAlloc(c_memoryProfilerTag, size);
     return p;
 }
 
@@ -34,6 +48,18 @@ void CUDAPageLockedMemAllocator::Free(void* p, int deviceId)
 {
     CheckCudaReturnCode(cudaSetDevice(deviceId), "Cannot set cuda device");
     CheckCudaReturnCode(cudaFreeHost(p), "Free in CUDAPageLockedMemAllocator failed");
+    size_t size = 0;
+    {
+        std::lock_guard<std::mutex> lock(s_allocationSizeMutex);
+        auto found = s_allocationSizes.find(p);
+        if (found != s_allocationSizes.end())
+        {
+            size = found->second;
+            s_allocationSizes.erase(found);
+        }
+    }
+    if (size > 0)
+        ProfilerMemoryFree(c_memoryProfilerTag, size);
 }
 
 void* CUDAPageLockedMemAllocator::Malloc(size_t size)
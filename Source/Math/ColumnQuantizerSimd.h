@@ -0,0 +1,213 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+// Explicitly vectorized kernels for the 1-bit column quantizer on the CPU.
+//
+// ColumnQuantizer walks a column one QWord at a time, following the interleaved bit layout that
+// collates memory accesses on the GPU: row r maps to bit (r / numQWords) of QWord (r % numQWords).
+// On the CPU that means every QWord strides through the whole column, so the scalar loop is both
+// serial and cache-hostile. The kernels here invert the traversal -- one bit position at a time,
+// walking rows contiguously -- which produces the identical bit pattern and bit-identical
+// residuals (the per-element arithmetic is unchanged) while letting the compare/select/subtract
+// run 8 (AVX2) or 4 (SSE2) lanes wide.
+//
+// Only the float 1-bit case is covered: that is what the 1-bit SGD gradient exchange quantizes,
+// and a float QWord is 32 bits so a whole SIMD compare mask maps onto consecutive QWords at one
+// bit position. Double and multi-bit columns fall through to the scalar path; callers probe via
+// the Try* functions and keep the scalar loop as fallback.
+//
+
+#pragma once
+
+#include "CPUTensorOpsSimd.h" // for GetCPUSimdLevel
+#include "ValueQuantizer.h"
+#include <cstring>
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// quantize one float column to 1 bit per value, updating the residual
+// Returns true if handled; inResCol == outResCol (in-place residual) is allowed.
+inline bool TryQuantizeColumn1BitSimd(bool zeroThresholdFor1Bit,
+                                      const float* inCol, const float* inResCol, size_t M,
+                                      unsigned int* qColBits,
+                                      float lower, float upper, float* outResCol)
+{
+    if (GetCPUSimdLevel() == CPUSimdLevel::Scalar)
+        return false;
+
+    ValueQuantizer<float> valQ(0, lower, upper);
+    const float val0 = valQ.Unquantize(0);
+    const float val1 = valQ.Unquantize(1);
+    // same expression ValueQuantizer uses for quantimid, so thresholds agree bit for bit
+    const float threshold = zeroThresholdFor1Bit ? 0.0f : 0.5f * (upper + lower);
+
+    const size_t numQWords = (M + 31) / 32;
+    memset(qColBits, 0, numQWords * sizeof(unsigned int)); // bits are OR'ed in below
+
+#ifdef __AVX2__
+    if (GetCPUSimdLevel() == CPUSimdLevel::AVX2)
+    {
+        const __m256 thresholdV = _mm256_set1_ps(threshold);
+        const __m256 val0V = _mm256_set1_ps(val0);
+        const __m256 val1V = _mm256_set1_ps(val1);
+        for (size_t k = 0; k < 32; k++) // bit position within the QWords
+        {
+            const size_t base = k * numQWords; // rows [base, base + count) all carry bit k
+            if (base >= M)
+                break;
+            const size_t count = std::min(numQWords, M - base);
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256 v = _mm256_add_ps(_mm256_loadu_ps(inCol + base + i), _mm256_loadu_ps(inResCol + base + i));
+                __m256 geMask = _mm256_cmp_ps(v, thresholdV, _CMP_GE_OQ); // false for NaN, like the scalar >=
+                _mm256_storeu_ps(outResCol + base + i, _mm256_sub_ps(v, _mm256_blendv_ps(val0V, val1V, geMask)));
+                unsigned int m = (unsigned int) _mm256_movemask_ps(geMask); // lane j -> QWord i + j
+                for (size_t b = 0; b < 8; b++)
+                    qColBits[i + b] |= ((m >> b) & 1) << k;
+            }
+            for (; i < count; i++)
+            {
+                float v = inCol[base + i] + inResCol[base + i];
+                bool q = v >= threshold;
+                outResCol[base + i] = v - (q ? val1 : val0);
+                if (q)
+                    qColBits[i] |= 1u << k;
+            }
+        }
+        return true;
+    }
+#endif
+
+    const __m128 thresholdV = _mm_set1_ps(threshold);
+    const __m128 val0V = _mm_set1_ps(val0);
+    const __m128 val1V = _mm_set1_ps(val1);
+    for (size_t k = 0; k < 32; k++)
+    {
+        const size_t base = k * numQWords;
+        if (base >= M)
+            break;
+        const size_t count = std::min(numQWords, M - base);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 v = _mm_add_ps(_mm_loadu_ps(inCol + base + i), _mm_loadu_ps(inResCol + base + i));
+            __m128 geMask = _mm_cmpge_ps(v, thresholdV);
+            __m128 uval = _mm_or_ps(_mm_and_ps(geMask, val1V), _mm_andnot_ps(geMask, val0V));
+            _mm_storeu_ps(outResCol + base + i, _mm_sub_ps(v, uval));
+            unsigned int m = (unsigned int) _mm_movemask_ps(geMask);
+            for (size_t b = 0; b < 4; b++)
+                qColBits[i + b] |= ((m >> b) & 1) << k;
+        }
+        for (; i < count; i++)
+        {
+            float v = inCol[base + i] + inResCol[base + i];
+            bool q = v >= threshold;
+            outResCol[base + i] = v - (q ? val1 : val0);
+            if (q)
+                qColBits[i] |= 1u << k;
+        }
+    }
+    return true;
+}
+
+// unquantize one 1-bit float column; if 'add', accumulate into the output
+inline bool TryUnquantizeColumn1BitSimd(float* outCol, size_t M, const unsigned int* qColBits,
+                                        float lower, float upper, bool add)
+{
+    if (GetCPUSimdLevel() == CPUSimdLevel::Scalar)
+        return false;
+
+    ValueQuantizer<float> valQ(0, lower, upper);
+    const float val0 = valQ.Unquantize(0);
+    const float val1 = valQ.Unquantize(1);
+
+    const size_t numQWords = (M + 31) / 32;
+
+#ifdef __AVX2__
+    if (GetCPUSimdLevel() == CPUSimdLevel::AVX2)
+    {
+        const __m256 val0V = _mm256_set1_ps(val0);
+        const __m256 val1V = _mm256_set1_ps(val1);
+        const __m256i ones = _mm256_set1_epi32(1);
+        for (size_t k = 0; k < 32; k++)
+        {
+            const size_t base = k * numQWords;
+            if (base >= M)
+                break;
+            const size_t count = std::min(numQWords, M - base);
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256i q = _mm256_loadu_si256((const __m256i*) (qColBits + i));
+                __m256i bitSet = _mm256_and_si256(_mm256_srli_epi32(q, (int) k), ones);
+                __m256 mask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(bitSet, ones));
+                __m256 val = _mm256_blendv_ps(val0V, val1V, mask);
+                if (add)
+                    val = _mm256_add_ps(val, _mm256_loadu_ps(outCol + base + i));
+                _mm256_storeu_ps(outCol + base + i, val);
+            }
+            for (; i < count; i++)
+            {
+                float val = ((qColBits[i] >> k) & 1) ? val1 : val0;
+                if (add)
+                    val += outCol[base + i];
+                outCol[base + i] = val;
+            }
+        }
+        return true;
+    }
+#endif
+
+    const __m128 val0V = _mm_set1_ps(val0);
+    const __m128 val1V = _mm_set1_ps(val1);
+    const __m128i ones = _mm_set1_epi32(1);
+    for (size_t k = 0; k < 32; k++)
+    {
+        const size_t base = k * numQWords;
+        if (base >= M)
+            break;
+        const size_t count = std::min(numQWords, M - base);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i q = _mm_loadu_si128((const __m128i*) (qColBits + i));
+            __m128i bitSet = _mm_and_si128(_mm_srli_epi32(q, (int) k), ones);
+            __m128 mask = _mm_castsi128_ps(_mm_cmpeq_epi32(bitSet, ones));
+            __m128 val = _mm_or_ps(_mm_and_ps(mask, val1V), _mm_andnot_ps(mask, val0V));
+            if (add)
+                val = _mm_add_ps(val, _mm_loadu_ps(outCol + base + i));
+            _mm_storeu_ps(outCol + base + i, val);
+        }
+        for (; i < count; i++)
+        {
+            float val = ((qColBits[i] >> k) & 1) ? val1 : val0;
+            if (add)
+                val += outCol[base + i];
+            outCol[base + i] = val;
+        }
+    }
+    return true;
+}
+
+// double columns stay on the scalar path (a double QWord is 64 bits, so one compare mask no
+// longer lines up with consecutive QWords; the gradient exchange quantizes float in practice)
+template <class ElemType>
+inline bool TryQuantizeColumn1BitSimd(bool /*zeroThresholdFor1Bit*/,
+                                      const ElemType* /*inCol*/, const ElemType* /*inResCol*/, size_t /*M*/,
+                                      typename QuantizedWordHelper<ElemType>::ValueType* /*qColBits*/,
+                                      ElemType /*lower*/, ElemType /*upper*/, ElemType* /*outResCol*/)
+{
+    return false;
+}
+
+template <class ElemType>
+inline bool TryUnquantizeColumn1BitSimd(ElemType* /*outCol*/, size_t /*M*/,
+                                        const typename QuantizedWordHelper<ElemType>::ValueType* /*qColBits*/,
+                                        ElemType /*lower*/, ElemType /*upper*/, bool /*add*/)
+{
+    return false;
+}
+
+}}}
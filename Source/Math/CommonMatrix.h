@@ -64,6 +64,16 @@ public:
     template <typename AllocatedElemType>
     static void Free(int deviceId, AllocatedElemType* bufferPtr, bool ignoreCUDARetCode = false);
 
+    // Freed device buffers are kept in per-device, per-size-class free lists and reused by later
+    // allocations of the same class, so steady-state Resize() churn never enters the driver
+    // (cudaMalloc/cudaFree serialize the device). Disable to get exact malloc/free pairing, e.g.
+    // when chasing memory corruption with external tools.
+    static void SetCachingEnabled(bool enable) { m_cachingEnabled = enable; }
+    static bool IsCachingEnabled() { return m_cachingEnabled; }
+
+    // return every cached block to the driver (e.g. under external memory pressure)
+    static void PurgeCache();
+
     // Let it be public method, the memory manager could check the totoal free memory and decide whether to physically
     // release all the cached memory.
     static std::pair<size_t, size_t> GetFreeAndTotalMemoryInMBs(int deviceId);
@@ -71,6 +81,8 @@ public:
 private:
     template <typename AllocatedElemType>
     static AllocatedElemType* AllocateNoTrace(int deviceId, size_t numElements);
+
+    static bool m_cachingEnabled;
 };
 
 // -----------------------------------------------------------------------
@@ -110,6 +122,13 @@ enum ElementWiseOperator
     opElementwiseProductWithQuotient, /* a * (b / c) */
     opElementwiseProductWithPowExponentDerivative, /* a * b * log(c) */
     opElementwiseProductWithPowBaseDerivative,  /* a * c * pow(b, c-1) */
+    // Fused elementwise chains. These evaluate a short pipeline of ops in a single traversal,
+    // so chains like scale -> add-bias -> nonlinearity touch memory once instead of once per op.
+    opSigmoidOfSum, /* Sigmoid(a + b) */
+    opTanhOfSum, /* Tanh(a + b) */
+    opLinearRectifierOfSum, /* Relu(a + b) */
+    opSigmoidOfProductPlus, /* Sigmoid(a * b + c) */
+    opTanhOfProductPlus, /* Tanh(a * b + c) */
     // Note: not all that's implemented in CNTK ComputationNodes has an opcode yet.
 };
 
@@ -166,7 +185,10 @@ enum ElementWiseOperator
     Macro(ElementwiseProductWithReciprocalDerivative);                       \
     Macro(ElementwiseProductWithSqrtDerivative);                             \
     Macro(SqrOfDifference);                                                  \
-    Macro(ElementwiseProductWithExponentialLinearUnitDerivativeFromOutput);
+    Macro(ElementwiseProductWithExponentialLinearUnitDerivativeFromOutput);  \
+    Macro(SigmoidOfSum);                                                     \
+    Macro(TanhOfSum);                                                        \
+    Macro(LinearRectifierOfSum);
     //Macro(Index);
 
 #define ForAllTernaryOps(Macro)                         \
@@ -177,7 +199,9 @@ enum ElementWiseOperator
     Macro(ElementwiseProductWithExpOfDiff);             \
     Macro(ElementwiseProductWithQuotient);              \
     Macro(ElementwiseProductWithPowExponentDerivative); \
-    Macro(ElementwiseProductWithPowBaseDerivative);
+    Macro(ElementwiseProductWithPowBaseDerivative);     \
+    Macro(SigmoidOfProductPlus);                        \
+    Macro(TanhOfProductPlus);
 
 // -----------------------------------------------------------------------
 // various enums to describe
@@ -29,6 +29,28 @@ void ConvolutionEngine<ElemType>::Forward(const Mat& in, const Mat& kernel, Mat&
     ForwardCore(in, kernel, out, workspace);
 }
 
+template <class ElemType>
+void ConvolutionEngine<ElemType>::ForwardBiasActivation(const Mat& in, const Mat& kernel, const Mat& bias, Mat& out, Mat& workspace)
+{
+    const auto& g = *m_geometry;
+    assert(g.InputShape().GetNumElements() == in.GetNumRows());
+    assert(g.OutputShape().GetNumElements() == out.GetNumRows());
+    size_t batchSize = in.GetNumCols();
+    assert(batchSize == out.GetNumCols());
+    assert(g.KernelShape().GetNumElements() * g.KernelCount() == kernel.GetNumElements());
+    // One bias value per output feature map.
+    assert(g.GetMapCount(g.InputShape().GetRank() - 1) == bias.GetNumElements());
+#ifdef NDEBUG
+    UNUSED(g);
+    UNUSED(batchSize);
+    UNUSED(bias);
+#endif
+
+    EnsureCompatible();
+    EnsureConvolutionInitialized();
+    ForwardBiasActivationCore(in, kernel, bias, out, workspace);
+}
+
 template <class ElemType>
 void ConvolutionEngine<ElemType>::BackwardData(const Mat& srcGrad, const Mat& kernel, Mat& grad, bool accumulateGradient, Mat& workspace)
 {
@@ -567,6 +589,29 @@ public:
     {
     }
 
+    // The per-sample workspace requirement follows from the Resize() calls in ForwardCore(),
+    // BackwardDataCore() and BackwardKernelCore() below, with subBatchSize == batchSize (the
+    // worst case; m_maxTempMemSizeInSamples only ever caps it). The constant-size transposed
+    // kernel copy of BackwardDataCore() is not included; it is per-network, not per-sample,
+    // and the arena still grows on first use if the estimate falls short.
+    size_t MaxWorkspaceSizePerSample() const override
+    {
+        const auto& inT = m_geometry->InputShape();
+        const auto& kernT = m_geometry->KernelShape();
+        const auto& outT = m_geometry->OutputShape();
+        size_t dimCount = inT.GetRank();
+        size_t mapOutCount = m_geometry->GetMapCount(dimCount - 1);
+        size_t mapOutSize = outT.GetNumElements() / mapOutCount;
+        size_t mapInCount = kernT[dimCount - 1];
+        size_t mapInSize = inT.GetNumElements() / mapInCount;
+        size_t kernSize = kernT.GetNumElements();
+        // forward and backward-kernel: unrolled input plus intermediate (pre-transpose) output
+        size_t forwardSize = mapOutSize * (kernSize + mapOutCount);
+        // backward-data: unrolled source gradient plus intermediate input gradient
+        size_t backwardDataSize = mapInSize * (kernSize * mapOutCount / mapInCount + mapInCount);
+        return max(forwardSize, backwardDataSize);
+    }
+
 protected:
     using typename Base::IntMatPtr;
 
@@ -851,6 +896,561 @@ public:
     }
 };
 
+//------------------------------------------------------------------
+// Direct convolution engine implementation (CPU).
+// Computes small-square-kernel 2D convolutions (3x3/5x5, full sharing)
+// by walking the kernel over the input directly, without unrolling,
+// with the output maps tiled across threads. For such kernels the
+// unroll step of the GEMM engine costs more memory traffic than the
+// convolution itself. The backward passes reuse the GEMM machinery of
+// the base class, but through a persistent per-engine workspace so the
+// unroll buffer survives across minibatches instead of being resized
+// in whatever shared matrix the caller hands in.
+//------------------------------------------------------------------
+template <class ElemType>
+class DirectConvolutionEngine : public GemmConvolutionEngine<ElemType>
+{
+public:
+    using Base = GemmConvolutionEngine<ElemType>;
+    using typename Base::Mat;
+
+public:
+    DirectConvolutionEngine(ConvolveGeometryPtr geometry, DEVICEID_TYPE deviceId, ImageLayoutKind imageLayout, size_t maxTempMemSizeInSamples, PoolKind poolKind, bool poolIncludePad)
+        : Base(geometry, deviceId, imageLayout, maxTempMemSizeInSamples, poolKind, poolIncludePad), m_unrollWorkspace(deviceId)
+    {
+    }
+
+protected:
+    using Base::IsGpu;
+
+    using Base::m_geometry;
+    using Base::m_deviceId;
+    using Base::m_imageLayout;
+
+    void EnsureCompatible() override
+    {
+        if (m_imageLayout != ImageLayoutKind::CHW)
+            LogicError("Direct convolution engine supports only CHW/cudnn layout.");
+        if (IsGpu(m_deviceId))
+            LogicError("Direct convolution engine currently supports only CPU device.");
+    }
+
+    // Direct computation of out(x', y', k, n) = sum_{x, y, c} in(x'*sw - pw + x, y'*sh - ph + y, c, n) * kernel(x, y, c, k).
+    // Both tensors are column-major with the W dimension having stride 1 and the kernel uses the
+    // row-major (cudnn) layout, i.e. elements within one output map's kernel are ordered like the
+    // input: x + X*y + X*Y*c. Each (sample, output map) pair is one independent output tile.
+    void ForwardCore(const Mat& in, const Mat& kernel, Mat& out, Mat& /*workspace*/) override
+    {
+        const auto& inT = m_geometry->InputShape();
+        const auto& outT = m_geometry->OutputShape();
+        const auto& kernT = m_geometry->KernelShape();
+
+        long inW = (long) inT[0], inH = (long) inT[1], inC = (long) inT[2];
+        long outW = (long) outT[0], outH = (long) outT[1], mapCount = (long) outT[2];
+        long kernW = (long) kernT[0], kernH = (long) kernT[1];
+        long strideW = (long) m_geometry->GetStride(0), strideH = (long) m_geometry->GetStride(1);
+        long padW = (long) m_geometry->GetLowerPad(0), padH = (long) m_geometry->GetLowerPad(1);
+
+        const ElemType* inPtr = in.Data();
+        const ElemType* kernPtr = kernel.Data();
+        ElemType* outPtr = out.Data();
+        long batchSize = (long) in.GetNumCols();
+
+#pragma omp parallel for
+        for (long nk = 0; nk < batchSize * mapCount; nk++)
+        {
+            long n = nk / mapCount;
+            long k = nk % mapCount;
+            const ElemType* inSample = inPtr + n * inW * inH * inC;
+            const ElemType* kernMap = kernPtr + k * kernW * kernH * inC;
+            ElemType* outMap = outPtr + n * outW * outH * mapCount + k * outW * outH;
+            for (long yo = 0; yo < outH; yo++)
+            {
+                long yBase = yo * strideH - padH;
+                for (long xo = 0; xo < outW; xo++)
+                {
+                    long xBase = xo * strideW - padW;
+                    ElemType sum = 0;
+                    for (long c = 0; c < inC; c++)
+                    {
+                        const ElemType* inPlane = inSample + c * inW * inH;
+                        const ElemType* kernPlane = kernMap + c * kernW * kernH;
+                        for (long ky = 0; ky < kernH; ky++)
+                        {
+                            long yi = yBase + ky;
+                            if (yi < 0 || yi >= inH)
+                                continue;
+                            for (long kx = 0; kx < kernW; kx++)
+                            {
+                                long xi = xBase + kx;
+                                if (xi < 0 || xi >= inW)
+                                    continue;
+                                sum += inPlane[yi * inW + xi] * kernPlane[ky * kernW + kx];
+                            }
+                        }
+                    }
+                    outMap[yo * outW + xo] = sum;
+                }
+            }
+        }
+    }
+
+    // The backward passes go through the unroll+GEMM path of the base class, but with this
+    // engine's own workspace: the caller-provided one is shared and gets repurposed between
+    // minibatches, so routing the unroll buffer through m_unrollWorkspace makes its (large)
+    // allocation a one-time cost.
+    void BackwardDataCore(const Mat& srcGrad, const Mat& kernel, Mat& grad, bool accumulateGradient, Mat& /*workspace*/) override
+    {
+        Base::BackwardDataCore(srcGrad, kernel, grad, accumulateGradient, m_unrollWorkspace);
+    }
+
+    void BackwardKernelCore(const Mat& srcGrad, const Mat& in, Mat& kernelGrad, bool accumulateGradient, bool allowReuse, Mat& /*workspace*/) override
+    {
+        // the forward pass does not fill the unroll buffer, so never reuse its content
+        UNUSED(allowReuse);
+        Base::BackwardKernelCore(srcGrad, in, kernelGrad, accumulateGradient, false, m_unrollWorkspace);
+    }
+
+public:
+    static bool IsSupported(DEVICEID_TYPE deviceId, ConvolveGeometryPtr geometry)
+    {
+        if (!GemmConvolutionEngine<ElemType>::IsSupported(deviceId, geometry))
+            return false;
+        const auto& inT = geometry->InputShape();
+        const auto& kernT = geometry->KernelShape();
+        if (inT.GetRank() != 3 || kernT.GetRank() != 3 || kernT[2] != inT[2])
+            return false;
+        // the direct loops only beat unroll+GEMM for small square kernels over the full input depth
+        return kernT[0] == kernT[1] && (kernT[0] == 3 || kernT[0] == 5);
+    }
+
+private:
+    Mat m_unrollWorkspace;
+};
+
+//------------------------------------------------------------------
+// Winograd convolution engine implementation (CPU).
+// Implements the F(2x2,3x3) fast algorithm (Lavin, Gray: "Fast Algorithms
+// for Convolutional Neural Networks"): each 2x2 output tile is computed
+// from a 4x4 input tile with 16 multiplies per channel instead of 36,
+// a 2.25x multiply-count reduction on 3x3 stride-1 convolutions.
+// The kernel is transformed once per call, input tiles are transformed
+// and accumulated tile-parallel across threads. Backward passes and
+// pooling reuse the base class machinery.
+//------------------------------------------------------------------
+template <class ElemType>
+class WinogradConvolutionEngine : public GemmConvolutionEngine<ElemType>
+{
+public:
+    using Base = GemmConvolutionEngine<ElemType>;
+    using typename Base::Mat;
+
+public:
+    WinogradConvolutionEngine(ConvolveGeometryPtr geometry, DEVICEID_TYPE deviceId, ImageLayoutKind imageLayout, size_t maxTempMemSizeInSamples, PoolKind poolKind, bool poolIncludePad)
+        : Base(geometry, deviceId, imageLayout, maxTempMemSizeInSamples, poolKind, poolIncludePad)
+    {
+    }
+
+protected:
+    using Base::IsGpu;
+
+    using Base::m_geometry;
+    using Base::m_deviceId;
+    using Base::m_imageLayout;
+
+    void EnsureCompatible() override
+    {
+        if (m_imageLayout != ImageLayoutKind::CHW)
+            LogicError("Winograd convolution engine supports only CHW/cudnn layout.");
+        if (IsGpu(m_deviceId))
+            LogicError("Winograd convolution engine currently supports only CPU device.");
+        const auto& kernT = m_geometry->KernelShape();
+        if (kernT[0] != 3 || kernT[1] != 3 || m_geometry->GetStride(0) != 1 || m_geometry->GetStride(1) != 1)
+            LogicError("Winograd convolution engine supports only 3x3 stride-1 convolutions.");
+    }
+
+    // u = G g G^T (4x4), G = [1 0 0; 1/2 1/2 1/2; 1/2 -1/2 1/2; 0 0 1]; g is one 3x3 kernel plane
+    static void TransformKernel3x3(const ElemType* g, ElemType* u)
+    {
+        ElemType t[4][3];
+        for (int x = 0; x < 3; x++)
+        {
+            ElemType g0 = g[0 * 3 + x], g1 = g[1 * 3 + x], g2 = g[2 * 3 + x];
+            t[0][x] = g0;
+            t[1][x] = (ElemType)0.5 * (g0 + g1 + g2);
+            t[2][x] = (ElemType)0.5 * (g0 - g1 + g2);
+            t[3][x] = g2;
+        }
+        for (int i = 0; i < 4; i++)
+        {
+            ElemType t0 = t[i][0], t1 = t[i][1], t2 = t[i][2];
+            u[i * 4 + 0] = t0;
+            u[i * 4 + 1] = (ElemType)0.5 * (t0 + t1 + t2);
+            u[i * 4 + 2] = (ElemType)0.5 * (t0 - t1 + t2);
+            u[i * 4 + 3] = t2;
+        }
+    }
+
+    // v = B^T d B (4x4), B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1]; d is a 4x4 input tile
+    static void TransformInput4x4(const ElemType* d, ElemType* v)
+    {
+        ElemType w[4][4];
+        for (int x = 0; x < 4; x++)
+        {
+            ElemType d0 = d[0 * 4 + x], d1 = d[1 * 4 + x], d2 = d[2 * 4 + x], d3 = d[3 * 4 + x];
+            w[0][x] = d0 - d2;
+            w[1][x] = d1 + d2;
+            w[2][x] = d2 - d1;
+            w[3][x] = d1 - d3;
+        }
+        for (int i = 0; i < 4; i++)
+        {
+            ElemType w0 = w[i][0], w1 = w[i][1], w2 = w[i][2], w3 = w[i][3];
+            v[i * 4 + 0] = w0 - w2;
+            v[i * 4 + 1] = w1 + w2;
+            v[i * 4 + 2] = w2 - w1;
+            v[i * 4 + 3] = w1 - w3;
+        }
+    }
+
+    // y = A^T m A (2x2), A^T = [1 1 1 0; 0 1 -1 -1]; m is the 4x4 elementwise-product accumulator
+    static void TransformOutput2x2(const ElemType* m, ElemType* y)
+    {
+        ElemType s[2][4];
+        for (int x = 0; x < 4; x++)
+        {
+            ElemType m0 = m[0 * 4 + x], m1 = m[1 * 4 + x], m2 = m[2 * 4 + x], m3 = m[3 * 4 + x];
+            s[0][x] = m0 + m1 + m2;
+            s[1][x] = m1 - m2 - m3;
+        }
+        for (int i = 0; i < 2; i++)
+        {
+            y[i * 2 + 0] = s[i][0] + s[i][1] + s[i][2];
+            y[i * 2 + 1] = s[i][1] - s[i][2] - s[i][3];
+        }
+    }
+
+    void ForwardCore(const Mat& in, const Mat& kernel, Mat& out, Mat& /*workspace*/) override
+    {
+        const auto& inT = m_geometry->InputShape();
+        const auto& outT = m_geometry->OutputShape();
+
+        long inW = (long) inT[0], inH = (long) inT[1], inC = (long) inT[2];
+        long outW = (long) outT[0], outH = (long) outT[1], mapCount = (long) outT[2];
+        long padW = (long) m_geometry->GetLowerPad(0), padH = (long) m_geometry->GetLowerPad(1);
+        long tilesW = (outW + 1) / 2, tilesH = (outH + 1) / 2;
+
+        const ElemType* inPtr = in.Data();
+        const ElemType* kernPtr = kernel.Data();
+        ElemType* outPtr = out.Data();
+        long batchSize = (long) in.GetNumCols();
+
+        // transform all kernel planes up front; the weights change every minibatch during
+        // training, so this is redone per call, but it is O(K*C) tiny 4x4 transforms
+        m_transformedKernel.resize(mapCount * inC * 16);
+        ElemType* u = m_transformedKernel.data();
+#pragma omp parallel for
+        for (long kc = 0; kc < mapCount * inC; kc++)
+            TransformKernel3x3(kernPtr + kc * 9, u + kc * 16);
+
+        // one tile row of one sample per iteration; the input transform of each tile is
+        // computed once and reused across all output maps
+#pragma omp parallel
+        {
+            std::vector<ElemType> v(inC * 16);
+#pragma omp for
+            for (long nty = 0; nty < batchSize * tilesH; nty++)
+            {
+                long n = nty / tilesH;
+                long ty = nty % tilesH;
+                const ElemType* inSample = inPtr + n * inW * inH * inC;
+                long yBase = 2 * ty - padH;
+                for (long tx = 0; tx < tilesW; tx++)
+                {
+                    long xBase = 2 * tx - padW;
+                    // gather + transform the 4x4 input tile of every channel (zero-padded at borders)
+                    for (long c = 0; c < inC; c++)
+                    {
+                        const ElemType* inPlane = inSample + c * inW * inH;
+                        ElemType d[16];
+                        for (long dy = 0; dy < 4; dy++)
+                        {
+                            long yi = yBase + dy;
+                            for (long dx = 0; dx < 4; dx++)
+                            {
+                                long xi = xBase + dx;
+                                d[dy * 4 + dx] = (yi >= 0 && yi < inH && xi >= 0 && xi < inW) ? inPlane[yi * inW + xi] : 0;
+                            }
+                        }
+                        TransformInput4x4(d, &v[c * 16]);
+                    }
+                    // per output map: elementwise multiply-accumulate in transform space, then
+                    // transform the 2x2 result back (right/bottom edge tiles may be partial)
+                    for (long k = 0; k < mapCount; k++)
+                    {
+                        ElemType m[16] = {0};
+                        const ElemType* uk = u + k * inC * 16;
+                        for (long c = 0; c < inC; c++)
+                            for (int j = 0; j < 16; j++)
+                                m[j] += uk[c * 16 + j] * v[c * 16 + j];
+                        ElemType y[4];
+                        TransformOutput2x2(m, y);
+                        ElemType* outMap = outPtr + n * outW * outH * mapCount + k * outW * outH;
+                        for (long dy = 0; dy < 2; dy++)
+                        {
+                            long yo = 2 * ty + dy;
+                            if (yo >= outH)
+                                break;
+                            for (long dx = 0; dx < 2; dx++)
+                            {
+                                long xo = 2 * tx + dx;
+                                if (xo >= outW)
+                                    break;
+                                outMap[yo * outW + xo] = y[dy * 2 + dx];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    static bool IsSupported(DEVICEID_TYPE deviceId, ConvolveGeometryPtr geometry)
+    {
+        if (!GemmConvolutionEngine<ElemType>::IsSupported(deviceId, geometry))
+            return false;
+        const auto& inT = geometry->InputShape();
+        const auto& kernT = geometry->KernelShape();
+        return inT.GetRank() == 3 && kernT.GetRank() == 3 && kernT[2] == inT[2] &&
+               kernT[0] == 3 && kernT[1] == 3 &&
+               geometry->GetStride(0) == 1 && geometry->GetStride(1) == 1;
+    }
+
+private:
+    std::vector<ElemType> m_transformedKernel;
+};
+
+//------------------------------------------------------------------
+// Depthwise convolution engine implementation (CPU).
+// Handles depthwise (per-channel) 2D convolutions: kernel shape (X, Y, 1)
+// with sharing disabled along the channel dimension, so each input channel
+// is filtered by its own kernel plane and channel c of the output depends
+// only on channel c of the input. Such geometries fail the full-sharing
+// requirement of the GEMM-family engines and would otherwise fall to the
+// lookup-based reference path, which pays the per-output-cell indirection
+// of MpRowCol/Runs for what is really a dense 2D stencil per channel.
+// This engine computes all three passes with direct loops, one (sample,
+// channel) plane per thread, with no workspace and no races: the planes
+// are fully independent.
+//------------------------------------------------------------------
+template <class ElemType>
+class DepthwiseConvolutionEngine : public ReferenceConvolutionEngine<ElemType>
+{
+public:
+    using Base = ReferenceConvolutionEngine<ElemType>;
+    using typename Base::Mat;
+
+public:
+    DepthwiseConvolutionEngine(ConvolveGeometryPtr geometry, DEVICEID_TYPE deviceId, ImageLayoutKind imageLayout, size_t maxTempMemSizeInSamples, PoolKind poolKind, bool poolIncludePad)
+        : Base(geometry, deviceId, imageLayout, maxTempMemSizeInSamples, poolKind, poolIncludePad)
+    {
+    }
+
+protected:
+    using Base::IsGpu;
+
+    using Base::m_geometry;
+    using Base::m_deviceId;
+    using Base::m_imageLayout;
+
+    void EnsureCompatible() override
+    {
+        if (m_imageLayout != ImageLayoutKind::CHW)
+            LogicError("Depthwise convolution engine supports only CHW/cudnn layout.");
+        if (IsGpu(m_deviceId))
+            LogicError("Depthwise convolution engine currently supports only CPU device.");
+    }
+
+    // out(x', y', c, n) = sum_{x, y} in(x'*sw - pw + x, y'*sh - ph + y, c, n) * kernel(x, y, c).
+    // The kernel matrix holds one (X x Y) plane per input channel: with sharing disabled only
+    // along the channel dimension, MpRowIwht maps channel c to weight offset c*X*Y.
+    void ForwardCore(const Mat& in, const Mat& kernel, Mat& out, Mat& /*workspace*/) override
+    {
+        const auto& inT = m_geometry->InputShape();
+        const auto& outT = m_geometry->OutputShape();
+        const auto& kernT = m_geometry->KernelShape();
+
+        long inW = (long) inT[0], inH = (long) inT[1], inC = (long) inT[2];
+        long outW = (long) outT[0], outH = (long) outT[1];
+        long kernW = (long) kernT[0], kernH = (long) kernT[1];
+        long strideW = (long) m_geometry->GetStride(0), strideH = (long) m_geometry->GetStride(1);
+        long padW = (long) m_geometry->GetLowerPad(0), padH = (long) m_geometry->GetLowerPad(1);
+
+        const ElemType* inPtr = in.Data();
+        const ElemType* kernPtr = kernel.Data();
+        ElemType* outPtr = out.Data();
+        long batchSize = (long) in.GetNumCols();
+
+#pragma omp parallel for
+        for (long nc = 0; nc < batchSize * inC; nc++)
+        {
+            long n = nc / inC;
+            long c = nc % inC;
+            const ElemType* inPlane = inPtr + n * inW * inH * inC + c * inW * inH;
+            const ElemType* kernPlane = kernPtr + c * kernW * kernH;
+            ElemType* outPlane = outPtr + n * outW * outH * inC + c * outW * outH;
+            for (long yo = 0; yo < outH; yo++)
+            {
+                long yBase = yo * strideH - padH;
+                for (long xo = 0; xo < outW; xo++)
+                {
+                    long xBase = xo * strideW - padW;
+                    ElemType sum = 0;
+                    for (long ky = 0; ky < kernH; ky++)
+                    {
+                        long yi = yBase + ky;
+                        if (yi < 0 || yi >= inH)
+                            continue;
+                        for (long kx = 0; kx < kernW; kx++)
+                        {
+                            long xi = xBase + kx;
+                            if (xi < 0 || xi >= inW)
+                                continue;
+                            sum += inPlane[yi * inW + xi] * kernPlane[ky * kernW + kx];
+                        }
+                    }
+                    outPlane[yo * outW + xo] = sum;
+                }
+            }
+        }
+    }
+
+    // Scatters each source gradient cell back through its kernel plane. The caller zeroes
+    // grad when not accumulating (ImplementsGradientOverwriteOptimization is false), so the
+    // loops always add. Each thread owns one (sample, channel) input plane - no races.
+    void BackwardDataCore(const Mat& srcGrad, const Mat& kernel, Mat& grad, bool /*accumulateGradient*/, Mat& /*workspace*/) override
+    {
+        const auto& inT = m_geometry->InputShape();
+        const auto& outT = m_geometry->OutputShape();
+        const auto& kernT = m_geometry->KernelShape();
+
+        long inW = (long) inT[0], inH = (long) inT[1], inC = (long) inT[2];
+        long outW = (long) outT[0], outH = (long) outT[1];
+        long kernW = (long) kernT[0], kernH = (long) kernT[1];
+        long strideW = (long) m_geometry->GetStride(0), strideH = (long) m_geometry->GetStride(1);
+        long padW = (long) m_geometry->GetLowerPad(0), padH = (long) m_geometry->GetLowerPad(1);
+
+        const ElemType* srcGradPtr = srcGrad.Data();
+        const ElemType* kernPtr = kernel.Data();
+        ElemType* gradPtr = grad.Data();
+        long batchSize = (long) srcGrad.GetNumCols();
+
+#pragma omp parallel for
+        for (long nc = 0; nc < batchSize * inC; nc++)
+        {
+            long n = nc / inC;
+            long c = nc % inC;
+            const ElemType* srcGradPlane = srcGradPtr + n * outW * outH * inC + c * outW * outH;
+            const ElemType* kernPlane = kernPtr + c * kernW * kernH;
+            ElemType* gradPlane = gradPtr + n * inW * inH * inC + c * inW * inH;
+            for (long yo = 0; yo < outH; yo++)
+            {
+                long yBase = yo * strideH - padH;
+                for (long xo = 0; xo < outW; xo++)
+                {
+                    long xBase = xo * strideW - padW;
+                    ElemType g = srcGradPlane[yo * outW + xo];
+                    for (long ky = 0; ky < kernH; ky++)
+                    {
+                        long yi = yBase + ky;
+                        if (yi < 0 || yi >= inH)
+                            continue;
+                        for (long kx = 0; kx < kernW; kx++)
+                        {
+                            long xi = xBase + kx;
+                            if (xi < 0 || xi >= inW)
+                                continue;
+                            gradPlane[yi * inW + xi] += g * kernPlane[ky * kernW + kx];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Accumulates each kernel plane from its channel across the whole batch. One channel per
+    // thread; the per-channel kernel planes are disjoint, so again no races.
+    void BackwardKernelCore(const Mat& srcGrad, const Mat& in, Mat& kernelGrad, bool /*accumulateGradient*/, bool /*allowReuse*/, Mat& /*workspace*/) override
+    {
+        const auto& inT = m_geometry->InputShape();
+        const auto& outT = m_geometry->OutputShape();
+        const auto& kernT = m_geometry->KernelShape();
+
+        long inW = (long) inT[0], inH = (long) inT[1], inC = (long) inT[2];
+        long outW = (long) outT[0], outH = (long) outT[1];
+        long kernW = (long) kernT[0], kernH = (long) kernT[1];
+        long strideW = (long) m_geometry->GetStride(0), strideH = (long) m_geometry->GetStride(1);
+        long padW = (long) m_geometry->GetLowerPad(0), padH = (long) m_geometry->GetLowerPad(1);
+
+        const ElemType* srcGradPtr = srcGrad.Data();
+        const ElemType* inPtr = in.Data();
+        ElemType* kernGradPtr = kernelGrad.Data();
+        long batchSize = (long) srcGrad.GetNumCols();
+
+#pragma omp parallel for
+        for (long c = 0; c < inC; c++)
+        {
+            ElemType* kernGradPlane = kernGradPtr + c * kernW * kernH;
+            for (long n = 0; n < batchSize; n++)
+            {
+                const ElemType* srcGradPlane = srcGradPtr + n * outW * outH * inC + c * outW * outH;
+                const ElemType* inPlane = inPtr + n * inW * inH * inC + c * inW * inH;
+                for (long yo = 0; yo < outH; yo++)
+                {
+                    long yBase = yo * strideH - padH;
+                    for (long xo = 0; xo < outW; xo++)
+                    {
+                        long xBase = xo * strideW - padW;
+                        ElemType g = srcGradPlane[yo * outW + xo];
+                        for (long ky = 0; ky < kernH; ky++)
+                        {
+                            long yi = yBase + ky;
+                            if (yi < 0 || yi >= inH)
+                                continue;
+                            for (long kx = 0; kx < kernW; kx++)
+                            {
+                                long xi = xBase + kx;
+                                if (xi < 0 || xi >= inW)
+                                    continue;
+                                kernGradPlane[ky * kernW + kx] += g * inPlane[yi * inW + xi];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    static bool IsSupported(DEVICEID_TYPE deviceId, ConvolveGeometryPtr geometry)
+    {
+        if (deviceId >= 0)
+            return false;
+        const auto& inT = geometry->InputShape();
+        const auto& kernT = geometry->KernelShape();
+        if (inT.GetRank() != 3 || kernT.GetRank() != 3 || kernT[2] != 1)
+            return false;
+        // Depthwise means: spatial dimensions shared, one distinct kernel per channel
+        // (sharing disabled along the channel dimension), channels mapped 1:1.
+        const auto& sharing = geometry->Sharing();
+        if (sharing.size() != 3 || !sharing[0] || !sharing[1] || sharing[2])
+            return false;
+        return geometry->GetStride(2) == 1 &&
+               geometry->GetMapCount(0) == 1 && geometry->GetMapCount(1) == 1 && geometry->GetMapCount(2) == 1;
+    }
+};
+
 template <class ElemType>
 std::unique_ptr<ConvolutionEngine<ElemType>> ConvolutionEngine<ElemType>::Create(ConvolveGeometryPtr geometry, DEVICEID_TYPE deviceId,
                                                                                  ImageLayoutKind imageLayout, size_t maxTempMemSizeInSamples, PoolKind poolKind,
@@ -886,6 +1486,32 @@ std::unique_ptr<ConvolutionEngine<ElemType>> ConvolutionEngine<ElemType>::Create
         return CuDnnConvolutionEngineFactory<ElemType>::Create(geometry, deviceId, imageLayout, maxTempMemSizeInSamples, poolKind, forceDeterministicAlgorithms, poolIncludePad);
     }
 
+    if (isEnabled(ConvolutionEngineKind::Depthwise) && DepthwiseConvolutionEngine<ElemType>::IsSupported(deviceId, geometry))
+    {
+        if (GetMathLibTraceLevel() > 0)
+            fprintf(stderr, "%lsusing depthwise convolution engine for geometry: %s.\n", logPrefix.c_str(), engStr.c_str());
+
+        return std::make_unique<DepthwiseConvolutionEngine<ElemType>>(geometry, deviceId, imageLayout, maxTempMemSizeInSamples, poolKind, poolIncludePad);
+    }
+
+    if (isEnabled(ConvolutionEngineKind::Winograd) && WinogradConvolutionEngine<ElemType>::IsSupported(deviceId, geometry))
+    {
+        if (GetMathLibTraceLevel() > 0)
+            fprintf(stderr, "%lsusing Winograd convolution engine for geometry: %s.\n", logPrefix.c_str(), engStr.c_str());
+
+        return std::make_unique<WinogradConvolutionEngine<ElemType>>(geometry, deviceId, imageLayout, maxTempMemSizeInSamples, poolKind, poolIncludePad);
+    }
+
+    // The direct engine is a faster special case of the CPU GEMM path (and falls back to the
+    // GEMM machinery for the backward passes), so it is gated by the same engine flag.
+    if (isEnabled(ConvolutionEngineKind::Gemm) && DirectConvolutionEngine<ElemType>::IsSupported(deviceId, geometry))
+    {
+        if (GetMathLibTraceLevel() > 0)
+            fprintf(stderr, "%lsusing direct convolution engine for geometry: %s.\n", logPrefix.c_str(), engStr.c_str());
+
+        return std::make_unique<DirectConvolutionEngine<ElemType>>(geometry, deviceId, imageLayout, maxTempMemSizeInSamples, poolKind, poolIncludePad);
+    }
+
     if (isEnabled(ConvolutionEngineKind::Gemm) && GemmConvolutionEngine<ElemType>::IsSupported(deviceId, geometry))
     {
         if (GetMathLibTraceLevel() > 0)
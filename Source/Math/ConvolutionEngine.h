@@ -22,8 +22,10 @@ enum class ConvolutionEngineKind
     CuDnn     = 1 << 1, // cuDNN, works only for 2D/3D convos with full sharing.
     Legacy    = 1 << 2, // Legacy, for backwards compatibility. REVIEW alexeyk: implement sparse version and remove Legacy altogether.
     Gemm      = 1 << 3, // Uses convolution unrolling+GEMM technique. Works only for convos with full sharing.
+    Winograd  = 1 << 4, // Winograd F(2x2,3x3) fast algorithm, CPU only. Works only for 3x3 stride-1 convos with full sharing.
+    Depthwise = 1 << 5, // Depthwise (per-channel) convolutions, CPU only. Works only for 2D convos with one filter per input channel.
 
-    All       = Reference | CuDnn | Legacy | Gemm
+    All       = Reference | CuDnn | Legacy | Gemm | Winograd | Depthwise
 };
 
 enum class PoolKind
@@ -47,6 +49,11 @@ public:
 
     void Forward(const Mat& in, const Mat& kernel, Mat& out, Mat& workspace);
 
+    // Fused forward convolution + per-output-map bias + rectifier, out = Relu(conv(in) + bias).
+    // Only engines whose ImplementsFusedBiasActivation() returns true provide this; callers must
+    // check that flag and fall back to Forward() plus an explicit bias/activation pass otherwise.
+    void ForwardBiasActivation(const Mat& in, const Mat& kernel, const Mat& bias, Mat& out, Mat& workspace);
+
     void BackwardData(const Mat& srcGrad, const Mat& kernel, Mat& grad, bool accumulateGradient, Mat& workspace);
 
     void BackwardKernel(const Mat& srcGrad, const Mat& in, Mat& kernelGrad, bool accumulateGradient, bool allowReuse, Mat& workspace);
@@ -74,6 +81,13 @@ public:
 
     virtual bool ImplementsGradientOverwriteOptimization() const { return false; }
 
+    virtual bool ImplementsFusedBiasActivation() const { return false; }
+
+    // upper bound, in elements per minibatch sample, on the workspace this engine will request in
+    // Forward()/BackwardData()/BackwardKernel(); 0 if not known up front. Used to pre-size the
+    // shared workspace arena in the matrix pool so that the first minibatches need not grow it.
+    virtual size_t MaxWorkspaceSizePerSample() const { return 0; }
+
 protected:
     ConvolutionEngine(ConvolveGeometryPtr geometry, DEVICEID_TYPE deviceId, ImageLayoutKind imageLayout, size_t maxTempMemSizeInSamples, PoolKind poolKind, bool poolIncludePad = false)
         : m_geometry(geometry), m_deviceId(deviceId), m_imageLayout(imageLayout), m_maxTempMemSizeInSamples(maxTempMemSizeInSamples), m_poolKind(poolKind), m_poolIncludePad(poolIncludePad)
@@ -87,6 +101,11 @@ protected:
 
     virtual void ForwardCore(const Mat& in, const Mat& kernel, Mat& out, Mat& workspace) = 0;
 
+    virtual void ForwardBiasActivationCore(const Mat& /*in*/, const Mat& /*kernel*/, const Mat& /*bias*/, Mat& /*out*/, Mat& /*workspace*/)
+    {
+        LogicError("ForwardBiasActivation is not implemented by this convolution engine.");
+    }
+
     virtual void BackwardDataCore(const Mat& srcGrad, const Mat& kernel, Mat& grad, bool accumulateGradient, Mat& workspace) = 0;
 
     virtual void BackwardKernelCore(const Mat& srcGrad, const Mat& in, Mat& kernelGrad, bool accumulateGradient, bool allowReuse, Mat& workspace) = 0;
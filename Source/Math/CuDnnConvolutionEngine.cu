@@ -9,6 +9,11 @@
 #include "GPUMatrix.h"
 #include <typeinfo>
 #include <typeindex>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <mutex>
 #include "CuDnnCommon.h"
 
 template <>
@@ -180,6 +185,36 @@ private:
     cudnnPoolingDescriptor_t m_pool;
 };
 
+class CuDnnActivation
+{
+public:
+    CuDnnActivation(cudnnActivationMode_t mode)
+        : m_activation(nullptr)
+    {
+        CUDNN_CALL(cudnnCreateActivationDescriptor(&m_activation));
+        CUDNN_CALL(cudnnSetActivationDescriptor(m_activation, mode, CUDNN_PROPAGATE_NAN, 0.0));
+    }
+
+    ~CuDnnActivation()
+    {
+        if (m_activation != nullptr)
+        {
+            cudnnDestroyActivationDescriptor(m_activation);
+            m_activation = nullptr;
+        }
+    }
+
+    operator cudnnActivationDescriptor_t() const
+    {
+        return m_activation;
+    }
+
+    DISABLE_COPY_AND_MOVE(CuDnnActivation);
+
+private:
+    cudnnActivationDescriptor_t m_activation;
+};
+
 enum class AutotuningState : int
 {
     Init = 0,          // initial state
@@ -187,6 +222,95 @@ enum class AutotuningState : int
     Running = 2        // done tuning, no long performing auto-tuning, code is running normally
 };
 
+// Persistent cache of convolution autotuning results, so that steady-state jobs skip the
+// expensive cudnnFind* calls entirely. Enabled by pointing the CNTK_CUDNN_AUTOTUNE_CACHE
+// environment variable at a file. Entries are keyed by GPU model, cuDNN version, data type,
+// convolution geometry and minibatch size, so the same file can be shared by heterogeneous
+// workers and simply yields a miss (and a re-tune) when anything relevant changed.
+// The cache is strictly best-effort: an unreadable or unwritable file never fails training.
+class CuDnnAutotuneCache
+{
+public:
+    static CuDnnAutotuneCache& Instance()
+    {
+        static CuDnnAutotuneCache instance;
+        return instance;
+    }
+
+    bool Enabled() const { return !m_path.empty(); }
+
+    bool TryGet(const std::string& key, int& algo, size_t& workspaceSize)
+    {
+        if (!Enabled() || key.empty())
+            return false;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end())
+            return false;
+        algo = it->second.algo;
+        workspaceSize = it->second.workspaceSize;
+        return true;
+    }
+
+    void Put(const std::string& key, int algo, size_t workspaceSize)
+    {
+        if (!Enabled() || key.empty())
+            return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry entry = { algo, workspaceSize };
+        if (!m_entries.insert(std::make_pair(key, entry)).second)
+            return; // already known, and thus already in the file
+        // append-only line writes keep the file consistent when several workers share it
+        FILE* f = fopen(m_path.c_str(), "ab");
+        if (f == nullptr)
+            return;
+        fprintf(f, "%s %d %zu\n", key.c_str(), algo, workspaceSize);
+        fclose(f);
+    }
+
+private:
+    CuDnnAutotuneCache()
+    {
+        const char* path = getenv("CNTK_CUDNN_AUTOTUNE_CACHE");
+        if (path == nullptr || *path == 0)
+            return;
+        m_path = path;
+        std::ifstream file(m_path);
+        std::string key;
+        int algo;
+        size_t workspaceSize;
+        while (file >> key >> algo >> workspaceSize)
+        {
+            Entry entry = { algo, workspaceSize };
+            m_entries[key] = entry;
+        }
+    }
+
+    struct Entry
+    {
+        int algo;
+        size_t workspaceSize;
+    };
+
+    std::string m_path;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::mutex m_mutex;
+};
+
+// GPU model and cuDNN version part of the cache key. Empty string (e.g. when device
+// properties cannot be read) disables caching for this engine.
+static std::string AutotuneDeviceKey(DEVICEID_TYPE deviceId)
+{
+    cudaDeviceProp props = {0};
+    if (deviceId < 0 || (cudaGetDeviceProperties(&props, deviceId) | cudaGetLastError()) != cudaSuccess)
+        return "";
+    std::ostringstream key;
+    for (const char* p = props.name; *p != 0; p++)
+        key << (*p == ' ' ? '_' : *p); // keys must be whitespace-free
+    key << "_sm" << props.major << props.minor << "_cudnn" << cudnnGetVersion();
+    return key.str();
+}
+
 template <class ElemType>
 class CuDnnConvolutionEngine : public ConvolutionEngine<ElemType>
 {
@@ -215,14 +339,27 @@ public:
             inputDims[dim_size - 1 - i] = inShape[input_size - 1 - i];
             outputDims[dim_size - 1 - i] = outShape[input_size - 1 - i];
         }
-        inputDims[0] = inShape[0]; 
-        outputDims[0] = outShape[0]; 
+        inputDims[0] = inShape[0];
+        outputDims[0] = outShape[0];
         m_inT.Set(TensorShape(inputDims), m_dataType);
         m_outT.Set(TensorShape(outputDims), m_dataType);
+
+        if (CuDnnAutotuneCache::Instance().Enabled())
+            m_autotuneDeviceKey = AutotuneDeviceKey(deviceId);
     }
 
     virtual bool ImplementsGradientOverwriteOptimization() const override { return true; }
 
+    // The fused conv+bias+activation entry point was added in cuDNN 7.
+    virtual bool ImplementsFusedBiasActivation() const override
+    {
+#if CUDNN_MAJOR >= 7
+        return true;
+#else
+        return false;
+#endif
+    }
+
 protected:
     using Base::m_geometry;
     using Base::m_deviceId;
@@ -294,11 +431,48 @@ protected:
             }
             return err; 
         }; 
-        FindBestAlgo(batchSize, m_fwdAlgo, workspaceSizeFinder, deterministicFinder, finder, staticFinder, workspace);
+        FindBestAlgo(batchSize, m_fwdAlgo, workspaceSizeFinder, deterministicFinder, finder, staticFinder, workspace, "fwd");
         // Perform forward convolution operation.
         CUDNN_CALL(cudnnConvolutionForward(*m_cudnn, &C::One, m_inT, ptr(in), *m_kernelT, ptr(kernel), *m_conv, m_fwdAlgo.selectedAlgo, ptr(workspace), workspace.BufferSize(), &C::Zero, m_outT, ptr(out)));
     }
 
+    // Computes out = Relu(conv(in) + bias) in a single cuDNN call, saving the two extra kernel
+    // launches and intermediate reads/writes of separate bias-add and activation passes.
+    // cuDNN supports the fused entry point only with the IMPLICIT_PRECOMP_GEMM algorithm, so
+    // there is no auto-tuning here - the workspace requirement of that one algorithm is queried
+    // directly.
+    void ForwardBiasActivationCore(const Mat& in, const Mat& kernel, const Mat& bias, Mat& out, Mat& workspace) override
+    {
+#if CUDNN_MAJOR >= 7
+        size_t batchSize = in.GetNumCols();
+        m_inT.UpdateBatchSize(batchSize);
+        m_outT.UpdateBatchSize(batchSize);
+        if (m_biasT == nullptr)
+        {
+            // The bias holds one value per output feature map: descriptor [1 x K x 1 x ... x 1]
+            // of the same rank as the output tensor.
+            const auto& inShape = m_geometry->InputShape();
+            SmallVector<size_t> biasDims(std::max(inShape.GetRank(), (size_t)3), 1);
+            biasDims[biasDims.size() - 1] = m_geometry->GetMapCount(inShape.GetRank() - 1);
+            m_biasT = std::make_unique<CuDnnTensor>(TensorShape(biasDims), m_dataType);
+            m_activation = std::make_unique<CuDnnActivation>(CUDNN_ACTIVATION_RELU);
+        }
+        size_t workSize = 0;
+        CUDNN_CALL(cudnnGetConvolutionForwardWorkspaceSize(*m_cudnn, m_inT, *m_kernelT, *m_conv, m_outT,
+                                                           CUDNN_CONVOLUTION_FWD_ALGO_IMPLICIT_PRECOMP_GEMM, &workSize));
+        if (workspace.BufferSize() < workSize)
+            workspace.Resize((workSize + sizeof(ElemType) - 1) / sizeof(ElemType), 1, 0, false);
+        // The z term of y = act(alpha1 * conv(x) + alpha2 * z + bias) is disabled by passing
+        // alpha2 = 0 with z aliasing the output.
+        CUDNN_CALL(cudnnConvolutionBiasActivationForward(*m_cudnn, &C::One, m_inT, ptr(in), *m_kernelT, ptr(kernel), *m_conv,
+                                                         CUDNN_CONVOLUTION_FWD_ALGO_IMPLICIT_PRECOMP_GEMM, ptr(workspace), workspace.BufferSize(),
+                                                         &C::Zero, m_outT, ptr(out), *m_biasT, ptr(bias), *m_activation, m_outT, ptr(out)));
+#else
+        UNUSED(in); UNUSED(kernel); UNUSED(bias); UNUSED(out); UNUSED(workspace);
+        LogicError("ForwardBiasActivation requires cuDNN 7 or higher.");
+#endif
+    }
+
     void BackwardDataCore(const Mat& srcGrad, const Mat& kernel, Mat& grad, bool accumulateGradient, Mat& workspace) override
     {
         size_t batchSize = srcGrad.GetNumCols();
@@ -356,7 +530,7 @@ protected:
             }
             return err;
         }; 
-        FindBestAlgo(batchSize, m_backDataAlgo, workspaceSizeFinder, deterministicFinder, finder, staticFinder, workspace);
+        FindBestAlgo(batchSize, m_backDataAlgo, workspaceSizeFinder, deterministicFinder, finder, staticFinder, workspace, "bwdData");
         // Compute gradients with respect to the output tensor (data).
         CUDNN_CALL(cudnnConvolutionBackwardData(*m_cudnn, &C::One, *m_kernelT, ptr(kernel), m_outT, ptr(srcGrad), *m_conv, m_backDataAlgo.selectedAlgo, ptr(workspace), workspace.BufferSize(), accumulateGradient ? &C::One : &C::Zero, m_inT, ptr(grad)));
     }
@@ -418,7 +592,7 @@ protected:
             }
             return err;
         }; 
-        FindBestAlgo(batchSize, m_backFiltAlgo, workspaceSizeFinder, deterministicFinder, finder, staticFinder, workspace);
+        FindBestAlgo(batchSize, m_backFiltAlgo, workspaceSizeFinder, deterministicFinder, finder, staticFinder, workspace, "bwdFilter");
         // Compute gradients with respect to the output tensor (data).
         CUDNN_CALL(cudnnConvolutionBackwardFilter(*m_cudnn, &C::One, m_inT, ptr(in), m_outT, ptr(srcGrad), *m_conv, m_backFiltAlgo.selectedAlgo, ptr(workspace), workspace.BufferSize(), accumulateGradient ? &C::One : &C::Zero, *m_kernelT, ptr(kernelGrad)));
     }
@@ -460,8 +634,36 @@ private:
 
     static const int MaxAlgoCount = 10;
 
+    // Full autotune cache key for this engine's geometry at the given minibatch size.
+    // Empty when caching is disabled or device properties were unavailable.
+    std::string AutotuneCacheKey(const char* kindTag, size_t batchSize) const
+    {
+        if (m_autotuneDeviceKey.empty())
+            return "";
+        std::ostringstream key;
+        key << m_autotuneDeviceKey << '|' << (m_dataType == CUDNN_DATA_DOUBLE ? 'd' : 'f') << '|'
+            << kindTag << (m_forceDeterministicAlgorithms ? "det" : "") << '|' << batchSize;
+        auto appendShape = [&key](const TensorShape& shape)
+        {
+            key << '|';
+            for (size_t i = 0; i < shape.GetRank(); i++)
+                key << (i == 0 ? "" : "x") << shape[i];
+        };
+        appendShape(m_geometry->InputShape());
+        appendShape(m_geometry->KernelShape());
+        appendShape(m_geometry->OutputShape());
+        appendShape(m_geometry->Stride());
+        appendShape(m_geometry->LowerPad());
+        appendShape(m_geometry->UpperPad());
+        appendShape(m_geometry->MapCount());
+        key << '|';
+        for (bool p : m_geometry->AutoPad()) // auto-padding changes the effective pads
+            key << (p ? '1' : '0');
+        return key.str();
+    }
+
     template <typename TAlgo, typename TWorkspaceSizeFinder, typename TDeterministicFinder, typename TFinder, typename TStaticFinder>
-    void FindBestAlgo(size_t batchSize, TAlgo& algo, TWorkspaceSizeFinder workspaceSizeFinder, TDeterministicFinder deterministicFinder, TFinder finder, TStaticFinder staticFinder, Mat& workspace)
+    void FindBestAlgo(size_t batchSize, TAlgo& algo, TWorkspaceSizeFinder workspaceSizeFinder, TDeterministicFinder deterministicFinder, TFinder finder, TStaticFinder staticFinder, Mat& workspace, const char* kindTag)
     {
         m_inT.UpdateBatchSize(batchSize);
         m_outT.UpdateBatchSize(batchSize);
@@ -492,8 +694,25 @@ private:
         // or in the special case when m_forceDeterministicAlgorithms, we allocate some memory and use the deterministic algorithm 
         if (algo.autotuningState == AutotuningState::Init)
         {
-            // find workspace size needed for finderEx and deterministic algorithm 
-            CUDNN_CALL(workspaceSizeFinder()); 
+            // a persisted autotuning result lets us skip the expensive cudnnFind* calls entirely
+            int cachedAlgo;
+            size_t cachedWorkspaceSize;
+            if (CuDnnAutotuneCache::Instance().TryGet(AutotuneCacheKey(kindTag, batchSize), cachedAlgo, cachedWorkspaceSize))
+            {
+                algo.selectedAlgo = (decltype(algo.selectedAlgo))cachedAlgo;
+                algo.maxAlgo = algo.selectedAlgo;
+                algo.AlgoWorkspaceSize = cachedWorkspaceSize;
+                algo.MBSizeForCurrentAlgo = batchSize;
+                algo.MBSizeForCurrentWorkspace = batchSize;
+                algo.maxMBSizeSeen = batchSize;
+                algo.autotuningState = AutotuningState::Running;
+                if (workspace.BufferSize() < cachedWorkspaceSize)
+                    workspace.Resize((cachedWorkspaceSize + sizeof(ElemType) - 1) / sizeof(ElemType), 1, 0, false);
+                return;
+            }
+
+            // find workspace size needed for finderEx and deterministic algorithm
+            CUDNN_CALL(workspaceSizeFinder());
             if (m_forceDeterministicAlgorithms)
             {
                 workspace.Resize((algo.DeterministicAlgoWorkspaceSize + sizeof(ElemType) - 1) / sizeof(ElemType), 1, 0, false);
@@ -502,8 +721,9 @@ private:
                 algo.MBSizeForCurrentAlgo = batchSize;
                 algo.selectedAlgo = (*algoPerf).algo;               // deterministic algorithm is the first in the list  
                 algo.maxAlgo = algo.selectedAlgo;
-                algo.autotuningState = AutotuningState::Running;    // no further need for tuning since this is deterministic, directly enter running state 
+                algo.autotuningState = AutotuningState::Running;    // no further need for tuning since this is deterministic, directly enter running state
                 algo.AlgoWorkspaceSize = (*algoPerf).memory;
+                CuDnnAutotuneCache::Instance().Put(AutotuneCacheKey(kindTag, batchSize), (int)algo.selectedAlgo, algo.AlgoWorkspaceSize);
             }
             else
             {
@@ -553,7 +773,8 @@ private:
                     workspace.Resize((curSize + sizeof(ElemType) - 1) / sizeof(ElemType), 1, 0, false);
                 else
                     workspace.Resize((algo.AlgoWorkspaceSize + sizeof(ElemType) - 1) / sizeof(ElemType), 1, 0, false);
-            } 
+                CuDnnAutotuneCache::Instance().Put(AutotuneCacheKey(kindTag, batchSize), (int)algo.selectedAlgo, algo.AlgoWorkspaceSize);
+            }
             catch (...) 
             {   // when it fails, it means accumulate is on, and allocation of temporary buffer failed. We resize to curSize and try again
                 fprintf(stderr, "Retrying with reduced workspace memory for convolution\n"); 
@@ -569,7 +790,8 @@ private:
                     algo.maxAlgo = algo.selectedAlgo;
                     algo.autotuningState = AutotuningState::Running;
                     algo.AlgoWorkspaceSize = (*res).memory;
-                } 
+                    CuDnnAutotuneCache::Instance().Put(AutotuneCacheKey(kindTag, batchSize), (int)algo.selectedAlgo, algo.AlgoWorkspaceSize);
+                }
                 catch (...) 
                 {   // fails again, let's fall back to cudnnGet
                     fprintf(stderr, "Fall back to use static finder to get the algorithm for convolution\n");
@@ -646,6 +868,9 @@ private:
     std::unique_ptr<CuDnnConv> m_conv;
     // Pooling specific.
     std::unique_ptr<CuDnnPool> m_pool;
+    // Fused conv+bias+activation specific, created lazily on first fused call.
+    std::unique_ptr<CuDnnTensor> m_biasT;
+    std::unique_ptr<CuDnnActivation> m_activation;
 
     ConvAlgoInfo<cudnnConvolutionFwdAlgoPerf_t> m_fwdAlgo;
     ConvAlgoInfo<cudnnConvolutionBwdDataAlgoPerf_t> m_backDataAlgo;
@@ -653,6 +878,9 @@ private:
 
     // Flag indicating whether only deterministic algorithms should be used.
     bool m_forceDeterministicAlgorithms;
+
+    // GPU model/cuDNN version prefix of the autotune cache key; empty when caching is off.
+    std::string m_autotuneDeviceKey;
 };
 
 template <class ElemType>
@@ -9,9 +9,9 @@
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
-    DataTransfererPtr CreatePrefetchDataTransferer(int deviceId)
+    DataTransfererPtr CreatePrefetchDataTransferer(int deviceId, size_t numStagingBuffers)
     {
-        return std::make_shared<PrefetchGPUDataTransferer>(deviceId);
+        return std::make_shared<PrefetchGPUDataTransferer>(deviceId, numStagingBuffers);
     }
 
 } } }
@@ -44,6 +44,16 @@ namespace Microsoft { namespace MSR { namespace CNTK {
         // Asynchronously starts copying data from cpu into gpu buffer.
         virtual void CopyCPUToGPUAsync(const void* cpuBuffer, size_t numElements, size_t elementSize, void* gpuBuffer) = 0;
 
+        // Asynchronously starts copying data from a (possibly pageable) cpu buffer into a gpu buffer,
+        // staging through an implementation-owned ring of pinned buffers when the implementation has one;
+        // in that case the cpu buffer can be reused as soon as this call returns, and several staged copies
+        // can be kept in flight. Implementations without staging fall back to a direct async copy, where the
+        // cpu buffer must stay valid until WaitForCopyCPUToGPU.
+        virtual void CopyCPUToGPUStagedAsync(const void* cpuBuffer, size_t numElements, size_t elementSize, void* gpuBuffer)
+        {
+            CopyCPUToGPUAsync(cpuBuffer, numElements, elementSize, gpuBuffer);
+        }
+
         // Records event that copies were started on internal stream.
         virtual void RecordCPUToGPUCopy() = 0;
 
@@ -64,5 +74,7 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 
     typedef std::shared_ptr<DataTransferer> DataTransfererPtr;
 
-    MATH_API DataTransfererPtr CreatePrefetchDataTransferer(int deviceId);
+    // numStagingBuffers controls how many pinned staging buffers (and thus how many in-flight
+    // host-to-device minibatch copies) the prefetch transferer keeps; see PinnedStagingRing.
+    MATH_API DataTransfererPtr CreatePrefetchDataTransferer(int deviceId, size_t numStagingBuffers = 4);
 }}}
@@ -2,6 +2,7 @@
 #include "Basics.h"
 #include "GPUDataTransferer.h"
 #include "GPUMatrix.h"
+#include "CUDAPageLockedMemAllocator.h"
 
 #pragma comment(lib, "cudart.lib")
 
@@ -47,6 +48,79 @@ static
     }
 }
 
+//// PinnedStagingRing
+
+PinnedStagingRing::PinnedStagingRing(int deviceId, size_t numBuffers)
+    : m_current(0),
+      m_deviceId(deviceId)
+{
+    if (numBuffers == 0)
+        InvalidArgument("PinnedStagingRing requires at least one staging buffer.");
+
+    PrepareDevice(m_deviceId);
+    m_slots.resize(numBuffers);
+    for (auto& slot : m_slots)
+    {
+        slot.buffer = nullptr;
+        slot.capacity = 0;
+        slot.copyInFlight = false;
+        // Same flags as the prefetch transferer events: blocking sync was never a problem in reading prefetch.
+        cudaEventCreateWithFlags(&slot.copyDone, cudaEventDisableTiming | cudaEventBlockingSync) || "cudaEventCreateWithFlags failed (PinnedStagingRing ctor)";
+    }
+}
+
+PinnedStagingRing::~PinnedStagingRing()
+{
+    try
+    {
+        PrepareDevice(m_deviceId);
+    }
+    catch (...)
+    {
+        // the error is already logged
+        return;
+    }
+
+    for (auto& slot : m_slots)
+    {
+        if (slot.copyInFlight)
+            cudaEventSynchronize(slot.copyDone);
+        cudaEventDestroy(slot.copyDone);
+        if (slot.buffer != nullptr)
+            CUDAPageLockedMemAllocator::Free(slot.buffer, m_deviceId);
+    }
+}
+
+void* PinnedStagingRing::GetNextBuffer(size_t size)
+{
+    PrepareDevice(m_deviceId);
+
+    m_current = (m_current + 1) % m_slots.size();
+    Slot& slot = m_slots[m_current];
+    if (slot.copyInFlight)
+    {
+        // Only blocks when all slots have copies in flight, i.e. the reader ran a full ring ahead.
+        cudaEventSynchronize(slot.copyDone) || "cudaEventSynchronize failed (PinnedStagingRing)";
+        slot.copyInFlight = false;
+    }
+
+    if (slot.capacity < size)
+    {
+        if (slot.buffer != nullptr)
+            CUDAPageLockedMemAllocator::Free(slot.buffer, m_deviceId);
+        slot.buffer = CUDAPageLockedMemAllocator::Malloc(size, m_deviceId);
+        slot.capacity = size;
+    }
+    return slot.buffer;
+}
+
+void PinnedStagingRing::RecordCopyScheduled(cudaStream_t stream)
+{
+    Slot& slot = m_slots[m_current];
+    cudaEventRecord(slot.copyDone, stream) || "cudaEventRecord failed (PinnedStagingRing)";
+    slot.copyInFlight = true;
+}
+
 //// Base class for different data transferers.
 GranularGPUDataTransferer::GranularGPUDataTransferer(int deviceId, const cudaStream_t& fetchStream, const cudaStream_t& assignStream, bool blocking)
     : m_fetchStream(fetchStream),
@@ -200,11 +274,22 @@ void GPUDataTransferer::WaitForCopyCPUToGPUAsync()
 
 /// PrefetchGPUDataTransferer
 
-PrefetchGPUDataTransferer::PrefetchGPUDataTransferer(int deviceId) : GranularGPUDataTransferer(deviceId, nullptr, nullptr, true)
+PrefetchGPUDataTransferer::PrefetchGPUDataTransferer(int deviceId, size_t numStagingBuffers)
+    : GranularGPUDataTransferer(deviceId, nullptr, nullptr, true),
+      m_stagingRing(new PinnedStagingRing(deviceId, numStagingBuffers))
 {
      cudaStreamCreateWithFlags(&m_stream, cudaStreamNonBlocking) || "cudaStreamCreateWithFlags failed (PrefetchGPUDataTransferer ctor)";
 }
 
+void PrefetchGPUDataTransferer::CopyCPUToGPUStagedAsync(const void* cpuBuffer, size_t numElements, size_t elementSize, void* gpuBuffer)
+{
+    size_t totalSize = numElements * elementSize;
+    void* staging = m_stagingRing->GetNextBuffer(totalSize);
+    memcpy(staging, cpuBuffer, totalSize);
+    CopyCPUToGPUAsync(staging, numElements, elementSize, gpuBuffer);
+    m_stagingRing->RecordCopyScheduled(GetAssignStream());
+}
+
 PrefetchGPUDataTransferer::~PrefetchGPUDataTransferer()
 {
     try
@@ -21,8 +21,57 @@
 
 #include "DataTransferer.h"
 
+#include <vector>
+
 namespace Microsoft { namespace MSR { namespace CNTK {
 
+// -----------------------------------------------------------------------
+// PinnedStagingRing -- ring of page-locked staging buffers for deep prefetch
+// -----------------------------------------------------------------------
+// A single staging buffer per transfer direction means the host-to-device copy of the next
+// minibatch cannot be scheduled until the previous one has released the buffer, so a reader
+// that runs ahead still exposes copy time. The ring owns a configurable number of page-locked
+// buffers, each paired with a CUDA event tracking the last copy staged from it:
+// GetNextBuffer() rotates to the next slot, waits for that slot's previous copy (which only
+// blocks when the reader laps the device) and grows the slot's allocation on demand;
+// RecordCopyScheduled() marks the async copy issued from the buffer just handed out.
+// With N slots a prefetching reader can keep N host-to-device copies in flight.
+class MATH_API PinnedStagingRing
+{
+public:
+    PinnedStagingRing(int deviceId, size_t numBuffers);
+    ~PinnedStagingRing();
+
+    // Returns a pinned buffer of at least 'size' bytes, waiting if the previous copy staged
+    // from this slot has not completed yet.
+    void* GetNextBuffer(size_t size);
+
+#ifndef CPUONLY
+    // Record on 'stream' that an async copy from the buffer last returned has been scheduled.
+    void RecordCopyScheduled(cudaStream_t stream);
+
+private:
+    struct Slot
+    {
+        void* buffer;
+        size_t capacity;
+        cudaEvent_t copyDone;
+        bool copyInFlight;
+    };
+
+#pragma warning(push)
+#pragma warning(disable : 4251) // Using std::vector on the dll boundary.
+    std::vector<Slot> m_slots;
+#pragma warning(pop)
+    size_t m_current;
+#endif // !CPUONLY
+
+private:
+    int m_deviceId;
+
+    DISABLE_COPY_AND_MOVE(PinnedStagingRing);
+};
+
 class MATH_API GranularGPUDataTransferer : public DataTransferer
 {
 public:
@@ -132,13 +181,23 @@ private:
 class PrefetchGPUDataTransferer : public GranularGPUDataTransferer
 {
 public:
-    PrefetchGPUDataTransferer(int deviceId);
+    PrefetchGPUDataTransferer(int deviceId, size_t numStagingBuffers = 4);
     ~PrefetchGPUDataTransferer();
 
+    // Stage the (possibly pageable) cpu buffer into the next slot of the pinned ring and
+    // schedule the device copy from there; the cpu buffer can be reused on return, and up to
+    // numStagingBuffers copies can be in flight before this blocks.
+    void CopyCPUToGPUStagedAsync(const void* cpuBuffer, size_t numElements, size_t elementSize, void* gpuBuffer) override;
+
 private:
 #ifndef CPUONLY
     cudaStream_t m_stream;
 
+#pragma warning(push)
+#pragma warning(disable : 4251) // Using std::unique pointer on the dll boundary.
+    std::unique_ptr<PinnedStagingRing> m_stagingRing;
+#pragma warning(pop)
+
     virtual const cudaStream_t& GetAssignStream() const override
     {
         return m_stream;
@@ -19,14 +19,18 @@
 #include "device_launch_parameters.h"
 #include <cuda.h>
 #include <cuda_runtime.h>
+#include <cuda_fp16.h>
 #include <curand.h>
 #include <curand_kernel.h>
 #include "cublas_v2.h"
 #include <assert.h>
+#include <map>
 #include <memory>
+#include <mutex>
 #include "CntkBatchNormalization.cuh"
 #include "Convolution.cuh"
 #include "CuDnnRNN.h"
+#include "PerformanceProfiler.h"
 
 #pragma comment(lib, "cudart.lib") // instruct linker to reference these libs
 #pragma comment(lib, "cublas.lib")
@@ -63,6 +67,39 @@ cudaStream_t MATH_API GetStream()
     return t_stream;
 }
 
+// fp16 conversion helpers, e.g. for compressed NCCL reductions
+__global__ void _floatToHalf(const float* src, __half* dst, CUDA_LONG N)
+{
+    CUDA_LONG id = blockDim.x * blockIdx.x + threadIdx.x;
+    for (; id < N; id += blockDim.x * gridDim.x)
+        dst[id] = __float2half(src[id]);
+}
+
+__global__ void _halfToFloat(const __half* src, float* dst, CUDA_LONG N)
+{
+    CUDA_LONG id = blockDim.x * blockIdx.x + threadIdx.x;
+    for (; id < N; id += blockDim.x * gridDim.x)
+        dst[id] = __half2float(src[id]);
+}
+
+void MATH_API CudaFloatToHalf(const float* src, void* halfDst, size_t count, cudaStream_t stream)
+{
+    if (count == 0)
+        return;
+    CUDA_LONG N = (CUDA_LONG)count;
+    int blocksPerGrid = (int)ceil(1.0 * N / GridDim::maxThreadsPerBlock);
+    _floatToHalf<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(src, (__half*)halfDst, N);
+}
+
+void MATH_API CudaHalfToFloat(const void* halfSrc, float* dst, size_t count, cudaStream_t stream)
+{
+    if (count == 0)
+        return;
+    CUDA_LONG N = (CUDA_LONG)count;
+    int blocksPerGrid = (int)ceil(1.0 * N / GridDim::maxThreadsPerBlock);
+    _halfToFloat<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>((const __half*)halfSrc, dst, N);
+}
+
 // Helper macro patterns for elementwise methods
 #define DEF_ELEMWISE_INPLACE_FUNC(f)                                      \
     template <class ElemType>                                             \
@@ -163,6 +200,271 @@ SyncGuard::~SyncGuard()
     }
 }
 
+// -----------------------------------------------------------------------
+// MatrixStreamPool
+// -----------------------------------------------------------------------
+
+struct StreamPoolEntry
+{
+    cudaStream_t streams[MatrixStreamPool::MaxStreams];
+    cudaEvent_t events[MatrixStreamPool::MaxStreams];
+    bool initialized;
+};
+
+static StreamPoolEntry s_streamPool[MAX_GPUS] = {};
+static std::mutex s_streamPoolMutex;
+
+// Get the pool of the current device, creating its streams and events on first use.
+// NOTE: like the cuBLAS handles, these are never freed; CUDA cleans them up at process exit.
+static StreamPoolEntry& GetStreamPoolEntry()
+{
+    int deviceId = 0;
+    CUDA_CALL(cudaGetDevice(&deviceId));
+    StreamPoolEntry& entry = s_streamPool[deviceId];
+    if (!entry.initialized)
+    {
+        std::lock_guard<std::mutex> lock(s_streamPoolMutex);
+        if (!entry.initialized)
+        {
+            for (int i = 0; i < MatrixStreamPool::MaxStreams; i++)
+            {
+                // Non-blocking streams do not implicitly synchronize with the legacy default
+                // stream, so pooled work can overlap with work that is not slot-assigned.
+                CUDA_CALL(cudaStreamCreateWithFlags(&entry.streams[i], cudaStreamNonBlocking));
+                // Timing is not needed for dependency edges; disabling it makes events cheaper.
+                CUDA_CALL(cudaEventCreateWithFlags(&entry.events[i], cudaEventDisableTiming));
+            }
+            entry.initialized = true;
+        }
+    }
+    return entry;
+}
+
+MatrixStreamPool::StreamGuard::StreamGuard(int slot)
+{
+    m_prevStream = GetStream();
+    if (slot >= 0)
+        SetStream(GetStreamPoolEntry().streams[slot % MaxStreams]);
+}
+
+MatrixStreamPool::StreamGuard::~StreamGuard()
+{
+    SetStream(m_prevStream);
+}
+
+/*static*/ void MatrixStreamPool::RecordEvent(int slot)
+{
+    StreamPoolEntry& entry = GetStreamPoolEntry();
+    slot %= MaxStreams;
+    CUDA_CALL(cudaEventRecord(entry.events[slot], entry.streams[slot]));
+}
+
+/*static*/ void MatrixStreamPool::AddDependency(int slot, int producerSlot)
+{
+    StreamPoolEntry& entry = GetStreamPoolEntry();
+    CUDA_CALL(cudaStreamWaitEvent(entry.streams[slot % MaxStreams], entry.events[producerSlot % MaxStreams], 0));
+}
+
+/*static*/ void MatrixStreamPool::SynchronizeAll()
+{
+    int deviceId = 0;
+    CUDA_CALL(cudaGetDevice(&deviceId));
+    StreamPoolEntry& entry = s_streamPool[deviceId];
+    if (!entry.initialized)
+        return;
+    for (int i = 0; i < MaxStreams; i++)
+        CUDA_CALL(cudaStreamSynchronize(entry.streams[i]));
+}
+
+// -----------------------------------------------------------------------
+// CudaGraphCache
+// -----------------------------------------------------------------------
+
+#if CUDA_VERSION >= 10000
+
+// Instantiated graphs per (device, key); like the pooled streams these live until process exit
+// unless explicitly invalidated.
+static std::map<std::pair<int, size_t>, cudaGraphExec_t> s_graphCache;
+static std::mutex s_graphCacheMutex;
+
+static int GraphCacheDeviceId()
+{
+    int deviceId = 0;
+    CUDA_CALL(cudaGetDevice(&deviceId));
+    return deviceId;
+}
+
+/*static*/ bool CudaGraphCache::IsSupported()
+{
+    return true;
+}
+
+/*static*/ bool CudaGraphCache::Replay(size_t key)
+{
+    cudaGraphExec_t exec;
+    {
+        std::lock_guard<std::mutex> lock(s_graphCacheMutex);
+        auto iter = s_graphCache.find(std::make_pair(GraphCacheDeviceId(), key));
+        if (iter == s_graphCache.end())
+            return false;
+        exec = iter->second;
+    }
+    CUDA_CALL(cudaGraphLaunch(exec, GetStream()));
+    return true;
+}
+
+/*static*/ bool CudaGraphCache::BeginCapture(size_t key)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_graphCacheMutex);
+        if (s_graphCache.find(std::make_pair(GraphCacheDeviceId(), key)) != s_graphCache.end())
+            return false;
+    }
+    // Thread-local mode: only work submitted by this thread becomes part of the graph.
+    CUDA_CALL(cudaStreamBeginCapture(GetStream(), cudaStreamCaptureModeThreadLocal));
+    return true;
+}
+
+/*static*/ void CudaGraphCache::EndCapture(size_t key)
+{
+    cudaGraph_t graph;
+    CUDA_CALL(cudaStreamEndCapture(GetStream(), &graph));
+    cudaGraphExec_t exec;
+    CUDA_CALL(cudaGraphInstantiate(&exec, graph, nullptr, nullptr, 0));
+    CUDA_CALL(cudaGraphDestroy(graph));
+    {
+        std::lock_guard<std::mutex> lock(s_graphCacheMutex);
+        s_graphCache[std::make_pair(GraphCacheDeviceId(), key)] = exec;
+    }
+    // The launches recorded during capture did not execute; run the graph for this step.
+    CUDA_CALL(cudaGraphLaunch(exec, GetStream()));
+}
+
+/*static*/ void CudaGraphCache::Invalidate(size_t key)
+{
+    std::lock_guard<std::mutex> lock(s_graphCacheMutex);
+    auto iter = s_graphCache.find(std::make_pair(GraphCacheDeviceId(), key));
+    if (iter != s_graphCache.end())
+    {
+        CUDA_CALL(cudaGraphExecDestroy(iter->second));
+        s_graphCache.erase(iter);
+    }
+}
+
+/*static*/ void CudaGraphCache::InvalidateAll()
+{
+    std::lock_guard<std::mutex> lock(s_graphCacheMutex);
+    for (auto& kv : s_graphCache)
+        CUDA_CALL(cudaGraphExecDestroy(kv.second));
+    s_graphCache.clear();
+}
+
+#else // CUDA_VERSION < 10000 -- toolkit has no graph support, callers fall through to regular launching
+
+/*static*/ bool CudaGraphCache::IsSupported()
+{
+    return false;
+}
+
+/*static*/ bool CudaGraphCache::Replay(size_t /*key*/)
+{
+    return false;
+}
+
+/*static*/ bool CudaGraphCache::BeginCapture(size_t /*key*/)
+{
+    return false;
+}
+
+/*static*/ void CudaGraphCache::EndCapture(size_t /*key*/)
+{
+}
+
+/*static*/ void CudaGraphCache::Invalidate(size_t /*key*/)
+{
+}
+
+/*static*/ void CudaGraphCache::InvalidateAll()
+{
+}
+
+#endif
+
+// -----------------------------------------------------------------------
+// caching device-memory allocator
+// -----------------------------------------------------------------------
+// cudaMalloc and cudaFree serialize the device, and variable-length minibatches make
+// GPUMatrix::Resize() hit them on every shape change. Freed blocks are therefore kept in
+// per-device free lists, bucketed by size class, and later allocations of the same class are
+// satisfied from the cache without entering the driver. Reusing a block without a synchronize
+// is safe because all compute work of a device is issued on its single compute stream
+// (t_stream), which orders the block's old consumer before its new producer; the copy streams
+// already synchronize with the compute stream through events. Size classes are powers of two
+// up to the 2 MB slab granularity and 2 MB multiples above it, bounding overallocation at 2x
+// for small blocks and one slab for large ones. When cudaMalloc fails, the device's cache is
+// flushed once and the allocation retried before the error is surfaced.
+
+namespace
+{
+struct GPUMemoryCache
+{
+    std::map<void*, size_t> blockSizeClasses;       // every block handed out -> its size class in bytes
+    std::map<size_t, std::vector<void*>> freeLists; // size class -> blocks available for reuse
+};
+
+std::mutex s_gpuMemoryCacheMutex;                // guards s_gpuMemoryCaches and all its contents
+std::map<int, GPUMemoryCache> s_gpuMemoryCaches; // deviceId -> cache
+
+// driver blocks handed out while caching is off; only needed so their frees can be
+// memory-profiled with the right byte count
+std::map<void*, size_t> s_uncachedBlockBytes;
+
+// memory-profiling tag for one device's matrix buffers
+void GetMemoryProfilerTag(int deviceId, char* tag, size_t tagLen)
+{
+    sprintf_s(tag, tagLen, "GPU[%d] Matrix", deviceId);
+}
+
+size_t RoundUpToSizeClass(size_t bytes)
+{
+    const size_t slabGranularity = 1 << 21; // 2 MB
+    if (bytes >= slabGranularity)
+        return (bytes + slabGranularity - 1) & ~(slabGranularity - 1);
+    size_t sizeClass = 256;
+    while (sizeClass < bytes)
+        sizeClass <<= 1;
+    return sizeClass;
+}
+
+// return all cached blocks of one device to the driver; caller holds s_gpuMemoryCacheMutex
+// and has made the device current
+void PurgeGPUMemoryCacheNoLock(int deviceId, GPUMemoryCache& cache)
+{
+    char profilerTag[32];
+    GetMemoryProfilerTag(deviceId, profilerTag, sizeof(profilerTag));
+    for (auto& freeList : cache.freeLists)
+    {
+        for (void* bufferPtr : freeList.second)
+        {
+            cache.blockSizeClasses.erase(bufferPtr);
+            cudaFree(bufferPtr);
+            ProfilerMemoryFree(profilerTag, freeList.first);
+        }
+    }
+    cache.freeLists.clear();
+}
+}
+
+void TracingGPUMemoryAllocator::PurgeCache()
+{
+    std::lock_guard<std::mutex> lock(s_gpuMemoryCacheMutex);
+    for (auto& cacheEntry : s_gpuMemoryCaches)
+    {
+        PrepareDevice(cacheEntry.first);
+        PurgeGPUMemoryCacheNoLock(cacheEntry.first, cacheEntry.second);
+    }
+}
+
 template <typename AllocatedElemType>
 AllocatedElemType* TracingGPUMemoryAllocator::Allocate(int deviceId, size_t numRows, size_t numCols)
 {
@@ -207,10 +509,46 @@ template <typename AllocatedElemType>
 void TracingGPUMemoryAllocator::Free(int deviceId, AllocatedElemType* bufferPtr, bool ignoreCUDARetCode /*= false*/)
 {
     PrepareDevice(deviceId);
-    if (ignoreCUDARetCode)
-        cudaFree((void*) bufferPtr);
-    else
-        CUDA_CALL(cudaFree((void*) bufferPtr));
+
+    // blocks that came out of the cache go back into it instead of to the driver
+    bool cached = false;
+    size_t uncachedBytes = 0;
+    if (bufferPtr != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(s_gpuMemoryCacheMutex);
+        auto cacheIter = s_gpuMemoryCaches.find(deviceId);
+        if (cacheIter != s_gpuMemoryCaches.end())
+        {
+            auto blockIter = cacheIter->second.blockSizeClasses.find((void*) bufferPtr);
+            if (blockIter != cacheIter->second.blockSizeClasses.end())
+            {
+                cacheIter->second.freeLists[blockIter->second].push_back((void*) bufferPtr);
+                cached = true;
+            }
+        }
+        if (!cached)
+        {
+            auto blockIter = s_uncachedBlockBytes.find((void*) bufferPtr);
+            if (blockIter != s_uncachedBlockBytes.end())
+            {
+                uncachedBytes = blockIter->second;
+                s_uncachedBlockBytes.erase(blockIter);
+            }
+        }
+    }
+    if (!cached)
+    {
+        if (ignoreCUDARetCode)
+            cudaFree((void*) bufferPtr);
+        else
+            CUDA_CALL(cudaFree((void*) bufferPtr));
+        if (uncachedBytes > 0)
+        {
+            char profilerTag[32];
+            GetMemoryProfilerTag(deviceId, profilerTag, sizeof(profilerTag));
+            ProfilerMemoryFree(profilerTag, uncachedBytes);
+        }
+    }
 
     if (IsTraceEnabled())
     {
@@ -229,10 +567,44 @@ AllocatedElemType* TracingGPUMemoryAllocator::AllocateNoTrace(int deviceId, size
     AllocatedElemType* deviceBufferPtr;
 
     PrepareDevice(deviceId);
-    // In case numElements is odd we allocate a buffer with one more element. The reason is 
+    // In case numElements is odd we allocate a buffer with one more element. The reason is
     // we might call curandGenerateNormal (e.g. for Gaussian noise injection) which would fail
     // if the number of elements it needs to generate is odd.
-    CUDA_CALL(cudaMalloc((void**) &deviceBufferPtr, sizeof(AllocatedElemType) * asMultipleOf(numElements, 2)));
+    size_t numBytes = sizeof(AllocatedElemType) * asMultipleOf(numElements, 2);
+    char profilerTag[32];
+    GetMemoryProfilerTag(deviceId, profilerTag, sizeof(profilerTag));
+    if (IsCachingEnabled())
+    {
+        size_t sizeClass = RoundUpToSizeClass(numBytes);
+        std::lock_guard<std::mutex> lock(s_gpuMemoryCacheMutex);
+        auto& cache = s_gpuMemoryCaches[deviceId];
+        auto& freeList = cache.freeLists[sizeClass];
+        if (!freeList.empty())
+        {
+            deviceBufferPtr = (AllocatedElemType*) freeList.back();
+            freeList.pop_back();
+            return deviceBufferPtr;
+        }
+        cudaError_t result = cudaMalloc((void**) &deviceBufferPtr, sizeClass);
+        if (result == cudaErrorMemoryAllocation)
+        {
+            // under memory pressure: return all cached blocks of this device to the driver
+            // and retry once before surfacing the error
+            PurgeGPUMemoryCacheNoLock(deviceId, cache);
+            cudaGetLastError(); // reset the sticky error state
+            result = cudaMalloc((void**) &deviceBufferPtr, sizeClass);
+        }
+        CUDA_CALL(result);
+        cache.blockSizeClasses[(void*) deviceBufferPtr] = sizeClass;
+        ProfilerMemoryAlloc(profilerTag, sizeClass);
+        return deviceBufferPtr;
+    }
+    CUDA_CALL(cudaMalloc((void**) &deviceBufferPtr, numBytes));
+    {
+        std::lock_guard<std::mutex> lock(s_gpuMemoryCacheMutex);
+        s_uncachedBlockBytes[(void*) deviceBufferPtr] = numBytes;
+    }
+    ProfilerMemoryAlloc(profilerTag, numBytes);
 
     return deviceBufferPtr;
 }
@@ -1244,7 +1616,9 @@ void GPUMatrix<ElemType>::SetValue(const size_t numRows, const size_t numCols, i
             if (!(matrixFlags & matrixFormatRowMajor))
             {
                 if (transferer)
-                    transferer->CopyCPUToGPUAsync(pArray, GetNumElements(), sizeof(ElemType), Data());
+                    // staged: goes through the transferer's pinned ring (if it has one), so the
+                    // caller's buffer is reusable on return and several copies can be in flight
+                    transferer->CopyCPUToGPUStagedAsync(pArray, GetNumElements(), sizeof(ElemType), Data());
                 else
                     CUDA_CALL(cudaMemcpy(Data(), pArray, sizeof(ElemType) * GetNumElements(), (matrixFlags & matrixFlagSetValueOnDevice) ? cudaMemcpyDeviceToDevice : cudaMemcpyHostToDevice));
             }
@@ -1256,7 +1630,9 @@ void GPUMatrix<ElemType>::SetValue(const size_t numRows, const size_t numCols, i
                         transposed[i + numRows * j] = pArray[j + numCols * i];
 
                 if (transferer)
-                    transferer->CopyCPUToGPUAsync(transposed.data(), GetNumElements(), sizeof(ElemType), Data());
+                    // staged if the transferer has a pinned ring, which also protects against
+                    // 'transposed' not outliving the async copy
+                    transferer->CopyCPUToGPUStagedAsync(transposed.data(), GetNumElements(), sizeof(ElemType), Data());
                 else
                     CUDA_CALL(cudaMemcpy(Data(), transposed.data(), sizeof(ElemType) * GetNumElements(), (matrixFlags & matrixFlagSetValueOnDevice) ? cudaMemcpyDeviceToDevice : cudaMemcpyHostToDevice));
             }
@@ -1370,6 +1746,44 @@ void GPUMatrix<ElemType>::SetUniformRandomMask(const ElemType maskRate, const El
     _setMaskAndScale<ElemType><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, t_stream>>>(Data(), N, maskRate, scaleValue);
 }
 
+// [this] = dropoutMask(seed, offset) .* a * scaleValue
+// Fused generate-and-apply using the Philox counter-based generator, so the backward pass can
+// regenerate the mask via AddDropoutOf with the same (seed, offset) instead of storing it.
+template <class ElemType>
+GPUMatrix<ElemType>& GPUMatrix<ElemType>::AssignDropoutOf(const GPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset)
+{
+    if (a.IsEmpty())
+        LogicError("AssignDropoutOf: Matrix a is empty.");
+
+    RequireSize(a.GetNumRows(), a.GetNumCols());
+
+    PrepareDevice();
+    CUDA_LONG N = (CUDA_LONG) GetNumElements();
+    CUDA_LONG numBlocks = (CUDA_LONG) ((offset + N - 1) / 4 - offset / 4 + 1);
+    int blocksPerGrid = (int) ceil(1.0 * numBlocks / GridDim::maxThreadsPerBlock);
+    SyncGuard syncGuard;
+    _dropoutOf<ElemType, false><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, t_stream>>>(Data(), a.Data(), N, maskRate, scaleValue, seed, offset);
+    return *this;
+}
+
+// [this] += dropoutMask(seed, offset) .* a * scaleValue
+template <class ElemType>
+GPUMatrix<ElemType>& GPUMatrix<ElemType>::AddDropoutOf(const GPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset)
+{
+    if (a.IsEmpty())
+        LogicError("AddDropoutOf: Matrix a is empty.");
+    if (a.GetNumRows() != GetNumRows() || a.GetNumCols() != GetNumCols())
+        InvalidArgument("AddDropoutOf: The input matrix dimensions do not match.");
+
+    PrepareDevice();
+    CUDA_LONG N = (CUDA_LONG) GetNumElements();
+    CUDA_LONG numBlocks = (CUDA_LONG) ((offset + N - 1) / 4 - offset / 4 + 1);
+    int blocksPerGrid = (int) ceil(1.0 * numBlocks / GridDim::maxThreadsPerBlock);
+    SyncGuard syncGuard;
+    _dropoutOf<ElemType, true><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, t_stream>>>(Data(), a.Data(), N, maskRate, scaleValue, seed, offset);
+    return *this;
+}
+
 template <class ElemType>
 ElemType GPUMatrix<ElemType>::Adagrad(GPUMatrix<ElemType>& gradients, const bool needAveMultiplier)
 {
@@ -1464,6 +1878,75 @@ void GPUMatrix<ElemType>::Adam(GPUMatrix<ElemType>& gradients,
         learnRatePerSample, momentum, adaWeight, adaMul, epsilon, unitGainMomentum, adamax);
 }
 
+template <class ElemType>
+/*static*/ void GPUMatrix<ElemType>::BatchAdamUpdate(const std::vector<GPUMatrix<ElemType>*>& smoothedGradients, const std::vector<GPUMatrix<ElemType>*>& gradients,
+    const std::vector<GPUMatrix<ElemType>*>& functionValues, const std::vector<ElemType>& adaMuls,
+    ElemType learnRatePerSample, ElemType momentum, ElemType adaWeight, ElemType epsilon,
+    bool unitGainMomentum, bool adamax)
+{
+    if (gradients.empty())
+        return;
+    PrepareDevice(gradients[0]->GetComputeDeviceId());
+
+    // fill tensors into argument blocks of MaxTensors and issue one launch per block
+    size_t i = 0;
+    while (i < gradients.size())
+    {
+        MultiTensorAdamArgs<ElemType> args;
+        CUDA_LONG total = 0;
+        int count = 0;
+        args.offset[0] = 0;
+        for (; i < gradients.size() && count < MultiTensorAdamArgs<ElemType>::MaxTensors; i++, count++)
+        {
+            CUDA_LONG n = (CUDA_LONG) gradients[i]->GetNumElements();
+            assert((smoothedGradients[i]->GetNumRows() == gradients[i]->GetNumRows()) &&
+                   (smoothedGradients[i]->GetNumCols() == 2 * gradients[i]->GetNumCols()));
+            args.grad[count] = gradients[i]->Data();
+            args.smoothAda[count] = smoothedGradients[i]->Data();
+            args.smoothMom[count] = smoothedGradients[i]->Data() + n;
+            args.val[count] = functionValues[i]->Data();
+            args.adaMul[count] = adaMuls[i];
+            total += n;
+            args.offset[count + 1] = total;
+        }
+        args.count = count;
+        int blocksPerGrid = (total + GridDim::maxThreadsPerBlock - 1) / GridDim::maxThreadsPerBlock;
+        _adamMultiTensor<ElemType> << <blocksPerGrid, GridDim::maxThreadsPerBlock >> >(args,
+            learnRatePerSample, momentum, adaWeight, epsilon, unitGainMomentum, adamax);
+    }
+}
+
+template <class ElemType>
+/*static*/ void GPUMatrix<ElemType>::BatchSquaredFrobeniusNorms(const std::vector<const GPUMatrix<ElemType>*>& inputs, std::vector<ElemType>& norms)
+{
+    norms.resize(inputs.size());
+    if (inputs.empty())
+        return;
+    int deviceId = inputs[0]->GetComputeDeviceId();
+    PrepareDevice(deviceId);
+    ElemType* normsDevice = TracingGPUMemoryAllocator::Allocate<ElemType>(deviceId, inputs.size());
+
+    // fill tensors into argument blocks of MaxTensors and issue one launch per block;
+    // the single device-to-host copy at the end is the only synchronization
+    size_t i = 0;
+    while (i < inputs.size())
+    {
+        MultiTensorNormArgs<ElemType> args;
+        size_t base = i;
+        int count = 0;
+        for (; i < inputs.size() && count < MultiTensorNormArgs<ElemType>::MaxTensors; i++, count++)
+        {
+            args.data[count] = inputs[i]->Data();
+            args.numElements[count] = (CUDA_LONG) inputs[i]->GetNumElements();
+        }
+        args.count = count;
+        _squaredNormsMultiTensor<ElemType> << <count, 512 >> >(args, normsDevice + base);
+    }
+
+    CUDA_CALL(cudaMemcpy(norms.data(), normsDevice, inputs.size() * sizeof(ElemType), cudaMemcpyDeviceToHost));
+    TracingGPUMemoryAllocator::Free<ElemType>(deviceId, normsDevice);
+}
+
 template <class ElemType>
 ElemType GPUMatrix<ElemType>::RmsProp(GPUMatrix<ElemType>& gradients,
                                       ElemType RMS_GAMMA,
@@ -2176,7 +2659,7 @@ GPUMatrix<ElemType>& GPUMatrix<ElemType>::AssignLogSoftmaxOf(const GPUMatrix<Ele
         CUDA_LONG M = (CUDA_LONG) GetNumRows();
         SyncGuard syncGuard;
         // note: kernel uses hard-coded thread dimension
-        _assignColumnwiseLogSoftmaxOf512Threads<<<N, 512, 0, t_stream>>>(a.Data(), Data(), N, M);
+        _assignColumnwiseLogSoftmaxOnlineOf512Threads<<<N, 512, 0, t_stream>>>(a.Data(), Data(), N, M);
     }
     else
     {
@@ -2858,6 +3341,18 @@ void GPUMatrix<ElemType>::VectorMax(GPUMatrix<ElemType>& maxIndexes, GPUMatrix<E
     maxValues.RequireSize(topK, n);
     maxIndexes.RequireSize(topK, n);
 
+    // For small K (the classification-error top-K case) select the winners directly with
+    // K argmax-reduction rounds per column, so the cost scales with K and no sort
+    // workspace (~5x the matrix size) is needed. The sort path below touches every
+    // element log(m * n) times, which dominates eval time for large vocabularies.
+    const int MaxPartialSelectionK = 32;
+    if (topK <= MaxPartialSelectionK)
+    {
+        const int blockSize = 512;
+        _vectorTopKMaxReduce<blockSize, MaxPartialSelectionK><<<n, blockSize, 0, t_stream>>>(us.Data(), maxIndexes.Data(), maxValues.Data(), m, topK);
+        return;
+    }
+
     // To sort matrix columns we use 2-pass _stable_ sort algorithm:
     // 1. Sort by values (descending) with corresponding row/col indexes.
     // 2. Sort by col indices (ascending) with corresponding values/row indices.
@@ -3433,6 +3928,15 @@ static cublasStatus_t cublas_gemm(cublasHandle_t handle, cublasOperation_t trans
 {
     return cublasDgemm(handle, transa, transb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
 }
+// float/double overloads of cublasSgemmBatched()/cublasDgemmBatched()
+static cublasStatus_t cublas_gemm_batched(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_t transb, int m, int n, int k, const float* alpha, const float* Aarray[], int lda, const float* Barray[], int ldb, const float* beta, float* Carray[], int ldc, int batchCount)
+{
+    return cublasSgemmBatched(handle, transa, transb, m, n, k, alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc, batchCount);
+}
+static cublasStatus_t cublas_gemm_batched(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_t transb, int m, int n, int k, const double* alpha, const double* Aarray[], int lda, const double* Barray[], int ldb, const double* beta, double* Carray[], int ldc, int batchCount)
+{
+    return cublasDgemmBatched(handle, transa, transb, m, n, k, alpha, Aarray, lda, Barray, ldb, beta, Carray, ldc, batchCount);
+}
 static cublasStatus_t cublas_axpy(cublasHandle_t handle, int n, const float* alpha, const float* x, int incx, float* y, int incy)
 {
     return cublasSaxpy(handle, n, alpha, x, incx, y, incy);
@@ -3470,6 +3974,74 @@ void GPUMatrix<ElemType>::MultiplyAndWeightedAdd(ElemType alpha, const GPUMatrix
     CUBLAS_CALL(cublas_gemm(cuHandle, transA, transB, m, n, k, &alpha, a.Data(), (int) a.m_numRows, b.Data(), (int) b.m_numRows, &beta, c.Data(), (int) c.m_numRows));
 }
 
+// grouped GEMM: c[i] = alpha * op(a[i]) * op(b[i]) + beta * c[i] for all i, issued as a single
+// cublas<t>gemmBatched() call. This amortizes kernel-launch overhead over the group, which matters
+// for the many tiny per-timestep products of recurrent loops. cublas requires uniform dimensions
+// across the batch; groups with non-uniform entries fall back to one gemm call per entry (still
+// avoiding the per-entry dispatch above this level).
+template <class ElemType>
+void GPUMatrix<ElemType>::BatchedMultiplyAndWeightedAdd(ElemType alpha, const std::vector<const GPUMatrix<ElemType>*>& a, const bool transposeA, const std::vector<const GPUMatrix<ElemType>*>& b, const bool transposeB,
+                                                        ElemType beta, const std::vector<GPUMatrix<ElemType>*>& c)
+{
+    if (a.size() != b.size() || a.size() != c.size())
+        InvalidArgument("BatchedMultiplyAndWeightedAdd: a, b, and c must contain the same number of matrices.");
+    if (a.empty())
+        return;
+
+    a[0]->PrepareDevice();
+    int deviceId = a[0]->GetComputeDeviceId();
+    cublasHandle_t cuHandle = GetCublasHandle(deviceId);
+    cublasOperation_t transA = transposeA ? CUBLAS_OP_T : CUBLAS_OP_N;
+    cublasOperation_t transB = transposeB ? CUBLAS_OP_T : CUBLAS_OP_N;
+
+    int m = int(transposeA ? a[0]->m_numCols : a[0]->m_numRows);
+    int n = int(transposeB ? b[0]->m_numRows : b[0]->m_numCols);
+    int k = int(transposeA ? a[0]->m_numRows : a[0]->m_numCols);
+    int l = int(transposeB ? b[0]->m_numCols : b[0]->m_numRows);
+    if (!(m > 0 && k > 0 && l > 0 && n > 0))
+        RuntimeError("!(m>0 && k>0 && l>0 && n>0)"); // converting from size_t to int may cause overflow
+    if (k != l)
+        RuntimeError("matrix dim mismatch in BatchedMultiplyAndWeightedAdd");
+
+    bool uniform = true;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i]->GetComputeDeviceId() != deviceId || b[i]->GetComputeDeviceId() != deviceId || c[i]->GetComputeDeviceId() != deviceId)
+            InvalidArgument("All matrices must be on the same GPU");
+        if (beta == 0)
+            c[i]->RequireSize(m, n);
+        else
+            c[i]->VerifySize(m, n); // Can't resize if beta != 0
+        uniform &= a[i]->m_numRows == a[0]->m_numRows && a[i]->m_numCols == a[0]->m_numCols &&
+                   b[i]->m_numRows == b[0]->m_numRows && b[i]->m_numCols == b[0]->m_numCols;
+    }
+
+    if (!uniform)
+    {
+        for (size_t i = 0; i < a.size(); i++)
+            MultiplyAndWeightedAdd(alpha, *a[i], transposeA, *b[i], transposeB, beta, *c[i]);
+        return;
+    }
+
+    // cublas<t>gemmBatched() takes the operand pointers through device-side arrays
+    int batchCount = (int) a.size();
+    std::vector<const ElemType*> hostPtrs(3 * batchCount);
+    for (int i = 0; i < batchCount; i++)
+    {
+        hostPtrs[i] = a[i]->Data();
+        hostPtrs[batchCount + i] = b[i]->Data();
+        hostPtrs[2 * batchCount + i] = c[i]->Data();
+    }
+    const ElemType** devicePtrs;
+    CUDA_CALL(cudaMalloc((void**) &devicePtrs, 3 * batchCount * sizeof(ElemType*)));
+    CUDA_CALL(cudaMemcpy(devicePtrs, hostPtrs.data(), 3 * batchCount * sizeof(ElemType*), cudaMemcpyHostToDevice));
+    CUBLAS_CALL(cublas_gemm_batched(cuHandle, transA, transB, m, n, k, &alpha,
+                                    devicePtrs, (int) a[0]->m_numRows,
+                                    devicePtrs + batchCount, (int) b[0]->m_numRows, &beta,
+                                    const_cast<ElemType**>(devicePtrs + 2 * batchCount), (int) c[0]->m_numRows, batchCount));
+    CUDA_CALL(cudaFree((void*) devicePtrs));
+}
+
 template <class ElemType>
 void GPUMatrix<ElemType>::Multiply1x1AndWeightedAdd(ElemType alpha, const GPUMatrix<ElemType>& a, const GPUMatrix<ElemType>& b, ElemType beta, GPUMatrix<ElemType>& c)
 {
@@ -4467,22 +5039,18 @@ GPUMatrix<ElemType>& GPUMatrix<ElemType>::AssignCTCScore(const GPUMatrix<ElemTyp
         cudaEvent_t done = nullptr;
         CUDA_CALL(cudaEventCreate(&done));
         dim3 thread_tail(DEFAULT_THREAD_PER_DIM, DEFAULT_THREAD_PER_DIM);
-        // x dimension is for utterances
-        // y dimention is for phone sequence in each utterance
-        // Ensure that we allocate correct number of blocks for given number of utterances and max number of phones in those utterances 
-        dim3 block_tail((uttNum + DEFAULT_THREAD_PER_DIM - 1) / DEFAULT_THREAD_PER_DIM, (maxPhoneNum + DEFAULT_THREAD_PER_DIM - 1) / DEFAULT_THREAD_PER_DIM);
-        for (long t = 0; t < maxFrameNum; t++)
-        {
-            _assignAlphaScore << <block_tail, thread_tail, 0, t_stream >> >(prob.Data(), alpha.Data(), phoneSeq.Data(), phoneBoundary.Data(), gpuUttToChanInd,
-                gpuFrameNum, gpuBeginFrame, gpuPhoneNum, numParallelSequences, uttNum, t, maxPhoneNum, totalPhoneNum, blankTokenId, delayConstraint);
-        }
+        // One block per utterance, threads parallel over the phone sequence; the time recursion
+        // runs inside the kernels with one barrier per frame, so the whole forward and backward
+        // pass is two launches instead of one tiny grid per frame (with long utterances the
+        // per-frame launch overhead dominated the forward-backward computation).
+        const int threadsPerUtt = 256;
+        _assignAlphaScore << <(unsigned int)uttNum, threadsPerUtt, 0, t_stream >> >(prob.Data(), alpha.Data(), phoneSeq.Data(), phoneBoundary.Data(), gpuUttToChanInd,
+            gpuFrameNum, gpuBeginFrame, gpuPhoneNum, numParallelSequences, uttNum, maxPhoneNum, totalPhoneNum, blankTokenId, delayConstraint);
+
+        _assignBetaScore << <(unsigned int)uttNum, threadsPerUtt, 0, t_stream >> >(prob.Data(), beta.Data(), phoneSeq.Data(), phoneBoundary.Data(), gpuUttToChanInd,
+            gpuFrameNum, gpuBeginFrame, gpuPhoneNum, numParallelSequences, uttNum, maxPhoneNum, totalPhoneNum, blankTokenId, delayConstraint);
+
 
-        for (long t = maxFrameNum - 1; t >= 0; t--)
-        {
-            _assignBetaScore << <block_tail, thread_tail, 0, t_stream >> >(prob.Data(), beta.Data(), phoneSeq.Data(), phoneBoundary.Data(), gpuUttToChanInd,
-                gpuFrameNum, gpuBeginFrame, gpuPhoneNum, numParallelSequences, uttNum, t, maxPhoneNum, totalPhoneNum, blankTokenId, delayConstraint);
-        }
-        
         ElemType zerVar = 0.0;
         totalScore.SetColumn(&zerVar, 0);
         _assignTotalScore << <uttNum, 1, 0, t_stream >> > (beta.Data(), totalScore.Data(), uttNum, gpuUttToChanInd, gpuBeginFrame, numParallelSequences, maxPhoneNum);
@@ -59,6 +59,11 @@ typedef struct CUstream_st* cudaStream_t;
 void MATH_API SetStream(cudaStream_t stream);
 cudaStream_t MATH_API GetStream();
 
+// fp16 conversion helpers, e.g. for compressed NCCL reductions. 'halfBuffer' holds
+// 'count' __half values; both launch asynchronously on the given stream.
+void MATH_API CudaFloatToHalf(const float* src, void* halfDst, size_t count, cudaStream_t stream);
+void MATH_API CudaHalfToFloat(const void* halfSrc, float* dst, size_t count, cudaStream_t stream);
+
 namespace Microsoft { namespace MSR { namespace CNTK {
 
 class DataTransferer;
@@ -85,6 +90,92 @@ public:
     ~SyncGuard();
 };
 
+// -----------------------------------------------------------------------
+// MatrixStreamPool -- pool of CUDA streams for overlapping independent GPU work
+// -----------------------------------------------------------------------
+// All GPU routines launch onto the thread-local stream set through SetStream(). By default that
+// is a single stream, so operations without data dependencies (e.g. independent branches of a
+// network) serialize even though the device could run them concurrently. The pool hands out a
+// fixed set of concurrently executing streams, keyed by a small integer slot, and provides
+// event-based dependency edges so a consumer stream starts only after its producers are done:
+//
+//     { MatrixStreamPool::StreamGuard guard(branch); <launch branch ops> }
+//     MatrixStreamPool::RecordEvent(branch);       // mark the branch output as ready
+//     MatrixStreamPool::AddDependency(join, branch); // the joining slot waits on-device for it
+//
+// Streams and events are created lazily per device and, like the cuBLAS handles, never freed.
+class MatrixStreamPool
+{
+public:
+    static const int MaxStreams = 16; // slots wrap modulo this, so any branch index is a valid slot
+
+    // Scoped stream assignment: redirects this thread's GPU launches to the pooled stream of
+    // 'slot' and restores the previous stream on destruction. A negative slot is a no-op, which
+    // lets callers keep a single code path for both serialized and overlapped execution.
+    class MATH_API StreamGuard
+    {
+    public:
+        StreamGuard(int slot);
+        ~StreamGuard();
+
+    private:
+        cudaStream_t m_prevStream;
+    };
+
+    // Record an event on the stream of 'slot', capturing all work submitted to it so far.
+    static MATH_API void RecordEvent(int slot);
+
+    // Make the stream of 'slot' wait, on the device and without blocking the CPU, until the
+    // work recorded for 'producerSlot' via RecordEvent() has completed.
+    static MATH_API void AddDependency(int slot, int producerSlot);
+
+    // Block the calling thread until all pooled streams of the current device have drained.
+    static MATH_API void SynchronizeAll();
+};
+
+// -----------------------------------------------------------------------
+// CudaGraphCache -- capture and replay of steady-state launch sequences
+// -----------------------------------------------------------------------
+// For small models the per-step cost of the hundreds of individual kernel launches dominates;
+// once minibatch shapes stabilize the launch sequence is identical every step and can be
+// recorded into a CUDA graph and replayed as a single launch. Graphs are cached per device
+// under a caller-provided key (e.g. a hash of the MBLayout signature); on a shape change the
+// caller invalidates and the next step re-captures. Typical use around a step:
+//
+//     if (!CudaGraphCache::Replay(key))
+//     {
+//         bool capturing = CudaGraphCache::BeginCapture(key);
+//         <launch the step>
+//         if (capturing)
+//             CudaGraphCache::EndCapture(key); // also launches the captured graph
+//     }
+//
+// Requires CUDA 10 or newer; on older toolkits (and CPUONLY builds) all calls are no-ops and
+// Replay/BeginCapture return false, so callers fall through to regular launching.
+// NOTE: the legacy default stream cannot be captured; run the step on a pooled stream
+// (see MatrixStreamPool) or any explicitly created one.
+class CudaGraphCache
+{
+public:
+    // Whether the toolkit supports graph capture at all.
+    static MATH_API bool IsSupported();
+
+    // Launch the cached graph for 'key' on this thread's stream. Returns false if none is cached.
+    static MATH_API bool Replay(size_t key);
+
+    // Start capturing this thread's stream into a graph for 'key'.
+    // Returns false (and captures nothing) if unsupported or a graph is already cached.
+    static MATH_API bool BeginCapture(size_t key);
+
+    // Finish the capture started by BeginCapture(), cache the instantiated graph and launch it
+    // (captured launches do not execute by themselves).
+    static MATH_API void EndCapture(size_t key);
+
+    // Drop the cached graph for 'key' / for all keys, e.g. when minibatch shapes change.
+    static MATH_API void Invalidate(size_t key);
+    static MATH_API void InvalidateAll();
+};
+
 // -----------------------------------------------------------------------
 // DeviceBoundNumber -- This class represents a number which resides on a particular device. Use it to avoid unnecessary transfers between CPU and GPU
 // -----------------------------------------------------------------------
@@ -232,6 +323,19 @@ public:
     void Adam(GPUMatrix<ElemType>& gradients, GPUMatrix<ElemType>& functionValues, ElemType learnRatePerSample,
               ElemType momentum, ElemType adaWeight, ElemType adaMul, ElemType epsilon, bool unitGainMomentum, bool adamax=false);
 
+    // Adam update of many parameter tensors in a few launches (multi-tensor batching); all
+    // matrices must be dense and on the same device, smoothed gradients already sized to
+    // two gradient columns. adaMuls carries the per-tensor bias correction.
+    static void BatchAdamUpdate(const std::vector<GPUMatrix<ElemType>*>& smoothedGradients, const std::vector<GPUMatrix<ElemType>*>& gradients,
+                                const std::vector<GPUMatrix<ElemType>*>& functionValues, const std::vector<ElemType>& adaMuls,
+                                ElemType learnRatePerSample, ElemType momentum, ElemType adaWeight, ElemType epsilon,
+                                bool unitGainMomentum, bool adamax = false);
+
+    // Squared Frobenius norms of many tensors (multi-tensor batching): a few launches plus a
+    // single device-to-host copy of all results, instead of one synchronizing reduction per
+    // tensor. All matrices must be dense and on the same device.
+    static void BatchSquaredFrobeniusNorms(const std::vector<const GPUMatrix<ElemType>*>& inputs, std::vector<ElemType>& norms);
+
     ElemType RmsProp(GPUMatrix<ElemType>& gradients, 
                      ElemType RMS_GAMMA, 
                      ElemType RMS_WGT_INC, 
@@ -276,6 +380,8 @@ public:
     void SetUniformRandomValue(const ElemType low, const ElemType high, unsigned long seed = USE_TIME_BASED_SEED);
     void SetGaussianRandomValue(const ElemType mean, const ElemType sigma, unsigned long seed = USE_TIME_BASED_SEED);
     void SetUniformRandomMask(const ElemType maskRate, const ElemType scaleValue, RNGHandle& rngHandle);
+    GPUMatrix<ElemType>& AssignDropoutOf(const GPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset);
+    GPUMatrix<ElemType>& AddDropoutOf(const GPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset);
 
     GPUMatrix<ElemType>& AssignOneHot(const GPUMatrix<ElemType>& a, vector<size_t>& shape, size_t axis);
     GPUMatrix<ElemType>& GatherFromTarget(const GPUMatrix<ElemType>& indices, const GPUMatrix<ElemType>& target, size_t row_elements);
@@ -518,6 +624,7 @@ public:
 public:
     // static BLAS functions
     static void MultiplyAndWeightedAdd(ElemType alpha, const GPUMatrix<ElemType>& a, const bool transposeA, const GPUMatrix<ElemType>& b, const bool transposeB, ElemType beta, GPUMatrix<ElemType>& c);
+    static void BatchedMultiplyAndWeightedAdd(ElemType alpha, const std::vector<const GPUMatrix<ElemType>*>& a, const bool transposeA, const std::vector<const GPUMatrix<ElemType>*>& b, const bool transposeB, ElemType beta, const std::vector<GPUMatrix<ElemType>*>& c);
     static void MultiplyAndAdd(const GPUMatrix<ElemType>& a, const bool transposeA, const GPUMatrix<ElemType>& b, const bool transposeB, GPUMatrix<ElemType>& c);
     static void Multiply(const GPUMatrix<ElemType>& a, const bool transposeA, const GPUMatrix<ElemType>& b, const bool transposeB, GPUMatrix<ElemType>& c);
     static void Multiply(const GPUMatrix<ElemType>& a, const GPUMatrix<ElemType>& b, GPUMatrix<ElemType>& c);
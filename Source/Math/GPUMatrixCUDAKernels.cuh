@@ -989,6 +989,71 @@ __global__ void _assignColumnwiseLogSoftmaxOf512Threads(
     }
 }
 
+// each block processes one column. There must be 512 threads in a block
+// Online-softmax variant: maintains the running max and the exp-sum rescaled to it in a
+// single read pass over the column, instead of a max pass followed by an exp-sum pass.
+// With the log-normalizer known after one pass, the output is written exactly once,
+// saving a full read-modify-write of 'us' compared to the three-pass kernel above --
+// a significant saving for large-vocabulary (e.g. LM output layer) columns.
+template <class ElemType>
+__global__ void _assignColumnwiseLogSoftmaxOnlineOf512Threads(
+    const ElemType* a,
+    ElemType* us,
+    const CUDA_LONG m_numCols,
+    const CUDA_LONG m_numRows)
+{
+    __shared__ ElemType partialMax[512];
+    __shared__ ElemType partialSum[512];
+
+    // single pass: each thread keeps a running max m and sum s of exp(a - m) over its strided elements
+    ElemType m = -10000000;
+    ElemType s = 0;
+    for (int i = threadIdx.x; i < m_numRows; i += 512)
+    {
+        ElemType v = a[IDX2C(i, blockIdx.x, m_numRows)];
+        if (v > m)
+        {
+            // rescale the sum accumulated so far to the new max
+            s = s * ((sizeof(ElemType) == sizeof(float)) ? expf(m - v) : exp(m - v)) + 1;
+            m = v;
+        }
+        else
+            s += (sizeof(ElemType) == sizeof(float)) ? expf(v - m) : exp(v - m);
+    }
+    partialMax[threadIdx.x] = m;
+    partialSum[threadIdx.x] = s;
+    __syncthreads();
+
+    // tree-reduce the (max, rescaled sum) pairs of all threads
+    for (int stride = 256; stride > 0; stride >>= 1)
+    {
+        if (threadIdx.x < stride)
+        {
+            ElemType otherMax = partialMax[threadIdx.x + stride];
+            ElemType otherSum = partialSum[threadIdx.x + stride];
+            if (otherMax > partialMax[threadIdx.x])
+            {
+                partialSum[threadIdx.x] = otherSum + partialSum[threadIdx.x] * ((sizeof(ElemType) == sizeof(float)) ? expf(partialMax[threadIdx.x] - otherMax) : exp(partialMax[threadIdx.x] - otherMax));
+                partialMax[threadIdx.x] = otherMax;
+            }
+            else
+                partialSum[threadIdx.x] += otherSum * ((sizeof(ElemType) == sizeof(float)) ? expf(otherMax - partialMax[threadIdx.x]) : exp(otherMax - partialMax[threadIdx.x]));
+        }
+        __syncthreads();
+    }
+
+    __shared__ ElemType colLogZ[1];
+    if (threadIdx.x == 0)
+        colLogZ[0] = partialMax[0] + ((sizeof(ElemType) == sizeof(float)) ? logf(partialSum[0]) : log(partialSum[0]));
+    __syncthreads();
+
+    // single write pass with the final log-normalizer
+    for (int i = threadIdx.x; i < m_numRows; i += 512)
+    {
+        us[IDX2C(i, blockIdx.x, m_numRows)] = a[IDX2C(i, blockIdx.x, m_numRows)] - colLogZ[0];
+    }
+}
+
 template <class ElemType>
 __global__ void _logSoftMaxRowWise(
     ElemType* a,
@@ -1689,6 +1754,66 @@ __global__ void _setMaskAndScale(
     a[id] = a[id] <= maskRate ? 0 : scaleValue;
 }
 
+// Philox4x32-10 output block for a 64-bit key (seed) and 64-bit counter. Device twin of
+// CPUPhiloxRNG::Generate (CPURNGHandle.h); the constants and round count must stay in sync.
+__device__ __forceinline__ void _philox4x32(uint64_t seed, uint64_t counter, uint32_t (&out)[4])
+{
+    uint32_t key0 = (uint32_t) seed, key1 = (uint32_t) (seed >> 32);
+    uint32_t c0 = (uint32_t) counter, c1 = (uint32_t) (counter >> 32), c2 = 0, c3 = 0;
+    for (int round = 0; round < 10; round++)
+    {
+        uint64_t p0 = (uint64_t) 0xD2511F53u * c0;
+        uint64_t p1 = (uint64_t) 0xCD9E8D57u * c2;
+        uint32_t n0 = (uint32_t) (p1 >> 32) ^ c1 ^ key0;
+        uint32_t n1 = (uint32_t) p1;
+        uint32_t n2 = (uint32_t) (p0 >> 32) ^ c3 ^ key1;
+        uint32_t n3 = (uint32_t) p0;
+        c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+        key0 += 0x9E3779B9u; // golden-ratio Weyl constants, per the paper
+        key1 += 0xBB67AE85u;
+    }
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+// Fused dropout generate-and-apply: the mask value of stream position p is derived from word
+// p % 4 of Philox counter p / 4, where p = offset + element index. One thread handles the up to
+// 4 elements covered by one counter, so forward (Add = false) and backward (Add = true) calls
+// over any sub-range of the stream regenerate the same mask without materializing it.
+template <class ElemType, bool Add>
+__global__ void _dropoutOf(
+    ElemType* us,
+    const ElemType* a,
+    const CUDA_LONG N,
+    const ElemType maskRate,
+    const ElemType scaleValue,
+    const uint64_t seed,
+    const uint64_t offset)
+{
+    const uint64_t firstCounter = offset / 4;
+    const CUDA_LONG numBlocks = (CUDA_LONG) ((offset + N - 1) / 4 - firstCounter + 1);
+    CUDA_LONG b = blockDim.x * blockIdx.x + threadIdx.x;
+    if (b >= numBlocks)
+        return;
+    uint32_t rnd[4];
+    _philox4x32(seed, firstCounter + b, rnd);
+    for (int k = 0; k < 4; k++)
+    {
+        int64_t i = (int64_t) (firstCounter + b) * 4 + k - (int64_t) offset;
+        if (i < 0 || i >= N)
+            continue;
+        ElemType v = (ElemType) ((rnd[k] >> 8) * (1.0 / 16777216.0)); // top 24 bits -> [0,1)
+        if (Add)
+        {
+            if (v > maskRate)
+                us[i] += a[i] * scaleValue;
+        }
+        else
+        {
+            us[i] = v <= maskRate ? 0 : a[i] * scaleValue;
+        }
+    }
+}
+
 template <class ElemType>
 __global__ void _vectorSum(
     ElemType* c,       // output
@@ -3077,6 +3202,52 @@ __global__ void _dense1DConvMultSparseCSCAndWeightedAddToDense(
     c[IDX2C(rowInC, colInC, m * numSteps)] = alpha * s + (beta == 0 ? 0 : beta * c[IDX2C(rowInC, colInC, m * numSteps)]); // If beta is zero then don't lookup c
 }
 
+// Load-balanced dense x sparse CSC product for skewed (power-law) nonzero distributions.
+// The kernel above assigns one thread per output element, each looping over the nnz of its
+// sparse column, so one heavy column keeps m threads busy while the rest of the grid drains.
+// Here work is split by nonzero instead: one thread per (dense row, nonzero) pair, with the
+// owning sparse column found by binary search in the CSC column index. Results are accumulated
+// with atomics, so c must already hold beta * c when the kernel launches.
+template <class ElemType>
+__global__ void _denseMultSparseCSCNnzBalancedAndAddToDense(
+    const CUDA_LONG m,   // rowDense
+    const int k,         // colDense
+    const int n,         // colSparse
+    const CUDA_LONG nnz, // nonzeros in the sparse matrix
+    const ElemType alpha,
+    const ElemType* a, // dense
+    const bool transposeA,
+    const ElemType* bnzValues, // sparse nz values
+    const GPUSPARSE_INDEX_TYPE* rowIndex,
+    const GPUSPARSE_INDEX_TYPE* colCSCIndex,
+    ElemType* c // dense target
+    )
+{
+    CUDA_LONG id = blockDim.x * blockIdx.x + threadIdx.x;
+    if (id >= m * nnz)
+        return;
+
+    CUDA_LONG nzIdx = id / m;          // the nonzero this thread applies
+    int rowInC = (int) (id % m);       // consecutive threads hit consecutive rows: coalesced a and c
+
+    // largest colInC with colCSCIndex[colInC] <= nzIdx
+    int lo = 0;
+    int hi = n - 1;
+    while (lo < hi)
+    {
+        int mid = (lo + hi + 1) / 2;
+        if (colCSCIndex[mid] <= nzIdx)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    int colInC = lo;
+
+    int i = rowIndex[nzIdx];
+    ElemType s = (!transposeA ? a[IDX2C(rowInC, i, m)] : a[IDX2C(i, rowInC, k)]) * bnzValues[nzIdx];
+    atomicAdd(&c[IDX2C(rowInC, colInC, m)], alpha * s);
+}
+
 /// c += alpha * a * b^T
 template <class ElemType>
 __global__ void _dense1DConvMultSparseCSCTransposeAndAddToDense(
@@ -5136,6 +5307,64 @@ __global__ void _copyTopKResults(const uint64_t* indexes, const ElemType* values
     maxValues[id] = values[icol * crow + irow];
 }
 
+// Computes the top-K values and their row indices per column by running topK block-wide
+// argmax rounds over the column instead of sorting it, so the cost is O(topK * crow) per
+// column rather than a full sort. This function processes 1 column per block. Rows that
+// have already been emitted are excluded by the thread that owns them: each thread scans
+// the rows congruent to its index mod BlockSize, so it only needs to remember its own
+// winners (at most topK <= MaxK of them).
+template <int BlockSize, int MaxK, class ElemType>
+__global__ void _vectorTopKMaxReduce(const ElemType* us, ElemType* maxIndexes, ElemType* maxValues,
+                                     const CUDA_LONG crow, const int topK)
+{
+    assert(blockDim.x == BlockSize && topK <= MaxK);
+
+    using BlockReduceT = cub::BlockReduce<cub::KeyValuePair<int, ElemType>, BlockSize>;
+    __shared__ typename BlockReduceT::TempStorage tmp;
+    __shared__ int winner;
+
+    const ElemType* curCol = us + blockIdx.x * crow;
+    int taken[MaxK]; // row indices of this thread's already-emitted winners
+    int numTaken = 0;
+
+    for (int k = 0; k < topK; k++)
+    {
+        // A key of -1 marks "no candidate"; it loses against any real candidate below.
+        cub::KeyValuePair<int, ElemType> best(-1, (ElemType) 0);
+        for (CUDA_LONG irow = threadIdx.x; irow < crow; irow += BlockSize)
+        {
+            bool skip = false;
+            for (int t = 0; t < numTaken; t++)
+                skip |= (taken[t] == irow);
+            if (skip)
+                continue;
+            ElemType v = curCol[irow];
+            // Break ties towards the smaller row index, matching the stable sort path.
+            if (best.key < 0 || v > best.value)
+            {
+                best.key = (int) irow;
+                best.value = v;
+            }
+        }
+        best = BlockReduceT(tmp).Reduce(best, [](const cub::KeyValuePair<int, ElemType>& a, const cub::KeyValuePair<int, ElemType>& b)
+                                        {
+                                            if (b.key < 0 || (a.key >= 0 && (a.value > b.value || (a.value == b.value && a.key < b.key))))
+                                                return a;
+                                            return b;
+                                        });
+        if (threadIdx.x == 0)
+        {
+            winner = best.key;
+            maxIndexes[IDX2C(k, blockIdx.x, topK)] = (ElemType) best.key;
+            maxValues[IDX2C(k, blockIdx.x, topK)] = best.value;
+        }
+        __syncthreads();
+        if (winner >= 0 && winner % BlockSize == (int) threadIdx.x)
+            taken[numTaken++] = winner;
+        __syncthreads(); // tmp is reused in the next round
+    }
+}
+
 template <int BlockSize, class ElemType>
 __global__ void _assignNumOfDiffCol(const ElemType* a, const ElemType* b, ElemType* c, CUDA_LONG crowB, CUDA_LONG ccol)
 {
@@ -5234,6 +5463,124 @@ __global__ void _adam(CUDA_LONG size, ElemType* grad, ElemType* smoothAda, ElemT
     }
 }
 
+// Argument block for the multi-tensor Adam kernel below. Passed to the kernel by value, so the
+// pointer tables travel in the kernel argument space (well under the 4 KB limit) and no device
+// allocation or copy is needed per launch.
+template <class ElemType>
+struct MultiTensorAdamArgs
+{
+    static const int MaxTensors = 32;
+    ElemType* grad[MaxTensors];
+    ElemType* smoothAda[MaxTensors];
+    ElemType* smoothMom[MaxTensors];
+    ElemType* val[MaxTensors];
+    ElemType adaMul[MaxTensors];      // per-tensor bias correction (smoothed counts can differ)
+    CUDA_LONG offset[MaxTensors + 1]; // exclusive prefix sum of the tensors' element counts
+    int count;
+};
+
+// multi-tensor version of _adam: applies the same per-element recurrence to up to MaxTensors
+// parameter tensors in a single launch, so models with hundreds of small parameters do not pay
+// one launch (and one full latency bubble) per tensor. Each thread maps its flat index to the
+// owning tensor with a binary search over the offset table.
+template <class ElemType>
+__global__ void _adamMultiTensor(MultiTensorAdamArgs<ElemType> args, ElemType lr, ElemType mom, ElemType adaWeight,
+                                 ElemType epsilon, bool unitGainMomentum, bool adamax)
+{
+    const ElemType unitGainFactor = unitGainMomentum ? (1.0 - mom) : 1.0;
+    const CUDA_LONG total = args.offset[args.count];
+    CUDA_LONG stride = blockDim.x * gridDim.x;
+    for (CUDA_LONG idx = blockIdx.x * blockDim.x + threadIdx.x; idx < total; idx += stride)
+    {
+        // largest t with offset[t] <= idx
+        int lo = 0;
+        int hi = args.count - 1;
+        while (lo < hi)
+        {
+            int mid = (lo + hi + 1) / 2;
+            if (args.offset[mid] <= idx)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        const CUDA_LONG i = idx - args.offset[lo];
+        ElemType g = args.grad[lo][i];
+        ElemType w;
+        if (!adamax)
+        {
+            ElemType adaSqr = adaWeight * args.smoothAda[lo][i] + (1.0f - adaWeight) * g * g;
+            args.smoothAda[lo][i] = adaSqr;
+            if (sizeof(ElemType) == sizeof(double))
+            {
+                w = args.adaMul[lo] * 1.0 / (sqrt(adaSqr) + epsilon);
+            }
+            else
+            {
+                w = args.adaMul[lo] * 1.0f / (sqrtf(adaSqr) + epsilon);
+            }
+        }
+        else
+        {
+            ElemType gAbs;
+            if (sizeof(ElemType) == sizeof(double))
+            {
+                gAbs = fabs(g);
+            }
+            else
+            {
+                gAbs = fabsf(g);
+            }
+            args.smoothAda[lo][i] = max(adaWeight * args.smoothAda[lo][i], gAbs);
+            w = args.adaMul[lo] / args.smoothAda[lo][i];
+        }
+
+        g = mom * args.smoothMom[lo][i] + unitGainFactor * g;
+        args.smoothMom[lo][i] = g;
+        args.val[lo][i] -= lr * g * w;
+    }
+}
+
+// Argument block for the multi-tensor squared-norm kernel below; like MultiTensorAdamArgs,
+// it is passed by value so the pointer table travels in the kernel argument space.
+template <class ElemType>
+struct MultiTensorNormArgs
+{
+    static const int MaxTensors = 64;
+    const ElemType* data[MaxTensors];
+    CUDA_LONG numElements[MaxTensors];
+    int count;
+};
+
+// computes the squared Frobenius norms of up to MaxTensors tensors in a single launch: one
+// block per tensor, whose threads stride over the tensor's elements and reduce the partial
+// sums in shared memory. A model's worth of per-layer norms thus costs a few launches and
+// one device-to-host copy instead of one synchronizing reduction per tensor.
+template <class ElemType>
+__global__ void _squaredNormsMultiTensor(MultiTensorNormArgs<ElemType> args, ElemType* norms)
+{
+    __shared__ ElemType partialSums[512]; // launched with blockDim.x == 512
+    const int t = blockIdx.x;
+    if (t >= args.count)
+        return;
+
+    const ElemType* data = args.data[t];
+    const CUDA_LONG n = args.numElements[t];
+    ElemType sum = 0;
+    for (CUDA_LONG i = threadIdx.x; i < n; i += blockDim.x)
+        sum += data[i] * data[i];
+    partialSums[threadIdx.x] = sum;
+    __syncthreads();
+
+    for (int stride = blockDim.x / 2; stride > 0; stride >>= 1)
+    {
+        if (threadIdx.x < stride)
+            partialSums[threadIdx.x] += partialSums[threadIdx.x + stride];
+        __syncthreads();
+    }
+    if (threadIdx.x == 0)
+        norms[t] = partialSums[0];
+}
+
 template <class ElemType>
 __global__ void _adam4BlockSparseCol(CUDA_LONG size,
     ElemType* grad_bsc, const GPUSPARSE_INDEX_TYPE* colOrRow2blockId, const size_t len,
@@ -5340,7 +5687,9 @@ __global__ void _adadelta4BlockSparseCol(CUDA_LONG size,
 }
 
 // Calculate alpha in forward-backward calculation. equation (6), (7) in ftp://ftp.idsia.ch/pub/juergen/icml2006.pdf
-// GPU x dimension corresponds to utterances, y dimension corresponds to phone sequence in each utterance
+// One block processes one utterance: the time recursion runs inside the kernel with one barrier
+// per frame, and the block's threads stride over the phone sequence, so the whole forward pass is
+// a single launch rather than one tiny grid per frame.
 // prob (input): the posterior output from the network
 // alpha (output): alpha for forward-backward calculation. 
 // phoneSeq (input): phone ID sequence for each utterance in this minibatch, each col is one utterance 
@@ -5351,7 +5700,6 @@ __global__ void _adadelta4BlockSparseCol(CUDA_LONG size,
 // uttPhoneNum (input): the phone number of each utterance. The size of this vector =  the number of all utterances in this minibatch
 // numChannels (input): channel number in this minibatch
 // uttNum (input): number of utterances
-// t (input): time stamp to process
 // maxPhoneNum (input): the max number of phones between utterances
 // totalPhoneNum (input): the total number of phones of all utterances
 // blankTokenId (input): id of the CTC blank token
@@ -5371,95 +5719,98 @@ __global__ void _assignAlphaScore(
     const size_t *uttPhoneNum,
     size_t numChannels,
     const size_t uttNum,
-    const size_t  t,
     const size_t maxPhoneNum, // Maximum length of utterance in this MB
     const size_t totalPhoneNum, // Total number of phones
     const size_t blankTokenId,
     const int delayConstraint)
 {
-    LONG64 uttId = blockDim.x * blockIdx.x + threadIdx.x;
-    // Index of the label in the sequence
-    LONG64 phoneSeqId = blockDim.y * blockIdx.y + threadIdx.y;
+    LONG64 uttId = blockIdx.x;
+    if (uttId >= uttNum)
+        return;
 
     // Number of phones and frames in this utterance
-    LONG64 phoneNum = uttPhoneNum[uttId]; 
+    LONG64 phoneNum = uttPhoneNum[uttId];
     LONG64 frameNum = uttFrameNum[uttId];
 
-    if (uttId >= uttNum || phoneSeqId >= phoneNum - 1 || t >= frameNum || phoneSeqId == 0) return;
-
-    // Current and previous phone indices in phoneSeq matrix
-    LONG64 labelid = uttId*maxPhoneNum + phoneSeqId;
-    LONG64 labelid_2 = labelid - 2;
-
-    // Actual current phone label
-    LONG64 phoneId = (LONG64)(phoneSeq[labelid]);
+    for (LONG64 t = 0; t < frameNum; t++)
+    {
+        // Index of the label in the sequence
+        for (LONG64 phoneSeqId = 1 + threadIdx.x; phoneSeqId < phoneNum - 1; phoneSeqId += blockDim.x)
+        {
+            // Current and previous phone indices in phoneSeq matrix
+            LONG64 labelid = uttId*maxPhoneNum + phoneSeqId;
+            LONG64 labelid_2 = labelid - 2;
 
-    // Index of the current frame in minibatch
-    LONG64 timeId = (t + uttBeginFrame[uttId])*numChannels + uttToChanInd[uttId];
+            // Actual current phone label
+            LONG64 phoneId = (LONG64)(phoneSeq[labelid]);
 
-    // Index of probability of observing phoneId at frame timeId
-    LONG64 probId = timeId*totalPhoneNum + phoneId;
+            // Index of the current frame in minibatch
+            LONG64 timeId = (t + uttBeginFrame[uttId])*numChannels + uttToChanInd[uttId];
 
-    LONG64 alphaId = maxPhoneNum* timeId + phoneSeqId; // alpha_t(s)
-    // Previous time frame
-    LONG64 timeId_1 = timeId - numChannels; // Index corresponding to (t-1)
-    LONG64 alphaId_0 = maxPhoneNum* timeId_1 + phoneSeqId; // alpha_{t-1}(s)
-    LONG64 alphaId_1 = alphaId_0 - 1; // alpha_{t-1}(s-1)
-    LONG64 alphaId_2 = alphaId_0 - 2; // alpha_{t-1}(s-2)
+            // Index of probability of observing phoneId at frame timeId
+            LONG64 probId = timeId*totalPhoneNum + phoneId;
 
-    if (t == 0)
-    {
-        // Initialize recursion
-        if (phoneSeqId == 1 || phoneSeqId == 2)
-        {
-            alphaScore[alphaId] = prob[probId];
-        }
-    }
-    else
-    {
-        if (phoneSeqId >= 1)
-        {
-            ElemType x = LZERO;
+            LONG64 alphaId = maxPhoneNum* timeId + phoneSeqId; // alpha_t(s)
+            // Previous time frame
+            LONG64 timeId_1 = timeId - numChannels; // Index corresponding to (t-1)
+            LONG64 alphaId_0 = maxPhoneNum* timeId_1 + phoneSeqId; // alpha_{t-1}(s)
+            LONG64 alphaId_1 = alphaId_0 - 1; // alpha_{t-1}(s-1)
+            LONG64 alphaId_2 = alphaId_0 - 2; // alpha_{t-1}(s-2)
 
-            ElemType ascore;
-            if (phoneSeqId > 2)
+            if (t == 0)
             {
-                // if current label is not blank and not equal prev non-blank label
-                if ((LONG64)(phoneSeq[labelid]) != blankTokenId && phoneId != (LONG64)(phoneSeq[labelid_2]))
+                // Initialize recursion
+                if (phoneSeqId == 1 || phoneSeqId == 2)
                 {
-                    x = logaddk(x, alphaScore[alphaId_2]);
+                    alphaScore[alphaId] = prob[probId];
                 }
             }
-
-            if (phoneSeqId > 1)
+            else
             {
-                x = logaddk(x, alphaScore[alphaId_1]);
-            }
+                ElemType x = LZERO;
 
-            x = logaddk(x, alphaScore[alphaId_0]);
+                ElemType ascore;
+                if (phoneSeqId > 2)
+                {
+                    // if current label is not blank and not equal prev non-blank label
+                    if ((LONG64)(phoneSeq[labelid]) != blankTokenId && phoneId != (LONG64)(phoneSeq[labelid_2]))
+                    {
+                        x = logaddk(x, alphaScore[alphaId_2]);
+                    }
+                }
 
-            if (phoneId != SIZE_MAX)
-                ascore = prob[probId]; // Probability of observing given label at given time
-            else
-                ascore = 0;
-            alphaScore[alphaId] = (ElemType)x + ascore;
-            if (delayConstraint != -1)
-            {
-                LONG64 labelid_r = labelid + 2;
-                LONG64 phoneBoundId_r = (LONG64)(phoneBound[labelid_r]);
-                if (phoneId == blankTokenId)
+                if (phoneSeqId > 1)
                 {
-                    // only constraint right side
-                    if (t > phoneBoundId_r + delayConstraint - 1)
-                        alphaScore[alphaId] = LZERO;
+                    x = logaddk(x, alphaScore[alphaId_1]);
                 }
-                else if (phoneId != blankTokenId)
+
+                x = logaddk(x, alphaScore[alphaId_0]);
+
+                if (phoneId != SIZE_MAX)
+                    ascore = prob[probId]; // Probability of observing given label at given time
+                else
+                    ascore = 0;
+                alphaScore[alphaId] = (ElemType)x + ascore;
+                if (delayConstraint != -1)
                 {
-                    if (t > phoneBoundId_r + delayConstraint)
-                        alphaScore[alphaId] = LZERO;
+                    LONG64 labelid_r = labelid + 2;
+                    LONG64 phoneBoundId_r = (LONG64)(phoneBound[labelid_r]);
+                    if (phoneId == blankTokenId)
+                    {
+                        // only constraint right side
+                        if (t > phoneBoundId_r + delayConstraint - 1)
+                            alphaScore[alphaId] = LZERO;
+                    }
+                    else if (phoneId != blankTokenId)
+                    {
+                        if (t > phoneBoundId_r + delayConstraint)
+                            alphaScore[alphaId] = LZERO;
+                    }
                 }
             }
         }
+        // alpha_t must be complete before any thread moves on to frame t+1
+        __syncthreads();
     }
 }
 
@@ -5477,79 +5828,83 @@ __global__ void _assignBetaScore(
     const size_t *uttPhoneNum,
     const size_t numChannels,
     const size_t uttNum,
-    const size_t  t,
     const size_t maxPhoneNum,
     const size_t totalPhoneNum,
     const size_t blankTokenId,
     const int delayConstraint)
 {
-    LONG64 uttId = blockDim.x * blockIdx.x + threadIdx.x;
-    // Index of the label in the sequence
-    LONG64 phoneSeqId = blockDim.y * blockIdx.y + threadIdx.y;
+    LONG64 uttId = blockIdx.x;
+    if (uttId >= uttNum)
+        return;
+
     LONG64 phoneNum = uttPhoneNum[uttId];
     LONG64 frameNum = uttFrameNum[uttId];
 
-    if (uttId >= uttNum || phoneSeqId >= phoneNum - 1 || t >= frameNum || phoneSeqId == 0) return;
-
-    LONG64 labelid = uttId*maxPhoneNum + phoneSeqId;
-    LONG64 labelid_2 = labelid + 2;
-    LONG64 phoneId = (LONG64)(phoneSeq[labelid]);
-    LONG64 timeId = (t + uttBeginFrame[uttId])*numChannels + uttToChanInd[uttId];
-    LONG64 probId = timeId*totalPhoneNum + phoneId;
-    LONG64 betaid = maxPhoneNum* timeId + phoneSeqId;
-    LONG64 timeId_1 = timeId + numChannels;
-    LONG64 betaid_0 = maxPhoneNum* timeId_1 + phoneSeqId;
-    LONG64 betaid_1 = betaid_0 + 1;
-    LONG64 betaid_2 = betaid_0 + 2;
-
-    if (t == frameNum - 1)
-    {
-        if (phoneSeqId == phoneNum - 3 || phoneSeqId == phoneNum - 2)
-        {
-            betaScore[betaid] = prob[probId];
-        }
-    }
-    else
+    for (LONG64 t = frameNum - 1; t >= 0; t--)
     {
-        if (phoneSeqId >= 1)
+        // Index of the label in the sequence
+        for (LONG64 phoneSeqId = 1 + threadIdx.x; phoneSeqId < phoneNum - 1; phoneSeqId += blockDim.x)
         {
-            ElemType x = LZERO;
-            ElemType ascore;
-            if (phoneSeqId < phoneNum - 3)
+            LONG64 labelid = uttId*maxPhoneNum + phoneSeqId;
+            LONG64 labelid_2 = labelid + 2;
+            LONG64 phoneId = (LONG64)(phoneSeq[labelid]);
+            LONG64 timeId = (t + uttBeginFrame[uttId])*numChannels + uttToChanInd[uttId];
+            LONG64 probId = timeId*totalPhoneNum + phoneId;
+            LONG64 betaid = maxPhoneNum* timeId + phoneSeqId;
+            LONG64 timeId_1 = timeId + numChannels;
+            LONG64 betaid_0 = maxPhoneNum* timeId_1 + phoneSeqId;
+            LONG64 betaid_1 = betaid_0 + 1;
+            LONG64 betaid_2 = betaid_0 + 2;
+
+            if (t == frameNum - 1)
             {
-                if (phoneSeq[labelid] != blankTokenId && phoneId != phoneSeq[labelid_2])
+                if (phoneSeqId == phoneNum - 3 || phoneSeqId == phoneNum - 2)
                 {
-                    x = logaddk(x, betaScore[betaid_2]);
+                    betaScore[betaid] = prob[probId];
                 }
             }
-
-            if (phoneSeqId < phoneNum - 2)
-            {
-                x = logaddk(x, betaScore[betaid_1]);
-            }
-
-            x = logaddk(x, betaScore[betaid_0]);
-
-            if (phoneId != SIZE_MAX)
-                ascore = prob[probId];
             else
-                ascore = 0;
-            betaScore[betaid] = (ElemType)x + ascore;
-            if (delayConstraint != -1)
             {
-                LONG64 phoneBoundId_r = (LONG64)(phoneBound[labelid_2]);
-                if (phoneId == blankTokenId)
+                ElemType x = LZERO;
+                ElemType ascore;
+                if (phoneSeqId < phoneNum - 3)
                 {
-                    if (t > phoneBoundId_r + delayConstraint - 1)
-                        betaScore[betaid] = LZERO;
+                    if (phoneSeq[labelid] != blankTokenId && phoneId != phoneSeq[labelid_2])
+                    {
+                        x = logaddk(x, betaScore[betaid_2]);
+                    }
                 }
-                else if (phoneId != blankTokenId)
+
+                if (phoneSeqId < phoneNum - 2)
+                {
+                    x = logaddk(x, betaScore[betaid_1]);
+                }
+
+                x = logaddk(x, betaScore[betaid_0]);
+
+                if (phoneId != SIZE_MAX)
+                    ascore = prob[probId];
+                else
+                    ascore = 0;
+                betaScore[betaid] = (ElemType)x + ascore;
+                if (delayConstraint != -1)
                 {
-                    if (t > phoneBoundId_r + delayConstraint)
-                        betaScore[betaid] = LZERO;
+                    LONG64 phoneBoundId_r = (LONG64)(phoneBound[labelid_2]);
+                    if (phoneId == blankTokenId)
+                    {
+                        if (t > phoneBoundId_r + delayConstraint - 1)
+                            betaScore[betaid] = LZERO;
+                    }
+                    else if (phoneId != blankTokenId)
+                    {
+                        if (t > phoneBoundId_r + delayConstraint)
+                            betaScore[betaid] = LZERO;
+                    }
                 }
             }
         }
+        // beta_t must be complete before any thread moves on to frame t-1
+        __syncthreads();
     }
 }
 
@@ -1134,6 +1134,40 @@ void GPUSparseMatrix<ElemType>::ConvolveAndWeightedAdd(ElemType alpha, const GPU
     {
         if (!transposeB)
         {
+            // For the plain (non-convolutional) product with thin columns, split work per nonzero
+            // instead of per output element. The per-element kernel below loops over the nnz of the
+            // thread's sparse column, so with power-law column occupancy a few heavy columns
+            // serialize whole warps while the rest of the grid drains. The balanced kernel gives
+            // every nonzero its own m threads and finds the owning column by binary search; at
+            // >= 64 average nnz per column the matrix is dense enough that the per-element kernel
+            // is already balanced and avoids the atomic accumulation, so keep it there.
+            size_t nnz = rhs.NzCount();
+            if (numSteps == 1 && !channelwise && nnz > 0 && nnz <= (size_t) n * 64)
+            {
+                // the balanced kernel only accumulates, so fold beta into c up front
+                if (beta == 0)
+                    CUDA_CALL(cudaMemsetAsync(c.Data(), 0, sizeof(ElemType) * cRows * cCols, t_stream));
+                else if (beta != 1)
+                    GPUMatrix<ElemType>::Scale(beta, c);
+
+                int blocksPerGrid = (int) ceil(1.0 * m * nnz / GridDim::maxThreadsPerBlock);
+                SyncGuard syncGuard;
+                _denseMultSparseCSCNnzBalancedAndAddToDense<ElemType><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, t_stream>>>(
+                    m,                 // rowDense
+                    k,                 // colDense
+                    n,                 // colSparse
+                    (CUDA_LONG) nnz,   // nonzeros in the sparse matrix
+                    alpha,
+                    reinterpret_cast<const ElemType*>(lhs.Data()), // dense
+                    transposeA,
+                    reinterpret_cast<const ElemType*>(rhs.Buffer()), // sparse nz values
+                    rhs.RowLocation(),
+                    rhs.ColLocation(),
+                    reinterpret_cast<ElemType*>(c.Data()) // dense target
+                    );
+                return;
+            }
+
             int blocksPerGrid = (int) ceil(1.0 * cRows * cCols / GridDim::maxThreadsPerBlock);
             SyncGuard syncGuard;
             _dense1DConvMultSparseCSCAndWeightedAddToDense<ElemType><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, t_stream>>>(
@@ -1421,6 +1421,59 @@ void Matrix<ElemType>::SetMatrixFromCSCFormat(const CPUSPARSE_INDEX_TYPE* h_CSCC
         { m_GPUSparseMatrix->SetMatrixFromCSCFormat(h_CSCCol, h_Row, h_Val, nz, numRows, numCols, false, -1, transferer); });
 }
 
+// Number of occupied block columns of a sparse block-column matrix
+template <class ElemType>
+size_t Matrix<ElemType>::GetSBCFormatBlockCount() const
+{
+    if (GetFormat() != matrixFormatSparseBlockCol)
+        LogicError("GetSBCFormatBlockCount: matrix must be in sparse block-column format.");
+
+    DISPATCH_MATRIX_ON_FLAG(this, nullptr,
+        { NOT_IMPLEMENTED; },
+        { NOT_IMPLEMENTED; },
+        { return m_CPUSparseMatrix->GetBlockSize(); },
+        { return m_GPUSparseMatrix->GetBlockSize(); });
+}
+
+// Copy the occupied blocks of a sparse block-column matrix to host memory, in the same layout
+// SetMatrixFromSBCFormat() consumes: blockIds[k] is the column held by block k, and block k's
+// dense column data occupies val[k * GetNumRows()] onwards. The caller provides buffers sized
+// by GetSBCFormatBlockCount().
+template <class ElemType>
+void Matrix<ElemType>::CopyMatrixToSBCFormat(size_t* blockIds, ElemType* val) const
+{
+    if (GetFormat() != matrixFormatSparseBlockCol)
+        LogicError("CopyMatrixToSBCFormat: matrix must be in sparse block-column format.");
+
+    DISPATCH_MATRIX_ON_FLAG(this, nullptr,
+        { NOT_IMPLEMENTED; },
+        { NOT_IMPLEMENTED; },
+        {
+            size_t numBlocks = m_CPUSparseMatrix->GetBlockSize();
+            for (size_t i = 0; i < numBlocks; i++)
+                blockIds[i] = m_CPUSparseMatrix->BlockIdsLocation()[i] - m_CPUSparseMatrix->GetBlockIdShift();
+            memcpy(val, m_CPUSparseMatrix->Data(), sizeof(ElemType) * numBlocks * GetNumRows());
+        },
+        {
+            CPUSparseMatrix<ElemType> cpuSparseMatrix(matrixFormatSparseBlockCol, GetNumRows(), GetNumCols(), m_GPUSparseMatrix->GetNumNZElements());
+            m_GPUSparseMatrix->CopyToCPUSparseMatrix(cpuSparseMatrix);
+            size_t numBlocks = cpuSparseMatrix.GetBlockSize();
+            for (size_t i = 0; i < numBlocks; i++)
+                blockIds[i] = cpuSparseMatrix.BlockIdsLocation()[i] - cpuSparseMatrix.GetBlockIdShift();
+            memcpy(val, cpuSparseMatrix.Data(), sizeof(ElemType) * numBlocks * GetNumRows());
+        });
+}
+
+template <class ElemType>
+void Matrix<ElemType>::SetMatrixFromSBCFormat(const size_t* blockIds, const ElemType* val, const size_t numBlocks, const size_t numRows, const size_t numCols)
+{
+    DISPATCH_MATRIX_ON_FLAG(this, this,
+        { NOT_IMPLEMENTED; },
+        { NOT_IMPLEMENTED; },
+        { m_CPUSparseMatrix->SetMatrixFromSBCFormat(blockIds, val, numBlocks, numRows, numCols); },
+        { m_GPUSparseMatrix->SetMatrixFromSBCFormat(blockIds, val, numBlocks, numRows, numCols); });
+}
+
 template <class ElemType>
 void Matrix<ElemType>::SetDiagonalValue(const ElemType v)
 {
@@ -1545,6 +1598,48 @@ void Matrix<ElemType>::SetUniformRandomMask(const ElemType maskRate, const ElemT
                             NOT_IMPLEMENTED);
 }
 
+// [this] = dropoutMask(seed, offset) .* a * scaleValue
+// The mask is a pure function of (seed, offset), so the backward pass can regenerate it via
+// AddDropoutOf with the same arguments instead of storing a mask matrix. 'offset' is the stream
+// position of element 0; slices of a larger matrix pass their element offset into that stream.
+template <class ElemType>
+Matrix<ElemType>& Matrix<ElemType>::AssignDropoutOf(const Matrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset)
+{
+    if (a.IsEmpty())
+        LogicError("AssignDropoutOf: Matrix a is empty.");
+
+    DecideAndMoveToRightDevice(a, *this);
+    SwitchToMatrixType(a.GetMatrixType(), a.GetFormat(), false);
+
+    DISPATCH_MATRIX_ON_FLAG(this,
+                            this,
+                            m_CPUMatrix->AssignDropoutOf(*a.m_CPUMatrix, maskRate, scaleValue, seed, offset),
+                            m_GPUMatrix->AssignDropoutOf(*a.m_GPUMatrix, maskRate, scaleValue, seed, offset),
+                            NOT_IMPLEMENTED,
+                            NOT_IMPLEMENTED);
+
+    return *this;
+}
+
+// [this] += dropoutMask(seed, offset) .* a * scaleValue
+template <class ElemType>
+Matrix<ElemType>& Matrix<ElemType>::AddDropoutOf(const Matrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset)
+{
+    if (a.IsEmpty())
+        LogicError("AddDropoutOf: Matrix a is empty.");
+
+    DecideAndMoveToRightDevice(*this, a);
+
+    DISPATCH_MATRIX_ON_FLAG(this,
+                            this,
+                            m_CPUMatrix->AddDropoutOf(*a.m_CPUMatrix, maskRate, scaleValue, seed, offset),
+                            m_GPUMatrix->AddDropoutOf(*a.m_GPUMatrix, maskRate, scaleValue, seed, offset),
+                            NOT_IMPLEMENTED,
+                            NOT_IMPLEMENTED);
+
+    return *this;
+}
+
 // Vanilla SGD update. 
 // Modifies "this" parameter matrix, on which this method is invoked.
 template <class ElemType>
@@ -1758,8 +1853,12 @@ void Matrix<ElemType>::AdamUpdate(Matrix<ElemType>& gradients, Matrix<ElemType>&
         biasCorrection, (ElemType)epsilon, unitGainMomentum, adamax);
         SetDataLocation(GPU);
     },
-    { NOT_IMPLEMENTED; },
-    { gradients.m_GPUSparseMatrix->Adam(*m_GPUMatrix, *functionValues.m_GPUMatrix, 
+    { gradients.m_CPUSparseMatrix->Adam(*m_CPUMatrix, *functionValues.m_CPUMatrix,
+        (ElemType)learnRatePerSample, (ElemType)meanMomentum, (ElemType)varMomentum,
+        biasCorrection, (ElemType)epsilon, smoothedCount, unitGainMomentum, adamax);
+        SetDataLocation(CPU);
+    },
+    { gradients.m_GPUSparseMatrix->Adam(*m_GPUMatrix, *functionValues.m_GPUMatrix,
         (ElemType)learnRatePerSample, (ElemType)meanMomentum, 
         (ElemType)varMomentum, biasCorrection, (ElemType)epsilon, unitGainMomentum, adamax); 
         SetDataLocation(GPU); });
@@ -1767,6 +1866,92 @@ void Matrix<ElemType>::AdamUpdate(Matrix<ElemType>& gradients, Matrix<ElemType>&
     // Note: Since both 'this' and gradients are changed, we must call SetDataLocation() on 'this' as well.
 }
 
+template <class ElemType>
+/*static*/ void Matrix<ElemType>::BatchAdamUpdate(const std::vector<Matrix<ElemType>*>& smoothedGradients, const std::vector<Matrix<ElemType>*>& gradients,
+    const std::vector<Matrix<ElemType>*>& functionValues, const std::vector<double*>& smoothedCounts,
+    const double learnRatePerSample, const double meanMomentum, const double varMomentum, const double epsilon, bool unitGainMomentum, bool adamax)
+{
+    assert(smoothedGradients.size() == gradients.size() && functionValues.size() == gradients.size() && smoothedCounts.size() == gradients.size());
+
+    // the fused multi-tensor path requires every tensor to be a dense GPU matrix on one device
+    bool batchable = !gradients.empty();
+    for (size_t i = 0; batchable && i < gradients.size(); i++)
+    {
+        batchable = gradients[i]->GetMatrixType() == MatrixType::DENSE && gradients[i]->GetDeviceId() >= 0 &&
+                    gradients[i]->GetDeviceId() == gradients[0]->GetDeviceId() &&
+                    functionValues[i]->GetMatrixType() == MatrixType::DENSE &&
+                    functionValues[i]->GetDeviceId() == gradients[0]->GetDeviceId() &&
+                    smoothedGradients[i]->GetDeviceId() == gradients[0]->GetDeviceId();
+    }
+    if (!batchable)
+    {
+        for (size_t i = 0; i < gradients.size(); i++)
+            smoothedGradients[i]->AdamUpdate(*gradients[i], *functionValues[i], *smoothedCounts[i],
+                                             learnRatePerSample, meanMomentum, varMomentum, epsilon, unitGainMomentum, adamax);
+        return;
+    }
+
+    std::vector<GPUMatrix<ElemType>*> gpuSmoothed(gradients.size()), gpuGradients(gradients.size()), gpuValues(gradients.size());
+    std::vector<ElemType> adaMuls(gradients.size());
+    for (size_t i = 0; i < gradients.size(); i++)
+    {
+        // per-tensor bias correction, same as AdamUpdate()
+        double& smoothedCount = *smoothedCounts[i];
+        smoothedCount++;
+        adaMuls[i] = adamax ? (ElemType)(1. / (1 - pow(meanMomentum, smoothedCount)))
+                            : (ElemType)(sqrt(1 - pow(varMomentum, smoothedCount)) / (1 - pow(meanMomentum, smoothedCount)));
+
+        size_t numColsNeeded = 2 * gradients[i]->GetNumCols();
+        if (smoothedGradients[i]->IsEmpty() || smoothedGradients[i]->GetNumCols() < numColsNeeded)
+        {
+            smoothedGradients[i]->Resize(gradients[i]->GetNumRows(), numColsNeeded);
+            smoothedGradients[i]->SetValue(0.0);
+        }
+
+        gpuSmoothed[i] = smoothedGradients[i]->m_GPUMatrix.get();
+        gpuGradients[i] = gradients[i]->m_GPUMatrix.get();
+        gpuValues[i] = functionValues[i]->m_GPUMatrix.get();
+    }
+
+    GPUMatrix<ElemType>::BatchAdamUpdate(gpuSmoothed, gpuGradients, gpuValues, adaMuls,
+                                         (ElemType) learnRatePerSample, (ElemType) meanMomentum, (ElemType) varMomentum, (ElemType) epsilon,
+                                         unitGainMomentum, adamax);
+
+    for (size_t i = 0; i < gradients.size(); i++)
+    {
+        smoothedGradients[i]->SetDataLocation(GPU);
+        functionValues[i]->SetDataLocation(GPU);
+    }
+}
+
+template <class ElemType>
+/*static*/ void Matrix<ElemType>::BatchSquaredFrobeniusNorms(const std::vector<const Matrix<ElemType>*>& inputs, std::vector<ElemType>& norms)
+{
+    norms.resize(inputs.size());
+
+    // the fused multi-tensor path requires every tensor to be a dense GPU matrix on one device
+    bool batchable = !inputs.empty();
+    for (size_t i = 0; batchable && i < inputs.size(); i++)
+    {
+        batchable = inputs[i]->GetMatrixType() == MatrixType::DENSE && inputs[i]->GetDeviceId() >= 0 &&
+                    inputs[i]->GetDeviceId() == inputs[0]->GetDeviceId();
+    }
+    if (!batchable)
+    {
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            ElemType norm = inputs[i]->FrobeniusNorm();
+            norms[i] = norm * norm;
+        }
+        return;
+    }
+
+    std::vector<const GPUMatrix<ElemType>*> gpuInputs(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++)
+        gpuInputs[i] = inputs[i]->m_GPUMatrix.get();
+    GPUMatrix<ElemType>::BatchSquaredFrobeniusNorms(gpuInputs, norms);
+}
+
 template <class ElemType>
 ElemType Matrix<ElemType>::RmsProp(Matrix<ElemType>& gradients,
                                    ElemType RMS_GAMMA,
@@ -3812,6 +3997,46 @@ MatrixFormat Matrix<ElemType>::GetFormat() const
     return m_baseMatrix->GetFormat();
 }
 
+// typed-handle fast path: bind directly to the underlying storage object, bypassing
+// DISPATCH_MATRIX_ON_FLAG for subsequent calls. See the declaration for the validity rules.
+template <class ElemType>
+shared_ptr<const CPUMatrix<ElemType>> Matrix<ElemType>::TryGetCPUDenseHandle() const
+{
+    if (m_matrixType != MatrixType::DENSE ||
+        (m_currentDataLocation != CurrentDataLocation::CPU && m_currentDataLocation != CurrentDataLocation::BOTH))
+        return nullptr;
+    return m_CPUMatrix;
+}
+
+template <class ElemType>
+shared_ptr<const GPUMatrix<ElemType>> Matrix<ElemType>::TryGetGPUDenseHandle() const
+{
+    if (m_matrixType != MatrixType::DENSE ||
+        (m_currentDataLocation != CurrentDataLocation::GPU && m_currentDataLocation != CurrentDataLocation::BOTH))
+        return nullptr;
+    return m_GPUMatrix;
+}
+
+template <class ElemType>
+shared_ptr<CPUMatrix<ElemType>> Matrix<ElemType>::TryGetWritableCPUDenseHandle()
+{
+    if (TryGetCPUDenseHandle() == nullptr)
+        return nullptr;
+    // writes through the handle must not leave a stale GPU twin behind
+    SetDataLocation(CurrentDataLocation::CPU, MatrixType::DENSE);
+    return m_CPUMatrix;
+}
+
+template <class ElemType>
+shared_ptr<GPUMatrix<ElemType>> Matrix<ElemType>::TryGetWritableGPUDenseHandle()
+{
+    if (TryGetGPUDenseHandle() == nullptr)
+        return nullptr;
+    // writes through the handle must not leave a stale CPU twin behind
+    SetDataLocation(CurrentDataLocation::GPU, MatrixType::DENSE);
+    return m_GPUMatrix;
+}
+
 // TODO: Comment why we need a second ElemType.
 // TODO: Move the shared core functions to the front of this source file.
 // BUGBUG: This performs a copy operation even for the output matrix that gets overwritten right away.
@@ -4683,7 +4908,7 @@ void Matrix<ElemType>::RNNForward(const Matrix<ElemType> &inputX, const Matrix<E
 
     DISPATCH_MATRIX_ON_FLAG(this,
                             this,
-                            NOT_IMPLEMENTED,
+                            m_CPUMatrix->RNNForward(*(inputX.m_CPUMatrix), *(paramW.m_CPUMatrix), xDim, yDim, numSequencesForFrame, rnnAttributes, *(reserve.m_CPUMatrix), *(workspace.m_CPUMatrix)),
                             m_GPUMatrix->RNNForward(*(inputX.m_GPUMatrix), *(paramW.m_GPUMatrix), xDim, yDim, numSequencesForFrame, rnnAttributes, *(reserve.m_GPUMatrix), *(workspace.m_GPUMatrix)),
                             NOT_IMPLEMENTED,
                             NOT_IMPLEMENTED);
@@ -4698,7 +4923,7 @@ void Matrix<ElemType>::RNNBackwardData(const Matrix<ElemType>& outputDY, const M
     workspace._transferToDevice(GetDeviceId());
     DISPATCH_MATRIX_ON_FLAG(this,
                             this,
-                            NOT_IMPLEMENTED,
+                            m_CPUMatrix->RNNBackwardData(*(outputDY.m_CPUMatrix), *(paramW.m_CPUMatrix), *(outputDX.m_CPUMatrix), rnnAttributes, *(reserve.m_CPUMatrix), *(workspace.m_CPUMatrix)),
                             m_GPUMatrix->RNNBackwardData(*(outputDY.m_GPUMatrix), *(paramW.m_GPUMatrix), *(outputDX.m_GPUMatrix), rnnAttributes, *(reserve.m_GPUMatrix), *(workspace.m_GPUMatrix)),
                             NOT_IMPLEMENTED,
                             NOT_IMPLEMENTED);
@@ -4713,7 +4938,7 @@ void Matrix<ElemType>::RNNBackwardWeights(const Matrix<ElemType>& inputX, const
     workspace._transferToDevice(GetDeviceId());
     DISPATCH_MATRIX_ON_FLAG(this,
                             this,
-                            NOT_IMPLEMENTED,
+                            m_CPUMatrix->RNNBackwardWeights(*(inputX.m_CPUMatrix), *(outputY.m_CPUMatrix), *(dw.m_CPUMatrix), rnnAttributes, *(reserve.m_CPUMatrix), *(workspace.m_CPUMatrix)),
                             m_GPUMatrix->RNNBackwardWeights(*(inputX.m_GPUMatrix), *(outputY.m_GPUMatrix), *(dw.m_GPUMatrix), rnnAttributes, *(reserve.m_GPUMatrix), *(workspace.m_GPUMatrix)),
                             NOT_IMPLEMENTED,
                             NOT_IMPLEMENTED);
@@ -4909,6 +5134,60 @@ void Matrix<ElemType>::MultiplyAndWeightedAdd(ElemType alpha, const Matrix<ElemT
     }
 }
 
+/// <summary>Grouped matrix-matrix multiply: c[i] = alpha * op(a[i]) * op(b[i]) + beta * c[i] for all i</summary>
+/// All products in the group are issued in one call, which amortizes per-call dispatch on the CPU
+/// (the group is partitioned across threads) and kernel-launch overhead on the GPU (a single
+/// batched GEMM). Intended for the many small per-timestep products of recurrent loops.
+/// Falls back to one MultiplyAndWeightedAdd per entry when operands are sparse or on mixed devices.
+template <class ElemType>
+void Matrix<ElemType>::BatchedMultiplyAndWeightedAdd(ElemType alpha, const std::vector<const Matrix<ElemType>*>& a, const bool transposeA, const std::vector<const Matrix<ElemType>*>& b, const bool transposeB,
+                                                     ElemType beta, const std::vector<Matrix<ElemType>*>& c)
+{
+    if (a.size() != b.size() || a.size() != c.size())
+        InvalidArgument("BatchedMultiplyAndWeightedAdd: a, b, and c must contain the same number of matrices.");
+    if (a.empty())
+        return;
+
+    // the grouped paths require all operands dense and on one device
+    int deviceId = c[0]->GetDeviceId();
+    bool canGroup = true;
+    for (size_t i = 0; i < a.size() && canGroup; i++)
+    {
+        canGroup = a[i]->GetMatrixType() == MatrixType::DENSE && b[i]->GetMatrixType() == MatrixType::DENSE && c[i]->GetMatrixType() == MatrixType::DENSE &&
+                   a[i]->GetDeviceId() == deviceId && b[i]->GetDeviceId() == deviceId && c[i]->GetDeviceId() == deviceId;
+    }
+    if (!canGroup)
+    {
+        for (size_t i = 0; i < a.size(); i++)
+            MultiplyAndWeightedAdd(alpha, *a[i], transposeA, *b[i], transposeB, beta, *c[i]);
+        return;
+    }
+
+    if (deviceId < 0) // CPU: each product is too small to parallelize internally, so parallelize across the group
+    {
+        long count = (long) a.size();
+#pragma omp parallel for
+        for (long i = 0; i < count; i++)
+            CPUMatrix<ElemType>::MultiplyAndWeightedAdd(alpha, *a[i]->m_CPUMatrix, transposeA, *b[i]->m_CPUMatrix, transposeB, beta, *c[i]->m_CPUMatrix);
+        for (size_t i = 0; i < c.size(); i++)
+            c[i]->SetDataLocation(CPU, DENSE);
+    }
+    else // GPU: single batched GEMM
+    {
+        std::vector<const GPUMatrix<ElemType>*> gpuA(a.size()), gpuB(b.size());
+        std::vector<GPUMatrix<ElemType>*> gpuC(c.size());
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            gpuA[i] = a[i]->m_GPUMatrix.get();
+            gpuB[i] = b[i]->m_GPUMatrix.get();
+            gpuC[i] = c[i]->m_GPUMatrix.get();
+        }
+        GPUMatrix<ElemType>::BatchedMultiplyAndWeightedAdd(alpha, gpuA, transposeA, gpuB, transposeB, beta, gpuC);
+        for (size_t i = 0; i < c.size(); i++)
+            c[i]->SetDataLocation(GPU, DENSE);
+    }
+}
+
 template <class ElemType>
 /*static*/ void Matrix<ElemType>::Multiply1x1AndWeightedAdd(ElemType alpha, const Matrix<ElemType>& a, const Matrix<ElemType>& b, ElemType beta, Matrix<ElemType>& c)
 {
@@ -18,6 +18,7 @@
 #include <limits.h>
 #include <memory> // for shared_ptr
 #include <array>
+#include <vector>
 #include <initializer_list>
 #include "QuantizedOperations.h"
 
@@ -171,6 +172,22 @@ public:
     // Same as TransferFromDeviceToDevice() but moves only if it is currently not on the target device
     void TransferToDeviceIfNotThere(int id_to, bool isBeingMoved = false, bool emptyTransfer = false, bool updatePreferredDevice = true) const;
     CurrentDataLocation GetCurrentMatrixLocation() const { return m_currentDataLocation; };
+
+    // typed-handle fast path:
+    // Every member function routes through DISPATCH_MATRIX_ON_FLAG, which re-checks the data
+    // location and matrix type on each call. That overhead is measurable in tight per-timestep
+    // loops over small matrices. Call sites that know their matrix stays put (e.g. once per node
+    // per minibatch, after all inputs have settled on their devices) can grab a typed handle and
+    // invoke CPUMatrix/GPUMatrix methods directly. Returns nullptr when the matrix is not dense
+    // or not (at least partly) resident on the respective device.
+    // The handle shares ownership of the storage object, so it never dangles; but a device
+    // transfer or format change swaps in a *new* storage object which a stale handle will not
+    // see. Re-acquire after any operation that may move the matrix. The writable variants also
+    // collapse a BOTH location onto the handle's device, so writes cannot leave a stale twin.
+    shared_ptr<const CPUMatrix<ElemType>> TryGetCPUDenseHandle() const;
+    shared_ptr<const GPUMatrix<ElemType>> TryGetGPUDenseHandle() const;
+    shared_ptr<CPUMatrix<ElemType>> TryGetWritableCPUDenseHandle();
+    shared_ptr<GPUMatrix<ElemType>> TryGetWritableGPUDenseHandle();
     void SwitchToMatrixType(MatrixType newMatrixType, MatrixFormat newMatrixFormat, bool keepValues); // sets matrix type between dense and sparse
     size_t GetNumRows() const;
     size_t GetNumCols() const;
@@ -215,6 +232,20 @@ public:
     void AdamUpdate(Matrix<ElemType>& gradients, Matrix<ElemType>& functionValues, double& smoothedCount,
         const double learnRatePerSample, const double meanMomentum, const double varMomentum, const double epsilon, bool unitGainMomentum = true, bool adamax = false);
 
+    // Adam update of a whole parameter set at once (multi-tensor batching). When all matrices
+    // are dense GPU matrices on one device, the updates are fused into a few kernel launches;
+    // otherwise this degrades to per-tensor AdamUpdate() calls. smoothedCounts are incremented
+    // per tensor, so tensors restored from different checkpoints stay correctly bias-corrected.
+    static void BatchAdamUpdate(const std::vector<Matrix<ElemType>*>& smoothedGradients, const std::vector<Matrix<ElemType>*>& gradients,
+        const std::vector<Matrix<ElemType>*>& functionValues, const std::vector<double*>& smoothedCounts,
+        const double learnRatePerSample, const double meanMomentum, const double varMomentum, const double epsilon, bool unitGainMomentum = true, bool adamax = false);
+
+    // Squared Frobenius norms of a whole set of tensors at once (multi-tensor batching).
+    // When all matrices are dense GPU matrices on one device, the norms are computed in a few
+    // launches and brought back with a single device-to-host copy; otherwise this degrades to
+    // one FrobeniusNorm() call (and one synchronization) per tensor.
+    static void BatchSquaredFrobeniusNorms(const std::vector<const Matrix<ElemType>*>& inputs, std::vector<ElemType>& norms);
+
     ElemType RmsProp(Matrix<ElemType>& gradients, ElemType RMS_GAMMA, ElemType RMS_WGT_INC, ElemType RMS_WGT_MAX, ElemType RMS_WGT_DEC, ElemType RMS_WGT_MIN, const bool needAveMultiplier);
 
     void AdaDeltaUpdate(Matrix<ElemType>& gradients, Matrix<ElemType>& functionvalues, ElemType learningRatePerSample, ElemType rho, ElemType epsilon);
@@ -283,6 +314,13 @@ public:
     void SetMatrixFromCSCFormat(const CPUSPARSE_INDEX_TYPE* h_CSCCol, const CPUSPARSE_INDEX_TYPE* h_Row, const ElemType* h_Val,
         const size_t nz, const size_t numRows, const size_t numCols, DataTransferer* transferer = nullptr);
 
+    // Host-side access to the (block ids, block data) representation of a sparse
+    // block-column matrix, so occupied blocks can be exchanged (e.g. across MPI ranks)
+    // without inflating the matrix to its dense size
+    size_t GetSBCFormatBlockCount() const;
+    void CopyMatrixToSBCFormat(size_t* blockIds, ElemType* val) const;
+    void SetMatrixFromSBCFormat(const size_t* blockIds, const ElemType* val, const size_t numBlocks, const size_t numRows, const size_t numCols);
+
     void MaskColumnsValue(const Matrix<char>& columnsMask, ElemType val, size_t numColsPerMaskEntry);
 
     void SetColumn(const ElemType* colPointer, size_t colInd);
@@ -294,6 +332,8 @@ public:
     void SetUniformRandomValue(const ElemType low, const ElemType high, unsigned long seed = USE_TIME_BASED_SEED);
     void SetGaussianRandomValue(const ElemType mean, const ElemType sigma, unsigned long seed = USE_TIME_BASED_SEED);
     void SetUniformRandomMask(const ElemType maskRate, const ElemType scaleValue, RNGHandle& rngHandle);
+    Matrix<ElemType>& AssignDropoutOf(const Matrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset);
+    Matrix<ElemType>& AddDropoutOf(const Matrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset);
     void AddGaussianRandomValue(const ElemType mean, const ElemType sigma, unsigned long seed = USE_TIME_BASED_SEED);
     Matrix<ElemType>& AssignNoiseContrastiveEstimation(const Matrix<ElemType>& a, const Matrix<ElemType>& b, const Matrix<ElemType>& c, const Matrix<ElemType>& bias, Matrix<ElemType>& tmp);
 
@@ -564,6 +604,10 @@ public:
     static void SVD(const Matrix<ElemType>& A, Matrix<ElemType>& SIGMA, Matrix<ElemType>& U, Matrix<ElemType>& VT, Matrix<ElemType>& W);
 
     static void MultiplyAndWeightedAdd(ElemType alpha, const Matrix<ElemType>& a, const bool transposeA, const Matrix<ElemType>& b, const bool transposeB, ElemType beta, Matrix<ElemType>& c, shared_ptr<QuantizedMultiplier<ElemType>> pQuantizedMultiplier=nullptr); // SGEMM
+    // grouped variant: computes c[i] = alpha * op(a[i]) * op(b[i]) + beta * c[i] for all i in one call,
+    // amortizing per-call dispatch (CPU) and kernel-launch overhead (GPU) over many small products,
+    // e.g. the per-timestep GEMMs of a recurrent loop
+    static void BatchedMultiplyAndWeightedAdd(ElemType alpha, const std::vector<const Matrix<ElemType>*>& a, const bool transposeA, const std::vector<const Matrix<ElemType>*>& b, const bool transposeB, ElemType beta, const std::vector<Matrix<ElemType>*>& c);
     static void MultiplyAndAdd(const Matrix<ElemType>& a, const bool transposeA, const Matrix<ElemType>& b, const bool transposeB, Matrix<ElemType>& c);
     static void Multiply(const Matrix<ElemType>& a, const bool transposeA, const Matrix<ElemType>& b, const bool transposeB, Matrix<ElemType>& c);
     static void Multiply(const Matrix<ElemType>& a, const Matrix<ElemType>& b, Matrix<ElemType>& c);
@@ -664,6 +708,142 @@ File& operator<<(File& stream, const Matrix<ElemType>& M)
     return stream;
 }
 
+// -----------------------------------------------------------------------
+// move-aware arithmetic operators
+// -----------------------------------------------------------------------
+// The member operators allocate a fresh result matrix on every call, so composed expressions
+// like 'C = A + B * s' used to allocate once per operator. When an operand is a temporary
+// (everything but the leftmost operand of a chain), the overloads below run the operation in
+// place on the temporary's buffer instead: the whole composition then costs one allocation (the
+// first temporary, moved through the chain into the destination) and lowers to the same
+// Scale/ScaleAndAdd/+= calls that hand-written Assign*Of code would make. Reuse requires a dense
+// temporary whose dimensions cover the other operand (the in-place operators broadcast row and
+// column vectors but not 1x1 scalars); anything else falls back to the copying operator.
+
+// can 'reuse' serve as the in-place accumulator for an elementwise op with operand 'a'?
+template <class ElemType>
+inline bool CanReuseBufferForElementwiseOp(const Matrix<ElemType>& a, const Matrix<ElemType>& reuse)
+{
+    if (a.IsEmpty() || reuse.IsEmpty() ||
+        a.GetMatrixType() != MatrixType::DENSE || reuse.GetMatrixType() != MatrixType::DENSE)
+        return false;
+    // 'a' must be same-size, a broadcastable column vector, or a broadcastable row vector
+    return (a.GetNumRows() == reuse.GetNumRows() && (a.GetNumCols() == reuse.GetNumCols() || a.GetNumCols() == 1)) ||
+           (a.GetNumCols() == reuse.GetNumCols() && a.GetNumRows() == 1);
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator+(const Matrix<ElemType>& a, Matrix<ElemType>&& b)
+{
+    if (CanReuseBufferForElementwiseOp(a, b))
+    {
+        b += a;
+        return std::move(b);
+    }
+    return a + static_cast<const Matrix<ElemType>&>(b);
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator+(Matrix<ElemType>&& a, const Matrix<ElemType>& b)
+{
+    if (CanReuseBufferForElementwiseOp(b, a))
+    {
+        a += b;
+        return std::move(a);
+    }
+    return static_cast<const Matrix<ElemType>&>(a) + b;
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator+(Matrix<ElemType>&& a, Matrix<ElemType>&& b)
+{
+    if (CanReuseBufferForElementwiseOp(b, a))
+    {
+        a += b;
+        return std::move(a);
+    }
+    return static_cast<const Matrix<ElemType>&>(a) + std::move(b);
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator-(Matrix<ElemType>&& a, const Matrix<ElemType>& b)
+{
+    if (CanReuseBufferForElementwiseOp(b, a))
+    {
+        a -= b;
+        return std::move(a);
+    }
+    return static_cast<const Matrix<ElemType>&>(a) - b;
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator-(const Matrix<ElemType>& a, Matrix<ElemType>&& b)
+{
+    if (CanReuseBufferForElementwiseOp(a, b))
+    {
+        // a - b == (-b) + a, exactly (negation and addition commute bitwise for IEEE floats)
+        b *= (ElemType) -1;
+        b += a;
+        return std::move(b);
+    }
+    return a - static_cast<const Matrix<ElemType>&>(b);
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator-(Matrix<ElemType>&& a, Matrix<ElemType>&& b)
+{
+    if (CanReuseBufferForElementwiseOp(b, a))
+    {
+        a -= b;
+        return std::move(a);
+    }
+    return static_cast<const Matrix<ElemType>&>(a) - std::move(b);
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator+(Matrix<ElemType>&& a, ElemType alpha)
+{
+    if (!a.IsEmpty() && a.GetMatrixType() == MatrixType::DENSE)
+    {
+        a += alpha;
+        return std::move(a);
+    }
+    return static_cast<const Matrix<ElemType>&>(a) + alpha;
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator-(Matrix<ElemType>&& a, ElemType alpha)
+{
+    if (!a.IsEmpty() && a.GetMatrixType() == MatrixType::DENSE)
+    {
+        a -= alpha;
+        return std::move(a);
+    }
+    return static_cast<const Matrix<ElemType>&>(a) - alpha;
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator*(Matrix<ElemType>&& a, ElemType alpha)
+{
+    if (!a.IsEmpty() && a.GetMatrixType() == MatrixType::DENSE)
+    {
+        a *= alpha;
+        return std::move(a);
+    }
+    return static_cast<const Matrix<ElemType>&>(a) * alpha;
+}
+
+template <class ElemType>
+inline Matrix<ElemType> operator/(Matrix<ElemType>&& a, ElemType alpha)
+{
+    if (!a.IsEmpty() && a.GetMatrixType() == MatrixType::DENSE)
+    {
+        a /= alpha;
+        return std::move(a);
+    }
+    return static_cast<const Matrix<ElemType>&>(a) / alpha;
+}
+
 typedef Matrix<float> SingleMatrix;
 typedef Matrix<double> DoubleMatrix;
 
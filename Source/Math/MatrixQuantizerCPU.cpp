@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "MatrixQuantizerCPU.h"
+#include "ColumnQuantizerSimd.h"
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
@@ -9,29 +10,17 @@ MatrixQuantizerCPU<ElemType>::MatrixQuantizerCPU()
 {
 }
 
+// quantize a contiguous range of columns; columns are independent, so the loop is parallel
 template <class ElemType>
-void MatrixQuantizerCPU<ElemType>::QuantizeAsync(const Matrix<ElemType>& inMatrix, const Matrix<ElemType>& inResidual, QuantizedMatrix<ElemType>& outQMatrix, Matrix<ElemType>& outResidual, bool zeroThresholdFor1Bit)
+void MatrixQuantizerCPU<ElemType>::QuantizeColumnRange(const Matrix<ElemType>& inMatrix, const Matrix<ElemType>& inResidual, QuantizedMatrix<ElemType>& outQMatrix, Matrix<ElemType>& outResidual, bool zeroThresholdFor1Bit,
+                                                       size_t colBegin, size_t colEnd)
 {
-    // The outQMatrix should be on the CPU
-    // TODO: Support transferring the quantization output to a quantized matrix on the GPU
-    assert(outQMatrix.GetDeviceId() == CPUDEVICE);
-
     size_t nBits = outQMatrix.GetNumBits();
-
     size_t nRow = inMatrix.GetNumRows();
-    size_t nCol = inMatrix.GetNumCols();
-
-    // Verify that the different matrix parameters have matching dimensions
-    assert((outQMatrix.GetNumRows() == nRow) && (outQMatrix.GetNumCols() == nCol));
-    assert((inResidual.GetNumRows() == nRow) && (inResidual.GetNumCols() == nCol));
-    assert((outResidual.GetNumRows() == nRow) && (outResidual.GetNumCols() == nCol));
 
     const size_t ldNbits = ValueQuantizer<ElemType>::ld(nBits);
-#ifdef QUANTUSEPPL
-    Concurrency::parallel_for((size_t) 0, us.cols(), [&](size_t j)
-#else
-    for (size_t j = 0; j < nCol; j++)
-#endif
+#pragma omp parallel for
+    for (ptrdiff_t j = (ptrdiff_t) colBegin; j < (ptrdiff_t) colEnd; j++)
     {
         auto& qcol = *(outQMatrix.GetQuantizedColumn(j));
         if (zeroThresholdFor1Bit)
@@ -45,6 +34,15 @@ void MatrixQuantizerCPU<ElemType>::QuantizeAsync(const Matrix<ElemType>& inMatri
             ColumnQuantizer<ElemType>::template ComputeRangeStatColj<false>(inMatrix.Data(), inResidual.Data(), (long) nRow, j, nBits, qcol.lower, qcol.upper);
         }
 
+        // vectorized 1-bit float path; produces the identical bits and residuals
+        if (nBits == 1 &&
+            TryQuantizeColumn1BitSimd(zeroThresholdFor1Bit,
+                                      inMatrix.Data() + j * nRow, inResidual.Data() + j * nRow, nRow,
+                                      qcol.bits, qcol.lower, qcol.upper, outResidual.Data() + j * nRow))
+        {
+            continue;
+        }
+
         ColumnQuantizer<ElemType> q(ldNbits, qcol.lower, qcol.upper);
         if (zeroThresholdFor1Bit)
         {
@@ -57,9 +55,45 @@ void MatrixQuantizerCPU<ElemType>::QuantizeAsync(const Matrix<ElemType>& inMatri
             q.template Quantize<false>(inMatrix.Data(), inResidual.Data(), (long) nRow, j, qcol.bits, outResidual.Data());
         }
     }
-#ifdef QUANTUSEPPL
-    );
-#endif
+}
+
+template <class ElemType>
+void MatrixQuantizerCPU<ElemType>::QuantizeAsync(const Matrix<ElemType>& inMatrix, const Matrix<ElemType>& inResidual, QuantizedMatrix<ElemType>& outQMatrix, Matrix<ElemType>& outResidual, bool zeroThresholdFor1Bit)
+{
+    // The outQMatrix should be on the CPU
+    // TODO: Support transferring the quantization output to a quantized matrix on the GPU
+    assert(outQMatrix.GetDeviceId() == CPUDEVICE);
+
+    size_t nRow = inMatrix.GetNumRows();
+    size_t nCol = inMatrix.GetNumCols();
+
+    // Verify that the different matrix parameters have matching dimensions
+    assert((outQMatrix.GetNumRows() == nRow) && (outQMatrix.GetNumCols() == nCol));
+    assert((inResidual.GetNumRows() == nRow) && (inResidual.GetNumCols() == nCol));
+    assert((outResidual.GetNumRows() == nRow) && (outResidual.GetNumCols() == nCol));
+    UNUSED(nRow);
+
+    QuantizeColumnRange(inMatrix, inResidual, outQMatrix, outResidual, zeroThresholdFor1Bit, 0, nCol);
+}
+
+template <class ElemType>
+void MatrixQuantizerCPU<ElemType>::QuantizePipelined(const Matrix<ElemType>& inMatrix, const Matrix<ElemType>& inResidual, QuantizedMatrix<ElemType>& outQMatrix, Matrix<ElemType>& outResidual, bool zeroThresholdFor1Bit,
+                                                     size_t colsPerChunk, const std::function<void(size_t colBegin, size_t colEnd)>& onColumnsReady)
+{
+    assert(outQMatrix.GetDeviceId() == CPUDEVICE);
+
+    size_t nCol = inMatrix.GetNumCols();
+    if (colsPerChunk == 0)
+        colsPerChunk = nCol;
+
+    // quantize chunk by chunk, handing each finished range to the caller right away so the
+    // aggregator can overlap its transfer with the quantization of the remaining columns
+    for (size_t colBegin = 0; colBegin < nCol; colBegin += colsPerChunk)
+    {
+        size_t colEnd = std::min(colBegin + colsPerChunk, nCol);
+        QuantizeColumnRange(inMatrix, inResidual, outQMatrix, outResidual, zeroThresholdFor1Bit, colBegin, colEnd);
+        onColumnsReady(colBegin, colEnd);
+    }
 }
 
 template <class ElemType>
@@ -84,19 +118,21 @@ void MatrixQuantizerCPU<ElemType>::UnquantizeAsync(QuantizedMatrix<ElemType>& in
     assert((outMatrix.GetNumRows() == nRow) && (outMatrix.GetNumCols() == nCol));
 
     const size_t ldNbits = ValueQuantizer<ElemType>::ld(nBits);
-#ifdef QUANTUSEPPL
-    Concurrency::parallel_for((size_t) 0, us.cols(), [&](size_t j)
-#else
-    for (size_t j = 0; j < nCol; j++)
-#endif
+#pragma omp parallel for
+    for (ptrdiff_t j = 0; j < (ptrdiff_t) nCol; j++)
     {
         const auto& qcol = *(inQMatrix.GetQuantizedColumn(j));
+
+        // vectorized 1-bit float path; produces identical values
+        if (nBits == 1 &&
+            TryUnquantizeColumn1BitSimd(outMatrix.Data() + j * nRow, nRow, qcol.bits, qcol.lower, qcol.upper, add))
+        {
+            continue;
+        }
+
         ColumnQuantizer<ElemType> q(ldNbits, qcol.lower, qcol.upper);
         q.Unquantize(outMatrix.Data(), (long) nRow, j, qcol.bits, add);
     }
-#ifdef QUANTUSEPPL
-    );
-#endif
 }
 
 template <class ElemType>
@@ -33,5 +33,13 @@ public:
 
     void UnquantizeAsync(QuantizedMatrix<ElemType>& inQMatrix, Matrix<ElemType>& outMatrix, bool add = false) override;
     void WaitUnquantizeAsyncDone() override;
+
+    // chunked quantization that signals each finished column range, overlapping with transfer
+    void QuantizePipelined(const Matrix<ElemType>& inMatrix, const Matrix<ElemType>& inResidual, QuantizedMatrix<ElemType>& outQMatrix, Matrix<ElemType>& outResidual, bool zeroThresholdFor1Bit,
+                           size_t colsPerChunk, const std::function<void(size_t colBegin, size_t colEnd)>& onColumnsReady) override;
+
+private:
+    void QuantizeColumnRange(const Matrix<ElemType>& inMatrix, const Matrix<ElemType>& inResidual, QuantizedMatrix<ElemType>& outQMatrix, Matrix<ElemType>& outResidual, bool zeroThresholdFor1Bit,
+                             size_t colBegin, size_t colEnd);
 };
 } } }
@@ -3,6 +3,8 @@
 #include "ColumnQuantizer.h"
 #include "QuantizedMatrix.h"
 
+#include <functional>
+
 #ifdef _WIN32
 #ifdef MATH_EXPORTS
 #define MATH_API __declspec(dllexport)
@@ -33,6 +35,21 @@ public:
     virtual void UnquantizeAsync(QuantizedMatrix<ElemType>& inQMatrix, Matrix<ElemType>& outMatrix, bool add = false) = 0;
     virtual void WaitUnquantizeAsyncDone() = 0;
 
+    // Pipelined variant for overlapping quantization with aggregation: quantizes the matrix in
+    // contiguous column ranges and invokes onColumnsReady(colBegin, colEnd) as each range
+    // completes, so the caller can hand finished ranges to the gradient aggregator (i.e. start
+    // the MPI transfer) while the remaining columns are still being quantized. The default
+    // implementation quantizes everything and signals one range; implementations that can chunk
+    // cheaply override it.
+    virtual void QuantizePipelined(const Matrix<ElemType>& inMatrix, const Matrix<ElemType>& inResidual, QuantizedMatrix<ElemType>& outQMatrix, Matrix<ElemType>& outResidual, bool zeroThresholdFor1Bit,
+                                   size_t colsPerChunk, const std::function<void(size_t colBegin, size_t colEnd)>& onColumnsReady)
+    {
+        UNUSED(colsPerChunk);
+        QuantizeAsync(inMatrix, inResidual, outQMatrix, outResidual, zeroThresholdFor1Bit);
+        WaitQuantizeAsyncDone();
+        onColumnsReady(0, inMatrix.GetNumCols());
+    }
+
     int GetDeviceId() const
     {
         return m_deviceId;
@@ -9,6 +9,7 @@
 #include "GPUMatrix.h"
 #include <nccl.h>
 #include <cuda_runtime.h>
+#include <cstring>
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
@@ -19,16 +20,24 @@ static void operator||(cudaError_t rc, const char *msg)
         RuntimeError("%s: %s (cuda error %d)", msg, cudaGetErrorString(rc), (int) rc);
 }
 
-NcclComm::NcclComm(int deviceId, const MPIWrapperPtr& mpi)
-    : m_ncclComm(nullptr), m_stream(nullptr)
+NcclComm::NcclComm(int deviceId, const MPIWrapperPtr& mpi, bool intraHostWhenMultiHost)
+    : m_ncclComm(nullptr), m_stream(nullptr), m_deviceId(deviceId), m_fp16Scratch(nullptr), m_fp16ScratchCount(0),
+      m_spansAllRanks(!mpi->IsMultiHost())
 {
-    if (mpi->IsMultiHost())
+    if (mpi->IsMultiHost() && !(intraHostWhenMultiHost && mpi->NumRanksOnHost() >= 2))
         return;
 
     size_t numRanks = mpi->NumNodesInUse();
     std::vector<int> allDevs(numRanks);
     mpi->Allgather(&deviceId, 1, MPI_INT, allDevs.data(), 1, MPI_INT);
 
+    // Gather which host root each rank belongs to, so devices only need to be distinct
+    // among the ranks sharing a host; all ranks see the same data and thus reach the
+    // same enable/disable decision.
+    int myHostRoot = (int)mpi->CurrentHostRootRank();
+    std::vector<int> allHostRoots(numRanks);
+    mpi->Allgather(&myHostRoot, 1, MPI_INT, allHostRoots.data(), 1, MPI_INT);
+
     for (size_t r = 0; r<numRanks; r++)
     {
         if (allDevs[r] == CPUDEVICE)
@@ -37,7 +46,7 @@ NcclComm::NcclComm(int deviceId, const MPIWrapperPtr& mpi)
             return;
         }
         for (size_t s = 0; s<r; s++)
-            if (allDevs[r] == allDevs[s])
+            if (allHostRoots[r] == allHostRoots[s] && allDevs[r] == allDevs[s])
             {
                 fprintf(stderr, "NcclComm: disabled, same device used by more than one rank\n");
                 return;
@@ -51,20 +60,41 @@ NcclComm::NcclComm(int deviceId, const MPIWrapperPtr& mpi)
     if (res != ncclSuccess)
         RuntimeError("NcclComm failed to obtain ncclUniqueId: %s", ncclGetErrorString(res));
 
-    mpi->Bcast(&ncclId, NCCL_UNIQUE_ID_BYTES, MPI_CHAR, 0);
+    if (m_spansAllRanks)
+    {
+        mpi->Bcast(&ncclId, NCCL_UNIQUE_ID_BYTES, MPI_CHAR, 0);
 
-    PrepareDevice(deviceId);
-    res = ncclCommInitRank(&m_ncclComm, numRanks, ncclId, mpi->CurrentNodeRank());
-    if (res != ncclSuccess)
-      RuntimeError("NcclComm failed to initialize ncclComm_t: %s", ncclGetErrorString(res));
+        PrepareDevice(deviceId);
+        res = ncclCommInitRank(&m_ncclComm, numRanks, ncclId, mpi->CurrentNodeRank());
+        if (res != ncclSuccess)
+          RuntimeError("NcclComm failed to initialize ncclComm_t: %s", ncclGetErrorString(res));
+    }
+    else
+    {
+        // one communicator per host: every rank generates an id, allgathers them, and
+        // adopts the id generated by its host's root rank
+        std::vector<char> allIds(numRanks * NCCL_UNIQUE_ID_BYTES);
+        mpi->Allgather(&ncclId, NCCL_UNIQUE_ID_BYTES, MPI_CHAR, allIds.data(), NCCL_UNIQUE_ID_BYTES, MPI_CHAR);
+        memcpy(&ncclId, allIds.data() + (size_t)myHostRoot * NCCL_UNIQUE_ID_BYTES, NCCL_UNIQUE_ID_BYTES);
+
+        PrepareDevice(deviceId);
+        res = ncclCommInitRank(&m_ncclComm, mpi->NumRanksOnHost(), ncclId, mpi->CurrentRankOnHost());
+        if (res != ncclSuccess)
+          RuntimeError("NcclComm failed to initialize ncclComm_t: %s", ncclGetErrorString(res));
+    }
 
     cudaStreamCreateWithFlags(&m_stream, cudaStreamDefault)
         || "cudaStreamCreateWithFlags failed";
-    fprintf(stderr, "NcclComm: initialized\n");
+    if (m_spansAllRanks)
+        fprintf(stderr, "NcclComm: initialized\n");
+    else
+        fprintf(stderr, "NcclComm: initialized for the %d ranks on this host\n", (int)mpi->NumRanksOnHost());
 }
 
 NcclComm::~NcclComm()
 {
+    if (m_fp16Scratch != nullptr)
+        TracingGPUMemoryAllocator::Free<char>(m_deviceId, (char*)m_fp16Scratch, true);
     if (m_stream != nullptr)
         cudaStreamDestroy(m_stream);
     if (m_ncclComm != nullptr)
@@ -76,6 +106,11 @@ bool NcclComm::IsSupported()
     return m_ncclComm != nullptr;
 }
 
+bool NcclComm::SpansAllRanks() const
+{
+    return m_spansAllRanks;
+}
+
 void NcclComm::AllReduceImpl(void* inputbuffer, void *outputbuffer, size_t count, DataType dtype)
 {
     ncclResult_t res;
@@ -83,6 +118,10 @@ void NcclComm::AllReduceImpl(void* inputbuffer, void *outputbuffer, size_t count
     {
         res = ncclAllReduce(inputbuffer, outputbuffer, count, ncclFloat, ncclSum, m_ncclComm, m_stream);
     }
+    else if (dtype == DataType::HALF)
+    {
+        res = ncclAllReduce(inputbuffer, outputbuffer, count, ncclHalf, ncclSum, m_ncclComm, m_stream);
+    }
     else
     {
         assert(dtype == DataType::DOUBLE);
@@ -93,6 +132,55 @@ void NcclComm::AllReduceImpl(void* inputbuffer, void *outputbuffer, size_t count
         RuntimeError("NcclComm ncclAllReduce failed: %s", ncclGetErrorString(res));
 }
 
+void NcclComm::AllReduceFp16Impl(float* inputBuffer, float* outputBuffer, size_t count)
+{
+    if (count == 0)
+        return;
+
+    if (count > m_fp16ScratchCount)
+    {
+        if (m_fp16Scratch != nullptr)
+            TracingGPUMemoryAllocator::Free<char>(m_deviceId, (char*)m_fp16Scratch);
+        m_fp16Scratch = TracingGPUMemoryAllocator::Allocate<char>(m_deviceId, count * 2); // __half is 2 bytes
+        m_fp16ScratchCount = count;
+    }
+
+    // cast-reduce-cast, entirely on the device and ordered on the communicator's stream
+    CudaFloatToHalf(inputBuffer, m_fp16Scratch, count, m_stream);
+    AllReduceImpl(m_fp16Scratch, m_fp16Scratch, count, DataType::HALF);
+    CudaHalfToFloat(m_fp16Scratch, outputBuffer, count, m_stream);
+}
+
+void NcclComm::ReduceScatterImpl(const void* inputBuffer, void* outputBuffer, size_t count, DataType dtype)
+{
+    ncclDataType_t ncclType = (dtype == DataType::FLOAT) ? ncclFloat : ncclDouble;
+    ncclResult_t res = ncclReduceScatter(inputBuffer, outputBuffer, count, ncclType, ncclSum, m_ncclComm, m_stream);
+    if (res != ncclSuccess)
+        RuntimeError("NcclComm ncclReduceScatter failed: %s", ncclGetErrorString(res));
+}
+
+void NcclComm::AllGatherImpl(const void* inputBuffer, void* outputBuffer, size_t count, DataType dtype)
+{
+    ncclDataType_t ncclType = (dtype == DataType::FLOAT) ? ncclFloat : ncclDouble;
+    ncclResult_t res;
+    // NCCL 2 changed the argument order of ncclAllGather
+#if defined(NCCL_MAJOR) && (NCCL_MAJOR >= 2)
+    res = ncclAllGather(inputBuffer, outputBuffer, count, ncclType, m_ncclComm, m_stream);
+#else
+    res = ncclAllGather(inputBuffer, (int)count, ncclType, outputBuffer, m_ncclComm, m_stream);
+#endif
+    if (res != ncclSuccess)
+        RuntimeError("NcclComm ncclAllGather failed: %s", ncclGetErrorString(res));
+}
+
+void NcclComm::BcastImpl(void* buffer, size_t count, DataType dtype, int root)
+{
+    ncclDataType_t ncclType = (dtype == DataType::FLOAT) ? ncclFloat : ncclDouble;
+    ncclResult_t res = ncclBcast(buffer, count, ncclType, root, m_ncclComm, m_stream);
+    if (res != ncclSuccess)
+        RuntimeError("NcclComm ncclBcast failed: %s", ncclGetErrorString(res));
+}
+
 void NcclComm::BroadcastImpl(void* buffer, size_t count, MPI_Datatype dtype, int root)
 {
     ncclResult_t res;
@@ -120,7 +208,7 @@ void NcclComm::Sync()
 #else // !USE_NCCL
 namespace Microsoft { namespace MSR { namespace CNTK {
 
-NcclComm::NcclComm(int /*deviceId*/, const MPIWrapperPtr& /*mpi*/) { }
+NcclComm::NcclComm(int /*deviceId*/, const MPIWrapperPtr& /*mpi*/, bool /*intraHostWhenMultiHost*/) { }
 
 NcclComm::~NcclComm() { }
 
@@ -129,6 +217,11 @@ bool NcclComm::IsSupported()
     return false;
 }
 
+bool NcclComm::SpansAllRanks() const
+{
+    return true;
+}
+
 void NcclComm::Sync() { }
 
 }}} // end namespaces
@@ -24,17 +24,29 @@ class NcclComm
 {
 #ifdef USE_NCCL
 private:
-    enum class DataType : int {FLOAT, DOUBLE};
+    enum class DataType : int {FLOAT, DOUBLE, HALF};
     void AllReduceImpl(void* inputbuffer, void* outputbuffer, size_t count, DataType dtype);
+    void AllReduceFp16Impl(float* inputBuffer, float* outputBuffer, size_t count);
+    void ReduceScatterImpl(const void* inputBuffer, void* outputBuffer, size_t count, DataType dtype);
+    void AllGatherImpl(const void* inputBuffer, void* outputBuffer, size_t count, DataType dtype);
     void BroadcastImpl(void* buffer, size_t count, MPI_Datatype dtype, int root);
+    void BcastImpl(void* buffer, size_t count, DataType dtype, int root);
     cudaStream_t m_stream;
     ncclComm_t m_ncclComm;
+    int m_deviceId;
+    void* m_fp16Scratch;       // device scratch of m_fp16ScratchCount __half values for cast-reduce-cast
+    size_t m_fp16ScratchCount;
+    bool m_spansAllRanks;      // false if the communicator covers only the ranks on our host
 #endif
 
 public:
-    NcclComm(int deviceId, const MPIWrapperPtr& mpiComm);
+    // When intraHostWhenMultiHost is set and the job spans multiple hosts, a communicator
+    // covering just the ranks on our host is created (for hierarchical aggregation) instead
+    // of disabling NCCL altogether.
+    NcclComm(int deviceId, const MPIWrapperPtr& mpiComm, bool intraHostWhenMultiHost = false);
     ~NcclComm();
     bool IsSupported();
+    bool SpansAllRanks() const; // true if the communicator covers every MPI rank
     void Sync(); // waits for outstanding reductions to complete
     
     template <typename ElemType>
@@ -53,8 +65,10 @@ public:
 #endif
     }
 
+    // When compressFp16 is set, float gradients are cast to fp16 on the device, reduced as
+    // fp16 and cast back, halving inter-node bandwidth at the cost of reduction precision.
     template <typename ElemType>
-    void AllReduce(const std::vector<Matrix<ElemType>*>& grads)
+    void AllReduce(const std::vector<Matrix<ElemType>*>& grads, bool compressFp16 = false)
     {
 #ifdef USE_NCCL
         DataType dtype = DataType::FLOAT;
@@ -63,17 +77,77 @@ public:
         else if (!std::is_same<ElemType, float>::value)
             RuntimeError("NcclComm Unsupported reduction type");
 
+        if (compressFp16 && dtype != DataType::FLOAT)
+            RuntimeError("NcclComm fp16-compressed AllReduce requires float data");
+
         for (size_t i=0; i<grads.size(); ++i)
         {
             if (grads[i]->Data() == nullptr) // Hack in case of eval
                 continue;
-            AllReduceImpl(grads[i]->Data(), grads[i]->Data(), grads[i]->GetNumElements(), dtype);
+            if (compressFp16)
+                AllReduceFp16Impl((float*)grads[i]->Data(), (float*)grads[i]->Data(), grads[i]->GetNumElements());
+            else
+                AllReduceImpl(grads[i]->Data(), grads[i]->Data(), grads[i]->GetNumElements(), dtype);
         }
 #else
         RuntimeError("NcclComm: CNTK was built without NCCL support.");
 #endif
     }
 
+    // Reduces the element-wise sum of all ranks' inputBuffer and scatters the result: this
+    // rank receives its shard of 'count' elements in outputBuffer; inputBuffer must hold
+    // count * numRanks elements, laid out in rank order.
+    template <typename ElemType>
+    void ReduceScatter(const ElemType* inputBuffer, ElemType* outputBuffer, size_t count)
+    {
+#ifdef USE_NCCL
+        DataType dtype = DataType::FLOAT;
+        if (std::is_same<ElemType, double>::value)
+            dtype = DataType::DOUBLE;
+        else if (!std::is_same<ElemType, float>::value)
+            RuntimeError("NcclComm Unsupported ReduceScatter type");
+
+        ReduceScatterImpl(inputBuffer, outputBuffer, count, dtype);
+#else
+        RuntimeError("NcclComm: CNTK was built without NCCL support.");
+#endif
+    }
+
+    // Gathers 'count' elements from every rank; outputBuffer must hold count * numRanks elements,
+    // laid out in rank order.
+    template <typename ElemType>
+    void AllGather(const ElemType* inputBuffer, ElemType* outputBuffer, size_t count)
+    {
+#ifdef USE_NCCL
+        DataType dtype = DataType::FLOAT;
+        if (std::is_same<ElemType, double>::value)
+            dtype = DataType::DOUBLE;
+        else if (!std::is_same<ElemType, float>::value)
+            RuntimeError("NcclComm Unsupported AllGather type");
+
+        AllGatherImpl(inputBuffer, outputBuffer, count, dtype);
+#else
+        RuntimeError("NcclComm: CNTK was built without NCCL support.");
+#endif
+    }
+
+    // Broadcasts a device buffer from 'root' to all ranks, e.g. for checkpoint distribution.
+    template <typename ElemType>
+    void Broadcast(ElemType* buffer, size_t count, int root)
+    {
+#ifdef USE_NCCL
+        DataType dtype = DataType::FLOAT;
+        if (std::is_same<ElemType, double>::value)
+            dtype = DataType::DOUBLE;
+        else if (!std::is_same<ElemType, float>::value)
+            RuntimeError("NcclComm Unsupported Broadcast type");
+
+        BcastImpl(buffer, count, dtype, root);
+#else
+        RuntimeError("NcclComm: CNTK was built without NCCL support.");
+#endif
+    }
+
     void Broadcast(void* buffer, size_t count, MPI_Datatype dtype, int root)
     {
 #ifdef USE_NCCL
@@ -1097,6 +1097,18 @@ void GPUMatrix<ElemType>::SetUniformRandomMask(const ElemType maskRate, const El
 {
 }
 
+template <class ElemType>
+GPUMatrix<ElemType>& GPUMatrix<ElemType>::AssignDropoutOf(const GPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset)
+{
+    return *this;
+}
+
+template <class ElemType>
+GPUMatrix<ElemType>& GPUMatrix<ElemType>::AddDropoutOf(const GPUMatrix<ElemType>& a, const ElemType maskRate, const ElemType scaleValue, const uint64_t seed, const uint64_t offset)
+{
+    return *this;
+}
+
 template <class ElemType>
 ElemType GPUMatrix<ElemType>::Adagrad(GPUMatrix<ElemType>& gradients, const bool needAveMultiplier)
 {
@@ -1115,6 +1127,19 @@ void GPUMatrix<ElemType>::Adam(GPUMatrix<ElemType>& gradients, GPUMatrix<ElemTyp
 
 }
 
+template <class ElemType>
+void GPUMatrix<ElemType>::BatchAdamUpdate(const std::vector<GPUMatrix<ElemType>*>& smoothedGradients, const std::vector<GPUMatrix<ElemType>*>& gradients,
+    const std::vector<GPUMatrix<ElemType>*>& functionValues, const std::vector<ElemType>& adaMuls,
+    ElemType learnRatePerSample, ElemType momentum, ElemType adaWeight, ElemType epsilon,
+    bool unitGainMomentum, bool adamax)
+{
+}
+
+template <class ElemType>
+void GPUMatrix<ElemType>::BatchSquaredFrobeniusNorms(const std::vector<const GPUMatrix<ElemType>*>& inputs, std::vector<ElemType>& norms)
+{
+}
+
 template <class ElemType>
 ElemType GPUMatrix<ElemType>::RmsProp(GPUMatrix<ElemType>& gradients, ElemType RMS_GAMMA, ElemType RMS_WGT_INC, ElemType RMS_WGT_MAX, ElemType RMS_WGT_DEC, ElemType RMS_WGT_MIN, const bool needAveMultiplier)
 {
@@ -1948,6 +1973,11 @@ void GPUMatrix<ElemType>::MultiplyAndWeightedAdd(ElemType alpha, const GPUMatrix
 {
 }
 template <class ElemType>
+void GPUMatrix<ElemType>::BatchedMultiplyAndWeightedAdd(ElemType alpha, const std::vector<const GPUMatrix<ElemType>*>& /*a*/, const bool transposeA, const std::vector<const GPUMatrix<ElemType>*>& /*b*/, const bool transposeB,
+                                                        ElemType beta, const std::vector<GPUMatrix<ElemType>*>& /*c*/)
+{
+}
+template <class ElemType>
 void GPUMatrix<ElemType>::Multiply1x1AndWeightedAdd(ElemType alpha, const GPUMatrix<ElemType>& lhs, const GPUMatrix<ElemType>& rhs, ElemType beta, GPUMatrix<ElemType>& c)
 {
 }
@@ -2310,10 +2340,18 @@ void GranularGPUDataTransferer::WaitForSyncPointOnFetchStreamAsync() {}
 
 void GranularGPUDataTransferer::WaitForSyncPointOnAssignStreamAsync() {}
 
-PrefetchGPUDataTransferer::PrefetchGPUDataTransferer(int /*deviceId*/) : GranularGPUDataTransferer() {}
+PinnedStagingRing::PinnedStagingRing(int deviceId, size_t /*numBuffers*/) : m_deviceId(deviceId) {}
+
+PinnedStagingRing::~PinnedStagingRing() {}
+
+void* PinnedStagingRing::GetNextBuffer(size_t /*size*/) { return nullptr; }
+
+PrefetchGPUDataTransferer::PrefetchGPUDataTransferer(int /*deviceId*/, size_t /*numStagingBuffers*/) : GranularGPUDataTransferer() {}
 
 PrefetchGPUDataTransferer::~PrefetchGPUDataTransferer() {}
 
+void PrefetchGPUDataTransferer::CopyCPUToGPUStagedAsync(const void* /*cpuBuffer*/, size_t /*numElements*/, size_t /*elementSize*/, void* /*gpuBuffer*/) {}
+
 GPUDataTransferer::GPUDataTransferer(int, bool){}
 GPUDataTransferer::~GPUDataTransferer(){}
 void GPUDataTransferer::CopyGPUToCPUAsync(void*, size_t, void*){}
@@ -2400,6 +2438,54 @@ float CudaTimer::Elapsed()
 
 /*static*/ bool SyncGuard::IsSyncEnabled() { return false; }
 
+MatrixStreamPool::StreamGuard::StreamGuard(int /*slot*/)
+    : m_prevStream(nullptr)
+{
+}
+
+MatrixStreamPool::StreamGuard::~StreamGuard()
+{
+}
+
+/*static*/ void MatrixStreamPool::RecordEvent(int /*slot*/)
+{
+}
+
+/*static*/ void MatrixStreamPool::AddDependency(int /*slot*/, int /*producerSlot*/)
+{
+}
+
+/*static*/ void MatrixStreamPool::SynchronizeAll()
+{
+}
+
+/*static*/ bool CudaGraphCache::IsSupported()
+{
+    return false;
+}
+
+/*static*/ bool CudaGraphCache::Replay(size_t /*key*/)
+{
+    return false;
+}
+
+/*static*/ bool CudaGraphCache::BeginCapture(size_t /*key*/)
+{
+    return false;
+}
+
+/*static*/ void CudaGraphCache::EndCapture(size_t /*key*/)
+{
+}
+
+/*static*/ void CudaGraphCache::Invalidate(size_t /*key*/)
+{
+}
+
+/*static*/ void CudaGraphCache::InvalidateAll()
+{
+}
+
 } } }
 
 // define a dummy GPUWatcher class too
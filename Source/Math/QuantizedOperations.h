@@ -3,6 +3,8 @@
 // Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
 //
 #pragma once
+#include <type_traits>
+#include <cstring>
 #include "Quantizers.h"
 
 namespace Microsoft { namespace MSR { namespace CNTK {
@@ -11,16 +13,23 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 // Quantized product of two dense matrices A and B, where each matrix has its own quantizer.
 // This class handles quantization of both matrices, product and de-quantization of the result.
 // Other implementations should inherit from this class or extract common methods to the base class and inherit from the base.
-template <class ElemType>
+// QuantType selects the quantized element type; short (the default) preserves more precision,
+// int8_t doubles the SIMD lanes available to the block kernels at some accuracy cost.
+// The accumulation is always done in int32.
+template <class ElemType, class QuantType = short>
 class QuantizedMultiplier
 {
+    static_assert(std::is_same<QuantType, short>::value || std::is_same<QuantType, int8_t>::value,
+        "QuantizedMultiplier supports short and int8_t quantized types");
+
     // Quantizers for matrices A and B
-    shared_ptr<QuantizerBase<ElemType, short>> m_pQuantizerA;
-    shared_ptr<QuantizerBase<ElemType, short>> m_pQuantizerB;
+    shared_ptr<QuantizerBase<ElemType, QuantType>> m_pQuantizerA;
+    shared_ptr<QuantizerBase<ElemType, QuantType>> m_pQuantizerB;
 
     // Placeholders for quantized matrices A and B
-    vector<short> m_pMatA, m_pMatB;
+    vector<QuantType> m_pMatA, m_pMatB;
 
+protected:
     // Whether matrices A and B are constant (i.e. weights)
     // If the matrix is constant, the size of the underlying container for quatized values will be preserved for
     // the lifespan of the object
@@ -29,33 +38,35 @@ class QuantizedMultiplier
 
     bool m_firstPass;
 
-public: 
-    QuantizedMultiplier(shared_ptr<QuantizerBase<ElemType, short>> pQuantizerA, bool isAConstant, shared_ptr<QuantizerBase<ElemType, short>> pQuantizerB, bool isBConstant) :
+public:
+    QuantizedMultiplier(shared_ptr<QuantizerBase<ElemType, QuantType>> pQuantizerA, bool isAConstant, shared_ptr<QuantizerBase<ElemType, QuantType>> pQuantizerB, bool isBConstant) :
         m_pQuantizerA(pQuantizerA), m_pQuantizerB(pQuantizerB), m_isAConstant(isAConstant), m_isBConstant(isBConstant), m_firstPass(true)
     {
         if (isAConstant && isBConstant)
             LogicError("Quantized multiplication is applied to two constant matrices -- it is highly inefficient. Better approach is to replace the operation with the resulting matrix.");
     };
-    QuantizedMultiplier(shared_ptr<QuantizerBase<ElemType, short>> pQuantizerA, shared_ptr<QuantizerBase<ElemType, short>> pQuantizerB) :
+    QuantizedMultiplier(shared_ptr<QuantizerBase<ElemType, QuantType>> pQuantizerA, shared_ptr<QuantizerBase<ElemType, QuantType>> pQuantizerB) :
         QuantizedMultiplier(pQuantizerA, false, pQuantizerB, false)
     {
     };
 
+    virtual ~QuantizedMultiplier() = default;
+
     // A[m,k]*B[k,n] = C[m,n]
-    void Multiply(int m, int n, int k, ElemType* A, ElemType* B, ElemType* C)
+    virtual void Multiply(int m, int n, int k, ElemType* A, ElemType* B, ElemType* C)
     {
         // Quantize
         if (!m_isAConstant || m_firstPass)
         {
             m_pMatA.resize(m*k);
-            ArrayRef<short> refMatA(m_pMatA.data(), m_pMatA.size());
+            ArrayRef<QuantType> refMatA(m_pMatA.data(), m_pMatA.size());
             m_pQuantizerA->Quantize(ArrayRef<ElemType>(A, m_pMatA.size()), refMatA);
         }
         
         if (!m_isBConstant || m_firstPass)
         {
             m_pMatB.resize(n*k);
-            ArrayRef<short> refMatB(m_pMatB.data(), m_pMatB.size());
+            ArrayRef<QuantType> refMatB(m_pMatB.data(), m_pMatB.size());
             m_pQuantizerB->Quantize(ArrayRef<ElemType>(B, m_pMatB.size()), refMatB);
         }
 
@@ -67,7 +78,7 @@ public:
         for (size_t i = 0; i < m; i++)
             for (size_t j = 0; j < n; j++)
             {
-                int dotProduct=0;
+                int32_t dotProduct = 0;
                 for (size_t l = 0; l < k; l++)
                 {
                     // CNTK is using column-major storage
@@ -86,4 +97,153 @@ public:
     void SetIsBConstant(bool v) { m_isBConstant = v; }
 };
 
+// Software conversion between fp32 and IEEE 754 binary16 ("half"). Round to nearest even,
+// matching what hardware converters (F16C, GPU) produce; overflow goes to infinity,
+// values below 2^-24 flush to (signed) zero through rounding.
+static inline unsigned short Float32ToFloat16(float v)
+{
+    unsigned int x;
+    memcpy(&x, &v, sizeof(x));
+    unsigned short sign = (unsigned short) ((x >> 16) & 0x8000);
+    x &= 0x7FFFFFFF;
+    if (x >= 0x7F800000) // INF/NaN
+        return (unsigned short) (sign | (x > 0x7F800000 ? 0x7E00 : 0x7C00));
+    unsigned int exp = x >> 23;
+    unsigned int mant = x & 0x7FFFFF;
+    if (exp > 142) // too large for half -> INF
+        return (unsigned short) (sign | 0x7C00);
+    if (exp >= 113) // normal half
+    {
+        unsigned short h = (unsigned short) (((exp - 112) << 10) | (mant >> 13));
+        unsigned int rem = mant & 0x1FFF;
+        if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) // round to nearest even; carry may overflow to INF, which is correct
+            h++;
+        return (unsigned short) (sign | h);
+    }
+    // subnormal half (or zero)
+    unsigned int shift = 126 - exp;
+    if (shift > 24)
+        return sign;
+    unsigned int m24 = mant | 0x800000;
+    unsigned short h = (unsigned short) (m24 >> shift);
+    unsigned int rem = m24 & ((1u << shift) - 1);
+    unsigned int half = 1u << (shift - 1);
+    if (rem > half || (rem == half && (h & 1))) // carry into the smallest normal is correct as well
+        h++;
+    return (unsigned short) (sign | h);
+}
+
+static inline float Float16ToFloat32(unsigned short h)
+{
+    unsigned int sign = (unsigned int) (h & 0x8000) << 16;
+    unsigned int exp = (h >> 10) & 0x1F;
+    unsigned int mant = h & 0x3FF;
+    unsigned int x;
+    if (exp == 0)
+    {
+        if (mant == 0)
+            x = sign;
+        else
+        {
+            // normalize the subnormal
+            exp = 113;
+            while ((mant & 0x400) == 0)
+            {
+                mant <<= 1;
+                exp--;
+            }
+            x = sign | (exp << 23) | ((mant & 0x3FF) << 13);
+        }
+    }
+    else if (exp == 31) // INF/NaN
+        x = sign | 0x7F800000 | (mant << 13);
+    else
+        x = sign | ((exp + 112) << 23) | (mant << 13);
+    float f;
+    memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+// Half-precision product of two dense matrices A and B. Constant matrices (typically weights)
+// are stored as IEEE 754 binary16, halving their memory footprint; they are widened back to
+// full precision on the fly during the product, so accumulation keeps fp32 accuracy.
+// Unlike QuantizedMultiplier there is no quantizer to configure: fp16 keeps ~3 decimal digits
+// over a wide dynamic range, which is enough for inference with typically-scaled trained weights.
+template <class ElemType>
+class HalfPrecisionMultiplier : public QuantizedMultiplier<ElemType>
+{
+    // fp16 copies of the constant matrices; preserved for the lifespan of the object
+    vector<unsigned short> m_pMatA16, m_pMatB16;
+
+    // fp32 scratch a panel of the fp16 matrix A is widened into; bounded by c_panelSize columns
+    // so it stays small relative to the fp16 storage that delivers the memory win
+    vector<ElemType> m_widenedA;
+
+    static const int c_panelSize = 64;
+
+    static void Narrow(const ElemType* src, size_t count, vector<unsigned short>& dst)
+    {
+        dst.resize(count);
+#pragma omp parallel for
+        for (long long i = 0; i < (long long) count; i++)
+            dst[i] = Float32ToFloat16((float) src[i]);
+    }
+
+public:
+    HalfPrecisionMultiplier(bool isAConstant = false, bool isBConstant = false) :
+        QuantizedMultiplier<ElemType>(nullptr, isAConstant, nullptr, isBConstant)
+    {
+    };
+
+    // A[m,k]*B[k,n] = C[m,n]
+    void Multiply(int m, int n, int k, ElemType* A, ElemType* B, ElemType* C) override
+    {
+        // Narrow constant inputs to fp16 once; they keep that representation from then on.
+        if (this->m_isAConstant && this->m_firstPass)
+            Narrow(A, (size_t) m * k, m_pMatA16);
+        if (this->m_isBConstant && this->m_firstPass)
+            Narrow(B, (size_t) k * n, m_pMatB16);
+        this->m_firstPass = false;
+
+        // SAXPY-ordered product: the inner loop is contiguous in both A and C (CNTK is using
+        // column-major storage) and auto-vectorizes. A is reused for every output column, so it
+        // is widened panel by panel into fp32 scratch; B elements are consumed once each and
+        // widened inline.
+        for (int l0 = 0; l0 < k; l0 += c_panelSize)
+        {
+            int panel = (k - l0 < c_panelSize) ? (k - l0) : c_panelSize;
+            const ElemType* pA;
+            if (this->m_isAConstant)
+            {
+                m_widenedA.resize((size_t) m * panel);
+#pragma omp parallel for
+                for (long long i = 0; i < (long long) m * panel; i++)
+                    m_widenedA[i] = (ElemType) Float16ToFloat32(m_pMatA16[(size_t) l0 * m + i]);
+                pA = m_widenedA.data();
+            }
+            else
+                pA = A + (size_t) l0 * m;
+
+#pragma omp parallel for
+            for (long long j = 0; j < n; j++)
+            {
+                ElemType* pc = C + (size_t) j * m;
+                if (l0 == 0)
+                {
+                    for (long long i = 0; i < m; i++)
+                        pc[i] = 0;
+                }
+                for (int l = 0; l < panel; l++)
+                {
+                    size_t ib = (size_t) j * k + l0 + l;
+                    ElemType bval = this->m_isBConstant ? (ElemType) Float16ToFloat32(m_pMatB16[ib]) : B[ib];
+                    const ElemType* pa = pA + (size_t) l * m;
+                    for (long long i = 0; i < m; i++)
+                        pc[i] += bval * pa[i];
+                }
+            }
+        }
+    }
+};
+
 }}}
\ No newline at end of file
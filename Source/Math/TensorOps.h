@@ -272,6 +272,9 @@ DefBinaryOp(ElementwiseProductWithReciprocalDerivative, a * -Sqr(b)); // b = out
 DefBinaryOp(ElementwiseProductWithSqrtDerivative, a / (2 * b)); // b = output; d/dx sqrt(x) = 1/(2 * sqrt(x)) --> note this is the same as ElementwiseQuotient w a constant; if more show up like this we should add more template params
 DefBinaryOp(SqrOfDifference, Sqr(a - b));
 DefBinaryOp(ElementwiseProductWithExponentialLinearUnitDerivativeFromOutput, b >= 0 ? a : a*(1+b)); // b = output;
+DefBinaryOp(SigmoidOfSum, Sigmoid(a + b)); // fused add-bias -> sigmoid
+DefBinaryOp(TanhOfSum, tanh_(a + b)); // fused add-bias -> tanh
+DefBinaryOp(LinearRectifierOfSum, a + b > 0 ? a + b : 0); // fused add-bias -> rectifier
 //DefBinaryOp(Index, IndexElement(a, b, i));  // note: this one uses the third argument
 
 #pragma pop_macro("DefBinaryOp")
@@ -292,6 +295,8 @@ DefTernaryOp(ElementwiseProductWithExpOfDiff, a * exp_(b - c));
 DefTernaryOp(ElementwiseProductWithQuotient, a * b * OpReciprocal(c));
 DefTernaryOp(ElementwiseProductWithPowExponentDerivative, a * b * OpLog(c));
 DefTernaryOp(ElementwiseProductWithPowBaseDerivative, a * c * OpPow(b, c - 1)); // Using the output of pow would be faster but it requires a quaternary op and users will likely only use pow in forward mode
+DefTernaryOp(SigmoidOfProductPlus, Sigmoid(a * b + c)); // fused scale -> add-bias -> sigmoid
+DefTernaryOp(TanhOfProductPlus, tanh_(a * b + c)); // fused scale -> add-bias -> tanh
 
 #pragma pop_macro("DefTernaryOp")
 
@@ -23,6 +23,8 @@
 #include "Basics.h"
 #include "TensorView.h"
 #include <array>
+#include <map>
+#include <vector>
 
 #ifndef let
 #define let const auto
@@ -62,8 +64,9 @@ static bool Matches(size_t d1, size_t d2)
     return d1 == 1 || d2 == 1 || d1 == d2;
 } // do two dimensions match?
 
-template <class ElemType, size_t N>
-static void PrepareTensorOperands(array<TensorShape, N> shapes, array<size_t, N>& offsets,
+// compute the traversal descriptors for a set of operand shapes (the slow path of PrepareTensorOperands below)
+template <size_t N>
+static void ComputeTensorOperands(array<TensorShape, N> shapes,
                                   SmallVector<size_t>& regularOpDims,
                                   array<SmallVector<ptrdiff_t>, N>& regularStrides,
                                   SmallVector<size_t>& reducingOpDims,
@@ -215,9 +218,74 @@ static void PrepareTensorOperands(array<TensorShape, N> shapes, array<size_t, N>
             reducingStrides[i].clear();
         reducingOpDims.clear();
     }
+}
+
+// -------------------------------------------------------------------
+// traversal-plan cache
+// -------------------------------------------------------------------
+
+// The descriptors computed above depend only on the operands' dimensions and strides, which
+// rarely change across minibatches, yet Do{U,Bi,Ter}naryOpOf used to redo all the flattening and
+// dimension-dropping on every single call -- measurable overhead on networks with many small
+// nodes. PrepareTensorOperands therefore caches the finished plans per thread, keyed by the
+// packed dims and strides of all operands. Offsets are deliberately not part of the key or the
+// plan: slicing moves the offset every minibatch but leaves the traversal unchanged (none of the
+// massaging steps touch it), so they are read directly off the input shapes.
+
+template <size_t N>
+struct TensorOpPlan
+{
+    SmallVector<size_t> regularOpDims, reducingOpDims;
+    array<SmallVector<ptrdiff_t>, N> regularStrides, reducingStrides;
+};
+
+template <size_t N>
+static void MakeTensorOpPlanKey(const array<TensorShape, N>& shapes, vector<size_t>& key)
+{
+    key.clear();
+    for (size_t i = 0; i < N; i++)
+    {
+        const auto& dims = shapes[i].GetDims();
+        const auto& strides = shapes[i].GetStrides();
+        key.push_back(dims.size());
+        for (size_t k = 0; k < dims.size(); k++)
+        {
+            key.push_back(dims[k]);
+            key.push_back((size_t) strides[k]);
+        }
+    }
+}
 
+template <class ElemType, size_t N>
+static void PrepareTensorOperands(const array<TensorShape, N>& shapes, array<size_t, N>& offsets,
+                                  SmallVector<size_t>& regularOpDims,
+                                  array<SmallVector<ptrdiff_t>, N>& regularStrides,
+                                  SmallVector<size_t>& reducingOpDims,
+                                  array<SmallVector<ptrdiff_t>, N>& reducingStrides)
+{
     for (size_t i = 0; i < N; i++)
         offsets[i] = shapes[i].GetOffset();
+
+    // thread-local so no lock is needed; distinct caches per operand count N
+    static thread_local map<vector<size_t>, TensorOpPlan<N>> s_planCache;
+    static thread_local vector<size_t> s_key; // reused across calls to avoid a per-call allocation
+
+    MakeTensorOpPlanKey(shapes, s_key);
+    auto iter = s_planCache.find(s_key);
+    if (iter == s_planCache.end())
+    {
+        if (s_planCache.size() >= 4096) // fully dynamic shapes would otherwise grow this without bound
+            s_planCache.clear();
+        TensorOpPlan<N> plan;
+        ComputeTensorOperands<N>(shapes, plan.regularOpDims, plan.regularStrides, plan.reducingOpDims, plan.reducingStrides);
+        iter = s_planCache.emplace(s_key, std::move(plan)).first;
+    }
+
+    const auto& plan = iter->second;
+    regularOpDims = plan.regularOpDims;
+    regularStrides = plan.regularStrides;
+    reducingOpDims = plan.reducingOpDims;
+    reducingStrides = plan.reducingStrides;
 }
 
 // enforce that in case of broadcasting, the output must not be an input
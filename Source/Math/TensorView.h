@@ -74,6 +74,9 @@ public:
     // Aliasing is not detected, so don't pass distinct TensorView objects that
     // reference overlapping but not identical slices.
     // If beta == 0, c is not read out, i.e. it can be uninitialized or contain NaNs.
+    // For short op chains, prefer the fused ops (e.g. AssignSigmoidOfProductPlusOf computes
+    // Sigmoid(a .* b + c) in one traversal) over a sequence of individual calls, each of which
+    // would materialize its intermediate result.
     // -------------------------------------------------------------------
 
 #pragma push_macro("DeclareUnaryTensorOp")
@@ -44,6 +44,15 @@ void join()
     cudaDeviceSynchronize() || "cudaDeviceSynchronize failed";
 }
 
+// number of CUDA devices available
+size_t numdevices()
+{
+    int count = 0;
+    if (cudaGetDeviceCount(&count) != cudaSuccess)
+        return 0;
+    return (size_t) count;
+}
+
 // allocate a stack to store the devices that have been pushed
 const int stackSize = 20;
 static int curStack = 0;
@@ -12,7 +12,8 @@
 namespace msra { namespace cuda {
 
 // helper functions
-void join(); // wait until current launch or other async operation is completed
+void join();        // wait until current launch or other async operation is completed
+size_t numdevices(); // number of CUDA devices available (0 in CPUONLY builds)
 
 // memory allocation and copying
 void *mallocbytes(size_t nelem, size_t sz);
@@ -71,8 +71,11 @@ struct lr3transP // lr3 = 3-state left-to-right architecture
 {
 
     static const size_t MAXSTATES = 3;
-    size_t numstates;
+    // matrix first and padded size (multiple of 16 bytes), mirroring simplesenonehmm::transP:
+    // rows then sit on 16-byte boundaries within the transPs array on both CPU and GPU
     float loga[MAXSTATES + 1][MAXSTATES + 1];
+    size_t numstates;
+    char padding[16 - sizeof(size_t) % 16];
 
     lr3transP()
     {
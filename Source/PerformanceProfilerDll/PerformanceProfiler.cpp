@@ -4,7 +4,8 @@
 //
 // Real-time thread-safe profiler that generates a summary report and a detail profile log.
 // The profiler is highly performant and lightweight. Profiling a single event introduces an overhead
-// of approximately 100 ns.
+// of approximately 100 ns. Custom events are recorded to per-thread buffers without taking any
+// lock, so concurrent threads can profile at high event rates without perturbing each other.
 //
 
 #ifndef _CRT_SECURE_NO_WARNINGS
@@ -17,9 +18,14 @@
 #include "fileutil.h"
 #include "TimerUtility.h"
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <stdio.h>
+#include <unordered_map>
+#include <vector>
 #ifndef CPUONLY
 #include <cuda_runtime_api.h>
 #endif
@@ -58,6 +64,8 @@ static const FixedEventDesc c_fixedEvtDesc[profilerEvtMax] = {
     { "_Minibatch Iteration", profilerEvtTime, false },             // profilerEvtMainMinibatch
     { "__Get Minibatch", profilerEvtTime, true },                   // profilerEvtMainGetMinibatch
     { "__Forward + Backward", profilerEvtTime, true },              // profilerEvtMainFB
+    { "___Forward Pass", profilerEvtTime, true },                   // profilerEvtMainForward
+    { "___Backward Pass", profilerEvtTime, true },                  // profilerEvtMainBackward
     { "__Gradient Aggregation", profilerEvtTime, true },            // profilerEvtMainGradient
     { "__Weight Update", profilerEvtTime, true },                   // profilerEvtMainWeights
     { "__Post Processing", profilerEvtTime, true },                 // profilerEvtMainPost
@@ -103,10 +111,7 @@ struct ProfilerState
     std::wstring            profilerDir;                 // Directory where reports/logs are saved
     std::wstring            logSuffix;                   // Suffix to append to report/log file names
     FixedEventRecord        fixedEvents[profilerEvtMax]; // Profiling data for each fixed event
-    bool                    customEventBufferFull;       // Is custom event buffer full?
-    unsigned long long      customEventBufferBytes;      // Number of bytes allocated for the custom event buffer
-    unsigned long long      customEventOffset;           // Offset to current place in buffer
-    unique_ptr<char[]>      customEventBuffer;           // Pointer to custom event buffer
+    unsigned long long      customEventBufferBytes;      // Number of bytes allocated per thread for custom events
 };
 
 
@@ -116,6 +121,64 @@ static unique_ptr<ProfilerState> g_profilerState;
 // Mutex controlling access to g_profilerState
 static std::mutex g_mutex;
 
+//
+// Per-thread custom event buffer. Each thread appends records to its own buffer without taking
+// any lock, so the record path costs a strlen and two copies regardless of how many threads
+// profile concurrently; the buffers are merged when the reports are written. The struct is
+// cache-line aligned so that two threads' append offsets never share a line. When a thread's
+// buffer fills up, further events on that thread are counted as dropped and surfaced in the
+// summary report.
+//
+struct alignas(64) ThreadEventBuffer
+{
+    unsigned int        threadId;      // id of the owning (appending) thread
+    bool                full;          // full warning already printed for this thread
+    unsigned long long  offset;        // current append position
+    unsigned long long  bytes;         // buffer capacity
+    unsigned long long  droppedEvents; // events not recorded because the buffer was full
+    unique_ptr<char[]>  buffer;
+};
+
+// All per-thread buffers, kept alive here (not in thread-local storage) so that events recorded
+// by threads that have since exited still make it into the reports. The mutex only guards the
+// vector itself; it is taken once per thread (at registration) and once at report time.
+static std::mutex g_threadBufferMutex;
+static std::vector<std::shared_ptr<ThreadEventBuffer>> g_threadEventBuffers;
+
+// Bumped on ProfilerClose so that threads outliving a profiler session do not keep appending to
+// buffers that have been handed off to the report generators.
+static std::atomic<size_t> g_profilerGeneration(0);
+static thread_local ThreadEventBuffer* t_eventBuffer = nullptr;
+static thread_local size_t t_eventBufferGeneration = 0;
+
+//
+// Memory tracking state (see ProfilerMemoryAlloc/Free). Memory events are orders of magnitude
+// rarer than timing events, so a single mutex around this state is fine.
+//
+struct MemoryTagRecord
+{
+    long long       currentBytes;   // bytes currently allocated under this tag
+    long long       peakBytes;      // largest currentBytes seen for this tag
+    long long       allocCount;     // number of allocations recorded
+};
+
+struct MemorySample
+{
+    long long       clock;          // timestamp of the sample
+    long long       totalBytes;     // tracked bytes across all tags at that time
+};
+
+static std::mutex g_memoryMutex;
+static std::map<std::string, MemoryTagRecord> g_memoryTags;
+static long long g_memoryCurrentBytes = 0;
+static long long g_memoryPeakBytes = 0;
+static long long g_memoryPeakClock = 0;
+static std::map<std::string, long long> g_memoryTagsAtPeak;  // per-tag breakdown at the peak total
+static std::vector<MemorySample> g_memorySamples;            // usage timeline for the chrome trace
+static unsigned long long g_memorySamplesDropped = 0;
+static const size_t c_memorySampleLimit = 1 << 20;           // bound the timeline, not the stats
+static std::map<std::string, std::map<std::string, unsigned long long>> g_memoryAttributions; // group -> name -> bytes
+
 // Forward declarations
 unsigned int GetThreadId();
 
@@ -124,6 +187,9 @@ void FormatTimeStr(char* str, size_t strLen, double value);
 void FormatThroughputStr(char* str, size_t strLen, double value);
 void FormatBytesStr(char* str, size_t strLen, long long bytes);
 void ProfilerGenerateDetailFile(const std::wstring& fileName);
+void ProfilerGenerateChromeTraceFile(const std::wstring& fileName);
+void ProfilerGenerateFlameGraphFile(const std::wstring& fileName);
+void ProfilerGenerateMemoryReport(const std::wstring& fileName, struct tm* timeInfo);
 
 
 double TicksToSeconds(long long ticks)
@@ -142,7 +208,7 @@ double TicksSqToSecondsSq(double ticksSq)
 //
 // Initialize all resources to enable profiling.
 // profilerDir: Directory where the profiler logs will be saved.
-// customEventBufferBytes: Size of the custom event buffer.
+// customEventBufferBytes: Size of the custom event buffer, per recording thread.
 // logSuffix: Suffix string to append to log file names.
 // syncGpu: Wait for GPU to complete processing for each profiling event with syncGpu flag set.
 //
@@ -158,10 +224,7 @@ void PERF_PROFILER_API ProfilerInit(const std::wstring& profilerDir, const unsig
     g_profilerState->profilerDir = profilerDir;
     g_profilerState->logSuffix = logSuffix;
 
-    g_profilerState->customEventBufferFull = false;
     g_profilerState->customEventBufferBytes = customEventBufferBytes;
-    g_profilerState->customEventOffset = 0ull;
-    g_profilerState->customEventBuffer.reset(new char[customEventBufferBytes]);
 
     g_profilerState->syncGpu = syncGpu;
     g_profilerState->enabled = false;
@@ -210,35 +273,71 @@ void ProfilerTimeRecordFixedEvent(const int eventId, const long long beginClock,
     g_profilerState->fixedEvents[eventId].cnt++;
 }
 
-void ProfilerTimeRecordToBuffer(const char* eventDescription, const long long beginClock, const long long endClock)
+// Return the calling thread's event buffer, registering a fresh one on the thread's first event
+// (or first event of a new profiler session). Note that only the registration itself takes a
+// lock; g_mutex is deliberately not used here so this is safe to call with g_mutex held.
+static ThreadEventBuffer* ProfilerEnsureThreadBuffer()
 {
-    std::lock_guard<std::mutex> lock(g_mutex);
+    if (t_eventBuffer == nullptr || t_eventBufferGeneration != g_profilerGeneration)
+    {
+        auto threadBuffer = std::make_shared<ThreadEventBuffer>();
+        threadBuffer->threadId = GetThreadId();
+        threadBuffer->full = false;
+        threadBuffer->offset = 0ull;
+        threadBuffer->bytes = g_profilerState->customEventBufferBytes;
+        threadBuffer->droppedEvents = 0ull;
+        threadBuffer->buffer.reset(new char[threadBuffer->bytes]);
+
+        std::lock_guard<std::mutex> lock(g_threadBufferMutex);
+        g_threadEventBuffers.push_back(threadBuffer);
+        t_eventBuffer = threadBuffer.get();
+        t_eventBufferGeneration = g_profilerGeneration;
+    }
+    return t_eventBuffer;
+}
 
-    if (!g_profilerState->enabled)
-        return;
+// Append one record to the calling thread's event buffer. No lock is taken: a thread only ever
+// appends to its own buffer. The enabled check is the caller's business, since deferred
+// (CUDA-event based) records must land in the buffer even when profiling got disabled between
+// the measurement and its resolution; for the same reason threadId is a parameter, as a
+// deferred record carries the id of the thread that began the measurement, not of the thread
+// that happens to resolve it.
+void ProfilerTimeRecordEvent(const char* eventDescription, const long long beginClock, const long long endClock, const unsigned int threadId)
+{
+    ThreadEventBuffer* threadBuffer = ProfilerEnsureThreadBuffer();
 
     auto eventDescriptionBytes = strlen(eventDescription) + 1;
     auto requiredBufferBytes = eventDescriptionBytes + sizeof(CustomEventRecord);
-    if ((g_profilerState->customEventOffset + requiredBufferBytes) > g_profilerState->customEventBufferBytes)
+    if ((threadBuffer->offset + requiredBufferBytes) > threadBuffer->bytes)
     {
-        if (!g_profilerState->customEventBufferFull)
+        threadBuffer->droppedEvents++;
+        if (!threadBuffer->full)
         {
-            fprintf(stderr, "Warning: Performance Profiler: Buffer is full, no more events will be recorded.\n");
-            g_profilerState->customEventBufferFull = true;
+            fprintf(stderr, "Warning: Performance Profiler: Event buffer of thread %u is full, further events on this thread will be dropped.\n",
+                threadBuffer->threadId);
+            threadBuffer->full = true;
         }
         return;
     }
 
-    strcpy(g_profilerState->customEventBuffer.get() + g_profilerState->customEventOffset, eventDescription);
-    g_profilerState->customEventOffset += eventDescriptionBytes;
+    strcpy(threadBuffer->buffer.get() + threadBuffer->offset, eventDescription);
+    threadBuffer->offset += eventDescriptionBytes;
 
     CustomEventRecord eventRecord;
     eventRecord.beginClock = beginClock;
     eventRecord.endClock = endClock;
-    eventRecord.threadId = GetThreadId();
+    eventRecord.threadId = threadId;
+
+    memcpy(threadBuffer->buffer.get() + threadBuffer->offset, &eventRecord, sizeof(CustomEventRecord));
+    threadBuffer->offset += sizeof(CustomEventRecord);
+}
+
+void ProfilerTimeRecordToBuffer(const char* eventDescription, const long long beginClock, const long long endClock)
+{
+    if (!g_profilerState->enabled)
+        return;
 
-    memcpy(g_profilerState->customEventBuffer.get() + g_profilerState->customEventOffset, &eventRecord, sizeof(CustomEventRecord));
-    g_profilerState->customEventOffset += sizeof(CustomEventRecord);
+    ProfilerTimeRecordEvent(eventDescription, beginClock, endClock, GetThreadId());
 }
 
 
@@ -278,6 +377,120 @@ void PERF_PROFILER_API ProfilerTimeEnd(const long long stateId, const char* even
 }
 
 
+//
+// CUDA-event based custom timing.
+//
+// Each Begin/End pair records two CUDA events on the default stream and remembers the host clock
+// at Begin. Ended pairs are resolved lazily: whenever a new measurement begins, all pairs that
+// the GPU has passed are folded into the custom event buffer, with the event pair's elapsed time
+// as the duration and the host Begin clock anchoring the event on the host timeline; whatever is
+// still in flight is flushed (with a sync) at profiler close. This way the recorded durations
+// are true device execution times, and no per-event cudaDeviceSynchronize is needed that would
+// distort the pipeline being measured.
+//
+#ifndef CPUONLY
+struct CudaTimeRecord
+{
+    cudaEvent_t     beginEvent;
+    cudaEvent_t     endEvent;
+    long long       beginClock;
+    unsigned int    threadId;
+    std::string     eventDescription;
+};
+
+static std::unordered_map<long long, CudaTimeRecord>    g_cudaOpenRecords;    // begun, not yet ended
+static std::deque<CudaTimeRecord>                       g_cudaPendingRecords; // ended, waiting for the GPU to pass endEvent
+static std::vector<std::pair<cudaEvent_t, cudaEvent_t>> g_cudaEventFreeList;
+static long long                                        g_cudaNextStateId = 0;
+
+// Fold all completed pending records into the draining thread's event buffer (the records keep
+// the thread id of the thread that began them). Caller must hold g_mutex.
+static void ProfilerDrainCudaRecordsLocked(const bool waitForGpu)
+{
+    while (!g_cudaPendingRecords.empty())
+    {
+        auto& record = g_cudaPendingRecords.front();
+        if (waitForGpu)
+            cudaEventSynchronize(record.endEvent);
+        else if (cudaEventQuery(record.endEvent) != cudaSuccess)
+            break; // events complete in record order, so nothing behind this one is done either
+
+        float elapsedMs = 0.0f;
+        if (cudaEventElapsedTime(&elapsedMs, record.beginEvent, record.endEvent) == cudaSuccess)
+        {
+            long long endClock = record.beginClock + (long long)((double)elapsedMs * 1e-3 * Clock::GetTicksPerSecond());
+            ProfilerTimeRecordEvent(record.eventDescription.c_str(), record.beginClock, endClock, record.threadId);
+        }
+
+        g_cudaEventFreeList.emplace_back(record.beginEvent, record.endEvent);
+        g_cudaPendingRecords.pop_front();
+    }
+}
+#endif
+
+long long PERF_PROFILER_API ProfilerCudaTimeBegin()
+{
+#ifdef CPUONLY
+    return ProfilerTimeBegin();
+#else
+    // A nullptr state indicates that the profiler is globally disabled, and not initialized
+    if (g_profilerState == nullptr)
+        return -1ll;
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    if (!g_profilerState->enabled)
+        return -1ll;
+
+    ProfilerDrainCudaRecordsLocked(false);
+
+    CudaTimeRecord record;
+    if (!g_cudaEventFreeList.empty())
+    {
+        record.beginEvent = g_cudaEventFreeList.back().first;
+        record.endEvent = g_cudaEventFreeList.back().second;
+        g_cudaEventFreeList.pop_back();
+    }
+    else if (cudaEventCreate(&record.beginEvent) != cudaSuccess || cudaEventCreate(&record.endEvent) != cudaSuccess)
+    {
+        return -1ll; // no usable CUDA device; the caller should fall back to host-clock timing
+    }
+
+    record.beginClock = Clock::GetTimeStamp();
+    record.threadId = GetThreadId();
+    cudaEventRecord(record.beginEvent);
+
+    long long stateId = g_cudaNextStateId++;
+    g_cudaOpenRecords[stateId] = std::move(record);
+    return stateId;
+#endif
+}
+
+
+void PERF_PROFILER_API ProfilerCudaTimeEnd(const long long stateId, const char* eventDescription)
+{
+#ifdef CPUONLY
+    ProfilerTimeEnd(stateId, eventDescription);
+#else
+    // A nullptr state indicates that the profiler is globally disabled, and not initialized
+    if (g_profilerState == nullptr || stateId < 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    auto found = g_cudaOpenRecords.find(stateId);
+    if (found == g_cudaOpenRecords.end())
+        return;
+    CudaTimeRecord record = std::move(found->second);
+    g_cudaOpenRecords.erase(found);
+
+    record.eventDescription = eventDescription;
+    cudaEventRecord(record.endEvent);
+    g_cudaPendingRecords.push_back(std::move(record));
+#endif
+}
+
+
 //
 // Conditionally sync the GPU if the syncGPU flag is set. This only needs to be excplicitly
 // called for custom events.
@@ -342,6 +555,77 @@ void PERF_PROFILER_API ProfilerThroughputEnd(const long long stateId, const int
 }
 
 
+//
+// Track memory allocations/frees under a tag. Tracking runs from ProfilerInit() on,
+// independent of the enabled flag, so that a free recorded after profiling was turned off
+// still balances its allocation.
+//
+static void ProfilerMemoryRecord(const char* tag, const long long deltaBytes)
+{
+    std::lock_guard<std::mutex> lock(g_memoryMutex);
+
+    auto& tagRecord = g_memoryTags[tag];
+    tagRecord.currentBytes += deltaBytes;
+    tagRecord.peakBytes = std::max(tagRecord.peakBytes, tagRecord.currentBytes);
+    if (deltaBytes > 0)
+        tagRecord.allocCount++;
+
+    g_memoryCurrentBytes += deltaBytes;
+    long long clock = Clock::GetTimeStamp();
+    if (g_memoryCurrentBytes > g_memoryPeakBytes)
+    {
+        g_memoryPeakBytes = g_memoryCurrentBytes;
+        g_memoryPeakClock = clock;
+        g_memoryTagsAtPeak.clear();
+        for (const auto& tagAndRecord : g_memoryTags)
+            g_memoryTagsAtPeak[tagAndRecord.first] = tagAndRecord.second.currentBytes;
+    }
+
+    if (g_memorySamples.size() < c_memorySampleLimit)
+        g_memorySamples.push_back(MemorySample{ clock, g_memoryCurrentBytes });
+    else
+        g_memorySamplesDropped++;
+}
+
+void PERF_PROFILER_API ProfilerMemoryAlloc(const char* tag, const unsigned long long bytes)
+{
+    // A nullptr state indicates that the profiler is globally disabled, and not initialized
+    if (g_profilerState == nullptr)
+        return;
+
+    ProfilerMemoryRecord(tag, (long long)bytes);
+}
+
+void PERF_PROFILER_API ProfilerMemoryFree(const char* tag, const unsigned long long bytes)
+{
+    // A nullptr state indicates that the profiler is globally disabled, and not initialized
+    if (g_profilerState == nullptr)
+        return;
+
+    ProfilerMemoryRecord(tag, -(long long)bytes);
+}
+
+void PERF_PROFILER_API ProfilerMemoryAttributionBegin(const char* group)
+{
+    // A nullptr state indicates that the profiler is globally disabled, and not initialized
+    if (g_profilerState == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(g_memoryMutex);
+    g_memoryAttributions[group].clear();
+}
+
+void PERF_PROFILER_API ProfilerMemoryAttribution(const char* group, const char* name, const unsigned long long bytes)
+{
+    // A nullptr state indicates that the profiler is globally disabled, and not initialized
+    if (g_profilerState == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(g_memoryMutex);
+    g_memoryAttributions[group][name] += bytes;
+}
+
+
 //
 // Generate reports and release all resources.
 //
@@ -351,6 +635,23 @@ void PERF_PROFILER_API ProfilerClose()
     if (g_profilerState == nullptr)
         return;
 
+#ifndef CPUONLY
+    // Flush in-flight CUDA-event measurements before the reports are written
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        ProfilerDrainCudaRecordsLocked(true);
+        for (auto& keyAndRecord : g_cudaOpenRecords) // begun but never ended: not recorded
+            g_cudaEventFreeList.emplace_back(keyAndRecord.second.beginEvent, keyAndRecord.second.endEvent);
+        g_cudaOpenRecords.clear();
+        for (auto& events : g_cudaEventFreeList)
+        {
+            cudaEventDestroy(events.first);
+            cudaEventDestroy(events.second);
+        }
+        g_cudaEventFreeList.clear();
+    }
+#endif
+
     // Get current time as yyyy-mm-dd_hh-mm-ss
     time_t currentTime;
     time(&currentTime);
@@ -366,6 +667,40 @@ void PERF_PROFILER_API ProfilerClose()
     fileName = g_profilerState->profilerDir + L"/" + std::wstring(timeStr) + L"_detail_" + g_profilerState->logSuffix + L".csv";
     ProfilerGenerateDetailFile(fileName);
 
+    // Generate chrome://tracing timeline of the custom event stream
+    fileName = g_profilerState->profilerDir + L"/" + std::wstring(timeStr) + L"_trace_" + g_profilerState->logSuffix + L".json";
+    ProfilerGenerateChromeTraceFile(fileName);
+
+    // Generate folded call stacks for flame graph rendering
+    fileName = g_profilerState->profilerDir + L"/" + std::wstring(timeStr) + L"_flame_" + g_profilerState->logSuffix + L".folded";
+    ProfilerGenerateFlameGraphFile(fileName);
+
+    // Generate memory report, when any memory events were tracked
+    {
+        std::lock_guard<std::mutex> lock(g_memoryMutex);
+        if (!g_memoryTags.empty() || !g_memoryAttributions.empty())
+        {
+            fileName = g_profilerState->profilerDir + L"/" + std::wstring(timeStr) + L"_memory_" + g_profilerState->logSuffix + L".txt";
+            ProfilerGenerateMemoryReport(fileName, timeInfo);
+        }
+        g_memoryTags.clear();
+        g_memoryTagsAtPeak.clear();
+        g_memoryAttributions.clear();
+        g_memorySamples.clear();
+        g_memorySamplesDropped = 0;
+        g_memoryCurrentBytes = 0;
+        g_memoryPeakBytes = 0;
+        g_memoryPeakClock = 0;
+    }
+
+    // Release the per-thread event buffers, and bump the generation so that threads outliving
+    // this session re-register instead of appending through stale thread-local pointers
+    {
+        std::lock_guard<std::mutex> lock(g_threadBufferMutex);
+        g_threadEventBuffers.clear();
+        g_profilerGeneration++;
+    }
+
     g_profilerState.reset();
 }
 
@@ -484,6 +819,21 @@ void ProfilerGenerateReport(const std::wstring& fileName, struct tm* timeInfo)
         if (printLine) fprintfOrDie(f, "\n");
     }
 
+    // Surface any events that were dropped because a thread's buffer filled up, so a truncated
+    // detail log is not mistaken for a complete one
+    unsigned long long droppedEvents = 0ull;
+    for (const auto& threadBuffer : g_threadEventBuffers)
+        droppedEvents += threadBuffer->droppedEvents;
+    if (droppedEvents > 0)
+    {
+        fprintfOrDie(f, "\nDropped Custom Events......: %llu (increase profilerBufferSize to capture all events)\n", droppedEvents);
+        for (const auto& threadBuffer : g_threadEventBuffers)
+        {
+            if (threadBuffer->droppedEvents > 0)
+                fprintfOrDie(f, "_Thread %u.................: %llu\n", threadBuffer->threadId, threadBuffer->droppedEvents);
+        }
+    }
+
     fclose(f);
 }
 
@@ -523,6 +873,31 @@ void FormatBytesStr(char* str, size_t strLen, long long bytes)
 
 
 
+//
+// Iterate the merged custom event stream: invoke the callback for every event recorded in any
+// of the per-thread buffers. Events are in record order within one thread's buffer but not
+// across buffers; the consumers below either do not care about global order or sort themselves.
+//
+template <typename EventCallback>
+static void ForEachCustomEvent(const EventCallback& callback)
+{
+    for (const auto& threadBuffer : g_threadEventBuffers)
+    {
+        char* eventPtr = threadBuffer->buffer.get();
+        while (eventPtr < (threadBuffer->buffer.get() + threadBuffer->offset))
+        {
+            char* descriptionStr = eventPtr;
+            eventPtr += strlen(descriptionStr) + 1;
+
+            CustomEventRecord* eventRecord = (CustomEventRecord*)eventPtr;
+            eventPtr += sizeof(CustomEventRecord);
+
+            callback(descriptionStr, *eventRecord);
+        }
+    }
+}
+
+
 //
 // Generate detail event file.
 //
@@ -536,19 +911,257 @@ void ProfilerGenerateDetailFile(const std::wstring& fileName)
 
     fprintfOrDie(f, "EventDescription,ThreadId,BeginTimeStamp(ms),EndTimeStamp(ms)\n");
 
-    char* eventPtr = g_profilerState->customEventBuffer.get();
+    ForEachCustomEvent([f](const char* descriptionStr, const CustomEventRecord& eventRecord)
+    {
+        fprintfOrDie(f, "\"%s\",%u,%.8f,%.8f\n", descriptionStr, eventRecord.threadId,
+            1000.0 * TicksToSeconds(eventRecord.beginClock),
+            1000.0 * TicksToSeconds(eventRecord.endClock));
+    });
+
+    fclose(f);
+}
+
+
+//
+// Generate a chrome://tracing compatible JSON file from the custom event stream.
+// The file can be loaded in chrome://tracing (or https://ui.perfetto.dev) to view all custom
+// events, including the per-node timings, on a zoomable per-thread timeline.
+//
+void ProfilerGenerateChromeTraceFile(const std::wstring& fileName)
+{
+    FILE* f = _wfopen(fileName.c_str(), L"wt");
+    if (f == NULL)
+    {
+        RuntimeError("Error: ProfilerGenerateChromeTraceFile: Cannot create file <%ls>.\n", fileName.c_str());
+    }
+
+    fprintfOrDie(f, "[\n");
 
-    while (eventPtr < (g_profilerState->customEventBuffer.get() + g_profilerState->customEventOffset))
+    // The fixed-event table names its sections through separator rows ("Main Thread",
+    // "Data Reader"); use that to label any thread observed recording a section's events,
+    // so CNTK phases line up readably against system traces loaded into the same timeline.
+    std::unordered_map<std::string, const char*> sectionOfFixedEvent;
+    const char* currentSection = nullptr;
+    for (int evtIdx = 0; evtIdx < profilerEvtMax; evtIdx++)
     {
-        char* descriptionStr = eventPtr;
-        eventPtr += strlen(descriptionStr) + 1;
+        if (c_fixedEvtDesc[evtIdx].eventType == profilerEvtSeparator)
+        {
+            if (c_fixedEvtDesc[evtIdx].eventDescription[0] != '\0')
+                currentSection = c_fixedEvtDesc[evtIdx].eventDescription;
+        }
+        else if (currentSection != nullptr)
+            sectionOfFixedEvent[c_fixedEvtDesc[evtIdx].eventDescription] = currentSection;
+    }
+    std::map<unsigned int, const char*> threadNames;
 
-        CustomEventRecord* eventRecord = (CustomEventRecord*)eventPtr;
-        eventPtr += sizeof(CustomEventRecord);
+    const char* separator = "";
 
-        fprintfOrDie(f, "\"%s\",%u,%.8f,%.8f\n", descriptionStr, eventRecord->threadId, 
-            1000.0 * TicksToSeconds(eventRecord->beginClock),
-            1000.0 * TicksToSeconds(eventRecord->endClock));
+    ForEachCustomEvent([&](const char* descriptionStr, const CustomEventRecord& eventRecord)
+    {
+        auto section = sectionOfFixedEvent.find(descriptionStr);
+        if (section != sectionOfFixedEvent.end() && threadNames.find(eventRecord.threadId) == threadNames.end())
+            threadNames[eventRecord.threadId] = section->second;
+
+        // drop the indentation underscores the fixed events carry for the text report
+        const char* displayName = descriptionStr;
+        while (*displayName == '_')
+            displayName++;
+
+        // escape the few JSON-relevant characters that may occur in node names
+        std::string escapedDescription;
+        for (const char* p = displayName; *p != '\0'; p++)
+        {
+            if (*p == '"' || *p == '\\')
+                escapedDescription += '\\';
+            escapedDescription += *p;
+        }
+
+        // complete ("X") events; timestamps and durations are in microseconds
+        fprintfOrDie(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+            separator, escapedDescription.c_str(), eventRecord.threadId,
+            1e6 * TicksToSeconds(eventRecord.beginClock),
+            1e6 * TicksToSeconds(eventRecord.endClock - eventRecord.beginClock));
+        separator = ",\n";
+    });
+
+    // counter track of tracked memory usage, so allocation spikes line up against the
+    // per-node event timeline
+    {
+        std::lock_guard<std::mutex> lock(g_memoryMutex);
+        for (const auto& sample : g_memorySamples)
+        {
+            fprintfOrDie(f, "%s{\"name\":\"Tracked Memory\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,\"args\":{\"MB\":%.3f}}",
+                separator, 1e6 * TicksToSeconds(sample.clock), (double)sample.totalBytes / (1024.0 * 1024.0));
+            separator = ",\n";
+        }
+    }
+
+    // name the process and the threads we could classify, so the timeline is self-describing
+    fprintfOrDie(f, "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"CNTK\"}}", separator);
+    separator = ",\n";
+    for (const auto& threadAndName : threadNames)
+        fprintfOrDie(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            separator, threadAndName.first, threadAndName.second);
+
+    fprintfOrDie(f, "\n]\n");
+
+    fclose(f);
+}
+
+
+//
+// Generate a folded-stacks file for flame graph rendering (the format consumed by the common
+// flamegraph.pl script): one line per call path with its self time in microseconds, e.g.
+// "Thread 1234;Minibatch Iteration;Forward Pass 5678". Call paths are reconstructed per thread
+// from the nesting of the recorded intervals.
+//
+void ProfilerGenerateFlameGraphFile(const std::wstring& fileName)
+{
+    struct TraceEvent
+    {
+        const char*  description;
+        long long    beginClock;
+        long long    endClock;
+    };
+
+    // collect the custom event stream, per thread
+    std::map<unsigned int, std::vector<TraceEvent>> eventsByThread;
+    ForEachCustomEvent([&eventsByThread](const char* descriptionStr, const CustomEventRecord& eventRecord)
+    {
+        eventsByThread[eventRecord.threadId].push_back(TraceEvent{ descriptionStr, eventRecord.beginClock, eventRecord.endClock });
+    });
+
+    std::map<std::string, long long> selfTicksByPath;
+    for (auto& threadAndEvents : eventsByThread)
+    {
+        auto& events = threadAndEvents.second;
+        std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b)
+        {
+            return a.beginClock != b.beginClock ? a.beginClock < b.beginClock : a.endClock > b.endClock;
+        });
+
+        char threadFrame[32];
+        sprintf_s(threadFrame, sizeof(threadFrame), "Thread %u", threadAndEvents.first);
+
+        // sweep the intervals, keeping the stack of currently open frames; a frame's self time
+        // is its duration minus the time spent in frames nested inside it
+        struct OpenFrame
+        {
+            std::string path;
+            long long   beginClock;
+            long long   endClock;
+            long long   childTicks;
+        };
+        std::vector<OpenFrame> stack;
+        auto popFrame = [&]()
+        {
+            selfTicksByPath[stack.back().path] += (stack.back().endClock - stack.back().beginClock) - stack.back().childTicks;
+            stack.pop_back();
+        };
+
+        for (const auto& event : events)
+        {
+            // close all open frames this event does not nest into
+            while (!stack.empty() && (stack.back().endClock <= event.beginClock || stack.back().endClock < event.endClock))
+                popFrame();
+
+            // frame name: drop the indentation underscores, and reserve ';' as the path separator
+            const char* displayName = event.description;
+            while (*displayName == '_')
+                displayName++;
+            std::string name(displayName);
+            std::replace(name.begin(), name.end(), ';', ':');
+
+            OpenFrame frame;
+            frame.path = (stack.empty() ? std::string(threadFrame) : stack.back().path) + ";" + name;
+            frame.beginClock = event.beginClock;
+            frame.endClock = event.endClock;
+            frame.childTicks = 0;
+            if (!stack.empty())
+                stack.back().childTicks += event.endClock - event.beginClock;
+            stack.push_back(std::move(frame));
+        }
+        while (!stack.empty())
+            popFrame();
+    }
+
+    FILE* f = _wfopen(fileName.c_str(), L"wt");
+    if (f == NULL)
+    {
+        RuntimeError("Error: ProfilerGenerateFlameGraphFile: Cannot create file <%ls>.\n", fileName.c_str());
+    }
+
+    for (const auto& pathAndTicks : selfTicksByPath)
+    {
+        long long microseconds = (long long)(1e6 * TicksToSeconds(pathAndTicks.second));
+        if (microseconds > 0)
+            fprintfOrDie(f, "%s %lld\n", pathAndTicks.first.c_str(), microseconds);
+    }
+
+    fclose(f);
+}
+
+
+//
+// Generate the memory report: per-tag peak and current usage, the breakdown at the moment of
+// peak total usage, and the planned attributions (e.g. the matrix pool's per-node buffer
+// assignments). Caller holds g_memoryMutex.
+//
+void ProfilerGenerateMemoryReport(const std::wstring& fileName, struct tm* timeInfo)
+{
+    FILE* f = _wfopen(fileName.c_str(), L"wt");
+    if (f == NULL)
+    {
+        RuntimeError("Error: ProfilerGenerateMemoryReport: Cannot create file <%ls>.\n", fileName.c_str());
+    }
+
+    fprintfOrDie(f, "CNTK Performance Profiler Memory Report\n\n");
+    char timeStr[32];
+    strftime(timeStr, sizeof(timeStr), "%Y/%m/%d %H:%M:%S", timeInfo);
+    fprintfOrDie(f, "Time Stamp: %s\n\n", timeStr);
+
+    char str[32];
+    if (!g_memoryTags.empty())
+    {
+        FormatBytesStr(str, sizeof(str), g_memoryPeakBytes);
+        fprintfOrDie(f, "Peak Tracked Memory:%s at %.3f s\n", str, TicksToSeconds(g_memoryPeakClock));
+        if (g_memorySamplesDropped > 0)
+            fprintfOrDie(f, "(memory timeline truncated, %llu samples dropped)\n", g_memorySamplesDropped);
+        fprintfOrDie(f, "\n");
+
+        fprintfOrDie(f, "Tag........................ ............Peak ....AtTotalPeak ..........Close ..........Allocs\n\n");
+        for (const auto& tagAndRecord : g_memoryTags)
+        {
+            fprintfOrDie(f, "%-26s: ", tagAndRecord.first.c_str());
+            FormatBytesStr(str, sizeof(str), tagAndRecord.second.peakBytes);
+            fprintfOrDie(f, "%s", str);
+            auto atPeak = g_memoryTagsAtPeak.find(tagAndRecord.first);
+            FormatBytesStr(str, sizeof(str), atPeak != g_memoryTagsAtPeak.end() ? atPeak->second : 0ll);
+            fprintfOrDie(f, "%s", str);
+            FormatBytesStr(str, sizeof(str), tagAndRecord.second.currentBytes);
+            fprintfOrDie(f, "%s", str);
+            fprintfOrDie(f, "%16lld\n", tagAndRecord.second.allocCount);
+        }
+    }
+
+    // planned attributions, largest consumers first
+    for (const auto& groupAndNames : g_memoryAttributions)
+    {
+        if (groupAndNames.second.empty())
+            continue;
+
+        fprintfOrDie(f, "\n%s\n\n", groupAndNames.first.c_str());
+
+        std::vector<std::pair<std::string, unsigned long long>> rows(groupAndNames.second.begin(), groupAndNames.second.end());
+        std::sort(rows.begin(), rows.end(), [](const std::pair<std::string, unsigned long long>& a, const std::pair<std::string, unsigned long long>& b)
+        {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        for (const auto& nameAndBytes : rows)
+        {
+            FormatBytesStr(str, sizeof(str), (long long)nameAndBytes.second);
+            fprintfOrDie(f, "%s  %s\n", str, nameAndBytes.first.c_str());
+        }
     }
 
     fclose(f);
@@ -62,6 +62,8 @@ enum ProfilerEvents
     profilerEvtMainMinibatch,               // One minibatch loop time
     profilerEvtMainGetMinibatch,            // GetMinibatch() function time
     profilerEvtMainFB,                      // Forward + Backward pass time
+    profilerEvtMainForward,                 // Forward pass time (subset of Forward + Backward)
+    profilerEvtMainBackward,                // Backward pass time (subset of Forward + Backward)
     profilerEvtMainGradient,                // Gradient aggregation time
     profilerEvtMainWeights,                 // Weight update time
     profilerEvtMainPost,                    // Remainder time in minibatch loop
@@ -81,7 +83,7 @@ enum ProfilerEvents
 //
 // Initialize all resources to enable profiling.
 // profilerDir: Directory where the profiler logs will be saved.
-// customEventBufferBytes: Bytes to allocate for the custom event buffer.
+// customEventBufferBytes: Bytes to allocate for the custom event buffer, per recording thread.
 // logSuffix: Suffix string to append to log files.
 // syncGpu: Wait for GPU to complete processing for each profiling event.
 //
@@ -106,6 +108,17 @@ long long PERF_PROFILER_API ProfilerTimeBegin();
 void PERF_PROFILER_API ProfilerTimeEnd(const long long stateId, const int eventId);
 void PERF_PROFILER_API ProfilerTimeEnd(const long long stateId, const char* eventDescription);
 
+//
+// Measure a custom event time on the GPU using CUDA events recorded on the compute stream.
+// The duration covers the device-side execution of the work submitted between Begin and End,
+// without forcing a host/device sync per event; completed measurements are folded into the
+// custom event stream lazily, once the GPU has passed the end event. On CPU-only builds this
+// falls back to the host-clock ProfilerTimeBegin()/ProfilerTimeEnd() pair.
+//
+long long PERF_PROFILER_API ProfilerCudaTimeBegin();
+void PERF_PROFILER_API ProfilerCudaTimeEnd(const long long stateId, const char* eventDescription);
+
+
 //
 // Conditionally sync the GPU if the syncGPU flag is set. This only needs to be excplicitly
 // called for custom events.
@@ -122,6 +135,28 @@ long long PERF_PROFILER_API ProfilerThroughputBegin();
 void PERF_PROFILER_API ProfilerThroughputEnd(const long long stateId, const int eventId, const long long bytes);
 
 
+//
+// Track a memory allocation or free under a tag (e.g. "GPU[0] Matrix"). The profiler keeps
+// running and peak byte counts per tag, the per-tag breakdown at the moment of peak total
+// usage, and a usage timeline that is emitted as a counter track into the chrome trace; all
+// of it ends up in the memory report written at ProfilerClose(). Unlike timing events,
+// memory is tracked from ProfilerInit() on, independent of ProfilerEnable(), so that frees
+// always balance their allocations. These are meant for driver-level allocations (rare and
+// expensive anyway), not for per-element work.
+//
+void PERF_PROFILER_API ProfilerMemoryAlloc(const char* tag, const unsigned long long bytes);
+void PERF_PROFILER_API ProfilerMemoryFree(const char* tag, const unsigned long long bytes);
+
+//
+// Record a statically planned memory attribution, e.g. the matrix pool's per-node buffer
+// assignments. Attributions are listed in the memory report under their group heading;
+// repeated names within a group accumulate. ProfilerMemoryAttributionBegin() clears a group,
+// so a planner that re-runs reports only its latest plan.
+//
+void PERF_PROFILER_API ProfilerMemoryAttributionBegin(const char* group);
+void PERF_PROFILER_API ProfilerMemoryAttribution(const char* group, const char* name, const unsigned long long bytes);
+
+
 //
 // Generate reports and release all resources.
 //
@@ -63,9 +63,15 @@ void BinaryChunkDeserializer::ReadChunkTable(FILE* infile, uint32_t firstChunkId
 }
 
 BinaryChunkDeserializer::BinaryChunkDeserializer(const BinaryConfigHelper& helper) :
-    BinaryChunkDeserializer(helper.GetFilePath())
+    BinaryChunkDeserializer(helper, helper.GetFilePath())
+{
+}
+
+BinaryChunkDeserializer::BinaryChunkDeserializer(const BinaryConfigHelper& helper, const std::wstring& filename) :
+    BinaryChunkDeserializer(filename)
 {
     SetTraceLevel(helper.GetTraceLevel());
+    m_useMappedChunks = helper.UseMemoryMappedChunks();
 
     Initialize(helper.GetRename(), helper.GetElementType());
 }
@@ -77,7 +83,8 @@ BinaryChunkDeserializer::BinaryChunkDeserializer(const std::wstring& filename) :
     m_file(nullptr),
     m_headerOffset(0),
     m_chunkTableOffset(0),
-    m_traceLevel(0)
+    m_traceLevel(0),
+    m_useMappedChunks(true)
 {
 }
 
@@ -196,14 +203,24 @@ void BinaryChunkDeserializer::GetSequencesForChunk(ChunkIdType chunkId, std::vec
     }
 }
 
-unique_ptr<byte[]> BinaryChunkDeserializer::ReadChunk(ChunkIdType chunkId)
+FileRegionPtr BinaryChunkDeserializer::ReadChunk(ChunkIdType chunkId)
 {
+    // Determine where the data portion of the chunk lives and how big it is.
+    int64_t dataStartOffset = m_chunkTable->GetDataStartOffset(chunkId);
+    size_t chunkSize = m_chunkTable->GetChunkSize(chunkId);
+
+#ifdef __unix__
+    if (m_useMappedChunks)
+    {
+        // Map the chunk directly over the page cache: the deserializers expose
+        // the sequence data as views into the mapping, so the bytes are never copied.
+        return make_shared<FileRegion>(m_file, dataStartOffset, chunkSize);
+    }
+#endif
+
     // Seek to the start of the data portion in the chunk
-    CNTKBinaryFileHelper::SeekOrDie(m_file, m_chunkTable->GetDataStartOffset(chunkId), SEEK_SET);
+    CNTKBinaryFileHelper::SeekOrDie(m_file, dataStartOffset, SEEK_SET);
 
-    // Determine how big the chunk is.
-    size_t chunkSize = m_chunkTable->GetChunkSize(chunkId);
-    
     // Create buffer
     // TODO: use a pool of buffers instead of allocating a new one, each time a chunk is read.
     unique_ptr<byte[]> buffer(new byte[chunkSize]);
@@ -211,14 +228,14 @@ unique_ptr<byte[]> BinaryChunkDeserializer::ReadChunk(ChunkIdType chunkId)
     // Read the chunk from disk
     CNTKBinaryFileHelper::ReadOrDie(buffer.get(), sizeof(byte), chunkSize, m_file);
 
-    return buffer;
+    return make_shared<FileRegion>(std::move(buffer));
 }
 
 
 ChunkPtr BinaryChunkDeserializer::GetChunk(ChunkIdType chunkId)
 {
-    // Read the chunk into memory
-    unique_ptr<byte[]> buffer = ReadChunk(chunkId);
+    // Read (or map) the chunk into memory
+    FileRegionPtr buffer = ReadChunk(chunkId);
 
     return make_shared<BinaryDataChunk>(chunkId, m_chunkTable->GetNumSequences(chunkId), std::move(buffer), m_deserializers);
 }
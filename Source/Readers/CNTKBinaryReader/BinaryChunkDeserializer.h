@@ -84,6 +84,9 @@ class BinaryChunkDeserializer : public DataDeserializerBase {
 public:
     explicit BinaryChunkDeserializer(const BinaryConfigHelper& helper);
 
+    // Creates a deserializer for a single shard file of a sharded dataset.
+    BinaryChunkDeserializer(const BinaryConfigHelper& helper, const std::wstring& filename);
+
     BinaryChunkDeserializer(CorpusDescriptorPtr corpus, const BinaryConfigHelper& helper) = delete;
 
     ~BinaryChunkDeserializer();
@@ -105,8 +108,9 @@ private:
     void ReadChunkTable(FILE* infile, uint32_t firstChunkIdx, uint32_t numChunks);
     void ReadChunkTable(FILE* infile);
 
-    // Reads a chunk from disk into buffer
-    unique_ptr<byte[]> ReadChunk(ChunkIdType chunkId);
+    // Retrieves the byte range of a chunk, either memory-mapping it (zero-copy,
+    // backed by the page cache) or reading it from disk into an owned buffer.
+    FileRegionPtr ReadChunk(ChunkIdType chunkId);
 
     BinaryChunkDeserializer(const wstring& filename);
 
@@ -125,9 +129,13 @@ private:
     
     uint32_t m_numChunks;
     uint32_t m_numInputs;
-    
+
     unsigned int m_traceLevel;
 
+    // If true, chunks are memory-mapped instead of read into owned buffers
+    // (only effective on platforms where mapping is implemented).
+    bool m_useMappedChunks;
+
     static const uint32_t s_currentVersion = 1;
 
     friend class CNTKBinaryReaderTestRunner;
@@ -62,8 +62,30 @@ namespace Microsoft { namespace MSR { namespace CNTK {
             RuntimeError("Not supported precision '%s'. Expected 'double' or 'float'.", precision.c_str());
         }
 
-        m_filepath = msra::strfun::utf16(config(L"file"));
+        if (config.ExistsCurrent(L"files"))
+        {
+            // A sharded dataset: a list of shard files that is distributed across workers by rank.
+            ConfigArray files(config(L"files"));
+            for (size_t i = 0; i < files.size(); ++i)
+                m_filepaths.push_back(msra::strfun::utf16(files[i]));
+            if (m_filepaths.empty())
+                InvalidArgument("The list of input files ('files') must not be empty.");
+            m_filepath = m_filepaths.front();
+        }
+        else
+        {
+            m_filepath = msra::strfun::utf16(config(L"file"));
+            m_filepaths.push_back(m_filepath);
+        }
+
+        m_workerRank = config(L"workerRank", (size_t)0);
+        m_numberOfWorkers = config(L"numberOfWorkers", (size_t)1);
+        if (m_numberOfWorkers == 0 || m_workerRank >= m_numberOfWorkers)
+            InvalidArgument("Invalid worker rank %d for %d workers.", (int)m_workerRank, (int)m_numberOfWorkers);
+
         m_keepDataInMemory = config(L"keepDataInMemory", false);
+        m_cacheSizeBytes = config(L"cacheSizeInBytes", (size_t)0); // 0 - cache is unbounded
+        m_useMappedChunks = config(L"memoryMappedChunks", true); // no effect on platforms without memory mapping
 
         m_randomizationWindow = GetRandomizationWindowFromConfig(config);
         m_sampleBasedRandomizationWindow = config(L"sampleBasedRandomizationWindow", false);
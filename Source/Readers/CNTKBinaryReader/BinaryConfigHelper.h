@@ -26,6 +26,14 @@ public:
     // Get full path to the input file.
     const wstring& GetFilePath() const { return m_filepath; }
 
+    // Get full paths to all input shards ('files' in the config).
+    // Contains a single entry when the dataset is not sharded.
+    const std::vector<std::wstring>& GetFilePaths() const { return m_filepaths; }
+
+    size_t GetWorkerRank() const { return m_workerRank; }
+
+    size_t GetNumberOfWorkers() const { return m_numberOfWorkers; }
+
     size_t GetRandomizationWindow() const { return m_randomizationWindow; }
 
     bool UseSampleBasedRandomizationWindow() const { return m_sampleBasedRandomizationWindow; }
@@ -34,12 +42,19 @@ public:
 
     bool ShouldKeepDataInMemory() const { return m_keepDataInMemory; }
 
+    size_t GetCacheSizeInBytes() const { return m_cacheSizeBytes; }
+
+    bool UseMemoryMappedChunks() const { return m_useMappedChunks; }
+
     ElementType GetElementType() const { return m_elementType; }
 
     DISABLE_COPY_AND_MOVE(BinaryConfigHelper);
 
 private:
     std::wstring m_filepath;
+    std::vector<std::wstring> m_filepaths; // all shards of the dataset; a single entry if not sharded
+    size_t m_workerRank;                   // rank of this worker, used to assign shards
+    size_t m_numberOfWorkers;              // total number of workers the shards are distributed across
     std::map<std::wstring, std::wstring> m_streams;
     ElementType m_elementType;
     size_t m_randomizationWindow;
@@ -47,7 +62,9 @@ private:
     // randomization window = number of chunks (default).
     bool m_sampleBasedRandomizationWindow;
     unsigned int m_traceLevel;
-    bool m_keepDataInMemory; // if true the whole dataset is kept in memory
+    bool m_keepDataInMemory; // if true the dataset is cached in memory
+    size_t m_cacheSizeBytes; // byte budget of the in-memory cache, 0 - unbounded
+    bool m_useMappedChunks; // if true, chunks are memory-mapped instead of read into owned buffers
 };
 
 } } }
@@ -10,18 +10,19 @@
 #include "CorpusDescriptor.h"
 #include "BinaryChunkDeserializer.h"
 #include "BinaryDataDeserializer.h"
+#include "FileHelper.h"
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 class BinaryDataChunk : public Chunk, public std::enable_shared_from_this<Chunk>
 {
 public:
     explicit BinaryDataChunk(ChunkIdType chunkId,
-        size_t numSequences, 
-        unique_ptr<byte[]> buffer, 
+        size_t numSequences,
+        FileRegionPtr buffer,
         std::vector<BinaryDataDeserializerPtr> deserializer)
         : m_chunkId(chunkId),
-        m_numSequences(numSequences), 
-        m_buffer(std::move(buffer)), 
+        m_numSequences(numSequences),
+        m_buffer(std::move(buffer)),
         m_deserializers(deserializer)
     { }
 
@@ -58,7 +59,7 @@ protected:
         size_t bytesProcessed = 0;
         // Now call all of the deserializers on the chunk, in order
         for (size_t i = 0; i < m_deserializers.size(); i++)
-            bytesProcessed += m_deserializers[i]->GetSequenceDataForChunk(m_numSequences, m_buffer.get() + bytesProcessed, m_data[i]);
+            bytesProcessed += m_deserializers[i]->GetSequenceDataForChunk(m_numSequences, m_buffer->Data() + bytesProcessed, m_data[i]);
     }
 
     // chunk id (copied from the descriptor)
@@ -68,8 +69,9 @@ protected:
     // so we must tell the chunk where it starts.
     size_t m_numSequences;
 
-    // This is the actual chunk read from disk. We will call back to the deserializer for it to be deserialized
-    unique_ptr<byte[]> m_buffer;
+    // The chunk's byte range of the input file, either memory-mapped or read from
+    // disk. The parsed sequence data below holds views directly into this region.
+    FileRegionPtr m_buffer;
 
     // This is the deserializer who knows how to interpret the m_data chunk that we read in
     std::vector<BinaryDataDeserializerPtr> m_deserializers;
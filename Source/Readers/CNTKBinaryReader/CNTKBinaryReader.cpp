@@ -8,6 +8,7 @@
 #include "Config.h"
 #include "BinaryConfigHelper.h"
 #include "BinaryChunkDeserializer.h"
+#include "ShardedBinaryChunkDeserializer.h"
 #include "ChunkCache.h"
 #include "BlockRandomizer.h"
 #include "NoRandomizer.h"
@@ -27,11 +28,20 @@ CNTKBinaryReader::CNTKBinaryReader(const ConfigParameters& config)
     log << "Initializing CNTKBinaryReader";
     try
     {
-        m_deserializer = shared_ptr<IDataDeserializer>(new BinaryChunkDeserializer(configHelper));
+        if (configHelper.GetFilePaths().size() > 1)
+        {
+            m_deserializer = shared_ptr<IDataDeserializer>(new ShardedBinaryChunkDeserializer(configHelper));
+            log << " | " << configHelper.GetFilePaths().size() << " shards, "
+                << configHelper.GetNumberOfWorkers() << " workers";
+        }
+        else
+        {
+            m_deserializer = shared_ptr<IDataDeserializer>(new BinaryChunkDeserializer(configHelper));
+        }
 
         if (configHelper.ShouldKeepDataInMemory())
         {
-            m_deserializer = shared_ptr<IDataDeserializer>(new ChunkCache(m_deserializer));
+            m_deserializer = shared_ptr<IDataDeserializer>(new ChunkCache(m_deserializer, configHelper.GetCacheSizeInBytes()));
             log << " | keeping data in memory";
         }
 
@@ -21,6 +21,8 @@
 #ifdef __unix__
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #endif
 #include <errno.h>
 #include <stdint.h>
@@ -119,5 +121,72 @@ private:
     CNTKBinaryFileHelper();
 };
 
+// A read-only byte range of an input file. The data is either memory-mapped
+// directly over the page cache (zero-copy) or read into an owned buffer when
+// mapping is not available on the platform.
+class FileRegion
+{
+public:
+    // Takes ownership of an already filled buffer.
+    explicit FileRegion(unique_ptr<byte[]> buffer) :
+        m_buffer(std::move(buffer)),
+        m_data(m_buffer.get())
+#ifdef __unix__
+        , m_mappingStart(nullptr),
+        m_mappingSize(0)
+#endif
+    {
+    }
+
+#ifdef __unix__
+    // Maps 'size' bytes of the file at 'offset' and advises the kernel about
+    // the access pattern, so the pages are read ahead of the first touch.
+    FileRegion(FILE* file, int64_t offset, size_t size)
+    {
+        int64_t pageSize = (int64_t)sysconf(_SC_PAGESIZE);
+        int64_t alignedOffset = offset - offset % pageSize;
+        m_mappingSize = size + (size_t)(offset - alignedOffset);
+        m_mappingStart = mmap(nullptr, m_mappingSize, PROT_READ, MAP_PRIVATE, fileno(file), alignedOffset);
+        if (m_mappingStart == MAP_FAILED)
+        {
+            m_mappingStart = nullptr;
+            RuntimeError("Error mapping a region of the input file: %s.", strerror(errno));
+        }
+
+        // The chunk will be consumed front to back, likely soon.
+        madvise(m_mappingStart, m_mappingSize, MADV_SEQUENTIAL);
+        madvise(m_mappingStart, m_mappingSize, MADV_WILLNEED);
+
+        m_data = (byte*)m_mappingStart + (offset - alignedOffset);
+    }
+#endif
+
+    ~FileRegion()
+    {
+#ifdef __unix__
+        if (m_mappingStart != nullptr)
+            munmap(m_mappingStart, m_mappingSize);
+#endif
+    }
+
+    byte* Data() const { return m_data; }
+
+    DISABLE_COPY_AND_MOVE(FileRegion);
+
+private:
+    // Owned storage, used when the region is not memory-mapped.
+    unique_ptr<byte[]> m_buffer;
+
+    // Start of the requested byte range.
+    byte* m_data;
+
+#ifdef __unix__
+    void* m_mappingStart; // page-aligned base of the mapping
+    size_t m_mappingSize;
+#endif
+};
+
+typedef shared_ptr<FileRegion> FileRegionPtr;
+
 }}}
 #endif
\ No newline at end of file
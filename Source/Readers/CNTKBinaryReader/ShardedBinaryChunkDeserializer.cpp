@@ -0,0 +1,127 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#include "stdafx.h"
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <algorithm>
+#include "ShardedBinaryChunkDeserializer.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+ShardedBinaryChunkDeserializer::ShardedBinaryChunkDeserializer(const BinaryConfigHelper& helper) :
+    DataDeserializerBase(true)
+{
+    const auto& paths = helper.GetFilePaths();
+    size_t numberOfWorkers = helper.GetNumberOfWorkers();
+    size_t workerRank = helper.GetWorkerRank();
+
+    if (paths.size() < numberOfWorkers)
+    {
+        InvalidArgument("The dataset consists of %d shards, which is not enough for %d workers. "
+            "Please decrease the number of workers or re-shard the dataset.",
+            (int)paths.size(), (int)numberOfWorkers);
+    }
+
+    ChunkIdType firstChunkId = 0;
+    size_t firstSequenceKey = 0;
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        // Shards are assigned to workers round-robin; only open the ones this worker owns.
+        if (i % numberOfWorkers != workerRank)
+            continue;
+
+        Shard shard;
+        shard.m_deserializer = make_shared<BinaryChunkDeserializer>(helper, paths[i]);
+        shard.m_firstChunkId = firstChunkId;
+        shard.m_firstSequenceKey = firstSequenceKey;
+
+        auto chunks = shard.m_deserializer->GetChunkDescriptions();
+        shard.m_numberOfChunks = (ChunkIdType)chunks.size();
+        firstChunkId += shard.m_numberOfChunks;
+        for (const auto& chunk : chunks)
+            firstSequenceKey += chunk->m_numberOfSequences;
+
+        // All shards must describe the same set of streams.
+        auto streams = shard.m_deserializer->GetStreamDescriptions();
+        if (m_streams.empty())
+        {
+            m_streams = streams;
+        }
+        else
+        {
+            if (streams.size() != m_streams.size())
+                RuntimeError("Shard '%ls' contains %d streams, while the first shard contains %d.",
+                    paths[i].c_str(), (int)streams.size(), (int)m_streams.size());
+
+            for (size_t j = 0; j < streams.size(); ++j)
+            {
+                if (streams[j]->m_name != m_streams[j]->m_name ||
+                    streams[j]->m_storageType != m_streams[j]->m_storageType ||
+                    streams[j]->m_elementType != m_streams[j]->m_elementType ||
+                    streams[j]->m_sampleLayout->GetNumElements() != m_streams[j]->m_sampleLayout->GetNumElements())
+                {
+                    RuntimeError("Shard '%ls' describes stream '%ls' differently than the first shard.",
+                        paths[i].c_str(), m_streams[j]->m_name.c_str());
+                }
+            }
+        }
+
+        m_shards.push_back(std::move(shard));
+    }
+
+    assert(!m_shards.empty());
+}
+
+const ShardedBinaryChunkDeserializer::Shard& ShardedBinaryChunkDeserializer::GetShard(ChunkIdType chunkId) const
+{
+    auto it = std::upper_bound(m_shards.begin(), m_shards.end(), chunkId,
+        [](ChunkIdType id, const Shard& shard) { return id < shard.m_firstChunkId; });
+
+    if (it == m_shards.begin())
+        LogicError("Requested chunk %u does not belong to any shard.", (unsigned int)chunkId);
+
+    const Shard& shard = *(it - 1);
+    if (chunkId - shard.m_firstChunkId >= shard.m_numberOfChunks)
+        LogicError("Requested chunk %u does not belong to any shard.", (unsigned int)chunkId);
+
+    return shard;
+}
+
+ChunkDescriptions ShardedBinaryChunkDeserializer::GetChunkDescriptions()
+{
+    ChunkDescriptions result;
+    for (const auto& shard : m_shards)
+    {
+        for (const auto& chunk : shard.m_deserializer->GetChunkDescriptions())
+        {
+            result.push_back(shared_ptr<ChunkDescription>(new ChunkDescription{
+                chunk->m_id + shard.m_firstChunkId, chunk->m_numberOfSamples, chunk->m_numberOfSequences }));
+        }
+    }
+
+    return result;
+}
+
+void ShardedBinaryChunkDeserializer::GetSequencesForChunk(ChunkIdType chunkId, std::vector<SequenceDescription>& result)
+{
+    const Shard& shard = GetShard(chunkId);
+    shard.m_deserializer->GetSequencesForChunk(chunkId - shard.m_firstChunkId, result);
+
+    // The shard numbers its chunks and sequence keys from zero, remap them into the combined numbering.
+    for (auto& description : result)
+    {
+        description.m_chunkId = chunkId;
+        description.m_key.m_sequence += shard.m_firstSequenceKey;
+    }
+}
+
+ChunkPtr ShardedBinaryChunkDeserializer::GetChunk(ChunkIdType chunkId)
+{
+    const Shard& shard = GetShard(chunkId);
+    return shard.m_deserializer->GetChunk(chunkId - shard.m_firstChunkId);
+}
+
+}}}
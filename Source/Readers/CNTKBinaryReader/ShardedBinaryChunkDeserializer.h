@@ -0,0 +1,60 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#pragma once
+
+#include "DataDeserializerBase.h"
+#include "BinaryConfigHelper.h"
+#include "BinaryChunkDeserializer.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// Deserializer for sharded CBF datasets. Each shard is an ordinary,
+// self-describing CBF file with its own chunk table, so a worker only has to
+// open and index the shards assigned to it (round-robin by worker rank), not
+// the whole dataset. The chunks of the assigned shards are exposed under a
+// single contiguous chunk id range.
+class ShardedBinaryChunkDeserializer : public DataDeserializerBase {
+public:
+    explicit ShardedBinaryChunkDeserializer(const BinaryConfigHelper& helper);
+
+    // Retrieves a chunk of data.
+    ChunkPtr GetChunk(ChunkIdType chunkId) override;
+
+    // Get information about chunks.
+    ChunkDescriptions GetChunkDescriptions() override;
+
+    // Get information about particular chunk.
+    void GetSequencesForChunk(ChunkIdType chunkId, vector<SequenceDescription>& result) override;
+
+private:
+    // A shard assigned to this worker.
+    struct Shard
+    {
+        std::shared_ptr<BinaryChunkDeserializer> m_deserializer;
+
+        // Chunk id of the shard's first chunk in the combined chunk numbering.
+        ChunkIdType m_firstChunkId;
+
+        // Number of chunks in the shard.
+        ChunkIdType m_numberOfChunks;
+
+        // Key offset of the shard's first sequence (each shard file numbers
+        // its sequences from zero). Note that the resulting keys are only
+        // unique within a worker, which is sufficient since every worker
+        // operates on its own subset of the shards.
+        size_t m_firstSequenceKey;
+    };
+
+    // Finds the shard that owns the given chunk id.
+    const Shard& GetShard(ChunkIdType chunkId) const;
+
+    // All shards assigned to this worker, ordered by their first chunk id.
+    std::vector<Shard> m_shards;
+
+    DISABLE_COPY_AND_MOVE(ShardedBinaryChunkDeserializer);
+};
+
+}}}
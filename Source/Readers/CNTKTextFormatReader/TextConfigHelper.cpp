@@ -123,6 +123,8 @@ TextConfigHelper::TextConfigHelper(const ConfigParameters& config)
     m_traceLevel = config(L"traceLevel", 1);
     m_chunkSizeBytes = config(L"chunkSizeInBytes", g_32MB); // 32 MB by default
     m_keepDataInMemory = config(L"keepDataInMemory", false);
+    m_cacheSizeBytes = config(L"cacheSizeInBytes", (size_t)0); // 0 - cache is unbounded
+    m_numParseThreads = config(L"numParseThreads", (size_t)1); // 0 - one thread per hardware thread
     m_frameMode = config(L"frameMode", false);
 
     m_randomizationWindow = GetRandomizationWindowFromConfig(config);
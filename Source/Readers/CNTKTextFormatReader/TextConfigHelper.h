@@ -39,6 +39,10 @@ public:
 
     bool ShouldKeepDataInMemory() const { return m_keepDataInMemory; }
 
+    size_t GetCacheSizeInBytes() const { return m_cacheSizeBytes; }
+
+    size_t GetNumParseThreads() const { return m_numParseThreads; }
+
     bool IsInFrameMode() const { return m_frameMode; }
 
     ElementType GetElementType() const { return m_elementType; }
@@ -57,7 +61,9 @@ private:
     unsigned int m_maxErrors;
     unsigned int m_traceLevel;
     size_t m_chunkSizeBytes; // chunks size in bytes
-    bool m_keepDataInMemory; // if true the whole dataset is kept in memory
+    bool m_keepDataInMemory; // if true the dataset is cached in memory
+    size_t m_cacheSizeBytes; // byte budget of the in-memory cache, 0 - unbounded
+    size_t m_numParseThreads; // number of threads parsing a single chunk, 0 - one per hardware thread
     bool m_frameMode; // if true, the maximum expected sequence length in the dataset is one sample.
 };
 
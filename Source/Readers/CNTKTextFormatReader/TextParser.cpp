@@ -7,10 +7,20 @@
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
 #include <cfloat>
+#include <future>
+#include <thread>
 #include "Indexer.h"
 #include "TextParser.h"
 #include "TextReaderConstants.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXT_PARSER_USE_SSE2
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 #define isSign(c) ((c == '-' || c == '+'))
 #define isE(c) ((c == 'e' || c == 'E'))
 
@@ -21,6 +31,42 @@ inline bool IsDigit(char c)
     return '0' <= c && c <= '9';
 }
 
+// Returns a pointer to the first character in [begin, end) that is not a decimal digit
+// (end, if there is none). Scans 16 characters at a time when SSE2 is available;
+// locating the end of a digit run up front removes the per-character branching
+// from the hot loops of the number parsers below.
+inline const char* FindNonDigit(const char* begin, const char* end)
+{
+#ifdef TEXT_PARSER_USE_SSE2
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    while (begin + 16 <= end)
+    {
+        __m128i chars = _mm_loadu_si128((const __m128i*)begin);
+        // (c - '0') <= 9 computed with unsigned saturation: the second subtraction
+        // yields zero exactly for the digit characters.
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8(chars, zeroChar), nine), _mm_setzero_si128());
+        int mask = _mm_movemask_epi8(isDigit);
+        if (mask != 0xffff)
+        {
+            unsigned long index;
+#ifdef _MSC_VER
+            _BitScanForward(&index, ~(unsigned long)mask);
+#else
+            index = (unsigned long)__builtin_ctz(~(unsigned)mask);
+#endif
+            return begin + index;
+        }
+        begin += 16;
+    }
+#endif
+    while (begin != end && IsDigit(*begin))
+    {
+        ++begin;
+    }
+    return begin;
+}
+
 enum State
 {
     Init = 0,
@@ -60,6 +106,31 @@ struct TextParser<ElemType>::StreamInfo
     size_t m_sampleDimension;
 };
 
+template <class ElemType>
+struct TextParser<ElemType>::ParseContext
+{
+    ParseContext(const char* bufferStart, size_t bufferSize, int64_t bufferOffsetInFile, size_t maxAliasLength) :
+        m_bufferStart(bufferStart),
+        m_end(bufferStart + bufferSize),
+        m_pos(bufferStart),
+        m_bufferOffsetInFile(bufferOffsetInFile),
+        m_scratch(new char[maxAliasLength + 1])
+    {
+    }
+
+    const char* m_bufferStart;      // start of the buffered chunk
+    const char* m_end;              // end of the buffered chunk
+    const char* m_pos;              // current position within the buffer
+    int64_t m_bufferOffsetInFile;   // file offset of the buffer start (for diagnostics)
+
+    unique_ptr<char[]> m_scratch;   // local buffer for string parsing
+
+    // Returns true if there's still data available.
+    bool inline CanRead() const { return m_pos != m_end; }
+
+    int64_t GetFileOffset() const { return m_bufferOffsetInFile + (m_pos - m_bufferStart); }
+};
+
 template <class ElemType>
 TextParser<ElemType>::TextParser(CorpusDescriptorPtr corpus, const TextConfigHelper& helper, bool primary) :
 TextParser(corpus, helper.GetFilePath(), helper.GetStreams(), primary)
@@ -68,6 +139,7 @@ TextParser(corpus, helper.GetFilePath(), helper.GetStreams(), primary)
     SetMaxAllowedErrors(helper.GetMaxAllowedErrors());
     SetChunkSize(helper.GetChunkSize());
     SetSkipSequenceIds(helper.ShouldSkipSequenceIds());
+    SetNumParseThreads(helper.GetNumParseThreads());
 
     Initialize();
 }
@@ -80,13 +152,8 @@ TextParser<ElemType>::TextParser(CorpusDescriptorPtr corpus, const std::wstring&
     m_file(nullptr),
     m_streamInfos(streams.size()),
     m_indexer(nullptr),
-    m_fileOffsetStart(0),
-    m_fileOffsetEnd(0),
-    m_buffer(new char[BUFFER_SIZE + 1]),
-    m_bufferStart(nullptr),
-    m_bufferEnd(nullptr),
-    m_pos(nullptr),
     m_chunkSizeBytes(0),
+    m_parseThreadCount(1),
     m_traceLevel(TraceLevel::Error),
     m_hadWarnings(false),
     m_numAllowedErrors(0),
@@ -116,8 +183,6 @@ TextParser<ElemType>::TextParser(CorpusDescriptorPtr corpus, const std::wstring&
     }
 
     assert(m_maxAliasLength > 0);
-
-    m_scratch = unique_ptr<char[]>(new char[m_maxAliasLength + 1]);
 }
 
 template <class ElemType>
@@ -168,19 +233,12 @@ void TextParser<ElemType>::Initialize()
                 "UTF-16 encoding is currently not supported.", m_filename.c_str());
         }
 
-        m_indexer = make_unique<Indexer>(m_file, m_primary, m_skipSequenceIds, NAME_PREFIX, m_chunkSizeBytes);
+        m_indexer = make_unique<Indexer>(m_file, m_primary, m_skipSequenceIds, NAME_PREFIX, m_chunkSizeBytes,
+            2 * 1024 * 1024 /*bufferSize*/, m_filename /*enables parallel indexing and the index cache*/);
         m_indexer->Build(m_corpus);
     });
 
     assert(m_indexer != nullptr);
-
-    int64_t position = _ftelli64(m_file);
-    if (position < 0)
-    {
-        RuntimeError("Error retrieving current position in the input file (%ls).", m_filename.c_str());
-    }
-
-    m_fileOffsetEnd = m_fileOffsetStart = static_cast<size_t>(position);
 }
 
 template <class ElemType>
@@ -264,79 +322,82 @@ ChunkPtr TextParser<ElemType>::GetChunk(ChunkIdType chunkId)
 template <class ElemType>
 void TextParser<ElemType>::LoadChunk(TextChunkPtr& chunk, const ChunkDescriptor& descriptor)
 {
-    chunk->m_sequenceMap.resize(descriptor.m_sequences.size());
-    for (size_t sequenceIndex = 0; sequenceIndex < descriptor.m_sequences.size(); ++sequenceIndex)
+    // Read the whole chunk with a single sequential read.
+    unique_ptr<char[]> buffer(new char[descriptor.m_byteSize]);
+    if (_fseeki64(m_file, descriptor.m_offset, SEEK_SET))
     {
-        const auto& sequenceDescriptor = descriptor.m_sequences[sequenceIndex];
-        chunk->m_sequenceMap[sequenceIndex] = LoadSequence(sequenceDescriptor, descriptor.m_offset);
+        PrintWarningNotification();
+        RuntimeError("Error seeking to position %" PRId64 " in the input file (%ls).",
+            (int64_t)descriptor.m_offset, m_filename.c_str());
     }
-}
 
-template <class ElemType>
-void TextParser<ElemType>::IncrementNumberOfErrorsOrDie()
-{
-    if (m_numAllowedErrors == 0)
+    if (fread(buffer.get(), 1, descriptor.m_byteSize, m_file) != descriptor.m_byteSize)
     {
         PrintWarningNotification();
-        RuntimeError("Reached the maximum number of allowed errors"
-            " while reading the input file (%ls).",
-            m_filename.c_str());
+        RuntimeError("Could not read from the input file (%ls).", m_filename.c_str());
     }
-    --m_numAllowedErrors;
-}
 
-template <class ElemType>
-bool TextParser<ElemType>::TryRefillBuffer()
-{
-    size_t bytesRead = fread(m_buffer.get(), 1, BUFFER_SIZE, m_file);
+    size_t numSequences = descriptor.m_sequences.size();
+    chunk->m_sequenceMap.resize(numSequences);
 
-    if (bytesRead == (size_t)-1)
+    size_t numThreads = m_parseThreadCount != 0 ? m_parseThreadCount : std::thread::hardware_concurrency();
+    numThreads = std::min(std::max<size_t>(numThreads, 1), numSequences);
+    if (numThreads <= 1)
     {
-        PrintWarningNotification();
-        RuntimeError("Could not read from the input file (%ls).", m_filename.c_str());
+        ParseContext context(buffer.get(), descriptor.m_byteSize, descriptor.m_offset, m_maxAliasLength);
+        for (size_t sequenceIndex = 0; sequenceIndex < numSequences; ++sequenceIndex)
+        {
+            chunk->m_sequenceMap[sequenceIndex] = LoadSequence(context, descriptor.m_sequences[sequenceIndex]);
+        }
+        return;
     }
 
-    if (!bytesRead)
+    // Parse disjoint sequence ranges of the chunk concurrently, each worker
+    // with a private context over the shared chunk buffer. With more than one
+    // parsing thread, warnings from different sequences may interleave.
+    std::vector<std::future<void>> workers;
+    size_t sequencesPerThread = (numSequences + numThreads - 1) / numThreads;
+    for (size_t begin = 0; begin < numSequences; begin += sequencesPerThread)
     {
-        return false;
+        size_t end = std::min(begin + sequencesPerThread, numSequences);
+        workers.push_back(std::async(std::launch::async,
+            [this, &chunk, &descriptor, &buffer, begin, end]()
+            {
+                ParseContext context(buffer.get(), descriptor.m_byteSize, descriptor.m_offset, m_maxAliasLength);
+                for (size_t sequenceIndex = begin; sequenceIndex < end; ++sequenceIndex)
+                {
+                    chunk->m_sequenceMap[sequenceIndex] = LoadSequence(context, descriptor.m_sequences[sequenceIndex]);
+                }
+            }));
     }
 
-    m_fileOffsetStart = m_fileOffsetEnd;
-    m_fileOffsetEnd += bytesRead;
-    m_bufferStart = m_buffer.get();
-    m_pos = m_bufferStart;
-    m_bufferEnd = m_bufferStart + bytesRead;
-    return true;
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
 }
 
 template <class ElemType>
-void TextParser<ElemType>::SetFileOffset(int64_t offset)
+void TextParser<ElemType>::IncrementNumberOfErrorsOrDie()
 {
-    int rc = _fseeki64(m_file, offset, SEEK_SET);
-    if (rc)
+    // Check-and-decrement has to be atomic, chunks may be parsed on multiple threads.
+    unsigned int remaining = m_numAllowedErrors;
+    do
     {
-        PrintWarningNotification();
-        RuntimeError("Error seeking to position %" PRId64 " in the input file (%ls).",
-            offset, m_filename.c_str());
-    }
-
-    m_fileOffsetStart = offset;
-    m_fileOffsetEnd = offset;
-
-    TryRefillBuffer();
+        if (remaining == 0)
+        {
+            PrintWarningNotification();
+            RuntimeError("Reached the maximum number of allowed errors"
+                " while reading the input file (%ls).",
+                m_filename.c_str());
+        }
+    } while (!m_numAllowedErrors.compare_exchange_weak(remaining, remaining - 1));
 }
 
 template <class ElemType>
-typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence(const SequenceDescriptor& sequenceDsc, size_t chunkOffsetInFile)
+typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence(ParseContext& context, const SequenceDescriptor& sequenceDsc)
 {
-    size_t fileOffset = sequenceDsc.OffsetInChunk() + chunkOffsetInFile;
-    if (fileOffset < m_fileOffsetStart || fileOffset > m_fileOffsetEnd)
-    {
-        SetFileOffset(fileOffset);
-    }
-
-    size_t bufferOffset = fileOffset - m_fileOffsetStart;
-    m_pos = m_bufferStart + bufferOffset;
+    context.m_pos = context.m_bufferStart + sequenceDsc.OffsetInChunk();
     size_t bytesToRead = sequenceDsc.SizeInBytes();
 
     SequenceBuffer sequence;
@@ -358,7 +419,7 @@ typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence
     size_t numRowsRead = 0, expectedRowCount = sequenceDsc.m_numberOfSamples;
     for (size_t i = 0; i < expectedRowCount; i++)
     {
-        if ((TryReadRow(sequence, bytesToRead)))
+        if ((TryReadRow(context, sequence, bytesToRead)))
         {
             ++numRowsRead;
         }
@@ -371,7 +432,7 @@ typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence
                     " while loading sequence (id = %" PRIu64 ") %ls.\n",
                     i + 1,
                     sequenceDsc.m_key.m_sequence,
-                    GetFileInfo().c_str());
+                    GetFileInfo(context).c_str());
             }
             IncrementNumberOfErrorsOrDie();
         }
@@ -385,7 +446,7 @@ typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence
                     " expected for the current sequence (id = %" PRIu64 ") %ls,"
                     " but only read %" PRIu64 " out of %" PRIu64 " expected rows.\n",
                     sequenceDsc.m_key.m_sequence,
-                    GetFileInfo().c_str(), numRowsRead, expectedRowCount);
+                    GetFileInfo(context).c_str(), numRowsRead, expectedRowCount);
             }
             break;
         }
@@ -401,7 +462,7 @@ typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence
         {
             fprintf(stderr,
                 "ERROR: Input ('%ls') is empty in sequence (id = %" PRIu64 ") %ls.\n",
-                m_streams[i]->m_name.c_str(), sequenceDsc.m_key.m_sequence, GetFileInfo().c_str());
+                m_streams[i]->m_name.c_str(), sequenceDsc.m_key.m_sequence, GetFileInfo(context).c_str());
             hasEmptyInputs = true;
         }
 
@@ -414,7 +475,7 @@ typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence
                     "WARNING: Input ('%ls') contains more samples than expected"
                     " (%u vs. %" PRIu64 ") for sequence (id = %" PRIu64 ") %ls.\n",
                     m_streams[i]->m_name.c_str(), sequence[i]->m_numberOfSamples, expectedRowCount,
-                    sequenceDsc.m_key.m_sequence, GetFileInfo().c_str());
+                    sequenceDsc.m_key.m_sequence, GetFileInfo(context).c_str());
             }
         }
         maxInputLength = max(sequence[i]->m_numberOfSamples, maxInputLength);
@@ -438,7 +499,7 @@ typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence
                 "WARNING: Maximum per-input number of samples for sequence (id = %" PRIu64 ") %ls"
                 " is less than expected (%u vs. %" PRIu64 ").\n",
                 sequenceDsc.m_key.m_sequence,
-                GetFileInfo().c_str(), maxInputLength, expectedRowCount);
+                GetFileInfo(context).c_str(), maxInputLength, expectedRowCount);
         }
         IncrementNumberOfErrorsOrDie();
     }
@@ -448,7 +509,7 @@ typename TextParser<ElemType>::SequenceBuffer TextParser<ElemType>::LoadSequence
         fprintf(stderr,
             "INFO: Finished loading sequence (id = %" PRIu64 ") %ls,"
             " successfully read %" PRIu64 " out of expected %" PRIu64 " rows.\n",
-            sequenceDsc.m_key.m_sequence, GetFileInfo().c_str(), numRowsRead, expectedRowCount);
+            sequenceDsc.m_key.m_sequence, GetFileInfo(context).c_str(), numRowsRead, expectedRowCount);
     }
 
     FillSequenceMetadata(sequence, sequenceDsc.m_key);
@@ -479,37 +540,38 @@ void TextParser<ElemType>::FillSequenceMetadata(SequenceBuffer& sequenceData, co
 }
 
 template <class ElemType>
-bool TextParser<ElemType>::TryReadRow(SequenceBuffer& sequence, size_t& bytesToRead)
+bool TextParser<ElemType>::TryReadRow(ParseContext& context, SequenceBuffer& sequence, size_t& bytesToRead)
 {
-    while (bytesToRead && CanRead() && IsDigit(*m_pos))
     {
         // skip sequence ids
-        ++m_pos;
-        --bytesToRead;
+        const char* runEnd = FindNonDigit(context.m_pos,
+            context.m_pos + std::min(bytesToRead, (size_t)(context.m_end - context.m_pos)));
+        bytesToRead -= runEnd - context.m_pos;
+        context.m_pos = runEnd;
     }
 
     size_t numSampleRead = 0;
-    while (bytesToRead && CanRead())
+    while (bytesToRead && context.CanRead())
     {
-        char c = *m_pos;
+        char c = *context.m_pos;
 
         if (c == ROW_DELIMITER)
         {
             // found the end of row, skip the delimiter, return.
-            ++m_pos;
+            ++context.m_pos;
             --bytesToRead;
 
             if (numSampleRead == 0 && ShouldWarn())
             {
                 fprintf(stderr,
-                    "WARNING: Empty input row %ls.\n", GetFileInfo().c_str());
+                    "WARNING: Empty input row %ls.\n", GetFileInfo(context).c_str());
             }
             else if (numSampleRead > m_streams.size() && ShouldWarn())
             {
                 fprintf(stderr,
                     "WARNING: Input row %ls contains more"
                     " samples than expected (%" PRIu64 " vs. %" PRIu64 ").\n",
-                    GetFileInfo().c_str(), numSampleRead, m_streams.size());
+                    GetFileInfo(context).c_str(), numSampleRead, m_streams.size());
             }
 
             return numSampleRead > 0;
@@ -518,19 +580,19 @@ bool TextParser<ElemType>::TryReadRow(SequenceBuffer& sequence, size_t& bytesToR
         if (isColumnDelimiter(c))
         {
             // skip column (input) delimiters.
-            ++m_pos;
+            ++context.m_pos;
             --bytesToRead;
             continue;
         }
 
-        if (TryReadSample(sequence, bytesToRead))
+        if (TryReadSample(context, sequence, bytesToRead))
         {
             numSampleRead++;
         }
         else
         {
             // skip over until the next sample/end of row
-            SkipToNextInput(bytesToRead);
+            SkipToNextInput(context, bytesToRead);
         }
     }
 
@@ -539,7 +601,7 @@ bool TextParser<ElemType>::TryReadRow(SequenceBuffer& sequence, size_t& bytesToR
         fprintf(stderr,
             "WARNING: Exhausted all input expected for the current sequence"
             " while reading an input row %ls."
-            " Possibly, a trailing newline is missing.\n", GetFileInfo().c_str());
+            " Possibly, a trailing newline is missing.\n", GetFileInfo(context).c_str());
     }
 
     // Return true when we've consumed all expected input.
@@ -548,40 +610,40 @@ bool TextParser<ElemType>::TryReadRow(SequenceBuffer& sequence, size_t& bytesToR
 
 // Reads one sample (an pipe-prefixed input identifier followed by a list of values)
 template <class ElemType>
-bool TextParser<ElemType>::TryReadSample(SequenceBuffer& sequence, size_t& bytesToRead)
+bool TextParser<ElemType>::TryReadSample(ParseContext& context, SequenceBuffer& sequence, size_t& bytesToRead)
 {
-    assert(m_pos < m_bufferEnd);
+    assert(context.m_pos < context.m_end);
 
     // prefix check.
-    if (*m_pos != NAME_PREFIX)
+    if (*context.m_pos != NAME_PREFIX)
     {
         if (ShouldWarn())
         {
             fprintf(stderr,
                 "WARNING: Unexpected character('%c') in place of a name prefix ('%c')"
                 " in an input name %ls.\n",
-                *m_pos, NAME_PREFIX, GetFileInfo().c_str());
+                *context.m_pos, NAME_PREFIX, GetFileInfo(context).c_str());
         }
         IncrementNumberOfErrorsOrDie();
         return false;
     }
 
     // skip name prefix
-    ++m_pos;
+    ++context.m_pos;
     --bytesToRead;
 
-    if (bytesToRead && CanRead() && *m_pos == ESCAPE_SYMBOL)
+    if (bytesToRead && context.CanRead() && *context.m_pos == ESCAPE_SYMBOL)
     {
         // A vertical bar followed by the number sign (|#) is treated as an escape sequence, 
         // everything that follows is ignored until the next vertical bar or the end of 
         // row, whichever comes first.
-        ++m_pos;
+        ++context.m_pos;
         --bytesToRead;
         return false;
     }
 
     size_t id;
-    if (!TryGetInputId(id, bytesToRead))
+    if (!TryGetInputId(context, id, bytesToRead))
     {
         return false;
     }
@@ -594,7 +656,7 @@ bool TextParser<ElemType>::TryReadSample(SequenceBuffer& sequence, size_t& bytes
         vector<ElemType>& values = data->m_buffer;
         size_t size = values.size();
         assert(size % stream.m_sampleDimension == 0);
-        if (!TryReadDenseSample(values, stream.m_sampleDimension, bytesToRead))
+        if (!TryReadDenseSample(context, values, stream.m_sampleDimension, bytesToRead))
         {
             // expected a dense sample, but was not able to fully read it, ignore it.
             if (values.size() != size)
@@ -615,7 +677,7 @@ bool TextParser<ElemType>::TryReadSample(SequenceBuffer& sequence, size_t& bytes
         vector<IndexType>& indices = data->m_indicesBuffer;
         assert(values.size() == indices.size());
         size_t size = values.size();
-        if (!TryReadSparseSample(values, indices, stream.m_sampleDimension, bytesToRead))
+        if (!TryReadSparseSample(context, values, indices, stream.m_sampleDimension, bytesToRead))
         {
             // expected a sparse sample, but something went south, ignore it.
             if (values.size() != size)
@@ -643,22 +705,22 @@ bool TextParser<ElemType>::TryReadSample(SequenceBuffer& sequence, size_t& bytes
 }
 
 template <class ElemType>
-bool TextParser<ElemType>::TryGetInputId(size_t& id, size_t& bytesToRead)
+bool TextParser<ElemType>::TryGetInputId(ParseContext& context, size_t& id, size_t& bytesToRead)
 {
-    char* scratchIndex = m_scratch.get();
+    char* scratchIndex = context.m_scratch.get();
 
-    while (bytesToRead && CanRead())
+    while (bytesToRead && context.CanRead())
     {
-        char c = *m_pos;
+        char c = *context.m_pos;
 
         // stop as soon as there's a value delimiter, an input prefix
         // or a non-printable character (e.g., newline, carriage return).
         if (isValueDelimiter(c) || c == NAME_PREFIX || isNonPrintable(c))
         {
-            size_t size = scratchIndex - m_scratch.get();
+            size_t size = scratchIndex - context.m_scratch.get();
             if (size)
             {
-                string name(m_scratch.get(), size);
+                string name(context.m_scratch.get(), size);
                 auto it = m_aliasToIdMap.find(name);
                 if (it != m_aliasToIdMap.end())
                 {
@@ -671,7 +733,7 @@ bool TextParser<ElemType>::TryGetInputId(size_t& id, size_t& bytesToRead)
                     fprintf(stderr,
                         "INFO: Skipping unknown input ('%s') %ls. "
                         "Input name '%s' was not specified in the reader config section.\n",
-                        name.c_str(), GetFileInfo().c_str(), name.c_str());
+                        name.c_str(), GetFileInfo(context).c_str(), name.c_str());
                 }
 
                 // return false here to skip this input, but do not call IncrementNumberOfErrorsOrDie()
@@ -683,12 +745,12 @@ bool TextParser<ElemType>::TryGetInputId(size_t& id, size_t& bytesToRead)
                 fprintf(stderr,
                     "WARNING: Input name prefix ('%c') is followed by"
                     " an invalid character ('%c') %ls.\n",
-                    NAME_PREFIX, c, GetFileInfo().c_str());
+                    NAME_PREFIX, c, GetFileInfo(context).c_str());
             }
 
             break;
         }
-        else if (scratchIndex < (m_scratch.get() + m_maxAliasLength))
+        else if (scratchIndex < (context.m_scratch.get() + m_maxAliasLength))
         {
             *scratchIndex = c;
             ++scratchIndex;
@@ -699,17 +761,17 @@ bool TextParser<ElemType>::TryGetInputId(size_t& id, size_t& bytesToRead)
             // yet it's not followed by a delimiter.
             if (m_traceLevel >= Info)
             {
-                string namePrefix(m_scratch.get(), m_maxAliasLength);
+                string namePrefix(context.m_scratch.get(), m_maxAliasLength);
                 fprintf(stderr,
                     "INFO: Skipping unknown input %ls. "
                     "Input name (with the %" PRIu64 "-character prefix '%s') "
                     "exceeds the maximum expected length (%" PRIu64 ").\n",
-                    GetFileInfo().c_str(), m_maxAliasLength, namePrefix.c_str(), m_maxAliasLength);
+                    GetFileInfo(context).c_str(), m_maxAliasLength, namePrefix.c_str(), m_maxAliasLength);
             }
             return false;
         }
 
-        ++m_pos;
+        ++context.m_pos;
         --bytesToRead;
     }
 
@@ -718,13 +780,13 @@ bool TextParser<ElemType>::TryGetInputId(size_t& id, size_t& bytesToRead)
         {
             fprintf(stderr,
                 "WARNING: Exhausted all input expected for the current sequence"
-                " while reading an input name %ls.\n", GetFileInfo().c_str());
+                " while reading an input name %ls.\n", GetFileInfo(context).c_str());
         }
-        else if (!CanRead()) 
+        else if (!context.CanRead()) 
         {
             fprintf(stderr,
                 "WARNING: Expected %" PRIu64 " more bytes, but no more input is available for the current sequence"
-                " while reading an input name %ls.\n", bytesToRead, GetFileInfo().c_str());
+                " while reading an input name %ls.\n", bytesToRead, GetFileInfo(context).c_str());
         }
     }
     
@@ -734,19 +796,19 @@ bool TextParser<ElemType>::TryGetInputId(size_t& id, size_t& bytesToRead)
 }
 
 template <class ElemType>
-bool TextParser<ElemType>::TryReadDenseSample(vector<ElemType>& values, size_t sampleSize, size_t& bytesToRead)
+bool TextParser<ElemType>::TryReadDenseSample(ParseContext& context, vector<ElemType>& values, size_t sampleSize, size_t& bytesToRead)
 {
     size_t counter = 0;
     ElemType value;
 
-    while (bytesToRead && CanRead())
+    while (bytesToRead && context.CanRead())
     {
-        char c = *m_pos;
+        char c = *context.m_pos;
 
         if (isValueDelimiter(c))
         {
             // skip value delimiters
-            ++m_pos;
+            ++context.m_pos;
             --bytesToRead;
             continue;
         }
@@ -761,7 +823,7 @@ bool TextParser<ElemType>::TryReadDenseSample(vector<ElemType>& values, size_t s
                     fprintf(stderr,
                         "WARNING: Dense sample (size = %" PRIu64 ") %ls"
                         " exceeds the expected size (%" PRIu64 ").\n",
-                        counter, GetFileInfo().c_str(), sampleSize);
+                        counter, GetFileInfo(context).c_str(), sampleSize);
                 }
                 return false;
             }
@@ -775,7 +837,7 @@ bool TextParser<ElemType>::TryReadDenseSample(vector<ElemType>& values, size_t s
                     fprintf(stderr,
                         "WARNING: A dense sample %ls has a sparse suffix "
                         "(expected size = %" PRIu64 ", actual size = %" PRIu64 ").\n",
-                        GetFileInfo().c_str(), sampleSize, counter);
+                        GetFileInfo(context).c_str(), sampleSize, counter);
                 }
                 for (; counter < sampleSize; ++counter)
                 {
@@ -786,7 +848,7 @@ bool TextParser<ElemType>::TryReadDenseSample(vector<ElemType>& values, size_t s
             return true;
         }
 
-        if (!TryReadRealNumber(value, bytesToRead))
+        if (!TryReadRealNumber(context, value, bytesToRead))
         {
             // bail out.
             return false;
@@ -802,13 +864,13 @@ bool TextParser<ElemType>::TryReadDenseSample(vector<ElemType>& values, size_t s
         {
             fprintf(stderr,
                 "WARNING: Exhausted all input expected for the current sequence"
-                " while reading a dense sample %ls.\n", GetFileInfo().c_str());
+                " while reading a dense sample %ls.\n", GetFileInfo(context).c_str());
         }
-        else if (!CanRead())
+        else if (!context.CanRead())
         {
             fprintf(stderr,
                 "WARNING: Expected %" PRIu64 " more bytes, but no more input is available for the current sequence"
-                " while reading a dense sample %ls.\n", bytesToRead, GetFileInfo().c_str());
+                " while reading a dense sample %ls.\n", bytesToRead, GetFileInfo(context).c_str());
         }
     }
 
@@ -818,20 +880,20 @@ bool TextParser<ElemType>::TryReadDenseSample(vector<ElemType>& values, size_t s
 }
 
 template <class ElemType>
-bool TextParser<ElemType>::TryReadSparseSample(std::vector<ElemType>& values, std::vector<IndexType>& indices,
+bool TextParser<ElemType>::TryReadSparseSample(ParseContext& context, std::vector<ElemType>& values, std::vector<IndexType>& indices,
     size_t sampleSize, size_t& bytesToRead)
 {
     size_t index = 0;
     ElemType value;
 
-    while (bytesToRead && CanRead())
+    while (bytesToRead && context.CanRead())
     {
-        char c = *m_pos;
+        char c = *context.m_pos;
 
         if (isValueDelimiter(c))
         {
             // skip value delimiters
-            ++m_pos;
+            ++context.m_pos;
             --bytesToRead;
             continue;
         }
@@ -844,7 +906,7 @@ bool TextParser<ElemType>::TryReadSparseSample(std::vector<ElemType>& values, st
         }
 
         // read next sparse index
-        if (!TryReadUint64(index, bytesToRead))
+        if (!TryReadUint64(context, index, bytesToRead))
         {
             // bail out.
             return false;
@@ -857,14 +919,14 @@ bool TextParser<ElemType>::TryReadSparseSample(std::vector<ElemType>& values, st
                 fprintf(stderr,
                     "WARNING: Sparse index value (%" PRIu64 ") %ls"
                     " exceeds the maximum expected value (%" PRIu64 ").\n",
-                    index, GetFileInfo().c_str(), sampleSize - 1);
+                    index, GetFileInfo(context).c_str(), sampleSize - 1);
             }
             // bail out.
             return false;
         }
 
         // an index must be followed by a delimiter
-        c = *m_pos;
+        c = *context.m_pos;
         if (c != INDEX_DELIMITER)
         {
             if (ShouldWarn())
@@ -873,17 +935,17 @@ bool TextParser<ElemType>::TryReadSparseSample(std::vector<ElemType>& values, st
                     "WARNING: Unexpected character('%c')"
                     " in place of the index delimiter ('%c')"
                     " after a sparse value index (%" PRIu64 ") %ls.\n",
-                    c, INDEX_DELIMITER, index, GetFileInfo().c_str());
+                    c, INDEX_DELIMITER, index, GetFileInfo(context).c_str());
             }
             return false;
         }
 
         // skip index delimiter
-        ++m_pos;
+        ++context.m_pos;
         --bytesToRead;
 
         // read the corresponding value
-        if (!TryReadRealNumber(value, bytesToRead))
+        if (!TryReadRealNumber(context, value, bytesToRead))
         {
             // bail out.
             return false;
@@ -899,13 +961,13 @@ bool TextParser<ElemType>::TryReadSparseSample(std::vector<ElemType>& values, st
         {
             fprintf(stderr,
                 "WARNING: Exhausted all input expected for the current sequence"
-                " while reading a sparse sample %ls.\n", GetFileInfo().c_str());
+                " while reading a sparse sample %ls.\n", GetFileInfo(context).c_str());
         }
-        else if (!CanRead())
+        else if (!context.CanRead())
         {
             fprintf(stderr,
                 "WARNING: Expected %" PRIu64 " more bytes, but no more input is available for the current sequence"
-                " while reading a sparse sample %ls.\n", bytesToRead, GetFileInfo().c_str());
+                " while reading a sparse sample %ls.\n", bytesToRead, GetFileInfo(context).c_str());
         }
     }
 
@@ -915,45 +977,45 @@ bool TextParser<ElemType>::TryReadSparseSample(std::vector<ElemType>& values, st
 }
 
 template <class ElemType>
-void TextParser<ElemType>::SkipToNextValue(size_t& bytesToRead)
+void TextParser<ElemType>::SkipToNextValue(ParseContext& context, size_t& bytesToRead)
 {
-    while (bytesToRead && CanRead())
+    while (bytesToRead && context.CanRead())
     {
-        char c = *m_pos;
+        char c = *context.m_pos;
         // skip everything until we hit either a value delimiter, an input marker or the end of row.
         if (isValueDelimiter(c) || c == NAME_PREFIX || c == ROW_DELIMITER)
         {
             return;
         }
-        ++m_pos;
+        ++context.m_pos;
         --bytesToRead;
     }
 }
 
 template <class ElemType>
-void TextParser<ElemType>::SkipToNextInput(size_t& bytesToRead)
+void TextParser<ElemType>::SkipToNextInput(ParseContext& context, size_t& bytesToRead)
 {
-    while (bytesToRead && CanRead())
+    while (bytesToRead && context.CanRead())
     {
-        char c = *m_pos;
+        char c = *context.m_pos;
         // skip everything until we hit either an input marker or the end of row.
         if (c == NAME_PREFIX || c == ROW_DELIMITER)
         {
             return;
         }
-        ++m_pos;
+        ++context.m_pos;
         --bytesToRead;
     }
 }
 
 template <class ElemType>
-bool TextParser<ElemType>::TryReadUint64(size_t& value, size_t& bytesToRead)
+bool TextParser<ElemType>::TryReadUint64(ParseContext& context, size_t& value, size_t& bytesToRead)
 {
     value = 0;
     bool found = false;
-    while (bytesToRead && CanRead())
+    while (bytesToRead && context.CanRead())
     {
-        char c = *m_pos;
+        char c = *context.m_pos;
 
         if (!IsDigit(c))
         {
@@ -961,7 +1023,7 @@ bool TextParser<ElemType>::TryReadUint64(size_t& value, size_t& bytesToRead)
             {
                 fprintf(stderr,
                     "WARNING: Expected a uint64 value, but none found %ls.\n", 
-                    GetFileInfo().c_str());
+                    GetFileInfo(context).c_str());
             }
 
             return found;
@@ -969,22 +1031,25 @@ bool TextParser<ElemType>::TryReadUint64(size_t& value, size_t& bytesToRead)
 
         found |= true;
 
-        size_t temp = value;
-        value = value * 10 + (c - '0');
-        if (temp > value)
+        // Locate the end of the digit run up front, then accumulate.
+        const char* runEnd = FindNonDigit(context.m_pos,
+            context.m_pos + std::min(bytesToRead, (size_t)(context.m_end - context.m_pos)));
+        for (; context.m_pos != runEnd; ++context.m_pos, --bytesToRead)
         {
-            if (ShouldWarn())
+            size_t temp = value;
+            value = value * 10 + (*context.m_pos - '0');
+            if (temp > value)
             {
-                fprintf(stderr,
-                    "WARNING: Overflow while reading a uint64 value %ls.\n",
-                    GetFileInfo().c_str());
-            }
+                if (ShouldWarn())
+                {
+                    fprintf(stderr,
+                        "WARNING: Overflow while reading a uint64 value %ls.\n",
+                        GetFileInfo(context).c_str());
+                }
 
-            return false;
+                return false;
+            }
         }
-
-        ++m_pos;
-        --bytesToRead;
     }
 
     if (ShouldWarn())
@@ -992,13 +1057,13 @@ bool TextParser<ElemType>::TryReadUint64(size_t& value, size_t& bytesToRead)
         if (bytesToRead == 0) {
             fprintf(stderr,
                 "WARNING: Exhausted all input expected for the current sequence"
-                " while reading a uint64 value %ls.\n", GetFileInfo().c_str());
+                " while reading a uint64 value %ls.\n", GetFileInfo(context).c_str());
         }
-        else if (!CanRead())
+        else if (!context.CanRead())
         {
             fprintf(stderr,
                 "WARNING: Expected %" PRIu64 " more bytes, but no more input is available for the current sequence"
-                " while reading a uint64 value %ls.\n", bytesToRead, GetFileInfo().c_str());
+                " while reading a uint64 value %ls.\n", bytesToRead, GetFileInfo(context).c_str());
         }
         
     }
@@ -1013,19 +1078,19 @@ bool TextParser<ElemType>::TryReadUint64(size_t& value, size_t& bytesToRead)
 // Assumes that bytesToRead is greater than the number of characters 
 // in the string representation of the floating point number
 // (i.e., the string is followed by one of the delimiters)
-// Post condition: m_pos points to the first character that 
+// Post condition: context.m_pos points to the first character that 
 // cannot be parsed as part of a floating point number.
 // Returns true if parsing was successful.
 template <class ElemType>
-bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRead)
+bool TextParser<ElemType>::TryReadRealNumber(ParseContext& context, ElemType& value, size_t& bytesToRead)
 {
     State state = State::Init;
     double coefficient = .0, number = .0, divider = .0;
     bool negative = false;
 
-    while (bytesToRead && CanRead())
+    while (bytesToRead && context.CanRead())
     {
-        char c = *m_pos;
+        char c = *context.m_pos;
 
         switch (state)
         {
@@ -1048,7 +1113,7 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
                     fprintf(stderr,
                         "WARNING: Unexpected character ('%c')"
                         " in a floating point value %ls.\n",
-                        c, GetFileInfo().c_str());
+                        c, GetFileInfo(context).c_str());
                 }
                 return false;
             }
@@ -1067,7 +1132,7 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
                     fprintf(stderr,
                         "WARNING: A sign symbol is followed by an invalid character('%c')"
                         " in a floating point value %ls.\n",
-                        c, GetFileInfo().c_str());
+                        c, GetFileInfo(context).c_str());
                 }
                 return false;
             }
@@ -1075,7 +1140,14 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
         case IntegralPart:
             if (IsDigit(c))
             {
-                number = number * 10 + (c - '0');
+                // Accumulate the whole digit run located up front.
+                const char* runEnd = FindNonDigit(context.m_pos,
+                    context.m_pos + std::min(bytesToRead, (size_t)(context.m_end - context.m_pos)));
+                for (; context.m_pos != runEnd; ++context.m_pos, --bytesToRead)
+                {
+                    number = number * 10 + (*context.m_pos - '0');
+                }
+                continue;
             }
             else if (c == '.')
             {
@@ -1111,9 +1183,15 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
             if (IsDigit(c))
             {
                 // TODO: ignore if number of precision digits > FLT_[MANT_]DIG/DBL_[MANT_]DIG
-                // no state change
-                number = number * 10 + (c - '0');
-                divider *= 10;
+                // no state change, accumulate the whole digit run located up front.
+                const char* runEnd = FindNonDigit(context.m_pos,
+                    context.m_pos + std::min(bytesToRead, (size_t)(context.m_end - context.m_pos)));
+                for (; context.m_pos != runEnd; ++context.m_pos, --bytesToRead)
+                {
+                    number = number * 10 + (*context.m_pos - '0');
+                    divider *= 10;
+                }
+                continue;
             }
             else if (isE(c))
             {
@@ -1151,7 +1229,7 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
                     fprintf(stderr,
                         "WARNING: An exponent symbol is followed by"
                         " an invalid character('%c')"
-                        " in a floating point value %ls.\n", c, GetFileInfo().c_str());
+                        " in a floating point value %ls.\n", c, GetFileInfo(context).c_str());
                 }
                 return false;
             }
@@ -1170,7 +1248,7 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
                     fprintf(stderr,
                         "WARNING: An exponent sign symbol followed by"
                         " an unexpected character('%c')"
-                        " in a floating point value %ls.\n", c, GetFileInfo().c_str());
+                        " in a floating point value %ls.\n", c, GetFileInfo(context).c_str());
                 }
                 return false;
             }
@@ -1178,8 +1256,14 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
         case Exponent:
             if (IsDigit(c))
             {
-                // no state change
-                number = number * 10 + (c - '0');
+                // no state change, accumulate the whole digit run located up front.
+                const char* runEnd = FindNonDigit(context.m_pos,
+                    context.m_pos + std::min(bytesToRead, (size_t)(context.m_end - context.m_pos)));
+                for (; context.m_pos != runEnd; ++context.m_pos, --bytesToRead)
+                {
+                    number = number * 10 + (*context.m_pos - '0');
+                }
+                continue;
             }
             else
             {
@@ -1194,12 +1278,12 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
             {
                 fprintf(stderr,
                     "WARNING: Reached an invalid state while reading a floating point value %ls.\n",
-                    GetFileInfo().c_str());
+                    GetFileInfo(context).c_str());
             }
             return false;
         }
 
-        ++m_pos;
+        ++context.m_pos;
         --bytesToRead;
     }
 
@@ -1211,7 +1295,7 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
             fprintf(stderr,
                 "WARNING: Exhausted all input expected for the current sequence"
                 " while reading an input row %ls."
-                " Possibly, a trailing newline is missing.\n", GetFileInfo().c_str());
+                " Possibly, a trailing newline is missing.\n", GetFileInfo(context).c_str());
         }
 
         switch (state)
@@ -1235,7 +1319,7 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
         {
             fprintf(stderr,
                 "WARNING: Reached an invalid state while reading a floating point value %ls.\n",
-                GetFileInfo().c_str());
+                GetFileInfo(context).c_str());
         }
         return false;
     }
@@ -1244,7 +1328,7 @@ bool TextParser<ElemType>::TryReadRealNumber(ElemType& value, size_t& bytesToRea
     {
         fprintf(stderr,
             "WARNING: Expected %" PRIu64 " more bytes, but no more input is available for the current sequence"
-            " while reading an input row %ls.\n", bytesToRead, GetFileInfo().c_str());
+            " while reading an input row %ls.\n", bytesToRead, GetFileInfo(context).c_str());
     }
 
     return false;
@@ -1281,10 +1365,16 @@ void TextParser<ElemType>::SetNumRetries(unsigned int numRetries)
 }
 
 template <class ElemType>
-std::wstring TextParser<ElemType>::GetFileInfo()
+void TextParser<ElemType>::SetNumParseThreads(size_t numThreads)
+{
+    m_parseThreadCount = numThreads;
+}
+
+template <class ElemType>
+std::wstring TextParser<ElemType>::GetFileInfo(const ParseContext& context)
 {
     std::wstringstream info;
-    info << L"at offset " << GetFileOffset() << L" in the input file (" << m_filename << L")";
+    info << L"at offset " << context.GetFileOffset() << L" in the input file (" << m_filename << L")";
     return info.str();
 }
 
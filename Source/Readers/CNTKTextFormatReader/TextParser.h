@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "DataDeserializerBase.h"
 #include "Descriptors.h"
 #include "TextConfigHelper.h"
@@ -84,6 +85,11 @@ private:
 
     typedef std::shared_ptr<TextDataChunk> TextChunkPtr;
 
+    // A cursor over a fully buffered chunk. All parsing routines operate on a
+    // context instead of shared member state, so that disjoint sequence ranges
+    // of a chunk can be parsed concurrently.
+    struct ParseContext;
+
     enum TraceLevel
     {
         Error = 0,
@@ -104,21 +110,11 @@ private:
 
     std::unique_ptr<Indexer> m_indexer;
 
-    size_t m_fileOffsetStart;
-    size_t m_fileOffsetEnd;
-
-    // TODO: not DRY (same in the Indexer), needs refactoring
-    unique_ptr<char[]> m_buffer;
-    const char* m_bufferStart;
-    const char* m_bufferEnd;
-    const char* m_pos; // buffer index
-
-    unique_ptr<char[]> m_scratch; // local buffer for string parsing
-
     size_t m_chunkSizeBytes;
+    size_t m_parseThreadCount; // number of threads parsing a single chunk, 0 - one per hardware thread
     unsigned int m_traceLevel;
-    bool m_hadWarnings;
-    unsigned int m_numAllowedErrors;
+    std::atomic<bool> m_hadWarnings;
+    std::atomic<unsigned int> m_numAllowedErrors;
     bool m_skipSequenceIds;
     unsigned int m_numRetries; // specifies the number of times an unsuccessful
                                // file operation should be repeated (default value is 5).
@@ -134,48 +130,39 @@ private:
     // have been swallowed.
     void PrintWarningNotification();
 
-    void SetFileOffset(int64_t position);
-
-    void SkipToNextValue(size_t& bytesToRead);
-    void SkipToNextInput(size_t& bytesToRead);
-
-    bool TryRefillBuffer();
-
-    int64_t GetFileOffset() const { return m_fileOffsetStart + (m_pos - m_bufferStart); }
+    void SkipToNextValue(ParseContext& context, size_t& bytesToRead);
+    void SkipToNextInput(ParseContext& context, size_t& bytesToRead);
 
     // Returns a string containing input file information (current offset, file name, etc.),
     // which can be included as a part of the trace/log message.
-    std::wstring GetFileInfo();
+    std::wstring GetFileInfo(const ParseContext& context);
 
     // Reads an alias/name and converts it to an internal stream id (= stream index).
-    bool TryGetInputId(size_t& id, size_t& bytesToRead);
+    bool TryGetInputId(ParseContext& context, size_t& id, size_t& bytesToRead);
 
-    bool TryReadRealNumber(ElemType& value, size_t& bytesToRead);
+    bool TryReadRealNumber(ParseContext& context, ElemType& value, size_t& bytesToRead);
 
-    bool TryReadUint64(size_t& value, size_t& bytesToRead);
+    bool TryReadUint64(ParseContext& context, size_t& value, size_t& bytesToRead);
 
     // Reads dense sample values into the provided vector.
-    bool TryReadDenseSample(std::vector<ElemType>& values, size_t sampleSize, size_t& bytesToRead);
+    bool TryReadDenseSample(ParseContext& context, std::vector<ElemType>& values, size_t sampleSize, size_t& bytesToRead);
 
     // Reads sparse sample values and corresponding indices into the provided vectors.
-    bool TryReadSparseSample(std::vector<ElemType>& values, std::vector<IndexType>& indices,
+    bool TryReadSparseSample(ParseContext& context, std::vector<ElemType>& values, std::vector<IndexType>& indices,
         size_t sampleSize, size_t& bytesToRead);
 
     // Reads one sample (an input identifier followed by a list of values)
-    bool TryReadSample(SequenceBuffer& sequence, size_t& bytesToRead);
+    bool TryReadSample(ParseContext& context, SequenceBuffer& sequence, size_t& bytesToRead);
 
     // Reads one whole row (terminated by a row delimiter) of samples
-    bool TryReadRow(SequenceBuffer& sequence, size_t& bytesToRead);
-
-    // Returns true if there's still data available.
-    bool inline CanRead() { return m_pos != m_bufferEnd || TryRefillBuffer(); }
+    bool TryReadRow(ParseContext& context, SequenceBuffer& sequence, size_t& bytesToRead);
 
     // Returns true if the trace level is greater or equal to 'Warning'
     bool inline ShouldWarn() { m_hadWarnings = true; return m_traceLevel >= Warning; }
 
-    // Given a descriptor and the file offset of the containing chunk,
-    // retrieves the data for the corresponding sequence from the file.
-    SequenceBuffer LoadSequence(const SequenceDescriptor& descriptor, size_t chunkOffset);
+    // Given a descriptor and a context positioned over the containing chunk,
+    // parses the data for the corresponding sequence.
+    SequenceBuffer LoadSequence(ParseContext& context, const SequenceDescriptor& descriptor);
 
     // Given a descriptor, retrieves the data for the corresponding chunk from the file.
     void LoadChunk(TextChunkPtr& chunk, const ChunkDescriptor& descriptor);
@@ -193,6 +180,8 @@ private:
 
     void SetNumRetries(unsigned int numRetries);
 
+    void SetNumParseThreads(size_t numThreads);
+
     friend class CNTKTextFormatReaderTestRunner<ElemType>;
 
     DISABLE_COPY_AND_MOVE(TextParser);
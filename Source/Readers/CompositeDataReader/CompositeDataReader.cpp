@@ -15,6 +15,7 @@
 #include "Bundler.h"
 #include "BlockRandomizer.h"
 #include "NoRandomizer.h"
+#include "ShuffleBufferRandomizer.h"
 #include "FramePacker.h"
 #include "SequencePacker.h"
 #include "TruncatedBpttPacker.h"
@@ -40,7 +41,12 @@ CompositeDataReader::CompositeDataReader(const ConfigParameters& config) :
         ContainsDeserializer(config, L"ImageDeserializer");
 
     useNumericSequenceKeys = config(L"useNumericSequenceKeys", useNumericSequenceKeys);
-    m_corpus = std::make_shared<CorpusDescriptor>(useNumericSequenceKeys);
+
+    // Optionally keep only 64-bit hashes of symbolic sequence keys. This caps
+    // the corpus key registry memory on very large corpora, but error messages
+    // can then only report the key hash.
+    bool hashSequenceKeys = config(L"hashSequenceKeys", false);
+    m_corpus = std::make_shared<CorpusDescriptor>(useNumericSequenceKeys, hashSequenceKeys);
 
     // Identifying packing mode.
     bool frameMode = config(L"frameMode", false);
@@ -104,7 +110,23 @@ CompositeDataReader::CompositeDataReader(const ConfigParameters& config) :
     // It makes sense to put it to true for cases when deserialization is CPU intensive,
     // i.e. decompression of images.
     bool multiThreadedDeserialization = config(L"multiThreadedDeserialization", ContainsDeserializer(config, L"ImageDeserializer"));
-    if (randomize)
+
+    // Number of threads used for multithreaded sequence deserialization; 0 keeps the OpenMP
+    // default. A non-zero value implies multithreaded deserialization.
+    size_t deserializationThreadCount = config(L"deserializationThreadCount", (size_t)0);
+    if (deserializationThreadCount != 0)
+        multiThreadedDeserialization = true;
+
+    // A non-zero shuffle buffer size selects the streaming randomizer, whose
+    // memory is bounded by the buffer size instead of the full sequence index.
+    // Useful for corpora too large for BlockRandomizer to index.
+    size_t shuffleBufferSize = isActionWrite ? 0 : config(L"shuffleBufferSize", (size_t)0);
+    if (shuffleBufferSize != 0)
+    {
+        m_sequenceEnumerator = std::make_shared<ShuffleBufferRandomizer>(deserializer, shuffleBufferSize,
+            multiThreadedDeserialization, maxErrors, GetRandomSeed(config), deserializationThreadCount);
+    }
+    else if (randomize)
     {
         // By default randomizing the whole data set.
         size_t randomizationWindow = requestDataSize;
@@ -137,12 +159,27 @@ CompositeDataReader::CompositeDataReader(const ConfigParameters& config) :
         }
 
         bool shouldPrefetch = true;
-        m_sequenceEnumerator = std::make_shared<BlockRandomizer>(verbosity, randomizationWindow, deserializer, shouldPrefetch, 
-            multiThreadedDeserialization, maxErrors, sampleBasedRandomizationWindow, GetRandomSeed(config));
+
+        // Byte budget for look-ahead chunk prefetching; 0 keeps a single chunk of look-ahead.
+        size_t prefetchBudgetInBytes = config(L"prefetchBudgetInBytes", (size_t)0);
+
+        // Optional length-bucketed batching: group sequences of similar length within the
+        // randomization window so that minibatches need less padding. The bucket width (in
+        // samples) trades shuffling quality against padding waste; 0 disables bucketing.
+        size_t lengthBucketWidthInSamples = config(L"lengthBucketWidthInSamples", (size_t)0);
+
+        // Optional window-free randomization for frame-mode corpora: the randomized position
+        // mapping is computed from a seeded permutation function instead of being stored,
+        // keeping the randomizer memory at O(number of chunks) regardless of corpus size.
+        bool windowFreeRandomization = config(L"windowFreeRandomization", false);
+
+        m_sequenceEnumerator = std::make_shared<BlockRandomizer>(verbosity, randomizationWindow, deserializer, shouldPrefetch,
+            multiThreadedDeserialization, maxErrors, sampleBasedRandomizationWindow, GetRandomSeed(config), prefetchBudgetInBytes,
+            lengthBucketWidthInSamples, windowFreeRandomization, deserializationThreadCount);
     }
     else
     {
-        m_sequenceEnumerator = std::make_shared<NoRandomizer>(deserializer, multiThreadedDeserialization, maxErrors);
+        m_sequenceEnumerator = std::make_shared<NoRandomizer>(deserializer, multiThreadedDeserialization, maxErrors, deserializationThreadCount);
     }
 
     // In case when there are transforms, applying them to the data.
@@ -164,9 +201,14 @@ CompositeDataReader::CompositeDataReader(const ConfigParameters& config) :
         m_streams.push_back(stream);
     }
 
-    // Currently for prefetch we use two alternating buffers,
-    // same is the default.
-    size_t numAlternatingBuffers = 2;
+    // The packer cycles through a ring of pinned buffers so that it can pack
+    // the next minibatch while the asynchronous device transfers of the
+    // previous ones are still in flight. One buffer per prefetch slot is
+    // enough: a slot is only refilled after its transfer has been waited on.
+    // With the default prefetch depth of 1 this keeps the usual two
+    // alternating buffers.
+    size_t prefetchDepth = config(L"prefetchDepth", (size_t)1);
+    size_t numAlternatingBuffers = std::max<size_t>(2, prefetchDepth);
 
     // Check whether to use local timeline, by default we use it for better performance.
     bool localTimeline = config(L"localTimeline", true);
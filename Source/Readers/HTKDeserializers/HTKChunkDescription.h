@@ -7,6 +7,8 @@
 
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
+#include <algorithm>
+#include <numeric>
 #include "DataDeserializer.h"
 #include "HTKFeaturesIO.h"
 #include "UtteranceDescription.h"
@@ -136,9 +138,23 @@ public:
             // if this is the first feature read ever, we explicitly open the first file to get the information such as feature dimension
             msra::asr::htkfeatreader reader;
 
-            // read all utterances; if they are in the same archive, htkfeatreader will be efficient in not closing the file
+            // Read utterances grouped by their physical archive and ordered by offset within
+            // each archive: one open per archive and forward-only sequential reads, instead of
+            // an open/seek per utterance when the script interleaves archives. The destination
+            // stripe of each utterance is determined by its index, so the read order is free.
+            std::vector<size_t> readOrder(m_utterances.size());
+            std::iota(readOrder.begin(), readOrder.end(), 0);
+            std::sort(readOrder.begin(), readOrder.end(), [this](size_t a, size_t b)
+            {
+                const auto& pathA = m_utterances[a].GetPath();
+                const auto& pathB = m_utterances[b].GetPath();
+                if (pathA.archivePathIdx != pathB.archivePathIdx)
+                    return pathA.archivePathIdx < pathB.archivePathIdx;
+                return pathA.s < pathB.s;
+            });
+
             m_frames.resize(featureDimension, m_totalFrames);
-            foreach_index(i, m_utterances)
+            for (size_t i : readOrder)
             {
                 // read features for this file
                 auto framesWrapper = GetUtteranceFrames(i);
@@ -175,6 +175,7 @@ class htkfeatreader : protected htkfeatio
     vector<float> a, b;                  // for decompression
     vector<short> tmp;                   // for decompression
     vector<unsigned char> tmpByteVector; // for decompression of idx files
+    vector<unsigned char> bulkbuffer;    // raw bytes of a whole utterance, read with a single sequential I/O
     size_t curframe;                     // current # samples read so far
     size_t numframes;                    // number of samples for current logical file
     size_t energyElements;               // how many energy elements to add if addEnergy is true
@@ -506,15 +507,53 @@ public:
         }
         curframe++;
     }
+    // decode one frame from raw file bytes into feature values
+    // Mirrors read() above, except that the bytes come from memory.
+    void decodeframe(const unsigned char* raw, std::vector<float>& v)
+    {
+        if (!compressed && !isidxformat) // not compressed--the easy one
+        {
+            v.resize(featdim);
+            memcpy(v.data(), raw, featdim * sizeof(float));
+            if (needbyteswapping)
+                msra::util::byteswap(v);
+        }
+        else if (isidxformat)
+        {
+            v.resize(featdim);
+            foreach_index (k, v)
+                v[k] = (float) raw[k];
+        }
+        else // need to decompress
+        {
+            tmp.resize(featdim);
+            memcpy(tmp.data(), raw, featdim * sizeof(short));
+            if (needbyteswapping)
+                msra::util::byteswap(tmp);
+            // 'decompress' it
+            v.resize(tmp.size());
+            foreach_index (k, v)
+                v[k] = (tmp[k] + b[k]) / a[k];
+        }
+    }
     // read a sequence of vectors from the open file into a range of frames [ts,te)
     template <class MATRIX>
     void read(MATRIX& feat, size_t ts, size_t te)
     {
-        // read vectors from file and push to our target structure
+        if (curframe + (te - ts) > numframes)
+            RuntimeError("htkfeatreader:attempted to read beyond end");
+
+        // Read the raw bytes of all requested frames with one large sequential
+        // read, then decode frame by frame from memory. A read per frame makes
+        // chunk loads on networked file systems pay a round trip per frame.
+        bulkbuffer.resize((te - ts) * vecbytesize);
+        freadOrDie(bulkbuffer.data(), vecbytesize, te - ts, f);
+        curframe += te - ts;
+
         vector<float> v(featdim + energyElements);
         for (size_t t = ts; t < te; t++)
         {
-            read(v);
+            decodeframe(bulkbuffer.data() + (t - ts) * vecbytesize, v);
             // add the energy elements (all zero) if needed
             if (addEnergy)
             {
@@ -21,6 +21,8 @@
 #include <wchar.h>
 #include "simplesenonehmm.h"
 #include <array>
+#include <future>
+#include <thread>
 #include "minibatchsourcehelpers.h"
 
 namespace msra { namespace asr {
@@ -920,11 +922,16 @@ class htkmlfreader : public map<wstring, vector<ENTRY>> // [key][i] the data
         return lines;
     }
 
+    // parse a single entry, writing the results into caller-provided 'key',
+    // 'entries' and 'wordsequence' only. Shared state is read but never
+    // written, so entries can be parsed concurrently.
+    // Returns false if the entry is to be skipped (malformed or filtered out).
     template <typename WORDSYMBOLTABLE, typename UNITSYMBOLTABLE>
-    void parseentry(const vector<std::string>& lines, size_t line, const set<wstring>& restricttokeys,
+    bool parseentry(const vector<std::string>& lines, size_t line, const set<wstring>& restricttokeys,
                     const WORDSYMBOLTABLE* wordmap, const UNITSYMBOLTABLE* unitmap,
                     vector<typename WORDSEQUENCE::word>& wordseqbuffer, vector<typename WORDSEQUENCE::aligninfo>& alignseqbuffer,
-                    const double htkTimeToFrame)
+                    const double htkTimeToFrame,
+                    wstring& key, vector<ENTRY>& entries, WORDSEQUENCE& wordsequence)
     {
         size_t idx = 0;
         string filename = lines[idx++];
@@ -936,16 +943,16 @@ class htkmlfreader : public map<wstring, vector<ENTRY>> // [key][i] the data
         {
             fprintf(stderr, "warning: filename entry (%s)\n", filename.c_str());
             fprintf(stderr, "skip current mlf entry from line (%lu) until line (%lu).\n", (unsigned long)(line + idx), (unsigned long)(line + lines.size()));
-            return;
+            return false;
         }
 
         filename = filename.substr(1, filename.length() - 2); // strip quotes
         if (filename.find("*/") == 0)
             filename = filename.substr(2);
 #ifdef _MSC_VER
-        wstring key = msra::strfun::utf16(regex_replace(filename, regex("\\.[^\\.\\\\/:]*$"), string())); // delete extension (or not if none)
+        key = msra::strfun::utf16(regex_replace(filename, regex("\\.[^\\.\\\\/:]*$"), string())); // delete extension (or not if none)
 #else
-        wstring key = msra::strfun::utf16(msra::dbn::removeExtension(filename)); // note that c++ 4.8 is incomplete for supporting regex
+        key = msra::strfun::utf16(msra::dbn::removeExtension(filename)); // note that c++ 4.8 is incomplete for supporting regex
 #endif
 
         // determine lines range
@@ -955,11 +962,9 @@ class htkmlfreader : public map<wstring, vector<ENTRY>> // [key][i] the data
 
         // don't parse unused entries (this is supposed to be used for very small debugging setups with huge MLFs)
         if (!restricttokeys.empty() && restricttokeys.find(key) == restricttokeys.end())
-            return;
+            return false;
 
-        vector<ENTRY>& entries = (*this)[key]; // this creates a new entry
-        if (!entries.empty())
-            malformed(msra::strfun::strprintf("duplicate entry '%ls'", key.c_str()));
+        entries.clear();
         entries.resize(e - s);
         wordseqbuffer.resize(0);
         alignseqbuffer.resize(0);
@@ -1019,11 +1024,172 @@ class htkmlfreader : public map<wstring, vector<ENTRY>> // [key][i] the data
             }
             // if (sentstart < 0 || sentend < 0 || silence < 0)
             //    LogicError("parseentry: word map must contain !silence, !sent_start, and !sent_end");
-            // implant
-            auto& wordsequence = wordsequences[key]; // this creates the map entry
-            wordsequence.words = wordseqbuffer;      // makes a copy
+            wordsequence.words = wordseqbuffer; // makes a copy
             wordsequence.align = alignseqbuffer;
         }
+        return true;
+    }
+
+    // enter a parsed entry into the maps (not thread-safe)
+    void implantentry(const wstring& key, vector<ENTRY>& entries, bool haswordsequence, WORDSEQUENCE& wordsequence)
+    {
+        vector<ENTRY>& mapentries = (*this)[key]; // this creates a new entry
+        if (!mapentries.empty())
+            malformed(msra::strfun::strprintf("duplicate entry '%ls'", key.c_str()));
+        mapentries.swap(entries);
+        if (haswordsequence) // if reading word sequences as well (for MMI), then record it (in a separate map)
+        {
+            auto& mapwordsequence = wordsequences[key]; // this creates the map entry
+            mapwordsequence.words.swap(wordsequence.words);
+            mapwordsequence.align.swap(wordsequence.align);
+        }
+    }
+
+    // parse a batch of entries, concurrently across hardware threads, and
+    // implant the results in file order (map insertion is not thread-safe,
+    // and duplicate detection must stay deterministic).
+    // 'keysread' records the keys accepted from this batch.
+    template <typename WORDSYMBOLTABLE, typename UNITSYMBOLTABLE>
+    void parseentrybatch(std::vector<std::pair<size_t, std::vector<std::string>>>& batch, const set<wstring>& restricttokeys,
+                         const WORDSYMBOLTABLE* wordmap, const UNITSYMBOLTABLE* unitmap, const double htkTimeToFrame,
+                         std::vector<wstring>& keysread)
+    {
+        struct parsedentry
+        {
+            bool accepted;
+            wstring key;
+            vector<ENTRY> entries;
+            WORDSEQUENCE wordsequence;
+        };
+        std::vector<parsedentry> results(batch.size());
+
+        size_t numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0 || batch.size() < 2 * numThreads) // don't spin up threads for a trailing mini-batch
+            numThreads = 1;
+        std::vector<std::future<void>> futures;
+        size_t entriesPerThread = (batch.size() + numThreads - 1) / numThreads;
+        for (size_t t = 0; t < numThreads; t++)
+        {
+            size_t begin = t * entriesPerThread;
+            size_t end = std::min(begin + entriesPerThread, batch.size());
+            if (begin >= end)
+                break;
+            futures.push_back(std::async(std::launch::async, [&, begin, end]()
+            {
+                std::vector<typename WORDSEQUENCE::word> wordseqbuffer;
+                std::vector<typename WORDSEQUENCE::aligninfo> alignseqbuffer;
+                for (size_t i = begin; i < end; i++)
+                    results[i].accepted = parseentry(batch[i].second, batch[i].first, restricttokeys, wordmap, unitmap,
+                                                     wordseqbuffer, alignseqbuffer, htkTimeToFrame,
+                                                     results[i].key, results[i].entries, results[i].wordsequence);
+            }));
+        }
+        for (auto& f : futures)
+            f.get(); // (rethrows parse errors, if any)
+
+        foreach_index (i, results)
+        {
+            if (!results[i].accepted)
+                continue;
+            if (!restricttokeys.empty() && this->size() >= restricttokeys.size()) // we are done
+                break;
+            implantentry(results[i].key, results[i].entries, wordmap != NULL, results[i].wordsequence);
+            keysread.push_back(std::move(results[i].key));
+        }
+        batch.clear();
+    }
+
+    // --- binary label cache
+    // Parsing a big MLF takes many minutes while its parsed form loads in
+    // seconds, so plain label reads (no word sequences, no key filter) compile
+    // the per-utterance label runs into a sidecar file <path>.labcache and
+    // load from it on repeat jobs while it is still current.
+    // The ENTRY records are stored as raw bytes (they are flat structs).
+
+    static const int labelcacheversion = 1;
+
+    // compile the labels read from 'path' into its sidecar cache file
+    void writebinarycache(const wstring& path, const std::vector<wstring>& keysread, const double htkTimeToFrame) const
+    {
+        const wstring cachepath = path + L".labcache";
+        const wstring tmppath = cachepath + L".tmp"; // (renamed at the end, to tolerate concurrent process start-up)
+        int64_t sourcesize = filesize64(path.c_str());
+        {
+            auto_file_ptr f(fopenOrDie(tmppath, L"wbS"));
+            fputTag(f, "MLFC");
+            fputint(f, labelcacheversion);
+            fwriteOrDie(&sourcesize, sizeof(sourcesize), 1, f);
+            // parsing depends on these--a cache from a different setup is not ours
+            fwriteOrDie(&htkTimeToFrame, sizeof(htkTimeToFrame), 1, f);
+            fputint(f, (int) statelistmap.size());
+            fputint(f, (int) symmap.size());
+            fputint(f, (int) keysread.size());
+            foreach_index (i, keysread)
+            {
+                const vector<ENTRY>& entries = this->find(keysread[i])->second;
+                fputstring(f, keysread[i]);
+                fputint(f, (int) entries.size());
+                if (!entries.empty())
+                    fwriteOrDie(&entries[0], sizeof(entries[0]), entries.size(), f);
+            }
+            fflushOrDie(f);
+        } // (file must be closed before renaming)
+        renameOrDie(tmppath, cachepath);
+        fprintf(stderr, "htkmlfreader: labels compiled to %ls\n", cachepath.c_str());
+    }
+
+    // load the labels from the sidecar cache, if present and current.
+    // Returns false if there is no usable cache (caller falls back to parsing).
+    bool readbinarycache(const wstring& path, const double htkTimeToFrame)
+    {
+        const wstring cachepath = path + L".labcache";
+        if (!fexists(cachepath))
+            return false;
+        try
+        {
+            auto_file_ptr f(fopenOrDie(cachepath, L"rbS"));
+            fcheckTag(f, "MLFC");
+            if (fgetint(f) != labelcacheversion)
+                return false;
+            int64_t sourcesize = 0;
+            freadOrDie(&sourcesize, sizeof(sourcesize), 1, f);
+            if (sourcesize != filesize64(path.c_str()))
+                return false; // MLF was regenerated--cache is stale
+            double cachedtimetoframe = 0.0;
+            freadOrDie(&cachedtimetoframe, sizeof(cachedtimetoframe), 1, f);
+            if (cachedtimetoframe != htkTimeToFrame ||
+                fgetint(f) != (int) statelistmap.size() ||
+                fgetint(f) != (int) symmap.size())
+                return false; // cache was created under a different setup
+
+            // read into a separate map first, so a truncated cache cannot
+            // leave partial entries behind for the parsing fall-back
+            int numentries = fgetint(f);
+            map<wstring, vector<ENTRY>> loaded;
+            for (int i = 0; i < numentries; i++)
+            {
+                wstring key = fgetwstring(f);
+                vector<ENTRY>& entries = loaded[key]; // this creates a new entry
+                entries.resize((size_t) fgetint(f));
+                if (!entries.empty())
+                    freadOrDie(&entries[0], sizeof(entries[0]), entries.size(), f);
+            }
+            for (auto& iter : loaded)
+            {
+                vector<ENTRY>& entries = (*this)[iter.first]; // this creates a new entry
+                if (!entries.empty())
+                    RuntimeError("htkmlfreader: duplicate entry '%ls' in label cache '%ls'", iter.first.c_str(), cachepath.c_str());
+                entries.swap(iter.second);
+            }
+            fprintf(stderr, "htkmlfreader: loaded %d entries from label cache %ls\n", numentries, cachepath.c_str());
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            // e.g. truncated by a dying writer--fall back to parsing
+            fprintf(stderr, "readbinarycache: ignoring unusable cache %ls (%s)\n", cachepath.c_str(), e.what());
+            return false;
+        }
     }
 
 public:
@@ -1095,6 +1261,12 @@ public:
         if (!restricttokeys.empty() && this->size() >= restricttokeys.size()) // no need to even read the file if we are there (we support multiple files)
             return;
 
+        // plain label loads (no word sequences, no key filter) can be served
+        // from the binary sidecar cache
+        const bool cacheable = (wordmap == NULL && restricttokeys.empty());
+        if (cacheable && readbinarycache(path, htkTimeToFrame))
+            return;
+
         fprintf(stderr, "htkmlfreader: reading MLF file %ls ...", path.c_str());
         curpath = path; // for error messages only
 
@@ -1103,9 +1275,14 @@ public:
         if (headerLine != "#!MLF!#")
             malformed("header missing");
 
-        // Read the file in blocks and parse MLF entries
-        std::vector<typename WORDSEQUENCE::word> wordsequencebuffer;
-        std::vector<typename WORDSEQUENCE::aligninfo> alignsequencebuffer;
+        // Read the file in blocks and parse MLF entries.
+        // Complete entries are collected into a batch that is parsed across
+        // hardware threads once it is large enough, so parsing overlaps and
+        // keeps up with the file I/O.
+        std::vector<std::pair<size_t, std::vector<std::string>>> entrybatch; // [](first line number, lines) of a complete entry
+        size_t batchNumLines = 0;                                            // lines accumulated in entrybatch
+        const size_t flushBatchNumLines = 1000000;                           // parse once this many lines have piled up
+        std::vector<wstring> keysread;                                       // keys accepted from this file (feeds the cache writer)
         size_t readBlockSize = 1000000;
         std::vector<char> currBlockBuf(readBlockSize + 1);
         size_t currLineNum = 1;
@@ -1135,7 +1312,13 @@ public:
                 {
                     if (restricttokeys.empty() || (this->size() < restricttokeys.size()))
                     {
-                        parseentry(currMLFLines, currLineNum - currMLFLines.size(), restricttokeys, wordmap, unitmap, wordsequencebuffer, alignsequencebuffer, htkTimeToFrame);
+                        batchNumLines += currMLFLines.size();
+                        entrybatch.push_back(std::make_pair(currLineNum - currMLFLines.size(), std::move(currMLFLines)));
+                        if (batchNumLines >= flushBatchNumLines)
+                        {
+                            parseentrybatch(entrybatch, restricttokeys, wordmap, unitmap, htkTimeToFrame, keysread);
+                            batchNumLines = 0;
+                        }
                     }
 
                     currMLFLines.clear();
@@ -1174,8 +1357,24 @@ public:
         if (!currMLFLines.empty())
             malformed("unexpected end in mid-utterance");
 
+        parseentrybatch(entrybatch, restricttokeys, wordmap, unitmap, htkTimeToFrame, keysread); // (parse the remainder)
+
         curpath.clear();
         fprintf(stderr, " total %lu entries\n", (unsigned long)this->size());
+
+        // compile the labels into the sidecar cache so that repeat jobs on the
+        // unchanged MLF can skip the parse
+        if (cacheable)
+        {
+            try
+            {
+                writebinarycache(path, keysread, htkTimeToFrame);
+            }
+            catch (const std::exception& e) // (e.g. read-only location--not fatal)
+            {
+                fprintf(stderr, "writebinarycache: failed to write %ls.labcache (%s)\n", path.c_str(), e.what());
+            }
+        }
     }
 
     // read state list, index is from 0
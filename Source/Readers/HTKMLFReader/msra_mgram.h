@@ -346,6 +346,22 @@ public:
         r = value;
         assert(value == back());
     }
+
+    // bulk serialization --used by CMGramLM's binary cache
+    void write(FILE *f) const
+    {
+        const std::vector<unsigned char> &base = *this;
+        fputint(f, (int) size());
+        if (!base.empty())
+            fwriteOrDie(&base[0], sizeof(base[0]), base.size(), f);
+    }
+    void read(FILE *f)
+    {
+        std::vector<unsigned char> &base = *this;
+        base.resize(3 * (size_t) fgetint(f));
+        if (!base.empty())
+            freadOrDie(&base[0], sizeof(base[0]), base.size(), f);
+    }
 };
 
 // maps from m-grams to m-gram storage locations.
@@ -485,6 +501,44 @@ public:
         std::swap(idmax, other.idmax);
     }
 
+    // --- binary serialization (used by CMGramLM's binary cache)
+    // Only the structural part is stored. The w -> id mapping is specific to
+    // the user's symbol space and gets re-established through created().
+    void write(FILE *f) const
+    {
+        fputTag(f, "MMAP");
+        fputint(f, M);
+        fputint(f, idmax);
+        fputint(f, level1nonsparse ? 1 : 0);
+        fputint(f, (int) level1lookup.size());
+        if (!level1lookup.empty())
+            fwriteOrDie(&level1lookup[0], sizeof(level1lookup[0]), level1lookup.size(), f);
+        for (int m = 0; m <= M; m++)
+            ids[m].write(f);
+        for (int m = 0; m < M; m++)
+        {
+            fputint(f, (int) firsts[m].size());
+            fwriteOrDie(&firsts[m][0], sizeof(firsts[m][0]), firsts[m].size(), f);
+        }
+    }
+    void read(FILE *f)
+    {
+        fcheckTag(f, "MMAP");
+        init(fgetint(f));
+        idmax = fgetint(f);
+        level1nonsparse = fgetint(f) != 0;
+        level1lookup.resize((size_t) fgetint(f));
+        if (!level1lookup.empty())
+            freadOrDie(&level1lookup[0], sizeof(level1lookup[0]), level1lookup.size(), f);
+        for (int m = 0; m <= M; m++)
+            ids[m].read(f);
+        for (int m = 0; m < M; m++)
+        {
+            firsts[m].resize((size_t) fgetint(f));
+            freadOrDie(&firsts[m][0], sizeof(firsts[m][0]), firsts[m].size(), f);
+        }
+    }
+
     // --- id mapping
 
     // test whether a word id is known in this model
@@ -1117,6 +1171,29 @@ public:
     {
         data.swap(other.data);
     }
+    // bulk serialization --used by CMGramLM's binary cache
+    void write(FILE *f) const
+    {
+        fputTag(f, "MDAT");
+        fputint(f, (int) data.size());
+        foreach_index (m, data)
+        {
+            fputint(f, (int) data[m].size());
+            if (!data[m].empty())
+                fwriteOrDie(&data[m][0], sizeof(data[m][0]), data[m].size(), f);
+        }
+    }
+    void read(FILE *f)
+    {
+        fcheckTag(f, "MDAT");
+        data.resize((size_t) fgetint(f));
+        foreach_index (m, data)
+        {
+            data[m].resize((size_t) fgetint(f));
+            if (!data[m].empty())
+                freadOrDie(&data[m][0], sizeof(data[m][0]), data[m].size(), f);
+        }
+    }
     // access existing elements. Usage:
     // DATATYPE & element = mgram_data[mgram_map[mgram_map::key (mgram, m)]]
     __forceinline DATATYPE &operator[](const mgram_map::coord &c)
@@ -1435,6 +1512,122 @@ protected:
         logB[mgram_map::coord()] = 0.0f;
     }
 
+    // --- binary cache
+    // Parsing a large ARPA file takes minutes while its compiled form loads in
+    // seconds, so read() transparently compiles the model to <pathname>.binlm
+    // on first use and loads that flat image on subsequent runs (unless the
+    // ARPA file changed size, which invalidates the cache).
+    // The cache stores the model in LM-internal id space, i.e. before any
+    // user-symbol mapping, hence it is usable regardless of the caller's
+    // symbol table--but only without vocabulary filtering, since filtering
+    // drops entries already at parse time.
+
+    static const int binaryCacheVersion = 1;
+
+    // compile the in-memory model into its binary cache file
+    void writeBinaryCache(const std::wstring &pathname) const
+    {
+        const std::wstring cachePath = pathname + L".binlm";
+        const std::wstring tmpPath = cachePath + L".tmp"; // (renamed at the end, to tolerate concurrent process start-up)
+        int64_t sourceSize = filesize64(pathname.c_str());
+        {
+            auto_file_ptr f(fopenOrDie(tmpPath, L"wbS"));
+            fputTag(f, "MGLM");
+            fputint(f, binaryCacheVersion);
+            fwriteOrDie(&sourceSize, sizeof(sourceSize), 1, f);
+            fputint(f, M);
+            // LM-internal symbol table (sorted, SYMBOL::id gives the internal id)
+            fputint(f, (int) lmSymbols.size());
+            foreach_index (i, lmSymbols)
+            {
+                fputint(f, lmSymbols[i].id);
+                fputstring(f, lmSymbols[i].symbol);
+            }
+            map.write(f);
+            logP.write(f);
+            logB.write(f);
+            fflushOrDie(f);
+        } // (file must be closed before renaming)
+        renameOrDie(tmpPath, cachePath);
+        fprintf(stderr, "writeBinaryCache: LM compiled to %ls\n", cachePath.c_str());
+    }
+
+    // load the model from its binary cache, if present and current.
+    // Returns false if there is no usable cache (caller falls back to parsing).
+    template <class SYMMAP>
+    bool readBinaryCache(const std::wstring &pathname, SYMMAP &userSymMap, int maxM)
+    {
+        const std::wstring cachePath = pathname + L".binlm";
+        if (!fexists(cachePath))
+            return false;
+        try
+        {
+            auto_file_ptr f(fopenOrDie(cachePath, L"rbS"));
+            fcheckTag(f, "MGLM");
+            if (fgetint(f) != binaryCacheVersion)
+                return false;
+            int64_t sourceSize = 0;
+            freadOrDie(&sourceSize, sizeof(sourceSize), 1, f);
+            if (sourceSize != filesize64(pathname.c_str()))
+                return false; // ARPA file was regenerated--cache is stale
+
+            int fileM = fgetint(f);
+            if (fileM < 1)
+                return false;
+
+            // LM-internal symbol table
+            int numSymbols = fgetint(f);
+            lmSymbols.clear();
+            lmSymbols.reserve(numSymbols);
+            for (int i = 0; i < numSymbols; i++)
+            {
+                int id = fgetint(f);
+                std::string symbol = fgetstring(f);
+                lmSymbols.push_back(SYMBOL(id, symbol.c_str()));
+            }
+            idToSymIndex.assign(lmSymbols.size(), -1); // (lmSymbols are stored sorted)
+            for (int i = 0; i < (int) lmSymbols.size(); i++)
+                idToSymIndex[lmSymbols[i].id] = i;
+
+            map.read(f);
+            logP.read(f);
+            logB.read(f);
+
+            M = fileM;
+            if (M > maxM) // caller requested a lower order
+            {
+                M = maxM;
+                map.resize(M);
+                logP.resize(M);
+                logB.resize(M - 1);
+            }
+
+            // the cache is only used without vocabulary filtering: enter any
+            // new words into the user's symbol space (same as the ARPA path)
+            foreach_index (i, lmSymbols)
+                if (userSymMap.sym2existingId(lmSymbols[i].symbol) == -1)
+                    userSymMap.sym2id(lmSymbols[i].symbol);
+
+            // establish mapping of word ids from user to LM space
+            std::vector<int> userToLMSymMap(userSymMap.size());
+            for (int i = 0; i < (int) userSymMap.size(); i++)
+                userToLMSymMap[i] = symbolToId(userSymMap.id2sym(i)); // may be -1 if not found
+            map.created(userToLMSymMap);
+
+            filename = pathname; // (keep this info for debugging)
+            fprintf(stderr, "read: loaded binary LM cache %ls, order %d\n", cachePath.c_str(), M);
+            return true;
+        }
+        catch (const std::exception &e)
+        {
+            // e.g. truncated by a dying writer--fall back to parsing
+            fprintf(stderr, "readBinaryCache: ignoring unusable cache %ls (%s)\n", cachePath.c_str(), e.what());
+            lmSymbols.clear(); // (undo any partial load)
+            idToSymIndex.clear();
+            return false;
+        }
+    }
+
 public:
     // read an ARPA (text) file.
     // Words do not need to be sorted in the unigram section, but the m-gram
@@ -1447,6 +1640,10 @@ public:
     template <class SYMMAP>
     void read(const std::wstring &pathname, SYMMAP &userSymMap, bool filterVocabulary, int maxM)
     {
+        // try the compiled binary cache first --parsing large ARPA files is slow
+        if (!filterVocabulary && readBinaryCache(pathname, userSymMap, maxM))
+            return;
+
         int lineNo = 0;
         auto_file_ptr f(fopenOrDie(pathname, L"rbS"));
         fprintf(stderr, "read: reading %ls", pathname.c_str());
@@ -1639,6 +1836,20 @@ public:
             userToLMSymMap[i] = id;
         }
         map.created(userToLMSymMap);
+
+        // compile the model into a binary cache so that subsequent loads of
+        // the unchanged file can skip the ARPA parse
+        if (!filterVocabulary)
+        {
+            try
+            {
+                writeBinaryCache(pathname);
+            }
+            catch (const std::exception &e) // (e.g. read-only location--not fatal)
+            {
+                fprintf(stderr, "writeBinaryCache: failed to compile %ls.binlm (%s)\n", pathname.c_str(), e.what());
+            }
+        }
     }
 
 protected:
@@ -14,6 +14,7 @@
 #include "minibatchiterator.h"
 #include <unordered_set>
 #include <random>
+#include <future>
 
 namespace msra { namespace dbn {
 
@@ -173,7 +174,17 @@ class minibatchutterancesourcemulti : public minibatchsource
                 // read all utterances; if they are in the same archive, htkfeatreader will be efficient in not closing the file
                 frames.resize(featdim, totalframes);
                 if (!latticesource.empty())
+                {
                     lattices.resize(utteranceset.size());
+                    // hand the whole chunk's keys to the archive's decoder pool up front, so the
+                    // lattices decompress in the background while we read features below, and the
+                    // getlattices() calls become in-memory cache hits
+                    std::vector<std::wstring> latticekeys;
+                    latticekeys.reserve(utteranceset.size());
+                    foreach_index (i, utteranceset)
+                        latticekeys.push_back(utteranceset[i].key());
+                    latticesource.prefetchlattices(latticekeys);
+                }
                 foreach_index (i, utteranceset)
                 {
                     // fprintf (stderr, ".");
@@ -243,6 +254,11 @@ class minibatchutterancesourcemulti : public minibatchsource
     size_t numutterances; // total number of utterances
     size_t _totalframes;  // total frames (same as classids.size() if we have labels)
     double timegetbatch;  // [v-hansu] for time measurement
+    // background chunk paging (double buffering): while the caller consumes a
+    // minibatch, an I/O thread pages the chunks of the predicted next window
+    // in (and slid-out chunks out). getbatch() joins this task at entry, so
+    // all chunk state is still only ever touched by one thread at a time.
+    std::future<bool> prefetchtask; // outstanding background paging, if any; returns whether anything was read
     // sequence in random order of actual use (randomized, where randomization is cached)
     const size_t randomizationrange; // parameter remembered; this is the full window (e.g. 48 hours), not the half window
     size_t currentsweep;             // randomization is currently cached for this sweep; if it changes, rebuild all below
@@ -1525,6 +1541,69 @@ private:
         }
     }
 
+    // wait for pending background paging and absorb whether it read anything.
+    // getbatch() calls this before touching any chunk state, so the paging
+    // task never runs concurrently with it.
+    bool joinprefetch()
+    {
+        bool readfromdisk = false;
+        if (prefetchtask.valid())
+            readfromdisk = prefetchtask.get(); // (rethrows background I/O errors, if any)
+        return readfromdisk;
+    }
+
+    // kick off background paging for the minibatch expected to be requested
+    // next, i.e. the window around 'nextglobalts'. The prediction is only a
+    // hint: if the caller asks for a different position, getbatch() pages
+    // synchronously as before, at worst having read some chunks in vain.
+    void prefetchnextbatch(const size_t nextglobalts, const size_t framesrequested, const size_t subsetnum, const size_t numsubsets, const size_t sweep)
+    {
+        if (nextglobalts >= (sweep + 1) * _totalframes) // next call enters a new sweep and re-randomizes; nothing sensible to predict
+            return;
+        prefetchtask = std::async(std::launch::async, [=]() -> bool
+        {
+            bool readfromdisk = false;
+            if (!framemode) // regular utterance mode
+            {
+                auto positer = randomizedutteranceposmap.find(nextglobalts);
+                if (positer == randomizedutteranceposmap.end()) // not an utterance boundary--mis-predicted
+                    return false;
+                const size_t spos = positer->second;
+                // determine the utterance range of the next minibatch (same loop as in getbatch())
+                size_t mbframes = randomizedutterancerefs[spos].numframes;
+                size_t epos;
+                for (epos = spos + 1; epos < numutterances && ((mbframes + randomizedutterancerefs[epos].numframes) < framesrequested); epos++)
+                    mbframes += randomizedutterancerefs[epos].numframes;
+                const size_t windowbegin = positionchunkwindows[spos].windowbegin();
+                const size_t windowend = positionchunkwindows[epos - 1].windowend();
+                for (size_t k = 0; k < windowbegin; k++)
+                    releaserandomizedchunk(k);
+                for (size_t k = windowend; k < randomizedchunks[0].size(); k++)
+                    releaserandomizedchunk(k);
+                for (size_t pos = spos; pos < epos; pos++)
+                    if ((randomizedutterancerefs[pos].chunkindex % numsubsets) == subsetnum)
+                        readfromdisk |= requirerandomizedchunk(randomizedutterancerefs[pos].chunkindex, windowbegin, windowend);
+            }
+            else // frame mode: page the entire chunk window of the next frame range
+            {
+                const size_t sweepte = (sweep + 1) * _totalframes;
+                const size_t globalte = std::min(nextglobalts + framesrequested, sweepte);
+                const size_t firstchunk = chunkforframepos(nextglobalts);
+                const size_t lastchunk = chunkforframepos(globalte - 1);
+                const size_t windowbegin = randomizedchunks[0][firstchunk].windowbegin;
+                const size_t windowend = randomizedchunks[0][lastchunk].windowend;
+                for (size_t k = 0; k < windowbegin; k++)
+                    releaserandomizedchunk(k);
+                for (size_t k = windowbegin; k < windowend; k++)
+                    if ((k % numsubsets) == subsetnum)
+                        readfromdisk |= requirerandomizedchunk(k, windowbegin, windowend);
+                for (size_t k = windowend; k < randomizedchunks[0].size(); k++)
+                    releaserandomizedchunk(k);
+            }
+            return readfromdisk;
+        });
+    }
+
     class matrixasvectorofvectors // wrapper around a matrix that views it as a vector of column vectors
     {
         void operator=(const matrixasvectorofvectors &); // non-assignable
@@ -1559,6 +1638,17 @@ private:
     }
 
 public:
+    ~minibatchutterancesourcemulti()
+    {
+        try
+        {
+            joinprefetch(); // don't let a background page-in outlive the chunk state
+        }
+        catch (...) // (I/O errors of a batch nobody asked for are of no interest here)
+        {
+        }
+    }
+
     void setverbosity(int newverbosity)
     {
         verbosity = newverbosity;
@@ -1582,7 +1672,7 @@ public:
                   std::vector<std::shared_ptr<const latticesource::latticepair>> &latticepairs, std::vector<std::vector<size_t>> &sentendmark,
                   std::vector<std::vector<size_t>> &phoneboundaries2) override
     {
-        bool readfromdisk = false; // return value: shall be 'true' if we paged in anything
+        bool readfromdisk = joinprefetch(); // 'true' if we paged in anything (background paging counts too)
 
         auto_timer timergetbatch;
         assert(_totalframes > 0);
@@ -1873,6 +1963,9 @@ public:
                 currmpinodeframecount++;
             }
         }
+        // page the next window in the background while the caller consumes this batch
+        prefetchnextbatch(globalts + mbframes, framesrequested, subsetnum, numsubsets, sweep);
+
         timegetbatch = timergetbatch;
 
         // this is the number of frames we actually moved ahead in time
@@ -0,0 +1,95 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#pragma once
+#include <opencv2/core/mat.hpp>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "Basics.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// A budgeted cache of decoded images, keyed by sequence id. Small-image datasets whose decoded
+// tensors fit in RAM are otherwise re-decoded from JPEG every epoch; caching the post-decode,
+// pre-augmentation image keeps random crops/flips varying per epoch while removing the decode
+// cost from epochs 2+. Least-recently-used images are evicted once the byte budget is reached.
+// Cached images are cloned on both insertion and retrieval, since the transformers downstream
+// modify their input in place.
+// Thread-safe: GetChunk()/GetSequence() run concurrently on the reader's decode threads.
+class DecodedImageCache
+{
+public:
+    DecodedImageCache(size_t budgetInBytes) : m_budget(budgetInBytes), m_size(0), m_hits(0), m_misses(0)
+    {
+    }
+
+    // Returns a private copy of the cached image for the sequence, or an empty cv::Mat on a miss.
+    cv::Mat Find(size_t seqId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(seqId);
+        if (it == m_index.end())
+        {
+            m_misses++;
+            return cv::Mat();
+        }
+        // move to the front of the LRU list
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        m_hits++;
+        return it->second->m_image.clone();
+    }
+
+    // Inserts a copy of the decoded image, evicting least-recently-used entries to stay within
+    // the byte budget. Images larger than the whole budget are not cached.
+    void Add(size_t seqId, const cv::Mat& image)
+    {
+        if (!image.data)
+            return;
+
+        size_t imageSize = image.total() * image.elemSize();
+        if (imageSize > m_budget)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_index.find(seqId) != m_index.end())
+            return;
+
+        while (m_size + imageSize > m_budget)
+        {
+            auto& last = m_entries.back();
+            m_size -= last.m_image.total() * last.m_image.elemSize();
+            m_index.erase(last.m_seqId);
+            m_entries.pop_back();
+        }
+
+        m_entries.push_front(Entry{ seqId, image.clone() });
+        m_index[seqId] = m_entries.begin();
+        m_size += imageSize;
+    }
+
+    size_t Hits() const { return m_hits; }
+    size_t Misses() const { return m_misses; }
+
+    DISABLE_COPY_AND_MOVE(DecodedImageCache);
+
+private:
+    struct Entry
+    {
+        size_t m_seqId;
+        cv::Mat m_image;
+    };
+
+    std::mutex m_mutex;
+    // most-recently-used entries at the front
+    std::list<Entry> m_entries;
+    std::unordered_map<size_t, std::list<Entry>::iterator> m_index;
+    size_t m_budget;
+    size_t m_size;
+    size_t m_hits;
+    size_t m_misses;
+};
+
+}}}
@@ -61,6 +61,10 @@ private:
 // that allows composition of deserializers and transforms on inputs.
 ImageDataDeserializer::ImageDataDeserializer(CorpusDescriptorPtr corpus, const ConfigParameters& config, bool primary) : ImageDeserializerBase(corpus, config, primary)
 {
+    size_t cacheSize = config(L"decodedImageCacheSizeInBytes", (size_t)0); // 0 - no caching of decoded images
+    if (cacheSize > 0)
+        m_cache = make_unique<DecodedImageCache>(cacheSize);
+
     CreateSequenceDescriptions(corpus, config(L"file"), m_labelGenerator->LabelDimension(), m_multiViewCrop);
 }
 
@@ -105,9 +109,22 @@ ImageDataDeserializer::ImageDataDeserializer(const ConfigParameters& config)
         RuntimeError("Unsupported label element type '%d'.", (int)label->m_elementType);
     }
 
+    size_t cacheSize = config(L"decodedImageCacheSizeInBytes", (size_t)0); // 0 - no caching of decoded images
+    if (cacheSize > 0)
+        m_cache = make_unique<DecodedImageCache>(cacheSize);
+
     CreateSequenceDescriptions(std::make_shared<CorpusDescriptor>(false), configHelper.GetMapPath(), labelDimension, configHelper.IsMultiViewCrop());
 }
 
+ImageDataDeserializer::~ImageDataDeserializer()
+{
+    if (m_cache != nullptr && m_verbosity > 1)
+    {
+        fprintf(stderr, "ImageDeserializer: Decoded-image cache served %" PRIu64 " of %" PRIu64 " reads.\n",
+                m_cache->Hits(), m_cache->Hits() + m_cache->Misses());
+    }
+}
+
 // Descriptions of chunks exposed by the image reader.
 ChunkDescriptions ImageDataDeserializer::GetChunkDescriptions()
 {
@@ -286,10 +303,24 @@ cv::Mat ImageDataDeserializer::ReadImage(size_t seqId, const std::string& path,
 {
     assert(!path.empty());
 
+    if (m_cache != nullptr)
+    {
+        auto cached = m_cache->Find(seqId);
+        if (cached.data)
+            return cached;
+    }
+
+    cv::Mat image;
     ImageDataDeserializer::SeqReaderMap::const_iterator r;
     if (m_readers.empty() || (r = m_readers.find(seqId)) == m_readers.end())
-        return m_defaultReader->Read(seqId, path, grayscale);
-    return (*r).second->Read(seqId, path, grayscale);
+        image = m_defaultReader->Read(seqId, path, grayscale);
+    else
+        image = (*r).second->Read(seqId, path, grayscale);
+
+    if (m_cache != nullptr)
+        m_cache->Add(seqId, image);
+
+    return image;
 }
 
 cv::Mat FileByteReader::Read(size_t, const std::string& seqPath, bool grayscale)
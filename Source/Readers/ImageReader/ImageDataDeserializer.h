@@ -8,6 +8,7 @@
 #include "ImageDeserializerBase.h"
 #include "Config.h"
 #include "ByteReader.h"
+#include "DecodedImageCache.h"
 #include <unordered_map>
 #include "CorpusDescriptor.h"
 
@@ -28,6 +29,8 @@ public:
     // TODO: This constructor should be deprecated in the future. Compositional config should be used instead.
     explicit ImageDataDeserializer(const ConfigParameters& config);
 
+    ~ImageDataDeserializer();
+
     // Gets sequences by specified ids. Order of returned sequences corresponds to the order of provided ids.
     virtual ChunkPtr GetChunk(ChunkIdType chunkId) override;
 
@@ -68,6 +71,10 @@ private:
     SeqReaderMap m_readers;
 
     std::unique_ptr<FileByteReader> m_defaultReader;
+
+    // Optional cache of decoded images ('decodedImageCacheSizeInBytes' > 0), so that small-image
+    // datasets are not re-decoded every epoch. Multi-view copies of a sequence share one cached decode.
+    std::unique_ptr<DecodedImageCache> m_cache;
 };
 
 }}}
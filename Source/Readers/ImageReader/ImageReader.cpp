@@ -66,12 +66,17 @@ ImageReader::ImageReader(const ConfigParameters& config)
     transformations.push_back(Transformation{ std::make_shared<ScaleTransformer>(featureStream), featureName });
     transformations.push_back(Transformation{ std::make_shared<ColorTransformer>(featureStream), featureName });
     transformations.push_back(Transformation{ std::make_shared<IntensityTransformer>(featureStream), featureName });
-    transformations.push_back(Transformation{ std::make_shared<MeanTransformer>(featureStream), featureName });
 
     if (configHelper.GetDataFormat() == CHW)
     {
+        // The transpose transformer subtracts the mean (if configured) during its
+        // own pass over the image, so a separate mean transformation is not needed.
         transformations.push_back(Transformation{ std::make_shared<TransposeTransformer>(featureStream), featureName });
     }
+    else
+    {
+        transformations.push_back(Transformation{ std::make_shared<MeanTransformer>(featureStream), featureName });
+    }
 
     // We should always have cast at the end. 
     // It is noop if the matrix element type is already expected by the packer.
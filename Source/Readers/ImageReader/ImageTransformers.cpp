@@ -410,30 +410,36 @@ void ScaleTransformer::Apply(uint8_t, cv::Mat &mat)
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-MeanTransformer::MeanTransformer(const ConfigParameters& config) : ImageTransformerBase(config)
+// Loads the mean image from the 'meanFile' specified in the config.
+// Returns an empty matrix if no mean file is configured.
+static cv::Mat LoadMeanImage(const ConfigParameters& config)
 {
+    cv::Mat meanImg;
     std::wstring meanFile = config(L"meanFile", L"");
     if (meanFile.empty())
-        m_meanImg.release();
-    else
-    {
-        cv::FileStorage fs;
-        fs.open(msra::strfun::utf8(meanFile).c_str(), cv::FileStorage::READ);
-        if (!fs.isOpened())
-            RuntimeError("Could not open file: %ls", meanFile.c_str());
-        fs["MeanImg"] >> m_meanImg;
-        int cchan;
-        fs["Channel"] >> cchan;
-        int crow;
-        fs["Row"] >> crow;
-        int ccol;
-        fs["Col"] >> ccol;
-        if (cchan * crow * ccol !=
-            m_meanImg.channels() * m_meanImg.rows * m_meanImg.cols)
-            RuntimeError("Invalid data in file: %ls", meanFile.c_str());
-        fs.release();
-        m_meanImg = m_meanImg.reshape(cchan, crow);
-    }
+        return meanImg;
+
+    cv::FileStorage fs;
+    fs.open(msra::strfun::utf8(meanFile).c_str(), cv::FileStorage::READ);
+    if (!fs.isOpened())
+        RuntimeError("Could not open file: %ls", meanFile.c_str());
+    fs["MeanImg"] >> meanImg;
+    int cchan;
+    fs["Channel"] >> cchan;
+    int crow;
+    fs["Row"] >> crow;
+    int ccol;
+    fs["Col"] >> ccol;
+    if (cchan * crow * ccol !=
+        meanImg.channels() * meanImg.rows * meanImg.cols)
+        RuntimeError("Invalid data in file: %ls", meanFile.c_str());
+    fs.release();
+    return meanImg.reshape(cchan, crow);
+}
+
+MeanTransformer::MeanTransformer(const ConfigParameters& config) : ImageTransformerBase(config)
+{
+    m_meanImg = LoadMeanImage(config);
 }
 
 void MeanTransformer::Apply(uint8_t, cv::Mat &mat)
@@ -460,7 +466,14 @@ void MeanTransformer::Apply(uint8_t, cv::Mat &mat)
 
 TransposeTransformer::TransposeTransformer(const ConfigParameters& config) : TransformBase(config),
     m_floatTransform(this), m_doubleTransform(this)
-{}
+{
+    m_meanImg = LoadMeanImage(config);
+    if (!m_meanImg.empty())
+    {
+        m_floatTransform.SetMean(m_meanImg);
+        m_doubleTransform.SetMean(m_meanImg);
+    }
+}
 
 // The method describes how input stream is transformed to the output stream. Called once per applied stream.
 // Transpose transformer expects the dense input stream with samples as HWC and outputs CHW.
@@ -513,6 +526,23 @@ SequenceDataPtr TransposeTransformer::Transform(SequenceDataPtr sequence)
     return nullptr; // Make compiler happy
 }
 
+template <class TElementTo>
+void TransposeTransformer::TypedTranspose<TElementTo>::SetMean(const cv::Mat& mean)
+{
+    // Keep the mean in the output element type so the subtraction in Apply
+    // happens in the same precision as in the standalone mean transformation.
+    cv::Mat converted;
+    mean.convertTo(converted, CV_64FC(mean.channels()));
+    size_t rowLength = converted.cols * converted.channels();
+    m_mean.resize(converted.rows * rowLength);
+    for (int i = 0; i < converted.rows; i++)
+    {
+        const double* src = converted.ptr<double>(i);
+        for (size_t j = 0; j < rowLength; j++)
+            m_mean[i * rowLength + j] = static_cast<TElementTo>(src[j]);
+    }
+}
+
 template <class TElementTo>
 template<class TElementFrom>
 SequenceDataPtr TransposeTransformer::TypedTranspose<TElementTo>::Apply(ImageSequenceData* inputSequence)
@@ -536,6 +566,18 @@ SequenceDataPtr TransposeTransformer::TypedTranspose<TElementTo>::Apply(ImageSeq
 
     auto dst = result->GetBuffer();
 
+    // When a mean is configured (and matches the input size), subtract it
+    // in the same pass as the transpose instead of running a separate pass.
+    const TElementTo* mean = nullptr;
+    if (!m_mean.empty())
+    {
+        if (m_mean.size() == count)
+            mean = m_mean.data();
+        else
+            fprintf(stderr, "WARNING: Mean file does not match the size of the input image, will be ignored.\n"
+                "Please remove mean transformation from the config.\n");
+    }
+
     if (channelCount == 3) // Unrolling for BGR, the most common case.
     {
         size_t nRows = inputSequence->m_image.rows;
@@ -548,12 +590,26 @@ SequenceDataPtr TransposeTransformer::TypedTranspose<TElementTo>::Apply(ImageSeq
         for (size_t i = 0; i < nRows; ++i)
         {
             auto* x = inputSequence->m_image.ptr<TElementFrom>((int)i);
-            for (size_t j = 0; j < nCols; ++j)
+            if (mean != nullptr)
+            {
+                const TElementTo* m = mean + i * nCols * 3;
+                for (size_t j = 0; j < nCols; ++j)
+                {
+                    auto row = j * 3;
+                    *b++ = static_cast<TElementTo>(x[row]) - m[row];
+                    *g++ = static_cast<TElementTo>(x[row + 1]) - m[row + 1];
+                    *r++ = static_cast<TElementTo>(x[row + 2]) - m[row + 2];
+                }
+            }
+            else
             {
-                auto row = j * 3;
-                *b++ = static_cast<TElementTo>(x[row]);
-                *g++ = static_cast<TElementTo>(x[row + 1]);
-                *r++ = static_cast<TElementTo>(x[row + 2]);
+                for (size_t j = 0; j < nCols; ++j)
+                {
+                    auto row = j * 3;
+                    *b++ = static_cast<TElementTo>(x[row]);
+                    *g++ = static_cast<TElementTo>(x[row + 1]);
+                    *r++ = static_cast<TElementTo>(x[row + 2]);
+                }
             }
         }
     }
@@ -564,7 +620,10 @@ SequenceDataPtr TransposeTransformer::TypedTranspose<TElementTo>::Apply(ImageSeq
         {
             for (size_t icol = 0; icol < channelCount; icol++)
             {
-                dst[icol * rowCount + irow] = static_cast<TElementTo>(src[irow * channelCount + icol]);
+                auto element = irow * channelCount + icol;
+                dst[icol * rowCount + irow] = mean != nullptr ?
+                    static_cast<TElementTo>(src[element]) - mean[element] :
+                    static_cast<TElementTo>(src[element]);
             }
         }
     }
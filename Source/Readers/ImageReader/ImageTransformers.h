@@ -166,6 +166,10 @@ private:
 };
 
 // Transpose transformation from HWC to CHW (note: row-major notation).
+// If a mean file is specified in the transform config ('meanFile'), the mean is
+// subtracted during the transpose pass itself, avoiding both a separate
+// per-image pass and the floating-point intermediate image the standalone
+// mean transformation has to create.
 class TransposeTransformer : public TransformBase
 {
 public:
@@ -188,9 +192,21 @@ private:
 
         template <class TElementFrom>
         SequenceDataPtr Apply(ImageSequenceData* inputSequence);
+
+        // Converts the mean image into the output element type (HWC order,
+        // matching the input images).
+        void SetMean(const cv::Mat& mean);
+
         conc_stack<std::vector<TElementTo>> m_memBuffers;
+
+        // Mean in HWC order converted to the output element type,
+        // empty if no mean file is configured.
+        std::vector<TElementTo> m_mean;
     };
 
+    // Mean image as loaded from the mean file, empty if not configured.
+    cv::Mat m_meanImg;
+
     // Auxiliary buffer to handle images of float type.
     TypedTranspose<float> m_floatTransform;
 
@@ -0,0 +1,57 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+// Exports.cpp : Defines the exported functions for the DLL application.
+//
+
+#include "stdafx.h"
+#define DATAREADER_EXPORTS
+#include "DataReader.h"
+#include "ReaderShim.h"
+#include "LMTextReader.h"
+#include "LMTextDeserializer.h"
+#include "HeapMemoryProvider.h"
+#include "StringUtil.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+auto factory = [](const ConfigParameters& parameters) -> ReaderPtr
+{
+    return std::make_shared<LMTextReader>(parameters);
+};
+
+extern "C" DATAREADER_API void GetReaderF(IDataReader** preader)
+{
+    *preader = new ReaderShim<float>(factory);
+}
+
+extern "C" DATAREADER_API void GetReaderD(IDataReader** preader)
+{
+    *preader = new ReaderShim<double>(factory);
+}
+
+// A factory method for creating LM text deserializers.
+extern "C" DATAREADER_API bool CreateDeserializer(IDataDeserializer** deserializer, const std::wstring& type, const ConfigParameters& deserializerConfig, CorpusDescriptorPtr corpus, bool primary)
+{
+    string precision = deserializerConfig.Find("precision", "float");
+    if (!AreEqualIgnoreCase(precision, "float") && !AreEqualIgnoreCase(precision, "double"))
+    {
+        InvalidArgument("Unsupported precision '%s'", precision.c_str());
+    }
+
+    if (type == L"LMTextDeserializer")
+    {
+        if (precision == "float")
+            *deserializer = new LMTextDeserializer<float>(corpus, deserializerConfig, primary);
+        else // double
+            *deserializer = new LMTextDeserializer<double>(corpus, deserializerConfig, primary);
+    }
+    else
+        InvalidArgument("Unknown deserializer type '%ls'", type.c_str());
+
+    // Deserializer created.
+    return true;
+}
+
+}}}
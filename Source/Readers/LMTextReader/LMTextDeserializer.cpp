@@ -0,0 +1,446 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#include "stdafx.h"
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <future>
+#include <thread>
+#include "Basics.h"
+#include "LMTextDeserializer.h"
+#include "ReaderConstants.h"
+#include "fileutil.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+using namespace std;
+
+inline bool IsTokenDelimiter(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+template <class ElemType>
+class LMTextDeserializer<ElemType>::LMTextDataChunk : public Chunk
+{
+public:
+    explicit LMTextDataChunk(const ChunkDescriptor& descriptor)
+    {
+        m_id = descriptor.m_id;
+    }
+
+    // Gets sequences by id.
+    void GetSequence(size_t sequenceId, std::vector<SequenceDataPtr>& result) override
+    {
+        assert(sequenceId < m_sequenceMap.size());
+        const auto& sequenceData = m_sequenceMap[sequenceId];
+        result.insert(result.end(), sequenceData.begin(), sequenceData.end());
+    }
+
+    // A map from sequence ids to the sequence data.
+    std::vector<SequenceBuffer> m_sequenceMap;
+
+    // chunk id (copied from the descriptor)
+    ChunkIdType m_id;
+};
+
+template <class ElemType>
+LMTextDeserializer<ElemType>::LMTextDeserializer(CorpusDescriptorPtr corpus, const ConfigParameters& config, bool primary) :
+    DataDeserializerBase(primary),
+    m_filename(config(L"file")),
+    m_file(nullptr),
+    m_vocabularySize(0),
+    m_unkId(-1),
+    m_sentenceBeginId(-1),
+    m_sentenceEndId(-1),
+    m_chunkSizeBytes(config(L"chunkSizeInBytes", g_32MB)),
+    m_parseThreadCount(config(L"numParseThreads", (size_t)1)), // 0 - one thread per hardware thread
+    m_traceLevel(config(L"traceLevel", 1)),
+    m_numAllowedErrors(config(L"maxErrors", 0)),
+    m_numRetries(5),
+    m_corpus(corpus)
+{
+    LoadVocabulary(config(L"vocabFile"));
+
+    string unkSymbol = config(L"unkSymbol", "<unk>");
+    auto unk = m_vocabulary.find(unkSymbol);
+    if (unk != m_vocabulary.end())
+        m_unkId = unk->second;
+
+    // sentence markers are optional; when present in the vocabulary, the begin marker is
+    // prepended to the input stream and the end marker appended to the label stream
+    auto sentenceBegin = m_vocabulary.find(config(L"beginSequenceSymbol", "<s>"));
+    if (sentenceBegin != m_vocabulary.end())
+        m_sentenceBeginId = sentenceBegin->second;
+    auto sentenceEnd = m_vocabulary.find(config(L"endSequenceSymbol", "</s>"));
+    if (sentenceEnd != m_vocabulary.end())
+        m_sentenceEndId = sentenceEnd->second;
+
+    // both streams are one-hot over the vocabulary; 'input' carries the token at each
+    // position, 'label' the next token, so the pair feeds a language model directly
+    wstring inputStreamName = config(L"inputStreamName", L"input");
+    wstring labelStreamName = config(L"labelStreamName", L"label");
+    for (const auto& name : { inputStreamName, labelStreamName })
+    {
+        auto stream = make_shared<StreamDescription>();
+        stream->m_name = name;
+        stream->m_id = m_streams.size();
+        stream->m_storageType = StorageType::sparse_csc;
+        stream->m_elementType = sizeof(ElemType) == sizeof(float) ? ElementType::tfloat : ElementType::tdouble;
+        stream->m_sampleLayout = make_shared<TensorShape>(m_vocabularySize);
+        m_streams.push_back(stream);
+    }
+
+    attempt(m_numRetries, [this]()
+    {
+        if (m_file == nullptr)
+            m_file = fopenOrDie(m_filename, L"rbS");
+        else if (ferror(m_file) != 0)
+        {
+            fclose(m_file);
+            m_file = fopenOrDie(m_filename, L"rbS");
+        }
+
+        BuildIndex();
+    });
+}
+
+template <class ElemType>
+LMTextDeserializer<ElemType>::~LMTextDeserializer()
+{
+    if (m_file)
+    {
+        fclose(m_file);
+    }
+}
+
+template <class ElemType>
+void LMTextDeserializer<ElemType>::LoadVocabulary(const std::wstring& vocabFilePath)
+{
+    FILE* vocabFile = fopenOrDie(vocabFilePath, L"rbS");
+    while (!feof(vocabFile))
+    {
+        string line = fgetline(vocabFile); // strips the newline
+        // trim other trailing whitespace
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+            line.pop_back();
+        if (line.empty())
+            continue;
+
+        auto inserted = m_vocabulary.insert(make_pair(line, (IndexType)m_vocabularySize));
+        if (!inserted.second)
+            RuntimeError("Duplicate token '%s' on line %" PRIu64 " of the vocabulary file (%ls).",
+                line.c_str(), (uint64_t)m_vocabularySize, vocabFilePath.c_str());
+        m_vocabularySize++;
+    }
+    fclose(vocabFile);
+
+    if (m_vocabularySize == 0)
+        RuntimeError("The vocabulary file (%ls) is empty.", vocabFilePath.c_str());
+}
+
+template <class ElemType>
+size_t LMTextDeserializer<ElemType>::NumberOfSamplesInLine(const char* begin, const char* end) const
+{
+    size_t numTokens = 0;
+    bool inToken = false;
+    for (const char* p = begin; p != end; ++p)
+    {
+        bool delimiter = IsTokenDelimiter(*p);
+        if (!delimiter && !inToken)
+            numTokens++;
+        inToken = !delimiter;
+    }
+
+    if (numTokens == 0)
+        return 0;
+
+    // the input stream is the augmented token sequence without its last element, the label
+    // stream the same sequence without its first; sentence markers extend the sequence
+    size_t augmentedLength = numTokens + (m_sentenceBeginId >= 0 ? 1 : 0) + (m_sentenceEndId >= 0 ? 1 : 0);
+    return augmentedLength - 1;
+}
+
+template <class ElemType>
+void LMTextDeserializer<ElemType>::BuildIndex()
+{
+    size_t fileSize = filesize(m_file);
+    m_index.reset(new Index(m_chunkSizeBytes, m_primary));
+    m_index->Reserve(fileSize);
+
+    const size_t bufferSize = 2 * 1024 * 1024;
+    unique_ptr<char[]> buffer(new char[bufferSize]);
+    string line; // current line, possibly spanning refills of the buffer
+    size_t lineStartOffset = 0;
+    size_t offset = 0;
+    size_t lineNumber = 0;
+
+    auto addLine = [this, &line, &lineStartOffset, &lineNumber](size_t endOffset)
+    {
+        size_t numSamples = NumberOfSamplesInLine(line.data(), line.data() + line.size());
+        // skip lines too short to produce at least one (input, label) sample pair;
+        // LoadChunk() never touches the skipped byte ranges
+        if (numSamples != 0)
+        {
+            if (numSamples > SEQUENCELEN_MAX)
+                RuntimeError("Sequence length overflow on line %" PRIu64 " of the input file (%ls).",
+                    (uint64_t)lineNumber, m_filename.c_str());
+            m_index->AddSequence(SequenceDescriptor(KeyType(lineNumber, 0), (uint32_t)numSamples),
+                lineStartOffset, endOffset);
+        }
+        line.clear();
+        lineNumber++;
+        lineStartOffset = endOffset;
+    };
+
+    for (;;)
+    {
+        size_t bytesRead = fread(buffer.get(), 1, bufferSize, m_file);
+        if (bytesRead == 0)
+            break;
+
+        const char* begin = buffer.get();
+        const char* end = begin + bytesRead;
+        for (const char* p = begin; p != end; ++p)
+        {
+            if (*p == '\n')
+            {
+                line.append(begin, p + 1);
+                begin = p + 1;
+                addLine(offset + (p + 1 - buffer.get()));
+            }
+        }
+        line.append(begin, end);
+        offset += bytesRead;
+    }
+
+    if (ferror(m_file) != 0)
+        RuntimeError("Could not read from the input file (%ls).", m_filename.c_str());
+
+    // a last line without a trailing newline still counts
+    if (!line.empty())
+        addLine(offset);
+
+    if (m_index->m_chunks.size() == 1 && m_index->m_chunks[0].m_numberOfSequences == 0)
+        RuntimeError("Could not find any sequences in the input file (%ls).", m_filename.c_str());
+}
+
+template <class ElemType>
+ChunkDescriptions LMTextDeserializer<ElemType>::GetChunkDescriptions()
+{
+    assert(m_index != nullptr);
+
+    ChunkDescriptions result;
+    result.reserve(m_index->m_chunks.size());
+    for (auto const& chunk : m_index->m_chunks)
+    {
+        result.push_back(shared_ptr<ChunkDescription>(
+            new ChunkDescription {
+                chunk.m_id,
+                chunk.m_numberOfSamples,
+                chunk.m_numberOfSequences
+        }));
+    }
+
+    return result;
+}
+
+template <class ElemType>
+void LMTextDeserializer<ElemType>::GetSequencesForChunk(ChunkIdType chunkId, std::vector<SequenceDescription>& result)
+{
+    const auto& chunk = m_index->m_chunks[chunkId];
+    result.reserve(chunk.m_sequences.size());
+
+    for (size_t sequenceIndex = 0; sequenceIndex < chunk.m_sequences.size(); ++sequenceIndex)
+    {
+        auto const& s = chunk.m_sequences[sequenceIndex];
+        result.push_back(
+        {
+            sequenceIndex,
+            s.m_numberOfSamples,
+            chunkId,
+            s.m_key
+        });
+    }
+}
+
+template <class ElemType>
+bool LMTextDeserializer<ElemType>::GetSequenceDescriptionByKey(const KeyType& key, SequenceDescription& result)
+{
+    if (m_primary)
+        LogicError("Matching by sequence key is not supported for primary deserilalizer.");
+
+    const auto& keys = m_index->m_keyToSequenceInChunk;
+    auto sequenceLocation = keys.find(key.m_sequence);
+    if (sequenceLocation == keys.end())
+        return false;
+
+    assert(sequenceLocation->second.first < m_index->m_chunks.size());
+    const auto& chunk = m_index->m_chunks[sequenceLocation->second.first];
+
+    assert(sequenceLocation->second.second < chunk.m_sequences.size());
+    const auto& sequence = chunk.m_sequences[sequenceLocation->second.second];
+
+    result.m_chunkId = sequenceLocation->second.first;
+    result.m_indexInChunk = sequenceLocation->second.second;
+    result.m_numberOfSamples = sequence.m_numberOfSamples;
+    result.m_key = sequence.m_key;
+    return true;
+}
+
+template <class ElemType>
+ChunkPtr LMTextDeserializer<ElemType>::GetChunk(ChunkIdType chunkId)
+{
+    const auto& chunkDescriptor = m_index->m_chunks[chunkId];
+    auto chunk = make_shared<LMTextDataChunk>(chunkDescriptor);
+
+    attempt(m_numRetries, [this, &chunk, &chunkDescriptor]()
+    {
+        if (ferror(m_file) != 0)
+        {
+            fclose(m_file);
+            m_file = fopenOrDie(m_filename, L"rbS");
+        }
+        LoadChunk(chunk, chunkDescriptor);
+    });
+
+    return chunk;
+}
+
+template <class ElemType>
+void LMTextDeserializer<ElemType>::LoadChunk(LMTextChunkPtr& chunk, const ChunkDescriptor& descriptor)
+{
+    // The byte span of a chunk may exceed the sum of its sequence sizes, since skipped
+    // lines leave gaps; read up to the end of the last sequence with one sequential read.
+    const auto& lastSequence = descriptor.m_sequences.back();
+    size_t spanInBytes = lastSequence.OffsetInChunk() + lastSequence.SizeInBytes();
+    unique_ptr<char[]> buffer(new char[spanInBytes]);
+    if (_fseeki64(m_file, descriptor.m_offset, SEEK_SET))
+        RuntimeError("Error seeking to position %" PRId64 " in the input file (%ls).",
+            (int64_t)descriptor.m_offset, m_filename.c_str());
+
+    if (fread(buffer.get(), 1, spanInBytes, m_file) != spanInBytes)
+        RuntimeError("Could not read from the input file (%ls).", m_filename.c_str());
+
+    size_t numSequences = descriptor.m_sequences.size();
+    chunk->m_sequenceMap.resize(numSequences);
+
+    size_t numThreads = m_parseThreadCount != 0 ? m_parseThreadCount : std::thread::hardware_concurrency();
+    numThreads = std::min(std::max<size_t>(numThreads, 1), numSequences);
+    if (numThreads <= 1)
+    {
+        for (size_t sequenceIndex = 0; sequenceIndex < numSequences; ++sequenceIndex)
+            chunk->m_sequenceMap[sequenceIndex] = LoadSequence(buffer.get(), descriptor.m_sequences[sequenceIndex]);
+        return;
+    }
+
+    // Tokenize disjoint sequence ranges of the chunk concurrently; the sequences only
+    // read from the shared chunk buffer and the (immutable) vocabulary.
+    std::vector<std::future<void>> workers;
+    size_t sequencesPerThread = (numSequences + numThreads - 1) / numThreads;
+    for (size_t begin = 0; begin < numSequences; begin += sequencesPerThread)
+    {
+        size_t end = std::min(begin + sequencesPerThread, numSequences);
+        workers.push_back(std::async(std::launch::async,
+            [this, &chunk, &descriptor, &buffer, begin, end]()
+            {
+                for (size_t sequenceIndex = begin; sequenceIndex < end; ++sequenceIndex)
+                    chunk->m_sequenceMap[sequenceIndex] = LoadSequence(buffer.get(), descriptor.m_sequences[sequenceIndex]);
+            }));
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+}
+
+template <class ElemType>
+IndexType LMTextDeserializer<ElemType>::TranslateToken(const char* begin, const char* end)
+{
+    auto found = m_vocabulary.find(string(begin, end));
+    if (found != m_vocabulary.end())
+        return found->second;
+    return m_unkId;
+}
+
+template <class ElemType>
+typename LMTextDeserializer<ElemType>::SequenceBuffer LMTextDeserializer<ElemType>::LoadSequence(const char* bufferStart, const SequenceDescriptor& descriptor)
+{
+    const char* pos = bufferStart + descriptor.OffsetInChunk();
+    const char* end = pos + descriptor.SizeInBytes();
+
+    // translate the tokens of the line into the augmented id sequence (with sentence markers)
+    std::vector<IndexType> augmented;
+    augmented.reserve(descriptor.m_numberOfSamples + 1);
+    bool isValid = true;
+    if (m_sentenceBeginId >= 0)
+        augmented.push_back(m_sentenceBeginId);
+    while (pos != end)
+    {
+        while (pos != end && IsTokenDelimiter(*pos))
+            ++pos;
+        if (pos == end)
+            break;
+        const char* tokenStart = pos;
+        while (pos != end && !IsTokenDelimiter(*pos))
+            ++pos;
+        IndexType id = TranslateToken(tokenStart, pos);
+        if (id < 0) // out-of-vocabulary token and the vocabulary has no unknown symbol
+        {
+            if (m_traceLevel >= 1)
+                fprintf(stderr, "WARNING: Out-of-vocabulary token '%s' in sequence %" PRIu64 " of the input file (%ls).\n",
+                    string(tokenStart, pos).c_str(), (uint64_t)descriptor.m_key.m_sequence, m_filename.c_str());
+            IncrementNumberOfErrorsOrDie();
+            isValid = false;
+            id = 0;
+        }
+        augmented.push_back(id);
+    }
+    if (m_sentenceEndId >= 0)
+        augmented.push_back(m_sentenceEndId);
+
+    if (augmented.size() != descriptor.m_numberOfSamples + (size_t)1)
+        RuntimeError("Token count of sequence %" PRIu64 " changed between indexing and parsing of the input file (%ls).",
+            (uint64_t)descriptor.m_key.m_sequence, m_filename.c_str());
+
+    // 'input' is the augmented sequence without its last token, 'label' without its first
+    size_t numSamples = descriptor.m_numberOfSamples;
+    SequenceBuffer sequence;
+    for (size_t j = 0; j < 2; ++j)
+    {
+        auto data = make_shared<SparseTokenStreamBuffer>();
+        data->m_indicesBuffer.assign(augmented.begin() + j, augmented.begin() + j + numSamples);
+        data->m_buffer.assign(numSamples, (ElemType)1);
+        data->m_nnzCounts.assign(numSamples, 1);
+        data->m_totalNnzCount = (IndexType)numSamples;
+        data->m_indices = data->m_indicesBuffer.data();
+        data->m_numberOfSamples = (uint32_t)numSamples;
+        data->m_sampleLayout = m_streams[j]->m_sampleLayout;
+        data->m_key = descriptor.m_key;
+        data->m_isValid = isValid;
+        sequence.push_back(data);
+    }
+    return sequence;
+}
+
+template <class ElemType>
+void LMTextDeserializer<ElemType>::IncrementNumberOfErrorsOrDie()
+{
+    // Check-and-decrement has to be atomic, chunks may be parsed on multiple threads.
+    unsigned int remaining = m_numAllowedErrors;
+    do
+    {
+        if (remaining == 0)
+            RuntimeError("Reached the maximum number of allowed errors"
+                " while reading the input file (%ls).",
+                m_filename.c_str());
+    } while (!m_numAllowedErrors.compare_exchange_weak(remaining, remaining - 1));
+}
+
+template class LMTextDeserializer<float>;
+template class LMTextDeserializer<double>;
+
+}}}
@@ -0,0 +1,118 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#pragma once
+
+#include <atomic>
+#include <unordered_map>
+#include "DataDeserializerBase.h"
+#include "Config.h"
+#include "Indexer.h"
+#include "CorpusDescriptor.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// A deserializer for plain-text language-model data (one sentence per line,
+// whitespace-separated tokens). It replaces the legacy LMSequenceReader: instead of a
+// single-threaded reader with its own epoch logic, it exposes the corpus as indexed
+// chunks of sequences, so language-model jobs get the same randomization, prefetch and
+// packing machinery (BlockRandomizer/SequencePacker or CompositeDataReader) as CTF jobs.
+//
+// The deserializer exposes two sparse one-hot streams over the vocabulary:
+//  - 'input' : the token at each position (preceded by the sentence-begin marker, if present in the vocabulary)
+//  - 'label' : the next token at each position (followed by the sentence-end marker, if present in the vocabulary)
+// The vocabulary is a plain-text file with one token per line; a token's class id is its line number.
+// Token lookup uses a hash map, out-of-vocabulary tokens map to the configured unknown symbol.
+template <class ElemType>
+class LMTextDeserializer : public DataDeserializerBase
+{
+public:
+    LMTextDeserializer(CorpusDescriptorPtr corpus, const ConfigParameters& config, bool primary);
+    ~LMTextDeserializer();
+
+    // Retrieves a chunk of data.
+    ChunkPtr GetChunk(ChunkIdType chunkId) override;
+
+    // Get information about chunks.
+    ChunkDescriptions GetChunkDescriptions() override;
+
+    // Get information about particular chunk.
+    void GetSequencesForChunk(ChunkIdType chunkId, std::vector<SequenceDescription>& result) override;
+
+    bool GetSequenceDescriptionByKey(const KeyType&, SequenceDescription&) override;
+
+private:
+    // In-memory representation of one one-hot stream of a sequence.
+    struct SparseTokenStreamBuffer : SparseSequenceData
+    {
+        SparseTokenStreamBuffer()
+        {
+            m_totalNnzCount = 0;
+        }
+
+        const void* GetDataBuffer() override
+        {
+            return m_buffer.data();
+        }
+
+        std::vector<IndexType> m_indicesBuffer;
+        std::vector<ElemType> m_buffer;
+    };
+
+    // A sequence buffer is a vector that contains sequence data for each input stream.
+    typedef std::vector<SequenceDataPtr> SequenceBuffer;
+
+    // A chunk of tokenized sequences, fully loaded in memory.
+    class LMTextDataChunk;
+    typedef std::shared_ptr<LMTextDataChunk> LMTextChunkPtr;
+
+    // Reads the vocabulary file (one token per line, the line number is the class id).
+    void LoadVocabulary(const std::wstring& vocabFilePath);
+
+    // Scans the input file once, counting tokens per line and building the chunk/sequence index.
+    void BuildIndex();
+
+    // Returns the number of samples the line will produce (0 for lines to be skipped).
+    size_t NumberOfSamplesInLine(const char* begin, const char* end) const;
+
+    // Reads the chunk's byte range from the file and tokenizes its sequences
+    // (concurrently, when more than one parse thread is configured).
+    void LoadChunk(LMTextChunkPtr& chunk, const ChunkDescriptor& descriptor);
+
+    // Tokenizes the line of a single sequence into its 'input' and 'label' streams.
+    SequenceBuffer LoadSequence(const char* bufferStart, const SequenceDescriptor& descriptor);
+
+    // Looks a token up in the vocabulary, falling back to the unknown symbol.
+    IndexType TranslateToken(const char* begin, const char* end);
+
+    void IncrementNumberOfErrorsOrDie();
+
+    const std::wstring m_filename;
+    FILE* m_file;
+
+    // Vocabulary: hashed token -> class id lookup.
+    std::unordered_map<std::string, IndexType> m_vocabulary;
+    size_t m_vocabularySize;
+    IndexType m_unkId;            // id of the unknown symbol, or -1 if the vocabulary has none
+    IndexType m_sentenceBeginId;  // id of the sentence-begin marker, or -1 if the vocabulary has none
+    IndexType m_sentenceEndId;    // id of the sentence-end marker, or -1 if the vocabulary has none
+
+    // Chunk and sequence metadata built by BuildIndex().
+    std::unique_ptr<Index> m_index;
+
+    size_t m_chunkSizeBytes;
+    size_t m_parseThreadCount; // number of threads tokenizing a single chunk, 0 - one per hardware thread
+    unsigned int m_traceLevel;
+    std::atomic<unsigned int> m_numAllowedErrors;
+    unsigned int m_numRetries; // specifies the number of times an unsuccessful
+                               // file operation should be repeated (default value is 5).
+
+    // Corpus descriptor.
+    CorpusDescriptorPtr m_corpus;
+
+    DISABLE_COPY_AND_MOVE(LMTextDeserializer);
+};
+
+}}}
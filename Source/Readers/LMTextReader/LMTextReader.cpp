@@ -0,0 +1,60 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#include "stdafx.h"
+#include "LMTextReader.h"
+#include "Config.h"
+#include "BlockRandomizer.h"
+#include "NoRandomizer.h"
+#include "LMTextDeserializer.h"
+#include "SequencePacker.h"
+#include "ReaderUtil.h"
+#include "StringUtil.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+using namespace std;
+
+LMTextReader::LMTextReader(const ConfigParameters& config)
+{
+    wstring filePath = config(L"file", L"");
+    try
+    {
+        auto corpus = make_shared<CorpusDescriptor>(true);
+        string precision = config.Find("precision", "float");
+        if (AreEqualIgnoreCase(precision, "float"))
+            m_deserializer = make_shared<LMTextDeserializer<float>>(corpus, config, true);
+        else if (AreEqualIgnoreCase(precision, "double"))
+            m_deserializer = make_shared<LMTextDeserializer<double>>(corpus, config, true);
+        else
+            InvalidArgument("Unsupported precision '%s'", precision.c_str());
+
+        size_t window = config(L"randomizationWindow", (size_t)0);
+        if (window > 0)
+        {
+            int verbosity = config(L"verbosity", 0);
+            m_sequenceEnumerator = make_shared<BlockRandomizer>(verbosity, window, m_deserializer,
+                                                                /*shouldPrefetch =*/ true,
+                                                                /*multithreadedGetNextSequences =*/ false,
+                                                                /*maxNumberOfInvalidSequences =*/ 0,
+                                                                /*sampleBasedRandomizationWindow =*/ false,
+                                                                /*seedOffset =*/ GetRandomSeed(config));
+        }
+        else
+        {
+            m_sequenceEnumerator = make_shared<NoRandomizer>(m_deserializer);
+        }
+
+        m_packer = std::make_shared<SequencePacker>(
+            m_sequenceEnumerator,
+            ReaderBase::GetStreamDescriptions());
+    }
+    catch (const std::runtime_error& e)
+    {
+        RuntimeError("LMTextReader: While reading '%ls': %s", filePath.c_str(), e.what());
+    }
+}
+
+}}}
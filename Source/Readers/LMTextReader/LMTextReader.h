@@ -0,0 +1,21 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#pragma once
+
+#include "ReaderBase.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// Implementation of the text language-model reader.
+// Effectively the class represents a factory for connecting the packer,
+// randomizer and the LM text deserializer together.
+class LMTextReader : public ReaderBase
+{
+public:
+    LMTextReader(const ConfigParameters& parameters);
+};
+
+}}}
@@ -0,0 +1,21 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+// stdafx.h : include file for standard system include files,
+// or project specific include files that are used frequently, but
+// are changed infrequently
+//
+
+#pragma once
+
+#include "Platform.h"
+#define _CRT_SECURE_NO_WARNINGS // "secure" CRT not available on all platforms
+#include "targetver.h"
+#ifdef __WINDOWS__
+#include "windows.h"
+#endif
+#include <stdio.h>
+#include <math.h>
+
+// TODO: reference additional headers your program requires here
@@ -0,0 +1,202 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+// ReaderBench.cpp : standalone benchmark harness for the reader pipeline.
+//
+// Drives any configured deserializer/randomizer/packer stack through the CompositeDataReader
+// plugin without a network attached, so reader throughput can be measured in isolation instead
+// of being inferred from GPU idle time in production. Reports sequences/sec, samples/sec,
+// dense bytes/sec, and ReadMinibatch() latency percentiles per epoch; running several epochs
+// shows warm-cache behavior (e.g. chunk or decoded-image caches). Per-stage timings inside the
+// stack (index/load/decode/randomize/pack) are not exposed across the reader interface; use the
+// performance profiler and the components' own verbosity switches for that level of detail.
+//
+// Usage: readerbench configFile=<config> [key=value ...]
+// The reader stack may be described in a 'reader' sub-section (as in full CNTK configs) or at
+// the top level of the config. Recognized harness parameters (top level):
+//   minibatchSize - minibatch size in samples (default 1024)
+//   epochSize     - epoch size in samples (default: one pass over the data)
+//   epochs        - number of epochs to drive (default 1)
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "Basics.h"
+#include "Config.h"
+#include "DataReader.h" // for requestDataSize
+#include "Reader.h"
+#include "Sequences.h"
+#include "TimerUtility.h"
+
+using namespace Microsoft::MSR::CNTK;
+
+static const char* StorageTypeName(StorageType type)
+{
+    return type == StorageType::dense ? "dense" : "sparse";
+}
+
+static const char* ElementTypeName(ElementType type)
+{
+    switch (type)
+    {
+    case ElementType::tfloat:  return "float";
+    case ElementType::tdouble: return "double";
+    case ElementType::tuchar:  return "uchar";
+    default:                   return "variant";
+    }
+}
+
+// size in bytes of one element of the *packed* minibatch; the packer converts variant streams
+// to the configured precision
+static size_t PackedElementSize(ElementType type, size_t precisionSize)
+{
+    switch (type)
+    {
+    case ElementType::tfloat:  return sizeof(float);
+    case ElementType::tdouble: return sizeof(double);
+    case ElementType::tuchar:  return sizeof(unsigned char);
+    default:                   return precisionSize;
+    }
+}
+
+static double Percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+        return 0.0;
+    size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+int wmain1(int argc, wchar_t* argv[])
+{
+    try
+    {
+        ConfigParameters config;
+        ConfigParameters::ParseCommandLine(argc, argv, config);
+
+        size_t minibatchSize = config(L"minibatchSize", (size_t)1024);
+        size_t epochSize = config(L"epochSize", (size_t)requestDataSize);
+        if (epochSize == 0)
+            epochSize = requestDataSize; // 0 - one pass over the data, as in SGD configs
+        size_t numEpochs = config(L"epochs", (size_t)1);
+
+        // the reader stack may be described in a 'reader' sub-section (full CNTK configs) or at the top level
+        ConfigParameters readerConfig(config.Exists(L"reader") ? ConfigParameters(config(L"reader")) : config);
+        size_t precisionSize = std::string(readerConfig(L"precision", "float")) == "double" ? sizeof(double) : sizeof(float);
+
+        typedef Reader*(*CreateCompositeDataReaderProc)(const ConfigParameters* parameters);
+        CreateCompositeDataReaderProc createReaderProc = (CreateCompositeDataReaderProc)Plugin().Load(L"CompositeDataReader", "CreateCompositeDataReader");
+        std::shared_ptr<Reader> reader(createReaderProc(&readerConfig));
+
+        auto streams = reader->GetStreamDescriptions();
+        std::map<std::wstring, int> inputDescriptions;
+        fprintf(stderr, "readerbench: minibatchSize=%d, epochs=%d, %d streams:\n", (int)minibatchSize, (int)numEpochs, (int)streams.size());
+        for (const auto& stream : streams)
+        {
+            inputDescriptions[stream->m_name] = CPUDEVICE; // no network attached, everything stays on the CPU
+            fprintf(stderr, "\t%ls: %s %s, sample layout %ls\n",
+                    stream->m_name.c_str(), StorageTypeName(stream->m_storageType), ElementTypeName(stream->m_elementType),
+                    stream->m_sampleLayout != nullptr ? static_cast<std::wstring>(*stream->m_sampleLayout).c_str() : L"per sequence");
+        }
+
+        bool hasSparseStreams = false;
+        for (const auto& stream : streams)
+            hasSparseStreams |= stream->m_storageType != StorageType::dense;
+        if (hasSparseStreams)
+            fprintf(stderr, "readerbench: sparse streams are excluded from the bytes/sec figure.\n");
+
+        for (size_t epoch = 0; epoch < numEpochs; epoch++)
+        {
+            EpochConfiguration epochConfig;
+            epochConfig.m_numberOfWorkers = 1;
+            epochConfig.m_workerRank = 0;
+            epochConfig.m_minibatchSizeInSamples = minibatchSize;
+            epochConfig.m_totalEpochSizeInSamples = epochSize;
+            epochConfig.m_epochIndex = epoch;
+            reader->StartEpoch(epochConfig, inputDescriptions);
+
+            size_t numMinibatches = 0, numSequences = 0, numSamples = 0, numBytes = 0;
+            std::vector<double> latencies;
+
+            Timer epochTimer;
+            epochTimer.Start();
+            for (;;)
+            {
+                Timer readTimer;
+                readTimer.Start();
+                Minibatch minibatch = reader->ReadMinibatch();
+                readTimer.Stop();
+                latencies.push_back(readTimer.ElapsedSeconds());
+
+                if (!minibatch.m_data.empty())
+                {
+                    numMinibatches++;
+
+                    // sequence/sample counts are taken from the first stream; streams of one
+                    // minibatch may differ in layout, but describe the same set of sequences
+                    const auto& layout = minibatch.m_data.front()->m_layout;
+                    numSequences += layout->GetNumSequences();
+                    numSamples += layout->GetActualNumSamples();
+
+                    for (size_t i = 0; i < minibatch.m_data.size(); i++)
+                    {
+                        if (streams[i]->m_storageType != StorageType::dense || streams[i]->m_sampleLayout == nullptr)
+                            continue;
+                        numBytes += minibatch.m_data[i]->m_layout->GetActualNumSamples() *
+                                    streams[i]->m_sampleLayout->GetNumElements() *
+                                    PackedElementSize(streams[i]->m_elementType, precisionSize);
+                    }
+                }
+
+                if (minibatch.m_endOfEpoch)
+                    break;
+            }
+            epochTimer.Stop();
+
+            double seconds = epochTimer.ElapsedSeconds();
+            std::sort(latencies.begin(), latencies.end());
+            fprintf(stderr, "epoch %d: %d minibatches, %d sequences, %d samples, %.1f MB dense in %.3fs\n",
+                    (int)epoch, (int)numMinibatches, (int)numSequences, (int)numSamples, numBytes / 1e6, seconds);
+            fprintf(stderr, "\t%.1f sequences/sec, %.1f samples/sec, %.1f MB/sec\n",
+                    numSequences / seconds, numSamples / seconds, numBytes / 1e6 / seconds);
+            fprintf(stderr, "\tReadMinibatch latency: p50 %.3fms, p90 %.3fms, p99 %.3fms, max %.3fms\n",
+                    Percentile(latencies, 0.50) * 1e3, Percentile(latencies, 0.90) * 1e3,
+                    Percentile(latencies, 0.99) * 1e3, latencies.empty() ? 0.0 : latencies.back() * 1e3);
+        }
+
+        return 0;
+    }
+    catch (const std::exception& err)
+    {
+        fprintf(stderr, "EXCEPTION occurred: %s\n", err.what());
+        return EXIT_FAILURE;
+    }
+}
+
+#ifdef __UNIX__
+/// UNIX main function converts arguments in UTF-8 encoding and passes to Visual-Studio style wmain() which takes wchar_t strings.
+int main(int argc, char* argv[])
+{
+    // TODO: change to STL containers
+    wchar_t** wargs = new wchar_t*[argc];
+    for (int i = 0; i < argc; ++i)
+    {
+        wargs[i] = new wchar_t[strlen(argv[i]) + 1];
+        size_t ans = ::mbstowcs(wargs[i], argv[i], strlen(argv[i]) + 1);
+        assert(ans == strlen(argv[i]));
+        UNUSED(ans);
+    }
+    int ret = wmain1(argc, wargs);
+    for (int i = 0; i < argc; ++i)
+        delete[] wargs[i];
+    delete[] wargs;
+    return ret;
+}
+#else
+int wmain(int argc, wchar_t* argv[])
+{
+    return wmain1(argc, argv);
+}
+#endif
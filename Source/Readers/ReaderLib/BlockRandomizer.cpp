@@ -24,7 +24,11 @@ BlockRandomizer::BlockRandomizer(
     bool multithreadedGetNextSequence,
     size_t maxNumberOfInvalidSequences,
     bool sampleBasedRandomizationWindow,
-    size_t seedOffset)
+    size_t seedOffset,
+    size_t prefetchBudgetInBytes,
+    size_t lengthBucketWidthInSamples,
+    bool windowFreeRandomization,
+    size_t deserializationThreadCount)
     : m_verbosity(verbosity),
       m_deserializer(deserializer),
       m_sweep(SIZE_MAX),
@@ -34,7 +38,9 @@ BlockRandomizer::BlockRandomizer(
       m_sweepSizeInSamples(0),
       m_chunkRandomizer(std::make_shared<ChunkRandomizer>(deserializer, randomizationRange, sampleBasedRandomizationWindow)),
       m_multithreadedGetNextSequences(multithreadedGetNextSequence),
-      m_prefetchedChunk(CHUNKID_MAX),
+      m_deserializationThreadCount(deserializationThreadCount),
+      m_prefetchBudgetInBytes(prefetchBudgetInBytes),
+      m_prefetchedSizeInBytes(0),
       m_cleaner(maxNumberOfInvalidSequences),
       m_seedOffset(seedOffset)
 {
@@ -43,7 +49,16 @@ BlockRandomizer::BlockRandomizer(
     m_launchType = shouldPrefetch ? launch::async : launch::deferred;
 
     m_streams = m_deserializer->GetStreamDescriptions();
-    m_sequenceRandomizer = std::make_shared<SequenceRandomizer>(verbosity, m_deserializer, m_chunkRandomizer);
+    m_sequenceRandomizer = std::make_shared<SequenceRandomizer>(verbosity, m_deserializer, m_chunkRandomizer, lengthBucketWidthInSamples, windowFreeRandomization);
+
+    // Estimate the in-memory size of a sample for the prefetch byte budget.
+    // The deserializers expose only sample counts per chunk, not byte sizes.
+    m_estimatedSampleSizeInBytes = 0;
+    for (auto const & stream : m_streams)
+    {
+        size_t elementSize = stream->m_elementType == ElementType::tdouble ? sizeof(double) : sizeof(float);
+        m_estimatedSampleSizeInBytes += stream->m_sampleLayout->GetNumElements() * elementSize;
+    }
 
     // Calculate total number of samples.
     m_sweepSizeInSamples = 0;
@@ -115,6 +130,11 @@ void BlockRandomizer::PrepareNewSweepIfNeeded(size_t samplePosition)
         // Resetting sequence randomizer.
         m_sequenceRandomizer->Reset(m_seedOffset + m_sweep);
         m_currentWindowRange = {};
+
+        // Dropping outstanding prefetches, the new sweep has a different chunk order.
+        WaitForOutstandingPrefetches();
+        m_prefetches.clear();
+        m_prefetchedSizeInBytes = 0;
     }
 }
 
@@ -217,9 +237,18 @@ std::pair<size_t, size_t> BlockRandomizer::LoadSequenceData(size_t globalSampleC
     if (m_multithreadedGetNextSequences)
     {
         ExceptionCapture capture;
+        if (m_deserializationThreadCount != 0)
+        {
+#pragma omp parallel for schedule(dynamic) num_threads((int)m_deserializationThreadCount)
+            for (int i = 0; i < m_sequenceBuffer.size(); ++i)
+                capture.SafeRun(process, i);
+        }
+        else
+        {
 #pragma omp parallel for schedule(dynamic)
-        for (int i = 0; i < m_sequenceBuffer.size(); ++i)
-            capture.SafeRun(process, i);
+            for (int i = 0; i < m_sequenceBuffer.size(); ++i)
+                capture.SafeRun(process, i);
+        }
         capture.RethrowIfHappened();
     }
     else
@@ -228,9 +257,8 @@ std::pair<size_t, size_t> BlockRandomizer::LoadSequenceData(size_t globalSampleC
             process(i);
     }
 
-    // Now it is safe to start the new chunk prefetch.
-    ChunkIdType chunkToPrefetchNext = GetChunkToPrefetch(windowRange);
-    Prefetch(chunkToPrefetchNext);
+    // Now it is safe to start the new chunk prefetches.
+    Prefetch(GetChunksToPrefetch(windowRange));
 
     return { numGlobalSamples, numLocalSamples };
 }
@@ -354,10 +382,13 @@ void BlockRandomizer::LoadDataChunks(const ClosedOpenChunkInterval& windowRange)
         }
 
         auto const& chunk = m_chunkRandomizer->GetRandomizedChunks()[i];
-        if (chunk.m_original->m_id == m_prefetchedChunk && m_prefetch.valid())
+        auto prefetch = m_prefetches.find(chunk.m_original->m_id);
+        if (prefetch != m_prefetches.end())
         {
             // Taking prefetched chunk.
-            m_chunks[chunk.m_original->m_id] = m_prefetch.get();
+            m_chunks[chunk.m_original->m_id] = prefetch->second.m_future.get();
+            m_prefetchedSizeInBytes -= prefetch->second.m_estimatedSizeInBytes;
+            m_prefetches.erase(prefetch);
             if (m_verbosity >= Information)
                 fprintf(stderr, "BlockRandomizer::RetrieveDataChunks: paged in prefetched chunk %u (original chunk: %u), now %" PRIu64 " chunks in memory\n",
                 chunk.m_chunkId,
@@ -366,11 +397,8 @@ void BlockRandomizer::LoadDataChunks(const ClosedOpenChunkInterval& windowRange)
         }
         else
         {
-            // Make sure we have no outstanding prefetches.
-            if (m_prefetch.valid())
-            {
-                m_prefetch.wait();
-            }
+            // Make sure we have no outstanding prefetches, chunk loads are serialized.
+            WaitForOutstandingPrefetches();
 
             m_chunks[chunk.m_original->m_id] = m_deserializer->GetChunk(chunk.m_original->m_id);
             if (m_verbosity >= Information)
@@ -388,45 +416,69 @@ void BlockRandomizer::LoadDataChunks(const ClosedOpenChunkInterval& windowRange)
                 m_chunkRandomizer->GetRandomizedChunks()[windowRange.m_end - 1].m_chunkId);
 }
 
-// Identifies chunk id that should be prefetched.
-ChunkIdType BlockRandomizer::GetChunkToPrefetch(const ClosedOpenChunkInterval& windowRange)
+// Identifies chunk ids that should be prefetched, as many upcoming chunks of the
+// randomization window as fit the byte budget (but always at least one chunk of look-ahead).
+std::vector<std::pair<ChunkIdType, size_t>> BlockRandomizer::GetChunksToPrefetch(const ClosedOpenChunkInterval& windowRange)
 {
-    ChunkIdType toBePrefetched = CHUNKID_MAX;
+    std::vector<std::pair<ChunkIdType, size_t>> toBePrefetched;
+    size_t budgetUsed = m_prefetchedSizeInBytes;
     auto current = windowRange.m_end;
     while (current < m_chunkRandomizer->GetRandomizedChunks().size())
     {
         const auto& chunk = m_chunkRandomizer->GetRandomizedChunks()[current];
         if (chunk.m_chunkId % m_config.m_numberOfWorkers == m_config.m_workerRank &&
-            m_chunks.find(chunk.m_original->m_id) == m_chunks.end())
+            m_chunks.find(chunk.m_original->m_id) == m_chunks.end() &&
+            m_prefetches.find(chunk.m_original->m_id) == m_prefetches.end())
         {
-            toBePrefetched = chunk.m_original->m_id;
-            break;
+            size_t estimatedSize = chunk.m_original->m_numberOfSamples * m_estimatedSampleSizeInBytes;
+            bool firstInFlight = m_prefetches.empty() && toBePrefetched.empty();
+            if (!firstInFlight && budgetUsed + estimatedSize > m_prefetchBudgetInBytes)
+                break;
+
+            toBePrefetched.push_back(std::make_pair(chunk.m_original->m_id, estimatedSize));
+            budgetUsed += estimatedSize;
         }
         ++current;
     }
     return toBePrefetched;
 }
 
-// Performs io prefetch of the specified chunk if needed.
-void BlockRandomizer::Prefetch(ChunkIdType chunkId)
+// Performs io prefetch of the specified chunks if needed.
+void BlockRandomizer::Prefetch(const std::vector<std::pair<ChunkIdType, size_t>>& chunks)
 {
-    // Start new prefetch if necessary.
-    if (m_prefetchedChunk != chunkId && chunkId != CHUNKID_MAX)
+    for (const auto& c : chunks)
     {
-        // Wait to make sure there is no outstanding prefetches.
-        if (m_prefetch.valid())
+        ChunkIdType chunkId = c.first;
+
+        // Chain the new load after the most recent one. Loads are serialized on a single
+        // background worker, because GetChunk() of the deserializers is not guaranteed
+        // to be safe to call concurrently.
+        auto previous = m_lastPrefetch;
+        m_lastPrefetch = std::async(m_launchType, [this, chunkId, previous]()
         {
-            m_prefetch.wait();
-        }
+            if (previous.valid())
+                previous.wait();
+            return m_deserializer->GetChunk(chunkId);
+        }).share();
 
-        m_prefetchedChunk = chunkId;
-        m_prefetch = std::async(m_launchType, [this, chunkId]() { return m_deserializer->GetChunk(chunkId); });
+        m_prefetches[chunkId] = ChunkPrefetch{ m_lastPrefetch, c.second };
+        m_prefetchedSizeInBytes += c.second;
 
         if (m_verbosity >= Debug)
             fprintf(stderr, "BlockRandomizer::Prefetch: prefetching original chunk: %u\n", chunkId);
     }
 }
 
+// Waits until all outstanding prefetches have finished.
+void BlockRandomizer::WaitForOutstandingPrefetches()
+{
+    // Prefetches are chained, waiting for the last one implies all of them.
+    if (m_lastPrefetch.valid())
+    {
+        m_lastPrefetch.wait();
+    }
+}
+
 void BlockRandomizer::SetCurrentSamplePosition(size_t currentSamplePosition)
 {
     PrepareNewSweepIfNeeded(currentSamplePosition);
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <vector>
+#include <map>
+#include <utility>
 
 #include "SequenceEnumerator.h"
 #include "DataDeserializer.h"
@@ -44,7 +46,11 @@ public:
         bool multithreadedGetNextSequences = false,
         size_t maxNumberOfInvalidSequences = 0, // per worker
         bool sampleBasedRandomizationWindow = true,
-        size_t seedOffset = 0);
+        size_t seedOffset = 0,
+        size_t prefetchBudgetInBytes = 0, // 0 - single chunk of look-ahead
+        size_t lengthBucketWidthInSamples = 0, // 0 - no length-bucketed batching
+        bool windowFreeRandomization = false, // compute the sequence permutation instead of storing it (frame mode only)
+        size_t deserializationThreadCount = 0); // 0 - use the OpenMP default number of threads
 
     // Starts a new epoch.
     virtual void StartEpoch(const EpochConfiguration& config) override;
@@ -65,9 +71,10 @@ public:
 
     ~BlockRandomizer()
     {
-        if (m_prefetch.valid())
+        // Prefetches are chained, waiting for the last one implies all of them have finished.
+        if (m_lastPrefetch.valid())
         {
-            m_prefetch.wait();
+            m_lastPrefetch.wait();
         }
     }
 
@@ -98,11 +105,15 @@ private:
     // Prepares a new sweep if needed.
     void PrepareNewSweepIfNeeded(size_t samplePosition);
 
-    // Performs io prefetch of the specified chunk if needed.
-    void Prefetch(ChunkIdType chunkId);
+    // Performs io prefetch of the specified chunks (original chunk id with estimated size in bytes).
+    void Prefetch(const std::vector<std::pair<ChunkIdType, size_t>>& chunks);
 
-    // Returns next candidate for the prefetch in the given range.
-    ChunkIdType GetChunkToPrefetch(const ClosedOpenChunkInterval& windowRange);
+    // Returns next candidates for prefetch beyond the given range,
+    // as many as the prefetch byte budget allows (but at least one).
+    std::vector<std::pair<ChunkIdType, size_t>> GetChunksToPrefetch(const ClosedOpenChunkInterval& windowRange);
+
+    // Waits until all outstanding prefetches have finished.
+    void WaitForOutstandingPrefetches();
 
     // Global sample position on the timeline.
     size_t m_globalSamplePosition;
@@ -142,6 +153,9 @@ private:
     // Whether to get sequences using multiple thread.
     bool m_multithreadedGetNextSequences;
 
+    // Number of threads used for multithreaded sequence deserialization, 0 - the OpenMP default.
+    size_t m_deserializationThreadCount;
+
     // General configuration
     // TODO generalize those for ReaderLib / Reader / CNTK
     enum VerbosityLevel
@@ -154,12 +168,32 @@ private:
 
     int m_verbosity;
 
-    // Prefetch future.
-    std::future<ChunkPtr> m_prefetch;
+    // An outstanding chunk prefetch.
+    struct ChunkPrefetch
+    {
+        std::shared_future<ChunkPtr> m_future;
+        size_t m_estimatedSizeInBytes;
+    };
+
+    // Outstanding prefetches by original chunk id. The loads are chained on a single
+    // background worker because deserializers do not guarantee thread-safe GetChunk().
+    std::map<ChunkIdType, ChunkPrefetch> m_prefetches;
+
+    // The most recently issued prefetch; waiting on it implies all prefetches have finished.
+    std::shared_future<ChunkPtr> m_lastPrefetch;
+
+    // Byte budget for outstanding prefetches (0 - single chunk of look-ahead).
+    size_t m_prefetchBudgetInBytes;
+
+    // Estimated total size of outstanding prefetches.
+    size_t m_prefetchedSizeInBytes;
+
+    // Estimated size of a single sample in bytes, used for the byte budget.
+    // Exact chunk sizes are not exposed by the deserializers, only sample counts are.
+    size_t m_estimatedSampleSizeInBytes;
+
     // Whether to have async or deferred prefetch.
     launch m_launchType;
-    // Prefetched original chunk id.
-    ChunkIdType m_prefetchedChunk;
 
     // Current loaded chunks.
     ClosedOpenChunkInterval m_currentWindowRange;
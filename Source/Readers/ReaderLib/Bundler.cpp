@@ -5,8 +5,11 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include "Bundler.h"
+#include "ExceptionCapture.h"
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
+#include <atomic>
+#include <future>
 #include <set>
 
 namespace Microsoft { namespace MSR { namespace CNTK {
@@ -18,6 +21,14 @@ struct Bundler::BundlerChunkDescription : public ChunkDescription
 
     // Sequences that are invalid in at least one deserializer.
     std::set<size_t> m_invalid;
+
+    // Whether the sequences of this chunk have already been checked against all deserializers.
+    std::atomic<bool> m_verified {false};
+
+    // If flag is set to true the sequence lengths of this chunk are counted by the primary
+    // deserializer only. Used for optimization when sequences between different deserializers
+    // are of the same length (i.e. often in speech)
+    bool m_takePrimarySequenceLength = true;
 };
 
 Bundler::Bundler(
@@ -31,6 +42,15 @@ Bundler::Bundler(
 {
     m_verbosity = readerConfig(L"verbosity", 0);
 
+    // By default chunks are verified lazily on first access; walking every chunk of every
+    // deserializer up front can take minutes on large multi-stream corpora.
+    m_eagerVerification = readerConfig(L"eagerChunkVerification", false);
+
+    // Deserialize the streams of a chunk on per-deserializer workers, so that for
+    // multimodal inputs the chunk latency is the maximum over the deserializers
+    // instead of their sum.
+    m_parallelChunkLoad = readerConfig(L"parallelChunkDeserialization", true);
+
     // Combines streams of underlying deserializers.
     for (auto d : deserializers)
     {
@@ -73,8 +93,10 @@ void Bundler::CreateChunkDescriptions()
     if (m_verbosity)
         fprintf(stderr, "Bundler::CreateChunkDescriptions(): creating descriptions for %" PRIu64 " chunks\n", chunks.size());
 
-    // If there is not cleaning required simply build chunks based on the chunk descriptions of the primary deserializer.
-    if (!m_cleanse)
+    // If no cleaning is required, or the cleaning is lazy, simply build chunks based on the
+    // chunk descriptions of the primary deserializer. In the lazy case the sequences of a
+    // chunk are checked against the other deserializers when the chunk is first requested.
+    if (!m_cleanse || !m_eagerVerification)
     {
         for (const auto& c : chunks)
         {
@@ -83,6 +105,7 @@ void Bundler::CreateChunkDescriptions()
             cd->m_numberOfSequences = c->m_numberOfSequences;
             cd->m_id = (ChunkIdType) m_chunks.size();
             cd->m_original = c;
+            cd->m_verified = !m_cleanse;
             m_chunks.push_back(cd);
         }
 
@@ -143,11 +166,15 @@ void Bundler::CreateChunkDescriptions()
             cd->m_numberOfSequences = numberOfSequences;
             cd->m_id = (ChunkIdType) m_chunks.size();
             cd->m_original = chunks[chunkIndex];
+            cd->m_verified = true;
             m_chunks.push_back(cd);
             cd->m_invalid = std::move(invalid);
         }
     }
 
+    for (const auto& c : m_chunks)
+        c->m_takePrimarySequenceLength = m_takePrimarySequenceLength;
+
     if (m_verbosity)
         fprintf(stderr, "Bundler::CreateChunkDescriptions(): finished cleaning of %" PRIu64 " chunks\n", m_chunks.size());
 
@@ -156,6 +183,50 @@ void Bundler::CreateChunkDescriptions()
             " Keys of logical sequences do not match.");
 }
 
+// Checks the sequences of a chunk against all deserializers, recording the ones that are
+// invalid in at least one of them. No-op when the chunk has already been verified (always
+// the case after an eager CreateChunkDescriptions() pass). Guarded by a lock, since the
+// randomizer can request chunks from its prefetch thread.
+void Bundler::VerifyChunk(const BundlerChunkDescriptionPtr& chunk)
+{
+    if (chunk->m_verified)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_verificationMutex);
+    if (chunk->m_verified)
+        return;
+
+    if (m_verbosity)
+        fprintf(stderr, "Bundler::VerifyChunk(): verifying chunk %u\n", (unsigned int)chunk->m_id);
+
+    std::vector<SequenceDescription> sequenceDescriptions;
+    m_primaryDeserializer->GetSequencesForChunk(chunk->m_original->m_id, sequenceDescriptions);
+
+    SequenceDescription s;
+    bool takePrimarySequenceLength = true;
+    for (size_t sequenceIndex = 0; sequenceIndex < sequenceDescriptions.size(); ++sequenceIndex)
+    {
+        const auto& sequence = sequenceDescriptions[sequenceIndex];
+        for (size_t deserializerIndex = 1; deserializerIndex < m_deserializers.size(); ++deserializerIndex)
+        {
+            if (!m_deserializers[deserializerIndex]->GetSequenceDescription(sequence, s))
+            {
+                chunk->m_invalid.insert(sequenceIndex);
+                break;
+            }
+
+            takePrimarySequenceLength = takePrimarySequenceLength && (s.m_numberOfSamples <= sequence.m_numberOfSamples);
+        }
+    }
+
+    if (!chunk->m_invalid.empty() && chunk->m_invalid.size() == sequenceDescriptions.size())
+        fprintf(stderr, "WARNING: Could not reconcile any sequence of chunk %u between different deserializers.\n",
+            (unsigned int)chunk->m_id);
+
+    chunk->m_takePrimarySequenceLength = takePrimarySequenceLength;
+    chunk->m_verified = true;
+}
+
 // Gets chunk descriptions.
 ChunkDescriptions Bundler::GetChunkDescriptions()
 {
@@ -166,11 +237,13 @@ ChunkDescriptions Bundler::GetChunkDescriptions()
 void Bundler::GetSequencesForChunk(ChunkIdType chunkId, std::vector<SequenceDescription>& sequences)
 {
     BundlerChunkDescriptionPtr chunk = m_chunks[chunkId];
+    VerifyChunk(chunk);
+
     ChunkDescriptionPtr original = chunk->m_original;
     m_primaryDeserializer->GetSequencesForChunk(original->m_id, sequences);
 
     std::vector<SequenceDescription> result;
-    if (m_takePrimarySequenceLength) // No need to consult other deserializers.
+    if (chunk->m_takePrimarySequenceLength) // No need to consult other deserializers.
     {
         // Do cleansing.
         result.reserve(sequences.size());
@@ -235,6 +308,7 @@ public:
         : m_numberOfInputs(numberOfInputs), m_parent(parent), m_chunkId(chunkId)
     {
         BundlerChunkDescriptionPtr chunk = m_parent->m_chunks[m_chunkId];
+        m_parent->VerifyChunk(chunk);
         ChunkDescriptionPtr original = chunk->m_original;
 
         auto& deserializers = m_parent->m_deserializers;
@@ -243,25 +317,31 @@ public:
 
         // Creating chunk mapping.
         m_parent->m_primaryDeserializer->GetSequencesForChunk(original->m_id, sequences);
-        ChunkPtr drivingChunk = m_parent->m_primaryDeserializer->GetChunk(original->m_id);
         m_sequenceToSequence.resize(deserializers.size() * sequences.size());
         m_innerChunks.resize(deserializers.size() * sequences.size());
-        for (size_t sequenceIndex = 0; sequenceIndex < sequences.size(); ++sequenceIndex)
+
+        // Requires the driving chunk and fills the mapping slots of the primary deserializer.
+        auto loadPrimary = [this, &chunk, &original, &sequences, &deserializers]()
         {
-            if (chunk->m_invalid.find(sequenceIndex) != chunk->m_invalid.end())
+            ChunkPtr drivingChunk = m_parent->m_primaryDeserializer->GetChunk(original->m_id);
+            for (size_t sequenceIndex = 0; sequenceIndex < sequences.size(); ++sequenceIndex)
             {
-                continue;
-            }
+                if (chunk->m_invalid.find(sequenceIndex) != chunk->m_invalid.end())
+                {
+                    continue;
+                }
 
-            size_t currentIndex = sequenceIndex * deserializers.size();
-            m_sequenceToSequence[currentIndex] = sequences[sequenceIndex].m_indexInChunk;
-            m_innerChunks[currentIndex] = drivingChunk;
-        }
+                size_t currentIndex = sequenceIndex * deserializers.size();
+                m_sequenceToSequence[currentIndex] = sequences[sequenceIndex].m_indexInChunk;
+                m_innerChunks[currentIndex] = drivingChunk;
+            }
+        };
 
-        // Creating sequence mapping and requiring underlying chunks.
-        SequenceDescription s;
-        for (size_t deserializerIndex = 1; deserializerIndex < deserializers.size(); ++deserializerIndex)
+        // Creates the sequence mapping and requires the underlying chunks of one
+        // non-driving deserializer.
+        auto loadSecondary = [this, &chunk, &sequences, &deserializers](size_t deserializerIndex)
         {
+            SequenceDescription s;
             auto& chunkTable = m_parent->m_weakChunkTable[deserializerIndex];
             for (size_t sequenceIndex = 0; sequenceIndex < sequences.size(); ++sequenceIndex)
             {
@@ -283,6 +363,38 @@ public:
 
                 m_innerChunks[currentIndex] = secondaryChunk;
             }
+        };
+
+        // Each deserializer loads its part of the chunk on its own worker, joined before
+        // the chunk is published to the randomizer. The workers write to disjoint index
+        // slices, and each touches only its own deserializer and weak chunk table, so no
+        // further synchronization is needed.
+        if (m_parent->m_parallelChunkLoad && deserializers.size() > 1)
+        {
+            ExceptionCapture capture;
+            std::vector<std::future<void>> workers;
+            workers.reserve(deserializers.size());
+            workers.push_back(std::async(std::launch::async,
+                [&capture, &loadPrimary]() { capture.SafeRun(loadPrimary); }));
+            for (size_t deserializerIndex = 1; deserializerIndex < deserializers.size(); ++deserializerIndex)
+            {
+                workers.push_back(std::async(std::launch::async,
+                    [&capture, &loadSecondary, deserializerIndex]() { capture.SafeRun(loadSecondary, deserializerIndex); }));
+            }
+
+            for (auto& worker : workers)
+            {
+                worker.wait();
+            }
+            capture.RethrowIfHappened();
+        }
+        else
+        {
+            loadPrimary();
+            for (size_t deserializerIndex = 1; deserializerIndex < deserializers.size(); ++deserializerIndex)
+            {
+                loadSecondary(deserializerIndex);
+            }
         }
     }
 
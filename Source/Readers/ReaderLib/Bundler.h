@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "DataDeserializer.h"
 #include "DataDeserializerBase.h"
 #include "Config.h"
@@ -38,6 +40,11 @@ private:
     // Creates chunk descriptions based on chunks of underlying deserializers.
     void CreateChunkDescriptions();
 
+    // Checks the sequences of a chunk against all deserializers, recording the
+    // ones that cannot be reconciled. Called on first access to the chunk
+    // unless eager verification was requested.
+    void VerifyChunk(const BundlerChunkDescriptionPtr& chunk);
+
     // Underlying deserializers.
     std::vector<IDataDeserializerPtr> m_deserializers;
 
@@ -54,6 +61,21 @@ private:
     // If this flag is set to false, no cleaning will be done, so additional overhead.
     bool m_cleanse;
 
+    // Whether all chunks are verified against all deserializers at construction
+    // time. By default verification happens lazily when a chunk is first
+    // requested, so startup does not walk every chunk of every deserializer;
+    // the chunk descriptions then carry the counts of the primary deserializer.
+    bool m_eagerVerification;
+
+    // Serializes lazy chunk verification, which can be triggered both from the
+    // main thread and from the randomizer prefetch thread.
+    std::mutex m_verificationMutex;
+
+    // Whether the deserializers load their parts of a chunk on parallel workers,
+    // joined before the chunk is returned. Independent streams of the same chunk
+    // then deserialize concurrently instead of sequentially.
+    bool m_parallelChunkLoad;
+
     // If flag is set to true the sequence length is counted by the primary deserializer only.
     // Used for optimization when sequences between different deserializers are of the same length
     // (i.e. often in speech)
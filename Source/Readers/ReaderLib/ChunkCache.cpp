@@ -9,17 +9,68 @@
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
+ChunkCache::ChunkCache(IDataDeserializerPtr deserializer, size_t cacheBudgetInBytes)
+    : m_cacheBudgetInBytes(cacheBudgetInBytes),
+      m_cachedSizeInBytes(0),
+      m_deserializer(deserializer)
+{
+    if (m_cacheBudgetInBytes == 0)
+        return;
+
+    // Estimate the in-memory size of a sample from the stream descriptions;
+    // the deserializers expose only sample counts per chunk, not byte sizes.
+    size_t sampleSizeInBytes = 0;
+    for (const auto& stream : m_deserializer->GetStreamDescriptions())
+    {
+        size_t elementSize = stream->m_elementType == ElementType::tdouble ? sizeof(double) : sizeof(float);
+        sampleSizeInBytes += stream->m_sampleLayout->GetNumElements() * elementSize;
+    }
+
+    for (const auto& chunk : m_deserializer->GetChunkDescriptions())
+    {
+        m_estimatedChunkSizes[chunk->m_id] = chunk->m_numberOfSamples * sampleSizeInBytes;
+    }
+}
+
 ChunkPtr ChunkCache::GetChunk(ChunkIdType chunkId)
 {
     auto it = m_chunkMap.find(chunkId);
     if (it != m_chunkMap.end())
     {
-        return it->second;
+        // Move the chunk to the most-recently-used end.
+        if (m_cacheBudgetInBytes != 0)
+            m_lruOrder.splice(m_lruOrder.end(), m_lruOrder, it->second.m_lruPosition);
+        return it->second.m_chunk;
     }
- 
+
     ChunkPtr chunk = m_deserializer->GetChunk(chunkId);
-    m_chunkMap[chunkId] = chunk;
- 
+
+    size_t estimatedSize = 0;
+    if (m_cacheBudgetInBytes != 0)
+    {
+        auto size = m_estimatedChunkSizes.find(chunkId);
+        estimatedSize = size != m_estimatedChunkSizes.end() ? size->second : 0;
+
+        // Evict least recently used chunks until the new one fits the budget.
+        // Eviction only drops the cache's reference; a chunk still referenced elsewhere
+        // (e.g. by the randomizer window) is freed once its last user lets go.
+        while (m_cachedSizeInBytes + estimatedSize > m_cacheBudgetInBytes && !m_lruOrder.empty())
+        {
+            auto evicted = m_chunkMap.find(m_lruOrder.front());
+            m_cachedSizeInBytes -= evicted->second.m_estimatedSizeInBytes;
+            m_chunkMap.erase(evicted);
+            m_lruOrder.pop_front();
+        }
+    }
+
+    CachedChunk cached;
+    cached.m_chunk = chunk;
+    cached.m_estimatedSizeInBytes = estimatedSize;
+    if (m_cacheBudgetInBytes != 0)
+        cached.m_lruPosition = m_lruOrder.insert(m_lruOrder.end(), chunkId);
+    m_chunkMap[chunkId] = cached;
+    m_cachedSizeInBytes += estimatedSize;
+
     return chunk;
 }
 
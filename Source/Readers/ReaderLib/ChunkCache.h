@@ -6,21 +6,26 @@
 #pragma once
 
 #include <map>
+#include <list>
 #include "DataDeserializer.h"
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
-// A cache to store the complete dataset (all chunks) in memory. The caching can
-// be switched on/off by a boolean flag in the reader config section, independent 
-// of the randomization and chunking parameters. The caching should only be enabled 
-// when the whole dataset fits in memory.
+// A cache to store dataset chunks in memory. The caching can be switched on/off
+// by a boolean flag in the reader config section, independent of the randomization
+// and chunking parameters. Without a byte budget every chunk ever read is pinned,
+// which should only be enabled when the whole dataset fits in memory. With a byte
+// budget the least recently used chunks are evicted once the (estimated) total
+// size of cached chunks exceeds the budget.
 // Implemented as a wrapping proxy around a deserializer that stores pointers to
-// all chunks it sees in an internal map.
+// the chunks it sees in an internal map.
 class ChunkCache : public IDataDeserializer
 {
 public:
 
-    ChunkCache(IDataDeserializerPtr deserializer) : m_deserializer(deserializer) { }
+    // cacheBudgetInBytes limits the estimated total size of cached chunks,
+    // 0 - unbounded, the complete dataset is kept in memory.
+    ChunkCache(IDataDeserializerPtr deserializer, size_t cacheBudgetInBytes = 0);
 
     virtual std::vector<StreamDescriptionPtr> GetStreamDescriptions() const override
     {
@@ -46,8 +51,28 @@ public:
     virtual ChunkPtr GetChunk(ChunkIdType chunkId);
 
 private:
-    // A map of currently loaded chunks
-    std::map<size_t, ChunkPtr> m_chunkMap;
+    // A cached chunk with its estimated size and position in the LRU order.
+    struct CachedChunk
+    {
+        ChunkPtr m_chunk;
+        size_t m_estimatedSizeInBytes;
+        std::list<ChunkIdType>::iterator m_lruPosition;
+    };
+
+    // A map of currently cached chunks.
+    std::map<size_t, CachedChunk> m_chunkMap;
+
+    // Cached chunk ids, least recently used first. Not maintained when the cache is unbounded.
+    std::list<ChunkIdType> m_lruOrder;
+
+    // Byte budget of the cache (0 - unbounded) and current estimated usage.
+    size_t m_cacheBudgetInBytes;
+    size_t m_cachedSizeInBytes;
+
+    // Estimated chunk sizes by chunk id, based on sample counts and the stream sample
+    // shapes; the deserializers do not expose actual chunk byte sizes.
+    std::map<ChunkIdType, size_t> m_estimatedChunkSizes;
+
     IDataDeserializerPtr m_deserializer;
 
     DISABLE_COPY_AND_MOVE(ChunkCache);
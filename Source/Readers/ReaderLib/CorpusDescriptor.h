@@ -21,7 +21,8 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 class CorpusDescriptor
 {
 public:
-    CorpusDescriptor(const std::wstring& file, bool numericSequenceKeys) : CorpusDescriptor(numericSequenceKeys)
+    CorpusDescriptor(const std::wstring& file, bool numericSequenceKeys, bool hashSequenceKeys = false)
+        : CorpusDescriptor(numericSequenceKeys, hashSequenceKeys)
     {
         m_includeAll = false;
 
@@ -38,7 +39,12 @@ public:
     }
 
     // By default include all sequences.
-    CorpusDescriptor(bool numericSequenceKeys) : m_includeAll(true), m_numericSequenceKeys(numericSequenceKeys)
+    // When hashSequenceKeys is set, only a 64-bit hash of each symbolic key is
+    // kept instead of interning the full key - the right choice for corpora
+    // whose keys do not fit into memory, at the cost of error messages
+    // reporting the key hash rather than the key itself.
+    CorpusDescriptor(bool numericSequenceKeys, bool hashSequenceKeys = false)
+        : m_numericSequenceKeys(numericSequenceKeys), m_hashSequenceKeys(hashSequenceKeys), m_includeAll(true)
     {
         if (numericSequenceKeys)
         {
@@ -56,6 +62,21 @@ public:
                 return std::to_string(id);
             };
         }
+        else if (hashSequenceKeys)
+        {
+            KeyToId = [](const std::string& key)
+            {
+                return StringToIdMap::Hash(key);
+            };
+
+            IdToKey = [](size_t id)
+            {
+                // The key is not recoverable from its hash.
+                std::stringstream key;
+                key << "0x" << std::hex << id;
+                return key.str();
+            };
+        }
         else
         {
             KeyToId = [this](const std::string& key)
@@ -83,7 +104,7 @@ public:
         }
 
         size_t id = 0;
-        if (m_numericSequenceKeys)
+        if (m_numericSequenceKeys || m_hashSequenceKeys)
             id = KeyToId(sequenceKey);
         else
         {
@@ -99,6 +120,7 @@ public:
 private:
     DISABLE_COPY_AND_MOVE(CorpusDescriptor);
     bool m_numericSequenceKeys;
+    bool m_hashSequenceKeys;
     bool m_includeAll;
     std::set<size_t> m_sequenceIds;
 
@@ -6,6 +6,11 @@
 #define __STDC_FORMAT_MACROS
 #define _CRT_SECURE_NO_WARNINGS
 #include <inttypes.h>
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include "Indexer.h"
 
 using std::string;
@@ -14,7 +19,8 @@ const static char ROW_DELIMITER = '\n';
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
-Indexer::Indexer(FILE* file, bool primary, bool skipSequenceIds, char streamPrefix, size_t chunkSize, size_t bufferSize) :
+Indexer::Indexer(FILE* file, bool primary, bool skipSequenceIds, char streamPrefix, size_t chunkSize, size_t bufferSize,
+    const std::wstring& fileName, size_t numIndexingThreads) :
     m_streamPrefix(streamPrefix),
     m_bufferSize(bufferSize),
     m_file(file),
@@ -26,7 +32,10 @@ Indexer::Indexer(FILE* file, bool primary, bool skipSequenceIds, char streamPref
     m_pos(nullptr),
     m_done(false),
     m_hasSequenceIds(!skipSequenceIds),
-    m_index(chunkSize, primary)
+    m_index(chunkSize, primary),
+    m_fileName(fileName),
+    m_skipSequenceIds(skipSequenceIds),
+    m_numIndexingThreads(numIndexingThreads)
 {
     if (m_file == nullptr)
     {
@@ -34,6 +43,242 @@ Indexer::Indexer(FILE* file, bool primary, bool skipSequenceIds, char streamPref
     }
 }
 
+namespace {
+
+// Opens a file given a wide-character name in a cross-platform manner.
+FILE* OpenFile(const std::wstring& fileName, const wchar_t* mode)
+{
+#ifdef _WIN32
+    return _wfopen(fileName.c_str(), mode);
+#else
+    return fopen(msra::strfun::utf8(fileName).c_str(), msra::strfun::utf8(mode).c_str());
+#endif
+}
+
+// Retrieves the size and the last modification time of a file,
+// returns false when the file cannot be stat-ed.
+bool TryGetFileSizeAndTime(const std::wstring& fileName, uint64_t& size, int64_t& time)
+{
+#ifdef _WIN32
+    struct _stat64 fileStat;
+    if (_wstat64(fileName.c_str(), &fileStat) != 0)
+        return false;
+#else
+    struct stat fileStat;
+    if (stat(msra::strfun::utf8(fileName).c_str(), &fileStat) != 0)
+        return false;
+#endif
+    size = (uint64_t)fileStat.st_size;
+    time = (int64_t)fileStat.st_mtime;
+    return true;
+}
+
+// On-disk layout of the index cache sidecar file: a single header followed by
+// one record per sequence, in file order. All fields are naturally aligned.
+const uint64_t c_indexCacheMagic = 0x58444e494b544e43ull; // "CNTKINDX"
+const uint32_t c_indexCacheVersion = 1;
+
+struct IndexCacheHeader
+{
+    uint64_t m_magic;
+    uint32_t m_version;
+    uint32_t m_hasSequenceIds;
+    uint64_t m_fileSize;        // size of the indexed input file
+    int64_t m_fileTime;         // last modification time of the indexed input file
+    uint64_t m_maxChunkSize;
+    uint32_t m_primary;
+    uint32_t m_skipSequenceIds;
+    int64_t m_contentStart;     // file offset of the first sequence (0 or 3, skipping the BOM)
+    uint64_t m_numberOfSequences;
+};
+
+struct IndexCacheRecord
+{
+    uint64_t m_key;
+    uint32_t m_numberOfSamples;
+    uint32_t m_byteSize;
+};
+
+// What the parallel scan extracts per line group: a run of adjacent lines
+// sharing the same sequence id (or a single line, in line mode).
+struct RangeSequence
+{
+    bool m_hasKey;              // false when the range starts mid-sequence and the id is unknown
+    size_t m_numericKey;
+    std::string m_symbolicKey;
+    uint32_t m_numberOfSamples;
+    int64_t m_startOffset;
+    int64_t m_endOffset;
+};
+
+enum class ScanMode
+{
+    lines,          // one sequence per line, ids are line numbers
+    numericIds,     // lines start with a numeric sequence id
+    symbolicIds     // lines start with a symbolic sequence key
+};
+
+// Buffered forward reader over a private file handle,
+// used by the parallel indexing workers.
+class RangeReader
+{
+public:
+    RangeReader(FILE* file, int64_t startOffset, size_t bufferSize) :
+        m_file(file),
+        m_offset(startOffset),
+        m_fill(0),
+        m_pos(0),
+        m_capacity(bufferSize),
+        m_buffer(new char[bufferSize]),
+        m_eof(false)
+    {
+        if (_fseeki64(m_file, startOffset, SEEK_SET) != 0)
+            RuntimeError("Error seeking to the offset %" PRIi64 " in the input file.", startOffset);
+        Refill();
+    }
+
+    bool Eof() const { return m_eof; }
+
+    char Peek() const { return m_buffer[m_pos]; }
+
+    // Offset of the next unread character (the end-of-file offset once exhausted).
+    int64_t Offset() const { return m_offset + (int64_t)m_pos; }
+
+    void Advance()
+    {
+        if (++m_pos == m_fill)
+            Refill();
+    }
+
+    // Moves past the next row delimiter, returning the offset right after it
+    // (the end-of-file offset when no delimiter is left).
+    int64_t SkipLine()
+    {
+        while (!m_eof)
+        {
+            auto delimiter = (const char*)memchr(m_buffer.get() + m_pos, ROW_DELIMITER, m_fill - m_pos);
+            if (delimiter != nullptr)
+            {
+                m_pos = delimiter - m_buffer.get();
+                int64_t lineEnd = Offset() + 1;
+                Advance();
+                return lineEnd;
+            }
+
+            m_pos = m_fill;
+            Refill();
+        }
+        return Offset();
+    }
+
+private:
+    void Refill()
+    {
+        m_offset += m_fill;
+        m_fill = fread(m_buffer.get(), 1, m_capacity, m_file);
+        m_pos = 0;
+        if (m_fill == 0)
+        {
+            if (ferror(m_file))
+                RuntimeError("Could not read from the input file.");
+            m_eof = true;
+        }
+    }
+
+    FILE* m_file;
+    int64_t m_offset; // file offset corresponding to the start of the buffer
+    size_t m_fill;
+    size_t m_pos;
+    size_t m_capacity;
+    std::unique_ptr<char[]> m_buffer;
+    bool m_eof;
+};
+
+// Scans all lines that start inside [rangeBegin, rangeEnd), grouping adjacent lines
+// that belong to the same sequence. The last line may extend past rangeEnd and is read
+// to completion; the worker responsible for the next range skips it (alignToLine).
+// The first group carries no key when the range starts in the middle of a sequence,
+// the merge step folds it into the last sequence of the previous range.
+std::vector<RangeSequence> ScanRange(const std::wstring& fileName, int64_t rangeBegin, int64_t rangeEnd,
+    bool alignToLine, ScanMode mode, size_t bufferSize)
+{
+    std::unique_ptr<FILE, int(*)(FILE*)> file(OpenFile(fileName, L"rbS"), fclose);
+    if (file == nullptr)
+        RuntimeError("Could not open the input file for indexing.");
+
+    RangeReader reader(file.get(), alignToLine ? rangeBegin - 1 : rangeBegin, bufferSize);
+    int64_t lineStart = alignToLine ? reader.SkipLine() : rangeBegin;
+
+    std::vector<RangeSequence> result;
+    RangeSequence current{};
+    bool open = false;
+    while (lineStart < rangeEnd && !reader.Eof())
+    {
+        // Read the sequence id at the beginning of the line, same rules as
+        // TryGetNumericSequenceId/TryGetSymbolicSequenceId: a line without an id
+        // (or a trailing line cut short by EOF) continues the current sequence.
+        bool found = false;
+        size_t numericKey = 0;
+        std::string symbolicKey;
+        if (mode == ScanMode::numericIds)
+        {
+            while (!reader.Eof() && isdigit((unsigned char)reader.Peek()))
+            {
+                numericKey = numericKey * 10 + (reader.Peek() - '0');
+                found = true;
+                reader.Advance();
+            }
+            if (reader.Eof())
+                found = false;
+        }
+        else if (mode == ScanMode::symbolicIds)
+        {
+            while (!reader.Eof() && !isspace((unsigned char)reader.Peek()))
+            {
+                symbolicKey += reader.Peek();
+                found = true;
+                reader.Advance();
+            }
+            if (reader.Eof())
+                found = false;
+        }
+
+        int64_t lineEnd = reader.SkipLine();
+
+        if (mode == ScanMode::lines)
+        {
+            // Each line is an individual sequence.
+            result.push_back(RangeSequence{ false, 0, std::string(), 1, lineStart, lineEnd });
+        }
+        else
+        {
+            bool sameAsCurrent = current.m_hasKey && found &&
+                (mode == ScanMode::numericIds ? numericKey == current.m_numericKey : symbolicKey == current.m_symbolicKey);
+            if (open && (sameAsCurrent || !found))
+            {
+                current.m_numberOfSamples++;
+                current.m_endOffset = lineEnd;
+            }
+            else
+            {
+                if (open)
+                    result.push_back(current);
+                current = RangeSequence{ found, numericKey, symbolicKey, 1, lineStart, lineEnd };
+                open = true;
+            }
+        }
+
+        lineStart = lineEnd;
+    }
+
+    if (open)
+        result.push_back(current);
+
+    return result;
+}
+
+} // namespace
+
 void Indexer::RefillBuffer()
 {
     if (!m_done)
@@ -94,6 +339,12 @@ void Indexer::Build(CorpusDescriptorPtr corpus)
         return;
     }
 
+    // A previously persisted index makes the scan unnecessary.
+    if (TryLoadFromCache(corpus))
+    {
+        return;
+    }
+
     // Create a lambda to read symbolic or numeric sequence ids,
     // depending on what the corpus expects.
     std::function<bool(size_t&)> tryGetSequenceId;
@@ -102,7 +353,8 @@ void Indexer::Build(CorpusDescriptorPtr corpus)
     else
         tryGetSequenceId = [this, corpus](size_t& id) { return TryGetSymbolicSequenceId(id, corpus->KeyToId); };
 
-    m_index.Reserve(filesize(m_file));
+    int64_t fileSize = (int64_t)filesize(m_file);
+    m_index.Reserve(fileSize);
 
     RefillBuffer(); // read the first block of data
     if (m_done)
@@ -110,6 +362,7 @@ void Indexer::Build(CorpusDescriptorPtr corpus)
         RuntimeError("Input file is empty");
     }
 
+    int64_t contentStart = 0;
     if ((m_bufferEnd - m_bufferStart > 3) &&
         (m_bufferStart[0] == '\xEF' && m_bufferStart[1] == '\xBB' && m_bufferStart[2] == '\xBF'))
     {
@@ -117,18 +370,43 @@ void Indexer::Build(CorpusDescriptorPtr corpus)
         m_pos += 3;
         m_fileOffsetStart += 3;
         m_bufferStart += 3;
+        contentStart = 3;
     }
 
     // check the first byte and decide what to do next
-    if (!m_hasSequenceIds || m_bufferStart[0] == m_streamPrefix)
+    bool lineMode = !m_hasSequenceIds || m_bufferStart[0] == m_streamPrefix;
+    if (lineMode)
     {
         // Skip sequence id parsing, treat lines as individual sequences
         // In this case the sequences do not have ids, they are assigned a line number.
         // If corpus expects to have sequence ids as symbolic names we throw.
         if (!corpus->IsNumericSequenceKeys())
             RuntimeError("Corpus expects non-numeric sequence keys but the CTF input file does not have them.");
+    }
 
+    // Decide on the number of scan ranges: parallel indexing needs the file name
+    // (each worker opens a private handle) and only pays off on large inputs.
+    size_t numRanges = 1;
+    if (!m_fileName.empty())
+    {
+        const int64_t minBytesPerRange = 32 * 1024 * 1024;
+        size_t maxThreads = m_numIndexingThreads != 0 ? m_numIndexingThreads : std::thread::hardware_concurrency();
+        numRanges = (size_t)std::min<int64_t>(
+            (int64_t)std::max<size_t>(maxThreads, 1),
+            std::max<int64_t>((fileSize - contentStart) / minBytesPerRange, 1));
+    }
+
+    if (numRanges > 1)
+    {
+        BuildParallel(corpus, lineMode, contentStart, fileSize, numRanges);
+        WriteCache(corpus);
+        return;
+    }
+
+    if (lineMode)
+    {
         BuildFromLines();
+        WriteCache(corpus);
         return;
     }
 
@@ -162,6 +440,224 @@ void Indexer::Build(CorpusDescriptorPtr corpus)
     }
 
     m_index.AddSequence(SequenceDescriptor{ KeyType{ previousId, 0 }, numberOfSamples }, sequenceOffset, m_fileOffsetEnd);
+
+    WriteCache(corpus);
+}
+
+void Indexer::BuildParallel(CorpusDescriptorPtr corpus, bool lineMode, int64_t contentStart, int64_t fileSize, size_t numRanges)
+{
+    ScanMode mode = lineMode ? ScanMode::lines :
+        (corpus->IsNumericSequenceKeys() ? ScanMode::numericIds : ScanMode::symbolicIds);
+
+    if (lineMode)
+        m_hasSequenceIds = false;
+
+    // Scan disjoint file ranges concurrently, each worker on a private file handle.
+    int64_t rangeSize = (fileSize - contentStart + numRanges - 1) / numRanges;
+    std::vector<std::future<std::vector<RangeSequence>>> scans;
+    for (size_t i = 0; i < numRanges; ++i)
+    {
+        int64_t rangeBegin = contentStart + i * rangeSize;
+        int64_t rangeEnd = std::min<int64_t>(rangeBegin + rangeSize, fileSize);
+        std::wstring fileName = m_fileName;
+        size_t bufferSize = m_bufferSize;
+        bool alignToLine = (i != 0); // the first range starts right at the content, no need to align
+        scans.push_back(std::async(std::launch::async,
+            [fileName, rangeBegin, rangeEnd, alignToLine, mode, bufferSize]()
+            {
+                return ScanRange(fileName, rangeBegin, rangeEnd, alignToLine, mode, bufferSize);
+            }));
+    }
+
+    size_t lineNumber = 0;
+    auto addSequence = [this, corpus, mode, &lineNumber](const RangeSequence& group)
+    {
+        size_t id;
+        if (mode == ScanMode::lines)
+            id = lineNumber++;
+        else if (mode == ScanMode::numericIds)
+            id = group.m_numericKey;
+        else
+            id = corpus->KeyToId(group.m_symbolicKey); // registers symbolic keys in file order
+        m_index.AddSequence(SequenceDescriptor{ KeyType{ id, 0 }, group.m_numberOfSamples },
+            group.m_startOffset, group.m_endOffset);
+    };
+
+    // Merge the per-range results in file order. The first group of a range may be
+    // the continuation of the last sequence of the previous range, fold it in then.
+    RangeSequence current{};
+    bool open = false;
+    for (size_t i = 0; i < numRanges; ++i)
+    {
+        auto groups = scans[i].get();
+        for (size_t j = 0; j < groups.size(); ++j)
+        {
+            auto& group = groups[j];
+            if (!open)
+            {
+                if (mode != ScanMode::lines && !group.m_hasKey)
+                    RuntimeError("Expected a sequence id at the offset %" PRIi64 ", none was found.", group.m_startOffset);
+                current = std::move(group);
+                open = true;
+                continue;
+            }
+
+            bool continuesCurrent = j == 0 && mode != ScanMode::lines &&
+                (!group.m_hasKey ||
+                 (current.m_hasKey &&
+                  (mode == ScanMode::numericIds
+                       ? group.m_numericKey == current.m_numericKey
+                       : group.m_symbolicKey == current.m_symbolicKey)));
+            if (continuesCurrent)
+            {
+                current.m_numberOfSamples += group.m_numberOfSamples;
+                current.m_endOffset = group.m_endOffset;
+            }
+            else
+            {
+                addSequence(current);
+                current = std::move(group);
+            }
+        }
+    }
+
+    if (open)
+        addSequence(current);
+}
+
+bool Indexer::TryLoadFromCache(CorpusDescriptorPtr corpus)
+{
+    // The cache stores numeric sequence keys only: symbolic keys have to be pushed
+    // through the corpus registry in file order and cannot be replayed from the sidecar.
+    if (m_fileName.empty() || !corpus->IsNumericSequenceKeys())
+        return false;
+
+    uint64_t fileSize = 0;
+    int64_t fileTime = 0;
+    if (!TryGetFileSizeAndTime(m_fileName, fileSize, fileTime))
+        return false;
+
+    std::unique_ptr<FILE, int(*)(FILE*)> cache(OpenFile(m_fileName + L".index.cache", L"rbS"), fclose);
+    if (cache == nullptr)
+        return false;
+
+    IndexCacheHeader header;
+    if (fread(&header, sizeof(header), 1, cache.get()) != 1 ||
+        header.m_magic != c_indexCacheMagic ||
+        header.m_version != c_indexCacheVersion ||
+        header.m_fileSize != fileSize ||
+        header.m_fileTime != fileTime ||
+        header.m_maxChunkSize != (uint64_t)m_index.m_maxChunkSize ||
+        header.m_primary != (m_index.m_primary ? 1u : 0u) ||
+        header.m_skipSequenceIds != (m_skipSequenceIds ? 1u : 0u) ||
+        header.m_numberOfSequences == 0)
+    {
+        return false;
+    }
+
+    m_index.Reserve(fileSize);
+
+    // Replay the sequence records through AddSequence: given the same chunk size,
+    // this deterministically rebuilds the chunking the original scan produced.
+    std::vector<IndexCacheRecord> records(4096);
+    uint64_t remaining = header.m_numberOfSequences;
+    int64_t offset = header.m_contentStart;
+    while (remaining > 0)
+    {
+        size_t count = (size_t)std::min<uint64_t>(remaining, records.size());
+        if (fread(records.data(), sizeof(IndexCacheRecord), count, cache.get()) != count)
+        {
+            // Truncated or corrupt cache, fall back to a full scan.
+            m_index.m_chunks.clear();
+            m_index.m_keyToSequenceInChunk.clear();
+            return false;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto& record = records[i];
+            m_index.AddSequence(SequenceDescriptor{ KeyType{ record.m_key, 0 }, record.m_numberOfSamples },
+                offset, offset + record.m_byteSize);
+            offset += record.m_byteSize;
+        }
+
+        remaining -= count;
+    }
+
+    m_hasSequenceIds = header.m_hasSequenceIds != 0;
+    return true;
+}
+
+void Indexer::WriteCache(CorpusDescriptorPtr corpus)
+{
+    // Mirrors the restriction in TryLoadFromCache. Any failure below is ignored,
+    // the next run simply scans the input again.
+    if (m_fileName.empty() || !corpus->IsNumericSequenceKeys())
+        return;
+
+    uint64_t fileSize = 0;
+    int64_t fileTime = 0;
+    if (!TryGetFileSizeAndTime(m_fileName, fileSize, fileTime))
+        return;
+
+    uint64_t numberOfSequences = 0;
+    for (const auto& chunk : m_index.m_chunks)
+        numberOfSequences += chunk.m_sequences.size();
+    if (numberOfSequences == 0)
+        return;
+
+    std::wstring cacheName = m_fileName + L".index.cache";
+    std::unique_ptr<FILE, int(*)(FILE*)> cache(OpenFile(cacheName, L"wb"), fclose);
+    if (cache == nullptr) // e.g. the corpus directory is read-only
+        return;
+
+    IndexCacheHeader header;
+    header.m_magic = c_indexCacheMagic;
+    header.m_version = c_indexCacheVersion;
+    header.m_hasSequenceIds = m_hasSequenceIds ? 1u : 0u;
+    header.m_fileSize = fileSize;
+    header.m_fileTime = fileTime;
+    header.m_maxChunkSize = m_index.m_maxChunkSize;
+    header.m_primary = m_index.m_primary ? 1u : 0u;
+    header.m_skipSequenceIds = m_skipSequenceIds ? 1u : 0u;
+    // The first chunk always starts at offset 0, so the offset of its first
+    // sequence within the chunk is also the content start in the file.
+    header.m_contentStart = m_index.m_chunks.front().m_offset +
+        m_index.m_chunks.front().m_sequences.front().OffsetInChunk();
+    header.m_numberOfSequences = numberOfSequences;
+
+    bool ok = fwrite(&header, sizeof(header), 1, cache.get()) == 1;
+
+    std::vector<IndexCacheRecord> records;
+    records.reserve(4096);
+    auto flush = [&records, &cache, &ok]()
+    {
+        if (ok && !records.empty())
+            ok = fwrite(records.data(), sizeof(IndexCacheRecord), records.size(), cache.get()) == records.size();
+        records.clear();
+    };
+
+    for (const auto& chunk : m_index.m_chunks)
+    {
+        for (const auto& sequence : chunk.m_sequences)
+        {
+            records.push_back(IndexCacheRecord{ sequence.m_key.m_sequence, sequence.m_numberOfSamples, sequence.SizeInBytes() });
+            if (records.size() == records.capacity())
+                flush();
+        }
+    }
+    flush();
+
+    if (!ok)
+    {
+        // Do not leave a partially written cache behind.
+        cache.reset();
+#ifdef _WIN32
+        _wremove(cacheName.c_str());
+#else
+        remove(msra::strfun::utf8(cacheName).c_str());
+#endif
+    }
 }
 
 void Indexer::SkipLine()
@@ -133,7 +133,12 @@ struct Index
 class Indexer
 {
 public:
-    Indexer(FILE* file, bool isPrimary, bool skipSequenceIds = false, char streamPrefix = '|', size_t chunkSize = 32 * 1024 * 1024, size_t bufferSize = 2 * 1024 * 1024);
+    // When a non-empty fileName is given, the indexer can scan the input with multiple
+    // threads over separate file handles (numIndexingThreads, 0 - one per hardware thread)
+    // and persists the built index to a '<fileName>.index.cache' sidecar file keyed by the
+    // input size and modification time, so subsequent runs skip the scan entirely.
+    Indexer(FILE* file, bool isPrimary, bool skipSequenceIds = false, char streamPrefix = '|', size_t chunkSize = 32 * 1024 * 1024, size_t bufferSize = 2 * 1024 * 1024,
+            const std::wstring& fileName = L"", size_t numIndexingThreads = 0);
 
     // Reads the input file, building and index of chunks and corresponding
     // sequences.
@@ -189,10 +194,31 @@ private:
 
 
     // Build a chunk/sequence index, treating each line as an individual sequence.
-    // Does not do any sequence parsing, instead uses line number as 
+    // Does not do any sequence parsing, instead uses line number as
     // the corresponding sequence id.
     void BuildFromLines();
 
+    // Builds the index by scanning disjoint file ranges on multiple threads over
+    // separate file handles and merging the per-range results in file order.
+    void BuildParallel(CorpusDescriptorPtr corpus, bool lineMode, int64_t contentStart, int64_t fileSize, size_t numRanges);
+
+    // Tries to load a previously persisted index from the sidecar file.
+    // Returns false when there is no usable cache (missing, stale or corrupt).
+    bool TryLoadFromCache(CorpusDescriptorPtr corpus);
+
+    // Persists the built index to the sidecar file. Failures are ignored,
+    // the cache is strictly an optimization.
+    void WriteCache(CorpusDescriptorPtr corpus);
+
+    // Input file name (optional, enables parallel indexing and the index cache).
+    const std::wstring m_fileName;
+
+    // Value of the skipSequenceIds constructor argument, stored for cache validation.
+    const bool m_skipSequenceIds;
+
+    // Number of indexing threads, 0 - one per hardware thread.
+    const size_t m_numIndexingThreads;
+
     // Returns current offset in the input file (in bytes). 
     int64_t GetFileOffset() const { return m_fileOffsetStart + (m_pos - m_bufferStart); }
 
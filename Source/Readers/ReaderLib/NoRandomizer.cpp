@@ -12,7 +12,7 @@
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
-    NoRandomizer::NoRandomizer(IDataDeserializerPtr deserializer, bool multithreadedGetNextSequences, size_t maxNumberOfInvalidSequences)
+    NoRandomizer::NoRandomizer(IDataDeserializerPtr deserializer, bool multithreadedGetNextSequences, size_t maxNumberOfInvalidSequences, size_t deserializationThreadCount)
     : m_deserializer(deserializer),
       m_currentChunkPosition(CHUNKID_MAX),
       m_globalSamplePosition(0),
@@ -20,6 +20,7 @@ namespace Microsoft { namespace MSR { namespace CNTK {
       m_sweepSizeInSamples(0),
       m_currentSequencePositionInChunk(0),
       m_multithreadedGetNextSequences(multithreadedGetNextSequences),
+      m_deserializationThreadCount(deserializationThreadCount),
       m_cleaner(maxNumberOfInvalidSequences)
 {
     assert(deserializer != nullptr);
@@ -227,9 +228,18 @@ Sequences NoRandomizer::GetNextSequences(size_t globalSampleCount, size_t localS
     if (m_multithreadedGetNextSequences)
     {
         ExceptionCapture capture;
+        if (m_deserializationThreadCount != 0)
+        {
+#pragma omp parallel for schedule(dynamic) num_threads((int)m_deserializationThreadCount)
+            for (int i = 0; i < m_sequenceBuffer.size(); ++i)
+                capture.SafeRun(process, i);
+        }
+        else
+        {
 #pragma omp parallel for schedule(dynamic)
-        for (int i = 0; i < m_sequenceBuffer.size(); ++i)
-            capture.SafeRun(process, i);
+            for (int i = 0; i < m_sequenceBuffer.size(); ++i)
+                capture.SafeRun(process, i);
+        }
         capture.RethrowIfHappened();
     }
     else
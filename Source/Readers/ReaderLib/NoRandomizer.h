@@ -20,9 +20,10 @@ class NoRandomizer : public SequenceEnumerator
 {
 public:
     NoRandomizer(
-        IDataDeserializerPtr deserializer, 
+        IDataDeserializerPtr deserializer,
         bool multithreadedGetNextSequences = false,
-        size_t maxNumberOfInvalidSequences = 0); // per worker
+        size_t maxNumberOfInvalidSequences = 0, // per worker
+        size_t deserializationThreadCount = 0); // 0 - use the OpenMP default number of threads
 
     virtual void StartEpoch(const EpochConfiguration& config) override;
     virtual Sequences GetNextSequences(size_t globalSampleCount, size_t localSampleCount) override;
@@ -52,6 +53,9 @@ private:
     // Useful in case deserializer performs CPU intensive deserialization (e.g. decompression)
     bool m_multithreadedGetNextSequences;
 
+    // Number of threads used for multithreaded sequence deserialization, 0 - the OpenMP default.
+    size_t m_deserializationThreadCount;
+
     // Stream descriptions
     std::vector<StreamDescriptionPtr> m_streams;
 
@@ -51,6 +51,12 @@ protected:
     void PackSparseSampleAsDense(char* destination, SparseSequenceDataPtr sequence,
         size_t sampleIndex, size_t sampleOffset, size_t sampleSize, size_t elementSize);
 
+    // Scatters the non-zero values of a sparse sample into a destination block
+    // that has already been zeroed out (e.g. with a single memset covering the
+    // whole minibatch buffer). Same parameters as PackSparseSampleAsDense.
+    void ScatterSparseSample(char* destination, SparseSequenceDataPtr sequence,
+        size_t sampleIndex, size_t sampleOffset, size_t sampleSize, size_t elementSize);
+
     // Packs a dense sample as dense. Copies sampleSize bytes staring at the sampleOffset from 
     // the data portion of the source sequence to the destination block of memory. sampleOffset 
     // specifies the offset of the first value from the given sample in the sequence data/ array 
@@ -104,6 +110,13 @@ inline void PackerBase::PackSparseSampleAsDense(char* destination, SparseSequenc
 {
     //The sample is sparse, first, need to zero out the buffer.
     memset(destination, 0, sampleSize);
+    ScatterSparseSample(destination, sequence, sampleIndex, sampleOffset, sampleSize, elementSize);
+}
+
+inline void PackerBase::ScatterSparseSample(char* destination, SparseSequenceDataPtr sequence,
+    size_t sampleIndex, size_t sampleOffset, size_t sampleSize, size_t elementSize)
+{
+    UNUSED(sampleSize);
     // Get the nnz count of the sample.
     size_t nonZeroCount = sequence->m_nnzCounts[sampleIndex];
     // In a sparse sequence, m_data points to the array of non zero elements,
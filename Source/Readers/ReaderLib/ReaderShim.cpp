@@ -25,8 +25,11 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 template <class ElemType>
 ReaderShim<ElemType>::ReaderShim() :
     m_deviceId(CPUDEVICE),
-    m_dataTransferers(2, DataTransfererPtr()),
-    m_currentDataTransferIndex(0),
+    m_prefetchDepth(1),
+    m_slotToFill(0),
+    m_slotToConsume(0),
+    m_numFilledSlots(0),
+    m_stopPrefetch(false),
     m_endOfEpoch(false),
     m_endOfSweep(false),
     m_currentSamplePosition(0),
@@ -60,6 +63,13 @@ void ReaderShim<ElemType>::Init(const ConfigParameters& config)
     // otherwise deferring - synchronous execution during .get() call
     m_launchType = prefetch ? launch::async : launch::deferred;
 
+    // Number of minibatches the prefetch loop is allowed to run ahead of the network.
+    // A depth > 1 lets the pipeline absorb reader latency spikes (e.g. network file systems)
+    // at the cost of one set of staging buffers per additional slot.
+    m_prefetchDepth = config(L"prefetchDepth", (size_t)1);
+    if (m_prefetchDepth < 1)
+        InvalidArgument("prefetchDepth must be at least 1.");
+
     m_numParallelSequences = numberOfuttsPerMinibatchForAllEpochs[0];
 
     if (!m_reader)
@@ -100,14 +110,8 @@ void ReaderShim<ElemType>::StartDistributedMinibatchLoop(
 template <class ElemType>
 void ReaderShim<ElemType>::SetCurrentSamplePosition(size_t currentSamplePosition)
 {
-    // Make sure there are no outstanding reads.
-    if (m_prefetchTask.valid())
-        m_prefetchTask.wait();
-
-    // Let's check that there is no outstanding copies.
-    // Wait on all events if there are any pending copy operations in flight.
-    if (m_dataTransferers[m_currentDataTransferIndex])
-        m_dataTransferers[m_currentDataTransferIndex]->WaitForCopyCPUToGPU();
+    // Make sure there are no outstanding reads or copies.
+    StopPrefetchLoop();
 
     // Set current position.
     m_reader->SetCurrentSamplePosition(currentSamplePosition);
@@ -118,43 +122,23 @@ void ReaderShim<ElemType>::SetCurrentSamplePosition(size_t currentSamplePosition
 template <class ElemType>
 void ReaderShim<ElemType>::SetConfiguration(const ReaderConfiguration& config, const std::map<std::wstring, int>& inputDescriptions)
 {
-    // Make sure there are no outstanding reads.
-    if (m_prefetchTask.valid())
-        m_prefetchTask.wait();
-
-    // Let's check that there is no outstanding copies.
-    // Wait on all events if there are any pending copy operations in flight.
-    if (m_dataTransferers[m_currentDataTransferIndex])
-        m_dataTransferers[m_currentDataTransferIndex]->WaitForCopyCPUToGPU();
+    // Make sure there are no outstanding reads or copies.
+    StopPrefetchLoop();
 
     m_reader->SetConfiguration(config, inputDescriptions);
     m_reader->SetCurrentSamplePosition(m_currentSamplePosition);
 
-    // Start prefetch.
-    auto localCurrentDataTransferIndex = m_currentDataTransferIndex;
-    // Starting the prefetch task. There is always a single async read in flight.
-    // When the network requests a new minibatch, we wait for the current async to finish, swap the buffers
-    // and kick off the new prefetch.
-    m_prefetchTask = std::async(m_launchType,
-        [this, localCurrentDataTransferIndex]()
-    {
-        return PrefetchMinibatch(localCurrentDataTransferIndex);
-    });
+    // Restart the prefetch loop. It keeps up to queue-depth async reads in flight.
+    // When the network requests a new minibatch, we wait for the oldest slot to be filled,
+    // swap the buffers and hand the slot back for refilling.
+    StartPrefetchLoop();
 }
 
 template <class ElemType>
 void ReaderShim<ElemType>::StartEpoch(const EpochConfiguration& config, const std::unordered_set<InputStreamDescription>& inputs)
 {
-    // For adaptive minibatch, make sure there are no outstanding reads.
-    if (m_prefetchTask.valid())
-    {
-        m_prefetchTask.wait();
-    }
-
-    // Let's check that there is no outstanding copies.
-    // Wait on all events if there are any pending copy operations in flight.
-    if (m_dataTransferers[m_currentDataTransferIndex])
-        m_dataTransferers[m_currentDataTransferIndex]->WaitForCopyCPUToGPU();
+    // For adaptive minibatch, make sure there are no outstanding reads or copies.
+    StopPrefetchLoop();
 
     // Now we can be sure, no prefetch thread is running and there are no outstanding memcopies.
     // Let's check that requested devices are ok and see whether we need to change our data transferers.
@@ -170,42 +154,140 @@ void ReaderShim<ElemType>::StartEpoch(const EpochConfiguration& config, const st
         LogicError("Readers do not support running on several GPUs in the same process, at least two devices found '%d', '%d'", deviceId, secondDevice->GetDeviceId());
     }
 
-    if (m_deviceId != deviceId)
+    if (m_deviceId != deviceId || m_prefetchSlots.size() != m_prefetchDepth)
     {
-        // Device changed. Let's change the data transferers.
+        // Device or queue depth changed. Let's recreate the slots with their data transferers.
         m_deviceId = deviceId;
-        m_dataTransferers.clear();
-        // We need two in order to support two operations in flight.
-        m_dataTransferers.push_back(m_deviceId == CPUDEVICE ? nullptr : CreatePrefetchDataTransferer(m_deviceId));
-        m_dataTransferers.push_back(m_deviceId == CPUDEVICE ? nullptr : CreatePrefetchDataTransferer(m_deviceId));
+        m_prefetchSlots.clear();
+        m_prefetchSlots.resize(m_prefetchDepth);
+        // Each slot needs its own transferer in order to support queue-depth operations in flight.
+        for (auto& slot : m_prefetchSlots)
+            slot.m_dataTransferer = m_deviceId == CPUDEVICE ? nullptr : CreatePrefetchDataTransferer(m_deviceId);
     }
 
-    // Let's create the buffers for the prefetch thread.
+    // Let's create the buffers for the prefetch thread, one set per slot.
     std::map<std::wstring, int> inputDescriptions;
     for (const auto& i : inputs)
     {
         inputDescriptions[i.GetStreamName()] = i.GetDeviceId();
         // Creating buffers with the same properties the network expects.
-        m_prefetchBuffers[i.GetStreamName()] = StreamPrefetchBuffer
+        for (auto& slot : m_prefetchSlots)
         {
-            std::make_shared<Matrix<ElemType>>(0, 0, i.GetDeviceId(), i.GetMatrixType(), i.GetMatrixFormat()),
-            std::make_shared<MBLayout>()
-        };
+            slot.m_buffers[i.GetStreamName()] = StreamPrefetchBuffer
+            {
+                std::make_shared<Matrix<ElemType>>(0, 0, i.GetDeviceId(), i.GetMatrixType(), i.GetMatrixFormat()),
+                std::make_shared<MBLayout>()
+            };
+        }
     }
 
     m_endOfEpoch = false;
     m_reader->StartEpoch(config, inputDescriptions);
     m_currentSamplePosition = m_reader->GetCurrentSamplePosition();
 
-    auto localCurrentDataTransferIndex = m_currentDataTransferIndex;
-    // Starting the prefetch task. There is always a single async read in flight.
-    // When the network requests a new minibatch, we wait for the current async to finish, swap the buffers
-    // and kick off the new prefetch.
-    m_prefetchTask = std::async(m_launchType,
-    [this, localCurrentDataTransferIndex]()
+    // Starting the prefetch loop. It keeps up to queue-depth async reads in flight.
+    // When the network requests a new minibatch, we wait for the oldest slot to be filled,
+    // swap the buffers and hand the slot back for refilling.
+    StartPrefetchLoop();
+}
+
+template <class ElemType>
+void ReaderShim<ElemType>::StartPrefetchLoop()
+{
+    // No loop is running at this point, so the state can be reset without taking the lock.
+    m_slotToFill = 0;
+    m_slotToConsume = 0;
+    m_numFilledSlots = 0;
+    m_stopPrefetch = false;
+    m_prefetchException = nullptr;
+
+    // In deferred mode (prefetch disabled) the reads happen synchronously
+    // on the main thread in GetMinibatch instead.
+    if (m_launchType == launch::async)
+        m_prefetchLoop = std::async(std::launch::async, [this]() { PrefetchLoop(); });
+}
+
+template <class ElemType>
+void ReaderShim<ElemType>::StopPrefetchLoop()
+{
+    if (m_prefetchLoop.valid())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_slotMutex);
+            m_stopPrefetch = true;
+        }
+        m_slotFreed.notify_all();
+        m_prefetchLoop.wait();
+        m_prefetchLoop = std::future<void>();
+    }
+
+    // The loop is not running anymore. Wait on all events if there are any pending
+    // copy operations in flight for slots that were filled but never consumed.
+    if (!m_prefetchException)
     {
-        return PrefetchMinibatch(localCurrentDataTransferIndex);
-    });
+        for (; m_numFilledSlots > 0; m_numFilledSlots--)
+        {
+            auto& slot = m_prefetchSlots[m_slotToConsume];
+            if (slot.m_dataTransferer && slot.m_result.m_isDataAvailable)
+                slot.m_dataTransferer->WaitForCopyCPUToGPU();
+            m_slotToConsume = (m_slotToConsume + 1) % m_prefetchSlots.size();
+        }
+    }
+    m_numFilledSlots = 0; // (can be non-zero here only after a failed prefetch)
+}
+
+template <class ElemType>
+void ReaderShim<ElemType>::PrefetchLoop()
+{
+    try
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_slotMutex);
+                m_slotFreed.wait(lock, [this]() { return m_stopPrefetch || m_numFilledSlots < m_prefetchSlots.size(); });
+                if (m_stopPrefetch)
+                    return;
+            }
+
+            bool endOfEpochReached = FillNextSlot();
+            m_slotFilled.notify_one();
+
+            // The epoch is exhausted; the loop is restarted by the next StartEpoch().
+            if (endOfEpochReached)
+                return;
+        }
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_slotMutex);
+            m_prefetchException = std::current_exception();
+            // Bump the fill count so that a waiting consumer wakes up and rethrows.
+            m_numFilledSlots++;
+        }
+        m_slotFilled.notify_one();
+    }
+}
+
+// Reads the next minibatch into the next free slot and publishes it to the consumer.
+template <class ElemType>
+bool ReaderShim<ElemType>::FillNextSlot()
+{
+    auto& slot = m_prefetchSlots[m_slotToFill];
+    slot.m_result = PrefetchMinibatch(slot);
+
+    // The reader runs ahead of the main thread, so remember the global sample position
+    // as of this minibatch; the consumer publishes it when the slot is consumed.
+    slot.m_samplePosition = m_reader->GetCurrentSamplePosition();
+
+    m_slotToFill = (m_slotToFill + 1) % m_prefetchSlots.size();
+    {
+        std::lock_guard<std::mutex> lock(m_slotMutex);
+        m_numFilledSlots++;
+    }
+
+    return slot.m_result.m_isEndOfEpoch;
 }
 
 string EnumerateInputs(const unordered_map<wstring, size_t>& nameToStreamId)
@@ -255,14 +337,25 @@ bool ReaderShim<ElemType>::GetMinibatch(StreamMinibatchInputs& matrices)
         }
     }
 
-    // Make sure the prefetch has finished.
-    assert(m_prefetchTask.valid());
-    auto result = m_prefetchTask.get();
+    // When prefetch is disabled we read synchronously on the main thread right here.
+    if (m_launchType == launch::deferred && m_numFilledSlots == 0)
+        FillNextSlot();
+
+    // Make sure the oldest prefetch has finished.
+    {
+        std::unique_lock<std::mutex> lock(m_slotMutex);
+        m_slotFilled.wait(lock, [this]() { return m_numFilledSlots > 0; });
+        if (m_prefetchException)
+            std::rethrow_exception(m_prefetchException);
+    }
 
     // Ok, prefetch is done.
+    auto& slot = m_prefetchSlots[m_slotToConsume];
+    auto result = slot.m_result;
 
-    // Let's update our sample position.
-    m_currentSamplePosition = m_reader->GetCurrentSamplePosition();
+    // Let's update our sample position. The prefetch loop may already have read further
+    // ahead, so use the position remembered when this slot's minibatch was read.
+    m_currentSamplePosition = slot.m_samplePosition;
 
     m_endOfEpoch = result.m_isEndOfEpoch;
     m_endOfSweep = result.m_isEndOfSweep;
@@ -272,23 +365,18 @@ bool ReaderShim<ElemType>::GetMinibatch(StreamMinibatchInputs& matrices)
         return false;
     }
 
-    // Remember current data transfer, async memcpy for it already started on the prefetch thread.
-    auto currentDataTransferIndex = m_currentDataTransferIndex;
-
-    matrices.m_getKeyById = m_getKeyById;
+    matrices.m_getKeyById = slot.m_getKeyById;
 
-    // Let's update the current data transferer.
-    m_currentDataTransferIndex = (m_currentDataTransferIndex + 1) % 2;
-
-    // Record an event that prefetch can wait on to ensure that prior compute has finished.
-    if (m_dataTransferers[m_currentDataTransferIndex])
-        m_dataTransferers[m_currentDataTransferIndex]->RecordComputeStreamSyncPoint();
+    // Let's wait till the memcopy into this slot has finished,
+    // the network is about to compute on these matrices.
+    if (slot.m_dataTransferer)
+        slot.m_dataTransferer->WaitForCopyCPUToGPU();
 
     // We have some data - let's swap the matrices.
     // We cannot simply change pointers because it seems they are remembered deeper in the network.
     for (auto i = matrices.begin(); i != matrices.end(); ++i)
     {
-        std::swap(i->second.GetMatrix<ElemType>(), *m_prefetchBuffers[i->first].m_matrix);
+        std::swap(i->second.GetMatrix<ElemType>(), *slot.m_buffers[i->first].m_matrix);
 
         // Resetting layouts.
         i->second.pMBLayout->Init(1, 0);
@@ -300,7 +388,7 @@ bool ReaderShim<ElemType>::GetMinibatch(StreamMinibatchInputs& matrices)
     // Let's now check the layouts and throw if the same layout is being assigned twice.
     for (auto i = matrices.begin(); i != matrices.end(); ++i)
     {
-        auto streamLayout = m_prefetchBuffers[i->first].m_mbLayout;
+        auto streamLayout = slot.m_buffers[i->first].m_mbLayout;
         auto& layout = i->second.pMBLayout;
         if (layout->GetNumCols() == 0) // just initialized, let's take the layout of the reader.
         {
@@ -321,30 +409,30 @@ bool ReaderShim<ElemType>::GetMinibatch(StreamMinibatchInputs& matrices)
     // So pick up the first one.
     m_numParallelSequences = matrices.begin()->second.pMBLayout->GetNumParallelSequences();
 
-    // It is time to issue the next prefetch.
-    if (!m_endOfEpoch)
+    // The matrices we just swapped out of the network were last touched by the previous
+    // minibatch's compute. Record an event the refill of this slot can wait on
+    // to ensure that compute has finished before the buffers are overwritten.
+    if (slot.m_dataTransferer)
+        slot.m_dataTransferer->RecordComputeStreamSyncPoint();
+
+    // Hand the slot back to the prefetch loop for refilling.
     {
-        // Starting the prefetch task. There is always a single async read in flight.
-        // When the network requests a new minibatch, we wait for the current async to finish, swap the buffers
-        // and kick off the new prefetch.
-        auto localCurrentDataTransferIndex = m_currentDataTransferIndex;
-        m_prefetchTask = std::async(m_launchType, [this, localCurrentDataTransferIndex]() { return PrefetchMinibatch(localCurrentDataTransferIndex); });
+        std::lock_guard<std::mutex> lock(m_slotMutex);
+        m_numFilledSlots--;
     }
-
-    // Let's wait till the previous memcopy has finished.
-    if (m_dataTransferers[currentDataTransferIndex])
-        m_dataTransferers[currentDataTransferIndex]->WaitForCopyCPUToGPU();
+    m_slotToConsume = (m_slotToConsume + 1) % m_prefetchSlots.size();
+    m_slotFreed.notify_one();
 
     return result.m_isDataAvailable;
 }
 
 template <class ElemType>
-typename ReaderShim<ElemType>::PrefetchResult ReaderShim<ElemType>::PrefetchMinibatch(size_t currentDataTransferIndex)
+typename ReaderShim<ElemType>::PrefetchResult ReaderShim<ElemType>::PrefetchMinibatch(PrefetchSlot& slot)
 {
     PROFILE_SCOPE(profilerEvtPrefetchMinibatch);
 
     // Resetting layouts.
-    for (auto& mx : m_prefetchBuffers)
+    for (auto& mx : slot.m_buffers)
         mx.second.m_mbLayout = std::make_shared<MBLayout>();
 
     Minibatch minibatch = m_reader->ReadMinibatch();
@@ -356,25 +444,25 @@ typename ReaderShim<ElemType>::PrefetchResult ReaderShim<ElemType>::PrefetchMini
     // Ok we have some data. Let's load it to GPU.
     // But before we need to make sure that corresponding compute has already finished from the last iteration.
 
-    // We need to make sure that the compute for the current transfer is finished before we start prefetch.
-    if (m_dataTransferers[currentDataTransferIndex])
-        m_dataTransferers[currentDataTransferIndex]->WaitForSyncPointOnAssignStreamAsync();
+    // We need to make sure that the compute on this slot's buffers is finished before we overwrite them.
+    if (slot.m_dataTransferer)
+        slot.m_dataTransferer->WaitForSyncPointOnAssignStreamAsync();
 
-    m_getKeyById = minibatch.m_getKeyById;
+    slot.m_getKeyById = minibatch.m_getKeyById;
 
-    for (auto& mx : m_prefetchBuffers)
+    for (auto& mx : slot.m_buffers)
     {
         size_t streamId = m_nameToStreamId[mx.first];
         const auto& stream = minibatch.m_data[streamId];
         mx.second.m_mbLayout = stream->m_layout;
 
         size_t sampleSize = m_streams[streamId]->m_sampleLayout->GetNumElements();
-        FillMatrixFromStream(m_streams[streamId]->m_storageType, mx.second.m_matrix.get(), sampleSize, stream, m_dataTransferers[currentDataTransferIndex].get());
+        FillMatrixFromStream(m_streams[streamId]->m_storageType, mx.second.m_matrix.get(), sampleSize, stream, slot.m_dataTransferer.get());
     }
 
     // Let's record that we started the copy, so that the main thread can wait afterwards.
-    if (m_dataTransferers[currentDataTransferIndex])
-        m_dataTransferers[currentDataTransferIndex]->RecordCPUToGPUCopy();
+    if (slot.m_dataTransferer)
+        slot.m_dataTransferer->RecordCPUToGPUCopy();
 
     return PrefetchResult{ minibatch.m_endOfSweep, minibatch.m_endOfEpoch, true };
 }
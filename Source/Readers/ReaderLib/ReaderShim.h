@@ -11,6 +11,8 @@
 #include <unordered_map>
 #include <string>
 #include <future>
+#include <mutex>
+#include <condition_variable>
 #include "DataReader.h"
 #include "Reader.h"
 
@@ -47,10 +49,16 @@ public:
         // Make sure there are no outstanding reads.
         // Future destructor does not wait as of 2013 so probably it is not in VS2013:
         // More info can be found here http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2013/n3679.html.
-        if (m_prefetchTask.valid())
+        if (m_prefetchLoop.valid())
         {
-            // If there are some, give them time to finish.
-            m_prefetchTask.wait_for(std::chrono::seconds(5));
+            {
+                std::lock_guard<std::mutex> lock(m_slotMutex);
+                m_stopPrefetch = true;
+            }
+            m_slotFreed.notify_all();
+
+            // If the loop is still reading, give it time to finish.
+            m_prefetchLoop.wait_for(std::chrono::seconds(5));
             // TODO: if the prefetch is still valid, print a warning here!
         }
 
@@ -114,9 +122,6 @@ private:
         bool m_isDataAvailable;
     };
 
-    PrefetchResult PrefetchMinibatch(size_t currentDataTransferIndex);
-
-    std::future<PrefetchResult> m_prefetchTask;
     ReaderPtr m_reader;
     ReaderFactory m_factory;
     bool m_endOfEpoch;
@@ -135,22 +140,46 @@ private:
         MBLayoutPtr m_mbLayout;
     };
 
-    // Intermediate buffer where the prefetch thread puts its data to.
-    // When the main thread enters GetMinibatch it swaps the matrices from this buffer,
-    // triggers the next prefetch and waits if memCpy is still in progress.
-    std::unordered_map<std::wstring, StreamPrefetchBuffer> m_prefetchBuffers;
-
-    // Alternating data transfer operations. In the current version these are only two - 
-    // currently waiting on the main thread and the one that can be started by the prefetch thread 
-    // in the meantime.
-    std::vector<DataTransfererPtr> m_dataTransferers;
-
-    // Id to key mapping.
-    std::function<std::string(size_t)> m_getKeyById;
+    // One element of the bounded prefetch queue. Each slot owns its own staging matrices
+    // and its own data transferer, so up to queue-depth reads and async memcopies can be
+    // in flight at the same time, absorbing transient reader latency spikes.
+    struct PrefetchSlot
+    {
+        // Intermediate buffers where the prefetch thread puts its data to.
+        // When the main thread consumes the slot in GetMinibatch it swaps the matrices
+        // from these buffers and waits if the memCpy is still in progress.
+        std::unordered_map<std::wstring, StreamPrefetchBuffer> m_buffers;
+        DataTransfererPtr m_dataTransferer;
+        PrefetchResult m_result;
+
+        // Reader sample position right after this slot's minibatch was read.
+        // The reader runs ahead of the main thread, so the global position must be
+        // taken at read time, not at consume time.
+        size_t m_samplePosition;
+
+        // Id to key mapping of this slot's minibatch.
+        std::function<std::string(size_t)> m_getKeyById;
+    };
 
-    // Current data transfer. Flips 0 and 1.
-    // Can be changed only from the main thread with no ongoing prefetch.
-    size_t m_currentDataTransferIndex; 
+    PrefetchResult PrefetchMinibatch(PrefetchSlot& slot);
+    bool FillNextSlot(); // returns true when the end of the epoch has been read
+    void PrefetchLoop();
+    void StartPrefetchLoop();
+    void StopPrefetchLoop();
+
+    // The prefetch queue, used as a ring buffer. The prefetch loop fills slot m_slotToFill,
+    // the main thread consumes slot m_slotToConsume; m_numFilledSlots keeps them apart.
+    std::vector<PrefetchSlot> m_prefetchSlots;
+    size_t m_prefetchDepth;   // configurable via 'prefetchDepth'
+    size_t m_slotToFill;      // written only by the prefetch loop
+    size_t m_slotToConsume;   // written only by the main thread
+    size_t m_numFilledSlots;  // guarded by m_slotMutex
+    bool m_stopPrefetch;      // guarded by m_slotMutex
+    std::exception_ptr m_prefetchException; // guarded by m_slotMutex, rethrown on the main thread
+    std::mutex m_slotMutex;
+    std::condition_variable m_slotFilled;
+    std::condition_variable m_slotFreed;
+    std::future<void> m_prefetchLoop;
 
     // Device id.
     int m_deviceId;
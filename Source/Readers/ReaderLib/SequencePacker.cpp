@@ -146,11 +146,22 @@ MBLayoutPtr SequencePacker::PackDenseStream(const StreamBatch& batch, size_t str
 
     auto elementSize = GetSizeByType(stream->m_elementType);
 
+    if (stream->m_storageType != StorageType::dense && stream->m_storageType != StorageType::sparse_csc)
+        RuntimeError("Storage type %d is not supported.", (int)stream->m_storageType);
+
+    // For sparse input, zero out the destination with a single memset upfront,
+    // so that packing a sample below only has to scatter its non-zero values.
+    if (stream->m_storageType == StorageType::sparse_csc)
+        memset(buffer.m_data.get(), 0, requiredSize);
+
     const auto& sequenceInfos = pMBLayout->GetAllSequences();
 
     // Iterate over sequences in the layout, copy samples from the
     // source sequences into the buffer (at appropriate offsets).
-    for (int i = 0; i < sequenceInfos.size(); ++i)
+    // Each sequence occupies its own set of columns in the layout,
+    // so the sequences can be packed in parallel.
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < (int)sequenceInfos.size(); ++i)
     {
         const auto& sequenceInfo = sequenceInfos[i];
         // skip gaps
@@ -181,23 +192,21 @@ MBLayoutPtr SequencePacker::PackDenseStream(const StreamBatch& batch, size_t str
                 PackDenseSample(destination, sequence, sampleOffset, sampleSize);
                 sampleOffset += sampleSize;
             }
-            else if (stream->m_storageType == StorageType::sparse_csc)
+            else
             {
+                assert(stream->m_storageType == StorageType::sparse_csc);
                 // TODO: make type casts members of the SparseSequenceData
                 SparseSequenceDataPtr sparseSequence = static_pointer_cast<SparseSequenceData>(sequence);
                 // make sure that the sequence meta-data is correct.
                 assert(numSamples == sparseSequence->m_nnzCounts.size());
-                PackSparseSampleAsDense(destination, sparseSequence, sampleIndex, sampleOffset, sampleSize, elementSize);
+                // The destination was zeroed out as a whole above, so only the non-zero values are scattered here.
+                ScatterSparseSample(destination, sparseSequence, sampleIndex, sampleOffset, sampleSize, elementSize);
                 // move the offset by nnz count of the sample.
                 sampleOffset += sparseSequence->m_nnzCounts[sampleIndex];
-                // verify that the offset is within the bounds (less or equal 
+                // verify that the offset is within the bounds (less or equal
                 // to the total nnz count of the sequence).
                 assert(sampleOffset <= sparseSequence->m_totalNnzCount);
             }
-            else
-            {
-                RuntimeError("Storage type %d is not supported.", (int)stream->m_storageType);
-            }
         }
     }
 
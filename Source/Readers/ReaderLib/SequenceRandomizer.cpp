@@ -18,8 +18,14 @@ namespace Microsoft { namespace MSR { namespace CNTK {
     SequenceRandomizer::SequenceRandomizer(
         int verbosity,
         IDataDeserializerPtr deserializer,
-        ChunkRandomizerPtr chunkRandomizer)
+        ChunkRandomizerPtr chunkRandomizer,
+        size_t lengthBucketWidthInSamples,
+        bool windowFreeRandomization)
         : m_verbosity(verbosity),
+        m_lengthBucketWidth(lengthBucketWidthInSamples),
+        m_windowFree(windowFreeRandomization),
+        m_currentPermutationBlock(SIZE_MAX),
+        m_sweepSeed(0),
         m_randomizedChunks(chunkRandomizer->GetRandomizedChunks()),
         m_chunkWindowBegin(0),
         m_randomizedWindowEnd(0),
@@ -30,6 +36,24 @@ namespace Microsoft { namespace MSR { namespace CNTK {
         m_currentSampleCursor(0),
         m_deserializer(deserializer)
     {
+        if (m_windowFree && m_lengthBucketWidth != 0)
+            InvalidArgument("Window-free randomization cannot be combined with length-bucketed batching.");
+
+        if (m_windowFree)
+        {
+            // Sequence descriptions are derived computationally in window-free mode, so
+            // per-sequence lengths cannot be recovered; every sequence must be a single sample.
+            for (const auto& c : m_randomizedChunks)
+            {
+                if (c.m_original->m_numberOfSamples != c.m_original->m_numberOfSequences)
+                    RuntimeError("Window-free randomization requires single-sample sequences (frame mode), "
+                        "but chunk %u contains %" PRIu64 " sequences and %" PRIu64 " samples.",
+                        c.m_original->m_id,
+                        (uint64_t)c.m_original->m_numberOfSequences,
+                        (uint64_t)c.m_original->m_numberOfSamples);
+            }
+        }
+
         size_t max = 0;
         for (const auto& c : m_randomizedChunks)
         {
@@ -59,10 +83,44 @@ namespace Microsoft { namespace MSR { namespace CNTK {
         m_currentSequenceCursor = 0;
         m_currentSampleCursor = 0;
 
+        if (m_windowFree)
+        {
+            // No window to prepare: descriptions are derived from the per-block permutations,
+            // keyed to the sweep seed on access. The block partition has to be rebuilt because
+            // the chunk order has changed.
+            m_sweepSeed = randSeed;
+            m_currentPermutationBlock = SIZE_MAX;
+            BuildPermutationBlocks();
+            return;
+        }
+
         // Prepare the chunk for reading
         RandomizeNextChunkIfNeeded();
     }
 
+    // Partitions the randomized chunks into disjoint permutation blocks, each covering the
+    // randomization window of its first chunk. Frames are permuted within their block, so the
+    // effective randomization window matches the chunk-level one except that it does not roll:
+    // frames cannot cross a block boundary.
+    void SequenceRandomizer::BuildPermutationBlocks()
+    {
+        m_blockStartPositions.clear();
+        m_blockStartChunks.clear();
+
+        size_t blockBegin = 0;
+        while (blockBegin < m_randomizedChunks.size())
+        {
+            m_blockStartChunks.push_back((ChunkIdType)blockBegin);
+            m_blockStartPositions.push_back(m_randomizedChunks[blockBegin].m_sequencePositionStart);
+
+            size_t blockEnd = std::max(blockBegin + 1, (size_t)m_randomizedChunks[blockBegin].m_randomizationWindow.m_end);
+            blockBegin = std::min(blockEnd, m_randomizedChunks.size());
+        }
+
+        m_blockStartChunks.push_back((ChunkIdType)m_randomizedChunks.size());
+        m_blockStartPositions.push_back(m_randomizedChunks.empty() ? 0 : m_randomizedChunks.back().SequenceEndPosition());
+    }
+
     // Gets the next randomized sequence descriptions not exceeding the global and local sample count,
     // when atLeastOneSequenceNeeded is false. Otherwise (when atLeastOneSequenceNeeded is true), 
     // returns at least one sequence description even when its length is greater than the required sample counts.
@@ -85,6 +143,9 @@ namespace Microsoft { namespace MSR { namespace CNTK {
             localSampleCount > std::numeric_limits<int>::max())
             RuntimeError("Global and local size of the minibatch cannot exceed max int.");
 
+        if (m_windowFree)
+            return GetNextSequenceDescriptionsWindowFree(globalSampleCount, localSampleCount, isLocalSequence, requiredChunks, sequences, atLeastOneSequenceNeeded);
+
         // Initialize the range to the current chunk.
         requiredChunks.m_begin = (ChunkIdType)std::min(m_currentChunkCursor, m_randomizedChunks.size() - 1);
         requiredChunks.m_end = requiredChunks.m_begin + 1;
@@ -141,6 +202,100 @@ namespace Microsoft { namespace MSR { namespace CNTK {
         return { globalSamplesRead, localSamplesRead };
     }
 
+    // Window-free counterpart of GetNextSequenceDescriptions: same loop structure, but the
+    // sequence descriptions are derived from the per-block permutation instead of the
+    // sequence window, and no chunks need to be paged in or released here.
+    std::pair<size_t, size_t> SequenceRandomizer::GetNextSequenceDescriptionsWindowFree(
+        size_t globalSampleCount,
+        size_t localSampleCount,
+        const std::function<bool(const RandomizedSequenceDescription*)>& isLocalSequence,
+        ClosedOpenChunkInterval& requiredChunks,
+        std::vector<RandomizedSequenceDescription>& sequences,
+        bool atLeastOneSequenceNeeded)
+    {
+        // Initialize the range to the current chunk.
+        requiredChunks.m_begin = (ChunkIdType)std::min(m_currentChunkCursor, m_randomizedChunks.size() - 1);
+        requiredChunks.m_end = requiredChunks.m_begin + 1;
+
+        sequences.reserve(localSampleCount);
+        sequences.clear();
+
+        size_t totalNumberOfSequences = m_randomizedChunks.back().SequenceEndPosition();
+        size_t globalSamplesRead = 0, localSamplesRead = 0;
+        while (m_currentSequenceCursor < totalNumberOfSequences &&
+               localSamplesRead < localSampleCount &&
+               globalSamplesRead < globalSampleCount)
+        {
+            RandomizedSequenceDescription sequence = GetPermutedSequenceDescription(m_currentSequenceCursor);
+            int sequenceLength = (int)sequence.m_numberOfSamples;
+            bool isLocal = isLocalSequence(&sequence);
+            bool enoughData = !sequences.empty() || !atLeastOneSequenceNeeded;
+
+            // Let's check whether we need to break because we exceeded global counter.
+            if (enoughData && globalSamplesRead + sequenceLength > globalSampleCount)
+                break;
+
+            // Let's check whether we need to break because we exceeded local counter.
+            if (enoughData && isLocal && localSamplesRead + sequenceLength > localSampleCount)
+                break;
+
+            if (isLocal) // Ok good to add it to the result.
+            {
+                sequences.push_back(sequence);
+                localSamplesRead += sequenceLength;
+            }
+
+            // even when the next sequence is not local, somebody else would return it, so
+            // we need to ivalidate the 'atLeastOneSequenceNeeded' flag.
+            atLeastOneSequenceNeeded = false;
+
+            globalSamplesRead += sequenceLength;
+
+            // Update the required chunk window: the permutation can source the frame from
+            // any chunk of the current block.
+            requiredChunks.m_begin = std::min(m_blockStartChunks[m_currentPermutationBlock], requiredChunks.m_begin);
+            requiredChunks.m_end = std::max(m_blockStartChunks[m_currentPermutationBlock + 1], requiredChunks.m_end);
+
+            // Update current cursor to the next sequence.
+            m_currentSequenceCursor++;
+            m_currentSampleCursor += sequenceLength;
+            while (m_currentChunkCursor < m_randomizedChunks.size() &&
+                   m_randomizedChunks[m_currentChunkCursor].SequenceEndPosition() <= m_currentSequenceCursor)
+            {
+                m_currentChunkCursor++;
+            }
+        }
+
+        return { globalSamplesRead, localSamplesRead };
+    }
+
+    // Computes the randomized sequence description for a sweep position from the seeded
+    // permutation of its block.
+    RandomizedSequenceDescription SequenceRandomizer::GetPermutedSequenceDescription(size_t sequencePosition)
+    {
+        // Locate the permutation block containing the position.
+        auto it = std::upper_bound(m_blockStartPositions.begin(), m_blockStartPositions.end(), sequencePosition);
+        size_t block = it - m_blockStartPositions.begin() - 1;
+
+        // Re-key the permutation when entering another block. The cursor moves sequentially,
+        // so this happens once per block per sweep.
+        if (block != m_currentPermutationBlock)
+        {
+            size_t blockSize = m_blockStartPositions[block + 1] - m_blockStartPositions[block];
+            m_blockPermutation.Reset(blockSize, m_sweepSeed * 0x9e3779b97f4a7c15ull + block);
+            m_currentPermutationBlock = block;
+        }
+
+        size_t permutedPosition = m_blockStartPositions[block] + m_blockPermutation(sequencePosition - m_blockStartPositions[block]);
+        ChunkIdType chunkIndex = GetChunkIndexForSequencePosition(permutedPosition);
+
+        RandomizedSequenceDescription s;
+        s.m_indexInOriginalChunk = permutedPosition - m_randomizedChunks[chunkIndex].m_sequencePositionStart;
+        s.m_numberOfSamples = 1;
+        s.m_chunk = &m_randomizedChunks[chunkIndex];
+        return s;
+    }
+
     // Move the chunk cursor to the next chunk, randomizing more sequences if necessary.
     void SequenceRandomizer::MoveChunkCursor()
     {
@@ -272,9 +427,23 @@ namespace Microsoft { namespace MSR { namespace CNTK {
             }
         }
 
+        // The chunk at m_randomizedWindowEnd is now fully randomized: no later swap can touch
+        // it, and positions within one randomized chunk are interchangeable. So its sequences
+        // can be regrouped into length buckets without affecting the randomization invariants.
+        // The sort is stable, preserving the random order within each bucket.
+        size_t randomizedChunk = m_randomizedWindowEnd - m_chunkWindowBegin;
+        if (m_lengthBucketWidth != 0)
+        {
+            size_t width = m_lengthBucketWidth;
+            std::stable_sort(m_sequenceWindow[randomizedChunk].begin(), m_sequenceWindow[randomizedChunk].end(),
+                [width](const RandomizedSequenceDescription& a, const RandomizedSequenceDescription& b)
+                {
+                    return a.m_numberOfSamples / width < b.m_numberOfSamples / width;
+                });
+        }
+
         // Let's recalculate number of samples in the randomized chunks for efficient indexing in seek.
         size_t sampleCount = 0;
-        size_t randomizedChunk = m_randomizedWindowEnd - m_chunkWindowBegin;
         for (size_t index = 0; index < m_sequenceWindow[randomizedChunk].size(); index++)
         {
             sampleCount += m_sequenceWindow[randomizedChunk][index].m_numberOfSamples;
@@ -307,6 +476,25 @@ namespace Microsoft { namespace MSR { namespace CNTK {
     // If there is no sequence, an offset outside the sweep is returned.
     size_t SequenceRandomizer::Seek(size_t sweepSampleOffset, size_t sweep)
     {
+        if (m_windowFree)
+        {
+            // Positions are independent of each other in window-free mode, so seeking is O(1).
+            // Sample and sequence positions coincide in frame mode. The sweep has already been
+            // prepared by Reset, no reseeding is needed here.
+            if (m_verbosity)
+                fprintf(stderr, "SequenceRandomizer::Seek(): seeking offset %" PRIu64 " in sweep %" PRIu64 " (window-free)\n",
+                    sweepSampleOffset,
+                    sweep);
+
+            size_t totalNumberOfSequences = m_randomizedChunks.back().SequenceEndPosition();
+            m_currentSequenceCursor = std::min(sweepSampleOffset, totalNumberOfSequences);
+            m_currentSampleCursor = m_currentSequenceCursor;
+            m_currentChunkCursor = m_currentSequenceCursor < totalNumberOfSequences ?
+                GetChunkIndexForSequencePosition(m_currentSequenceCursor) :
+                m_randomizedChunks.size();
+            return m_currentSampleCursor;
+        }
+
         // Determine sample range that is randomized within the chunk window.
         size_t randomizeWindowBeginInSamples = 0;
         size_t randomizedWindowEndInSamples = 0;
@@ -10,6 +10,7 @@
 #include "Transformer.h"
 #include "DataDeserializer.h"
 #include "ChunkRandomizer.h"
+#include "RandomOrdering.h"
 #include <deque>
 #include <random>
 
@@ -32,10 +33,24 @@ struct RandomizedSequenceDescription
 class SequenceRandomizer
 {
 public:
+    // lengthBucketWidthInSamples enables length-bucketed batching: once a chunk is fully
+    // randomized, its sequences are regrouped into buckets of similar length (bucket index =
+    // number of samples / width), so that consecutive minibatches carry sequences of similar
+    // length and need less padding. The width trades shuffling quality against padding waste:
+    // the random order is preserved within each bucket, so wider buckets shuffle better but
+    // pad more. 0 disables bucketing.
+    // windowFreeRandomization replaces the materialized sequence window with a seeded
+    // permutation function that is evaluated per position, so memory stays O(number of chunks)
+    // instead of O(number of sequences in the window). Because sequence descriptions are then
+    // derived computationally, every sequence must consist of a single sample (frame mode);
+    // the constructor verifies this. Incompatible with length bucketing (all lengths are
+    // equal in frame mode, so bucketing is meaningless there anyway).
     SequenceRandomizer(
         int verbosity,
         IDataDeserializerPtr deserializer,
-        ChunkRandomizerPtr chunkRandomizer);
+        ChunkRandomizerPtr chunkRandomizer,
+        size_t lengthBucketWidthInSamples = 0,
+        bool windowFreeRandomization = false);
 
     // Resets the current sweep according to the randomization seed provided.
     void Reset(size_t seed);
@@ -84,6 +99,24 @@ private:
     // Release chunks from the chunk window that are not needed anymore.
     void ReleaseChunks();
 
+    // Window-free counterpart of GetNextSequenceDescriptions: descriptions are derived
+    // from the per-block permutation instead of the sequence window.
+    std::pair<size_t, size_t> GetNextSequenceDescriptionsWindowFree(
+        size_t globalSampleCount,
+        size_t localSampleCount,
+        const std::function<bool(const RandomizedSequenceDescription*)>& isLocalSequence,
+        ClosedOpenChunkInterval& requiredChunks,
+        std::vector<RandomizedSequenceDescription>& sequences,
+        bool atLeastOneSequenceNeeded);
+
+    // Computes the randomized sequence description for a sweep position from the seeded
+    // permutation of its block (window-free mode only).
+    RandomizedSequenceDescription GetPermutedSequenceDescription(size_t sequencePosition);
+
+    // Partitions the randomized chunks into disjoint permutation blocks, each covering the
+    // randomization window of its first chunk. Rebuilt every sweep because the chunk order changes.
+    void BuildPermutationBlocks();
+
     IDataDeserializerPtr m_deserializer;
 
     // Used only as a buffer to get sequence descriptions without memory reallocation.
@@ -164,6 +197,29 @@ private:
     // General configuration
     int m_verbosity;
 
+    // Width of a length bucket in samples, 0 if bucketing is disabled.
+    size_t m_lengthBucketWidth;
+
+    // Whether the sequence window is replaced by computed per-block permutations.
+    bool m_windowFree;
+
+    // First sequence position of each permutation block, plus the total number of
+    // sequences as a sentinel. Valid in window-free mode only.
+    std::vector<size_t> m_blockStartPositions;
+
+    // First randomized chunk of each permutation block, plus the total number of chunks
+    // as a sentinel. Block i spans chunks [m_blockStartChunks[i], m_blockStartChunks[i + 1]).
+    std::vector<ChunkIdType> m_blockStartChunks;
+
+    // Permutation of the block the cursor is currently in, re-keyed lazily on block change.
+    RandomPermutation m_blockPermutation;
+
+    // Block the cached permutation is keyed to, SIZE_MAX if none.
+    size_t m_currentPermutationBlock;
+
+    // Seed of the current sweep, used to key the per-block permutations.
+    size_t m_sweepSeed;
+
     std::mt19937_64 m_rng;
 };
 
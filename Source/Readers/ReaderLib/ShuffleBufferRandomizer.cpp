@@ -0,0 +1,371 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#define _CRT_SECURE_NO_WARNINGS
+#include <algorithm>
+#include <inttypes.h>
+
+#include "ShuffleBufferRandomizer.h"
+#include "DataReader.h"
+#include "ExceptionCapture.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+ShuffleBufferRandomizer::ShuffleBufferRandomizer(
+    IDataDeserializerPtr deserializer,
+    size_t shuffleBufferSize,
+    bool multithreadedGetNextSequences,
+    size_t maxNumberOfInvalidSequences,
+    size_t seedOffset,
+    size_t deserializationThreadCount)
+    : m_deserializer(deserializer),
+      m_multithreadedGetNextSequences(multithreadedGetNextSequences),
+      m_deserializationThreadCount(deserializationThreadCount),
+      m_shuffleBufferSize(shuffleBufferSize),
+      m_seedOffset(seedOffset),
+      m_sweepIndex(0),
+      m_nextChunkToStream(0),
+      m_streamingChunkId(CHUNKID_MAX),
+      m_nextSequenceInWindow(0),
+      m_pendingPick(SIZE_MAX),
+      m_globalSamplePosition(0),
+      m_globalSequencePosition(0),
+      m_sweepSizeInSamples(0),
+      m_sweepSizeInSequences(0),
+      m_cleaner(maxNumberOfInvalidSequences)
+{
+    assert(deserializer != nullptr);
+
+    if (shuffleBufferSize == 0)
+        InvalidArgument("ShuffleBufferRandomizer: the shuffle buffer must hold at least one sequence.");
+
+    m_streams = m_deserializer->GetStreamDescriptions();
+    m_chunkDescriptions = m_deserializer->GetChunkDescriptions();
+
+    for (const auto& chunk : m_chunkDescriptions)
+    {
+        m_sweepSizeInSamples += chunk->m_numberOfSamples;
+        m_sweepSizeInSequences += chunk->m_numberOfSequences;
+    }
+
+    if (m_sweepSizeInSamples == 0)
+    {
+        RuntimeError("ShuffleBufferRandomizer: Expected input to contain samples, but the number of successfully read samples was 0.");
+    }
+
+    StartSweep(0);
+}
+
+void ShuffleBufferRandomizer::StartEpoch(const EpochConfiguration& config)
+{
+    m_config = config;
+
+    if (config.m_totalEpochSizeInSweeps != g_infinity)
+    {
+        m_config.m_totalEpochSizeInSamples = m_sweepSizeInSamples * config.m_totalEpochSizeInSweeps;
+    }
+    else if (m_config.m_totalEpochSizeInSamples == requestDataSize)
+        m_config.m_totalEpochSizeInSamples = m_sweepSizeInSamples;
+
+    // Chunk-based decimation relies on the pool spanning several chunks per
+    // worker; with a smaller buffer the emission order gets bursty per chunk
+    // and workers see uneven minibatch sizes.
+    size_t averageSequencesPerChunk = m_sweepSizeInSequences / m_chunkDescriptions.size();
+    if (m_config.m_numberOfWorkers > 1 &&
+        m_shuffleBufferSize < averageSequencesPerChunk * m_config.m_numberOfWorkers)
+    {
+        fprintf(stderr, "WARNING: ShuffleBufferRandomizer: the shuffle buffer (%" PRIu64 " sequences) spans less than"
+            " one chunk per worker (%" PRIu64 " workers, %" PRIu64 " sequences per chunk on average),"
+            " minibatches can be unevenly distributed across the workers.\n",
+            (uint64_t)m_shuffleBufferSize,
+            (uint64_t)m_config.m_numberOfWorkers,
+            (uint64_t)averageSequencesPerChunk);
+    }
+
+    SetCurrentSamplePosition(m_config.m_totalEpochSizeInSamples * config.m_epochIndex);
+}
+
+void ShuffleBufferRandomizer::StartSweep(size_t sweepIndex)
+{
+    assert(m_pool.empty());
+
+    m_sweepIndex = sweepIndex;
+    m_rng.seed((uint64_t)(m_seedOffset + sweepIndex));
+    m_nextChunkToStream = 0;
+    m_streamingChunkId = CHUNKID_MAX;
+    m_sequenceWindow.clear();
+    m_nextSequenceInWindow = 0;
+    m_pendingPick = SIZE_MAX;
+    m_pooledChunks.clear();
+}
+
+void ShuffleBufferRandomizer::FillPool()
+{
+    while (m_pool.size() < m_shuffleBufferSize)
+    {
+        if (m_nextSequenceInWindow >= m_sequenceWindow.size())
+        {
+            // Done pulling from the current chunk, drop its entry if it is already drained.
+            if (m_streamingChunkId != CHUNKID_MAX)
+            {
+                auto it = m_pooledChunks.find(m_streamingChunkId);
+                if (it != m_pooledChunks.end() && it->second.second == 0)
+                    m_pooledChunks.erase(it);
+                m_streamingChunkId = CHUNKID_MAX;
+            }
+
+            if (m_nextChunkToStream >= m_chunkDescriptions.size())
+                break; // The sweep is fully streamed, the pool only drains from now on.
+
+            m_sequenceWindow.clear();
+            m_deserializer->GetSequencesForChunk(m_nextChunkToStream, m_sequenceWindow);
+            m_nextSequenceInWindow = 0;
+            m_streamingChunkId = m_nextChunkToStream;
+            m_nextChunkToStream++;
+            continue;
+        }
+
+        const auto& description = m_sequenceWindow[m_nextSequenceInWindow++];
+        m_pooledChunks[description.m_chunkId].second++;
+        m_pool.push_back(description);
+    }
+}
+
+size_t ShuffleBufferRandomizer::PickPoolIndex()
+{
+    assert(!m_pool.empty());
+
+    // Pool entries are removed by a swap with the back, so a pending pick from
+    // an earlier call still denotes the same sequence: the pool can only have
+    // grown since the pick was made.
+    if (m_pendingPick == SIZE_MAX)
+        m_pendingPick = (size_t)(m_rng() % m_pool.size());
+
+    return m_pendingPick;
+}
+
+bool ShuffleBufferRandomizer::IsChunkStillStreaming(ChunkIdType chunkId) const
+{
+    return chunkId == m_streamingChunkId && m_nextSequenceInWindow < m_sequenceWindow.size();
+}
+
+void ShuffleBufferRandomizer::RemoveFromPool(size_t poolIndex)
+{
+    auto chunkId = m_pool[poolIndex].m_chunkId;
+    auto it = m_pooledChunks.find(chunkId);
+    assert(it != m_pooledChunks.end());
+
+    // Release the chunk when no pooled sequence references it and no further
+    // sequences of it will enter the pool.
+    if (--it->second.second == 0 && !IsChunkStillStreaming(chunkId))
+        m_pooledChunks.erase(it);
+
+    m_pool[poolIndex] = m_pool.back();
+    m_pool.pop_back();
+    m_pendingPick = SIZE_MAX;
+}
+
+// Gets next sequences not exceeding local and global samples.
+void ShuffleBufferRandomizer::GetNextSequenceDescriptions(size_t globalSampleCount, size_t localSampleCount, std::vector<SequenceDescription>& result)
+{
+    assert(globalSampleCount != 0);
+    assert(localSampleCount != 0);
+
+    if (globalSampleCount > std::numeric_limits<int>::max() &&
+        localSampleCount > std::numeric_limits<int>::max())
+        RuntimeError("Global and local size of the minibatch cannot exceed max int.");
+
+    size_t numGlobalSamplesLoaded = 0, numLocalSamplesLoaded = 0;
+
+    result.reserve(localSampleCount);
+    result.clear();
+
+    while (globalSampleCount > numGlobalSamplesLoaded && localSampleCount > numLocalSamplesLoaded)
+    {
+        FillPool();
+        if (m_pool.empty())
+        {
+            // The current sweep is fully drained, move on to the next one.
+            StartSweep(m_sweepIndex + 1);
+            FillPool();
+            assert(!m_pool.empty());
+        }
+
+        size_t pick = PickPoolIndex();
+        const SequenceDescription& sequence = m_pool[pick];
+        auto sequenceLength = sequence.m_numberOfSamples;
+
+        // Decimation is by chunk, not by emission position: the sequence is
+        // local when its chunk is assigned to this worker, so each worker only
+        // ever loads the data of its own ~1/N of the chunks. The emission order
+        // still stays balanced across workers because the pool mixes sequences
+        // from many chunks. The assignment is rotated with the sweep index so
+        // that over several sweeps every worker reads every chunk.
+        bool isLocal = ((size_t)sequence.m_chunkId + m_sweepIndex) % m_config.m_numberOfWorkers == m_config.m_workerRank;
+        bool enoughData = !result.empty();
+
+        // Let's check whether we need to break because we exceeded global counter.
+        // The pick stays pending, so the generators remain in lockstep across workers.
+        if (enoughData && globalSampleCount - numGlobalSamplesLoaded < sequenceLength)
+            break;
+
+        // Let's check whether we need to break because we exceeded local counter.
+        if (enoughData && isLocal && localSampleCount - numLocalSamplesLoaded < sequenceLength)
+            break;
+
+        if (isLocal) // Ok good to add it to the result.
+        {
+            result.push_back(sequence);
+            numLocalSamplesLoaded += sequenceLength;
+
+            // Make sure the chunk data is available for the minibatch assembly.
+            auto& chunk = m_pooledChunks[sequence.m_chunkId];
+            if (chunk.first == nullptr)
+                chunk.first = m_deserializer->GetChunk(sequence.m_chunkId);
+            m_minibatchChunks[sequence.m_chunkId] = chunk.first;
+        }
+
+        numGlobalSamplesLoaded += sequenceLength;
+        m_globalSamplePosition += sequenceLength;
+        m_globalSequencePosition++;
+
+        RemoveFromPool(pick);
+    }
+}
+
+size_t ShuffleBufferRandomizer::GetCurrentSamplePosition()
+{
+    return m_globalSamplePosition;
+}
+
+Sequences ShuffleBufferRandomizer::GetNextSequences(size_t globalSampleCount, size_t localSampleCount)
+{
+    if (globalSampleCount == 0)
+        LogicError("Global sample count must not be zero.");
+
+    if (localSampleCount == 0)
+        LogicError("Local sample count must not be zero.");
+
+    Sequences result;
+    size_t endOfEpochPosition = m_config.m_totalEpochSizeInSamples * (m_config.m_epochIndex + 1);
+    if (m_globalSamplePosition >= endOfEpochPosition)
+    {
+        result.m_endOfEpoch = true;
+        result.m_endOfSweep = (m_globalSamplePosition >= m_sweepSizeInSamples) &&
+            (m_globalSamplePosition % m_sweepSizeInSamples == 0);
+        return result;
+    }
+
+    // Check we do not go over epoch.
+    globalSampleCount = std::min(globalSampleCount, endOfEpochPosition - m_globalSamplePosition);
+
+    if (!m_config.m_allowMinibatchesToCrossSweepBoundaries)
+    {
+        // Cut down the required sample count if we're not allowed to go over the
+        // sweep boundary
+        size_t sweepPosition = m_globalSamplePosition % m_sweepSizeInSamples;
+        globalSampleCount = std::min(globalSampleCount, m_sweepSizeInSamples - sweepPosition);
+    }
+
+    if (globalSampleCount == 0)
+        LogicError("Global sample count must not result in zero.");
+
+    auto sweepIndex = m_globalSamplePosition / m_sweepSizeInSamples;
+
+    // Chunks of the previous minibatch are released here; the ones still
+    // referenced by pooled sequences stay alive in m_pooledChunks.
+    m_minibatchChunks.clear();
+
+    m_sequenceBuffer.clear();
+    GetNextSequenceDescriptions(globalSampleCount, localSampleCount, m_sequenceBuffer);
+
+    // m_globalSamplePosition is already shifted in GetNextSequenceDescriptions() by the current minibatch size.
+    // Set the end-of-epoch flag (true when the current batch is last in an epoch).
+    result.m_endOfEpoch = (m_globalSamplePosition >= endOfEpochPosition);
+    result.m_endOfSweep = sweepIndex != m_globalSamplePosition / m_sweepSizeInSamples;
+
+    if (m_sequenceBuffer.size() == 0)
+    {
+        return result;
+    }
+
+    result.m_data.resize(m_streams.size(), std::vector<SequenceDataPtr>(m_sequenceBuffer.size()));
+
+    auto process = [&](int i) -> void {
+        std::vector<SequenceDataPtr> sequence;
+        const auto& sequenceDescription = m_sequenceBuffer[i];
+
+        auto it = m_minibatchChunks.find(sequenceDescription.m_chunkId);
+        if (it == m_minibatchChunks.end())
+        {
+            LogicError("Invalid chunk requested.");
+        }
+
+        it->second->GetSequence(sequenceDescription.m_indexInChunk, sequence);
+        for (int j = 0; j < m_streams.size(); ++j)
+        {
+            result.m_data[j][i] = sequence[j];
+        }
+    };
+
+    if (m_multithreadedGetNextSequences)
+    {
+        ExceptionCapture capture;
+        if (m_deserializationThreadCount != 0)
+        {
+#pragma omp parallel for schedule(dynamic) num_threads((int)m_deserializationThreadCount)
+            for (int i = 0; i < m_sequenceBuffer.size(); ++i)
+                capture.SafeRun(process, i);
+        }
+        else
+        {
+#pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < m_sequenceBuffer.size(); ++i)
+                capture.SafeRun(process, i);
+        }
+        capture.RethrowIfHappened();
+    }
+    else
+    {
+        for (int i = 0; i < m_sequenceBuffer.size(); ++i)
+            process(i);
+    }
+
+    m_cleaner.Clean(result);
+    return result;
+}
+
+void ShuffleBufferRandomizer::SetCurrentSamplePosition(size_t samplePosition)
+{
+    // Restart from the beginning of the containing sweep and deterministically
+    // replay the emission order up to the requested position. No chunk data is
+    // loaded during the replay, only the sequence descriptions are streamed.
+    m_minibatchChunks.clear();
+    m_pool.clear();
+
+    size_t sweepIndex = samplePosition / m_sweepSizeInSamples;
+    StartSweep(sweepIndex);
+    m_globalSamplePosition = sweepIndex * m_sweepSizeInSamples;
+    m_globalSequencePosition = sweepIndex * m_sweepSizeInSequences;
+
+    // As in NoRandomizer, the position is rounded up to the next sequence boundary.
+    while (m_globalSamplePosition < samplePosition)
+    {
+        FillPool();
+        assert(!m_pool.empty());
+
+        size_t pick = PickPoolIndex();
+        m_globalSamplePosition += m_pool[pick].m_numberOfSamples;
+        m_globalSequencePosition++;
+        RemoveFromPool(pick);
+    }
+}
+
+void ShuffleBufferRandomizer::SetConfiguration(const ReaderConfiguration& config)
+{
+    *((ReaderConfiguration*)&m_config) = config;
+}
+
+} } }
@@ -0,0 +1,152 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#pragma once
+
+#include <map>
+#include <random>
+#include <vector>
+#include "SequenceEnumerator.h"
+#include "DataDeserializer.h"
+#include "ReaderUtil.h"
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// A streaming randomizer with memory bounded by the shuffle buffer size,
+// independent of the corpus size. Chunks are streamed in their original order
+// (as in NoRandomizer) and the incoming sequence descriptions pass through a
+// bounded pool: every emitted sequence is drawn uniformly at random from the
+// pool and replaced with the next sequence from the stream. This gives
+// approximate shuffling - a sequence can move at most 'pool size' positions
+// against the stream order - without ever materializing the full sequence
+// index, which BlockRandomizer requires.
+//
+// A sweep is still an exact permutation of the corpus: the pool stops
+// refilling at the sweep boundary and drains completely before the next sweep
+// begins. The generator is re-seeded per sweep from (seedOffset + sweep index),
+// so all workers replay the identical emission order and agree on the global
+// sample accounting. Decimation is shard-aware: chunks are assigned to workers
+// by ((chunk id + sweep index) % number of workers), an emitted sequence is
+// local when its chunk belongs to this worker, and only local chunks are ever
+// loaded - each worker reads roughly 1/N of the corpus bytes per sweep, and the
+// sweep rotation lets every worker cover every chunk over N sweeps. Restoring
+// a sample position replays the emissions of the containing sweep without
+// loading any chunk data.
+class ShuffleBufferRandomizer : public SequenceEnumerator
+{
+public:
+    ShuffleBufferRandomizer(
+        IDataDeserializerPtr deserializer,
+        size_t shuffleBufferSize, // in sequences
+        bool multithreadedGetNextSequences = false,
+        size_t maxNumberOfInvalidSequences = 0, // per worker
+        size_t seedOffset = 0,
+        size_t deserializationThreadCount = 0); // 0 - use the OpenMP default number of threads
+
+    virtual void StartEpoch(const EpochConfiguration& config) override;
+    virtual Sequences GetNextSequences(size_t globalSampleCount, size_t localSampleCount) override;
+    virtual std::vector<StreamDescriptionPtr> GetStreamDescriptions() const override
+    {
+        return m_deserializer->GetStreamDescriptions();
+    }
+
+    size_t GetCurrentSamplePosition() override;
+    void SetCurrentSamplePosition(size_t currentSamplePosition) override;
+
+    void SetConfiguration(const ReaderConfiguration& config) override;
+
+private:
+    // Gets next sequences not exceeding localSampleCount for this worker and globalSampleCount across workers.
+    void GetNextSequenceDescriptions(size_t globalSampleCount, size_t localSampleCount, std::vector<SequenceDescription>& result);
+
+    // Positions the chunk stream at the beginning of the given sweep and re-seeds the generator.
+    void StartSweep(size_t sweepIndex);
+
+    // Refills the pool from the chunk stream up to the buffer size, stopping at the sweep boundary.
+    void FillPool();
+
+    // Picks the pool index of the next sequence to emit. The pick stays pending
+    // until the sequence is actually emitted, so that a minibatch boundary on
+    // one worker does not desynchronize the generators across workers.
+    size_t PickPoolIndex();
+
+    // Removes the sequence at the given pool index, releasing its chunk when
+    // no other pooled sequence references it.
+    void RemoveFromPool(size_t poolIndex);
+
+    // Whether the chunk still has sequences that are not yet pooled.
+    bool IsChunkStillStreaming(ChunkIdType chunkId) const;
+
+    IDataDeserializerPtr m_deserializer;
+
+    // Whether to get sequences using multiple thread.
+    // Useful in case deserializer performs CPU intensive deserialization (e.g. decompression)
+    bool m_multithreadedGetNextSequences;
+
+    // Number of threads used for multithreaded sequence deserialization, 0 - the OpenMP default.
+    size_t m_deserializationThreadCount;
+
+    // Stream descriptions
+    std::vector<StreamDescriptionPtr> m_streams;
+
+    // Epoch configuration
+    EpochConfiguration m_config;
+
+    // Chunk descriptions.
+    ChunkDescriptions m_chunkDescriptions;
+
+    // Number of sequences the pool is allowed to hold.
+    const size_t m_shuffleBufferSize;
+
+    // Seed offset, the generator is seeded with (m_seedOffset + sweep index).
+    const size_t m_seedOffset;
+
+    // Index of the current sweep.
+    size_t m_sweepIndex;
+
+    // Per-sweep generator, identical on all workers.
+    std::mt19937_64 m_rng;
+
+    // Chunk stream cursor inside the current sweep: the next chunk to pull
+    // sequences from and the descriptions of the chunk currently being pulled.
+    ChunkIdType m_nextChunkToStream;
+    ChunkIdType m_streamingChunkId;
+    std::vector<SequenceDescription> m_sequenceWindow;
+    size_t m_nextSequenceInWindow;
+
+    // The shuffle pool of pending sequence descriptions.
+    std::vector<SequenceDescription> m_pool;
+
+    // A pool index picked but not yet emitted, SIZE_MAX if none.
+    size_t m_pendingPick;
+
+    // Chunks referenced by pooled sequences: chunk id -> (data, number of pooled sequences).
+    // The data stays empty until a local sequence of the chunk is emitted, so
+    // replaying emissions to restore a position does not touch the actual data.
+    std::map<ChunkIdType, std::pair<ChunkPtr, size_t>> m_pooledChunks;
+
+    // Chunks needed to assemble the minibatch currently being emitted.
+    std::map<ChunkIdType, ChunkPtr> m_minibatchChunks;
+
+    // Global sample position on the timeline.
+    size_t m_globalSamplePosition;
+
+    // Number of sequences emitted so far.
+    size_t m_globalSequencePosition;
+
+    // Total number of samples in the sweep.
+    size_t m_sweepSizeInSamples;
+
+    // Total number of sequences in the sweep.
+    size_t m_sweepSizeInSequences;
+
+    // Temp buffer to avoid allocations.
+    std::vector<SequenceDescription> m_sequenceBuffer;
+
+    // Helper class for removing invalid sequences.
+    SequenceCleaner m_cleaner;
+};
+
+}}}
@@ -8,18 +8,23 @@
 #include <string>
 #include <memory>
 #include <vector>
-#include <map>
 #include "Basics.h"
 
 namespace Microsoft { namespace MSR { namespace CNTK {
 
 // This class represents a string registry pattern to share strings between different deserializers if needed.
 // It associates a unique key for a given string.
-// Currently it is implemented in-memory, but can be unloaded to external disk if needed.
+// The strings are interned in a single contiguous character pool and addressed
+// by offsets, with an open-addressing hash table over precomputed hashes on
+// top. Compared to a node-based map of std::strings this avoids the per-key
+// allocation and pointer overhead, which dominates the reader startup memory
+// on corpora with hundreds of millions of sequence keys.
 // TODO: Move this class to Basics.h when it is required by more than one reader.
 template<class TString>
 class TStringToIdMap
 {
+    typedef typename TString::value_type TChar;
+
 public:
     TStringToIdMap()
     {}
@@ -27,21 +32,23 @@ public:
     // Adds string value to the registry.
     void AddValue(const TString& value)
     {
-        auto iter = m_values.insert(std::make_pair(value, m_indexedValues.size()));
-        m_indexedValues.push_back(&((iter.first)->first));
+        size_t hash = Hash(value);
+        size_t bucket = FindBucket(value, hash);
+        if (m_buckets[bucket] == 0)
+            Insert(value, hash, bucket);
     }
 
     // Tries to get a value by id.
     bool TryGet(const TString& value, size_t& id) const
     {
-        const auto& it = m_values.find(value);
-        if (it == m_values.end())
+        size_t bucket = FindBucket(value, Hash(value));
+        if (m_buckets[bucket] == 0)
         {
             return false;
         }
         else
         {
-            id = it->second;
+            id = m_buckets[bucket] - 1;
             return true;
         }
     }
@@ -49,43 +56,123 @@ public:
     // Get integer id for the string value, adding if not exists.
     size_t AddIfNotExists(const TString& value)
     {
-        const auto& it = m_values.find(value);
-        if (it == m_values.end())
-        {
-            AddValue(value);
-            return m_values[value];
-        }
-        return it->second;
+        size_t hash = Hash(value);
+        size_t bucket = FindBucket(value, hash);
+        if (m_buckets[bucket] == 0)
+            return Insert(value, hash, bucket);
+        return m_buckets[bucket] - 1;
     }
 
     // Get integer id for the string value.
     size_t operator[](const TString& value) const
     {
-        const auto& it = m_values.find(value);
-        assert(it != m_values.end());
-        return it->second;
+        size_t bucket = FindBucket(value, Hash(value));
+        assert(m_buckets[bucket] != 0);
+        return m_buckets[bucket] - 1;
     }
 
     // Get string value by its integer id.
-    const TString& operator[](size_t id) const
+    TString operator[](size_t id) const
     {
-        if (id >= m_indexedValues.size())
+        if (id >= m_offsets.size())
             RuntimeError("Unknown id requested");
-        return *m_indexedValues[id];
+        return TString(m_pool.data() + m_offsets[id]);
     }
 
     // Checks whether the value exists.
     bool Contains(const TString& value) const
     {
-        return m_values.find(value) != m_values.end();
+        return m_buckets[FindBucket(value, Hash(value))] != 0;
+    }
+
+    // 64-bit FNV-1a hash of the value. Exposed so that hash-only corpus keys
+    // stay stable across platforms and runs, unlike std::hash.
+    static size_t Hash(const TString& value)
+    {
+        size_t hash = 14695981039346656037ull;
+        for (auto c : value)
+        {
+            hash ^= (size_t)c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
     }
 
 private:
     // TODO: Move NonCopyable as a separate class to Basics.h
     DISABLE_COPY_AND_MOVE(TStringToIdMap);
 
-    std::map<TString, size_t> m_values;
-    std::deque<const TString*> m_indexedValues;
+    // Finds the bucket that holds the value, or the empty bucket where it
+    // should be inserted. Linear probing over a power-of-two table; the
+    // precomputed hash is compared before touching the pool.
+    size_t FindBucket(const TString& value, size_t hash) const
+    {
+        size_t mask = m_buckets.size() - 1;
+        size_t bucket = hash & mask;
+        while (m_buckets[bucket] != 0)
+        {
+            size_t id = m_buckets[bucket] - 1;
+            if (m_hashes[id] == hash && Equals(id, value))
+                break;
+            bucket = (bucket + 1) & mask;
+        }
+        return bucket;
+    }
+
+    bool Equals(size_t id, const TString& value) const
+    {
+        // Stored keys are null-terminated, so a length mismatch shows up as a
+        // character mismatch before either string runs out.
+        const TChar* stored = m_pool.data() + m_offsets[id];
+        const TChar* expected = value.c_str();
+        while (*stored == *expected && *stored != 0)
+        {
+            ++stored;
+            ++expected;
+        }
+        return *stored == *expected;
+    }
+
+    size_t Insert(const TString& value, size_t hash, size_t bucket)
+    {
+        size_t id = m_offsets.size();
+        m_offsets.push_back(m_pool.size());
+        m_hashes.push_back(hash);
+        m_pool.insert(m_pool.end(), value.c_str(), value.c_str() + value.size() + 1);
+        m_buckets[bucket] = id + 1;
+
+        // Keep the load factor below ~70%.
+        if ((m_offsets.size() + 1) * 10 > m_buckets.size() * 7)
+            Grow();
+
+        return id;
+    }
+
+    void Grow()
+    {
+        std::vector<size_t> buckets(m_buckets.size() * 2, 0);
+        size_t mask = buckets.size() - 1;
+        for (size_t id = 0; id < m_offsets.size(); ++id)
+        {
+            size_t bucket = m_hashes[id] & mask;
+            while (buckets[bucket] != 0)
+                bucket = (bucket + 1) & mask;
+            buckets[bucket] = id + 1;
+        }
+        m_buckets.swap(buckets);
+    }
+
+    // All keys concatenated, each terminated by a null character.
+    std::vector<TChar> m_pool;
+
+    // Offset of each key in the pool, indexed by id.
+    std::vector<size_t> m_offsets;
+
+    // Precomputed hash of each key, indexed by id.
+    std::vector<size_t> m_hashes;
+
+    // Open-addressing hash table mapping keys to (id + 1), 0 marks an empty bucket.
+    std::vector<size_t> m_buckets = std::vector<size_t>(256, 0);
 };
 
 typedef TStringToIdMap<std::wstring> WStringToIdMap;
@@ -200,9 +200,34 @@ Minibatch TruncatedBPTTPacker::ReadMinibatch()
 
         m_currentLayouts[streamIndex]->Init(m_numParallelSequences, m_config.m_truncationSize);
         size_t sequenceId = 0;
+        m_packedSampleCopies.clear();
         for (size_t slotIndex = 0; slotIndex < m_numParallelSequences; ++slotIndex)
         {
-            result.m_endOfSweep |= PackSlot(streamIndex, slotIndex, sequenceId, mbSeqIdToCorpusSeqId);
+            result.m_endOfSweep |= PackSlot(streamIndex, slotIndex, sequenceId, mbSeqIdToCorpusSeqId, m_packedSampleCopies);
+        }
+
+        // The layout pass above only recorded where each sample goes; now execute
+        // the copies in parallel. Destinations are disjoint column strides of the
+        // minibatch buffer, so the samples can be copied independently.
+        size_t sampleSize = GetSampleSize(m_inputStreamDescriptions[streamIndex]);
+        StorageType storageType = m_inputStreamDescriptions[streamIndex]->m_storageType;
+        size_t elementSize = GetSizeByType(m_inputStreamDescriptions[streamIndex]->m_elementType);
+
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)m_packedSampleCopies.size(); ++i)
+        {
+            const auto& copy = m_packedSampleCopies[i];
+            if (storageType == StorageType::dense)
+            {
+                PackDenseSample(copy.m_destination, copy.m_data, copy.m_sampleOffset, sampleSize);
+            }
+            else
+            {
+                assert(storageType == StorageType::sparse_csc);
+                SparseSequenceDataPtr sparseSequence = static_pointer_cast<SparseSequenceData>(copy.m_data);
+                PackSparseSampleAsDense(copy.m_destination, sparseSequence, copy.m_sampleCursor,
+                    copy.m_sampleOffset, sampleSize, elementSize);
+            }
         }
 
         StreamMinibatchPtr m = make_shared<StreamMinibatch>();
@@ -230,7 +255,8 @@ Minibatch TruncatedBPTTPacker::ReadMinibatch()
 }
 
 // Packs a slot of sequences into the minibatch.
-bool TruncatedBPTTPacker::PackSlot(size_t streamIndex, size_t slotIndex, size_t& sequenceId, std::vector<size_t>& idToKey)
+bool TruncatedBPTTPacker::PackSlot(size_t streamIndex, size_t slotIndex, size_t& sequenceId, std::vector<size_t>& idToKey,
+    std::vector<PackedSampleCopy>& copies)
 {
     bool containsEndOfSweepSequence = false;
     auto& slot = m_sequenceBufferPerStream[streamIndex]->m_slots[slotIndex];
@@ -249,7 +275,6 @@ bool TruncatedBPTTPacker::PackSlot(size_t streamIndex, size_t slotIndex, size_t&
 
     size_t sampleSize = GetSampleSize(m_inputStreamDescriptions[streamIndex]);
     StorageType storageType = m_inputStreamDescriptions[streamIndex]->m_storageType;
-    size_t elementSize = GetSizeByType(m_inputStreamDescriptions[streamIndex]->m_elementType);
 
     // Distance between two samples of the same sequence in bytes.
     size_t strideSize = m_numParallelSequences * sampleSize;
@@ -290,11 +315,11 @@ bool TruncatedBPTTPacker::PackSlot(size_t streamIndex, size_t slotIndex, size_t&
         assert(offset >= 0 && offset < buffer.m_size);
         char* destination = buffer.m_data.get() + offset;
 
-        // Pack the sample.
+        // Record the sample copy; the data is moved by the parallel copy loop in ReadMinibatch.
+        copies.push_back(PackedSampleCopy{ data, destination, slot.m_sampleCursor, slot.m_sampleOffset });
         if (storageType == StorageType::dense)
         {
             assert(slot.m_sampleOffset == slot.m_sampleCursor * sampleSize);
-            PackDenseSample(destination, data, slot.m_sampleOffset, sampleSize);
             slot.m_sampleOffset += sampleSize;
         }
         else
@@ -303,8 +328,6 @@ bool TruncatedBPTTPacker::PackSlot(size_t streamIndex, size_t slotIndex, size_t&
             // TODO: make type casts members of the SparseSequenceData
             SparseSequenceDataPtr sparseSequence = static_pointer_cast<SparseSequenceData>(data);
             assert(slot.m_sampleCursor < sparseSequence->m_nnzCounts.size());
-            PackSparseSampleAsDense(destination, sparseSequence, slot.m_sampleCursor, 
-                slot.m_sampleOffset, sampleSize, elementSize);
             slot.m_sampleOffset += sparseSequence->m_nnzCounts[slot.m_sampleCursor];
             assert(slot.m_sampleOffset <= sparseSequence->m_totalNnzCount);
         }
@@ -15,6 +15,23 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 struct SequenceBuffer;
 typedef std::shared_ptr<SequenceBuffer> SequenceBufferPtr;
 
+// A deferred copy of a single sample into the strided minibatch buffer.
+// The layout pass records one entry per packed sample; the copies are then
+// executed in parallel (destinations of different samples never overlap).
+struct PackedSampleCopy
+{
+    SequenceDataPtr m_data;
+
+    // Destination of the sample in the minibatch buffer.
+    char* m_destination;
+
+    // Index of the sample inside the sequence.
+    size_t m_sampleCursor;
+
+    // Byte (dense) or element (sparse) offset of the sample inside the sequence data.
+    size_t m_sampleOffset;
+};
+
 // A bptt packer that densely packs samples in parallel for GPU consumptions.
 // TODO: Currently supports only packing of streams with sequences of equal length.
 class TruncatedBPTTPacker : public PackerBase
@@ -45,9 +62,11 @@ private:
     // For each new input, sequence id is reset to 0, and incremented each time
     // a sequence is added to the layout. This allows layouts corresponding to different
     // inputs to have consistent sequence ids.
-    // Returns a boolean indicating if a packed data contains a sequence 
+    // Returns a boolean indicating if a packed data contains a sequence
     // (i.e., sequence tail) that was read last in a data sweep.
-    bool PackSlot(size_t streamIndex, size_t slotIndex, size_t& sequenceId, std::vector<size_t>& idToKey);
+    // The actual sample copies are appended to 'copies' to be executed in parallel.
+    bool PackSlot(size_t streamIndex, size_t slotIndex, size_t& sequenceId, std::vector<size_t>& idToKey,
+        std::vector<PackedSampleCopy>& copies);
 
     virtual MBLayoutPtr CreateMBLayout(const StreamBatch& batch)
     {
@@ -67,6 +86,10 @@ private:
     // Layout per stream.
     // TODO: currently assume that layout is the same between different streams, this will change.
     std::vector<MBLayoutPtr> m_currentLayouts;
+
+    // Sample copies recorded by the layout pass of the current stream
+    // (kept as a member to reuse the allocation between minibatches).
+    std::vector<PackedSampleCopy> m_packedSampleCopies;
 };
 
 typedef std::shared_ptr<TruncatedBPTTPacker> TruncatedBPTTPackerPtr;
@@ -106,7 +106,9 @@ bool UCIFastReader<ElemType>::EnsureDataAvailable(size_t mbStartSample, bool end
     int recordsRead = 0;
     do
     {
-        int numRead = m_parser->Parse(numberToRead - recordsRead, &m_featureData, &m_labelData);
+        int numRead = m_parseCache != nullptr ?
+            (int)m_parseCache->Retrieve(numberToRead - recordsRead, &m_featureData, &m_labelData) :
+            m_parser->Parse(numberToRead - recordsRead, &m_featureData, &m_labelData);
 
         recordsRead += numRead;
         if (!m_endReached)
@@ -118,7 +120,11 @@ bool UCIFastReader<ElemType>::EnsureDataAvailable(size_t mbStartSample, bool end
             // update dataset variables
             size_t additionalToRead = UpdateDataVariables(mbStartSample + recordsRead);
 
-            m_parser->SetFilePosition(0); // make another pass of the dataset
+            // make another pass of the dataset
+            if (m_parseCache != nullptr)
+                m_parseCache->SetRecordPosition(0);
+            else
+                m_parser->SetFilePosition(0);
 
             // if doing and end of data check, and we are at the end
             // or a partial minibatch was found exit now
@@ -341,6 +347,8 @@ void UCIFastReader<ElemType>::InitFromConfig(const ConfigRecordType& readerConfi
     m_parser->SetTraceLevel(m_traceLevel);
 
     m_prefetchEnabled = readerConfig(L"prefetch", false);
+    m_cacheBinaryData = readerConfig(L"cacheBinaryData", true);
+    m_parseCache = nullptr;
     // set the feature count to at least one (we better have one feature...)
     assert(m_featureCount != 0);
 
@@ -393,6 +401,8 @@ void UCIFastReader<ElemType>::InitFromConfig(const ConfigRecordType& readerConfi
     }
 
     std::wstring file = configFeatures(L"file");
+    m_dataFilePath = file;
+    m_labelColumns = dimLabels;
     if (m_traceLevel > 0)
         fprintf(stderr, "Reading UCI file %ls\n", file.c_str());
 
@@ -562,6 +572,57 @@ void UCIFastReader<ElemType>::ReleaseMemory()
     m_featureData.clear();
     m_labelIdData.clear();
     m_labelData.clear();
+    m_parseCache = nullptr;
+}
+
+// EnsureParseCache - open the binary sidecar cache for the source file, building it with
+// a single streaming parse pass if it is missing or stale. On any failure the cache is
+// disabled and the reader falls back to parsing the text file every epoch.
+template <class ElemType>
+void UCIFastReader<ElemType>::EnsureParseCache()
+{
+    auto cache = std::make_shared<UCIParseCache<ElemType, LabelType>>();
+    if (cache->Open(m_dataFilePath, m_featureCount, m_labelColumns))
+    {
+        if (m_traceLevel > 0)
+            fprintf(stderr, "UCIFastReader: serving %ls from binary parse cache (%lu records)\n",
+                m_dataFilePath.c_str(), (unsigned long)cache->NumRecords());
+    }
+    else
+    {
+        if (m_traceLevel > 0)
+            fprintf(stderr, "UCIFastReader: building binary parse cache %ls...\n",
+                UCIParseCache<ElemType, LabelType>::CachePath(m_dataFilePath).c_str());
+
+        typename UCIParseCache<ElemType, LabelType>::Writer writer;
+        bool success = writer.Create(m_dataFilePath, m_featureCount, m_labelColumns);
+
+        m_parser->SetFilePosition(0);
+        const size_t chunkRecords = 16384;
+        std::vector<ElemType> features;
+        std::vector<LabelType> labels;
+        while (success)
+        {
+            features.clear();
+            labels.clear();
+            size_t numRead = m_parser->Parse(chunkRecords, &features, &labels);
+            success = writer.Append(features, labels, numRead);
+            if (numRead < chunkRecords)
+                break;
+        }
+        success = success && writer.Finalize();
+        m_parser->SetFilePosition(0);
+
+        if (!success || !cache->Open(m_dataFilePath, m_featureCount, m_labelColumns))
+        {
+            fprintf(stderr, "WARNING: UCIFastReader: could not build binary parse cache for %ls, falling back to parsing\n",
+                m_dataFilePath.c_str());
+            m_cacheBinaryData = false;
+            return;
+        }
+    }
+
+    m_parseCache = cache;
 }
 
 //SetupEpoch - Setup the proper position in the file, and other variable settings to start a particular epoch
@@ -580,12 +641,20 @@ void UCIFastReader<ElemType>::SetupEpoch()
         // don't know the total number of samples yet, so count them
         if (m_totalSamples == 0)
         {
-            if (m_traceLevel > 0)
-                fprintf(stderr, "UCIFastReader: Starting at epoch %lu, counting lines to determine record count...\n", (unsigned long) m_epoch);
-            m_parser->SetParseMode(ParseLineCount);
-            m_totalSamples = m_parser->Parse(size_t(-1), NULL, NULL);
-            m_parser->SetParseMode(ParseNormal);
-            m_parser->SetFilePosition(0);
+            if (m_parseCache != nullptr)
+            {
+                // the cache already knows the record count
+                m_totalSamples = m_parseCache->NumRecords();
+            }
+            else
+            {
+                if (m_traceLevel > 0)
+                    fprintf(stderr, "UCIFastReader: Starting at epoch %lu, counting lines to determine record count...\n", (unsigned long) m_epoch);
+                m_parser->SetParseMode(ParseLineCount);
+                m_totalSamples = m_parser->Parse(size_t(-1), NULL, NULL);
+                m_parser->SetParseMode(ParseNormal);
+                m_parser->SetFilePosition(0);
+            }
             m_mbStartSample = 0;
             UpdateDataVariables(0); // update all the variables since we read to the end...
             if (m_traceLevel > 0)
@@ -611,7 +680,7 @@ void UCIFastReader<ElemType>::SetupEpoch()
             bool endReached = m_endReached;
             if (!endReached)
             {
-                if (!m_parser->HasMoreData())
+                if (!(m_parseCache != nullptr ? m_parseCache->HasMoreData() : m_parser->HasMoreData()))
                 {
                     endReached = true;
                     UpdateDataVariables(mbStartSample);
@@ -629,16 +698,24 @@ void UCIFastReader<ElemType>::SetupEpoch()
         // not the right position, need to get there
         else
         {
-            // if we are already past the desired record, start at the beginning again
-            if (currentFileRecord > fileRecord)
+            if (m_parseCache != nullptr)
             {
-                m_parser->SetFilePosition(0);
-                currentFileRecord = 0;
+                // cache records are directly addressable, no need to skip over lines
+                m_parseCache->SetRecordPosition(fileRecord);
+            }
+            else
+            {
+                // if we are already past the desired record, start at the beginning again
+                if (currentFileRecord > fileRecord)
+                {
+                    m_parser->SetFilePosition(0);
+                    currentFileRecord = 0;
+                }
+                fprintf(stderr, "reading from record %lu to %lu to be positioned properly for epoch\n", (unsigned long) currentFileRecord, (unsigned long) fileRecord);
+                m_parser->SetParseMode(ParseLineCount);
+                m_parser->Parse(fileRecord - currentFileRecord, NULL, NULL);
+                m_parser->SetParseMode(ParseNormal);
             }
-            fprintf(stderr, "reading from record %lu to %lu to be positioned properly for epoch\n", (unsigned long) currentFileRecord, (unsigned long) fileRecord);
-            m_parser->SetParseMode(ParseLineCount);
-            m_parser->Parse(fileRecord - currentFileRecord, NULL, NULL);
-            m_parser->SetParseMode(ParseNormal);
             if (!m_labelFileToWrite.empty())
             {
                 fprintf(stderr, "WARNING: file %ls NOT written to disk, label file will only be written when starting epochs at the beginning of the dataset\n", m_labelFileToWrite.c_str());
@@ -749,6 +826,11 @@ void UCIFastReader<ElemType>::StartDistributedMinibatchLoop(size_t mbSize, size_
     else if (m_labelType != labelNone)
         m_labelData.reserve(m_labelDim * epochSize);
 
+    // open (or build on first use) the binary parse cache so the epochs can be
+    // served without parsing; not applicable when the legacy cache writer is active
+    if (m_cacheBinaryData && m_parseCache == nullptr && m_cachingWriter == nullptr && !mOneLinePerFile)
+        EnsureParseCache();
+
     SetupEpoch();
 }
 
@@ -12,6 +12,7 @@
 #include "RandomOrdering.h"
 #include <future>
 #include "UCIParser.h"
+#include "UCIParseCache.h"
 #include <string>
 #include <map>
 #include <vector>
@@ -101,6 +102,14 @@ class UCIFastReader : public DataReaderBase
     void InitCache(const ConfigParameters& config);
     void InitCache(const ScriptableObjects::IConfigRecord& config);
 
+    // binary parse cache: sidecar file next to the source holding the parsed
+    // column-major feature matrix and label strings, invalidated by source size/mtime
+    bool m_cacheBinaryData;            // config flag 'cacheBinaryData'
+    std::wstring m_dataFilePath;       // path of the source file (for the sidecar)
+    size_t m_labelColumns;             // label entries per record as parsed
+    std::shared_ptr<UCIParseCache<ElemType, LabelType>> m_parseCache; // non-null when serving from the cache
+    void EnsureParseCache();
+
     size_t RandomizeSweep(size_t epochSample);
     bool Randomize()
     {
@@ -0,0 +1,456 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+// UCIParseCache.h - binary sidecar cache for parsed UCI data.
+//
+// Parsing the ASCII floats dominates per-epoch reader cost for tabular data. The cache
+// persists the parsed column-major feature matrix (one sample per column, columns
+// contiguous) together with the raw label strings to a '<file>.cache' sidecar next to
+// the source. Subsequent epochs (and runs) are served straight from a read-only mapping
+// of that file with zero parsing. The cache records the size and modification time of
+// the source file and is silently rebuilt when either changes.
+//
+#pragma once
+#include "stdafx.h"
+#include "Basics.h"
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+// Windows or Posix? Follows the same split as SparsePCReader for file mapping.
+#ifdef __WINDOWS__
+#define UCIPARSECACHE_USE_WINDOWS_API
+#endif
+
+#ifndef UCIPARSECACHE_USE_WINDOWS_API
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// File layout: Header, then the feature block (numRecords * featureDim elements,
+// column-major), then the label block (one length-prefixed string per label entry).
+// All fields are machine-native; the cache is a local artifact, not an interchange format.
+struct UCIParseCacheHeader
+{
+    char magic[8];         // "UCICACHE"
+    uint32_t version;      // format version
+    uint32_t elemSize;     // sizeof element type the features were parsed into
+    uint64_t featureDim;   // features per record
+    uint64_t labelDim;     // label entries per record
+    uint64_t numRecords;   // records in the cache
+    int64_t sourceSize;    // size of the source file when the cache was written
+    int64_t sourceTime;    // modification time of the source file when the cache was written
+    uint64_t labelBytes;   // total size of the label block
+};
+
+// UCIParseCache - read-only view of a parse cache, plus a Writer to build one.
+// Mirrors the slice of the UCIParser interface that UCIFastReader drives
+// (sequential retrieval with explicit repositioning), so the reader can swap
+// the parser for the cache without changing its epoch logic.
+template <typename NumType, typename LabelType>
+class UCIParseCache
+{
+public:
+    static const uint32_t c_version = 1;
+
+    UCIParseCache()
+        : m_dataBuffer(nullptr), m_mappedSize(0), m_featureDim(0), m_labelDim(0),
+          m_numRecords(0), m_nextRecord(0)
+    {
+#ifdef UCIPARSECACHE_USE_WINDOWS_API
+        m_hndl = INVALID_HANDLE_VALUE;
+        m_filemap = NULL;
+#else
+        m_hndl = -1;
+#endif
+    }
+
+    ~UCIParseCache()
+    {
+        Close();
+    }
+
+    // Path of the sidecar cache for a source file.
+    static std::wstring CachePath(const std::wstring& sourcePath)
+    {
+        return sourcePath + L".cache";
+    }
+
+    // Size and modification time of a file, used to detect stale caches.
+    static bool GetFileSignature(const std::wstring& path, int64_t& size, int64_t& time)
+    {
+#ifdef UCIPARSECACHE_USE_WINDOWS_API
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attributes))
+            return false;
+        size = ((int64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+        time = ((int64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+#else
+        struct stat buf;
+        if (stat(msra::strfun::utf8(path).c_str(), &buf) != 0)
+            return false;
+        size = (int64_t)buf.st_size;
+        time = (int64_t)buf.st_mtime;
+#endif
+        return true;
+    }
+
+    // Opens the cache for the given source file; returns false if the cache is
+    // missing, stale (source size/mtime changed), or does not match the
+    // requested element size and dimensions.
+    bool Open(const std::wstring& sourcePath, size_t featureDim, size_t labelDim)
+    {
+        Close();
+
+        int64_t sourceSize, sourceTime;
+        if (!GetFileSignature(sourcePath, sourceSize, sourceTime))
+            return false;
+
+        if (!Map(CachePath(sourcePath)))
+            return false;
+
+        UCIParseCacheHeader header;
+        if (m_mappedSize < sizeof(header))
+            return CloseAndFail();
+        memcpy(&header, m_dataBuffer, sizeof(header));
+
+        if (memcmp(header.magic, "UCICACHE", sizeof(header.magic)) != 0 ||
+            header.version != c_version ||
+            header.elemSize != sizeof(NumType) ||
+            header.featureDim != featureDim ||
+            header.labelDim != labelDim ||
+            header.sourceSize != sourceSize ||
+            header.sourceTime != sourceTime)
+        {
+            return CloseAndFail();
+        }
+
+        uint64_t featureBytes = header.numRecords * header.featureDim * sizeof(NumType);
+        if (m_mappedSize < sizeof(header) + featureBytes + header.labelBytes)
+            return CloseAndFail();
+
+        m_featureDim = (size_t)header.featureDim;
+        m_labelDim = (size_t)header.labelDim;
+        m_numRecords = (size_t)header.numRecords;
+        m_nextRecord = 0;
+
+        // Index the variable-length label strings so that records can be
+        // retrieved from any position. Walking the length prefixes is cheap
+        // compared to parsing; the index costs 8 bytes per label entry.
+        m_labelOffsets.clear();
+        if (m_labelDim != 0)
+        {
+            m_labelOffsets.reserve(m_numRecords * m_labelDim);
+            uint64_t offset = sizeof(header) + featureBytes;
+            uint64_t end = offset + header.labelBytes;
+            for (size_t i = 0; i < m_numRecords * m_labelDim; ++i)
+            {
+                if (offset + sizeof(uint32_t) > end)
+                    return CloseAndFail(); // truncated label block
+                m_labelOffsets.push_back(offset);
+                uint32_t length;
+                memcpy(&length, m_dataBuffer + offset, sizeof(length));
+                offset += sizeof(length) + length;
+                if (offset > end)
+                    return CloseAndFail();
+            }
+        }
+
+        return true;
+    }
+
+    size_t NumRecords() const
+    {
+        return m_numRecords;
+    }
+
+    // Repositions the retrieval cursor, the cache equivalent of UCIParser::SetFilePosition.
+    void SetRecordPosition(size_t record)
+    {
+        m_nextRecord = min(record, m_numRecords);
+    }
+
+    bool HasMoreData() const
+    {
+        return m_nextRecord < m_numRecords;
+    }
+
+    // Appends up to recordsRequested records to the vectors, advancing the cursor;
+    // same contract as UCIParser::Parse, returns the number of records retrieved.
+    size_t Retrieve(size_t recordsRequested, std::vector<NumType>* numbers, std::vector<LabelType>* labels)
+    {
+        size_t recordsToRead = min(recordsRequested, m_numRecords - m_nextRecord);
+        if (recordsToRead == 0)
+            return 0;
+
+        const NumType* features = (const NumType*)(m_dataBuffer + sizeof(UCIParseCacheHeader)) + m_nextRecord * m_featureDim;
+        numbers->insert(numbers->end(), features, features + recordsToRead * m_featureDim);
+
+        if (labels != nullptr && m_labelDim != 0)
+        {
+            for (size_t i = m_nextRecord * m_labelDim, end = (m_nextRecord + recordsToRead) * m_labelDim; i < end; ++i)
+            {
+                const char* entry = m_dataBuffer + m_labelOffsets[i];
+                uint32_t length;
+                memcpy(&length, entry, sizeof(length));
+                labels->push_back(LabelType(entry + sizeof(length), length));
+            }
+        }
+
+        m_nextRecord += recordsToRead;
+        return recordsToRead;
+    }
+
+    // Writer - builds a cache in a single streaming pass over the parser output.
+    // Features are streamed to a temporary file; the (small) label block is buffered
+    // in memory and written on Finalize together with the final header, then the
+    // temporary file is moved into place so that concurrent readers never observe
+    // a partially written cache.
+    class Writer
+    {
+    public:
+        Writer() : m_file(nullptr), m_numRecords(0), m_featureDim(0), m_labelDim(0)
+        {
+        }
+
+        ~Writer()
+        {
+            Abort();
+        }
+
+        bool Create(const std::wstring& sourcePath, size_t featureDim, size_t labelDim)
+        {
+            if (!GetFileSignature(sourcePath, m_sourceSize, m_sourceTime))
+                return false;
+
+            m_cachePath = CachePath(sourcePath);
+            m_tempPath = m_cachePath + L".tmp";
+            m_file = OpenFile(m_tempPath, "wb");
+            if (m_file == nullptr)
+                return false;
+
+            m_featureDim = featureDim;
+            m_labelDim = labelDim;
+
+            // Header placeholder, rewritten with the real counts on Finalize.
+            UCIParseCacheHeader header = {};
+            return fwrite(&header, sizeof(header), 1, m_file) == 1;
+        }
+
+        // Appends one parsed chunk; numRecords is what UCIParser::Parse returned for it.
+        bool Append(const std::vector<NumType>& features, const std::vector<LabelType>& labels, size_t numRecords)
+        {
+            // A mismatch means the parser hit malformed data; leave such files uncached.
+            if (features.size() != numRecords * m_featureDim || labels.size() != numRecords * m_labelDim)
+                return false;
+
+            if (!features.empty() &&
+                fwrite(features.data(), sizeof(NumType), features.size(), m_file) != features.size())
+            {
+                return false;
+            }
+
+            for (const auto& label : labels)
+            {
+                uint32_t length = (uint32_t)label.size();
+                const char* bytes = (const char*)&length;
+                m_labelBuffer.insert(m_labelBuffer.end(), bytes, bytes + sizeof(length));
+                m_labelBuffer.insert(m_labelBuffer.end(), label.data(), label.data() + length);
+            }
+
+            m_numRecords += numRecords;
+            return true;
+        }
+
+        // Writes the label block and final header and moves the cache into place.
+        bool Finalize()
+        {
+            if (!m_labelBuffer.empty() &&
+                fwrite(m_labelBuffer.data(), 1, m_labelBuffer.size(), m_file) != m_labelBuffer.size())
+            {
+                return false;
+            }
+
+            UCIParseCacheHeader header;
+            memcpy(header.magic, "UCICACHE", sizeof(header.magic));
+            header.version = c_version;
+            header.elemSize = sizeof(NumType);
+            header.featureDim = m_featureDim;
+            header.labelDim = m_labelDim;
+            header.numRecords = m_numRecords;
+            header.sourceSize = m_sourceSize;
+            header.sourceTime = m_sourceTime;
+            header.labelBytes = m_labelBuffer.size();
+
+            if (fseek(m_file, 0, SEEK_SET) != 0 ||
+                fwrite(&header, sizeof(header), 1, m_file) != 1 ||
+                fclose(m_file) != 0)
+            {
+                m_file = nullptr;
+                Abort();
+                return false;
+            }
+            m_file = nullptr;
+
+            if (!RenameFile(m_tempPath, m_cachePath))
+            {
+                Abort();
+                return false;
+            }
+            return true;
+        }
+
+        // Drops a partially written cache.
+        void Abort()
+        {
+            if (m_file != nullptr)
+            {
+                fclose(m_file);
+                m_file = nullptr;
+            }
+            if (!m_tempPath.empty())
+            {
+                RemoveFile(m_tempPath);
+                m_tempPath.clear();
+            }
+        }
+
+    private:
+        static FILE* OpenFile(const std::wstring& path, const char* mode)
+        {
+#ifdef UCIPARSECACHE_USE_WINDOWS_API
+            std::wstring wideMode(mode, mode + strlen(mode));
+            return _wfopen(path.c_str(), wideMode.c_str());
+#else
+            return fopen(msra::strfun::utf8(path).c_str(), mode);
+#endif
+        }
+
+        static bool RenameFile(const std::wstring& from, const std::wstring& to)
+        {
+#ifdef UCIPARSECACHE_USE_WINDOWS_API
+            _wunlink(to.c_str()); // rename does not overwrite on Windows
+            return _wrename(from.c_str(), to.c_str()) == 0;
+#else
+            return rename(msra::strfun::utf8(from).c_str(), msra::strfun::utf8(to).c_str()) == 0;
+#endif
+        }
+
+        static void RemoveFile(const std::wstring& path)
+        {
+#ifdef UCIPARSECACHE_USE_WINDOWS_API
+            _wunlink(path.c_str());
+#else
+            unlink(msra::strfun::utf8(path).c_str());
+#endif
+        }
+
+        FILE* m_file;
+        std::wstring m_cachePath;
+        std::wstring m_tempPath;
+        std::vector<char> m_labelBuffer;
+        size_t m_numRecords;
+        size_t m_featureDim;
+        size_t m_labelDim;
+        int64_t m_sourceSize;
+        int64_t m_sourceTime;
+    };
+
+private:
+    DISABLE_COPY_AND_MOVE(UCIParseCache);
+
+    bool Map(const std::wstring& path)
+    {
+#ifdef UCIPARSECACHE_USE_WINDOWS_API
+        m_hndl = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_hndl == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(m_hndl, &fileSize))
+            return CloseAndFail();
+        m_mappedSize = (size_t)fileSize.QuadPart;
+
+        m_filemap = CreateFileMapping(m_hndl, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m_filemap == NULL)
+            return CloseAndFail();
+
+        m_dataBuffer = (char*)MapViewOfFile(m_filemap, FILE_MAP_READ, 0, 0, 0);
+        if (m_dataBuffer == nullptr)
+            return CloseAndFail();
+#else
+        m_hndl = open(msra::strfun::utf8(path).c_str(), O_RDONLY);
+        if (m_hndl == -1)
+            return false;
+
+        struct stat sb;
+        if (fstat(m_hndl, &sb) == -1)
+            return CloseAndFail();
+        m_mappedSize = (size_t)sb.st_size;
+
+        m_dataBuffer = (char*)mmap(nullptr, m_mappedSize, PROT_READ, MAP_PRIVATE, m_hndl, 0);
+        if (m_dataBuffer == MAP_FAILED)
+        {
+            m_dataBuffer = nullptr;
+            return CloseAndFail();
+        }
+#endif
+        return true;
+    }
+
+    bool CloseAndFail()
+    {
+        Close();
+        return false;
+    }
+
+    void Close()
+    {
+#ifdef UCIPARSECACHE_USE_WINDOWS_API
+        if (m_dataBuffer != nullptr)
+            UnmapViewOfFile(m_dataBuffer);
+        if (m_filemap != NULL)
+            CloseHandle(m_filemap);
+        if (m_hndl != INVALID_HANDLE_VALUE)
+            CloseHandle(m_hndl);
+        m_filemap = NULL;
+        m_hndl = INVALID_HANDLE_VALUE;
+#else
+        if (m_dataBuffer != nullptr)
+            munmap(m_dataBuffer, m_mappedSize);
+        if (m_hndl != -1)
+            close(m_hndl);
+        m_hndl = -1;
+#endif
+        m_dataBuffer = nullptr;
+        m_mappedSize = 0;
+        m_labelOffsets.clear();
+        m_numRecords = m_nextRecord = 0;
+    }
+
+#ifdef UCIPARSECACHE_USE_WINDOWS_API
+    HANDLE m_hndl;
+    HANDLE m_filemap;
+#else
+    int m_hndl;
+#endif
+    char* m_dataBuffer;
+    size_t m_mappedSize;
+
+    size_t m_featureDim;
+    size_t m_labelDim;
+    size_t m_numRecords;
+    size_t m_nextRecord;
+
+    // File offset of each label entry (length prefix), numRecords * labelDim entries.
+    std::vector<uint64_t> m_labelOffsets;
+};
+
+} } }
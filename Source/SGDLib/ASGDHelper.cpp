@@ -186,10 +186,14 @@ public:
         // because the parameter server will minus the delta on the server, so that we should send the minus initial model to the server.
         std::transform(m_deltaArray, m_deltaArray + m_totalModelSize, m_deltaArray, std::bind1st(std::multiplies<ElemType>(), -factor));
 
-        m_workerArray->Add(m_deltaArray, m_totalModelSize);
-        m_workerArray->Get(m_deltaArray, m_totalModelSize);
+        for (int widx = 0; widx < m_tableCount; widx++)
+        {
+            m_workerTables[widx]->Add(m_deltaArray + m_tableOffsets[widx], m_tableLength[widx]);
+            m_workerTables[widx]->Get(m_deltaArray + m_tableOffsets[widx], m_tableLength[widx]);
+        }
         WaitAll();
-        m_workerArray->Get(m_deltaArray, m_totalModelSize);
+        for (int widx = 0; widx < m_tableCount; widx++)
+            m_workerTables[widx]->Get(m_deltaArray + m_tableOffsets[widx], m_tableLength[widx]);
 
         if (std::equal(m_deltaArray, m_deltaArray + m_totalModelSize, m_cpuAsyncBuffer[0]))
             fprintf(stderr, "multiverso initial model loaded.\n");
@@ -298,8 +302,7 @@ public:
 
                 ElemType* px = m_deltaArray;
                 ElemType* py = m_cpuAsyncBuffer[m_bufferIndexInUse];
-                m_workerArray->AddAsync(px, m_totalModelSize);
-                m_workerArray->Get(py, m_totalModelSize);
+                PushDeltasAndPullModel(px, py);
 
                 threadTimer.Stop();
                 if (m_traceLevel > 3)
@@ -339,8 +342,7 @@ public:
 
                 ElemType* px = m_deltaArray;
                 ElemType* py = m_cpuAsyncBuffer[t_cacheIdx];
-                m_workerArray->AddAsync(px, m_totalModelSize);
-                m_workerArray->Get(py, m_totalModelSize);
+                PushDeltasAndPullModel(px, py);
 
             });
 #endif
@@ -389,8 +391,7 @@ public:
 
             ElemType* px = m_deltaArray;
             ElemType* py = m_cpuAsyncBuffer[0];
-            m_workerArray->AddAsync(px, m_totalModelSize);
-            m_workerArray->Get(py, m_totalModelSize);
+            PushDeltasAndPullModel(px, py);
 
             m_reportTimer.Stop();
             if (m_traceLevel > 3)
@@ -455,8 +456,14 @@ private:
         // cacluate total of learnable node's size
         m_totalModelSize = accumulate(m_tableLength.begin(), m_tableLength.end(), 0);
 
-        m_serverArray = new multiverso::ArrayServer<ElemType>(m_totalModelSize);
-        m_workerArray = new multiverso::ArrayWorker<ElemType>(m_totalModelSize);
+        // one table per learnable node rather than one monolithic array: Multiverso range-partitions
+        // every table across the server ranks (so no single server holds the whole model), and the
+        // per-node granularity lets PushDeltasAndPullModel() skip nodes that did not change
+        for (size_t len : m_tableLength)
+        {
+            m_serverTables.push_back(new multiverso::ArrayServer<ElemType>(len));
+            m_workerTables.push_back(new multiverso::ArrayWorker<ElemType>(len));
+        }
 
         multiverso::MV_Barrier();
 
@@ -483,6 +490,26 @@ private:
 #endif
     }
 
+    // push the per-node deltas and pull the shared model back
+    // Nodes whose delta is all-zero -- frozen layers, or nodes whose (sparse) gradient touched no
+    // column since the last sync -- are not pushed at all, so they cost no upstream bandwidth.
+    // The pull stays dense per table: other workers may have changed any entry.
+    void PushDeltasAndPullModel(ElemType* deltaArray, ElemType* modelBuffer)
+    {
+        for (int widx = 0; widx < m_tableCount; widx++)
+        {
+            ElemType* delta = deltaArray + m_tableOffsets[widx];
+            size_t len = m_tableLength[widx];
+            bool touched = false;
+            for (size_t k = 0; k < len && !touched; k++)
+                touched = (delta[k] != 0);
+            if (touched)
+                m_workerTables[widx]->AddAsync(delta, len);
+        }
+        for (int widx = 0; widx < m_tableCount; widx++)
+            m_workerTables[widx]->Get(modelBuffer + m_tableOffsets[widx], m_tableLength[widx]);
+    }
+
     float DecayCoefficient()
     {
         float f = 1.f;
@@ -548,8 +575,8 @@ private:
 
     }
 
-    multiverso::ArrayServer<ElemType>* m_serverArray;
-    multiverso::ArrayWorker<ElemType>* m_workerArray;
+    std::vector<multiverso::ArrayServer<ElemType>*> m_serverTables; // one table per learnable node
+    std::vector<multiverso::ArrayWorker<ElemType>*> m_workerTables;
 
     thread * m_aysncBufferThread;
     bool m_doesEveryNodesShouldSynced;
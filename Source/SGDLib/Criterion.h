@@ -99,6 +99,32 @@ struct CriterionAccumulator
     {
         return Accumulate(i, numSamplesInMinibatch, /*reset=*/true);
     }
+    // retrieve all accumulated results at once as (numerator, denominator) pairs
+    // This pulls the whole accumulator row off the device in a single transfer; calling
+    // GetCriterion() in a loop instead costs one device sync per criterion.
+    std::vector<EpochCriterion> GetCriteria() const
+    {
+        size_t numCriteria = m_aggregateSampleCounts.size();
+        std::vector<EpochCriterion> criteria(numCriteria, EpochCriterion(0, 0));
+
+        // if nothing has been accumulated, the matrix must not be looked at
+        // (cf. the matching per-element check in GetCriterion())
+        bool anySamples = false;
+        for (size_t i = 0; i < numCriteria; i++)
+            anySamples = anySamples || (m_aggregateSampleCounts[i] != 0);
+        if (!anySamples)
+            return criteria;
+
+        std::vector<ElemType> values(numCriteria);
+        m_aggregateCriterionValues->CopySection(1, numCriteria, values.data(), /*colStride=*/1);
+        for (size_t i = 0; i < numCriteria; i++)
+        {
+            if (m_aggregateSampleCounts[i] != 0) // (entries without samples are invalid and stay (0, 0))
+                criteria[i] = EpochCriterion(values[i], m_aggregateSampleCounts[i]);
+        }
+        return criteria;
+    }
+
     // retrieve an accumulated result as a pair (numerator, denominator)
     EpochCriterion GetCriterion(size_t i) const
     {
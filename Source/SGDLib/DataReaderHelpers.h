@@ -529,10 +529,15 @@ namespace Microsoft { namespace MSR { namespace CNTK {
 
         void GetSubMinibatchToNet(size_t iSubminibatch)
         {
-            Matrices decimatedMatrices;
-            MBLayoutPtr decimatedLayout;
-            pair<size_t, size_t> seqRange = DataReaderHelpers::DecimateMinibatch<ElemType>(m_inputMatricesCache, decimatedMatrices, m_MBLayoutCache, decimatedLayout, m_numSubminibatches, iSubminibatch);
-            //  NOTE: deimatedMatrices must be released by caller
+            // decide the parallel-sequence range this sub-minibatch covers (same split as DecimateMinibatch())
+            size_t numParallelSequences = m_MBLayoutCache->GetNumParallelSequences();
+            size_t nT = m_MBLayoutCache->GetNumTimeSteps();
+            size_t st = numParallelSequences *  iSubminibatch      / m_numSubminibatches;
+            size_t en = numParallelSequences * (iSubminibatch + 1) / m_numSubminibatches;
+            en = en > numParallelSequences ? numParallelSequences : en;
+            en = (iSubminibatch + 1 == m_numSubminibatches) ? numParallelSequences : en;
+            size_t numNewParallelSequences = en - st;
+            pair<size_t, size_t> seqRange(st, en);
 
             // base on the seqRange, we do the decimation for lattices and related variables
             if (m_hasLattices)
@@ -546,14 +551,38 @@ namespace Microsoft { namespace MSR { namespace CNTK {
                     seqRange);
             }
 
-            // The following does m_netInputMatrixPtr = decimatedMatrices; with ownership shenanigans.
-            for (auto& x : decimatedMatrices)
+            // Write the sub-minibatch columns straight from the cache into the network's input
+            // matrices. The parallel sequences of a sub-minibatch are interleaved with those of its
+            // siblings within each time step, so the data forms a strided row block of the reshaped
+            // cache rather than a contiguous column span; a single strided slice-assignment per
+            // input extracts it, with no intermediate matrices materialized.
+            for (auto& x : m_inputMatricesCache)
             {
                 const wstring& name = x.first;
-                m_netInputMatrixPtr.GetInputMatrix<ElemType>(name).SetValue(decimatedMatrices.GetInputMatrix<ElemType>(name));
+                auto& mat = m_inputMatricesCache.GetInputMatrix<ElemType>(name);
+                size_t numRows = mat.GetNumRows();
+
+                if (nT != mat.GetNumCols() / numParallelSequences)
+                    LogicError("GetSubMinibatchToNet: MBLayout borked, GetNumTimeSteps() mismatches minibatch number of columns\n");
+
+                auto& netMat = m_netInputMatrixPtr.GetInputMatrix<ElemType>(name);
+                netMat.AssignRowSliceValuesOf(mat.Reshaped(numRows * numParallelSequences, nT), st * numRows, numNewParallelSequences * numRows);
+                netMat.Reshape(numRows, numNewParallelSequences * nT);
             }
 
-            m_netMBLayoutPtr->CopyFrom(decimatedLayout);
+            // slice the layout directly into the network's layout object, rather than building a
+            // temporary MBLayout and copying it over
+            m_netMBLayoutPtr->Init(numNewParallelSequences, nT);
+            m_netMBLayoutPtr->SetAxisName(m_MBLayoutCache->GetAxisName());
+            for (const auto& seq : m_MBLayoutCache->GetAllSequences())
+            {
+                if (seq.s >= st && seq.s < en)
+                {
+                    auto shiftedSeq = seq;
+                    shiftedSeq.s -= st; // these sequences have shifted up by 'st' sequences
+                    m_netMBLayoutPtr->AddSequence(shiftedSeq);
+                }
+            }
 
             for (auto& x : m_netStatefulNodes)
             {
@@ -19,6 +19,33 @@ public:
     // Returns a boolean indicating if any samples were processed
     virtual bool AggregateGradients(const std::vector<Matrix<ElemType>*>& gradients, DistGradHeader* headerCPU, bool resetState) = 0;
 
+    // Bucketed aggregation, overlapping the gradient exchange with the backward pass. The driver
+    // calls BeginBucketedAggregation() before backpropagation with all gradients listed in the
+    // order the backward pass will finalize them, NotifyGradientComplete() as each gradient
+    // receives its last contribution, and CompleteBucketedAggregation() after backpropagation.
+    // The aggregator reduces each filled bucket while the remaining gradients are still being
+    // computed. Aggregators that do not support this scheme keep the default implementation.
+    virtual bool SupportsBucketedAggregation() const
+    {
+        return false;
+    }
+
+    virtual void BeginBucketedAggregation(const std::vector<Matrix<ElemType>*>& /*gradients*/, int /*numEvalNodes*/, bool /*resetState*/)
+    {
+        LogicError("BeginBucketedAggregation: Bucketed gradient aggregation is not supported by this aggregator!");
+    }
+
+    virtual void NotifyGradientComplete(Matrix<ElemType>* /*gradient*/)
+    {
+        LogicError("NotifyGradientComplete: Bucketed gradient aggregation is not supported by this aggregator!");
+    }
+
+    // Returns a boolean indicating if any samples were processed
+    virtual bool CompleteBucketedAggregation(DistGradHeader* /*headerCPU*/)
+    {
+        LogicError("CompleteBucketedAggregation: Bucketed gradient aggregation is not supported by this aggregator!");
+    }
+
     size_t NumProc()
     {
         return m_mpi->NumNodesInUse();
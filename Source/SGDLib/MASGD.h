@@ -327,7 +327,8 @@ namespace Microsoft { namespace MSR { namespace CNTK {
     template<typename ElemType>
     class BasicModelAveragingSGD : public IMASGD<ElemType>
     {
-        typedef IMASGD<ElemType> Base; 
+        typedef IMASGD<ElemType> Base;
+    protected:
         using Base::m_pMPI;
         using Base::DownCast;
 
@@ -398,10 +399,162 @@ namespace Microsoft { namespace MSR { namespace CNTK {
                 secondsOnCommunication += (float)commTimer.ElapsedSeconds();
                 // 2.1.5. set value 
                 pNode->Value().SetValue(mat.GetNumRows(), mat.GetNumCols(), mat.GetDeviceId(), px.get());
-                // 2.1.6. clean up 
+                // 2.1.6. clean up
                 //delete[]px;
             }
         }
     };
 
+    // Overlapped variant of model averaging.
+    // Instead of blocking on the parameter allreduce at every sync point, the allreduce is kicked off
+    // asynchronously against a shadow copy of the parameters and training continues on the local model.
+    // At the next sync point the completed average is installed, with the local progress made during the
+    // sync window re-applied on top (Value += average - shadow). This makes the averaged model one sync
+    // period stale but hides the full communication latency behind training, which pays off on
+    // high-latency (e.g. cross-site) clusters.
+    template<typename ElemType>
+    class OverlappedModelAveragingSGD : public BasicModelAveragingSGD<ElemType>
+    {
+        typedef BasicModelAveragingSGD<ElemType> Base;
+        using Base::m_pMPI;
+        using Base::DownCast;
+
+    public:
+        OverlappedModelAveragingSGD(const MPIWrapperPtr& pMPI, size_t reportFreq, DEVICEID_TYPE devID)
+            : Base(pMPI, reportFreq, devID), m_aggregationInFlight(false), m_epochEndReached(false)
+        {
+            fprintf(stderr, "ModelAveraging will overlap the parameter exchange with training\n");
+        }
+
+        void ModelAggregationProcessing(
+            size_t samplesSinceLastSync,                                       /* in */
+            const std::list<ComputationNodeBasePtr>&  learnableNodes,          /* in/out */
+            std::list<Matrix<ElemType>>&              smoothedGradient,        /* in/out */
+            size_t&                                   totalSamplesProcessed,   /* out */
+            float&                                    secondsOnCommunication   /* out */) override
+        {
+            if (m_epochEndReached)
+            {
+                // the epoch-end aggregation must complete in place -- the model may be saved right after
+                Base::ModelAggregationProcessing(samplesSinceLastSync, learnableNodes, smoothedGradient, totalSamplesProcessed, secondsOnCommunication);
+                return;
+            }
+
+            secondsOnCommunication = 0.0f;
+
+            //----------------------------------------
+            // 1. install the average that was kicked off at the previous sync point, if any
+            //----------------------------------------
+            CompletePendingAggregation(learnableNodes, secondsOnCommunication);
+
+            //----------------------------------------
+            // 2. communicate with other nodes to negotiate contribution weights (cheap: one integer)
+            //----------------------------------------
+            float factor = 0;
+            int   nTotalSamples = samplesSinceLastSync;
+            Timer commTimer;
+            commTimer.Start();
+            m_pMPI->AllReduce(&nTotalSamples, 1);
+            commTimer.Stop();
+            secondsOnCommunication += (float)commTimer.ElapsedSeconds();
+
+            if (nTotalSamples <= 0)
+            {
+                // prepare for overflow
+                factor = 1.0f / m_pMPI->NumNodesInUse();
+                totalSamplesProcessed = samplesSinceLastSync * m_pMPI->NumNodesInUse();
+                // give an estimated one
+            }
+            else
+            {
+                factor = (samplesSinceLastSync + 0.0f) / nTotalSamples;
+                totalSamplesProcessed = nTotalSamples;
+            }
+
+            //----------------------------------------
+            // 3. kick off the parameter allreduce asynchronously; training continues on the local model
+            //----------------------------------------
+            commTimer.Restart();
+            for (auto& pBaseNode : learnableNodes)
+            {
+                if (!pBaseNode->IsParameterUpdateRequired())
+                {
+                    continue;
+                }
+                auto pNode = DownCast(pBaseNode);
+                // shadow copy: my parameters as of this sync point, needed to re-apply local progress later
+                m_shadows.push_back(pNode->Value().DeepClone());
+                // my weighted contribution, staged on the host for the in-place allreduce
+                Matrix<ElemType> mat(pNode->Value().DeepClone());
+                Matrix<ElemType>::Scale(factor, mat);
+                unique_ptr<ElemType[]> px(mat.CopyToArray());
+                size_t    nx = mat.GetNumElements();
+                m_requests.push_back(MPI_Request());
+                m_pMPI->AllReduceAsync(px.get(), nx, &m_requests.back());
+                m_buffers.push_back(std::move(px));
+            }
+            commTimer.Stop();
+            secondsOnCommunication += (float)commTimer.ElapsedSeconds();
+            m_aggregationInFlight = true;
+        }
+
+        void OnEpochEnd(const std::list<ComputationNodeBasePtr>&    LearnableNodes,
+                        std::list<Matrix<ElemType>>&                smoothedGradient,
+                        size_t                                      samplesSinceLastSync
+                        ) override
+        {
+            float secondsOnCommunication = 0.0f;
+            CompletePendingAggregation(LearnableNodes, secondsOnCommunication);
+            m_epochEndReached = true; // force the final aggregation through the blocking path
+            Base::OnEpochEnd(LearnableNodes, smoothedGradient, samplesSinceLastSync);
+            m_epochEndReached = false;
+        }
+
+    private:
+        // wait for the in-flight allreduce and install the averaged model, keeping the local progress
+        // made since the allreduce was started
+        void CompletePendingAggregation(const std::list<ComputationNodeBasePtr>& learnableNodes, float& secondsOnCommunication)
+        {
+            if (!m_aggregationInFlight)
+            {
+                return;
+            }
+            Timer commTimer;
+            commTimer.Start();
+            m_pMPI->WaitAll(m_requests);
+            commTimer.Stop();
+            secondsOnCommunication += (float)commTimer.ElapsedSeconds();
+
+            auto shadowIter = m_shadows.begin();
+            size_t i = 0;
+            for (auto& pBaseNode : learnableNodes)
+            {
+                if (!pBaseNode->IsParameterUpdateRequired())
+                {
+                    continue;
+                }
+                auto pNode = DownCast(pBaseNode);
+                Matrix<ElemType>& shadow = *shadowIter;
+                // average - shadow = what the collective changed relative to my snapshot;
+                // adding it onto the live parameters keeps the updates made during the sync window
+                Matrix<ElemType> average(shadow.GetDeviceId());
+                average.SetValue(shadow.GetNumRows(), shadow.GetNumCols(), shadow.GetDeviceId(), m_buffers[i].get());
+                average -= shadow;
+                pNode->Value() += average;
+                ++shadowIter;
+                ++i;
+            }
+            m_shadows.clear();
+            m_buffers.clear();
+            m_requests.clear();
+            m_aggregationInFlight = false;
+        }
+
+        std::list<Matrix<ElemType>>             m_shadows;  // per-node local parameters at allreduce kickoff
+        std::vector<unique_ptr<ElemType[]>>     m_buffers;  // per-node host buffers the allreduce runs over
+        std::vector<MPI_Request>                m_requests;
+        bool                                    m_aggregationInFlight;
+        bool                                    m_epochEndReached;
+    };
+
 } } }
@@ -11,6 +11,7 @@
 #include "Basics.h"
 #include "SGD.h"
 #include "NonlinearityNodes.h"          // for DropoutNode
+#include "PreComputeNodes.h"            // for PreComputedNodeBase (precompute cache)
 #include "SpecialPurposeNodes.h"        // for SequenceWithSoftmaxNode
 #include "DataReaderHelpers.h"
 #include "MatrixQuantizerImpl.h"
@@ -32,6 +33,7 @@
 
 #include "CNTKLibraryInternals.h"
 #include "SimpleDistGradAggregator.h"
+#include "TopKDistGradAggregator.h"
 #include "V2SimpleDistGradAggregator.h"
 #include "ProgressTracing.h"
 #include "PerformanceProfiler.h"
@@ -77,6 +79,9 @@ void SGD<ElemType>::Train(shared_ptr<ComputationNetwork> net, DEVICEID_TYPE devi
     // set tracing flags
     net->EnableNodeTracing(m_traceNodeNamesReal, m_traceNodeNamesCategory, m_traceNodeNamesSparse);
 
+    // set gradient checkpointing cut points (activation recomputation)
+    net->SetGradientCheckpointNodes(m_gradientCheckpointNodeNames);
+
     TrainOrAdaptModel(startEpoch, net, loadNetworkFromCheckpoint, net, nullptr, trainSetDataReader, validationSetDataReader);
 }
 
@@ -482,7 +487,8 @@ void SGD<ElemType>::TrainOrAdaptModel(int startEpoch, ComputationNetworkPtr net,
     if (isSequenceTrainingCriterion)
     {
         ComputationNetwork::SetSeqParam<ElemType>(net, criterionNodes[0], m_hSmoothingWeight, m_frameDropThresh, m_doReferenceAlign,
-                                                  m_seqGammarCalcAMF, m_seqGammarCalcLMF, m_seqGammarCalcWP, m_seqGammarCalcbMMIFactor, m_seqGammarCalcUsesMBR);
+                                                  m_seqGammarCalcAMF, m_seqGammarCalcLMF, m_seqGammarCalcWP, m_seqGammarCalcbMMIFactor, m_seqGammarCalcUsesMBR,
+                                                  m_seqGammarCalcNumLatticeDevices);
     }
 
     // Multiverso Warpper for ASGD logic init
@@ -779,6 +785,12 @@ void SGD<ElemType>::TrainOrAdaptModel(int startEpoch, ComputationNetworkPtr net,
             {
                 if (m_loadBestModel)
                 {
+                    // If the checkpoint being rolled back to is still streaming to disk in the
+                    // background on the main node, finish it, and only then let the other
+                    // ranks read it
+                    WaitForPendingCheckpointWrite();
+                    SynchronizeWorkers();
+
                     // roll back
                     auto bestModelPath = GetModelNameForEpoch(i - m_learnRateAdjustInterval);
                     LOGPRINTF(stderr, "Loading (rolling back to) previous model with best training-criterion value: %ls.\n", bestModelPath.c_str());
@@ -869,7 +881,7 @@ void SGD<ElemType>::TrainOrAdaptModel(int startEpoch, ComputationNetworkPtr net,
                     int epochToDelete = i - j;
                     LOGPRINTF(stderr, "SGD: removing model and checkpoint files for epoch %d after rollback to epoch %lu\n", epochToDelete + 1, (unsigned long)(i - m_learnRateAdjustInterval) + 1);  // report 1 based epoch number
                     _wunlink(GetModelNameForEpoch(epochToDelete).c_str());
-                    _wunlink(GetCheckPointFileNameForEpoch(epochToDelete).c_str());
+                    DeleteCheckPointFilesForEpoch(epochToDelete);
                 }
 
                 // Set i back to the loaded model
@@ -905,16 +917,27 @@ void SGD<ElemType>::TrainOrAdaptModel(int startEpoch, ComputationNetworkPtr net,
                     {
                         if (epochsSinceLastLearnRateAdjust != 1)
                         {
-                            _wunlink(GetCheckPointFileNameForEpoch(i - 1).c_str());
+                            DeleteCheckPointFilesForEpoch(i - 1);
                         }
                         if (epochsSinceLastLearnRateAdjust == m_learnRateAdjustInterval)
                         {
-                            _wunlink(GetCheckPointFileNameForEpoch(i - m_learnRateAdjustInterval).c_str());
+                            DeleteCheckPointFilesForEpoch(i - m_learnRateAdjustInterval);
                         }
                     }
                     else
                     {
-                        _wunlink(GetCheckPointFileNameForEpoch(i - 1).c_str());
+                        // With delta checkpointing the last full snapshot must outlive the
+                        // deltas encoded against it; it is deleted only after the next full
+                        // snapshot has landed on disk.
+                        if (i - 1 != m_checkpointDeltaBaseEpoch)
+                            DeleteCheckPointFilesForEpoch(i - 1);
+                        if (m_retiredCheckpointBaseEpoch >= 0)
+                        {
+                            // the superseding full snapshot may still be streaming to disk
+                            WaitForPendingCheckpointWrite();
+                            DeleteCheckPointFilesForEpoch(m_retiredCheckpointBaseEpoch);
+                            m_retiredCheckpointBaseEpoch = -1;
+                        }
                     }
                 }
             }
@@ -926,6 +949,18 @@ void SGD<ElemType>::TrainOrAdaptModel(int startEpoch, ComputationNetworkPtr net,
                 // Set i back to the loaded model
                 i -= m_learnRateAdjustInterval;
             }
+
+            // In sharded mode every rank contributes its slice of the checkpoint; this pairs
+            // up with the main node's SaveCheckPointInfo() call above (barrier inside)
+            if (UseShardedCheckpointing())
+                SaveCheckPointInfo(
+                    i,
+                    totalTrainingSamplesSeen,
+                    learnRatePerSample,
+                    smoothedGradients,
+                    smoothedCounts,
+                    prevCriterion,
+                    chosenMinibatchSize);
         }
 
         if (learnRatePerSample < 1e-12)
@@ -1066,6 +1101,13 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
     if (numSubminibatchesNeeded > 1)
         smbDispatcher.Init(net, learnableNodes, criterionNodes, evaluationNodes);
 
+    // Bucketed gradient aggregation allreduces each bucket of parameter gradients as soon as the
+    // backward pass has finalized it, overlapping the exchange with the rest of backprop.
+    // Sub-minibatching accumulates gradients across several backward passes, so gradients are not
+    // final when the backward sweep passes them and bucketing must stay off then. (The decision
+    // only depends on the configuration, so all workers post the same collective sequence.)
+    bool useBucketedGradientAggregation = useGradientAggregation && (numSubminibatchesNeeded <= 1) && m_distGradAgg->SupportsBucketedAggregation();
+
     // The following is a special feature only supported by the Kaldi2Reader for more efficient sequence training.
     // This attemps to compute the error signal for the whole utterance, which will
     // be fed to the neural network as features. Currently it is a workaround
@@ -1085,6 +1127,9 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
 
             if (m_bufferedAsyncGradientAggregation)
                 fprintf(stderr, ", BufferedAsyncGradientAggregation is ENABLED");
+
+            if (useBucketedGradientAggregation)
+                fprintf(stderr, ", BucketedGradientAggregation is ENABLED");
         }
 
         if (useAsyncGradientAggregation)
@@ -1114,6 +1159,12 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
     Timer timer;
     timer.Start();
 
+    // Per-phase exposed wall-clock time, accumulated over the epoch and reported at the end.
+    // Since GPU launches are asynchronous, each phase is charged the time the main thread
+    // actually waited in it; device work that overlaps a later phase shows up there instead.
+    Timer phaseTimer;
+    double epochReaderTime = 0, epochForwardTime = 0, epochBackwardTime = 0, epochAggregationTime = 0, epochUpdateTime = 0;
+
     // NOTE: the following two local matrices are not used in distGradAgg path
     // assume only one training criterion node for each epoch.
     // The criterion values are accumulated here over the minibatches (without having to pull them off the GPU).
@@ -1167,8 +1218,11 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
         size_t actualMBSize = 0;
 
         auto profGetMinibatch = ProfilerTimeBegin();
+        phaseTimer.Restart();
         bool wasDataRead = DataReaderHelpers::GetMinibatchIntoNetwork<ElemType>(*trainSetDataReader, net, criterionNodes[0],
                                                                                 useDistributedMBReading, useParallelTrain, *inputMatrices, actualMBSize, m_mpi);
+        phaseTimer.Stop();
+        epochReaderTime += phaseTimer.ElapsedSeconds();
 
         if (maxNumSamplesExceeded) // Dropping data.
             wasDataRead = false;
@@ -1203,6 +1257,53 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
         ComputationNetwork::BumpEvalTimeStamp(featureNodes);
         ComputationNetwork::BumpEvalTimeStamp(labelNodes);
 
+        // For bucketed gradient aggregation, start this minibatch's aggregation before backprop
+        // and let the backward sweep report each parameter gradient as it becomes final
+        if (useBucketedGradientAggregation)
+        {
+            if (learnParamsGradients.size() == 0)
+            {
+                // Lazily form the list of gradients to exchange, ordered by when the backward
+                // sweep finalizes them (reverse evaluation order), so buckets fill front to back.
+                // Learnable parameters the criterion does not reach go last; they never report
+                // completion and are flushed when the aggregation is completed.
+                std::list<ComputationNodeBasePtr> orderedLearnableNodes;
+                const auto& evalOrder = net->GetEvalOrder(criterionNodes[0]);
+                for (auto nodeIter = evalOrder.rbegin(); nodeIter != evalOrder.rend(); ++nodeIter)
+                {
+                    if (std::find(learnableNodes.begin(), learnableNodes.end(), *nodeIter) != learnableNodes.end())
+                        orderedLearnableNodes.push_back(*nodeIter);
+                }
+                for (auto nodeIter = learnableNodes.begin(); nodeIter != learnableNodes.end(); nodeIter++)
+                {
+                    if (std::find(orderedLearnableNodes.begin(), orderedLearnableNodes.end(), *nodeIter) == orderedLearnableNodes.end())
+                        orderedLearnableNodes.push_back(*nodeIter);
+                }
+
+                learnParamsGradients.reserve(orderedLearnableNodes.size());
+                for (auto nodeIter = orderedLearnableNodes.begin(); nodeIter != orderedLearnableNodes.end(); nodeIter++)
+                {
+                    ComputationNodePtr node = dynamic_pointer_cast<ComputationNode<ElemType>>(*nodeIter);
+                    if (node->IsParameterUpdateRequired())
+                    {
+                        Matrix<ElemType>* currParamsGradient = &(node->Gradient()); // TODO: we can use shared_ptrs now
+
+                        // Sometimes, in parallel training, the current node may not get any samples to process
+                        // In this case, the gradient matrix may not have been sized yet. If so, lets size it.
+                        if (currParamsGradient->GetNumCols() == 0)
+                        {
+                            Matrix<ElemType>* currParamsValues = &(node->Value());
+                            currParamsGradient->Resize(currParamsValues->GetNumRows(), currParamsValues->GetNumCols());
+                        }
+
+                        learnParamsGradients.push_back(currParamsGradient);
+                    }
+                }
+            }
+
+            m_distGradAgg->BeginBucketedAggregation(learnParamsGradients, (int)evaluationNodes.size(), isFirstMinibatch);
+        }
+
         if (actualMBSize > 0)
         {
             assert(wasDataRead);
@@ -1246,14 +1347,42 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
 
                 // compute eval node first since when gradient is computed the forward function values
                 // may be changed and need to be recomputed when gradient and function value share the same matrix
+                auto profForward = ProfilerTimeBegin();
+                auto cudaForward = ProfilerCudaTimeBegin();
+                phaseTimer.Restart();
                 net->ForwardProp(forwardPropRoots); // the bulk of this evaluation is reused in ComputeGradient() below
+                phaseTimer.Stop();
+                epochForwardTime += phaseTimer.ElapsedSeconds();
+                ProfilerCudaTimeEnd(cudaForward, "Forward Pass");
+                ProfilerTimeEnd(profForward, profilerEvtMainForward);
 
                 // ===========================================================
                 // backprop
                 // ===========================================================
 
                 if (learnRatePerSample > 0.01 * m_minLearnRate) // only compute gradient when learning rate is large enough
+                {
+                    // have the backward sweep report each finalized gradient, so filled buckets
+                    // can start their allreduce while the rest of backprop is still running
+                    if (useBucketedGradientAggregation)
+                    {
+                        net->SetNodeGradientCompleteCallback([this](const ComputationNodeBasePtr& node)
+                        {
+                            auto compNode = dynamic_pointer_cast<ComputationNode<ElemType>>(node);
+                            if (compNode && compNode->GradientPtr())
+                                m_distGradAgg->NotifyGradientComplete(&compNode->Gradient());
+                        });
+                    }
+
+                    auto profBackward = ProfilerTimeBegin();
+                    auto cudaBackward = ProfilerCudaTimeBegin();
+                    phaseTimer.Restart();
                     net->Backprop(criterionNodes[0]);
+                    phaseTimer.Stop();
+                    epochBackwardTime += phaseTimer.ElapsedSeconds();
+                    ProfilerCudaTimeEnd(cudaBackward, "Backward Pass");
+                    ProfilerTimeEnd(profBackward, profilerEvtMainBackward);
+                }
 
                 // house-keeping for sub-minibatching
                 if (actualNumSubminibatches > 1)
@@ -1264,6 +1393,9 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
         } // if (actualMBSize > 0)
         // WARNING: If actualMBSize == 0, then criterion nodes have NOT been updated, and contain garbage (last MB's) values.
 
+        if (useBucketedGradientAggregation)
+            net->SetNodeGradientCompleteCallback(nullptr);
+
         // In case of mini epochs (used for adaptive minibatch size and learning rate),
         // no more data should be processed by this worker.
         if (shouldCheckEarlyExit)
@@ -1274,6 +1406,7 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
 
         ProfilerTimeEnd(profForwardBackward, profilerEvtMainFB);
         auto profGradientAgg = ProfilerTimeBegin();
+        phaseTimer.Restart();
 
         // for momentum/clipping/regularization/etc., as well as for progress and statistics, we should only count frames that are not gaps
         // #samples according to the default dynamic axis, for use with criterion nodes that do not have an MBLayout
@@ -1329,16 +1462,22 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
                 localEpochEvalErrors.Assign(i, numSamplesWithLabelOfNetwork);
 
             // copy all values to be aggregated into the header
+            // (a single device-to-host transfer per accumulator, rather than one sync per criterion)
             m_gradHeader->numSamples = aggregateNumSamples;
-            m_gradHeader->criterion           = localEpochCriterion.GetCriterion(0).first;
-            m_gradHeader->numSamplesWithLabel = localEpochCriterion.GetCriterion(0).second; // same as aggregateNumSamplesWithLabel
+            EpochCriterion localCriterion = localEpochCriterion.GetCriterion(0);
+            m_gradHeader->criterion           = localCriterion.first;
+            m_gradHeader->numSamplesWithLabel = localCriterion.second; // same as aggregateNumSamplesWithLabel
             assert(m_gradHeader->numSamplesWithLabel == aggregateNumSamplesWithLabel);
+            std::vector<EpochCriterion> localEvalErrors = localEpochEvalErrors.GetCriteria();
             for (size_t i = 0; i < evaluationNodes.size(); i++)
-                m_gradHeader->evalErrors[i] = localEpochEvalErrors.GetCriterion(i);
+                m_gradHeader->evalErrors[i] = localEvalErrors[i];
 
-            // aggregate
+            // aggregate; in bucketed mode the gradient allreduces were already issued during
+            // backprop, so only the headers and the trailing buckets remain
             m_gradHeader->numEvalNode = evaluationNodes.size(); // TODO: rename numEvalNode (plural)
-            bool samplesProcessed = m_distGradAgg->AggregateGradients(learnParamsGradients, m_gradHeader.get(), isFirstMinibatch);
+            bool samplesProcessed = useBucketedGradientAggregation
+                ? m_distGradAgg->CompleteBucketedAggregation(m_gradHeader.get())
+                : m_distGradAgg->AggregateGradients(learnParamsGradients, m_gradHeader.get(), isFirstMinibatch);
             noMoreSamplesToProcess = !samplesProcessed;
 
             // read out the header--now everything is aggregated
@@ -1363,8 +1502,11 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
             }
         }
 
+        phaseTimer.Stop();
+        epochAggregationTime += phaseTimer.ElapsedSeconds();
         ProfilerTimeEnd(profGradientAgg, profilerEvtMainGradient);
         auto profWeights = ProfilerTimeBegin();
+        phaseTimer.Restart();
 
         // update model parameters
         if ((aggregateNumSamples > 0) && (learnRatePerSample > m_minLearnRate * 0.01))
@@ -1379,6 +1521,9 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
             if (numSamplesInMinibatch != aggregateNumSamples)
                 fprintf(stderr, "SGD: using true #samples %d instead of MB size %d\n", (int)numSamplesInMinibatch, (int)aggregateNumSamples);
 #endif
+            // clipping gradients to prevent outliers (batched over all parameters, cf. ClipGradients())
+            ClipGradients(learnableNodes, numSamplesInMinibatch);
+
             auto smoothedGradientIter = smoothedGradients.begin();
             auto smoothedCountIter = smoothedCounts.begin();
             for (auto nodeIter = learnableNodes.begin(); nodeIter != learnableNodes.end(); nodeIter++, smoothedGradientIter++, smoothedCountIter++)
@@ -1447,6 +1592,8 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
         }
 
 
+        phaseTimer.Stop();
+        epochUpdateTime += phaseTimer.ElapsedSeconds();
         ProfilerTimeEnd(profWeights, profilerEvtMainWeights);
         auto profPost = ProfilerTimeBegin();
 
@@ -1465,8 +1612,7 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
             // if no aggregation, we directly get the values from the minibatch accumulators
             timer.Restart();
             epochCriterion = localEpochCriterion.GetCriterion(0);
-            for (size_t i = 0; i < epochEvalErrors.size(); i++)
-                epochEvalErrors[i] = localEpochEvalErrors.GetCriterion(i);
+            epochEvalErrors = localEpochEvalErrors.GetCriteria();
             timer.Stop();
 
             // Add the last trailing compute
@@ -1626,6 +1772,12 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
 
     // --- END MAIN MINIBATCH LOOP
 
+    if (m_traceLevel > 0)
+    {
+        LOGPRINTF(stderr, "Epoch[%2d of %d]: exposed time per phase: reader wait = %.4fs; forward = %.4fs; backward = %.4fs; gradient aggregation = %.4fs; weight update = %.4fs\n",
+                  (int)epochNumber + 1, (int)m_maxEpochs, epochReaderTime, epochForwardTime, epochBackwardTime, epochAggregationTime, epochUpdateTime);
+    }
+
     if (useModelAggregation )
     {
         m_pMASGDHelper->OnEpochEnd(learnableNodes, smoothedGradients, nSamplesSinceLastModelSync);
@@ -1643,8 +1795,7 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
     if (!useGradientAggregation)
     {
         epochCriterion = localEpochCriterion.GetCriterion(0);
-        for (size_t i = 0; i < epochEvalErrors.size(); i++)
-            epochEvalErrors[i] = localEpochEvalErrors.GetCriterion(i);
+        epochEvalErrors = localEpochEvalErrors.GetCriteria();
     }
 
     // in case of model averaging, do one more final aggregation of criteria
@@ -1657,8 +1808,7 @@ size_t SGD<ElemType>::TrainOneEpoch(ComputationNetworkPtr net,
         // get criteria for this worker
         assert(!useGradientAggregation); // (otherwise the data would not be in localEpochCriterion)
         epochCriterion = localEpochCriterion.GetCriterion(0);
-        for (size_t i = 0; i < epochEvalErrors.size(); i++)
-            epochEvalErrors[i] = localEpochEvalErrors.GetCriterion(i);
+        epochEvalErrors = localEpochEvalErrors.GetCriteria();
 
         // all-reduce epochCriterion and epochEvalErrors over nodes
         m_mpi->AllReduce(&epochCriterion.first,  1);
@@ -1751,6 +1901,13 @@ bool SGD<ElemType>::PreCompute(ComputationNetworkPtr net,
         }
     }
 
+    // if a cache file was given and its contents match this network, side-load it instead of scanning the corpus
+    if (!m_preComputeCacheFile.empty() && TryLoadPreComputeCache(nodes))
+    {
+        LOGPRINTF(stderr, "Precomputing --> Side-loaded cached results from %ls. Skipping corpus scan.\n\n", m_preComputeCacheFile.c_str());
+        return true;
+    }
+
     // compute
     ScopedNetworkOperationMode modeGuard(net, NetworkOperationMode::preComputing);
 
@@ -1786,12 +1943,123 @@ bool SGD<ElemType>::PreCompute(ComputationNetworkPtr net,
     for (auto & node : nodes)
         dynamic_pointer_cast<IPreComputeNode>(node)->MarkComputed(true /*done accumulating*/);
 
+    if (!m_preComputeCacheFile.empty())
+        SavePreComputeCache(nodes);
+
     fprintf(stderr, "\n");
     LOGPRINTF(stderr, "Precomputing --> Completed.\n\n");
 
     return true;
 }
 
+// Precompute results are cached to a sidecar file so that each corpus only needs to be scanned once.
+// The cache stores name, operation, and accumulated value of every PreCompute node; on load, all of
+// these must match the current network, otherwise the cache is rejected and the corpus is scanned
+// again. Which corpus a cache belongs to is encoded in its path (preComputeCacheFile), which the
+// user should key by dataset, since readers expose no stable corpus fingerprint we could verify.
+template <class ElemType>
+bool SGD<ElemType>::TryLoadPreComputeCache(const std::list<ComputationNodeBasePtr>& nodes)
+{
+    if (!fexists(m_preComputeCacheFile.c_str()))
+        return false;
+
+    // read the whole cache before touching any node, so that a rejected cache leaves the network unchanged
+    std::vector<std::wstring> names, operations;
+    std::list<Matrix<ElemType>> values;
+    try
+    {
+        File fstream(m_preComputeCacheFile, FileOptions::fileOptionsBinary | FileOptions::fileOptionsRead);
+        fstream.GetMarker(FileMarker::fileMarkerBeginSection, L"BPCCache");
+        size_t version;
+        fstream >> version;
+        if (version != 1)
+        {
+            LOGPRINTF(stderr, "Warning: Precompute cache %ls has unsupported version %d. Recomputing.\n", m_preComputeCacheFile.c_str(), (int) version);
+            return false;
+        }
+        size_t numNodes;
+        fstream >> numNodes;
+        for (size_t i = 0; i < numNodes; i++)
+        {
+            std::wstring name, operation;
+            fstream >> name >> operation;
+            names.push_back(name);
+            operations.push_back(operation);
+            values.push_back(Matrix<ElemType>((DEVICEID_TYPE) CPUDEVICE));
+            fstream >> values.back();
+        }
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EPCCache");
+    }
+    catch (const std::exception& e)
+    {
+        LOGPRINTF(stderr, "Warning: Failed to read precompute cache %ls (%s). Recomputing.\n", m_preComputeCacheFile.c_str(), e.what());
+        return false;
+    }
+
+    // validate against the current network
+    if (names.size() != nodes.size())
+    {
+        LOGPRINTF(stderr, "Warning: Precompute cache %ls holds %d nodes but the network requires %d. Recomputing.\n",
+                  m_preComputeCacheFile.c_str(), (int) names.size(), (int) nodes.size());
+        return false;
+    }
+    std::vector<shared_ptr<PreComputedNodeBase<ElemType>>> targets(names.size());
+    auto valueIter = values.begin();
+    for (size_t i = 0; i < names.size(); i++, valueIter++)
+    {
+        ComputationNodeBasePtr found;
+        for (const auto& node : nodes)
+            if (node->NodeName() == names[i] && node->OperationName() == operations[i])
+                found = node;
+        auto target = dynamic_pointer_cast<PreComputedNodeBase<ElemType>>(found);
+        if (!target ||
+            valueIter->GetNumCols() != 1 ||
+            valueIter->GetNumRows() != found->GetSampleLayout().GetNumElements())
+        {
+            LOGPRINTF(stderr, "Warning: Precompute cache %ls does not match node %ls. Recomputing.\n", m_preComputeCacheFile.c_str(), names[i].c_str());
+            return false;
+        }
+        targets[i] = target;
+    }
+
+    // all entries check out; now side-load
+    valueIter = values.begin();
+    for (size_t i = 0; i < names.size(); i++, valueIter++)
+        targets[i]->SideLoadFromMatrix(*valueIter);
+
+    return true;
+}
+
+template <class ElemType>
+void SGD<ElemType>::SavePreComputeCache(const std::list<ComputationNodeBasePtr>& nodes)
+{
+    // in parallel training, only the main node writes the cache, cf. SaveCheckPointInfo()
+    if ((m_mpi != nullptr) && !m_mpi->IsMainNode())
+        return;
+
+    // write to a temporary file and rename, so that a dying process cannot leave a corrupt cache
+    wstring tempFileName = m_preComputeCacheFile + L".tmp";
+    {
+        File fstream(tempFileName, FileOptions::fileOptionsBinary | FileOptions::fileOptionsWrite);
+        fstream.Setvbuf();
+        fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BPCCache");
+        fstream << (size_t) 1; // version
+        fstream << nodes.size();
+        for (const auto& nodeBase : nodes)
+        {
+            auto node = dynamic_pointer_cast<ComputationNode<ElemType>>(nodeBase);
+            fstream << node->NodeName() << node->OperationName();
+            fstream << node->Value();
+        }
+        fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EPCCache");
+        fstream.Flush();
+    }
+
+    _wunlink(m_preComputeCacheFile.c_str());
+    renameOrDie(tempFileName, m_preComputeCacheFile);
+    LOGPRINTF(stderr, "Precomputing --> Cached results to %ls.\n", m_preComputeCacheFile.c_str());
+}
+
 // return a reasonable initial learning rate based on the initial mbsize
 template <class ElemType>
 double SGD<ElemType>::SearchForBestLearnRate(ComputationNetworkPtr net,
@@ -1958,6 +2226,35 @@ double SGD<ElemType>::SearchForBestLearnRate(ComputationNetworkPtr net,
     return bestLearnRatePerSample;
 }
 
+// Key under which a minibatch-size search result is cached (and persisted in the checkpoint).
+// A cached result remains valid as long as the learnable parameters keep their shapes (a
+// structural model edit changes the signature) and the learning rate stays within the same
+// power-of-two band; since the learning-rate schedule moves monotonically across the epochs,
+// the band also bounds the range of epochs a cached result can serve.
+template <class ElemType>
+std::pair<int, size_t> SGD<ElemType>::MinibatchSearchCacheKey(const double learnRatePerSample,
+                                                              const std::list<ComputationNodeBasePtr>& learnableNodes) const
+{
+    int learnRateBand = (learnRatePerSample > 0) ? (int)floor(log(learnRatePerSample) / log(2.0)) : 0;
+
+    // FNV-1a over the names and dimensions of the learnable parameters
+    size_t signature = (size_t)14695981039346656037ull;
+    auto combine = [&signature](size_t value)
+    {
+        signature = (signature ^ value) * (size_t)1099511628211ull;
+    };
+    for (const auto& nodeBase : learnableNodes)
+    {
+        ComputationNodePtr node = dynamic_pointer_cast<ComputationNode<ElemType>>(nodeBase);
+        for (wchar_t c : node->NodeName())
+            combine((size_t)c);
+        combine(node->Value().GetNumRows());
+        combine(node->Value().GetNumCols());
+    }
+
+    return std::make_pair(learnRateBand, signature);
+}
+
 // AdaptiveMinibatchSizing() -- choose the largest feasible minibatch size
 // This is necessary for data-parallel operation. The aim is to minimize model updates, and hence bandwidth
 // This implements
@@ -2042,6 +2339,22 @@ size_t SGD<ElemType>::AdaptiveMinibatchSizing(ComputationNetworkPtr net,
             maxMinibatchSize = min(maxMinibatchSize, m_prevChosenMinibatchSize * 2);
         }
 
+        std::pair<int, size_t> cacheKey;
+        if (m_useMinibatchSearchCache)
+        {
+            cacheKey = MinibatchSearchCacheKey(learnRatePerSample, learnableNodes);
+            auto cached = m_mbSearchCache.find(cacheKey);
+            if (cached != m_mbSearchCache.end())
+            {
+                // an earlier search with the same model shapes and learning-rate band already
+                // paid for this answer; just clamp it into the window allowed for this epoch
+                chosenMinibatchSize = max(minMinibatchSize, min(cached->second, maxMinibatchSize));
+                LOGPRINTF(stderr, " AdaptiveMinibatchSearch Epoch[%d]: Reusing cached minibatchSize %d (learning-rate band %d)\n",
+                          (int)epochNumber + 1, (int)chosenMinibatchSize, cacheKey.first);
+                return chosenMinibatchSize;
+            }
+        }
+
         chosenMinibatchSize = SearchForBestMinibatchSize(net, refNet, refNode, epochNumber,
                                                          numFramesToUseInSearch, trainSetDataReader,
                                                          learnRatePerSample, featureNodes,
@@ -2049,6 +2362,9 @@ size_t SGD<ElemType>::AdaptiveMinibatchSizing(ComputationNetworkPtr net,
                                                          evaluationNodes, inputMatrices,
                                                          learnableNodes, smoothedGradients, smoothedCounts,
                                                          minMinibatchSize, maxMinibatchSize);
+
+        if (m_useMinibatchSearchCache)
+            m_mbSearchCache[cacheKey] = chosenMinibatchSize;
     }
 
     return chosenMinibatchSize;
@@ -2279,6 +2595,12 @@ void SGD<ElemType>::InitDistGradAgg(int numEvalNodes, int numGradientBits, int d
         RuntimeError("Gradient quantization is unsupported in CNTK binaries built without quantized gradient aggregation support!");
 #endif // !CNTK_PARALLEL_TRAINING_SUPPORT
     }
+    else if (m_topKGradientAggregationPercent > 0)
+    {
+        if (traceLevel > 0)
+            fprintf(stderr, "Initializing dataParallelSGD with top-%.3g%% sparsified aggregation.\n", m_topKGradientAggregationPercent);
+        m_distGradAgg = std::make_shared<TopKDistGradAggregator<ElemType>>(m_mpi, m_topKGradientAggregationPercent, m_syncStatsTrace);
+    }
     else
     {
         if (traceLevel > 0)
@@ -2286,9 +2608,12 @@ void SGD<ElemType>::InitDistGradAgg(int numEvalNodes, int numGradientBits, int d
         if (Globals::UseV2Aggregator()) // Currently used to check V2 against baselines.
             m_distGradAgg = std::make_shared<V2SimpleDistGradAggregator<ElemType>>(m_mpi, m_bufferedAsyncGradientAggregation, deviceId, m_syncStatsTrace, ::CNTK::MPICommunicator(m_packThresholdSizeInBytes));
         else
-            m_distGradAgg = std::make_shared<SimpleDistGradAggregator<ElemType>>(m_mpi, m_bufferedAsyncGradientAggregation, deviceId, m_syncStatsTrace, m_packThresholdSizeInBytes);
+            m_distGradAgg = std::make_shared<SimpleDistGradAggregator<ElemType>>(m_mpi, m_bufferedAsyncGradientAggregation, deviceId, m_syncStatsTrace, m_packThresholdSizeInBytes, m_aggregationBucketSizeInBytes);
     }
 
+    if ((m_aggregationBucketSizeInBytes > 0) && !m_distGradAgg->SupportsBucketedAggregation() && (traceLevel > 0))
+        fprintf(stderr, "useBucketedGradientAggregation is ignored: it requires the full-precision (v1) gradient aggregator.\n");
+
     m_gradHeader.reset(DistGradHeader::Create(numEvalNodes), [](DistGradHeader* ptr) { DistGradHeader::Destroy(ptr); });
 }
 
@@ -2301,7 +2626,10 @@ void SGD<ElemType>::InitModelAggregationHandler(int traceLevel, DEVICEID_TYPE de
     }
     if (GetParallelizationMethod() == ParallelizationMethod::modelAveragingSGD)
     {
-        m_pMASGDHelper = make_shared<BasicModelAveragingSGD<ElemType>>(m_mpi, traceLevel, devID);
+        if (m_useMAOverlappedAveraging)
+            m_pMASGDHelper = make_shared<OverlappedModelAveragingSGD<ElemType>>(m_mpi, traceLevel, devID);
+        else
+            m_pMASGDHelper = make_shared<BasicModelAveragingSGD<ElemType>>(m_mpi, traceLevel, devID);
     }
     else if (GetParallelizationMethod() == ParallelizationMethod::blockMomentumSGD)
     {
@@ -2356,8 +2684,7 @@ void SGD<ElemType>::UpdateWeights(Matrix<ElemType>& functionValues, Matrix<ElemT
     // make actualMBSize is a valid value
     assert(actualMBSize > 0);
 
-    // clipping gradients to prevent outliers
-    ClipGradient(gradientValues, actualMBSize);
+    // Note: gradient clipping has already run for all parameters at once, cf. ClipGradients().
 
     GradientsUpdateType adpType = GradUpdateType();
     double noiseStd = GradientUpdateNoiseStd();
@@ -2458,6 +2785,141 @@ void SGD<ElemType>::ClipGradient(Matrix<ElemType>& gradient, const size_t actual
     }
 }
 
+// Clip the gradients of all learnable nodes at once, before the weight updates.
+// Norm-based clipping needs each gradient's Frobenius norm on the host, and fetching them one by one
+// (as ClipGradient() does) costs one device sync per parameter. Here all norms are first reduced on
+// the device into a single [1 x N] row which is then fetched in one transfer; only gradients whose
+// norm exceeds the threshold are scaled afterwards. The per-matrix clipping semantics of
+// ClipGradient() are preserved exactly.
+template <class ElemType>
+void SGD<ElemType>::ClipGradients(const std::list<ComputationNodeBasePtr>& learnableNodes, const size_t actualMBSize) const
+{
+    if (m_clippingThresholdPerSample == std::numeric_limits<double>::infinity())
+        return;
+
+    std::vector<Matrix<ElemType>*> gradients;
+    for (const auto& node : learnableNodes)
+    {
+        if (node->IsParameterUpdateRequired())
+            gradients.push_back(&dynamic_pointer_cast<ComputationNode<ElemType>>(node)->Gradient());
+    }
+    if (gradients.empty())
+        return;
+
+    if (m_gradientClippingWithTruncation) // truncation runs entirely on the device, no norms needed
+    {
+        for (auto* gradient : gradients)
+            ClipGradient(*gradient, actualMBSize);
+        return;
+    }
+
+    // norm2 normalized
+    double maxGradientPerMB = m_clippingThresholdPerSample * actualMBSize;
+    size_t numGradients = gradients.size();
+    DEVICEID_TYPE deviceId = (DEVICEID_TYPE)gradients.front()->GetDeviceId();
+    Matrix<ElemType> norms(1, numGradients, deviceId);
+    Matrix<ElemType> norm(deviceId); // [1 x 1] scratch for one reduction result
+    std::vector<bool> batched(numGradients, false);
+    bool anyBatched = false;
+    for (size_t i = 0; i < numGradients; i++)
+    {
+        const auto& gradient = *gradients[i];
+        if (gradient.GetMatrixType() != MatrixType::DENSE || gradient.GetDeviceId() != deviceId)
+            continue; // (sparse or stray-device gradients go through the scalar path below)
+        norm.AssignFrobeniusNormOf(gradient);
+        norms.ColumnSlice(i, 1).AssignValuesOf(norm);
+        batched[i] = anyBatched = true;
+    }
+    std::vector<ElemType> hostNorms(numGradients);
+    if (anyBatched)
+        norms.CopySection(1, numGradients, hostNorms.data(), /*colStride=*/1); // the single host sync
+    for (size_t i = 0; i < numGradients; i++)
+    {
+        if (!batched[i])
+        {
+            ClipGradient(*gradients[i], actualMBSize);
+            continue;
+        }
+        double gradientNorm = hostNorms[i];
+        if (gradientNorm > maxGradientPerMB)
+            *gradients[i] *= (ElemType)(maxGradientPerMB / gradientNorm);
+    }
+}
+
+// Delta checkpoints store the smoothed gradients XORed byte-wise against the last full
+// snapshot. Between nearby checkpoints the sign, exponent and high mantissa bytes of most
+// elements agree, so the XOR stream is dominated by zeros; it is stored losslessly as
+// (zero-run, literal-run) pairs with 32-bit run lengths.
+static void DeltaEncodeBuffer(const char* base, const char* current, size_t size, std::vector<char>& encoded)
+{
+    // a literal run only ends when enough equal bytes follow to amortize the 8-byte pair header
+    const size_t minZeroRun = 8;
+    const size_t maxRun = std::numeric_limits<uint32_t>::max();
+
+    encoded.clear();
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t zeroRun = 0;
+        while (pos + zeroRun < size && base[pos + zeroRun] == current[pos + zeroRun])
+            zeroRun++;
+        pos += zeroRun;
+
+        size_t literalEnd = pos;
+        while (literalEnd < size)
+        {
+            size_t same = 0;
+            while (literalEnd + same < size && same < minZeroRun && base[literalEnd + same] == current[literalEnd + same])
+                same++;
+            if (same >= minZeroRun)
+                break;
+            literalEnd += same;
+            if (literalEnd < size)
+                literalEnd++; // the differing byte
+        }
+
+        // emit the (zero-run, literal-run) pair, splitting runs that overflow the 32-bit length
+        do
+        {
+            uint32_t zeroRun32 = (uint32_t)std::min(zeroRun, maxRun);
+            uint32_t literalRun32 = zeroRun > maxRun ? 0 : (uint32_t)std::min(literalEnd - pos, maxRun);
+            char header[2 * sizeof(uint32_t)];
+            memcpy(header, &zeroRun32, sizeof(uint32_t));
+            memcpy(header + sizeof(uint32_t), &literalRun32, sizeof(uint32_t));
+            encoded.insert(encoded.end(), header, header + sizeof(header));
+            for (size_t k = 0; k < literalRun32; k++)
+                encoded.push_back(base[pos + k] ^ current[pos + k]);
+            zeroRun -= zeroRun32;
+            pos += literalRun32;
+        } while (zeroRun > 0 || pos < literalEnd);
+    }
+}
+
+// Applies an encoded delta in place: 'buffer' holds the base snapshot's bytes on input and
+// the checkpointed values on output.
+static void DeltaDecodeBuffer(const std::vector<char>& encoded, char* buffer, size_t size)
+{
+    size_t src = 0, dst = 0;
+    while (src < encoded.size())
+    {
+        if (encoded.size() - src < 2 * sizeof(uint32_t))
+            RuntimeError("Delta checkpoint: truncated delta stream.");
+        uint32_t zeroRun, literalRun;
+        memcpy(&zeroRun, encoded.data() + src, sizeof(uint32_t));
+        memcpy(&literalRun, encoded.data() + src + sizeof(uint32_t), sizeof(uint32_t));
+        src += 2 * sizeof(uint32_t);
+        if (dst + zeroRun + literalRun > size || encoded.size() - src < literalRun)
+            RuntimeError("Delta checkpoint: delta stream does not fit the target buffer.");
+        dst += zeroRun;
+        for (size_t k = 0; k < literalRun; k++)
+            buffer[dst + k] ^= encoded[src + k];
+        dst += literalRun;
+        src += literalRun;
+    }
+    if (dst != size)
+        RuntimeError("Delta checkpoint: delta stream covers %d of %d bytes.", (int)dst, (int)size);
+}
+
 template <class ElemType>
 void SGD<ElemType>::SaveCheckPointInfo(const size_t epoch, const size_t totalSamplesSeen,
                                        const double learnRatePerSample,
@@ -2466,32 +2928,156 @@ void SGD<ElemType>::SaveCheckPointInfo(const size_t epoch, const size_t totalSam
                                        const double prevCriterion,
                                        const size_t minibatchSize)
 {
+    // In sharded mode all ranks cooperate on the write, each contributing its own slice
+    if (UseShardedCheckpointing())
+    {
+        SaveShardedCheckPoint(epoch, totalSamplesSeen, learnRatePerSample, smoothedGradients, smoothedCounts, prevCriterion, minibatchSize);
+        return;
+    }
+
     // In case of parallel training only the main node should we saving the checkpoint to prevent
     // the parallel training nodes from colliding to write the same file
     if ((m_mpi == nullptr) || m_mpi->IsMainNode())
     {
+        // Only one background write may be in flight at a time; it uses the same temporary
+        // file name, and the writes must land on disk in epoch order
+        WaitForPendingCheckpointWrite();
+
         wstring checkPointFileName = GetCheckPointFileNameForEpoch(int(epoch));
-        // Saving into temporary file and then renaming it to the checkPointFileName
-        // This is a standard trick to avoid havign corrupted checkpoints files if process dies during writing
-        wstring tempFileName = checkPointFileName + L".tmp";
 
+        // Decide whether this epoch gets a full snapshot or a delta against the last one.
+        // Deltas stay off under best-model rollback, whose checkpoint deletion schedule does
+        // not preserve the base file. A full snapshot is also forced when no base was written
+        // by this process (e.g. right after resuming) and when rolling back to or past the base.
+        bool deltasEnabled = m_fullCheckpointInterval > 1 &&
+                             m_pMASGDHelper == nullptr &&
+                             !(m_autoLearnRateSearchType == LearningRateSearchAlgorithm::AdjustAfterEpoch && m_loadBestModel);
+        bool writeFull = !deltasEnabled ||
+                         m_checkpointDeltaBaseEpoch < 0 ||
+                         (int)epoch <= m_checkpointDeltaBaseEpoch ||
+                         epoch % m_fullCheckpointInterval == 0 ||
+                         m_checkpointDeltaBase == nullptr ||
+                         m_checkpointDeltaBase->size() != smoothedGradients.size();
+
+        std::shared_ptr<std::list<Matrix<ElemType>>> deltaBase = writeFull ? nullptr : m_checkpointDeltaBase;
+        int deltaBaseEpoch = m_checkpointDeltaBaseEpoch;
+
+        if (deltasEnabled && writeFull)
         {
-            File fstream(tempFileName, FileOptions::fileOptionsBinary | FileOptions::fileOptionsWrite);
-            // Buffer writes in memory then flush to filesystem, which reduces number of small writes
-            fstream.Setvbuf();
-            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BVersion"); 
-            fstream << (size_t)CURRENT_CNTK_CHECKPOINT_VERSION; 
-            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EVersion");
+            // This snapshot becomes the base the following deltas are encoded against; the
+            // superseded base file is deleted by the caller once this write has landed.
+            if (m_checkpointDeltaBaseEpoch >= 0 && m_checkpointDeltaBaseEpoch != (int)epoch)
+                m_retiredCheckpointBaseEpoch = m_checkpointDeltaBaseEpoch;
+            m_checkpointDeltaBase = std::make_shared<std::list<Matrix<ElemType>>>();
+            for (const Matrix<ElemType>& smoothedGradientValues : smoothedGradients)
+                m_checkpointDeltaBase->emplace_back(smoothedGradientValues, CPUDEVICE);
+            m_checkpointDeltaBaseEpoch = (int)epoch;
+        }
+
+        // The model-averaging helper serializes live state of its own that cannot be
+        // snapshotted here, so its presence forces the synchronous path
+        if (!m_useAsyncCheckpointing || m_pMASGDHelper)
+        {
+            WriteCheckPointFile(checkPointFileName, totalSamplesSeen, learnRatePerSample, smoothedGradients, smoothedCounts, prevCriterion, minibatchSize, m_criteriaBestEpoch, m_mbSearchCache,
+                                deltaBase.get(), deltaBaseEpoch);
+            return;
+        }
 
-            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BCKP");
-            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BLearnRate");
-            fstream << totalSamplesSeen << learnRatePerSample << prevCriterion;
-            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ELearnRate");
+        // Snapshot the learner state into host memory so training can resume immediately,
+        // then stream the snapshot to disk on a background thread. The write ends in the same
+        // rename-on-complete as the synchronous path, so a checkpoint file only ever appears
+        // on disk fully written.
+        auto smoothedGradientsSnapshot = std::make_shared<std::list<Matrix<ElemType>>>();
+        if (deltasEnabled && writeFull)
+            smoothedGradientsSnapshot = m_checkpointDeltaBase; // the base copies double as the write snapshot
+        else
+            for (const Matrix<ElemType>& smoothedGradientValues : smoothedGradients)
+                smoothedGradientsSnapshot->emplace_back(smoothedGradientValues, CPUDEVICE);
+
+        std::vector<double> smoothedCountsSnapshot = smoothedCounts;
+        std::map<std::wstring, BestEpoch> criteriaBestEpochSnapshot = m_criteriaBestEpoch;
+        std::map<std::pair<int, size_t>, size_t> mbSearchCacheSnapshot = m_mbSearchCache;
+        m_pendingCheckpointWrite = std::async(std::launch::async,
+            [this, checkPointFileName, totalSamplesSeen, learnRatePerSample, smoothedGradientsSnapshot, smoothedCountsSnapshot, prevCriterion, minibatchSize, criteriaBestEpochSnapshot, mbSearchCacheSnapshot, deltaBase, deltaBaseEpoch]
+            {
+                WriteCheckPointFile(checkPointFileName, totalSamplesSeen, learnRatePerSample, *smoothedGradientsSnapshot, smoothedCountsSnapshot, prevCriterion, minibatchSize, criteriaBestEpochSnapshot, mbSearchCacheSnapshot,
+                                    deltaBase.get(), deltaBaseEpoch);
+            });
+    }
+}
 
-            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BMinibatchSize");
-            fstream << minibatchSize;
-            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EMinibatchSize");
+template <class ElemType>
+void SGD<ElemType>::WriteCheckPointFile(const wstring& checkPointFileName, const size_t totalSamplesSeen,
+                                        const double learnRatePerSample,
+                                        const std::list<Matrix<ElemType>>& smoothedGradients,
+                                        const std::vector<double>& smoothedCounts,
+                                        const double prevCriterion,
+                                        const size_t minibatchSize,
+                                        const std::map<std::wstring, BestEpoch>& criteriaBestEpoch,
+                                        const std::map<std::pair<int, size_t>, size_t>& mbSearchCache,
+                                        const std::list<Matrix<ElemType>>* deltaBase,
+                                        const int deltaBaseEpoch,
+                                        const size_t numShards)
+{
+    // Saving into temporary file and then renaming it to the checkPointFileName
+    // This is a standard trick to avoid havign corrupted checkpoints files if process dies during writing
+    wstring tempFileName = checkPointFileName + L".tmp";
 
+    {
+        File fstream(tempFileName, FileOptions::fileOptionsBinary | FileOptions::fileOptionsWrite);
+        // Buffer writes in memory then flush to filesystem, which reduces number of small writes
+        fstream.Setvbuf();
+        fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BVersion"); 
+        fstream << (size_t)CURRENT_CNTK_CHECKPOINT_VERSION; 
+        fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EVersion");
+
+        fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BCKP");
+        fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BLearnRate");
+        fstream << totalSamplesSeen << learnRatePerSample << prevCriterion;
+        fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ELearnRate");
+
+        fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BMinibatchSize");
+        fstream << minibatchSize;
+        fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EMinibatchSize");
+
+        if (numShards != 0)
+        {
+            // Sharded checkpoint: the gradient payload lives in the per-rank shard files,
+            // the primary file only records how many of them to read back.
+            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BShardedGradient");
+            fstream << numShards;
+            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EShardedGradient");
+        }
+        else if (deltaBase != nullptr)
+        {
+            // Delta checkpoint: only the XOR against the base snapshot's smoothed gradients is
+            // stored, together with the epoch of the base so the load path can chain them.
+            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BDeltaGradient");
+            fstream << (size_t)deltaBaseEpoch;
+
+            std::vector<char> encoded;
+            auto baseIter = deltaBase->begin();
+            for (auto smoothedGradientIter = smoothedGradients.begin(); smoothedGradientIter != smoothedGradients.end(); smoothedGradientIter++, baseIter++)
+            {
+                // the encoder works on host buffers; in the synchronous path the live smoothed
+                // gradients may still reside on a GPU
+                Matrix<ElemType> current(*smoothedGradientIter, CPUDEVICE);
+                const Matrix<ElemType>& base = *baseIter;
+                if (current.GetNumRows() != base.GetNumRows() || current.GetNumCols() != base.GetNumCols())
+                    LogicError("Delta checkpoint: smoothed-gradient dimensions changed since the base snapshot.");
+
+                size_t numBytes = current.GetNumElements() * sizeof(ElemType);
+                DeltaEncodeBuffer((const char*)base.Data(), (const char*)current.Data(), numBytes, encoded);
+
+                fstream << current.GetNumRows() << current.GetNumCols() << (size_t)encoded.size();
+                for (size_t k = 0; k < encoded.size(); k++)
+                    fstream << encoded[k];
+            }
+
+            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EDeltaGradient");
+        }
+        else
+        {
             fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BGradient");
 
             for (auto smoothedGradientIter = smoothedGradients.begin(); smoothedGradientIter != smoothedGradients.end(); smoothedGradientIter++)
@@ -2501,35 +3087,161 @@ void SGD<ElemType>::SaveCheckPointInfo(const size_t epoch, const size_t totalSam
             }
 
             fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EGradient");
+        }
 
-            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"BCount");
+        fstream.PutMarker(FileMarker::fileMarkerEndSection, L"BCount");
 
-            for (auto sc : smoothedCounts)
-                fstream << sc;
+        for (auto sc : smoothedCounts)
+            fstream << sc;
 
-            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ECount");
+        fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ECount");
 
-            if (m_saveBestModelPerCriterion)
+        if (m_saveBestModelPerCriterion)
+        {
+            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BCriteria");
+            const int32_t criteriaSize = static_cast<int32_t>(criteriaBestEpoch.size());
+            fstream << criteriaSize;
+            for (const auto& criterion : criteriaBestEpoch)
             {
-                fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BCriteria");
-                const int32_t criteriaSize = static_cast<int32_t>(m_criteriaBestEpoch.size());
-                fstream << criteriaSize;
-                for (const auto& criterion : m_criteriaBestEpoch)
-                {
-                    fstream << criterion.second.criterionMinValue << criterion.second.epochIndex;
-                }
-                fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ECriteria");
+                fstream << criterion.second.criterionMinValue << criterion.second.epochIndex;
             }
+            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ECriteria");
+        }
+
+        if (!mbSearchCache.empty())
+        {
+            fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BMBSearchCache");
+            fstream << (size_t)mbSearchCache.size();
+            for (const auto& entry : mbSearchCache)
+                fstream << entry.first.first << entry.first.second << entry.second;
+            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EMBSearchCache");
+        }
+
+        fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ECKP");
+        if (m_pMASGDHelper)
+            m_pMASGDHelper->SaveToCheckPoint(fstream);
+        // Ensuring that data is written
+        fstream.Flush();
+    }
+
+    _wunlink(checkPointFileName.c_str());
+    renameOrDie(tempFileName, checkPointFileName);
+}
+
+// Deterministic, size-balanced shard assignment: largest matrices first, each onto the
+// least-loaded shard. All ranks compute the identical assignment from the identical
+// (replicated) learner state, so no coordination is needed.
+template <class ElemType>
+static void ComputeCheckpointShardAssignment(const std::list<Matrix<ElemType>>& smoothedGradients, const size_t numShards,
+                                             /*out*/ std::vector<size_t>& shardOfMatrix)
+{
+    std::vector<std::pair<size_t, size_t>> sizes; // (elements, matrix index)
+    size_t index = 0;
+    for (const Matrix<ElemType>& smoothedGradientValues : smoothedGradients)
+        sizes.emplace_back(smoothedGradientValues.GetNumElements(), index++);
+    std::stable_sort(sizes.begin(), sizes.end(),
+                     [](const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b) { return a.first > b.first; });
+
+    std::vector<size_t> shardLoad(numShards, 0);
+    shardOfMatrix.resize(sizes.size());
+    for (const auto& entry : sizes)
+    {
+        size_t shard = (size_t)(std::min_element(shardLoad.begin(), shardLoad.end()) - shardLoad.begin());
+        shardOfMatrix[entry.second] = shard;
+        shardLoad[shard] += entry.first;
+    }
+}
+
+template <class ElemType>
+void SGD<ElemType>::SaveShardedCheckPoint(const size_t epoch, const size_t totalSamplesSeen,
+                                          const double learnRatePerSample,
+                                          const std::list<Matrix<ElemType>>& smoothedGradients,
+                                          const std::vector<double>& smoothedCounts,
+                                          const double prevCriterion,
+                                          const size_t minibatchSize)
+{
+    // The write itself is already spread over all ranks, so there is no background thread;
+    // still drain any async write left over from before the mode took effect
+    WaitForPendingCheckpointWrite();
+
+    size_t numShards = m_mpi->NumNodesInUse();
+    size_t myShard = m_mpi->CurrentNodeRank();
+
+    std::vector<size_t> shardOfMatrix;
+    ComputeCheckpointShardAssignment(smoothedGradients, numShards, shardOfMatrix);
+
+    // Every rank streams its slice of the (replicated) smoothed gradients to its own shard
+    // file, with the same temporary-file-then-rename trick as the primary checkpoint file.
+    wstring shardFileName = GetCheckPointShardNameForEpoch(int(epoch), myShard);
+    wstring tempFileName = shardFileName + L".tmp";
+    {
+        File fstream(tempFileName, FileOptions::fileOptionsBinary | FileOptions::fileOptionsWrite);
+        fstream.Setvbuf();
+        fstream.PutMarker(FileMarker::fileMarkerBeginSection, L"BShard");
+
+        size_t numLocalMatrices = 0;
+        for (size_t i = 0; i < shardOfMatrix.size(); i++)
+            if (shardOfMatrix[i] == myShard)
+                numLocalMatrices++;
+        fstream << numLocalMatrices;
+
+        size_t index = 0;
+        for (const Matrix<ElemType>& smoothedGradientValues : smoothedGradients)
+        {
+            if (shardOfMatrix[index] == myShard)
+            {
+                fstream << index;
+                fstream << smoothedGradientValues;
+            }
+            index++;
+        }
+
+        fstream.PutMarker(FileMarker::fileMarkerEndSection, L"EShard");
+        fstream.Flush();
+    }
+    _wunlink(shardFileName.c_str());
+    renameOrDie(tempFileName, shardFileName);
+
+    // The main node additionally writes the primary file: scalar state plus the shard count
+    if (m_mpi->IsMainNode())
+        WriteCheckPointFile(GetCheckPointFileNameForEpoch(int(epoch)), totalSamplesSeen, learnRatePerSample, smoothedGradients, smoothedCounts, prevCriterion, minibatchSize, m_criteriaBestEpoch, m_mbSearchCache,
+                            /*deltaBase=*/nullptr, /*deltaBaseEpoch=*/-1, numShards);
+
+    // No rank may proceed (and later read or delete shard files) before every shard has landed
+    m_mpi->WaitAll();
+}
+
+template <class ElemType>
+void SGD<ElemType>::ReadShardedCheckpointGradients(const size_t epochNumber, const size_t numShards,
+                                                   std::list<Matrix<ElemType>>& smoothedGradients)
+{
+    // index the list so shards can deliver their matrices in any order
+    std::vector<Matrix<ElemType>*> matrices;
+    for (Matrix<ElemType>& smoothedGradientValues : smoothedGradients)
+        matrices.push_back(&smoothedGradientValues);
+
+    for (size_t shard = 0; shard < numShards; shard++)
+    {
+        let shardFileName = GetCheckPointShardNameForEpoch(int(epochNumber), shard);
+        if (!fexists(shardFileName.c_str()))
+            RuntimeError("Sharded checkpoint: shard file '%ls' is missing.", shardFileName.c_str());
+
+        File fstream(shardFileName, FileOptions::fileOptionsBinary | FileOptions::fileOptionsRead);
+        fstream.GetMarker(FileMarker::fileMarkerBeginSection, L"BShard");
 
-            fstream.PutMarker(FileMarker::fileMarkerEndSection, L"ECKP");
-            if (m_pMASGDHelper)
-                m_pMASGDHelper->SaveToCheckPoint(fstream);
-            // Ensuring that data is written
-            fstream.Flush();
+        size_t numLocalMatrices;
+        fstream >> numLocalMatrices;
+        for (size_t i = 0; i < numLocalMatrices; i++)
+        {
+            size_t index;
+            fstream >> index;
+            if (index >= matrices.size())
+                RuntimeError("Sharded checkpoint: shard file '%ls' references smoothed gradient %d, but the network only has %d.",
+                             shardFileName.c_str(), (int)index, (int)matrices.size());
+            fstream >> *matrices[index];
         }
 
-        _wunlink(checkPointFileName.c_str());
-        renameOrDie(tempFileName, checkPointFileName);
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EShard");
     }
 }
 
@@ -2542,6 +3254,9 @@ bool SGD<ElemType>::TryLoadCheckPointInfo(const size_t epochNumber,
                                           /*out*/ double& prevCriterion,
                                           /*out*/ size_t& minibatchSize)
 {
+    // The checkpoint we are about to probe may still be streaming to disk in the background
+    WaitForPendingCheckpointWrite();
+
     // gracefully handle if a checkpoint file is missing
     // This means a user wanted to continue training from an older model, but that model had no checkpoint info anymore.
     // This is valid, we just don't get the features that require previous models, such as LR or MBSize control.
@@ -2571,6 +3286,9 @@ void SGD<ElemType>::LoadCheckPointInfo(const size_t epochNumber,
                                        /*out*/ double& prevCriterion,
                                        /*out*/ size_t& minibatchSize)
 {
+    // The checkpoint being loaded may still be streaming to disk in the background
+    WaitForPendingCheckpointWrite();
+
     let checkPointFileName = GetCheckPointFileNameForEpoch(int(epochNumber));
     //fprintf(stderr, "Loading checkpoint info from %ls\n", checkPointFileName.c_str());
     File fstream(checkPointFileName,
@@ -2600,14 +3318,55 @@ void SGD<ElemType>::LoadCheckPointInfo(const size_t epochNumber,
         minibatchSize = m_mbSize[epochNumber];
     }
 
-    fstream.GetMarker(FileMarker::fileMarkerBeginSection, L"BGradient");
-
-    for (auto smoothedGradientIter = smoothedGradients.begin(); smoothedGradientIter != smoothedGradients.end(); smoothedGradientIter++)
+    if (fstream.TryGetMarker(FileMarker::fileMarkerBeginSection, L"BShardedGradient"))
     {
-        Matrix<ElemType>& smoothedGradientValues = *smoothedGradientIter;
-        fstream >> smoothedGradientValues;
+        // Sharded checkpoint: the gradient payload is spread over per-rank shard files;
+        // every rank reads all of them, since the learner state is replicated.
+        size_t numShards;
+        fstream >> numShards;
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EShardedGradient");
+        ReadShardedCheckpointGradients(epochNumber, numShards, smoothedGradients);
+    }
+    else if (fstream.TryGetMarker(FileMarker::fileMarkerBeginSection, L"BDeltaGradient"))
+    {
+        // Delta checkpoint: restore the base snapshot's smoothed gradients first, then patch
+        // them with the stored XOR deltas. Deltas always chain directly to a full snapshot.
+        size_t deltaBaseEpoch;
+        fstream >> deltaBaseEpoch;
+        ReadCheckpointGradients(deltaBaseEpoch, smoothedGradients);
+
+        std::vector<char> encoded;
+        for (auto smoothedGradientIter = smoothedGradients.begin(); smoothedGradientIter != smoothedGradients.end(); smoothedGradientIter++)
+        {
+            Matrix<ElemType>& smoothedGradientValues = *smoothedGradientIter;
+            size_t numRows, numCols, encodedSize;
+            fstream >> numRows >> numCols >> encodedSize;
+            if (numRows != smoothedGradientValues.GetNumRows() || numCols != smoothedGradientValues.GetNumCols())
+                RuntimeError("Delta checkpoint: smoothed-gradient dimensions [%d x %d] do not match the base snapshot [%d x %d].",
+                             (int)numRows, (int)numCols, (int)smoothedGradientValues.GetNumRows(), (int)smoothedGradientValues.GetNumCols());
+
+            encoded.resize(encodedSize);
+            for (size_t k = 0; k < encodedSize; k++)
+                fstream >> encoded[k];
+
+            // patch a host copy of the base values, then push it back without moving the matrix
+            Matrix<ElemType> patched(smoothedGradientValues, CPUDEVICE);
+            DeltaDecodeBuffer(encoded, (char*)patched.Data(), patched.GetNumElements() * sizeof(ElemType));
+            smoothedGradientValues.SetValue(numRows, numCols, smoothedGradientValues.GetDeviceId(), patched.Data());
+        }
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EDeltaGradient");
+    }
+    else
+    {
+        fstream.GetMarker(FileMarker::fileMarkerBeginSection, L"BGradient");
+
+        for (auto smoothedGradientIter = smoothedGradients.begin(); smoothedGradientIter != smoothedGradients.end(); smoothedGradientIter++)
+        {
+            Matrix<ElemType>& smoothedGradientValues = *smoothedGradientIter;
+            fstream >> smoothedGradientValues;
+        }
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EGradient");
     }
-    fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EGradient");
 
     if (fstream.TryGetMarker(FileMarker::fileMarkerBeginSection, L"BCount"))
     {
@@ -2635,6 +3394,21 @@ void SGD<ElemType>::LoadCheckPointInfo(const size_t epochNumber,
         fstream.GetMarker(FileMarker::fileMarkerBeginSection, L"ECriteria");
     }
 
+    if (fstream.TryGetMarker(FileMarker::fileMarkerBeginSection, L"BMBSearchCache"))
+    {
+        size_t cacheSize = 0;
+        fstream >> cacheSize;
+        m_mbSearchCache.clear();
+        for (size_t i = 0; i < cacheSize; i++)
+        {
+            int learnRateBand;
+            size_t modelSignature, cachedMinibatchSize;
+            fstream >> learnRateBand >> modelSignature >> cachedMinibatchSize;
+            m_mbSearchCache[std::make_pair(learnRateBand, modelSignature)] = cachedMinibatchSize;
+        }
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EMBSearchCache");
+    }
+
     fstream.GetMarker(FileMarker::fileMarkerEndSection, L"ECKP");
 
     if (m_pMASGDHelper)
@@ -2645,12 +3419,72 @@ void SGD<ElemType>::LoadCheckPointInfo(const size_t epochNumber,
     return;
 }
 
+template <class ElemType>
+void SGD<ElemType>::ReadCheckpointGradients(const size_t epochNumber, std::list<Matrix<ElemType>>& smoothedGradients)
+{
+    let checkPointFileName = GetCheckPointFileNameForEpoch(int(epochNumber));
+    if (!fexists(checkPointFileName.c_str()))
+        RuntimeError("Delta checkpoint: the full base checkpoint '%ls' is missing.", checkPointFileName.c_str());
+
+    File fstream(checkPointFileName,
+                 FileOptions::fileOptionsBinary | FileOptions::fileOptionsRead);
+
+    // walk the scalar sections in front of the gradients, discarding their values
+    if (fstream.TryGetMarker(FileMarker::fileMarkerBeginSection, L"BVersion"))
+    {
+        size_t ckpVersion;
+        fstream >> ckpVersion;
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EVersion");
+    }
+
+    fstream.GetMarker(FileMarker::fileMarkerBeginSection, L"BCKP");
+
+    fstream.GetMarker(FileMarker::fileMarkerBeginSection, L"BLearnRate");
+    size_t totalSamplesSeen;
+    double learnRatePerSample, prevCriterion;
+    fstream >> totalSamplesSeen >> learnRatePerSample >> prevCriterion;
+    fstream.GetMarker(FileMarker::fileMarkerEndSection, L"ELearnRate");
+
+    if (fstream.TryGetMarker(FileMarker::fileMarkerBeginSection, L"BMinibatchSize"))
+    {
+        size_t minibatchSize;
+        fstream >> minibatchSize;
+        fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EMinibatchSize");
+    }
+
+    // deltas only ever chain to a full snapshot, so the base must carry a plain gradient section
+    if (!fstream.TryGetMarker(FileMarker::fileMarkerBeginSection, L"BGradient"))
+        RuntimeError("Delta checkpoint: the base checkpoint '%ls' is not a full snapshot.", checkPointFileName.c_str());
+
+    for (auto smoothedGradientIter = smoothedGradients.begin(); smoothedGradientIter != smoothedGradients.end(); smoothedGradientIter++)
+    {
+        Matrix<ElemType>& smoothedGradientValues = *smoothedGradientIter;
+        fstream >> smoothedGradientValues;
+    }
+    fstream.GetMarker(FileMarker::fileMarkerEndSection, L"EGradient");
+}
+
 template <class ElemType>
 wstring SGD<ElemType>::GetCheckPointFileNameForEpoch(const int epoch)
 {
     return GetModelNameForEpoch(epoch) + L".ckp";
 }
 
+template <class ElemType>
+wstring SGD<ElemType>::GetCheckPointShardNameForEpoch(const int epoch, const size_t shard)
+{
+    return GetCheckPointFileNameForEpoch(epoch) + msra::strfun::wstrprintf(L".shard%d", (int)shard);
+}
+
+template <class ElemType>
+void SGD<ElemType>::DeleteCheckPointFilesForEpoch(const int epoch)
+{
+    _wunlink(GetCheckPointFileNameForEpoch(epoch).c_str());
+    if (UseShardedCheckpointing())
+        for (size_t shard = 0; shard < m_mpi->NumNodesInUse(); shard++)
+            _wunlink(GetCheckPointShardNameForEpoch(epoch, shard).c_str());
+}
+
 template <class ElemType>
 wstring SGD<ElemType>::GetModelNameForEpoch(const int epoch, bool bLastModel) const
 {
@@ -2890,6 +3724,7 @@ SGDParams::SGDParams(const ConfigRecordType& configSGD, size_t sizeofElemType)
     m_minibatchSizeTuningFrequency = configAALR(L"minibatchSizeTuningFrequency", (size_t) 1);
     m_minibatchSizeTuningMax = configAALR(L"minibatchSizeTuningMax", (size_t) 1048576);
     m_minibatchSearchCriterionErrorMargin = configAALR(L"minibatchSearchCriterionErrorMargin", (size_t) 1);
+    m_useMinibatchSearchCache = configAALR(L"useMinibatchSearchCache", false);
 
     m_numPrevLearnRates = configAALR(L"numPrevLearnRates", (size_t) 5);
     m_numBestSearchEpoch = configAALR(L"numBestSearchEpoch", (size_t) 1);
@@ -2974,6 +3809,7 @@ SGDParams::SGDParams(const ConfigRecordType& configSGD, size_t sizeofElemType)
     m_seqGammarCalcLMF = configSGD(L"seqGammarLMF", 14.0);
     m_seqGammarCalcbMMIFactor = configSGD(L"seqGammarBMMIFactor", 0.0);
     m_seqGammarCalcWP = configSGD(L"seqGammarWordPen", 0.0);
+    m_seqGammarCalcNumLatticeDevices = configSGD(L"seqGammarNumLatticeDevices", (size_t) 1);
     m_disableRegInBatchNormalization = configSGD(L"disableRegInBatchNormalization", false);
 
     m_dropoutRates = configSGD(L"dropoutRate", ConfigRecordType::Array(doubleargvector(vector<double>{0.0})));
@@ -3016,6 +3852,7 @@ SGDParams::SGDParams(const ConfigRecordType& configSGD, size_t sizeofElemType)
     }
 
     m_useAllDataForPreComputedNode = configSGD(L"UseAllDataForPreComputedNode", true);
+    m_preComputeCacheFile = (const std::wstring&) configSGD(L"preComputeCacheFile", L"");
 
     // consistency checks
     for (size_t i = 0; i < m_mbSize.size(); i++)
@@ -3118,9 +3955,12 @@ SGDParams::SGDParams(const ConfigRecordType& configSGD, size_t sizeofElemType)
     m_numGradientBits = vector<int>{8 * (int)sizeofElemType}; // means no quantization
     m_zeroThresholdFor1Bit = true;
     m_bufferedAsyncGradientAggregation = false;
+    m_aggregationBucketSizeInBytes = 0;
+    m_topKGradientAggregationPercent = 0;
     m_enableDistributedMBReading = false;
     m_parallelizationStartEpochNum = 0;
-    m_modelAggregationBlockSize = 0; 
+    m_modelAggregationBlockSize = 0;
+    m_useMAOverlappedAveraging = false;
 
     if (configSGD.Exists(L"ParallelTrain"))
     {
@@ -3151,11 +3991,36 @@ SGDParams::SGDParams(const ConfigRecordType& configSGD, size_t sizeofElemType)
             m_numGradientBits = configDataParallelSGD(L"gradientBits", ConfigRecordType::Array(intargvector(vector<int>{defaultGradientBits})));
             m_zeroThresholdFor1Bit = configDataParallelSGD(L"useZeroThresholdFor1BitQuantization", true);
             m_bufferedAsyncGradientAggregation = configDataParallelSGD(L"useBufferedAsyncGradientAggregation", false);
+
+            // Bucketed aggregation starts allreducing each bucket of parameter gradients as soon as
+            // backprop has finished computing it, hiding the exchange behind the rest of the backward pass
+            bool useBucketedGradientAggregation = configDataParallelSGD(L"useBucketedGradientAggregation", false);
+            size_t aggregationBucketSizeInMB = configDataParallelSGD(L"aggregationBucketSizeInMB", (size_t)32);
+            m_aggregationBucketSizeInBytes = useBucketedGradientAggregation ? aggregationBucketSizeInMB * 1024 * 1024 : 0;
+            if (useBucketedGradientAggregation && m_bufferedAsyncGradientAggregation)
+                InvalidArgument("useBucketedGradientAggregation and useBufferedAsyncGradientAggregation cannot be combined.");
+
             for (size_t i = 0; i < m_numGradientBits.size(); i++)
             {
                 if (m_numGradientBits[i] < 1 || m_numGradientBits[i] > defaultGradientBits)
                     InvalidArgument("gradientBits values must be in the range [1, 32] when using precision=float and in range [1, 64] when using precision=double.");
             }
+
+            // Top-K sparsified aggregation: exchange only the largest-magnitude entries of each
+            // gradient and carry the remainder forward in an error-feedback residual
+            m_topKGradientAggregationPercent = configDataParallelSGD(L"topKGradientAggregationPercent", 0.0);
+            if (m_topKGradientAggregationPercent < 0 || m_topKGradientAggregationPercent > 100)
+                InvalidArgument("topKGradientAggregationPercent must be in the range [0, 100].");
+            if (m_topKGradientAggregationPercent > 0)
+            {
+                if (m_bufferedAsyncGradientAggregation)
+                    InvalidArgument("topKGradientAggregationPercent and useBufferedAsyncGradientAggregation cannot be combined.");
+                for (size_t i = 0; i < m_numGradientBits.size(); i++)
+                {
+                    if (m_numGradientBits[i] != defaultGradientBits)
+                        InvalidArgument("topKGradientAggregationPercent cannot be combined with gradient quantization (gradientBits).");
+                }
+            }
         }
         if (configParallelTrain.Exists(L"ModelAveragingSGD"))
         {
@@ -3170,8 +4035,9 @@ SGDParams::SGDParams(const ConfigRecordType& configSGD, size_t sizeofElemType)
                 m_modelAggregationBlockSize *= numMPIWorkers;
             }
             else
-                m_modelAggregationBlockSize = 40000 * numMPIWorkers;    // default value 
-#if 1           // legacy option 
+                m_modelAggregationBlockSize = 40000 * numMPIWorkers;    // default value
+            m_useMAOverlappedAveraging = configMASGD(L"useOverlappedAveraging", false);
+#if 1           // legacy option
             if (configMASGD.Exists(L"syncFrequencyInFrames"))
             {
                 if (configMASGD.Exists(L"blockSizePerWorker") || configMASGD.Exists(L"blockSize"))
@@ -13,6 +13,7 @@
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include <future>
 #include "fileutil.h"
 #include "Config.h"
 #include <chrono>
@@ -240,6 +241,7 @@ protected:
     size_t m_minibatchSearchCriterionErrorMargin;
     size_t m_minibatchSizeTuningFrequency;
     size_t m_minibatchSizeTuningMax;
+    bool m_useMinibatchSearchCache; // reuse prior search results (persisted in the checkpoint) instead of re-running trial epochs
 
     doubleargvector m_dropoutRates;
     doubleargvector m_batchNormalizationTimeConstant;
@@ -268,6 +270,7 @@ protected:
     bool m_doUnitTest;
 
     bool m_useAllDataForPreComputedNode;
+    std::wstring m_preComputeCacheFile; // if given, precompute results are cached here and side-loaded on subsequent runs
 
     // Parallel training
     MPIWrapperPtr m_mpi;
@@ -292,10 +295,13 @@ protected:
     // Data parallel SGD training parameters
     intargvector m_numGradientBits;
     bool m_bufferedAsyncGradientAggregation;
+    size_t m_aggregationBucketSizeInBytes; // > 0: overlap bucket-wise gradient aggregation with backprop
+    double m_topKGradientAggregationPercent; // > 0: exchange only the largest-magnitude entries, with error feedback
     bool m_zeroThresholdFor1Bit;
 
     // Parallel training related with MA / BM
     size_t m_modelAggregationBlockSize;
+    bool   m_useMAOverlappedAveraging; // start the model-averaging allreduce asynchronously and install the result at the next sync point
     bool   m_resetSGDMomentum; 
     bool   m_useNesterovBlockMomentum;
     double m_blockLearningRate; 
@@ -322,6 +328,7 @@ protected:
     double m_seqGammarCalcWP;
     double m_seqGammarCalcbMMIFactor;
     bool m_seqGammarCalcUsesMBR;
+    size_t m_seqGammarCalcNumLatticeDevices;
     
     // decide whether should apply regularization into BatchNormalizationNode
     // true: disable Regularization
@@ -353,12 +360,18 @@ public:
           // TODO: The next few do not belong into SGD any more than the network or reader we operate on. Either move network and reader in here, or move these out.
           m_modelPath((const wstring&) configSGD(L"modelPath")),
           m_keepCheckPointFiles(configSGD(L"keepCheckPointFiles", false)),
+          m_useAsyncCheckpointing(configSGD(L"useAsyncCheckpointing", false)),
+          m_fullCheckpointInterval(configSGD(L"fullCheckpointInterval", (size_t)1)),
+          m_checkpointDeltaBaseEpoch(-1),
+          m_retiredCheckpointBaseEpoch(-1),
+          m_useShardedCheckpointing(configSGD(L"shardedCheckpointing", false)),
           m_saveBestModelPerCriterion(configSGD(L"saveBestModelPerCriterion", false)),
           m_trainCriterionNodeName((const wstring&) configSGD(L"trainCriterionNodeName", L"")),
           m_evalCriterionNodeName ((const wstring&) configSGD(L"evalCriterionNodeName", L"")),
           m_traceNodeNamesReal    (configSGD(L"traceNodeNamesReal",     ConfigRecordType::Array(stringargvector()))),
           m_traceNodeNamesCategory(configSGD(L"traceNodeNamesCategory", ConfigRecordType::Array(stringargvector()))),
           m_traceNodeNamesSparse  (configSGD(L"traceNodeNamesSparse",   ConfigRecordType::Array(stringargvector()))),
+          m_gradientCheckpointNodeNames(configSGD(L"gradientCheckpointNodes", ConfigRecordType::Array(stringargvector()))),
           m_prevChosenMinibatchSize(0),
           m_lastFinishedEpochTrainLoss(0.0),
           m_distGradAgg(nullptr),
@@ -411,6 +424,10 @@ protected:
                     const std::vector<ComputationNodeBasePtr>& labelNodes,
                     StreamMinibatchInputs* inputMatrices);
 
+    // sidecar cache for precompute results, cf. preComputeCacheFile
+    bool TryLoadPreComputeCache(const std::list<ComputationNodeBasePtr>& nodes);
+    void SavePreComputeCache(const std::list<ComputationNodeBasePtr>& nodes);
+
     // return a reasonable initial learning rate based on the initial mbsize
     double SearchForBestLearnRate(ComputationNetworkPtr net,
                                   ComputationNetworkPtr refNet,
@@ -480,6 +497,10 @@ protected:
                                       std::list<Matrix<ElemType>>& smoothedGradients, std::vector<double> smoothedCounts,
                                       const size_t minMinibatchSize, const size_t maxMinibatchSize);
 
+    // key under which a minibatch-size search result is cached (cf. m_useMinibatchSearchCache)
+    std::pair<int, size_t> MinibatchSearchCacheKey(const double learnRatePerSample,
+                                                   const std::list<ComputationNodeBasePtr>& learnableNodes) const;
+
     // Attemps to compute the error signal for the whole utterance, which will
     // be fed to the neural network as features. Currently it is a workaround
     // for the two-forward-pass sequence and ctc training, which allows
@@ -530,6 +551,7 @@ public:
 
 protected:
     void ClipGradient(Matrix<ElemType>& gradient, const size_t actualMBSize) const;
+    void ClipGradients(const std::list<ComputationNodeBasePtr>& learnableNodes, const size_t actualMBSize) const;
 
     void SaveCheckPointInfo(const size_t epoch, const size_t totalSamplesSeen, // TODO: combine totalSamplesSeen and prevCriterion into a EpochCriterion type
                             const double learnRatePerSample,
@@ -538,6 +560,54 @@ protected:
                             const double prevCriterion,
                             const size_t minibatchSize);
 
+    void WriteCheckPointFile(const std::wstring& checkPointFileName, const size_t totalSamplesSeen,
+                             const double learnRatePerSample,
+                             const std::list<Matrix<ElemType>>& smoothedGradients,
+                             const std::vector<double>& smoothedCounts,
+                             const double prevCriterion,
+                             const size_t minibatchSize,
+                             const std::map<std::wstring, BestEpoch>& criteriaBestEpoch,
+                             const std::map<std::pair<int, size_t>, size_t>& mbSearchCache,
+                             const std::list<Matrix<ElemType>>* deltaBase, // when non-null, the gradients are stored as a delta against this snapshot
+                             const int deltaBaseEpoch,
+                             const size_t numShards = 0); // when non-zero, the gradients live in shard files and only their count is recorded
+
+    // Reads just the smoothed-gradient section of the given epoch's (full) checkpoint file;
+    // used to resolve a delta checkpoint against the snapshot it was encoded against.
+    void ReadCheckpointGradients(const size_t epochNumber, std::list<Matrix<ElemType>>& smoothedGradients);
+
+    // Sharded checkpointing (cf. shardedCheckpointing): every rank writes its assigned slice of
+    // the smoothed gradients to a per-rank shard file in parallel, the main node writes the
+    // primary file with the scalar state and the shard count. Must be called by ALL ranks.
+    void SaveShardedCheckPoint(const size_t epoch, const size_t totalSamplesSeen,
+                               const double learnRatePerSample,
+                               const std::list<Matrix<ElemType>>& smoothedGradients,
+                               const std::vector<double>& smoothedCounts,
+                               const double prevCriterion,
+                               const size_t minibatchSize);
+
+    // Reads the smoothed gradients back from the shard files of the given epoch.
+    void ReadShardedCheckpointGradients(const size_t epochNumber, const size_t numShards,
+                                        std::list<Matrix<ElemType>>& smoothedGradients);
+
+    // Removes the checkpoint file of the given epoch, including its shard files if any.
+    void DeleteCheckPointFilesForEpoch(const int epoch);
+
+    bool UseShardedCheckpointing() const
+    {
+        return m_useShardedCheckpointing && m_mpi != nullptr && m_mpi->NumNodesInUse() > 1;
+    }
+
+    std::wstring GetCheckPointShardNameForEpoch(const int epoch, const size_t shard);
+
+    // Wait until a background checkpoint write (cf. useAsyncCheckpointing) has finished;
+    // must be called before reading, deleting or rewriting checkpoint files
+    void WaitForPendingCheckpointWrite()
+    {
+        if (m_pendingCheckpointWrite.valid())
+            m_pendingCheckpointWrite.get(); // rethrows any error the background write hit
+    }
+
     bool TryLoadCheckPointInfo(const size_t epochNumber,
                                /*out*/ size_t& totalSamplesSeen,
                                /*out*/ double& learnRatePerSample,
@@ -575,6 +645,16 @@ public:
 protected:
     std::wstring m_modelPath;
     bool m_keepCheckPointFiles;
+    bool m_useAsyncCheckpointing; // snapshot the learner state and stream it to disk on a background thread
+    std::future<void> m_pendingCheckpointWrite; // the checkpoint write currently in flight, if any
+    // Delta checkpointing (cf. fullCheckpointInterval): every n-th epoch writes a full checkpoint,
+    // the epochs in between store the smoothed gradients XOR-encoded against the last full snapshot,
+    // which stays resident in host memory and must stay on disk until the next full snapshot lands.
+    size_t m_fullCheckpointInterval;
+    std::shared_ptr<std::list<Matrix<ElemType>>> m_checkpointDeltaBase; // host copy of the last full snapshot's smoothed gradients
+    int m_checkpointDeltaBaseEpoch;    // epoch of the last full snapshot, -1 if none was written by this process
+    int m_retiredCheckpointBaseEpoch;  // full snapshot superseded by a newer one, pending deletion
+    bool m_useShardedCheckpointing;    // spread the checkpoint write across all ranks, cf. SaveShardedCheckPoint()
     bool m_saveBestModelPerCriterion;
     // Mapping from criterion to the best epoch on validation data set.
     std::map<std::wstring, BestEpoch> m_criteriaBestEpoch;
@@ -587,7 +667,13 @@ protected:
     std::vector<std::wstring> m_traceNodeNamesCategory;
     std::vector<std::wstring> m_traceNodeNamesSparse;
 
+    // gradient checkpointing: nodes whose activations are retained as recomputation cut points
+    std::vector<std::wstring> m_gradientCheckpointNodeNames;
+
     size_t m_prevChosenMinibatchSize;
+    // results of earlier minibatch-size searches, keyed by (learning-rate band, model signature);
+    // persisted into the checkpoint so a restarted job does not redo the trial epochs
+    std::map<std::pair<int, size_t>, size_t> m_mbSearchCache;
     double m_lastFinishedEpochTrainLoss;
 
     std::shared_ptr<IDistGradAggregator<ElemType>> m_distGradAgg;
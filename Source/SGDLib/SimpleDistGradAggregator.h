@@ -10,7 +10,9 @@
 #include "IDistGradAggregator.h"
 #include "CUDAPageLockedMemAllocator.h"
 #include "NcclComm.h"
+#include <algorithm>
 #include <future>
+#include <set>
 #include "GPUDataTransferer.h"
 #include "TimerUtility.h"
 #include "MatrixQuantizerImpl.h"
@@ -23,10 +25,17 @@ class SimpleDistGradAggregator : public IDistGradAggregator<ElemType>
     UsingIDistGradAggregatorMembers;
 
 public:
-    SimpleDistGradAggregator(const MPIWrapperPtr& mpi, bool useAsyncAggregation, int deviceId, int syncStatsTrace, size_t packThresholdSizeInBytes = DEFAULT_PACK_THRESHOLD_SIZE_IN_BYTES)
+    SimpleDistGradAggregator(const MPIWrapperPtr& mpi, bool useAsyncAggregation, int deviceId, int syncStatsTrace, size_t packThresholdSizeInBytes = DEFAULT_PACK_THRESHOLD_SIZE_IN_BYTES, size_t bucketSizeInBytes = 0)
         : IDistGradAggregator<ElemType>(mpi), m_useAsyncAggregation(useAsyncAggregation), m_initialized(false), m_bufferedGradHeader(nullptr), m_syncStatsTrace(syncStatsTrace),
-        m_iterationCount(0), m_nccl(deviceId, mpi), m_packThresholdSizeInBytes(packThresholdSizeInBytes)
-    {}
+        m_iterationCount(0), m_nccl(deviceId, mpi, true /*intraHostWhenMultiHost*/), m_packThresholdSizeInBytes(packThresholdSizeInBytes),
+        m_bucketSizeInBytes(bucketSizeInBytes), m_bucketsInitialized(false), m_numBucketsIssued(0), m_showBucketSyncStats(false),
+        m_hierarchicalShardElements(0)
+    {
+        // A multi-host job with several GPUs per host gets an intra-host NCCL communicator;
+        // if additionally every host runs the same number of ranks, the per-host shards line
+        // up and we aggregate hierarchically, cf. AggregateGradientsHierarchicalImpl()
+        m_hierarchical = m_nccl.IsSupported() && !m_nccl.SpansAllRanks() && m_mpi->HostsAreUniform();
+    }
 
     ~SimpleDistGradAggregator()
     {
@@ -125,6 +134,207 @@ public:
         }
     }
 
+    bool SupportsBucketedAggregation() const override
+    {
+        // Bucketed aggregation needs final gradients at bucket-issue time; the double-buffered
+        // async mode instead ships the previous minibatch's gradients, so the two overlap
+        // schemes are mutually exclusive.
+        return (m_bucketSizeInBytes > 0) && !m_useAsyncAggregation;
+    }
+
+    void BeginBucketedAggregation(const std::vector<Matrix<ElemType>*>& gradients, int numEvalNodes, bool resetState) override
+    {
+        if (!SupportsBucketedAggregation())
+            LogicError("BeginBucketedAggregation: Aggregator was not configured for bucketed aggregation!");
+
+        if (m_bucketChain.valid())
+            LogicError("BeginBucketedAggregation: Unexpected pending bucketed aggregation found!");
+
+        if (!m_bucketsInitialized)
+        {
+            m_bucketsInitialized = true;
+            int deviceId = gradients[0]->GetDeviceId();
+
+            if (ShouldCopyDataToCPU(deviceId) && (m_allocator == nullptr))
+                m_allocator.reset(new CUDAPageLockedMemAllocator(deviceId));
+
+            m_bucketedGradients = gradients;
+
+            // Greedily group the gradients, which are listed in the order the backward pass
+            // finalizes them, into buckets of at least m_bucketSizeInBytes, so that buckets
+            // fill (and ship) front to back as backprop proceeds
+            for (size_t i = 0; i < gradients.size(); i++)
+            {
+                // Make sure none of the gradient matrixes are sparse - we currently do not support aggregation of sparse gradient matrices
+                if (gradients[i]->GetMatrixType() != DENSE)
+                    RuntimeError("Gradient aggregation for sparse gradient matrices is currently unsupported!");
+
+                if (m_buckets.empty() || ((m_buckets.back().numElements * sizeof(ElemType)) >= m_bucketSizeInBytes))
+                    m_buckets.push_back(Bucket());
+
+                m_gradientToBucket[gradients[i]] = m_buckets.size() - 1;
+                m_buckets.back().gradients.push_back(gradients[i]);
+                m_buckets.back().numElements += gradients[i]->GetNumElements();
+            }
+
+            // NCCL and CUDA-aware MPI reduce the individual gradients in place; the plain MPI
+            // path reduces each bucket as one message out of a contiguous buffer
+            if (!(m_nccl.IsSupported() && m_nccl.SpansAllRanks()) && !((m_mpi->UseGpuGdr() != 0) && (deviceId != CPUDEVICE)))
+            {
+                for (Bucket& bucket : m_buckets)
+                {
+                    bucket.packBuffer.reset(new Matrix<ElemType>(1, bucket.numElements, deviceId));
+                    if (ShouldCopyDataToCPU(deviceId))
+                    {
+                        bucket.transferer = std::make_unique<GPUDataTransferer>(deviceId, true /*useConcurrentStreams*/);
+                        bucket.cpuBuffer = AllocateIntermediateBuffer(deviceId, bucket.numElements);
+                    }
+                }
+            }
+
+            if (m_mpi->IsMainNode() && m_recvHeaders.empty())
+            {
+                for (size_t i = 0; i < NumProc() - 1; ++i)
+                    m_recvHeaders.push_back(DistGradHeader::Create(numEvalNodes));
+            }
+        }
+
+        // Unlike the async mode there is no buffered cross-minibatch state, so there is nothing
+        // further to do on resetState; just rearm the per-minibatch bookkeeping
+        resetState;
+        for (Bucket& bucket : m_buckets)
+            bucket.numComplete = 0;
+        m_numBucketsIssued = 0;
+
+        m_showBucketSyncStats = (m_syncStatsTrace > 0) && ((m_iterationCount % m_syncStatsTrace) == 0);
+        m_iterationCount++;
+    }
+
+    void NotifyGradientComplete(Matrix<ElemType>* gradient) override
+    {
+        auto iter = m_gradientToBucket.find(gradient);
+        if (iter == m_gradientToBucket.end()) // not a gradient we aggregate (e.g. a non-parameter node)
+            return;
+
+        m_buckets[iter->second].numComplete++;
+
+        // Issue buckets strictly in order, so that every rank posts the same collective sequence
+        // no matter how its backward pass is timed
+        while ((m_numBucketsIssued < m_buckets.size()) &&
+               (m_buckets[m_numBucketsIssued].numComplete == m_buckets[m_numBucketsIssued].gradients.size()))
+        {
+            IssueBucket(m_buckets[m_numBucketsIssued]);
+            m_numBucketsIssued++;
+        }
+    }
+
+    bool CompleteBucketedAggregation(DistGradHeader* headerCPU) override
+    {
+        // A worker that read no data skipped backprop entirely, so no bucket has been issued
+        // yet; its gradients must go into the reduction as zeroes
+        if (headerCPU->numSamples == 0)
+        {
+            assert(headerCPU->criterion == 0.0);
+            assert(headerCPU->numSamplesWithLabel == 0);
+            for (int i = 0; i < headerCPU->numEvalNode; ++i)
+                assert(headerCPU->evalErrors[i].first == 0 && headerCPU->evalErrors[i].second == 0);
+
+            for (size_t i = 0; i < m_bucketedGradients.size(); ++i)
+                m_bucketedGradients[i]->SetValue(0);
+        }
+
+        // Flush buckets whose gradients never reported complete (an empty minibatch, or
+        // parameters the training criterion does not reach)
+        while (m_numBucketsIssued < m_buckets.size())
+        {
+            IssueBucket(m_buckets[m_numBucketsIssued]);
+            m_numBucketsIssued++;
+        }
+
+        Timer aggregationTimer;
+        if (m_showBucketSyncStats)
+            aggregationTimer.Start();
+
+        // Wait for the worker chain to drain before touching MPI from this thread; the chain
+        // owns all MPI traffic while it is running
+        if (m_bucketChain.valid())
+            m_bucketChain.get();
+
+        // Exchange and aggregate the headers, the same way AggregateGradientsImpl() does
+        size_t numGradMatrices = m_bucketedGradients.size();
+        std::vector<MPI_Request> recvHeaderRequests(NumProc() - 1);
+        if (m_mpi->IsMainNode())
+        {
+            for (size_t j = 0; j < NumProc() - 1; ++j)
+            {
+                int source = (j >= MyRank()) ? (j + 1) : j;
+                // We use a tag of 'numGradMatrices' for the pre-aggregation header
+                m_mpi->Irecv(m_recvHeaders[j], m_recvHeaders[j]->Size(), MPI_CHAR, source, numGradMatrices, &(recvHeaderRequests[j])) || MpiFail("MPI_Irecv");
+            }
+        }
+
+        MPI_Request sendHeaderRequest;
+        if (!m_mpi->IsMainNode())
+            m_mpi->Isend(headerCPU, headerCPU->Size(), MPI_CHAR, m_mpi->MainNodeRank(), numGradMatrices, &sendHeaderRequest) || MpiFail("MPI_Isend");
+
+        // On the main node wait for the headers to arrive and aggregate
+        if (m_mpi->IsMainNode())
+        {
+            size_t numNodesHeadersReceivedFrom = 0;
+            while (numNodesHeadersReceivedFrom < (NumProc() - 1))
+            {
+                int idx = MPI_UNDEFINED;
+                m_mpi->Waitany(recvHeaderRequests.size(), recvHeaderRequests.data(), &idx, MPI_STATUS_IGNORE) || MpiFail("MPI_Waitany");
+                if (idx == MPI_UNDEFINED)
+                {
+                    break;
+                }
+
+                numNodesHeadersReceivedFrom++;
+
+                headerCPU->Aggregate(m_recvHeaders[idx], true);
+            }
+
+            assert(numNodesHeadersReceivedFrom == (NumProc() - 1));
+        }
+
+        // Broadcast the aggregated header to all nodes
+        m_mpi->Bcast(headerCPU, headerCPU->Size(), MPI_CHAR, m_mpi->MainNodeRank());
+
+        if (m_nccl.IsSupported() && m_nccl.SpansAllRanks())
+            m_nccl.Sync();
+
+        // Scatter the reduced buckets back into the individual gradient matrices
+        for (Bucket& bucket : m_buckets)
+        {
+            if (bucket.packBuffer == nullptr) // NCCL / CUDA-aware MPI reduced the gradients in place
+                continue;
+
+            if (bucket.transferer != nullptr)
+                bucket.transferer->WaitForCopyCPUToGPUAsync(); // reduced data is still on its way back to the device
+
+            size_t offset = 0;
+            for (Matrix<ElemType>* gradient : bucket.gradients)
+            {
+                gradient->AssignValuesOf(bucket.packBuffer->ColumnSlice(offset, gradient->GetNumElements()).Reshaped(gradient->GetNumRows(), gradient->GetNumCols()));
+                offset += gradient->GetNumElements();
+            }
+        }
+
+        // Wait for completion of the async send requests
+        if (!m_mpi->IsMainNode())
+            m_mpi->Wait(&sendHeaderRequest, MPI_STATUSES_IGNORE) || MpiFail("MPI_Wait");
+
+        if (m_showBucketSyncStats)
+        {
+            aggregationTimer.Stop();
+            double gradientAggregationTime = aggregationTimer.ElapsedSeconds();
+            fprintf(stderr, "Bucketed gradient aggregation wait time: %.6g\n", gradientAggregationTime);
+        }
+
+        return (headerCPU->numSamples != 0);
+    }
+
 private:
     std::shared_ptr<ElemType> AllocateIntermediateBuffer(int deviceID, size_t numElements)
     {
@@ -144,13 +354,121 @@ private:
         if (deviceId == CPUDEVICE)
             return false;
 
-        // Do not copy if NCCL is supported or GPUDirect RDMA is used
-        if (m_nccl.IsSupported() || m_mpi->UseGpuGdr() == true)
+        // Do not copy if NCCL spans all ranks or GPUDirect RDMA is used; an intra-host-only
+        // NCCL communicator still leaves the cross-host exchange to plain MPI
+        if ((m_nccl.IsSupported() && m_nccl.SpansAllRanks()) || m_mpi->UseGpuGdr() == true)
             return false;
 
         return true;
     }
 
+    // One bucket of gradients for the bucketed (overlapped) aggregation mode
+    struct Bucket
+    {
+        std::vector<Matrix<ElemType>*> gradients;     // members, listed in backward completion order
+        size_t numElements = 0;                       // total elements across the members
+        size_t numComplete = 0;                       // members reported complete in this minibatch
+        std::unique_ptr<Matrix<ElemType>> packBuffer; // contiguous reduce buffer (plain MPI path only)
+        std::shared_ptr<ElemType> cpuBuffer;          // pinned host staging for packBuffer
+        std::unique_ptr<GPUDataTransferer> transferer;
+    };
+
+    // Reduce one bucket of finished gradients while backprop is still producing the rest.
+    // NCCL buckets go straight onto the communication stream; the MPI paths run on the single
+    // worker chain so the main thread immediately returns to enqueueing backprop work.
+    void IssueBucket(Bucket& bucket)
+    {
+        int deviceId = m_bucketedGradients[0]->GetDeviceId();
+
+        // NCCL reduces straight out of device memory, ordered behind the compute stream
+        // (only if it spans all ranks; intra-host-only NCCL cannot do the full reduction)
+        if (m_nccl.IsSupported() && m_nccl.SpansAllRanks())
+        {
+            m_nccl.AllReduce(bucket.gradients);
+            return;
+        }
+
+        // CUDA-aware MPI also reduces device memory in place, but blocks the calling thread,
+        // so run it on the worker chain once the compute stream has caught up
+        if ((m_mpi->UseGpuGdr() != 0) && (deviceId != CPUDEVICE))
+        {
+            MatrixComputeStreamEvent* mainStreamSyncEvent = MatrixComputeStreamEvent::Create(deviceId);
+            std::vector<Matrix<ElemType>*> bucketGradients = bucket.gradients;
+            MPIWrapperPtr mpi = m_mpi;
+            ChainBucketWork([=]
+            {
+                Matrix<ElemType>::SetDevice(deviceId);
+                mainStreamSyncEvent->SynchronizeEvent();
+                delete mainStreamSyncEvent;
+
+                for (Matrix<ElemType>* gradient : bucketGradients)
+                    mpi->AllReduce(gradient->Data(), gradient->GetNumElements());
+            });
+            return;
+        }
+
+        // Pack the members into the bucket's contiguous buffer, so the bucket travels as a
+        // single message. On a GPU device this enqueues onto the compute stream, i.e. behind
+        // the kernels that produced the gradients.
+        size_t offset = 0;
+        for (Matrix<ElemType>* gradient : bucket.gradients)
+        {
+            bucket.packBuffer->ColumnSlice(offset, gradient->GetNumElements()).AssignValuesOf(gradient->Reshaped(1, gradient->GetNumElements()));
+            offset += gradient->GetNumElements();
+        }
+
+        MPIWrapperPtr mpi = m_mpi;
+        ElemType* cpuBuffer = bucket.cpuBuffer.get();
+        ElemType* packBuffer = bucket.packBuffer->Data();
+        size_t numElements = bucket.numElements;
+        if (deviceId != CPUDEVICE)
+        {
+            MatrixComputeStreamEvent* mainStreamSyncEvent = MatrixComputeStreamEvent::Create(deviceId);
+            GPUDataTransferer* transferer = bucket.transferer.get();
+            ChainBucketWork([=]
+            {
+                Matrix<ElemType>::SetDevice(deviceId);
+
+                // fetch the packed bucket once the compute stream has produced it
+                mainStreamSyncEvent->SynchronizeDataTransferFetchStreamWithEvent<ElemType>();
+                delete mainStreamSyncEvent;
+                transferer->CopyGPUToCPUAsync(packBuffer, numElements, cpuBuffer);
+                transferer->WaitForCopyGPUToCPUAsync();
+
+                mpi->AllReduce(cpuBuffer, numElements);
+
+                // completion of the copy back is awaited in CompleteBucketedAggregation()
+                transferer->CopyCPUToGPUAsync(cpuBuffer, numElements, packBuffer);
+            });
+        }
+        else
+        {
+            ChainBucketWork([=]
+            {
+                mpi->AllReduce(packBuffer, numElements);
+            });
+        }
+    }
+
+    // Appends one unit of work to the single worker chain. A minibatch's buckets are reduced
+    // one after another on that chain, keeping the per-rank collective order deterministic.
+    void ChainBucketWork(std::function<void()> work)
+    {
+        if (!m_bucketChain.valid())
+        {
+            m_bucketChain = std::async(std::launch::async, std::move(work));
+        }
+        else
+        {
+            auto previousWork = std::make_shared<std::future<void>>(std::move(m_bucketChain));
+            m_bucketChain = std::async(std::launch::async, [previousWork, work]
+            {
+                previousWork->get();
+                work();
+            });
+        }
+    }
+
     void ResetState(const std::vector<Matrix<ElemType>*>& gradients, int numEvalNodes, bool resetState)
     {
         // When called the first time let's setup the intermediateCPU buffers for gradient aggregation if needed
@@ -165,10 +483,37 @@ private:
                 m_allocator.reset(new CUDAPageLockedMemAllocator(deviceId));
             }
 
+            // Block-sparse gradients cannot ride the hierarchical contiguous buffer; fall
+            // back to the flat aggregation when any are present
+            if (m_hierarchical)
+            {
+                for (size_t i = 0; i < gradients.size(); i++)
+                {
+                    if (gradients[i]->GetMatrixType() != DENSE)
+                    {
+                        fprintf(stderr, "SimpleDistGradAggregator: sparse gradients present, falling back from hierarchical to flat aggregation\n");
+                        m_hierarchical = false;
+                        break;
+                    }
+                }
+            }
+
             size_t packedGradientsSizeInElements = 0;
             for (size_t i = 0; i < gradients.size(); i++)
             {
-                if (!m_useAsyncAggregation && sizeof(ElemType) * gradients[i]->GetNumElements() <= m_packThresholdSizeInBytes)
+                // Block-sparse gradients (e.g. of embedding layers) are aggregated by exchanging
+                // only their occupied blocks, cf. AggregateBlockSparseGradient(); other sparse
+                // formats and the double-buffered async mode remain unsupported
+                if (gradients[i]->GetMatrixType() != DENSE)
+                {
+                    if (m_useAsyncAggregation || gradients[i]->GetFormat() != matrixFormatSparseBlockCol)
+                        RuntimeError("Gradient aggregation is only supported for dense and (without async aggregation) sparse block-column gradient matrices!");
+
+                    m_sparseGradientIndex.push_back(i);
+                    continue;
+                }
+
+                if (!m_useAsyncAggregation && !m_hierarchical && sizeof(ElemType) * gradients[i]->GetNumElements() <= m_packThresholdSizeInBytes)
                 {
                     packedGradientsSizeInElements += gradients[i]->GetNumElements();
                     m_packedGradientsIndex.push_back(i);
@@ -178,10 +523,6 @@ private:
                     m_gradientIndexToAggregate.push_back(i);
                 }
 
-                // Make sure none of the gradient matrixes are sparse - we currently do not support aggregation of sparse gradient matrices
-                if (gradients[i]->GetMatrixType() != DENSE)
-                    RuntimeError("Gradient aggregation for sparse gradient matrices is currently unsupported!");
-
                 if (m_useAsyncAggregation)
                     m_bufferedGradients[gradients[i]].reset(new Matrix<ElemType>(gradients[i]->GetNumRows(), gradients[i]->GetNumCols(), deviceId));
             }
@@ -201,7 +542,8 @@ private:
                 // Reuse "@param m_gradientIndexToAggregate" for following code, if no continous buffer allocated
                 for (size_t i = 0; i < gradients.size(); i++)
                 {
-                    m_gradientIndexToAggregate.push_back(i);
+                    if (gradients[i]->GetMatrixType() == DENSE)
+                        m_gradientIndexToAggregate.push_back(i);
                 }
             }
             else
@@ -210,7 +552,7 @@ private:
                 m_gradientIndexToAggregate.insert(m_gradientIndexToAggregate.begin(), 1, (size_t)-1);
             }
 
-            if (ShouldCopyDataToCPU(deviceId))
+            if (!m_hierarchical && ShouldCopyDataToCPU(deviceId))
             {
                 for (size_t i : m_gradientIndexToAggregate)
                 {
@@ -220,6 +562,32 @@ private:
                 }
             }
 
+            // Hierarchical mode reduces the whole model out of one contiguous buffer: an
+            // intra-host NCCL reduce-scatter leaves this rank holding one reduced shard,
+            // MPI completes the sum across hosts, and an NCCL allgather redistributes it
+            if (m_hierarchical)
+            {
+                size_t totalElements = 0;
+                for (size_t i = 0; i < gradients.size(); i++)
+                    totalElements += gradients[i]->GetNumElements();
+
+                // pad the buffer so it splits into equal shards, one per rank on this host;
+                // the padding is zeroed once and only ever accumulates zeroes
+                size_t numShards = m_mpi->NumRanksOnHost();
+                size_t paddedElements = ((totalElements + numShards - 1) / numShards) * numShards;
+                m_hierarchicalShardElements = paddedElements / numShards;
+                m_hierarchicalBuffer.reset(new Matrix<ElemType>(1, paddedElements, deviceId));
+                m_hierarchicalBuffer->SetValue(0);
+
+                if (m_mpi->UseGpuGdr() == 0)
+                {
+                    if (m_allocator == nullptr)
+                        m_allocator.reset(new CUDAPageLockedMemAllocator(deviceId));
+                    m_hierarchicalCPUBuffer = AllocateIntermediateBuffer(deviceId, m_hierarchicalShardElements);
+                    m_hierarchicalTransferer = std::make_unique<GPUDataTransferer>(deviceId, m_useAsyncAggregation);
+                }
+            }
+
             if (m_useAsyncAggregation)
             {
                 m_bufferedGradHeader = DistGradHeader::Create(numEvalNodes);
@@ -251,6 +619,12 @@ private:
 
     void AggregateGradientsImpl(const std::vector<Matrix<ElemType>*>& gradients, DistGradHeader* headerCPU, bool showSyncPerfStats)
     {
+        if (m_hierarchical)
+        {
+            AggregateGradientsHierarchicalImpl(gradients, headerCPU, showSyncPerfStats);
+            return;
+        }
+
         Timer aggregationTimer;
         int deviceId = gradients[0]->GetDeviceId();
         if (showSyncPerfStats)
@@ -328,7 +702,7 @@ private:
 
         // Perform async allreduce on the gradient data
         std::vector<MPI_Request> allReduceRequests;
-        if (!m_nccl.IsSupported())
+        if (!(m_nccl.IsSupported() && m_nccl.SpansAllRanks()))
         {
             size_t allReduceIndex = 0;
             ElemType* reductionBuffer;
@@ -389,7 +763,7 @@ private:
         // Broadcast the aggregated header to all nodes
         m_mpi->Bcast(headerCPU, headerCPU->Size(), MPI_CHAR, m_mpi->MainNodeRank());
 
-        if (m_nccl.IsSupported())
+        if (m_nccl.IsSupported() && m_nccl.SpansAllRanks())
         {
             m_nccl.Sync();
         }
@@ -418,6 +792,10 @@ private:
             }
         }
 
+        // Aggregate the block-sparse gradients over the union of the occupied blocks
+        for (size_t i : m_sparseGradientIndex)
+            AggregateBlockSparseGradient(gradients[i]);
+
         // Copy data back to the packed gradients from the continous buffer
         offset = 0;
         for (size_t i : m_packedGradientsIndex)
@@ -438,6 +816,182 @@ private:
         }
     }
 
+    // Aggregate a sparse block-column gradient (e.g. an embedding layer's gradient, which only
+    // touches the columns of the words seen in the minibatch) without inflating it to the dense
+    // layer size: the ranks exchange their block-id sets, and a single allreduce covers just the
+    // union of the touched blocks. The exchange is host-side; for a GPU gradient only the
+    // occupied blocks travel across PCIe.
+    void AggregateBlockSparseGradient(Matrix<ElemType>* gradient)
+    {
+        size_t numRows = gradient->GetNumRows();
+
+        // Pull this rank's blocks to the host
+        size_t numBlocks = gradient->GetSBCFormatBlockCount();
+        std::vector<size_t> blockIds(numBlocks);
+        std::vector<ElemType> blockData(numBlocks * numRows);
+        if (numBlocks > 0)
+            gradient->CopyMatrixToSBCFormat(blockIds.data(), blockData.data());
+
+        // Gather every rank's block count, then the block-id lists padded to the largest count
+        std::vector<size_t> blockCounts(NumProc());
+        m_mpi->AllGather(&numBlocks, 1, blockCounts.data(), 1);
+
+        size_t maxBlocks = *std::max_element(blockCounts.begin(), blockCounts.end());
+        if (maxBlocks == 0) // no rank touched any block
+            return;
+
+        std::vector<size_t> paddedBlockIds(maxBlocks, SIZE_MAX);
+        std::copy(blockIds.begin(), blockIds.end(), paddedBlockIds.begin());
+        std::vector<size_t> allBlockIds(maxBlocks * NumProc());
+        m_mpi->AllGather(paddedBlockIds.data(), maxBlocks, allBlockIds.data(), maxBlocks);
+
+        // Union of the touched blocks, in ascending column order on every rank
+        std::set<size_t> unionSet;
+        for (size_t rank = 0; rank < NumProc(); rank++)
+            unionSet.insert(allBlockIds.begin() + rank * maxBlocks, allBlockIds.begin() + rank * maxBlocks + blockCounts[rank]);
+        std::vector<size_t> unionIds(unionSet.begin(), unionSet.end());
+
+        // Scatter this rank's blocks into their union slots; a single in-place allreduce over
+        // the union then completes the sum
+        std::vector<ElemType> unionData(unionIds.size() * numRows, ElemType(0));
+        for (size_t b = 0; b < numBlocks; b++)
+        {
+            size_t slot = std::lower_bound(unionIds.begin(), unionIds.end(), blockIds[b]) - unionIds.begin();
+            memcpy(unionData.data() + slot * numRows, blockData.data() + b * numRows, sizeof(ElemType) * numRows);
+        }
+        m_mpi->AllReduce(unionData.data(), unionData.size());
+
+        // Rebuild the gradient from the union's reduced blocks
+        gradient->SetMatrixFromSBCFormat(unionIds.data(), unionData.data(), unionIds.size(), numRows, gradient->GetNumCols());
+    }
+
+    // Hierarchical aggregation for multi-host jobs with several GPUs per host: an intra-host
+    // NCCL reduce-scatter leaves each local rank holding one reduced shard of the model, a
+    // cross-host MPI allreduce among the ranks holding the same shard completes the sum, and
+    // an intra-host NCCL allgather redistributes the result. The inter-host fabric then
+    // carries each gradient element once per host instead of once per rank.
+    void AggregateGradientsHierarchicalImpl(const std::vector<Matrix<ElemType>*>& gradients, DistGradHeader* headerCPU, bool showSyncPerfStats)
+    {
+        Timer aggregationTimer;
+        int deviceId = gradients[0]->GetDeviceId();
+        if (showSyncPerfStats)
+        {
+            std::unique_ptr<MatrixComputeStreamEvent> mainStreamSyncEvent(MatrixComputeStreamEvent::Create(deviceId));
+            mainStreamSyncEvent->SynchronizeEvent();
+            aggregationTimer.Start();
+        }
+
+        size_t numGradMatrices = gradients.size();
+
+        if (headerCPU->numSamples == 0)
+        {
+            assert(headerCPU->criterion == 0.0);
+            assert(headerCPU->numSamplesWithLabel == 0);
+            for (int i = 0; i < headerCPU->numEvalNode; ++i)
+                assert(headerCPU->evalErrors[i].first == 0 && headerCPU->evalErrors[i].second == 0);
+
+            // If the current node did not process any samples, the gradients should be zero'd
+            for (size_t i = 0; i < numGradMatrices; ++i)
+                gradients[i]->SetValue(0);
+        }
+
+        // Pack all gradients into the contiguous buffer; the padding beyond the gradient data
+        // stays zero. On a GPU device this enqueues behind the kernels that produced the
+        // gradients, the same ordering the flat NCCL path relies on.
+        size_t offset = 0;
+        for (size_t i = 0; i < numGradMatrices; i++)
+        {
+            m_hierarchicalBuffer->ColumnSlice(offset, gradients[i]->GetNumElements()).AssignValuesOf(gradients[i]->Reshaped(1, gradients[i]->GetNumElements()));
+            offset += gradients[i]->GetNumElements();
+        }
+
+        // Initiate receive of the header on the main node
+        std::vector<MPI_Request> recvHeaderRequests(NumProc() - 1);
+        if (m_mpi->IsMainNode())
+        {
+            for (size_t j = 0; j < NumProc() - 1; ++j)
+            {
+                int source = (j >= MyRank()) ? (j + 1) : j;
+                // We use a tag of 'numGradMatrices' for the pre-aggregation header
+                m_mpi->Irecv(m_recvHeaders[j], m_recvHeaders[j]->Size(), MPI_CHAR, source, numGradMatrices, &(recvHeaderRequests[j])) || MpiFail("MPI_Irecv");
+            }
+        }
+
+        // Send the headers from all nodes but the main node
+        MPI_Request sendHeaderRequest;
+        if (!m_mpi->IsMainNode())
+            m_mpi->Isend(headerCPU, headerCPU->Size(), MPI_CHAR, m_mpi->MainNodeRank(), numGradMatrices, &sendHeaderRequest) || MpiFail("MPI_Isend");
+
+        // Reduce within the host: afterwards this rank's shard of the buffer holds the sum
+        // over all local ranks (NCCL scatters in place)
+        ElemType* bufferData = m_hierarchicalBuffer->Data();
+        ElemType* shardData = bufferData + (m_mpi->CurrentRankOnHost() * m_hierarchicalShardElements);
+        m_nccl.ReduceScatter(bufferData, shardData, m_hierarchicalShardElements);
+        m_nccl.Sync(); // the shard must be final before MPI (or the staging copy) reads it
+
+        // Complete the sum across hosts, among the ranks holding the same shard
+        if (m_mpi->UseGpuGdr() != 0)
+        {
+            m_mpi->AllReduceAcrossHosts(shardData, m_hierarchicalShardElements);
+        }
+        else
+        {
+            m_hierarchicalTransferer->CopyGPUToCPUAsync(shardData, m_hierarchicalShardElements, m_hierarchicalCPUBuffer.get());
+            m_hierarchicalTransferer->WaitForCopyGPUToCPUAsync();
+            m_mpi->AllReduceAcrossHosts(m_hierarchicalCPUBuffer.get(), m_hierarchicalShardElements);
+            m_hierarchicalTransferer->CopyCPUToGPUAsync(m_hierarchicalCPUBuffer.get(), m_hierarchicalShardElements, shardData);
+            m_hierarchicalTransferer->WaitForCopyCPUToGPUAsync();
+        }
+
+        // Redistribute the fully reduced shards within the host (in place again)
+        m_nccl.AllGather(shardData, bufferData, m_hierarchicalShardElements);
+
+        // On the main node wait for the headers to arrive and aggregate
+        if (m_mpi->IsMainNode())
+        {
+            size_t numNodesHeadersReceivedFrom = 0;
+            while (numNodesHeadersReceivedFrom < (NumProc() - 1))
+            {
+                int idx = MPI_UNDEFINED;
+                m_mpi->Waitany(recvHeaderRequests.size(), recvHeaderRequests.data(), &idx, MPI_STATUS_IGNORE) || MpiFail("MPI_Waitany");
+                if (idx == MPI_UNDEFINED)
+                {
+                    break;
+                }
+
+                numNodesHeadersReceivedFrom++;
+
+                headerCPU->Aggregate(m_recvHeaders[idx], true);
+            }
+
+            assert(numNodesHeadersReceivedFrom == (NumProc() - 1));
+        }
+
+        // Broadcast the aggregated header to all nodes
+        m_mpi->Bcast(headerCPU, headerCPU->Size(), MPI_CHAR, m_mpi->MainNodeRank());
+
+        m_nccl.Sync(); // wait for the allgather before unpacking
+
+        // Copy the aggregated gradients back out of the contiguous buffer
+        offset = 0;
+        for (size_t i = 0; i < numGradMatrices; i++)
+        {
+            gradients[i]->AssignValuesOf(m_hierarchicalBuffer->ColumnSlice(offset, gradients[i]->GetNumElements()).Reshaped(gradients[i]->GetNumRows(), gradients[i]->GetNumCols()));
+            offset += gradients[i]->GetNumElements();
+        }
+
+        // Wait for completion of the async send requests
+        if (!m_mpi->IsMainNode())
+            m_mpi->Wait(&sendHeaderRequest, MPI_STATUSES_IGNORE) || MpiFail("MPI_Wait");
+
+        if (showSyncPerfStats)
+        {
+            aggregationTimer.Stop();
+            double gradientAggregationTime = aggregationTimer.ElapsedSeconds();
+            fprintf(stderr, "Actual gradient aggregation time: %.6g\n", gradientAggregationTime);
+        }
+    }
+
 private:
     std::unique_ptr<CUDAPageLockedMemAllocator> m_allocator;
 
@@ -463,6 +1017,27 @@ private:
     std::vector<size_t> m_packedGradientsIndex;
     std::vector<size_t> m_gradientIndexToAggregate;
 
+    // Sparse block-column gradients, aggregated over the union of their occupied blocks,
+    // cf. AggregateBlockSparseGradient()
+    std::vector<size_t> m_sparseGradientIndex;
+
+    // Bucketed (overlapped) aggregation state, cf. BeginBucketedAggregation()
+    const size_t m_bucketSizeInBytes; // minimum bucket payload; 0 disables bucketed aggregation
+    bool m_bucketsInitialized;
+    std::vector<Matrix<ElemType>*> m_bucketedGradients;           // all gradients, in backward completion order
+    std::vector<Bucket> m_buckets;                                // issued front to back
+    std::unordered_map<Matrix<ElemType>*, size_t> m_gradientToBucket;
+    size_t m_numBucketsIssued;
+    bool m_showBucketSyncStats;
+    std::future<void> m_bucketChain; // single worker chain reducing the issued buckets in order
+
+    // Hierarchical (intra-host NCCL + cross-host MPI) aggregation, cf. AggregateGradientsHierarchicalImpl()
+    bool m_hierarchical;
+    std::unique_ptr<Matrix<ElemType>> m_hierarchicalBuffer; // all gradients packed contiguously, padded to split into equal shards
+    size_t m_hierarchicalShardElements;                     // elements per shard (one shard per rank on this host)
+    std::shared_ptr<ElemType> m_hierarchicalCPUBuffer;      // pinned host staging for this rank's shard
+    std::unique_ptr<GPUDataTransferer> m_hierarchicalTransferer;
+
     int m_syncStatsTrace;
 
     // Only used for controlling frequency of measuring/showing gradient aggregation perf stats
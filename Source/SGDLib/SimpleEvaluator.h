@@ -46,8 +46,7 @@ public:
         m_traceLevel(traceLevel),
         m_maxSamplesInRAM(maxSamplesInRAM), 
         m_numSubminiBatches(numSubminiBatches), 
-        m_mpi(mpi), 
-        m_distGradAgg(nullptr),
+        m_mpi(mpi),
         m_gradHeader(nullptr),
         m_enableDistributedMBReading(enableDistributedMBReading)
     {
@@ -100,7 +99,6 @@ public:
 
         m_net->StartEvaluateMinibatchLoop(evalNodes);
 
-        std::vector<Matrix<ElemType>*> learnParamsGradients;
         DataReaderHelpers::SubminibatchDispatcher<ElemType> smbDispatcher;
         size_t numSubminibatchesNeeded = DataReaderHelpers::GetNumSubminibatchesNeeded<ElemType>(dataReader, m_maxSamplesInRAM, m_numSubminiBatches, mbSize);
 
@@ -159,76 +157,25 @@ public:
             // BUGBUG (Issue #95): Once we have multiple layouts, this must be done on a per-node basis.
             size_t numSamplesWithLabel = wasDataRead ? m_net->GetNumSamplesWithLabelOfNetwork(actualMBSize) : 0;
             size_t aggregateNumSamplesWithLabel = numSamplesWithLabel;
-            if (useParallelTrain)
-            {
-                if (m_gradHeader == nullptr)
-                {
-                    m_gradHeader.reset(DistGradHeader::Create(evalNodes.size()), [](DistGradHeader* ptr) {
-                        DistGradHeader::Destroy(ptr);
-                    });
-
-                    if (Globals::UseV2Aggregator())
-                        m_distGradAgg = make_shared<V2SimpleDistGradAggregator<ElemType>>(m_mpi, false /*useAsyncAggregation*/, m_net->GetDeviceId(), 0 /*syncStatsTrace*/, ::CNTK::MPICommunicator());
-                    else 
-                        m_distGradAgg = make_shared<SimpleDistGradAggregator<ElemType>>(m_mpi, false /*useAsyncAggregation*/, m_net->GetDeviceId(), 0 /*syncStatsTrace*/);
-                }
 
-                m_gradHeader->numEvalNode = evalNodes.size();
-                m_gradHeader->numSamples = actualMBSize;
-                m_gradHeader->numSamplesWithLabel = numSamplesWithLabel;
-                m_gradHeader->criterion = 0.0; // (not used here)
+            // accumulate the criteria on the device; they are read out only at logging intervals
+            // and after the loop, cf. CriterionAccumulator::GetCriteria()
+            if (actualMBSize > 0)
+            {
                 for (size_t i = 0; i < evalNodes.size(); i++)
-                    m_gradHeader->evalErrors[i] = localEpochEvalErrors.Assign(i, numSamplesWithLabel).GetCriterion(i);
-
-                // TODO: We are reusing the aggregation logic inside SimpleDistGradAggregator, which has a heavy dependency
-                // on the gradient matrix. At some point we should refactor the aggregator class to be able to only calculating
-                // eval results and then remove this hack.
-                if (learnParamsGradients.size() == 0)
-                {
-                    Matrix<ElemType>* matrix = new Matrix<ElemType>((DEVICEID_TYPE)m_net->GetDeviceId());
-                    learnParamsGradients.push_back(matrix);
-                }
-
-                // Using SimpleDistAggregator for eval results only. At some point we should rename the class to be just
-                // IDistAggregator and SimpleDistAggregator.
-                bool samplesProcessed = m_distGradAgg->AggregateGradients(learnParamsGradients, m_gradHeader.get(), /*resetState =*/ false);
-                noMoreSamplesToProcess = !samplesProcessed;
-
-                aggregateNumSamplesWithLabel = m_gradHeader->numSamplesWithLabel;
-                for (size_t i = 0; i < evalResults.size(); i++)
-                {
-                    if (ContainsAccumulatedResult(evalNodes[i]))
-                    {
-                        // We don't accumulate error in epoch criterion as this node has already accumulated error for
-                        // all samples that passed through network in forward pass.
-                        if (samplesProcessed)
-                        {
-                            evalResults[i] = m_gradHeader->evalErrors[i];
-                        }
-                        // else: no samples processed, no aggregation happened -> we do not want to override current value
-                        // with 0.
-                    }
-                    else
-                        evalResults[i] += m_gradHeader->evalErrors[i];
-                }
+                    localEpochEvalErrors.Add(i, numSamplesWithLabel);
             }
-            else
+
+            if (useParallelTrain)
             {
-                if (actualMBSize != 0)
-                {
-                    for (int i = 0; i < evalNodes.size(); i++)
-                    {
-                        localEpochEvalErrors.Assign(i, numSamplesWithLabel);
-                        if (ContainsAccumulatedResult(evalNodes[i]))
-                        {
-                            // We don't accumulate error in epoch criterion as this node has already accumulated error
-                            // for all samples that passed through network in forward pass.
-                            evalResults[i] = localEpochEvalErrors.GetCriterion(i);
-                        }
-                        else
-                            evalResults[i] += localEpochEvalErrors.GetCriterion(i);
-                    }
-                }
+                // Each rank evaluates only its shard and accumulates locally; the shard sums are
+                // combined with a single AllReduce after the loop. The only per-minibatch exchange
+                // is this two-integer allreduce, which tracks the aggregate sample tally and keeps
+                // the ranks looping in lockstep until every shard is exhausted.
+                size_t counts[2] = { actualMBSize, numSamplesWithLabel };
+                m_mpi->AllReduce(counts, 2);
+                noMoreSamplesToProcess = (counts[0] == 0);
+                aggregateNumSamplesWithLabel = counts[1];
             }
 
             totalEpochSamples += aggregateNumSamplesWithLabel;
@@ -240,6 +187,9 @@ public:
 
                 if (numMBsRun <= m_firstMBsToShowResult || (m_numMBsToShowResult && (numMBsRun % m_numMBsToShowResult == 0)))
                 {
+                    // fetch the running criteria from the device (in parallel mode these are the
+                    // current rank's shard only; the cross-rank combination happens after the loop)
+                    evalResults = localEpochEvalErrors.GetCriteria();
                     DisplayEvalStatistics(numMBsRunLastLogged + 1, numMBsRun, numSamplesLastLogged, evalNodes, evalResults, evalResultsLastLogged);
 
                     for (int i = 0; i < evalResults.size(); i++)
@@ -266,6 +216,31 @@ public:
             dataReader->DataEnd();
         }
 
+        // hoist the locally accumulated criteria from the device
+        evalResults = localEpochEvalErrors.GetCriteria();
+
+        // combine the ranks' shard sums with a single allreduce (evaluation nodes that accumulate
+        // results themselves are handled below through their own accumulator aggregation)
+        if (useParallelTrain)
+        {
+            vector<double> numer(evalResults.size(), 0.0);
+            vector<size_t> denom(evalResults.size(), 0);
+            for (size_t i = 0; i < evalResults.size(); i++)
+            {
+                if (ContainsAccumulatedResult(evalNodes[i]))
+                    continue;
+                numer[i] = evalResults[i].first;
+                denom[i] = evalResults[i].second;
+            }
+            m_mpi->AllReduce(numer);
+            m_mpi->AllReduce(denom);
+            for (size_t i = 0; i < evalResults.size(); i++)
+            {
+                if (!ContainsAccumulatedResult(evalNodes[i]))
+                    evalResults[i] = EpochCriterion(numer[i], denom[i]);
+            }
+        }
+
         // show last batch of results
         if (m_traceLevel > 0 && numSamplesLastLogged > 0)
         {
@@ -334,7 +309,6 @@ protected:
     MPIWrapperPtr m_mpi;
     bool m_enableDistributedMBReading;
 
-    std::shared_ptr<IDistGradAggregator<ElemType>> m_distGradAgg;
     std::shared_ptr<struct DistGradHeader> m_gradHeader;
     int m_traceLevel;
     void operator=(const SimpleEvaluator&); // (not assignable)
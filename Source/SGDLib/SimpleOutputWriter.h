@@ -15,6 +15,7 @@
 #include <string>
 #include <stdexcept>
 #include <fstream>
+#include <future>
 #include <cstdio>
 #include "ProgressTracing.h"
 #include "ComputationNetworkBuilder.h"
@@ -130,6 +131,55 @@ public:
             valueFormatString, gradient, false, idToKeyMapping);
     }
 
+    // host-side copy of one output node's minibatch, so that formatting can run on a background
+    // thread while the network already computes the next minibatch (which overwrites the node's Value)
+    struct NodeOutputSnapshot
+    {
+        std::wstring nodeName;
+        std::unique_ptr<ElemType[]> data; // dense host copy of the node's Value
+        size_t numRows;
+        size_t numCols;
+        TensorShape sampleLayout;
+        MBLayoutPtr mbLayout; // private copy; the node's own layout is recycled by the next GetMinibatch()
+        FILE* file;
+    };
+
+    NodeOutputSnapshot SnapshotNodeOutput(const ComputationNodePtr& node, FILE* f)
+    {
+        NodeOutputSnapshot snapshot;
+        snapshot.nodeName = node->NodeName();
+        const Matrix<ElemType>& value = node->Value();
+        snapshot.data.reset(value.CopyToArray()); // this is the device-to-host transfer (and GPU sync)
+        snapshot.numRows = value.GetNumRows();
+        snapshot.numCols = value.GetNumCols();
+        snapshot.sampleLayout = node->GetSampleLayout();
+        if (node->HasMBLayout())
+        {
+            snapshot.mbLayout = make_shared<MBLayout>();
+            snapshot.mbLayout->CopyFrom(node->GetMBLayout());
+        }
+        snapshot.file = f;
+        return snapshot;
+    }
+
+    // same as WriteMinibatch() above, but operating on a snapshot instead of the live node
+    void WriteMinibatch(const NodeOutputSnapshot& snapshot,
+        const WriteFormattingOptions& formattingOptions, std::string valueFormatString, const std::vector<std::string>& labelMapping,
+        size_t numMBsRun, const std::function<std::string(size_t)>& idToKeyMapping)
+    {
+        const auto sequenceSeparator = formattingOptions.Processed(snapshot.nodeName, formattingOptions.sequenceSeparator, numMBsRun);
+        const auto sequencePrologue =  formattingOptions.Processed(snapshot.nodeName, formattingOptions.sequencePrologue,  numMBsRun);
+        const auto sequenceEpilogue =  formattingOptions.Processed(snapshot.nodeName, formattingOptions.sequenceEpilogue,  numMBsRun);
+        const auto elementSeparator =  formattingOptions.Processed(snapshot.nodeName, formattingOptions.elementSeparator,  numMBsRun);
+        const auto sampleSeparator =   formattingOptions.Processed(snapshot.nodeName, formattingOptions.sampleSeparator,   numMBsRun);
+
+        ComputationNode<ElemType>::WriteMinibatchWithFormatting(snapshot.file, snapshot.data.get(), snapshot.numRows, snapshot.numCols,
+            snapshot.sampleLayout, snapshot.mbLayout, FrameRange(), SIZE_MAX, SIZE_MAX,
+            formattingOptions.transpose, formattingOptions.isCategoryLabel, formattingOptions.isSparse, labelMapping,
+            sequenceSeparator, sequencePrologue, sequenceEpilogue, elementSeparator, sampleSeparator,
+            valueFormatString, false, idToKeyMapping);
+    }
+
     void InsertNode(std::vector<ComputationNodeBasePtr>& allNodes, ComputationNodeBasePtr parent, ComputationNodeBasePtr newNode)
     {
         newNode->SetInput(0, parent);
@@ -230,18 +280,42 @@ public:
         char formatChar = !formattingOptions.isCategoryLabel ? 'f' : !formattingOptions.labelMappingFile.empty() ? 's' : 'u';
         std::string valueFormatString = "%" + formattingOptions.precisionFormat + formatChar; // format string used in fprintf() for formatting the values
 
+        // Formatting and disk writes are pipelined: after the forward pass, the outputs are copied to
+        // the host and handed to a background task, so the next minibatch's forward pass overlaps the
+        // text formatting of this one. Double-buffered: at most one minibatch's write is in flight.
+        // The unit-test path and stdout output (which interleaves with per-minibatch separators printed
+        // below) stay synchronous.
+        bool asyncWrite = !nodeUnitTest && outputPath != L"-";
+        std::future<void> pendingWrite;
+
         for (size_t numMBsRun = 0; DataReaderHelpers::GetMinibatchIntoNetwork<ElemType>(dataReader, m_net, nullptr, false, false, inputMatrices, actualMBSize, nullptr); numMBsRun++)
         {
             ComputationNetwork::BumpEvalTimeStamp(inputNodes);
             m_net->ForwardProp(outputNodes);
 
-            for (auto & onode : outputNodes)
+            auto getKeyById = writeSequenceKey ? inputMatrices.m_getKeyById : std::function<std::string(size_t)>();
+            if (asyncWrite)
+            {
+                auto snapshots = make_shared<std::vector<NodeOutputSnapshot>>();
+                for (auto & onode : outputNodes)
+                    snapshots->push_back(SnapshotNodeOutput(dynamic_pointer_cast<ComputationNode<ElemType>>(onode), *outputStreams[onode]));
+
+                if (pendingWrite.valid())
+                    pendingWrite.get(); // wait for the previous minibatch's write (this also rethrows any write error)
+
+                pendingWrite = std::async(std::launch::async,
+                                          [this, snapshots, &formattingOptions, valueFormatString, &labelMapping, numMBsRun, getKeyById]()
+                {
+                    for (const auto & snapshot : *snapshots)
+                        WriteMinibatch(snapshot, formattingOptions, valueFormatString, labelMapping, numMBsRun, getKeyById);
+                });
+            }
+            else for (auto & onode : outputNodes)
             {
                 // compute the node value
                 // Note: Intermediate values are memoized, so in case of multiple output nodes, we only compute what has not been computed already.
 
                 FILE* file = *outputStreams[onode];
-                auto getKeyById = writeSequenceKey ? inputMatrices.m_getKeyById : std::function<std::string(size_t)>();
                 WriteMinibatch(file, dynamic_pointer_cast<ComputationNode<ElemType>>(onode), formattingOptions, formatChar, valueFormatString, labelMapping, numMBsRun, /* gradient */ false, getKeyById);
 
                 if (nodeUnitTest)
@@ -277,6 +351,9 @@ public:
             dataReader.DataEnd();
         } // end loop over minibatches
 
+        if (pendingWrite.valid()) // drain the last in-flight write before the epilogues
+            pendingWrite.get();
+
         for (auto & stream : outputStreams)
         {
             FILE* f = *stream.second;
@@ -0,0 +1,245 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+
+#pragma once
+
+#include "Constants.h"
+#include "IDistGradAggregator.h"
+#include "TimerUtility.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace Microsoft { namespace MSR { namespace CNTK {
+
+// Aggregates gradients by exchanging only the K entries of largest magnitude per gradient
+// matrix, as (index, value) pairs. The entries that are not selected are not lost: they
+// accumulate in a per-gradient residual that is added back in before the next selection
+// (error feedback), so every contribution is eventually applied. K is derived from the
+// gradient dimensions and thus identical on every rank, which lets the pairs travel through
+// plain fixed-count allgathers. For gradients whose mass concentrates in few entries
+// (e.g. embeddings) this cuts the exchange volume far below even 1-bit quantization.
+template <class ElemType>
+class TopKDistGradAggregator : public IDistGradAggregator<ElemType>
+{
+    UsingIDistGradAggregatorMembers;
+
+public:
+    TopKDistGradAggregator(const MPIWrapperPtr& mpi, double topKPercent, int syncStatsTrace)
+        : IDistGradAggregator<ElemType>(mpi), m_topKPercent(topKPercent), m_syncStatsTrace(syncStatsTrace), m_iterationCount(0), m_initialized(false)
+    {}
+
+    ~TopKDistGradAggregator()
+    {
+        for (size_t i = 0; i < m_recvHeaders.size(); ++i)
+            DistGradHeader::Destroy(m_recvHeaders[i]);
+
+        for (ElemType* buffer : m_cpuGradientBuffers)
+            delete[] buffer;
+    }
+
+    // Aggregate the gradient matrices across all nodes
+    bool AggregateGradients(const std::vector<Matrix<ElemType>*>& gradients, DistGradHeader* headerCPU, bool resetState) override
+    {
+        ResetState(gradients, headerCPU->numEvalNode, resetState);
+        bool showSyncPerfStats = (m_syncStatsTrace > 0) && ((m_iterationCount % m_syncStatsTrace) == 0);
+        m_iterationCount++;
+
+        Timer aggregationTimer;
+        if (showSyncPerfStats)
+            aggregationTimer.Start();
+
+        size_t numGradMatrices = gradients.size();
+
+        if (headerCPU->numSamples == 0)
+        {
+            assert(headerCPU->criterion == 0.0);
+            assert(headerCPU->numSamplesWithLabel == 0);
+            for (int i = 0; i < headerCPU->numEvalNode; ++i)
+                assert(headerCPU->evalErrors[i].first == 0 && headerCPU->evalErrors[i].second == 0);
+
+            // If the current node did not process any samples, the gradients should be zero'd.
+            // The rank still takes its turn in the allgathers below, contributing the top of
+            // its residual.
+            for (size_t i = 0; i < numGradMatrices; ++i)
+                gradients[i]->SetValue(0);
+        }
+
+        // Initiate receive of the header on the main node
+        std::vector<MPI_Request> recvHeaderRequests(NumProc() - 1);
+        if (m_mpi->IsMainNode())
+        {
+            for (size_t j = 0; j < NumProc() - 1; ++j)
+            {
+                int source = (j >= MyRank()) ? (j + 1) : j;
+                // We use a tag of 'numGradMatrices' for the pre-aggregation header
+                m_mpi->Irecv(m_recvHeaders[j], m_recvHeaders[j]->Size(), MPI_CHAR, source, numGradMatrices, &(recvHeaderRequests[j])) || MpiFail("MPI_Irecv");
+            }
+        }
+
+        // Send the headers from all nodes but the main node
+        MPI_Request sendHeaderRequest;
+        if (!m_mpi->IsMainNode())
+            m_mpi->Isend(headerCPU, headerCPU->Size(), MPI_CHAR, m_mpi->MainNodeRank(), numGradMatrices, &sendHeaderRequest) || MpiFail("MPI_Isend");
+
+        for (size_t i = 0; i < numGradMatrices; i++)
+        {
+            size_t numElements = gradients[i]->GetNumElements();
+            size_t k = m_topK[i];
+
+            // Fetch the gradient to the CPU and fold in the residual carried over from the
+            // previous minibatches
+            gradients[i]->CopyToArray(m_cpuGradientBuffers[i], m_cpuGradientBufferSizes[i]);
+            ElemType* accumulated = m_cpuGradientBuffers[i];
+            ElemType* residual = m_residuals[i].data();
+            for (size_t j = 0; j < numElements; j++)
+                accumulated[j] += residual[j];
+
+            // Select the K entries of largest magnitude
+            m_selectionScratch.resize(numElements);
+            for (size_t j = 0; j < numElements; j++)
+                m_selectionScratch[j] = j;
+            std::nth_element(m_selectionScratch.begin(), m_selectionScratch.begin() + (k - 1), m_selectionScratch.end(),
+                             [accumulated](size_t a, size_t b) { return std::abs(accumulated[a]) > std::abs(accumulated[b]); });
+
+            // Move the selected entries into the send buffers; what remains of the
+            // accumulator becomes the new residual
+            m_sendIndices.resize(k);
+            m_sendValues.resize(k);
+            for (size_t j = 0; j < k; j++)
+            {
+                size_t index = m_selectionScratch[j];
+                m_sendIndices[j] = index;
+                m_sendValues[j] = accumulated[index];
+                accumulated[index] = 0;
+            }
+            memcpy(residual, accumulated, numElements * sizeof(ElemType));
+
+            // Exchange everyone's (index, value) pairs; every rank contributes exactly k
+            size_t totalPairs = NumProc() * k;
+            m_recvIndices.resize(totalPairs);
+            m_recvValues.resize(totalPairs);
+            if (NumProc() > 1)
+            {
+                m_mpi->AllGather(m_sendIndices.data(), k, m_recvIndices.data(), k);
+                m_mpi->AllGather(m_sendValues.data(), k, m_recvValues.data(), k);
+            }
+            else
+            {
+                std::copy(m_sendIndices.begin(), m_sendIndices.end(), m_recvIndices.begin());
+                std::copy(m_sendValues.begin(), m_sendValues.end(), m_recvValues.begin());
+            }
+
+            // Rebuild the aggregated gradient from all contributions (the accumulator buffer
+            // is free again now that the residual holds its remainder)
+            std::fill(accumulated, accumulated + numElements, (ElemType)0);
+            for (size_t j = 0; j < totalPairs; j++)
+                accumulated[m_recvIndices[j]] += m_recvValues[j];
+
+            gradients[i]->SetValue(gradients[i]->GetNumRows(), gradients[i]->GetNumCols(), gradients[i]->GetDeviceId(), accumulated);
+        }
+
+        // On the main node wait for the headers to arrive and aggregate
+        if (m_mpi->IsMainNode())
+        {
+            size_t numNodesHeadersReceivedFrom = 0;
+            while (numNodesHeadersReceivedFrom < (NumProc() - 1))
+            {
+                int idx = MPI_UNDEFINED;
+                m_mpi->Waitany(recvHeaderRequests.size(), recvHeaderRequests.data(), &idx, MPI_STATUS_IGNORE) || MpiFail("MPI_Waitany");
+                if (idx == MPI_UNDEFINED)
+                {
+                    break;
+                }
+
+                numNodesHeadersReceivedFrom++;
+
+                headerCPU->Aggregate(m_recvHeaders[idx], true);
+            }
+
+            assert(numNodesHeadersReceivedFrom == (NumProc() - 1));
+        }
+
+        // Broadcast the aggregated header to all nodes
+        m_mpi->Bcast(headerCPU, headerCPU->Size(), MPI_CHAR, m_mpi->MainNodeRank());
+
+        // Wait for completion of the async send requests
+        if (!m_mpi->IsMainNode())
+            m_mpi->Wait(&sendHeaderRequest, MPI_STATUSES_IGNORE) || MpiFail("MPI_Wait");
+
+        if (showSyncPerfStats)
+        {
+            aggregationTimer.Stop();
+            double gradientAggregationTime = aggregationTimer.ElapsedSeconds();
+            fprintf(stderr, "Actual gradient aggregation time: %.6g\n", gradientAggregationTime);
+        }
+
+        return (headerCPU->numSamples != 0);
+    }
+
+private:
+    void ResetState(const std::vector<Matrix<ElemType>*>& gradients, int numEvalNodes, bool resetState)
+    {
+        if (!m_initialized)
+        {
+            m_initialized = true;
+
+            for (size_t i = 0; i < gradients.size(); i++)
+            {
+                // Make sure none of the gradient matrixes are sparse - we currently do not support aggregation of sparse gradient matrices
+                if (gradients[i]->GetMatrixType() != DENSE)
+                    RuntimeError("Gradient aggregation for sparse gradient matrices is currently unsupported!");
+
+                size_t numElements = gradients[i]->GetNumElements();
+                size_t k = (size_t)(numElements * (m_topKPercent / 100.0));
+                m_topK.push_back(std::max((size_t)1, std::min(k, numElements)));
+
+                m_residuals.push_back(std::vector<ElemType>(numElements, (ElemType)0));
+                m_cpuGradientBuffers.push_back(nullptr);
+                m_cpuGradientBufferSizes.push_back(0);
+            }
+
+            if (m_mpi->IsMainNode())
+            {
+                for (size_t i = 0; i < NumProc() - 1; ++i)
+                    m_recvHeaders.push_back(DistGradHeader::Create(numEvalNodes));
+            }
+        }
+        else if (resetState)
+        {
+            // Drop the residuals on an epoch boundary so stale error feedback does not leak
+            // into the new epoch
+            for (size_t i = 0; i < m_residuals.size(); i++)
+                std::fill(m_residuals[i].begin(), m_residuals[i].end(), (ElemType)0);
+        }
+    }
+
+private:
+    // Percentage of entries exchanged per gradient matrix (at least one entry per gradient)
+    const double m_topKPercent;
+
+    std::vector<size_t> m_topK;                       // K per gradient, identical on all ranks
+    std::vector<std::vector<ElemType>> m_residuals;   // error feedback: entries not yet sent
+    std::vector<ElemType*> m_cpuGradientBuffers;      // reusable CPU copies of the gradients
+    std::vector<size_t> m_cpuGradientBufferSizes;
+
+    // Per-minibatch scratch, reused across gradients and iterations
+    std::vector<size_t> m_selectionScratch;
+    std::vector<size_t> m_sendIndices;
+    std::vector<ElemType> m_sendValues;
+    std::vector<size_t> m_recvIndices;
+    std::vector<ElemType> m_recvValues;
+
+    std::vector<DistGradHeader*> m_recvHeaders;
+
+    int m_syncStatsTrace;
+
+    // Only used for controlling frequency of measuring/showing gradient aggregation perf stats
+    size_t m_iterationCount;
+
+    bool m_initialized;
+};
+} } }
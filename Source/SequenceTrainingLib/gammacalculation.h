@@ -9,6 +9,7 @@
 #include "CUDAPageLockedMemAllocator.h"
 
 #include <memory>
+#include <thread>
 #include <vector>
 
 #pragma warning(disable : 4127) // conditional expression is constant
@@ -22,6 +23,7 @@ struct SeqGammarCalParam
     double wp;
     double bMMIfactor;
     bool sMBRmode;
+    size_t numLatticeDevices; // shard lattice processing over this many GPUs (1 = single device)
     SeqGammarCalParam()
     {
         amf = 14.0;
@@ -29,6 +31,7 @@ struct SeqGammarCalParam
         wp = 0.0;
         bMMIfactor = 0.0;
         sMBRmode = false;
+        numLatticeDevices = 1;
     }
 };
 
@@ -47,6 +50,7 @@ public:
         amf = 7.0f;
         boostmmifactor = 0.0f;
         seqsMBRmode = false;
+        numlatticedevices = 1;
     }
     ~GammaCalculation()
     {
@@ -68,6 +72,22 @@ public:
 
             if (parallellattice.enabled())                             // send hmm set to GPU if GPU computation enabled
                 parallellattice.entercomputation(m_hset, mbrclassdef); // cache senone2classmap if mpemode
+
+            // multi-device lattice sharding: set up additional parallelstates on the other GPUs
+            if (numlatticedevices > 1 && parallellattice.enabled())
+            {
+                const size_t devicecount = msra::lattices::lattice::parallelstate::getdevicecount();
+                for (size_t deviceid = 0; deviceid < devicecount && extraparallellattices.size() + 1 < numlatticedevices; deviceid++)
+                {
+                    if ((int) deviceid == DeviceId) // the training device is shard 0 (parallellattice itself)
+                        continue;
+                    extraparallellattices.push_back(std::make_shared<msra::lattices::lattice::parallelstate>());
+                    extraparallellattices.back()->setdevice(deviceid);
+                    extraparallellattices.back()->entercomputation(m_hset, mbrclassdef);
+                }
+                if (extraparallellattices.size() > 0)
+                    fprintf(stderr, "GammaCalculation: sharding lattice processing over %d devices\n", (int) (extraparallellattices.size() + 1));
+            }
             initialmark = true;
         }
     }
@@ -82,6 +102,7 @@ public:
         wp = (float) gammarParam.wp;
         seqsMBRmode = gammarParam.sMBRmode;
         boostmmifactor = (float) gammarParam.bMMIfactor;
+        numlatticedevices = gammarParam.numLatticeDevices;
     }
 
     // ========================================
@@ -98,6 +119,15 @@ public:
                        std::vector<size_t>& extrauttmap,
                        bool doreferencealign)
     {
+        // shard the minibatch's lattices over multiple devices if so configured
+        // (reference alignment writes labels per utterance and stays on the single-device path)
+        if (extraparallellattices.size() > 0 && !doreferencealign && std::is_same<ElemType, float>::value)
+        {
+            calgammaformbsharded(functionValues, lattices, loglikelihood, gammafromlattice, uids, boundaries,
+                                 samplesInRecurrentStep, pMBLayout, extrauttmap);
+            return;
+        }
+
         // check total frame number to be added ?
         // int deviceid = loglikelihood.GetDeviceId();
         size_t boundaryframenum;
@@ -126,126 +156,205 @@ public:
             assert(T == pMBLayout->GetNumTimeSteps());
         }
 
-        size_t mapi = 0; // parallel-sequence index for utterance [i]
-        // cal gamma for each utterance
-        size_t ts = 0;
-        for (size_t i = 0; i < lattices.size(); i++)
+        // determine the per-utterance layout up front (the old all-in-one loop derived this
+        // on the fly; we need it ahead of time so preparation can run one utterance ahead)
+        struct uttinfo
         {
-            const size_t numframes = lattices[i]->getnumframes();
-
-            msra::dbn::matrixstripe predstripe(pred, ts, numframes);           // logLLs for this utterance
-            msra::dbn::matrixstripe dengammasstripe(dengammas, ts, numframes); // denominator gammas
-
-            if (samplesInRecurrentStep == 1) // no sequence parallelism
+            size_t ts;         // start column in the frame-concatenated layout
+            size_t numframes;  // utterance length
+            size_t mapi;       // parallel-sequence index
+            size_t startframe; // first time step within the parallel sequence
+        };
+        std::vector<uttinfo> utts(lattices.size());
+        size_t maxuttframes = 0;
+        {
+            size_t ts = 0;
+            for (size_t i = 0; i < lattices.size(); i++)
             {
-                tempmatrix = loglikelihood.ColumnSlice(ts, numframes);
-                // if (m_deviceid == CPUDEVICE)
+                const size_t numframes = lattices[i]->getnumframes();
+                size_t mapi = 0;
+                if (samplesInRecurrentStep > 1)
                 {
-                    CopyFromCNTKMatrixToSSEMatrix(tempmatrix, numframes, predstripe);
-                }
-
-                if (m_deviceid != CPUDEVICE)
-                    parallellattice.setloglls(tempmatrix);
-            }
-            else // multiple parallel sequences
-            {
-                // get number of frames for the utterance
-                mapi = extrauttmap[i]; // parallel-sequence index; in case of >1 utterance within this parallel sequence, this is in order of concatenation
+                    mapi = extrauttmap[i]; // parallel-sequence index; in case of >1 utterance within this parallel sequence, this is in order of concatenation
 
-                // scan MBLayout for end of utterance
-                size_t mapframenum = SIZE_MAX; // duration of utterance [i] as determined from MBLayout
-                for (size_t t = validframes[mapi]; t < T; t++)
-                {
-                    // TODO: Adapt this to new MBLayout, m_sequences would be easier to work off.
-                    if (pMBLayout->IsEnd(mapi, t))
+                    // scan MBLayout for end of utterance
+                    size_t mapframenum = SIZE_MAX; // duration of utterance [i] as determined from MBLayout
+                    for (size_t t = validframes[mapi]; t < T; t++)
                     {
-                        mapframenum = t - validframes[mapi] + 1;
-                        break;
+                        // TODO: Adapt this to new MBLayout, m_sequences would be easier to work off.
+                        if (pMBLayout->IsEnd(mapi, t))
+                        {
+                            mapframenum = t - validframes[mapi] + 1;
+                            break;
+                        }
                     }
-                }
 
-                // must match the explicit information we get from the reader
-                if (numframes != mapframenum)
-                    LogicError("gammacalculation: IsEnd() not working, numframes (%d) vs. mapframenum (%d)", (int) numframes, (int) mapframenum);
-                assert(numframes == mapframenum);
-
-                if (numframes > tempmatrix.GetNumCols())
-                    tempmatrix.Resize(numrows, numframes);
-
-                Microsoft::MSR::CNTK::Matrix<ElemType> loglikelihoodForCurrentParallelUtterance = loglikelihood.ColumnSlice(mapi + (validframes[mapi] * samplesInRecurrentStep), ((numframes - 1) * samplesInRecurrentStep) + 1);
-                tempmatrix.CopyColumnsStrided(loglikelihoodForCurrentParallelUtterance, numframes, samplesInRecurrentStep, 1);
-
-                // if (doreferencealign || m_deviceid == CPUDEVICE)
-                {
-                    CopyFromCNTKMatrixToSSEMatrix(tempmatrix, numframes, predstripe);
-                }
-
-                if (m_deviceid != CPUDEVICE)
-                {
-                    parallellattice.setloglls(tempmatrix);
+                    // must match the explicit information we get from the reader
+                    if (numframes != mapframenum)
+                        LogicError("gammacalculation: IsEnd() not working, numframes (%d) vs. mapframenum (%d)", (int) numframes, (int) mapframenum);
+                    assert(numframes == mapframenum);
                 }
+                utts[i] = uttinfo{ts, numframes, mapi, validframes[mapi]};
+                if (samplesInRecurrentStep > 1)
+                    validframes[mapi] += numframes; // advance the cursor within the parallel sequence
+                if (numframes > maxuttframes)
+                    maxuttframes = numframes;
+                ts += numframes;
             }
+        }
 
-            array_ref<size_t> uidsstripe(&uids[ts], numframes);
-
-            if (doreferencealign)
+        // We pipeline the loop below: while utterance [i] runs its forward/backward on the
+        // device, a helper thread already prepares utterance [i+1] (gathers its logLLs,
+        // copies them down into the CPU-side 'pred' stripe through a pinned buffer, and
+        // computes the numerator score). This hides the per-utterance preparation latency
+        // behind the gamma computation.
+        const bool overlapprep = parallellattice.enabled() && lattices.size() > 1;
+        if (overlapprep)
+        {
+            // pre-size both intermediate copy buffers so neither side of the pipeline has to
+            // allocate mid-loop (the pinned-memory allocator is shared between them)
+            const size_t maxelems = numrows * maxuttframes;
+            if ((m_intermediateCUDACopyBuffer == nullptr) || (m_intermediateCUDACopyBufferSize < maxelems))
             {
-                boundaryframenum = numframes;
+                m_intermediateCUDACopyBuffer = AllocateIntermediateBuffer(loglikelihood.GetDeviceId(), maxelems);
+                m_intermediateCUDACopyBufferSize = maxelems;
             }
-            else
-                boundaryframenum = 0;
-            array_ref<size_t> boundariesstripe(&boundaries[ts], boundaryframenum);
-
-            double numavlogp = 0;
-            foreach_column (t, dengammasstripe) // we do not allocate memory for numgamma now, should be the same as numgammasstripe
+            if ((m_prepCopyBuffer == nullptr) || (m_prepCopyBufferSize < maxelems))
             {
-                const size_t s = uidsstripe[t];
-                numavlogp += predstripe(s, t) / amf;
+                m_prepCopyBuffer = AllocateIntermediateBuffer(loglikelihood.GetDeviceId(), maxelems);
+                m_prepCopyBufferSize = maxelems;
             }
-            numavlogp /= numframes;
-
-            // auto_timer dengammatimer;
-            double denavlogp = lattices[i]->second.forwardbackward(parallellattice,
-                                                                   (const msra::math::ssematrixbase&) predstripe, (const msra::asr::simplesenonehmm&) m_hset,
-                                                                   (msra::math::ssematrixbase&) dengammasstripe, (msra::math::ssematrixbase&) gammasbuffer /*empty, not used*/,
-                                                                   lmf, wp, amf, boostmmifactor, seqsMBRmode, uidsstripe, boundariesstripe);
-            objectValue += (ElemType)((numavlogp - denavlogp) * numframes);
+        }
 
-            if (samplesInRecurrentStep == 1)
+        std::vector<Microsoft::MSR::CNTK::Matrix<ElemType>> stagingmatrices; // [i % 2] per-slot logLL staging on the device
+        stagingmatrices.reserve(2);
+        stagingmatrices.emplace_back(m_deviceid);
+        stagingmatrices.emplace_back(m_deviceid);
+        std::vector<double> numavlogps(lattices.size(), 0.0);
+        auto preputterance = [&](size_t i)
+        {
+            const size_t numframes = utts[i].numframes;
+            auto& staging = stagingmatrices[i % 2];
+            msra::dbn::matrixstripe predstripe(pred, utts[i].ts, numframes); // logLLs for this utterance
+            if (samplesInRecurrentStep == 1)                                 // no sequence parallelism
             {
-                tempmatrix = gammafromlattice.ColumnSlice(ts, numframes);
+                staging = loglikelihood.ColumnSlice(utts[i].ts, numframes);
             }
-
-            // copy gamma to tempmatrix
-            if (m_deviceid == CPUDEVICE)
+            else // multiple parallel sequences: gather the utterance's frames
             {
-                CopyFromSSEMatrixToCNTKMatrix(dengammas, numrows, numframes, tempmatrix, gammafromlattice.GetDeviceId());
+                if (numframes > staging.GetNumCols())
+                    staging.Resize(numrows, numframes);
+                Microsoft::MSR::CNTK::Matrix<ElemType> loglikelihoodForCurrentParallelUtterance = loglikelihood.ColumnSlice(utts[i].mapi + (utts[i].startframe * samplesInRecurrentStep), ((numframes - 1) * samplesInRecurrentStep) + 1);
+                staging.CopyColumnsStrided(loglikelihoodForCurrentParallelUtterance, numframes, samplesInRecurrentStep, 1);
             }
-            else
-                parallellattice.getgamma(tempmatrix);
+            CopyFromCNTKMatrixToSSEMatrix(staging, numframes, predstripe, m_prepCopyBuffer, m_prepCopyBufferSize);
 
-            // set gamma for multi channel
-            if (samplesInRecurrentStep > 1)
+            // numerator score (reads the stripe we just filled)
+            array_ref<size_t> uidsstripe(&uids[utts[i].ts], numframes);
+            double numavlogp = 0;
+            for (size_t t = 0; t < numframes; t++)
             {
-                Microsoft::MSR::CNTK::Matrix<ElemType> gammaFromLatticeForCurrentParallelUtterance = gammafromlattice.ColumnSlice(mapi + (validframes[mapi] * samplesInRecurrentStep), ((numframes - 1) * samplesInRecurrentStep) + 1);
-                gammaFromLatticeForCurrentParallelUtterance.CopyColumnsStrided(tempmatrix, numframes, 1, samplesInRecurrentStep);
+                const size_t s = uidsstripe[t];
+                numavlogp += predstripe(s, t) / amf;
             }
+            numavlogps[i] = numavlogp / numframes;
+        };
 
-            if (doreferencealign)
+        // cal gamma for each utterance
+        std::thread prepthread;
+        std::exception_ptr prepexception;
+        try
+        {
+            for (size_t i = 0; i < lattices.size(); i++)
             {
-                for (size_t nframe = 0; nframe < numframes; nframe++)
+                if (i == 0)
+                    preputterance(i);
+                else if (overlapprep) // the helper thread prepared utterance [i] during iteration [i-1]
+                {
+                    prepthread.join();
+                    if (prepexception)
+                        std::rethrow_exception(prepexception);
+                }
+                else
+                    preputterance(i);
+                if (overlapprep && i + 1 < lattices.size())
+                    prepthread = std::thread([&preputterance, &prepexception, i]()
+                                             {
+                                                 try
+                                                 {
+                                                     preputterance(i + 1);
+                                                 }
+                                                 catch (...)
+                                                 {
+                                                     prepexception = std::current_exception();
+                                                 }
+                                             });
+
+                const size_t numframes = utts[i].numframes;
+                const size_t mapi = utts[i].mapi;
+                auto& staging = stagingmatrices[i % 2];
+                msra::dbn::matrixstripe predstripe(pred, utts[i].ts, numframes);           // logLLs for this utterance
+                msra::dbn::matrixstripe dengammasstripe(dengammas, utts[i].ts, numframes); // denominator gammas
+
+                if (m_deviceid != CPUDEVICE)
+                    parallellattice.setloglls(staging);
+
+                array_ref<size_t> uidsstripe(&uids[utts[i].ts], numframes);
+
+                if (doreferencealign)
                 {
-                    size_t uid = uidsstripe[nframe];
-                    if (samplesInRecurrentStep > 1)
-                        labels(uid, (nframe + validframes[mapi]) * samplesInRecurrentStep + mapi) = 1.0;
-                    else
-                        labels(uid, ts + nframe) = 1.0;
+                    boundaryframenum = numframes;
+                }
+                else
+                    boundaryframenum = 0;
+                array_ref<size_t> boundariesstripe(&boundaries[utts[i].ts], boundaryframenum);
+
+                // auto_timer dengammatimer;
+                double denavlogp = lattices[i]->second.forwardbackward(parallellattice,
+                                                                       (const msra::math::ssematrixbase&) predstripe, (const msra::asr::simplesenonehmm&) m_hset,
+                                                                       (msra::math::ssematrixbase&) dengammasstripe, (msra::math::ssematrixbase&) gammasbuffer /*empty, not used*/,
+                                                                       lmf, wp, amf, boostmmifactor, seqsMBRmode, uidsstripe, boundariesstripe);
+                objectValue += (ElemType)((numavlogps[i] - denavlogp) * numframes);
+
+                if (samplesInRecurrentStep == 1)
+                {
+                    tempmatrix = gammafromlattice.ColumnSlice(utts[i].ts, numframes);
+                }
+
+                // copy gamma to tempmatrix
+                if (m_deviceid == CPUDEVICE)
+                {
+                    CopyFromSSEMatrixToCNTKMatrix(dengammas, numrows, numframes, tempmatrix, gammafromlattice.GetDeviceId());
+                }
+                else
+                    parallellattice.getgamma(tempmatrix);
+
+                // set gamma for multi channel
+                if (samplesInRecurrentStep > 1)
+                {
+                    Microsoft::MSR::CNTK::Matrix<ElemType> gammaFromLatticeForCurrentParallelUtterance = gammafromlattice.ColumnSlice(mapi + (utts[i].startframe * samplesInRecurrentStep), ((numframes - 1) * samplesInRecurrentStep) + 1);
+                    gammaFromLatticeForCurrentParallelUtterance.CopyColumnsStrided(tempmatrix, numframes, 1, samplesInRecurrentStep);
+                }
+
+                if (doreferencealign)
+                {
+                    for (size_t nframe = 0; nframe < numframes; nframe++)
+                    {
+                        size_t uid = uidsstripe[nframe];
+                        if (samplesInRecurrentStep > 1)
+                            labels(uid, (nframe + utts[i].startframe) * samplesInRecurrentStep + mapi) = 1.0;
+                        else
+                            labels(uid, utts[i].ts + nframe) = 1.0;
+                    }
                 }
+                fprintf(stderr, "dengamma value %f\n", denavlogp);
             }
-            if (samplesInRecurrentStep > 1)
-                validframes[mapi] += numframes; // advance the cursor within the parallel sequence
-            fprintf(stderr, "dengamma value %f\n", denavlogp);
-            ts += numframes;
+        }
+        catch (...)
+        {
+            if (prepthread.joinable())
+                prepthread.join();
+            throw;
         }
         functionValues.SetValue(objectValue);
     }
@@ -384,8 +493,197 @@ public:
     }
 
 private:
+    // multi-device version of calgammaformb(): the minibatch's lattices are sharded
+    // round-robin over the lattice devices, forwardbackward() runs concurrently with one
+    // thread per device, and the resulting gammas are staged through CPU stripes (like
+    // the CPU path) and applied to 'gammafromlattice' on the training device.
+    void calgammaformbsharded(Microsoft::MSR::CNTK::Matrix<ElemType>& functionValues,
+                              std::vector<std::shared_ptr<const msra::dbn::latticepair>>& lattices,
+                              const Microsoft::MSR::CNTK::Matrix<ElemType>& loglikelihood,
+                              Microsoft::MSR::CNTK::Matrix<ElemType>& gammafromlattice,
+                              std::vector<size_t>& uids, std::vector<size_t>& boundaries,
+                              size_t samplesInRecurrentStep,
+                              std::shared_ptr<Microsoft::MSR::CNTK::MBLayout> pMBLayout,
+                              std::vector<size_t>& extrauttmap)
+    {
+        std::vector<size_t> validframes(samplesInRecurrentStep, 0); // [s] cursor pointing to next utterance begin within a single parallel sequence [s]
+        ElemType objectValue = 0.0;
+        const size_t numrows = loglikelihood.GetNumRows();
+        const size_t numcols = loglikelihood.GetNumCols();
+        Microsoft::MSR::CNTK::Matrix<ElemType> tempmatrix(m_deviceid);
+
+        if (numcols > pred.cols())
+        {
+            pred.resize(numrows, numcols);
+            dengammas.resize(numrows, numcols);
+        }
+
+        const size_t T = numcols / samplesInRecurrentStep; // number of time steps in minibatch
+        if (samplesInRecurrentStep > 1)
+        {
+            assert(extrauttmap.size() == lattices.size());
+            assert(T == pMBLayout->GetNumTimeSteps());
+        }
+
+        // phase 1 (serial): determine the per-utterance layout and copy all logLLs into the CPU-side 'pred' stripes
+        struct uttinfo
+        {
+            size_t ts;         // start column in the frame-concatenated layout
+            size_t numframes;  // utterance length
+            size_t mapi;       // parallel-sequence index
+            size_t startframe; // first time step within the parallel sequence
+        };
+        std::vector<uttinfo> utts(lattices.size());
+        size_t ts = 0;
+        for (size_t i = 0; i < lattices.size(); i++)
+        {
+            const size_t numframes = lattices[i]->getnumframes();
+            size_t mapi = 0;
+            msra::dbn::matrixstripe predstripe(pred, ts, numframes); // logLLs for this utterance
+            if (samplesInRecurrentStep == 1)                         // no sequence parallelism
+            {
+                tempmatrix = loglikelihood.ColumnSlice(ts, numframes);
+                CopyFromCNTKMatrixToSSEMatrix(tempmatrix, numframes, predstripe);
+            }
+            else // multiple parallel sequences
+            {
+                mapi = extrauttmap[i];
+
+                // scan MBLayout for end of utterance
+                size_t mapframenum = SIZE_MAX;
+                for (size_t t = validframes[mapi]; t < T; t++)
+                {
+                    if (pMBLayout->IsEnd(mapi, t))
+                    {
+                        mapframenum = t - validframes[mapi] + 1;
+                        break;
+                    }
+                }
+                if (numframes != mapframenum)
+                    LogicError("gammacalculation: IsEnd() not working, numframes (%d) vs. mapframenum (%d)", (int) numframes, (int) mapframenum);
+
+                if (numframes > tempmatrix.GetNumCols())
+                    tempmatrix.Resize(numrows, numframes);
+                Microsoft::MSR::CNTK::Matrix<ElemType> loglikelihoodForCurrentParallelUtterance = loglikelihood.ColumnSlice(mapi + (validframes[mapi] * samplesInRecurrentStep), ((numframes - 1) * samplesInRecurrentStep) + 1);
+                tempmatrix.CopyColumnsStrided(loglikelihoodForCurrentParallelUtterance, numframes, samplesInRecurrentStep, 1);
+                CopyFromCNTKMatrixToSSEMatrix(tempmatrix, numframes, predstripe);
+            }
+            utts[i] = uttinfo{ts, numframes, mapi, validframes[mapi]};
+            if (samplesInRecurrentStep > 1)
+                validframes[mapi] += numframes; // advance the cursor within the parallel sequence
+            ts += numframes;
+        }
+
+        // phase 2 (parallel): each device runs forwardbackward for every numdevices-th utterance
+        // Each shard has its own parallelstate, so the devices work fully independently; logLLs
+        // go up from the CPU stripe and gammas come back down into the (disjoint) CPU stripes.
+        const size_t numdevices = extraparallellattices.size() + 1;
+        std::vector<double> numavlogps(lattices.size(), 0.0);
+        std::vector<double> denavlogps(lattices.size(), 0.0);
+        std::vector<std::exception_ptr> shardexceptions(numdevices);
+        auto shardbody = [&](size_t shard)
+        {
+            try
+            {
+                msra::lattices::lattice::parallelstate& shardstate = (shard == 0) ? parallellattice : *extraparallellattices[shard - 1];
+                Microsoft::MSR::CNTK::Matrix<ElemType> cpustaging(CPUDEVICE);  // CPU-side staging for the logLL upload
+                Microsoft::MSR::CNTK::Matrix<ElemType> shardgammas(CPUDEVICE); // staging for the gamma download
+                std::vector<ElemType> copybuffer;
+                for (size_t i = shard; i < lattices.size(); i += numdevices)
+                {
+                    const size_t numframes = utts[i].numframes;
+                    msra::dbn::matrixstripe predstripe(pred, utts[i].ts, numframes);
+                    msra::dbn::matrixstripe dengammasstripe(dengammas, utts[i].ts, numframes);
+
+                    // ship this utterance's logLLs to the shard's device
+                    copybuffer.resize(numrows * numframes);
+                    for (size_t t = 0; t < numframes; t++)
+                        memcpy(&copybuffer[t * numrows], &predstripe(0, t), sizeof(float) * numrows);
+                    cpustaging.SetValue(numrows, numframes, CPUDEVICE, copybuffer.data(), 0);
+                    shardstate.setloglls(cpustaging);
+
+                    array_ref<size_t> uidsstripe(&uids[utts[i].ts], numframes);
+                    array_ref<size_t> boundariesstripe(&boundaries[utts[i].ts], 0); // (no reference alignment on this path)
+
+                    double numavlogp = 0;
+                    foreach_column (t, dengammasstripe)
+                    {
+                        const size_t s = uidsstripe[t];
+                        numavlogp += predstripe(s, t) / amf;
+                    }
+                    numavlogps[i] = numavlogp / numframes;
+
+                    denavlogps[i] = lattices[i]->second.forwardbackward(shardstate,
+                                                                        (const msra::math::ssematrixbase&) predstripe, (const msra::asr::simplesenonehmm&) m_hset,
+                                                                        (msra::math::ssematrixbase&) dengammasstripe, (msra::math::ssematrixbase&) gammasbuffer /*empty, not used*/,
+                                                                        lmf, wp, amf, boostmmifactor, seqsMBRmode, uidsstripe, boundariesstripe);
+
+                    // fetch the gammas into the CPU stripe (the sMBR path has already done this inside forwardbackward())
+                    if (!seqsMBRmode)
+                    {
+                        shardstate.getgamma(shardgammas); // (getgamma moves this staging matrix to the shard's device)
+                        copybuffer.resize(numrows * numframes);
+                        ElemType* pbuf = copybuffer.data();
+                        size_t bufsize = copybuffer.size();
+                        shardgammas.CopyToArray(pbuf, bufsize);
+                        if (pbuf != copybuffer.data())
+                            LogicError("calgammaformbsharded: unexpected re-allocation in Matrix::CopyToArray");
+                        for (size_t t = 0; t < numframes; t++)
+                            memcpy(&dengammasstripe(0, t), &copybuffer[t * numrows], sizeof(float) * numrows);
+                    }
+                }
+            }
+            catch (...)
+            {
+                shardexceptions[shard] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> shardthreads;
+        for (size_t shard = 1; shard < numdevices; shard++)
+            shardthreads.emplace_back(shardbody, shard);
+        shardbody(0); // shard 0 (the training device) runs on the calling thread
+        for (auto& thread : shardthreads)
+            thread.join();
+        for (size_t shard = 0; shard < numdevices; shard++)
+            if (shardexceptions[shard])
+                std::rethrow_exception(shardexceptions[shard]);
+
+        // phase 3 (serial): apply the gammas to the training device and accumulate the objective
+        for (size_t i = 0; i < lattices.size(); i++)
+        {
+            const size_t numframes = utts[i].numframes;
+            objectValue += (ElemType)((numavlogps[i] - denavlogps[i]) * numframes);
+
+            msra::dbn::matrixstripe dengammasstripe(dengammas, utts[i].ts, numframes);
+            if (samplesInRecurrentStep == 1)
+            {
+                tempmatrix = gammafromlattice.ColumnSlice(utts[i].ts, numframes); // (a view, so this writes into gammafromlattice)
+                CopyFromSSEMatrixToCNTKMatrix(dengammasstripe, numrows, numframes, tempmatrix, gammafromlattice.GetDeviceId());
+            }
+            else
+            {
+                if (numframes > tempmatrix.GetNumCols())
+                    tempmatrix.Resize(numrows, numframes);
+                Microsoft::MSR::CNTK::Matrix<ElemType> gammaslice = tempmatrix.ColumnSlice(0, numframes);
+                CopyFromSSEMatrixToCNTKMatrix(dengammasstripe, numrows, numframes, gammaslice, gammafromlattice.GetDeviceId());
+                Microsoft::MSR::CNTK::Matrix<ElemType> gammaFromLatticeForCurrentParallelUtterance = gammafromlattice.ColumnSlice(utts[i].mapi + (utts[i].startframe * samplesInRecurrentStep), ((numframes - 1) * samplesInRecurrentStep) + 1);
+                gammaFromLatticeForCurrentParallelUtterance.CopyColumnsStrided(gammaslice, numframes, 1, samplesInRecurrentStep);
+            }
+            fprintf(stderr, "dengamma value %f\n", denavlogps[i]);
+        }
+        functionValues.SetValue(objectValue);
+    }
+
     // Helper methods for copying between ssematrix objects and CNTK matrices
     void CopyFromCNTKMatrixToSSEMatrix(const Microsoft::MSR::CNTK::Matrix<ElemType>& src, size_t numCols, msra::math::ssematrixbase& dest)
+    {
+        CopyFromCNTKMatrixToSSEMatrix(src, numCols, dest, m_intermediateCUDACopyBuffer, m_intermediateCUDACopyBufferSize);
+    }
+
+    // variant with a caller-provided intermediate buffer, so the preparation thread of the
+    // pipelined calgammaformb() path can copy concurrently with the main thread's gamma copies
+    void CopyFromCNTKMatrixToSSEMatrix(const Microsoft::MSR::CNTK::Matrix<ElemType>& src, size_t numCols, msra::math::ssematrixbase& dest,
+                                       std::shared_ptr<ElemType>& intermediateBuffer, size_t& intermediateBufferSize)
     {
         if (!std::is_same<ElemType, float>::value)
         {
@@ -394,15 +692,15 @@ private:
 
         size_t numRows = src.GetNumRows();
         const Microsoft::MSR::CNTK::Matrix<ElemType> srcSlice = src.ColumnSlice(0, numCols);
-        if ((m_intermediateCUDACopyBuffer == nullptr) || (m_intermediateCUDACopyBufferSize < srcSlice.GetNumElements()))
+        if ((intermediateBuffer == nullptr) || (intermediateBufferSize < srcSlice.GetNumElements()))
         {
-            m_intermediateCUDACopyBuffer = AllocateIntermediateBuffer(srcSlice.GetDeviceId(), srcSlice.GetNumElements());
-            m_intermediateCUDACopyBufferSize = srcSlice.GetNumElements();
+            intermediateBuffer = AllocateIntermediateBuffer(srcSlice.GetDeviceId(), srcSlice.GetNumElements());
+            intermediateBufferSize = srcSlice.GetNumElements();
         }
 
-        ElemType* pBuf = m_intermediateCUDACopyBuffer.get();
-        srcSlice.CopyToArray(pBuf, m_intermediateCUDACopyBufferSize);
-        if (pBuf != m_intermediateCUDACopyBuffer.get())
+        ElemType* pBuf = intermediateBuffer.get();
+        srcSlice.CopyToArray(pBuf, intermediateBufferSize);
+        if (pBuf != intermediateBuffer.get())
         {
             LogicError("Unexpected re-allocation of destination CPU buffer in Matrix::CopyToArray!");
         }
@@ -509,11 +807,15 @@ protected:
     std::vector<size_t> boundary;
     float boostmmifactor;
     bool seqsMBRmode;
+    size_t numlatticedevices;                                                                    // requested number of devices for lattice sharding
+    std::vector<std::shared_ptr<msra::lattices::lattice::parallelstate>> extraparallellattices; // per-device states for shards 1..n-1 (shard 0 = parallellattice)
 
 private:
     std::unique_ptr<Microsoft::MSR::CNTK::CUDAPageLockedMemAllocator> m_cudaAllocator;
     std::shared_ptr<ElemType> m_intermediateCUDACopyBuffer;
     size_t m_intermediateCUDACopyBufferSize;
+    std::shared_ptr<ElemType> m_prepCopyBuffer; // separate pinned buffer for the preparation thread
+    size_t m_prepCopyBufferSize;
 };
 
 }}
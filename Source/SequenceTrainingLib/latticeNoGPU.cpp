@@ -13,6 +13,11 @@
 
 namespace msra { namespace cuda {
 
+size_t numdevices()
+{
+    return 0;
+}
+
 void latticefunctionsops::edgealignment(const vectorref<lrhmmdef>& hmms, const vectorref<lr3transP>& transPs, const size_t spalignunitid,
                                         const size_t silalignunitid, const matrixref<float>& logLLs,
                                         const vectorref<msra::lattices::nodeinfo>& nodes, const vectorref<msra::lattices::edgeinfowithscores>& edges,
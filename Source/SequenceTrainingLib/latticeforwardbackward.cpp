@@ -178,6 +178,7 @@ static bool islogzero(FLOAT v)
         const auto &hmm = hset.gethmm(units[k].unit);
         const size_t n = hmm.getnumstates();
         const auto &transP = hmm.gettransP();
+        const unsigned short *senoneids = hmm.getsenoneids(); // hoisted flat row: avoids per-frame indexed accessor calls
         const size_t ts = te - units[k].frames; // end time of current unit
         const size_t js = je - n;               // range of state indices
 
@@ -202,8 +203,8 @@ static bool islogzero(FLOAT v)
         {
             for (size_t to = 0; to < n; to++)
             {
-                const size_t j = js + to;             // source trellis node
-                const size_t s = hmm.getsenoneid(to); // senone id for state at position 'to' in the HMM
+                const size_t j = js + to;            // source trellis node
+                const size_t s = (size_t) senoneids[to]; // senone id for state at position 'to' in the HMM
                 const float acLL = logLLs(s, t);
                 if (islogzero(acLL))
                     fprintf(stderr, "forwardbackwardedge: WARNING: edge J=%d unit %d (%s) frames [%d,%d) ac score(%d,%d) is zero (%d st, %d fr: %s)\n",
@@ -254,6 +255,7 @@ static bool islogzero(FLOAT v)
         const auto &hmm = hset.gethmm(units[k].unit);
         const size_t n = hmm.getnumstates();
         const auto &transP = hmm.gettransP();
+        const unsigned short *senoneids = hmm.getsenoneids();
         const size_t te2 = ts + units[k].frames; // end time of current unit
         const size_t je2 = js + n;               // range of state indices
 
@@ -263,7 +265,7 @@ static bool islogzero(FLOAT v)
             for (size_t to = 0; to < n; to++)
             {
                 const size_t j = js + to; // target trellis node
-                const size_t s = hmm.getsenoneid(to);
+                const size_t s = (size_t) senoneids[to];
                 const float acLL = logLLs(s, t);
                 float alphajtnoll = LOGZERO;
                 if (t == ts) // entering score
@@ -370,6 +372,7 @@ static bool islogzero(FLOAT v)
         const auto &hmm = hset.gethmm(units[k].unit);
         const size_t n = hmm.getnumstates();
         const auto &transP = hmm.gettransP();
+        const unsigned short *senoneids = hmm.getsenoneids();
         const size_t te = ts + units[k].frames;    // end time of current unit
         const size_t je = js + hmm.getnumstates(); // range of state indices
 
@@ -379,7 +382,7 @@ static bool islogzero(FLOAT v)
             for (size_t j = js; j < je; j++)
             {
                 const size_t to = j - js; // relative state
-                const size_t s = hmm.getsenoneid(to);
+                const size_t s = (size_t) senoneids[to];
                 pathscores(j, t) = LOGZERO;
                 backpointers(j, t) = invalidbp;
                 if (t == ts) // entering score
@@ -872,7 +875,11 @@ void lattice::forwardbackwardalign(parallelstate &parallelstate,
         if (minlogpp > LOGZERO)
             fprintf(stderr, "forwardbackwardalign: pruning not supported (we won't need it!) :)\n");
         edgeacscores.resize(edges.size());
-        for (size_t j = 0; j < edges.size(); j++)
+        // edges are mutually independent here (each only touches abcs[j], edgeacscores[j],
+        // and thisedgealignments[j]), so we distribute them over the cores
+        const long numsiledges = (long) edges.size();
+#pragma omp parallel for schedule(dynamic) // dynamic: silence edges differ vastly in length
+        for (long j = 0; j < numsiledges; j++)
         {
             const auto &aligntokens = getaligninfo(j); // get alignment tokens
             if (aligntokens.size() == 0)
@@ -952,7 +959,13 @@ void lattice::forwardbackwardalign(parallelstate &parallelstate,
             parallelstate.getedgeacscores(edgeacscoresgpu);
             parallelstate.copyalignments(thisedgealignmentsgpu);
         }
-        foreach_index (j, edges)
+        // This per-edge loop is where a GPU-less sMBR pass spends nearly all of its time.
+        // Edges are mutually independent (each only writes abcs[j], edgeacscores[j], and
+        // thisedgealignments[j], all pre-allocated), so we distribute them over the cores.
+        // Verification mode stays single-threaded to keep its diagnostics readable.
+        const long numedges = (long) edges.size();
+#pragma omp parallel for schedule(dynamic) if (!cpuverification) // dynamic: edge lengths vary vastly
+        for (long j = 0; j < numedges; j++)
         {
             const edgeinfowithscores &e = edges[j];
             const size_t ts = nodes[e.S].t;
@@ -982,7 +995,7 @@ void lattice::forwardbackwardalign(parallelstate &parallelstate,
                 if (fabs(edgeacscores[j] - edgeacscoresgpu[j]) > 1e-3)
                 {
                     fprintf(stderr, "edge %d, sil ? %d, edgeacscores / edgeacscoresgpu MISMATCH %f v.s. %f, diff %e\n",
-                            j, edgehassil ? 1 : 0, (float) edgeacscores[j], (float) edgeacscoresgpu[j],
+                            (int) j, edgehassil ? 1 : 0, (float) edgeacscores[j], (float) edgeacscoresgpu[j],
                             (float) (edgeacscores[j] - edgeacscoresgpu[j]));
                     fprintf(stderr, "aligntokens: ");
                     foreach_index (i, aligntokens)
@@ -992,7 +1005,7 @@ void lattice::forwardbackwardalign(parallelstate &parallelstate,
                 for (size_t t = ts; t < te; t++)
                 {
                     if (thisedgealignments[j][t - ts] != thisedgealignmentsgpu[j][t - ts])
-                        fprintf(stderr, "edge %d, sil ? %d, time %d, alignment / alignmentgpu MISMATCH %d v.s. %d\n", j, edgehassil ? 1 : 0, (int) (t - ts), thisedgealignments[j][t - ts], thisedgealignmentsgpu[j][t - ts]);
+                        fprintf(stderr, "edge %d, sil ? %d, time %d, alignment / alignmentgpu MISMATCH %d v.s. %d\n", (int) j, edgehassil ? 1 : 0, (int) (t - ts), thisedgealignments[j][t - ts], thisedgealignmentsgpu[j][t - ts]);
                 }
             }
         }
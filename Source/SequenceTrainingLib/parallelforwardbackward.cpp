@@ -424,8 +424,8 @@ struct parallelstateimpl
     std::vector<unsigned short> senone2classmapcpuforgpu;
 
     // this caches the models over
-    // static_assert (sizeof (lr3transP) == 32, "unexpected size of lr3transP");
     // TOOD: give this function a proper name
+    static_assert(sizeof(lr3transP) % 16 == 0, "lr3transP must be padded to a multiple of 16 bytes for aligned row access");
     static_assert(sizeof(lrhmmdef) == 8, "unexpected size of lrhmmdef");
     void cachehset(const msra::asr::simplesenonehmm& hset, mbrclassdefinition mbrclassdef)
     {
@@ -686,6 +686,11 @@ size_t lattice::parallelstate::getdevice()
     return pimpl->getdevice();
 }
 
+/*static*/ size_t lattice::parallelstate::getdevicecount()
+{
+    return msra::cuda::numdevices();
+}
+
 void lattice::parallelstate::release(bool pcpumode)
 {
     if (!pcpumode)
@@ -0,0 +1,273 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.md file in the project root for full license information.
+//
+// MathBench.cpp : timed microbenchmarks for the hot Math kernels ('make mathbench').
+//
+// Unlike the unit tests, which check correctness, this harness times the production dispatch
+// paths (dense GEMM, TensorOp shapes as they occur in real networks, sparse product, quantized
+// block multiplier) across a matrix of sizes, with warmup and repetitions, and emits the
+// results as JSON so they can be tracked over time. Human-readable progress goes to stderr,
+// JSON goes to stdout (or to a file with --json).
+//
+#include "Matrix.h"
+#include "CPUMatrix.h"
+#include "CPUSparseMatrix.h"
+#include "TensorView.h"
+#include "BlockMultiplier.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::MSR::CNTK;
+using namespace std;
+
+static int g_warmup = 2;
+static int g_reps = 10;
+static string g_filter; // when set, only run benchmarks whose name contains this substring
+
+struct BenchResult
+{
+    string name;   // kernel being timed
+    string params; // size/shape description, stable across runs for trend tracking
+    double bestMs;
+    double meanMs;
+    double gflops; // based on best time; 0 if no meaningful flop count
+};
+
+static vector<BenchResult> g_results;
+
+// time body() with warmup and repetitions; flopsPerRep == 0 suppresses the rate column
+template <typename Body>
+static void RunBench(const string& name, const string& params, double flopsPerRep, const Body& body)
+{
+    if (!g_filter.empty() && name.find(g_filter) == string::npos)
+        return;
+    for (int i = 0; i < g_warmup; i++)
+        body();
+    double bestMs = 0, sumMs = 0;
+    for (int i = 0; i < g_reps; i++)
+    {
+        auto start = chrono::steady_clock::now();
+        body();
+        auto stop = chrono::steady_clock::now();
+        double ms = chrono::duration<double, milli>(stop - start).count();
+        sumMs += ms;
+        if (i == 0 || ms < bestMs)
+            bestMs = ms;
+    }
+    BenchResult res{name, params, bestMs, sumMs / g_reps, flopsPerRep > 0 ? flopsPerRep / (bestMs * 1e6) : 0};
+    g_results.push_back(res);
+    fprintf(stderr, "%-28s %-28s best %9.3f ms  mean %9.3f ms", name.c_str(), params.c_str(), res.bestMs, res.meanMs);
+    if (res.gflops > 0)
+        fprintf(stderr, "  %8.2f GFlops", res.gflops);
+    fprintf(stderr, "\n");
+}
+
+template <class ElemType>
+static void RandomInitCPUMatrix(CPUMatrix<ElemType>& M, unsigned long seed)
+{
+    M.SetUniformRandomValue((ElemType) -0.5, (ElemType) 0.5, seed);
+}
+
+// -----------------------------------------------------------------------
+// dense GEMM: CPUMatrix::MultiplyAndWeightedAdd
+// -----------------------------------------------------------------------
+
+template <class ElemType>
+static void BenchGemm(const char* name, size_t m, size_t k, size_t n)
+{
+    CPUMatrix<ElemType> A(m, k), B(k, n), C(m, n);
+    RandomInitCPUMatrix(A, 1);
+    RandomInitCPUMatrix(B, 2);
+    RandomInitCPUMatrix(C, 3);
+    char params[80];
+    sprintf(params, "m=%d k=%d n=%d", (int) m, (int) k, (int) n);
+    RunBench(name, params, 2.0 * m * k * n, [&]()
+    {
+        CPUMatrix<ElemType>::MultiplyAndWeightedAdd((ElemType) 1, A, false, B, false, (ElemType) 0.5, C);
+    });
+}
+
+// -----------------------------------------------------------------------
+// TensorOp shapes as they occur in real networks
+// -----------------------------------------------------------------------
+
+static shared_ptr<Matrix<float>> MakeTensorSob(const TensorShape& shape, unsigned long seed)
+{
+    auto sob = make_shared<Matrix<float>>(shape.GetNumElements(), 1, (DEVICEID_TYPE) CPUDEVICE);
+    sob->SetUniformRandomValue(-0.5f, 0.5f, seed);
+    return sob;
+}
+
+static string ShapeString(const TensorShape& shape)
+{
+    string s = "[";
+    for (size_t i = 0; i < shape.GetRank(); i++)
+        s += (i ? "x" : "") + to_string(shape[i]);
+    return s + "]";
+}
+
+// convolutional-layer bias addition: output = activation + broadcast bias
+static void BenchTensorBiasAdd(const TensorShape& dataShape, const TensorShape& biasShape)
+{
+    TensorView<float> data(MakeTensorSob(dataShape, 4), dataShape);
+    TensorView<float> bias(MakeTensorSob(biasShape, 5), biasShape);
+    TensorView<float> result(MakeTensorSob(dataShape, 6), dataShape);
+    RunBench("TensorOp.BiasAdd", ShapeString(dataShape) + "+" + ShapeString(biasShape),
+             (double) dataShape.GetNumElements(), [&]()
+    {
+        result.DoSumOf(0.0f, data, bias, 1.0f);
+    });
+}
+
+// bias gradient: reduce the full gradient tensor onto the bias shape
+static void BenchTensorBiasGrad(const TensorShape& dataShape, const TensorShape& biasShape)
+{
+    TensorView<float> grad(MakeTensorSob(dataShape, 7), dataShape);
+    TensorView<float> biasGrad(MakeTensorSob(biasShape, 8), biasShape);
+    RunBench("TensorOp.BiasGradient", ShapeString(dataShape) + "->" + ShapeString(biasShape),
+             (double) dataShape.GetNumElements(), [&]()
+    {
+        biasGrad.DoCopyOf(0.0f, grad, 1.0f);
+    });
+}
+
+// elementwise nonlinearity over a typical hidden layer
+static void BenchTensorSigmoid(const TensorShape& shape)
+{
+    TensorView<float> input(MakeTensorSob(shape, 9), shape);
+    TensorView<float> output(MakeTensorSob(shape, 10), shape);
+    RunBench("TensorOp.Sigmoid", ShapeString(shape), (double) shape.GetNumElements(), [&]()
+    {
+        output.DoSigmoidOf(0.0f, input, 1.0f);
+    });
+}
+
+// -----------------------------------------------------------------------
+// dense * sparse: CPUSparseMatrix::MultiplyAndWeightedAdd
+// -----------------------------------------------------------------------
+
+static void BenchSparseProduct(size_t m, size_t k, size_t n, size_t nnzPerCol)
+{
+    CPUMatrix<float> lhs(m, k), c(m, n);
+    RandomInitCPUMatrix(lhs, 11);
+    RandomInitCPUMatrix(c, 12);
+    CPUSparseMatrix<float> rhs(matrixFormatSparseCSC, k, n, nnzPerCol * n);
+    for (size_t j = 0; j < n; j++) // fill in column order (CSC append order)
+        for (size_t i = 0; i < nnzPerCol; i++)
+            rhs.SetValue((i * (k / nnzPerCol) + j) % k, j, 1.0f + (float) i);
+    char params[80];
+    sprintf(params, "m=%d k=%d n=%d nnz/col=%d", (int) m, (int) k, (int) n, (int) nnzPerCol);
+    RunBench("CPUSparse.MultiplyAndAdd", params, 2.0 * m * nnzPerCol * n, [&]()
+    {
+        CPUSparseMatrix<float>::MultiplyAndWeightedAdd(1.0f, lhs, false, rhs, false, 0.5f, c);
+    });
+}
+
+// -----------------------------------------------------------------------
+// quantized fixed-point GEMM: BlockMultiplier
+// -----------------------------------------------------------------------
+
+static void BenchBlockMultiplier(int m, int k, int n, int numThreads)
+{
+    typedef BlockMultiplier<BlockHandlerSSE> Multiplier;
+    Multiplier mult;
+    mult.SetNumThreads(numThreads);
+    int16_t* A = Multiplier::CreateMatrixA(m, k);
+    int16_t* B = Multiplier::CreateMatrixB(k, n);
+    int32_t* C = Multiplier::CreateMatrixC(m, n);
+    for (int i = 0; i < m * k; i++)
+        A[i] = (int16_t)(i % 63 - 31);
+    for (int i = 0; i < k * n; i++)
+        B[i] = (int16_t)(i % 63 - 31);
+    int16_t* preparedB = mult.PrepareB(B, k, n);
+    char params[80];
+    sprintf(params, "m=%d k=%d n=%d threads=%d", m, k, n, numThreads);
+    RunBench("BlockMultiplier", params, 2.0 * m * k * n, [&]()
+    {
+        mult.MultiplyMatrices(A, m, k, preparedB, n, C);
+    });
+    Multiplier::FreeMatrix(A);
+    Multiplier::FreeMatrix(B);
+    Multiplier::FreeMatrix(C);
+    if (preparedB != B)
+        Multiplier::FreeMatrix(preparedB);
+}
+
+// -----------------------------------------------------------------------
+// output & driver
+// -----------------------------------------------------------------------
+
+static void WriteJson(ostream& out)
+{
+    out << "[\n";
+    for (size_t i = 0; i < g_results.size(); i++)
+    {
+        const auto& r = g_results[i];
+        out << "  { \"name\": \"" << r.name << "\", \"params\": \"" << r.params << "\""
+            << ", \"warmup\": " << g_warmup << ", \"reps\": " << g_reps
+            << ", \"best_ms\": " << r.bestMs << ", \"mean_ms\": " << r.meanMs
+            << ", \"gflops\": " << r.gflops << " }" << (i + 1 < g_results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+}
+
+int main(int argc, char* argv[])
+{
+    string jsonPath;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--warmup" && i + 1 < argc)
+            g_warmup = atoi(argv[++i]);
+        else if (arg == "--reps" && i + 1 < argc)
+            g_reps = atoi(argv[++i]);
+        else if (arg == "--filter" && i + 1 < argc)
+            g_filter = argv[++i];
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: mathbench [--warmup N] [--reps N] [--filter substring] [--json path]\n");
+            return 1;
+        }
+    }
+
+    // dense GEMM across hidden-layer and decode shapes
+    BenchGemm<float>("CPUMatrix.Gemm<float>", 512, 512, 128);
+    BenchGemm<float>("CPUMatrix.Gemm<float>", 1024, 1024, 1024);
+    BenchGemm<float>("CPUMatrix.Gemm<float>", 2048, 2048, 256);
+    BenchGemm<float>("CPUMatrix.Gemm<float>", 2048, 2048, 1); // beam-1 decode: GEMV shape
+    BenchGemm<double>("CPUMatrix.Gemm<double>", 1024, 1024, 256);
+
+    // TensorOp shapes lifted from real networks (cf. TensorTests.cpp)
+    BenchTensorBiasAdd(TensorShape{28, 28, 128, 32}, TensorShape{1, 1, 128});
+    BenchTensorBiasAdd(TensorShape{2048, 256}, TensorShape{2048, 1});
+    BenchTensorBiasGrad(TensorShape{28, 28, 128, 32}, TensorShape{1, 1, 128});
+    BenchTensorBiasGrad(TensorShape{2048, 256}, TensorShape{2048, 1});
+    BenchTensorSigmoid(TensorShape{2048, 256});
+
+    // dense * sparse CSC, embedding-gradient-like density
+    BenchSparseProduct(512, 8192, 128, 82);  // ~1% dense
+    BenchSparseProduct(512, 8192, 128, 410); // ~5% dense
+
+    // quantized block multiplier
+    BenchBlockMultiplier(256, 2048, 64, 1);
+    BenchBlockMultiplier(256, 2048, 64, 4);
+
+    if (jsonPath.empty())
+        WriteJson(cout);
+    else
+    {
+        ofstream f(jsonPath);
+        WriteJson(f);
+        fprintf(stderr, "wrote %d results to %s\n", (int) g_results.size(), jsonPath.c_str());
+    }
+    return 0;
+}
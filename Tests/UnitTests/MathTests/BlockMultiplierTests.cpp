@@ -4,6 +4,9 @@
 //
 #include "stdafx.h"
 #include "../../../Source/Math/BlockMultiplier.h"
+#ifdef _MSC_VER
+#include <intrin.h> // for __cpuid/__cpuidex
+#endif
 
 namespace Microsoft { namespace MSR { namespace CNTK { namespace TEST {
 
@@ -137,6 +140,34 @@ template<typename ScalarAT, typename ScalarBT, typename ScalarCT, typename Multi
     TestMultiplierSub<ScalarAT, ScalarBT, ScalarCT, MultiplierT>(m, k, n, testMult, numThreads, epsilon);
 }
 
+#ifdef SUPPORT_AVX512
+// The AVX-512 binaries may be built on (or for) a newer machine than the one running the tests,
+// so gate the AVX-512 cases on a runtime check instead of failing with an illegal instruction.
+static bool SupportsAVX512()
+{
+#if defined(__GNUC__)
+#ifdef __AVX512VNNI__
+    if (!__builtin_cpu_supports("avx512vnni"))
+        return false;
+#endif
+    return __builtin_cpu_supports("avx512bw") != 0;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuidex(info, 7, 0);
+#ifdef __AVX512VNNI__
+    if ((info[2] & (1 << 11)) == 0) // ECX bit 11 = AVX512_VNNI
+        return false;
+#endif
+    return (info[1] & (1 << 30)) != 0; // EBX bit 30 = AVX512BW
+#else
+    return false;
+#endif
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE(BlockMultiplierSuite)
 
 BOOST_AUTO_TEST_CASE(BlockMultiplyTest8x128x8SingleThread)
@@ -185,5 +216,49 @@ BOOST_AUTO_TEST_CASE(BlockMultiplyTestAllKFourRowsMultiThread)
     TestMultiplierSub<int16_t, int16_t, int32_t, BlockMultiplier<BlockHandlerSSE>>(4, 128 + 64 + 32 + 16 + 8 + 1, 1, 2);
 }
 
+#ifdef SUPPORT_AVX512
+// The AVX-512 cases deliberately use k >= 256: with two or more 128-blocks the A offsets of the
+// x4 and x1 rewrites no longer coincide, so a handler mixing up rowsPerBlock only fails here.
+
+// m % 4 == 0, so all rows go through the x4 kernels.
+BOOST_AUTO_TEST_CASE(BlockMultiplyAVX512Test8x256x8SingleThread)
+{
+    if (!SupportsAVX512())
+        return;
+    TestMultiplierSub<int16_t, int16_t, int32_t, BlockMultiplier<BlockHandlerAVX512>>(8, 256, 8, 1);
+}
+
+// m % 4 != 0 forces the x1 kernels for the leftover row.
+BOOST_AUTO_TEST_CASE(BlockMultiplyAVX512Test17x256x9SingleThread)
+{
+    if (!SupportsAVX512())
+        return;
+    TestMultiplierSub<int16_t, int16_t, int32_t, BlockMultiplier<BlockHandlerAVX512>>(17, 256, 9, 1);
+}
+
+// Single row on the x1 path through every kernel size, with a two-block 128 pass.
+BOOST_AUTO_TEST_CASE(BlockMultiplyAVX512TestAllKSingleRowSingleThread)
+{
+    if (!SupportsAVX512())
+        return;
+    TestMultiplierSub<int16_t, int16_t, int32_t, BlockMultiplier<BlockHandlerAVX512>>(1, 256 + 64 + 32 + 16 + 8 + 1, 1, 1);
+}
+
+// Four rows through every kernel size on the x4 path.
+BOOST_AUTO_TEST_CASE(BlockMultiplyAVX512TestAllKFourRowsSingleThread)
+{
+    if (!SupportsAVX512())
+        return;
+    TestMultiplierSub<int16_t, int16_t, int32_t, BlockMultiplier<BlockHandlerAVX512>>(4, 256 + 64 + 32 + 16 + 8 + 1, 1, 1);
+}
+
+BOOST_AUTO_TEST_CASE(BlockMultiplyAVX512Test17x384x9MultiThread)
+{
+    if (!SupportsAVX512())
+        return;
+    TestMultiplierSub<int16_t, int16_t, int32_t, BlockMultiplier<BlockHandlerAVX512>>(17, 384, 9, 2);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
 }}}} //end namespaces
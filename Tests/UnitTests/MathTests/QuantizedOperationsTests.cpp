@@ -5,6 +5,11 @@
 #include "stdafx.h"
 #include "../../../Source/Math/QuantizedOperations.h"
 #include "../../../Source/Math/Helpers.h"
+#ifdef SUPPORT_AVX2
+#include "../../../Source/Math/BlockMultiplier.h"
+#include "../../../Source/Math/BlockHandlerAVXInt8.h"
+#include "../../../Source/Math/CPUTensorOpsSimd.h" // for GetCPUSimdLevel
+#endif
 
 using namespace Microsoft::MSR::CNTK;
 namespace Microsoft { namespace MSR { namespace CNTK { namespace Test {
@@ -51,6 +56,74 @@ BOOST_FIXTURE_TEST_CASE(MultiplyIntToShort, RandomSeedFixture)
 }
 
 
+BOOST_FIXTURE_TEST_CASE(MultiplyIntToInt8, RandomSeedFixture)
+{
+    // Same product as above, quantized to int8 instead of short.
+    int m = 5, n = 4, k = 3;
+    std::vector<float> A = {1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
+    std::vector<float> B = {16,17,18,19,20,21,22,23,24,25,26,27};
+    std::vector<float> C_expected = { 316, 367, 418, 469, 520, 370, 430, 490, 550, 610, 424, 493, 562, 631, 700, 478, 556, 634, 712, 790 };
+    std::vector<float> C;
+    C.resize(m*n);
+
+    shared_ptr<QuantizerBase<float, int8_t>> quantA(new SymmetricQuantizer<float, int8_t>(1));
+    shared_ptr<QuantizerBase<float, int8_t>> quantB(new SymmetricQuantizer<float, int8_t>(2));
+
+    QuantizedMultiplier<float, int8_t> mult(quantA, true, quantB, false);
+    mult.Multiply(m, n, k, A.data(), B.data(), C.data());
+
+    // int8 quantization is coarse, so allow a relative tolerance instead of exact equality.
+    for (size_t i = 0; i < m*n; i++)
+        BOOST_CHECK(fabs(C[i] - C_expected[i]) / C_expected[i] < 0.1);
+}
+
+#ifdef SUPPORT_AVX2
+// The case above has k=3, so it never leaves the scalar leftover loop (the smallest SIMD
+// block is k=8). This one drives the int8 block kernels themselves: k >= 256 reaches the
+// two-block 128 kernel, whose A offsets differ between the x4 and x1 rewrites, and
+// m % 4 != 0 forces the x1 kernels for the leftover row. The values fit int8 exactly, so
+// the result must match the int16 SSE handler bit for bit.
+BOOST_FIXTURE_TEST_CASE(MultiplyInt8BlockKernelsLargeK, RandomSeedFixture)
+{
+    if (GetCPUSimdLevel() < CPUSimdLevel::AVX2) // the handler needs AVX2 at runtime
+        return;
+
+    const int m = 17, k = 384, n = 9;
+    BlockMultiplier<BlockHandlerAVXInt8> int8Mult;
+    BlockMultiplier<BlockHandlerSSE> shortMult;
+    int8_t* A8 = int8Mult.CreateMatrixA(m, k);
+    int8_t* B8 = int8Mult.CreateMatrixB(k, n);
+    int32_t* C8 = int8Mult.CreateMatrixC(m, n);
+    int16_t* A16 = shortMult.CreateMatrixA(m, k);
+    int16_t* B16 = shortMult.CreateMatrixB(k, n);
+    int32_t* C16 = shortMult.CreateMatrixC(m, n);
+
+    for (int i = 0; i < m * k; i++)
+        A16[i] = A8[i] = (int8_t)(((i * 7) % 63) - 31);
+    for (int i = 0; i < k * n; i++)
+        B16[i] = B8[i] = (int8_t)(((i * 11) % 63) - 31);
+
+    int8_t* B8Prepared = int8Mult.PrepareB(B8, k, n);
+    int16_t* B16Prepared = shortMult.PrepareB(B16, k, n);
+    int8Mult.MultiplyMatrices(A8, m, k, B8Prepared, n, C8);
+    shortMult.MultiplyMatrices(A16, m, k, B16Prepared, n, C16);
+
+    for (int i = 0; i < m * n; i++)
+        BOOST_CHECK_EQUAL(C8[i], C16[i]);
+
+    int8Mult.FreeMatrix(A8);
+    int8Mult.FreeMatrix(B8);
+    int8Mult.FreeMatrix(C8);
+    shortMult.FreeMatrix(A16);
+    shortMult.FreeMatrix(B16);
+    shortMult.FreeMatrix(C16);
+    if (B8Prepared != B8)
+        int8Mult.FreeMatrix(B8Prepared);
+    if (B16Prepared != B16)
+        shortMult.FreeMatrix(B16Prepared);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } } } }
\ No newline at end of file